@@ -2481,6 +2481,12 @@ std::string AggExpr::toString() const {
     case kSAMPLE:
       agg = "SAMPLE";
       break;
+    case kAPPROX_MEDIAN:
+      agg = "APPROX_MEDIAN";
+      break;
+    case kAPPROX_TOP_K:
+      agg = "APPROX_TOP_K";
+      break;
   }
   std::string str{"(" + agg};
   if (is_distinct) {
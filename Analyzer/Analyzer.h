@@ -1483,6 +1483,12 @@ class Query {
   void set_limit(int64_t l) { limit = l; }
   int64_t get_offset() const { return offset; }
   void set_offset(int64_t o) { offset = o; }
+  const std::vector<std::vector<std::shared_ptr<TargetEntry>>>& get_values_lists() const {
+    return values_lists;
+  }
+  void add_values_list(std::vector<std::shared_ptr<TargetEntry>> values) {
+    values_lists.push_back(std::move(values));
+  }
 
  private:
   bool is_distinct;                                      // true only if SELECT DISTINCT
@@ -1502,6 +1508,9 @@ class Query {
   std::list<int> result_col_list;  // for INSERT statement only
   int64_t limit;                   // row count for LIMIT clause.  0 means ALL
   int64_t offset;                  // offset in OFFSET clause.  0 means no offset.
+  std::vector<std::vector<std::shared_ptr<TargetEntry>>>
+      values_lists;  // rows after the first for multi-row INSERT VALUES;
+                     // the first row is the targetlist
 };
 }  // namespace Analyzer
 
@@ -21,15 +21,53 @@
 #include <aws/core/Aws.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsV2Request.h>
 #include <aws/s3/model/Object.h>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <sstream>
 
 int S3Archive::awsapi_count;
 std::mutex S3Archive::awsapi_mtx;
 Aws::SDKOptions S3Archive::awsapi_options;
 
+namespace {
+
+// geometry of the parallel ranged-GET pipeline: parts big enough to amortize
+// request latency, and enough connections in flight to fill the NIC, since a
+// single S3 stream tops out well below link rate
+const size_t kS3PartBytes = 32 * 1024 * 1024;
+const size_t kS3MaxInflightParts = 4;
+
+// one ranged GET, returning the part's bytes
+std::string download_s3_part(Aws::S3::S3Client* s3_client,
+                             const std::string& s3_url,
+                             const std::string& bucket_name,
+                             const std::string& objkey,
+                             const size_t offset,
+                             const size_t object_size) {
+  const auto len = std::min(kS3PartBytes, object_size - offset);
+  Aws::S3::Model::GetObjectRequest object_request;
+  object_request.WithBucket(bucket_name).WithKey(objkey);
+  object_request.SetRange("bytes=" + std::to_string(offset) + "-" +
+                          std::to_string(offset + len - 1));
+  auto get_object_outcome = s3_client->GetObject(object_request);
+  if (!get_object_outcome.IsSuccess()) {
+    throw std::runtime_error("failed to get object '" + objkey + "' of s3 url '" +
+                             s3_url + "': " +
+                             get_object_outcome.GetError().GetExceptionName() + ": " +
+                             get_object_outcome.GetError().GetMessage());
+  }
+  std::ostringstream part;
+  part << get_object_outcome.GetResult().GetBody().rdbuf();
+  return part.str();
+}
+
+}  // namespace
+
 void S3Archive::init_for_read() {
   boost::filesystem::create_directories(s3_temp_dir);
   if (!boost::filesystem::is_directory(s3_temp_dir)) {
@@ -181,6 +219,80 @@ const std::string S3Archive::land(const std::string& objkey,
     }
   }
 
+  // Large plain objects going through the pipe skip the single streamed GET
+  // below in favor of a windowed sequence of ranged GETs downloaded on
+  // parallel connections and stitched into the pipe in order, so the parse
+  // threads on the reader side stay fed at link rate. Small objects and the
+  // fully-landed formats (.7z, parquet) keep the simple path.
+  if (use_pipe && !for_detection) {
+    Aws::S3::Model::HeadObjectRequest head_request;
+    head_request.WithBucket(bucket_name).WithKey(objkey);
+    const auto head_outcome = s3_client->HeadObject(head_request);
+    if (head_outcome.IsSuccess() &&
+        head_outcome.GetResult().GetContentLength() >
+            static_cast<int64_t>(kS3PartBytes)) {
+      const auto object_size =
+          static_cast<size_t>(head_outcome.GetResult().GetContentLength());
+      // the first part is fetched synchronously so bad credentials or a lost
+      // object throw to the caller here, before the reader side opens the
+      // pipe and could hang on a writer that never shows up
+      auto first_part =
+          download_s3_part(s3_client.get(), url, bucket_name, objkey, 0, object_size);
+      // local copies so the thread can't race ~S3Archive on members
+      const auto bucket_name_copy = this->bucket_name;
+      const auto s3_url = this->url;
+      auto s3_client_ptr = s3_client.get();
+      auto th_writer = std::thread([=, &teptr, first_part = std::move(first_part)]() {
+        try {
+          static std::mutex mutex_glog;
+          {
+            std::unique_lock<std::mutex> lock(mutex_glog);
+            LOG(INFO) << "downloading s3://" << bucket_name_copy << "/" << objkey
+                      << " to pipe " << file_path << " with "
+                      << (object_size + kS3PartBytes - 1) / kS3PartBytes
+                      << " ranged GETs...";
+          }
+          Aws::OFStream local_file;
+          local_file.open(file_path.c_str(),
+                          std::ios::out | std::ios::binary | std::ios::trunc);
+          local_file.write(first_part.data(), first_part.size());
+          std::deque<std::future<std::string>> inflight;
+          size_t scheduled = first_part.size();
+          while (scheduled < object_size || !inflight.empty()) {
+            while (scheduled < object_size && inflight.size() < kS3MaxInflightParts) {
+              inflight.push_back(std::async(std::launch::async,
+                                            download_s3_part,
+                                            s3_client_ptr,
+                                            s3_url,
+                                            bucket_name_copy,
+                                            objkey,
+                                            scheduled,
+                                            object_size));
+              scheduled += std::min(kS3PartBytes, object_size - scheduled);
+            }
+            const auto part = inflight.front().get();
+            inflight.pop_front();
+            local_file.write(part.data(), part.size());
+          }
+          {
+            std::unique_lock<std::mutex> lock(mutex_glog);
+            LOG(INFO) << "downloaded s3://" << bucket_name_copy << "/" << objkey
+                      << " to pipe " << file_path << ".";
+          }
+        } catch (...) {
+          // the pipe reader surfaces this via teptr like the single-GET path
+          teptr = std::current_exception();
+        }
+      });
+      threads.push_back(std::move(th_writer));
+      file_paths.insert(
+          std::pair<const std::string, const std::string>(objkey, file_path));
+      return file_path;
+    }
+    // HEAD can fail without GetObject failing (eg. no HeadObject privilege);
+    // fall through to the single streamed GET in that case
+  }
+
   /*
     Here is the background info that makes the thread interaction here a bit subtle:
     1) We need two threading modes for the `th_writer` thread below:
@@ -22,6 +22,9 @@
  */
 
 #include "Calcite.h"
+#ifdef ENABLE_CALCITE_JNI
+#include "CalciteJNI.h"
+#endif
 #include <thread>
 #include <utility>
 #include "Catalog/Catalog.h"
@@ -46,6 +49,9 @@ using namespace apache::thrift;
 using namespace apache::thrift::protocol;
 using namespace apache::thrift::transport;
 
+bool g_enable_calcite_plan_cache{false};
+size_t g_calcite_plan_cache_max_entries{1000};
+
 namespace {
 template <typename XDEBUG_OPTION,
           typename REMOTE_DEBUG_OPTION,
@@ -255,9 +261,22 @@ void Calcite::init(const int mapd_port,
                    const int calcite_port,
                    const std::string& data_dir,
                    const size_t calcite_max_mem,
-                   const std::string& udf_filename) {
+                   const std::string& udf_filename,
+                   const bool use_jni) {
   LOG(INFO) << "Creating Calcite Handler,  Calcite Port is " << calcite_port
             << " base data dir is " << data_dir;
+  if (use_jni) {
+#ifdef ENABLE_CALCITE_JNI
+    CalciteJNI::get().init(mapd_port, data_dir, calcite_max_mem, udf_filename);
+    jni_mode_ = true;
+    server_available_ = false;
+    return;
+#else
+    throw std::runtime_error(
+        "In-process Calcite requested but the server was built without "
+        "ENABLE_CALCITE_JNI");
+#endif
+  }
   if (calcite_port < 0) {
     CHECK(false) << "JNI mode no longer supported.";
   }
@@ -283,10 +302,20 @@ Calcite::Calcite(const MapDParameters& mapd_parameter,
        mapd_parameter.calcite_port,
        data_dir,
        mapd_parameter.calcite_max_mem,
-       udf_filename);
+       udf_filename,
+       mapd_parameter.enable_calcite_jni);
 }
 
 void Calcite::updateMetadata(std::string catalog, std::string table) {
+  invalidateCachedPlans(catalog);
+#ifdef ENABLE_CALCITE_JNI
+  if (jni_mode_) {
+    auto ms = measure<>::execution(
+        [&]() { CalciteJNI::get().updateMetadata(catalog, table); });
+    LOG(INFO) << "Time to updateMetadata " << ms << " (ms)";
+    return;
+  }
+#endif
   if (server_available_) {
     auto ms = measure<>::execution([&]() {
       auto clientP = get_client(remote_calcite_port_);
@@ -335,6 +364,67 @@ void checkPermissionForTables(const Catalog_Namespace::SessionInfo& session_info
   }
 }
 
+std::string Calcite::planCacheKey(const std::string& catalog,
+                                  const std::string& sql_string,
+                                  const bool legacy_syntax,
+                                  const bool is_explain,
+                                  const bool is_view_optimize) const {
+  // canonicalize only by trimming; anything smarter risks touching literals
+  const auto begin = sql_string.find_first_not_of(" \t\n\r");
+  const auto end = sql_string.find_last_not_of(" \t\n\r;");
+  const auto trimmed = begin == std::string::npos
+                           ? std::string()
+                           : sql_string.substr(begin, end - begin + 1);
+  return catalog + '\n' + (legacy_syntax ? '1' : '0') + (is_explain ? '1' : '0') +
+         (is_view_optimize ? '1' : '0') + '\n' + trimmed;
+}
+
+bool Calcite::getCachedPlan(const std::string& cache_key, TPlanResult& result) {
+  std::lock_guard<std::mutex> lock(plan_cache_mutex_);
+  const auto it = plan_cache_.find(cache_key);
+  if (it == plan_cache_.end()) {
+    return false;
+  }
+  result = *it->second;
+  result.execution_time_ms = 0;
+  return true;
+}
+
+void Calcite::putCachedPlan(const std::string& cache_key, const TPlanResult& result) {
+  std::lock_guard<std::mutex> lock(plan_cache_mutex_);
+  if (plan_cache_.count(cache_key)) {
+    return;
+  }
+  while (plan_cache_.size() >= g_calcite_plan_cache_max_entries &&
+         !plan_cache_order_.empty()) {
+    plan_cache_.erase(plan_cache_order_.front());
+    plan_cache_order_.pop_front();
+  }
+  plan_cache_.emplace(cache_key, std::make_shared<TPlanResult>(result));
+  plan_cache_order_.push_back(cache_key);
+}
+
+// Drops all cached plans for the given catalog; an empty catalog drops
+// everything. Plans only become stale through DDL, which always funnels
+// through updateMetadata.
+void Calcite::invalidateCachedPlans(const std::string& catalog) {
+  std::lock_guard<std::mutex> lock(plan_cache_mutex_);
+  if (catalog.empty()) {
+    plan_cache_.clear();
+    plan_cache_order_.clear();
+    return;
+  }
+  const auto prefix = catalog + '\n';
+  for (auto it = plan_cache_order_.begin(); it != plan_cache_order_.end();) {
+    if (it->compare(0, prefix.size(), prefix) == 0) {
+      plan_cache_.erase(*it);
+      it = plan_cache_order_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 TPlanResult Calcite::process(
     const Catalog_Namespace::SessionInfo& session_info,
     const std::string sql_string,
@@ -342,12 +432,32 @@ TPlanResult Calcite::process(
     const bool legacy_syntax,
     const bool is_explain,
     const bool is_view_optimize) {
-  TPlanResult result = processImpl(session_info,
-                                   sql_string,
-                                   filter_push_down_info,
-                                   legacy_syntax,
-                                   is_explain,
-                                   is_view_optimize);
+  // Filter push down rewrites make the plan dependent on more than the query
+  // text, so only plain requests are cacheable.
+  const bool use_plan_cache =
+      g_enable_calcite_plan_cache && filter_push_down_info.empty();
+  std::string cache_key;
+  TPlanResult result;
+  bool cache_hit = false;
+  if (use_plan_cache) {
+    cache_key = planCacheKey(session_info.getCatalog().getCurrentDB().dbName,
+                             sql_string,
+                             legacy_syntax,
+                             is_explain,
+                             is_view_optimize);
+    cache_hit = getCachedPlan(cache_key, result);
+  }
+  if (!cache_hit) {
+    result = processImpl(session_info,
+                         sql_string,
+                         filter_push_down_info,
+                         legacy_syntax,
+                         is_explain,
+                         is_view_optimize);
+    if (use_plan_cache) {
+      putCachedPlan(cache_key, result);
+    }
+  }
 
   AccessPrivileges NOOP;
 
@@ -380,6 +490,11 @@ std::vector<TCompletionHint> Calcite::getCompletionHints(
     const std::string sql_string,
     const int cursor) {
   std::vector<TCompletionHint> hints;
+  if (jni_mode_) {
+    // not plumbed through the JNI bridge; only used by interactive clients
+    LOG(WARNING) << "Completion hints are not available with in-process Calcite";
+    return hints;
+  }
   auto& cat = session_info.getCatalog();
   const auto user = session_info.get_currentUser().userName;
   const auto session = session_info.get_session_id();
@@ -427,6 +542,22 @@ TPlanResult Calcite::processImpl(
 
   LOG(INFO) << "User " << user << " catalog " << catalog << " sql '" << sql_string << "'";
   TPlanResult ret;
+#ifdef ENABLE_CALCITE_JNI
+  if (jni_mode_) {
+    auto ms = measure<>::execution([&]() {
+      ret = CalciteJNI::get().process(user,
+                                      session,
+                                      catalog,
+                                      sql_string,
+                                      filter_push_down_info,
+                                      legacy_syntax,
+                                      is_explain,
+                                      is_view_optimize);
+    });
+    LOG(INFO) << "Time in embedded Calcite " << ms << " (ms)";
+    return ret;
+  }
+#endif
   if (server_available_) {
     try {
       auto ms = measure<>::execution([&]() {
@@ -464,6 +595,11 @@ TPlanResult Calcite::processImpl(
 }
 
 std::string Calcite::getExtensionFunctionWhitelist() {
+#ifdef ENABLE_CALCITE_JNI
+  if (jni_mode_) {
+    return CalciteJNI::get().getExtensionFunctionWhitelist();
+  }
+#endif
   if (server_available_) {
     TPlanResult ret;
     std::string whitelist;
@@ -482,6 +618,11 @@ std::string Calcite::getExtensionFunctionWhitelist() {
 }
 
 std::string Calcite::getUserDefinedFunctionWhitelist() {
+#ifdef ENABLE_CALCITE_JNI
+  if (jni_mode_) {
+    return CalciteJNI::get().getUserDefinedFunctionWhitelist();
+  }
+#endif
   if (server_available_) {
     TPlanResult ret;
     std::string whitelist;
@@ -527,6 +668,11 @@ Calcite::~Calcite() {
 }
 
 std::string Calcite::getRuntimeUserDefinedFunctionWhitelist() {
+#ifdef ENABLE_CALCITE_JNI
+  if (jni_mode_) {
+    return CalciteJNI::get().getRuntimeUserDefinedFunctionWhitelist();
+  }
+#endif
   if (server_available_) {
     TPlanResult ret;
     std::string whitelist;
@@ -545,6 +691,13 @@ std::string Calcite::getRuntimeUserDefinedFunctionWhitelist() {
 }
 
 void Calcite::setRuntimeUserDefinedFunction(std::string udf_string) {
+  invalidateCachedPlans("");
+#ifdef ENABLE_CALCITE_JNI
+  if (jni_mode_) {
+    CalciteJNI::get().setRuntimeUserDefinedFunction(udf_string);
+    return;
+  }
+#endif
   if (server_available_) {
     auto clientP = get_client(remote_calcite_port_);
     clientP.first->setRuntimeUserDefinedFunction(udf_string);
@@ -24,9 +24,12 @@
 #ifndef CALCITE_H
 #define CALCITE_H
 
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 #include "Shared/MapDParameters.h"
 #include "rapidjson/document.h"
@@ -83,7 +86,8 @@ class Calcite {
             const int port,
             const std::string& data_dir,
             const size_t calcite_max_mem,
-            const std::string& udf_filename);
+            const std::string& udf_filename,
+            const bool use_jni = false);
   void runServer(const int mapd_port,
                  const int port,
                  const std::string& data_dir,
@@ -98,10 +102,30 @@ class Calcite {
   std::vector<std::string> get_db_objects(const std::string ra);
   void inner_close_calcite_server(bool log);
 
+  // Plan cache for repeated (dashboard) queries: maps catalog name plus the
+  // trimmed SQL text and planning flags to the TPlanResult, so identical
+  // queries skip the planner round trip entirely. Permission checks still run
+  // on every call against the cached accessed objects; entries for a catalog
+  // are dropped whenever DDL reaches updateMetadata.
+  std::string planCacheKey(const std::string& catalog,
+                           const std::string& sql_string,
+                           const bool legacy_syntax,
+                           const bool is_explain,
+                           const bool is_view_optimize) const;
+  bool getCachedPlan(const std::string& cache_key, TPlanResult& result);
+  void putCachedPlan(const std::string& cache_key, const TPlanResult& result);
+  void invalidateCachedPlans(const std::string& catalog);
+
+  std::unordered_map<std::string, std::shared_ptr<TPlanResult>> plan_cache_;
+  std::deque<std::string> plan_cache_order_;  // insertion order, for eviction
+  std::mutex plan_cache_mutex_;
+
   std::thread calcite_server_thread_;
   int ping();
 
   bool server_available_;
+  // planner runs in an embedded JVM, no external server (ENABLE_CALCITE_JNI)
+  bool jni_mode_ = false;
   int remote_calcite_port_ = -1;
   std::string ssl_trust_store_;
   std::string ssl_trust_password_;
@@ -0,0 +1,317 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CalciteJNI.h"
+
+#include "Shared/Logger.h"
+#include "Shared/mapdpath.h"
+
+#include "gen-cpp/CalciteServer.h"
+
+#include "rapidjson/document.h"
+
+#include <jni.h>
+
+namespace {
+
+const char* kBridgeClassName = "com/mapd/parser/server/CalciteJNI";
+
+void read_accessed_objects(const rapidjson::Value& json,
+                           TAccessedQueryObjects& objects) {
+  auto read_list = [&json](const char* name, std::vector<std::string>& out) {
+    const auto it = json.FindMember(name);
+    if (it == json.MemberEnd() || !it->value.IsArray()) {
+      return;
+    }
+    for (const auto& entry : it->value.GetArray()) {
+      out.emplace_back(entry.GetString());
+    }
+  };
+  read_list("tables_selected_from", objects.tables_selected_from);
+  read_list("tables_inserted_into", objects.tables_inserted_into);
+  read_list("tables_updated_in", objects.tables_updated_in);
+  read_list("tables_deleted_from", objects.tables_deleted_from);
+}
+
+// The Java side serializes TPlanResult with TSimpleJSONProtocol, which writes
+// one object keyed by field name.
+TPlanResult plan_result_from_json(const std::string& json) {
+  TPlanResult ret;
+  rapidjson::Document document;
+  document.Parse(json.c_str());
+  CHECK(!document.HasParseError()) << json;
+  CHECK(document.IsObject());
+  if (document.HasMember("plan_result")) {
+    ret.plan_result = document["plan_result"].GetString();
+  }
+  if (document.HasMember("execution_time_ms")) {
+    ret.execution_time_ms = document["execution_time_ms"].GetInt64();
+  }
+  if (document.HasMember("primary_accessed_objects")) {
+    read_accessed_objects(document["primary_accessed_objects"],
+                          ret.primary_accessed_objects);
+  }
+  if (document.HasMember("resolved_accessed_objects")) {
+    read_accessed_objects(document["resolved_accessed_objects"],
+                          ret.resolved_accessed_objects);
+  }
+  return ret;
+}
+
+// Local references created by C++ to Java calls live until the calling thread
+// detaches, not until the call returns, so every entry point works inside its
+// own local frame.
+class LocalFrameGuard {
+ public:
+  LocalFrameGuard(JNIEnv* env, const jint capacity) : env_(env) {
+    CHECK_EQ(0, env_->PushLocalFrame(capacity));
+  }
+  ~LocalFrameGuard() { env_->PopLocalFrame(nullptr); }
+
+ private:
+  JNIEnv* env_;
+};
+
+}  // namespace
+
+class CalciteJNIImpl {
+ public:
+  void createVM(const size_t calcite_max_mem, const std::string& data_dir) {
+    const auto class_path =
+        "-Djava.class.path=" + mapd_root_abs_path() +
+        "/bin/calcite-1.0-SNAPSHOT-jar-with-dependencies.jar";
+    const auto max_mem = "-Xmx" + std::to_string(calcite_max_mem) + "m";
+    const auto log_dir = "-DMAPD_LOG_DIR=" + data_dir;
+    JavaVMOption options[3];
+    options[0].optionString = const_cast<char*>(class_path.c_str());
+    options[1].optionString = const_cast<char*>(max_mem.c_str());
+    options[2].optionString = const_cast<char*>(log_dir.c_str());
+    JavaVMInitArgs vm_args;
+    vm_args.version = JNI_VERSION_1_8;
+    vm_args.nOptions = 3;
+    vm_args.options = options;
+    vm_args.ignoreUnrecognized = JNI_FALSE;
+    JNIEnv* env{nullptr};
+    const auto err =
+        JNI_CreateJavaVM(&jvm_, reinterpret_cast<void**>(&env), &vm_args);
+    if (err != JNI_OK) {
+      throw std::runtime_error("Failed to create embedded JVM for Calcite, error " +
+                               std::to_string(err));
+    }
+    const auto local_class = env->FindClass(kBridgeClassName);
+    if (!local_class) {
+      throw std::runtime_error(
+          "Embedded Calcite bridge class not found in the calcite jar; the jar "
+          "predates JNI support");
+    }
+    bridge_class_ = static_cast<jclass>(env->NewGlobalRef(local_class));
+    init_method_ = env->GetStaticMethodID(
+        bridge_class_, "init", "(ILjava/lang/String;Ljava/lang/String;Ljava/lang/String;)V");
+    process_method_ = env->GetStaticMethodID(
+        bridge_class_,
+        "process",
+        "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;[I[I[I"
+        "ZZZ)Ljava/lang/String;");
+    update_metadata_method_ = env->GetStaticMethodID(
+        bridge_class_, "updateMetadata", "(Ljava/lang/String;Ljava/lang/String;)V");
+    ext_whitelist_method_ = env->GetStaticMethodID(
+        bridge_class_, "getExtensionFunctionWhitelist", "()Ljava/lang/String;");
+    udf_whitelist_method_ = env->GetStaticMethodID(
+        bridge_class_, "getUserDefinedFunctionWhitelist", "()Ljava/lang/String;");
+    runtime_udf_whitelist_method_ = env->GetStaticMethodID(
+        bridge_class_, "getRuntimeUserDefinedFunctionWhitelist", "()Ljava/lang/String;");
+    set_runtime_udf_method_ = env->GetStaticMethodID(
+        bridge_class_, "setRuntimeUserDefinedFunction", "(Ljava/lang/String;)V");
+    CHECK(init_method_ && process_method_ && update_metadata_method_ &&
+          ext_whitelist_method_ && udf_whitelist_method_ &&
+          runtime_udf_whitelist_method_ && set_runtime_udf_method_);
+  }
+
+  // The JVM requires every calling thread to be attached; threads stay
+  // attached for their lifetime, which is fine for the server's pools.
+  JNIEnv* getEnv() {
+    JNIEnv* env{nullptr};
+    const auto res = jvm_->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_8);
+    if (res == JNI_EDETACHED) {
+      CHECK_EQ(JNI_OK,
+               jvm_->AttachCurrentThread(reinterpret_cast<void**>(&env), nullptr));
+    } else {
+      CHECK_EQ(JNI_OK, res);
+    }
+    CHECK(env);
+    return env;
+  }
+
+  // Converts a pending Java exception to the C++ exception types the Thrift
+  // path produces: parse rejections become std::invalid_argument, everything
+  // else std::runtime_error.
+  void throwPendingException(JNIEnv* env) {
+    const auto throwable = env->ExceptionOccurred();
+    if (!throwable) {
+      return;
+    }
+    env->ExceptionClear();
+    const auto throwable_class = env->GetObjectClass(throwable);
+    const auto to_string_method = env->GetMethodID(
+        throwable_class, "toString", "()Ljava/lang/String;");
+    CHECK(to_string_method);
+    const auto jmessage =
+        static_cast<jstring>(env->CallObjectMethod(throwable, to_string_method));
+    std::string message("<no message>");
+    if (jmessage) {
+      const auto chars = env->GetStringUTFChars(jmessage, nullptr);
+      message = chars;
+      env->ReleaseStringUTFChars(jmessage, chars);
+    }
+    if (message.find("InvalidParseRequest") != std::string::npos) {
+      throw std::invalid_argument(message);
+    }
+    throw std::runtime_error("Embedded Calcite error: " + message);
+  }
+
+  jstring toJString(JNIEnv* env, const std::string& str) {
+    return env->NewStringUTF(str.c_str());
+  }
+
+  std::string fromJString(JNIEnv* env, jstring jstr) {
+    if (!jstr) {
+      return "";
+    }
+    const auto chars = env->GetStringUTFChars(jstr, nullptr);
+    std::string ret(chars);
+    env->ReleaseStringUTFChars(jstr, chars);
+    return ret;
+  }
+
+  std::string callStringMethod(jmethodID method) {
+    auto env = getEnv();
+    LocalFrameGuard frame_guard(env, 16);
+    const auto jresult =
+        static_cast<jstring>(env->CallStaticObjectMethod(bridge_class_, method));
+    throwPendingException(env);
+    return fromJString(env, jresult);
+  }
+
+  JavaVM* jvm_{nullptr};
+  jclass bridge_class_{nullptr};
+  jmethodID init_method_{nullptr};
+  jmethodID process_method_{nullptr};
+  jmethodID update_metadata_method_{nullptr};
+  jmethodID ext_whitelist_method_{nullptr};
+  jmethodID udf_whitelist_method_{nullptr};
+  jmethodID runtime_udf_whitelist_method_{nullptr};
+  jmethodID set_runtime_udf_method_{nullptr};
+};
+
+CalciteJNI::CalciteJNI() : impl_(new CalciteJNIImpl) {}
+
+CalciteJNI& CalciteJNI::get() {
+  static CalciteJNI instance;
+  return instance;
+}
+
+void CalciteJNI::init(const int mapd_port,
+                      const std::string& data_dir,
+                      const size_t calcite_max_mem,
+                      const std::string& udf_filename) {
+  impl_->createVM(calcite_max_mem, data_dir);
+  auto env = impl_->getEnv();
+  LocalFrameGuard frame_guard(env, 16);
+  const auto extension_functions_ast = mapd_root_abs_path() + "/QueryEngine/";
+  env->CallStaticVoidMethod(impl_->bridge_class_,
+                            impl_->init_method_,
+                            mapd_port,
+                            impl_->toJString(env, data_dir),
+                            impl_->toJString(env, extension_functions_ast),
+                            impl_->toJString(env, udf_filename));
+  impl_->throwPendingException(env);
+  LOG(INFO) << "Embedded Calcite initialized";
+}
+
+TPlanResult CalciteJNI::process(
+    const std::string& user,
+    const std::string& session,
+    const std::string& catalog,
+    const std::string& sql_string,
+    const std::vector<TFilterPushDownInfo>& filter_push_down_info,
+    const bool legacy_syntax,
+    const bool is_explain,
+    const bool is_view_optimize) {
+  auto env = impl_->getEnv();
+  LocalFrameGuard frame_guard(env, 32);
+  const auto num_push_downs = filter_push_down_info.size();
+  std::vector<jint> input_prev(num_push_downs);
+  std::vector<jint> input_start(num_push_downs);
+  std::vector<jint> input_next(num_push_downs);
+  for (size_t i = 0; i < num_push_downs; ++i) {
+    input_prev[i] = filter_push_down_info[i].input_prev;
+    input_start[i] = filter_push_down_info[i].input_start;
+    input_next[i] = filter_push_down_info[i].input_next;
+  }
+  auto make_int_array = [env](const std::vector<jint>& vals) {
+    const auto jarray = env->NewIntArray(vals.size());
+    if (!vals.empty()) {
+      env->SetIntArrayRegion(jarray, 0, vals.size(), vals.data());
+    }
+    return jarray;
+  };
+  const auto jresult = static_cast<jstring>(
+      env->CallStaticObjectMethod(impl_->bridge_class_,
+                                  impl_->process_method_,
+                                  impl_->toJString(env, user),
+                                  impl_->toJString(env, session),
+                                  impl_->toJString(env, catalog),
+                                  impl_->toJString(env, sql_string),
+                                  make_int_array(input_prev),
+                                  make_int_array(input_start),
+                                  make_int_array(input_next),
+                                  static_cast<jboolean>(legacy_syntax),
+                                  static_cast<jboolean>(is_explain),
+                                  static_cast<jboolean>(is_view_optimize)));
+  impl_->throwPendingException(env);
+  return plan_result_from_json(impl_->fromJString(env, jresult));
+}
+
+std::string CalciteJNI::getExtensionFunctionWhitelist() {
+  return impl_->callStringMethod(impl_->ext_whitelist_method_);
+}
+
+std::string CalciteJNI::getUserDefinedFunctionWhitelist() {
+  return impl_->callStringMethod(impl_->udf_whitelist_method_);
+}
+
+std::string CalciteJNI::getRuntimeUserDefinedFunctionWhitelist() {
+  return impl_->callStringMethod(impl_->runtime_udf_whitelist_method_);
+}
+
+void CalciteJNI::setRuntimeUserDefinedFunction(const std::string& udf_string) {
+  auto env = impl_->getEnv();
+  LocalFrameGuard frame_guard(env, 16);
+  env->CallStaticVoidMethod(impl_->bridge_class_,
+                            impl_->set_runtime_udf_method_,
+                            impl_->toJString(env, udf_string));
+  impl_->throwPendingException(env);
+}
+
+void CalciteJNI::updateMetadata(const std::string& catalog, const std::string& table) {
+  auto env = impl_->getEnv();
+  LocalFrameGuard frame_guard(env, 16);
+  env->CallStaticVoidMethod(impl_->bridge_class_,
+                            impl_->update_metadata_method_,
+                            impl_->toJString(env, catalog),
+                            impl_->toJString(env, table));
+  impl_->throwPendingException(env);
+}
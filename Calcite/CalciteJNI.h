@@ -0,0 +1,70 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    CalciteJNI.h
+ * @brief   Runs the Calcite planner inside an embedded JVM instead of a
+ *          separate java process reached over localhost Thrift, removing the
+ *          per-query RPC round trip and the restart failure mode. Compiled
+ *          only when ENABLE_CALCITE_JNI is set; the Java entry points live in
+ *          com.mapd.parser.server.CalciteJNI.
+ */
+
+#ifndef CALCITE_CALCITEJNI_H
+#define CALCITE_CALCITEJNI_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class TFilterPushDownInfo;
+class TPlanResult;
+
+class CalciteJNIImpl;
+
+class CalciteJNI {
+ public:
+  static CalciteJNI& get();
+
+  // Starts the embedded JVM and instantiates the Java side handler; must be
+  // called once before any other method.
+  void init(const int mapd_port,
+            const std::string& data_dir,
+            const size_t calcite_max_mem,
+            const std::string& udf_filename);
+
+  TPlanResult process(const std::string& user,
+                      const std::string& session,
+                      const std::string& catalog,
+                      const std::string& sql_string,
+                      const std::vector<TFilterPushDownInfo>& filter_push_down_info,
+                      const bool legacy_syntax,
+                      const bool is_explain,
+                      const bool is_view_optimize);
+
+  std::string getExtensionFunctionWhitelist();
+  std::string getUserDefinedFunctionWhitelist();
+  std::string getRuntimeUserDefinedFunctionWhitelist();
+  void setRuntimeUserDefinedFunction(const std::string& udf_string);
+  void updateMetadata(const std::string& catalog, const std::string& table);
+
+ private:
+  CalciteJNI();
+
+  std::unique_ptr<CalciteJNIImpl> impl_;
+};
+
+#endif  // CALCITE_CALCITEJNI_H
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cassert>
 #include <exception>
+#include <future>
 #include <list>
 #include <memory>
 #include <random>
@@ -49,6 +50,7 @@
 #include "../QueryEngine/TableOptimizer.h"
 
 #include "../Fragmenter/Fragmenter.h"
+#include "../Fragmenter/InsertWal.h"
 #include "../Fragmenter/SortedOrderFragmenter.h"
 #include "../Parser/ParserNode.h"
 #include "../Shared/File.h"
@@ -124,6 +126,21 @@ void Catalog::updateFrontendViewsToDashboards() {
   sqliteConnector_.query("END TRANSACTION");
 }
 
+void Catalog::updateMaterializedViewsSchema() {
+  cat_sqlite_lock sqlite_lock(this);
+  sqliteConnector_.query("BEGIN TRANSACTION");
+  try {
+    sqliteConnector_.query(
+        "CREATE TABLE IF NOT EXISTS mapd_materialized_views (viewname text unique, "
+        "basename text, select_query text, last_refresh_row_count bigint, "
+        "needs_full_refresh boolean)");
+  } catch (const std::exception& e) {
+    sqliteConnector_.query("ROLLBACK TRANSACTION");
+    throw;
+  }
+  sqliteConnector_.query("END TRANSACTION");
+}
+
 Catalog::Catalog(const string& basePath,
                  const DBMetadata& curDB,
                  std::shared_ptr<Data_Namespace::DataMgr> dataMgr,
@@ -149,6 +166,11 @@ Catalog::Catalog(const string& basePath,
   if (!is_new_db) {
     CheckAndExecuteMigrationsPostBuildMaps();
   }
+  if (g_enable_insert_wal) {
+    // re-apply any insert batches whose checkpoint was still pending when the
+    // server last went down, before the database serves its first query
+    Fragmenter_Namespace::InsertWal::getInstance().openAndReplay(*this);
+  }
 }
 
 Catalog::~Catalog() {
@@ -219,6 +241,22 @@ void Catalog::updateTableDescriptorSchema() {
       sqliteConnector_.query(
           "ALTER TABLE mapd_tables ADD sort_column_id INTEGER DEFAULT 0");
     }
+    if (std::find(cols.begin(), cols.end(), std::string("cache_policy")) == cols.end()) {
+      sqliteConnector_.query(
+          "ALTER TABLE mapd_tables ADD cache_policy INTEGER DEFAULT 0");
+    }
+    if (std::find(cols.begin(), cols.end(), std::string("unique_key_column_id")) ==
+        cols.end()) {
+      sqliteConnector_.query(
+          "ALTER TABLE mapd_tables ADD unique_key_column_id INTEGER DEFAULT 0");
+    }
+    if (std::find(cols.begin(), cols.end(), std::string("retention_column_id")) ==
+        cols.end()) {
+      sqliteConnector_.query(
+          "ALTER TABLE mapd_tables ADD retention_column_id INTEGER DEFAULT 0");
+      sqliteConnector_.query(
+          "ALTER TABLE mapd_tables ADD retention_seconds BIGINT DEFAULT 0");
+    }
   } catch (std::exception& e) {
     sqliteConnector_.query("ROLLBACK TRANSACTION");
     throw;
@@ -802,6 +840,7 @@ void Catalog::CheckAndExecuteMigrations() {
   updatePageSize();
   updateDeletedColumnIndicator();
   updateFrontendViewsToDashboards();
+  updateMaterializedViewsSchema();
   recordOwnershipOfObjectsInObjectPermissions();
 }
 
@@ -847,7 +886,8 @@ void Catalog::buildMaps() {
       "SELECT tableid, name, ncolumns, isview, fragments, frag_type, max_frag_rows, "
       "max_chunk_size, frag_page_size, "
       "max_rows, partitions, shard_column_id, shard, num_shards, key_metainfo, userid, "
-      "sort_column_id "
+      "sort_column_id, cache_policy, unique_key_column_id, retention_column_id, "
+      "retention_seconds "
       "from mapd_tables");
   sqliteConnector_.query(tableQuery);
   numRows = sqliteConnector_.getNumRows();
@@ -872,6 +912,17 @@ void Catalog::buildMaps() {
     td->userId = sqliteConnector_.getData<int>(r, 15);
     td->sortedColumnId =
         sqliteConnector_.isNull(r, 16) ? 0 : sqliteConnector_.getData<int>(r, 16);
+    td->cachePolicy = static_cast<Data_Namespace::TableCachePolicy>(
+        sqliteConnector_.isNull(r, 17) ? 0 : sqliteConnector_.getData<int>(r, 17));
+    td->uniqueKeyColumnId =
+        sqliteConnector_.isNull(r, 18) ? 0 : sqliteConnector_.getData<int>(r, 18);
+    td->retentionColumnId =
+        sqliteConnector_.isNull(r, 19) ? 0 : sqliteConnector_.getData<int>(r, 19);
+    td->retentionSeconds =
+        sqliteConnector_.isNull(r, 20) ? 0 : sqliteConnector_.getData<int64_t>(r, 20);
+    if (td->cachePolicy != Data_Namespace::CACHE_NORMAL) {
+      Data_Namespace::setTableCachePolicy(currentDB_.dbId, td->tableId, td->cachePolicy);
+    }
     if (!td->isView) {
       td->fragmenter = nullptr;
     }
@@ -1011,11 +1062,16 @@ void Catalog::addTableToMap(TableDescriptor& td,
                             const list<ColumnDescriptor>& columns,
                             const list<DictDescriptor>& dicts) {
   cat_write_lock write_lock(this);
+  bumpMetadataVersion();
   TableDescriptor* new_td = new TableDescriptor();
   *new_td = td;
   new_td->mutex_ = std::make_shared<std::mutex>();
   tableDescriptorMap_[to_upper(td.tableName)] = new_td;
   tableDescriptorMapById_[td.tableId] = new_td;
+  if (new_td->cachePolicy != Data_Namespace::CACHE_NORMAL) {
+    Data_Namespace::setTableCachePolicy(
+        currentDB_.dbId, new_td->tableId, new_td->cachePolicy);
+  }
   for (auto cd : columns) {
     ColumnDescriptor* new_cd = new ColumnDescriptor();
     *new_cd = cd;
@@ -1061,6 +1117,7 @@ void Catalog::removeTableFromMap(const string& tableName,
                                  const int tableId,
                                  const bool is_on_error) {
   cat_write_lock write_lock(this);
+  bumpMetadataVersion();
   TableDescriptorMapById::iterator tableDescIt = tableDescriptorMapById_.find(tableId);
   if (tableDescIt == tableDescriptorMapById_.end()) {
     throw runtime_error("Table " + tableName + " does not exist.");
@@ -1075,6 +1132,7 @@ void Catalog::removeTableFromMap(const string& tableName,
 
   tableDescriptorMapById_.erase(tableDescIt);
   tableDescriptorMap_.erase(to_upper(tableName));
+  Data_Namespace::clearTableCachePolicy(currentDB_.dbId, tableId);
   if (td->fragmenter != nullptr) {
     delete td->fragmenter;
   }
@@ -1660,6 +1718,7 @@ void Catalog::getDictionary(const ColumnDescriptor& cd,
 
 void Catalog::addColumn(const TableDescriptor& td, ColumnDescriptor& cd) {
   // caller must handle sqlite/chunk transaction TOGETHER
+  bumpMetadataVersion();
   cd.tableId = td.tableId;
   if (cd.columnType.get_compression() == kENCODING_DICT) {
     addDictionary(cd);
@@ -1952,9 +2011,10 @@ void Catalog::createTable(
           "frag_type, max_frag_rows, "
           "max_chunk_size, "
           "frag_page_size, max_rows, partitions, shard_column_id, shard, num_shards, "
-          "sort_column_id, "
+          "sort_column_id, cache_policy, unique_key_column_id, retention_column_id, "
+          "retention_seconds, "
           "key_metainfo) VALUES (?, ?, ?, "
-          "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+          "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
 
           std::vector<std::string>{td.tableName,
                                    std::to_string(td.userId),
@@ -1971,6 +2031,10 @@ void Catalog::createTable(
                                    std::to_string(td.shard),
                                    std::to_string(td.nShards),
                                    std::to_string(td.sortedColumnId),
+                                   std::to_string(static_cast<int>(td.cachePolicy)),
+                                   std::to_string(td.uniqueKeyColumnId),
+                                   std::to_string(td.retentionColumnId),
+                                   std::to_string(td.retentionSeconds),
                                    td.keyMetainfo});
 
       // now get the auto generated tableid
@@ -2550,6 +2614,7 @@ void Catalog::doDropTable(const TableDescriptor* td) {
 void Catalog::renamePhysicalTable(const TableDescriptor* td, const string& newTableName) {
   cat_write_lock write_lock(this);
   cat_sqlite_lock sqlite_lock(this);
+  bumpMetadataVersion();
 
   sqliteConnector_.query("BEGIN TRANSACTION");
   try {
@@ -2573,6 +2638,54 @@ void Catalog::renamePhysicalTable(const TableDescriptor* td, const string& newTa
   calciteMgr_->updateMetadata(currentDB_.dbName, td->tableName);
 }
 
+void Catalog::setTableCachePolicy(const TableDescriptor* td,
+                                  const Data_Namespace::TableCachePolicy policy) {
+  cat_write_lock write_lock(this);
+  cat_sqlite_lock sqlite_lock(this);
+  bumpMetadataVersion();
+
+  // apply to all corresponding physical tables if this is a logical table
+  std::vector<const TableDescriptor*> tds;
+  const auto physicalTableIt = logicalToPhysicalTableMapById_.find(td->tableId);
+  if (physicalTableIt != logicalToPhysicalTableMapById_.end()) {
+    for (const auto physical_tb_id : physicalTableIt->second) {
+      const TableDescriptor* phys_td = getMetadataForTable(physical_tb_id);
+      CHECK(phys_td);
+      tds.push_back(phys_td);
+    }
+  }
+  tds.push_back(td);
+
+  sqliteConnector_.query("BEGIN TRANSACTION");
+  try {
+    for (const auto crt_td : tds) {
+      sqliteConnector_.query_with_text_params(
+          "UPDATE mapd_tables SET cache_policy = ? WHERE tableid = ?",
+          std::vector<std::string>{std::to_string(static_cast<int>(policy)),
+                                   std::to_string(crt_td->tableId)});
+    }
+  } catch (std::exception& e) {
+    sqliteConnector_.query("ROLLBACK TRANSACTION");
+    throw;
+  }
+  sqliteConnector_.query("END TRANSACTION");
+
+  for (const auto crt_td : tds) {
+    auto tableDescIt = tableDescriptorMapById_.find(crt_td->tableId);
+    CHECK(tableDescIt != tableDescriptorMapById_.end());
+    tableDescIt->second->cachePolicy = policy;
+    Data_Namespace::setTableCachePolicy(currentDB_.dbId, crt_td->tableId, policy);
+    if (policy == Data_Namespace::CACHE_BYPASS &&
+        crt_td->persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
+      // Flush what's already cached so the policy takes effect immediately.
+      // Temporary tables persist at the CPU level, so they keep their chunks.
+      const ChunkKey chunkKeyPrefix{currentDB_.dbId, crt_td->tableId};
+      dataMgr_->deleteChunksWithPrefix(chunkKeyPrefix, MemoryLevel::CPU_LEVEL);
+      dataMgr_->deleteChunksWithPrefix(chunkKeyPrefix, MemoryLevel::GPU_LEVEL);
+    }
+  }
+}
+
 void Catalog::renameTable(const TableDescriptor* td, const string& newTableName) {
   {
     cat_write_lock write_lock(this);
@@ -2618,6 +2731,7 @@ void Catalog::renameColumn(const TableDescriptor* td,
                            const string& newColumnName) {
   cat_write_lock write_lock(this);
   cat_sqlite_lock sqlite_lock(this);
+  bumpMetadataVersion();
   sqliteConnector_.query("BEGIN TRANSACTION");
   try {
     for (int i = 0; i <= cd->columnType.get_physical_cols(); ++i) {
@@ -2786,6 +2900,95 @@ void Catalog::replaceDashboard(DashboardDescriptor& vd) {
       vd.dashboardMetadata, vd.userId, vd.dashboardSystemRoleName);
 }
 
+void Catalog::createMaterializedView(const MaterializedViewRecord& record) {
+  cat_write_lock write_lock(this);
+  cat_sqlite_lock sqlite_lock(this);
+  sqliteConnector_.query("BEGIN TRANSACTION");
+  try {
+    sqliteConnector_.query_with_text_params(
+        "INSERT INTO mapd_materialized_views (viewname, basename, select_query, "
+        "last_refresh_row_count, needs_full_refresh) VALUES (?, ?, ?, ?, 0)",
+        std::vector<std::string>{record.viewName,
+                                 record.baseTableName,
+                                 record.selectQuery,
+                                 std::to_string(record.lastRefreshRowCount)});
+  } catch (const std::exception& e) {
+    sqliteConnector_.query("ROLLBACK TRANSACTION");
+    throw;
+  }
+  sqliteConnector_.query("END TRANSACTION");
+}
+
+void Catalog::dropMaterializedViews(const std::string& table_name) {
+  cat_write_lock write_lock(this);
+  cat_sqlite_lock sqlite_lock(this);
+  sqliteConnector_.query_with_text_params(
+      "DELETE FROM mapd_materialized_views WHERE viewname = ? OR basename = ?",
+      std::vector<std::string>{table_name, table_name});
+}
+
+void Catalog::updateMaterializedViewWatermark(const std::string& view_name,
+                                              const int64_t row_count) {
+  cat_write_lock write_lock(this);
+  cat_sqlite_lock sqlite_lock(this);
+  sqliteConnector_.query_with_text_params(
+      "UPDATE mapd_materialized_views SET last_refresh_row_count = ?, "
+      "needs_full_refresh = 0 WHERE viewname = ?",
+      std::vector<std::string>{std::to_string(row_count), view_name});
+}
+
+void Catalog::invalidateMaterializedViewWatermarks(const std::string& base_table_name) {
+  cat_sqlite_lock sqlite_lock(this);
+  // called on every in-place DML commit and fragment drop, so keep the common
+  // case - no views over the table - a read-only probe
+  sqliteConnector_.query_with_text_params(
+      "SELECT viewname FROM mapd_materialized_views WHERE basename = ? AND "
+      "needs_full_refresh = 0",
+      std::vector<std::string>{base_table_name});
+  if (sqliteConnector_.getNumRows() == 0) {
+    return;
+  }
+  sqliteConnector_.query_with_text_params(
+      "UPDATE mapd_materialized_views SET needs_full_refresh = 1 WHERE basename = ?",
+      std::vector<std::string>{base_table_name});
+}
+
+std::vector<MaterializedViewRecord> Catalog::getMaterializedViews(
+    const std::string& base_table_name) {
+  cat_sqlite_lock sqlite_lock(this);
+  sqliteConnector_.query_with_text_params(
+      "SELECT viewname, basename, select_query, last_refresh_row_count, "
+      "needs_full_refresh FROM mapd_materialized_views WHERE basename = ?",
+      std::vector<std::string>{base_table_name});
+  std::vector<MaterializedViewRecord> records;
+  for (size_t i = 0; i < sqliteConnector_.getNumRows(); ++i) {
+    records.push_back(MaterializedViewRecord{sqliteConnector_.getData<std::string>(i, 0),
+                                             sqliteConnector_.getData<std::string>(i, 1),
+                                             sqliteConnector_.getData<std::string>(i, 2),
+                                             sqliteConnector_.getData<int64_t>(i, 3),
+                                             sqliteConnector_.getData<bool>(i, 4)});
+  }
+  return records;
+}
+
+bool Catalog::getMaterializedView(const std::string& view_name,
+                                  MaterializedViewRecord& record) {
+  cat_sqlite_lock sqlite_lock(this);
+  sqliteConnector_.query_with_text_params(
+      "SELECT viewname, basename, select_query, last_refresh_row_count, "
+      "needs_full_refresh FROM mapd_materialized_views WHERE viewname = ?",
+      std::vector<std::string>{view_name});
+  if (sqliteConnector_.getNumRows() == 0) {
+    return false;
+  }
+  record = MaterializedViewRecord{sqliteConnector_.getData<std::string>(0, 0),
+                                  sqliteConnector_.getData<std::string>(0, 1),
+                                  sqliteConnector_.getData<std::string>(0, 2),
+                                  sqliteConnector_.getData<int64_t>(0, 3),
+                                  sqliteConnector_.getData<bool>(0, 4)};
+  return true;
+}
+
 std::string Catalog::calculateSHA1(const std::string& data) {
   boost::uuids::detail::sha1 sha1;
   unsigned int digest[5];
@@ -2888,8 +3091,24 @@ int Catalog::getLogicalTableId(const int physicalTableId) const {
 void Catalog::checkpoint(const int logicalTableId) const {
   const auto td = getMetadataForTable(logicalTableId);
   const auto shards = getPhysicalTablesDescriptors(td);
+  if (shards.size() == 1) {
+    getDataMgr().checkpoint(getCurrentDB().dbId, shards.front()->tableId);
+    return;
+  }
+  // Each shard has its own file manager and epoch, so their checkpoints can
+  // flush concurrently; a sharded table commits in the time of its slowest
+  // shard instead of the sum.
+  std::vector<std::future<void>> checkpoint_threads;
   for (const auto shard : shards) {
-    getDataMgr().checkpoint(getCurrentDB().dbId, shard->tableId);
+    checkpoint_threads.push_back(std::async(std::launch::async, [this, shard] {
+      getDataMgr().checkpoint(getCurrentDB().dbId, shard->tableId);
+    }));
+  }
+  for (auto& checkpoint_thread : checkpoint_threads) {
+    checkpoint_thread.wait();
+  }
+  for (auto& checkpoint_thread : checkpoint_threads) {
+    checkpoint_thread.get();
   }
 }
 
@@ -2976,6 +3195,14 @@ void Catalog::remove(const std::string& dbName) {
   mapd_cat_map_.erase(dbName);
 }
 
+std::vector<std::shared_ptr<Catalog>> Catalog::getAllCatalogs() {
+  std::vector<std::shared_ptr<Catalog>> catalogs;
+  for (const auto& name_and_cat : mapd_cat_map_) {
+    catalogs.push_back(name_and_cat.second);
+  }
+  return catalogs;
+}
+
 void Catalog::vacuumDeletedRows(const int logicalTableId) const {
   // shard here to serve request from TableOptimizer and elsewhere
   cat_read_lock read_lock(this);
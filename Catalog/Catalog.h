@@ -72,6 +72,22 @@ class SharedDictionaryDef;
 
 namespace Catalog_Namespace {
 
+/**
+ * @type MaterializedViewRecord
+ * @brief catalog bookkeeping for a materialized view: the view and base table
+ * names, the view's defining query, and the base table row count the view has
+ * rolled up so far. needsFullRefresh is raised whenever the base table changes
+ * in a way that is not a pure append (update, delete, vacuum, fragment drops),
+ * after which the watermark no longer delimits the unrolled rows.
+ */
+struct MaterializedViewRecord {
+  std::string viewName;
+  std::string baseTableName;
+  std::string selectQuery;
+  int64_t lastRefreshRowCount;
+  bool needsFullRefresh;
+};
+
 /**
  * @type Catalog
  * @brief class for a per-database catalog.  also includes metadata for the
@@ -114,11 +130,28 @@ class Catalog {
       const std::list<ColumnDescriptor>& columns,
       const std::vector<Parser::SharedDictionaryDef>& shared_dict_defs);
   int32_t createDashboard(DashboardDescriptor& vd);
+  void createMaterializedView(const MaterializedViewRecord& record);
+  // Forgets every materialized view the table participates in, as base or as
+  // view.
+  void dropMaterializedViews(const std::string& table_name);
+  // Records a successful refresh: the view has rolled up the base table up to
+  // row_count rows, and any pending full-refresh request is satisfied.
+  void updateMaterializedViewWatermark(const std::string& view_name,
+                                       const int64_t row_count);
+  // Flags every view over the base table for a full refresh; called from the
+  // DML and fragment-drop paths which move or rewrite rows in place.
+  void invalidateMaterializedViewWatermarks(const std::string& base_table_name);
+  std::vector<MaterializedViewRecord> getMaterializedViews(
+      const std::string& base_table_name);
+  bool getMaterializedView(const std::string& view_name,
+                           MaterializedViewRecord& record);
   void replaceDashboard(DashboardDescriptor& vd);
   std::string createLink(LinkDescriptor& ld, size_t min_length);
   void dropTable(const TableDescriptor* td);
   void truncateTable(const TableDescriptor* td);
   void renameTable(const TableDescriptor* td, const std::string& newTableName);
+  void setTableCachePolicy(const TableDescriptor* td,
+                           const Data_Namespace::TableCachePolicy policy);
   void renameColumn(const TableDescriptor* td,
                     const ColumnDescriptor* cd,
                     const std::string& newColumnName);
@@ -191,6 +224,11 @@ class Catalog {
   void setTableEpoch(const int db_id, const int table_id, const int new_epoch);
   int getDatabaseId() const { return currentDB_.dbId; }
 
+  // Monotonic counter bumped on every schema mutation (table, column and view
+  // DDL). Lets callers cache metadata derived from this catalog and cheaply
+  // detect staleness instead of re-walking the descriptor maps.
+  uint64_t getMetadataVersion() const { return metadata_version_.load(); }
+
   SqliteConnector& getSqliteConnector() { return sqliteConnector_; }
   void roll(const bool forward);
   DictRef addDictionary(ColumnDescriptor& cd);
@@ -207,6 +245,7 @@ class Catalog {
                                       std::shared_ptr<Calcite> calcite,
                                       bool is_new_db);
   static void remove(const std::string& dbName);
+  static std::vector<std::shared_ptr<Catalog>> getAllCatalogs();
 
   const bool checkMetadataForDeletedRecs(int dbId, int tableId, int columnId) const;
   const ColumnDescriptor* getDeletedColumn(const TableDescriptor* td) const;
@@ -251,6 +290,7 @@ class Catalog {
   void updatePageSize();
   void updateDeletedColumnIndicator();
   void updateFrontendViewsToDashboards();
+  void updateMaterializedViewsSchema();
   void recordOwnershipOfObjectsInObjectPermissions();
   void checkDateInDaysColumnMigration();
   void createDashboardSystemRoles();
@@ -296,6 +336,8 @@ class Catalog {
 
   const int getColumnIdBySpiUnlocked(const int table_id, const size_t spi) const;
 
+  void bumpMetadataVersion() { metadata_version_++; }
+
   std::string basePath_;
   TableDescriptorMap tableDescriptorMap_;
   TableDescriptorMapById tableDescriptorMapById_;
@@ -326,6 +368,8 @@ class Catalog {
       std::vector<std::pair<ColumnDescriptor*, ColumnDescriptor*>>;
   ColumnDescriptorsForRoll columnDescriptorsForRoll;
 
+  std::atomic<uint64_t> metadata_version_{0};
+
  private:
   static std::map<std::string, std::shared_ptr<Catalog>> mapd_cat_map_;
   DeletedColumnPerTableMap deletedColumnPerTable_;
@@ -17,6 +17,9 @@
 #ifndef RW_LOCKS_H
 #define RW_LOCKS_H
 
+#include <mutex>
+
+#include "../Shared/LockWaitStats.h"
 #include "../Shared/mapd_shared_mutex.h"
 
 namespace Catalog_Namespace {
@@ -44,7 +47,8 @@ class read_lock {
     std::thread::id tid = std::this_thread::get_id();
 
     if (cat->thread_holding_write_lock != tid && !inner_type::thread_holds_read_lock) {
-      lock = mapd_shared_lock<mapd_shared_mutex>(cat->sharedMutex_);
+      lock = mapd_shared_lock<mapd_shared_mutex>(cat->sharedMutex_, std::defer_lock);
+      lock_wait_stats::acquire_timed(lock, lock_wait_stats::Subsystem::kCatalog);
       inner_type::thread_holds_read_lock = true;
       holds_lock = true;
     }
@@ -74,7 +78,8 @@ class sqlite_lock {
     std::thread::id tid = std::this_thread::get_id();
 
     if (cat->thread_holding_sqlite_lock != tid) {
-      lock = std::unique_lock<std::mutex>(cat->sqliteMutex_);
+      lock = std::unique_lock<std::mutex>(cat->sqliteMutex_, std::defer_lock);
+      lock_wait_stats::acquire_timed(lock, lock_wait_stats::Subsystem::kCatalog);
       cat->thread_holding_sqlite_lock = tid;
       holds_lock = true;
     }
@@ -104,7 +109,8 @@ class write_lock {
     std::thread::id tid = std::this_thread::get_id();
 
     if (cat->thread_holding_write_lock != tid) {
-      lock = mapd_unique_lock<mapd_shared_mutex>(cat->sharedMutex_);
+      lock = mapd_unique_lock<mapd_shared_mutex>(cat->sharedMutex_, std::defer_lock);
+      lock_wait_stats::acquire_timed(lock, lock_wait_stats::Subsystem::kCatalog);
       cat->thread_holding_write_lock = tid;
       holds_lock = true;
     }
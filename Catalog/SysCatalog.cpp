@@ -138,6 +138,7 @@ void SysCatalog::init(const std::string& basePath,
     buildRoleMap();
     buildUserRoleMap();
     buildObjectDescriptorMap();
+    buildUserMetadataMap();
   }
 }
 
@@ -731,6 +732,7 @@ void SysCatalog::createUser(const string& name,
                             const std::string& dbname) {
   sys_write_lock write_lock(this);
   sys_sqlite_lock sqlite_lock(this);
+  bumpPrivilegesVersion();
 
   UserMetadata user;
   if (getMetadataForUser(name, user)) {
@@ -769,11 +771,13 @@ void SysCatalog::createUser(const string& name,
     throw;
   }
   sqliteConnector_->query("END TRANSACTION");
+  buildUserMetadataMap();
 }
 
 void SysCatalog::dropUser(const string& name) {
   sys_write_lock write_lock(this);
   sys_sqlite_lock sqlite_lock(this);
+  bumpPrivilegesVersion();
 
   sqliteConnector_->query("BEGIN TRANSACTION");
   try {
@@ -795,6 +799,7 @@ void SysCatalog::dropUser(const string& name) {
     throw;
   }
   sqliteConnector_->query("END TRANSACTION");
+  buildUserMetadataMap();
 }
 
 namespace {  // anonymous namespace
@@ -812,7 +817,9 @@ void SysCatalog::alterUser(const int32_t userid,
                            const string* passwd,
                            bool* issuper,
                            const string* dbname) {
+  sys_write_lock write_lock(this);
   sys_sqlite_lock sqlite_lock(this);
+  bumpPrivilegesVersion();
   sqliteConnector_->query("BEGIN TRANSACTION");
   try {
     string sql;
@@ -850,6 +857,7 @@ void SysCatalog::alterUser(const int32_t userid,
     throw;
   }
   sqliteConnector_->query("END TRANSACTION");
+  buildUserMetadataMap();
 }
 
 auto SysCatalog::yieldTransactionStreamer() {
@@ -891,6 +899,7 @@ void SysCatalog::renameUser(std::string const& old_name, std::string const& new_
   using namespace std::string_literals;
   sys_write_lock write_lock(this);
   sys_sqlite_lock sqlite_lock(this);
+  bumpPrivilegesVersion();
 
   UserMetadata old_user;
   if (!getMetadataForUser(old_name, old_user)) {
@@ -912,6 +921,7 @@ void SysCatalog::renameUser(std::string const& old_name, std::string const& new_
   auto failure_handler = [] {};
   auto success_handler = [this, &old_name, &new_name] {
     updateUserRoleName(old_name, new_name);
+    buildUserMetadataMap();
   };
   auto q1 = {"UPDATE mapd_users SET name=?1 where name=?2;"s, new_name, old_name};
   auto q2 = {"UPDATE mapd_object_permissions set roleName=?1 WHERE roleName=?2;"s,
@@ -925,6 +935,7 @@ void SysCatalog::renameDatabase(std::string const& old_name,
   using namespace std::string_literals;
   sys_write_lock write_lock(this);
   sys_sqlite_lock sqlite_lock(this);
+  bumpPrivilegesVersion();
 
   DBMetadata new_db;
   if (getMetadataForDB(new_name, new_db)) {
@@ -967,6 +978,9 @@ void SysCatalog::renameDatabase(std::string const& old_name,
 void SysCatalog::createDatabase(const string& name, int owner) {
   sys_write_lock write_lock(this);
   sys_sqlite_lock sqlite_lock(this);
+  // also fences cached metadata responses built against a previous database
+  // of the same name, whose fresh catalog restarts its version counter
+  bumpPrivilegesVersion();
 
   DBMetadata db;
   if (getMetadataForDB(name, db)) {
@@ -1062,6 +1076,7 @@ void SysCatalog::createDatabase(const string& name, int owner) {
 void SysCatalog::dropDatabase(const DBMetadata& db) {
   sys_write_lock write_lock(this);
   sys_sqlite_lock sqlite_lock(this);
+  bumpPrivilegesVersion();
   auto cat =
       Catalog::get(basePath_, db, dataMgr_, string_dict_hosts_, calciteMgr_, false);
   sqliteConnector_->query("BEGIN TRANSACTION");
@@ -1100,6 +1115,8 @@ void SysCatalog::dropDatabase(const DBMetadata& db) {
     throw;
   }
   sqliteConnector_->query("END TRANSACTION");
+  // the drop cleared default_db references to this database
+  buildUserMetadataMap();
 }
 
 // checkPasswordForUser() with no EE code
@@ -1132,43 +1149,45 @@ bool SysCatalog::checkPasswordForUserImpl(const std::string& passwd,
   return true;
 }
 
-bool SysCatalog::getMetadataForUser(const string& name, UserMetadata& user) {
+void SysCatalog::buildUserMetadataMap() {
+  sys_write_lock write_lock(this);
   sys_sqlite_lock sqlite_lock(this);
-  sqliteConnector_->query_with_text_param(
-      "SELECT userid, name, passwd_hash, issuper, default_db FROM mapd_users WHERE name "
-      "= ?",
-      name);
+  userMetadataMap_.clear();
+  userMetadataMapById_.clear();
+  sqliteConnector_->query(
+      "SELECT userid, name, passwd_hash, issuper, default_db FROM mapd_users");
   int numRows = sqliteConnector_->getNumRows();
-  if (numRows == 0) {
+  for (int r = 0; r < numRows; ++r) {
+    UserMetadata user;
+    user.userId = sqliteConnector_->getData<int>(r, 0);
+    user.userName = sqliteConnector_->getData<string>(r, 1);
+    user.passwd_hash = sqliteConnector_->getData<string>(r, 2);
+    user.isSuper = sqliteConnector_->getData<bool>(r, 3);
+    user.isReallySuper = user.isSuper;
+    user.defaultDbId =
+        sqliteConnector_->isNull(r, 4) ? -1 : sqliteConnector_->getData<int>(r, 4);
+    userMetadataMap_[user.userName] = user;
+    userMetadataMapById_[user.userId] = user;
+  }
+}
+
+bool SysCatalog::getMetadataForUser(const string& name, UserMetadata& user) {
+  sys_read_lock read_lock(this);
+  const auto user_it = userMetadataMap_.find(name);
+  if (user_it == userMetadataMap_.end()) {
     return false;
   }
-  user.userId = sqliteConnector_->getData<int>(0, 0);
-  user.userName = sqliteConnector_->getData<string>(0, 1);
-  user.passwd_hash = sqliteConnector_->getData<string>(0, 2);
-  user.isSuper = sqliteConnector_->getData<bool>(0, 3);
-  user.isReallySuper = user.isSuper;
-  user.defaultDbId =
-      sqliteConnector_->isNull(0, 4) ? -1 : sqliteConnector_->getData<int>(0, 4);
+  user = user_it->second;
   return true;
 }
 
 bool SysCatalog::getMetadataForUserById(const int32_t idIn, UserMetadata& user) {
-  sys_sqlite_lock sqlite_lock(this);
-  sqliteConnector_->query_with_text_param(
-      "SELECT userid, name, passwd_hash, issuper, default_db FROM mapd_users WHERE "
-      "userid = ?",
-      std::to_string(idIn));
-  int numRows = sqliteConnector_->getNumRows();
-  if (numRows == 0) {
+  sys_read_lock read_lock(this);
+  const auto user_it = userMetadataMapById_.find(idIn);
+  if (user_it == userMetadataMapById_.end()) {
     return false;
   }
-  user.userId = sqliteConnector_->getData<int>(0, 0);
-  user.userName = sqliteConnector_->getData<string>(0, 1);
-  user.passwd_hash = sqliteConnector_->getData<string>(0, 2);
-  user.isSuper = sqliteConnector_->getData<bool>(0, 3);
-  user.isReallySuper = user.isSuper;
-  user.defaultDbId =
-      sqliteConnector_->isNull(0, 4) ? -1 : sqliteConnector_->getData<int>(0, 4);
+  user = user_it->second;
   return true;
 }
 
@@ -2082,6 +2101,8 @@ void SysCatalog::execInTransaction(F&& f, Args&&... args) {
     throw;
   }
   sqliteConnector_->query("END TRANSACTION");
+  // every transactional mutation here is a role or privilege change
+  bumpPrivilegesVersion();
 }
 
 void SysCatalog::createRole(const std::string& roleName, const bool& userPrivateRole) {
@@ -237,6 +237,10 @@ class SysCatalog : private CommonFileOperations {
   void revokeDashboardSystemRole(const std::string roleName,
                                  const std::vector<std::string> grantees);
   bool isAggregator() const { return aggregator_; }
+  // Monotonic counter bumped whenever users, roles or object privileges
+  // change. Lets callers cache privilege-filtered metadata and cheaply detect
+  // staleness.
+  uint64_t getPrivilegesVersion() const { return privileges_version_.load(); }
   static SysCatalog& instance() {
     static SysCatalog sys_cat{};
     return sys_cat;
@@ -258,6 +262,11 @@ class SysCatalog : private CommonFileOperations {
  private:
   typedef std::map<std::string, Grantee*> GranteeMap;
   typedef std::multimap<std::string, ObjectRoleDescriptor*> ObjectRoleDescriptorMap;
+  // Write-through cache of mapd_users, keyed by exact user name and by user id.
+  // Reads go through the in-memory maps under the shared lock; SQLite is only
+  // touched by the DDL paths, which rebuild the maps after committing.
+  typedef std::map<std::string, UserMetadata> UserMetadataMap;
+  typedef std::map<int32_t, UserMetadata> UserMetadataMapById;
 
   SysCatalog()
       : CommonFileOperations(basePath_)
@@ -272,6 +281,7 @@ class SysCatalog : private CommonFileOperations {
   void buildRoleMap();
   void buildUserRoleMap();
   void buildObjectDescriptorMap();
+  void buildUserMetadataMap();
   void checkAndExecuteMigrations();
   void importDataFromOldMapdDB();
   void createUserRoles();
@@ -335,6 +345,8 @@ class SysCatalog : private CommonFileOperations {
   std::string basePath_;
   GranteeMap granteeMap_;
   ObjectRoleDescriptorMap objectDescriptorMap_;
+  UserMetadataMap userMetadataMap_;
+  UserMetadataMapById userMetadataMapById_;
   std::unique_ptr<SqliteConnector> sqliteConnector_;
 
   std::shared_ptr<Data_Namespace::DataMgr> dataMgr_;
@@ -344,6 +356,9 @@ class SysCatalog : private CommonFileOperations {
   std::shared_ptr<Calcite> calciteMgr_;
   std::vector<LeafHostInfo> string_dict_hosts_;
   bool aggregator_;
+  std::atomic<uint64_t> privileges_version_{0};
+
+  void bumpPrivilegesVersion() { privileges_version_++; }
 
   auto yieldTransactionStreamer();
 
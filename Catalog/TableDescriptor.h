@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <string>
 #include "../DataMgr/MemoryLevel.h"
+#include "../DataMgr/TableCachePolicy.h"
 #include "../Fragmenter/AbstractFragmenter.h"
 #include "../Shared/sqldefs.h"
 
@@ -55,7 +56,15 @@ struct TableDescriptor {
       nShards;  // # of shards, i.e. physical tables for this logical table (default: 0)
   int shardedColumnId;  // Id of the column to be sharded on
   int sortedColumnId;   // Id of the column to be sorted on
+  int uniqueKeyColumnId;  // Id of the declared unique key column (0 = none); inserts
+                          // into the table upsert on this key
+  int retentionColumnId;      // Id of the timestamp/date column retention is keyed on
+                              // (0 = no retention)
+  int64_t retentionSeconds;   // rows older than this are aged out by whole-fragment
+                              // drops (0 = keep forever)
   Data_Namespace::MemoryLevel persistenceLevel;
+  Data_Namespace::TableCachePolicy
+      cachePolicy;     // buffer pool caching policy (CACHE_POLICY = NORMAL|PIN|BYPASS)
   bool hasDeletedCol;  // Does table has a delete col, Yes (VACUUM = DELAYED)
                        //                              No  (VACUUM = IMMEDIATE)
   // Spi means Sequential Positional Index which is equivalent to the input index in a
@@ -71,7 +80,11 @@ struct TableDescriptor {
       , nShards(0)
       , shardedColumnId(0)
       , sortedColumnId(0)
+      , uniqueKeyColumnId(0)
+      , retentionColumnId(0)
+      , retentionSeconds(0)
       , persistenceLevel(Data_Namespace::MemoryLevel::DISK_LEVEL)
+      , cachePolicy(Data_Namespace::CACHE_NORMAL)
       , hasDeletedCol(true)
       , mutex_(std::make_shared<std::mutex>()) {}
 };
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <stdexcept>
 #include "Shared/Logger.h"
+#include "Shared/nvtx_helpers.h"
 
 namespace CudaMgr_Namespace {
 
@@ -38,6 +39,7 @@ CudaMgr::CudaMgr(const int num_gpus, const int start_gpu)
   }
   fillDeviceProperties();
   createDeviceContexts();
+  enablePeerAccess();
   printDeviceProperties();
 }
 
@@ -73,6 +75,8 @@ void CudaMgr::copyHostToDevice(int8_t* device_ptr,
                                const int8_t* host_ptr,
                                const size_t num_bytes,
                                const int device_num) {
+  NVTX_RANGE("copyHostToDevice " + std::to_string(num_bytes) + " bytes to device " +
+             std::to_string(device_num));
   setContext(device_num);
   checkError(
       cuMemcpyHtoD(reinterpret_cast<CUdeviceptr>(device_ptr), host_ptr, num_bytes));
@@ -82,6 +86,8 @@ void CudaMgr::copyDeviceToHost(int8_t* host_ptr,
                                const int8_t* device_ptr,
                                const size_t num_bytes,
                                const int device_num) {
+  NVTX_RANGE("copyDeviceToHost " + std::to_string(num_bytes) + " bytes from device " +
+             std::to_string(device_num));
   setContext(device_num);
   checkError(
       cuMemcpyDtoH(host_ptr, reinterpret_cast<const CUdeviceptr>(device_ptr), num_bytes));
@@ -94,6 +100,9 @@ void CudaMgr::copyDeviceToDevice(int8_t* dest_ptr,
                                  const int src_device_num) {
   // dest_device_num and src_device_num are the device numbers relative to start_gpu_
   // (real_device_num - start_gpu_)
+  NVTX_RANGE("copyDeviceToDevice " + std::to_string(num_bytes) + " bytes from device " +
+             std::to_string(src_device_num) + " to device " +
+             std::to_string(dest_device_num));
   if (src_device_num == dest_device_num) {
     setContext(src_device_num);
     checkError(cuMemcpy(reinterpret_cast<CUdeviceptr>(dest_ptr),
@@ -108,6 +117,41 @@ void CudaMgr::copyDeviceToDevice(int8_t* dest_ptr,
   }
 }
 
+bool CudaMgr::canAccessPeer(const int dst_device_num, const int src_device_num) const {
+  CHECK_LT(dst_device_num, device_count_);
+  CHECK_LT(src_device_num, device_count_);
+  return peer_access_[dst_device_num][src_device_num];
+}
+
+void CudaMgr::exchangeDeviceBuffers(const std::vector<PeerCopySpec>& copies) {
+  NVTX_RANGE("exchangeDeviceBuffers " + std::to_string(copies.size()) + " copies");
+  // One stream per source device so copies leaving different GPUs run
+  // concurrently; a DGX-style all-to-all then saturates every NVLink link at
+  // once instead of serializing behind a single synchronous cuMemcpyPeer.
+  std::vector<CUstream> streams(device_count_, nullptr);
+  for (const auto& copy : copies) {
+    CHECK_LT(copy.src_device_num, device_count_);
+    CHECK_LT(copy.dst_device_num, device_count_);
+    setContext(copy.src_device_num);
+    if (!streams[copy.src_device_num]) {
+      checkError(cuStreamCreate(&streams[copy.src_device_num], CU_STREAM_NON_BLOCKING));
+    }
+    checkError(cuMemcpyPeerAsync(reinterpret_cast<CUdeviceptr>(copy.dst),
+                                 device_contexts_[copy.dst_device_num],
+                                 reinterpret_cast<CUdeviceptr>(copy.src),
+                                 device_contexts_[copy.src_device_num],
+                                 copy.num_bytes,
+                                 streams[copy.src_device_num]));
+  }
+  for (int d = 0; d < device_count_; ++d) {
+    if (streams[d]) {
+      setContext(d);
+      checkError(cuStreamSynchronize(streams[d]));
+      checkError(cuStreamDestroy(streams[d]));
+    }
+  }
+}
+
 void CudaMgr::loadGpuModuleData(CUmodule* module,
                                 const void* image,
                                 unsigned int num_options,
@@ -209,6 +253,24 @@ int8_t* CudaMgr::allocateDeviceMem(const size_t num_bytes, const int device_num)
   return reinterpret_cast<int8_t*>(device_ptr);
 }
 
+int8_t* CudaMgr::allocateManagedMem(const size_t num_bytes, const int device_num) {
+  setContext(device_num);
+  CUdeviceptr device_ptr;
+  checkError(cuMemAllocManaged(&device_ptr, num_bytes, CU_MEM_ATTACH_GLOBAL));
+  if (device_properties_[device_num].computeMajor >= 6) {
+    // Tell the driver these pages belong on the device so only the true
+    // overflow gets evicted to host under memory pressure, and fault them in
+    // up front rather than one page at a time from the first kernel. Both
+    // hints need Pascal's hardware page faulting; on older parts the
+    // allocation still works, it is just migrated wholesale by the driver.
+    const auto device = device_properties_[device_num].device;
+    checkError(cuMemAdvise(
+        device_ptr, num_bytes, CU_MEM_ADVISE_SET_PREFERRED_LOCATION, device));
+    checkError(cuMemPrefetchAsync(device_ptr, num_bytes, device, 0));
+  }
+  return reinterpret_cast<int8_t*>(device_ptr);
+}
+
 void CudaMgr::freePinnedHostMem(int8_t* host_ptr) {
   checkError(cuMemFreeHost(reinterpret_cast<void*>(host_ptr)));
 }
@@ -296,6 +358,39 @@ void CudaMgr::createDeviceContexts() {
   }
 }
 
+void CudaMgr::enablePeerAccess() {
+  peer_access_.assign(device_count_, std::vector<bool>(device_count_, false));
+  size_t peer_pairs = 0;
+  for (int d = 0; d < device_count_; ++d) {
+    peer_access_[d][d] = true;
+    setContext(d);
+    for (int p = 0; p < device_count_; ++p) {
+      if (p == d) {
+        continue;
+      }
+      int can_access{0};
+      checkError(cuDeviceCanAccessPeer(
+          &can_access, device_properties_[d].device, device_properties_[p].device));
+      if (!can_access) {
+        continue;
+      }
+      // grants the current context (device d) direct access to p's memory;
+      // already-enabled is fine, the contexts are created once at startup
+      const auto status = cuCtxEnablePeerAccess(device_contexts_[p], 0);
+      if (status != CUDA_SUCCESS && status != CUDA_ERROR_PEER_ACCESS_ALREADY_ENABLED) {
+        checkError(status);
+      }
+      peer_access_[d][p] = true;
+      peer_pairs++;
+    }
+  }
+  if (device_count_ > 1) {
+    LOG(INFO) << "Enabled direct GPU peer access for " << peer_pairs << " of "
+              << device_count_ * (device_count_ - 1)
+              << " device pairs; the rest stage inter-GPU copies through host memory";
+  }
+}
+
 void CudaMgr::setContext(const int device_num) const {
   // deviceNum is the device number relative to startGpu (realDeviceNum - startGpu_)
   CHECK_LT(device_num, device_count_);
@@ -21,6 +21,8 @@
  */
 #include "BufferMgr.h"
 #include "Buffer.h"
+#include "DataMgr/TableCachePolicy.h"
+#include "Shared/LockWaitStats.h"
 #include "Shared/Logger.h"
 #include "Shared/measure.h"
 
@@ -28,6 +30,11 @@
 #include <iomanip>
 #include <limits>
 
+// Fraction of each buffer pool PIN policy tables may occupy before their
+// chunks become evictable again; keeps a runaway pinned table from starving
+// everything else out of the pool.
+double g_pinned_table_mem_fraction{0.5};
+
 using namespace std;
 
 namespace Buffer_Namespace {
@@ -81,12 +88,14 @@ void BufferMgr::reinit() {
 
 void BufferMgr::clear() {
   std::lock_guard<std::mutex> sizedSegsLock(sizedSegsMutex_);
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  std::lock_guard<std::mutex> unsizedSegsLock(unsizedSegsMutex_);
-  for (auto bufferIt = chunkIndex_.begin(); bufferIt != chunkIndex_.end(); ++bufferIt) {
-    delete bufferIt->second->buffer;
+  for (auto& shard : chunkIndexShards_) {
+    std::lock_guard<std::mutex> shardLock(shard.mutex);
+    for (auto bufferIt = shard.index.begin(); bufferIt != shard.index.end(); ++bufferIt) {
+      delete bufferIt->second->buffer;
+    }
+    shard.index.clear();
   }
-  chunkIndex_.clear();
+  std::lock_guard<std::mutex> unsizedSegsLock(unsizedSegsMutex_);
   slabs_.clear();
   slabSegments_.clear();
   unsizedSegs_.clear();
@@ -104,36 +113,42 @@ AbstractBuffer* BufferMgr::createBuffer(const ChunkKey& chunkKey,
   }
 
   // ChunkPageSize here is just for recording dirty pages
+  auto& shard = getChunkIndexShard(chunkKey);
+  BufferList::iterator segIt;
   {
-    std::lock_guard<std::mutex> lock(chunkIndexMutex_);
-    CHECK(chunkIndex_.find(chunkKey) == chunkIndex_.end());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    CHECK(shard.index.find(chunkKey) == shard.index.end());
     BufferSeg bufferSeg(BufferSeg(-1, 0, USED));
     bufferSeg.chunkKey = chunkKey;
     std::lock_guard<std::mutex> unsizedSegsLock(unsizedSegsMutex_);
     unsizedSegs_.push_back(bufferSeg);  // race condition?
-    chunkIndex_[chunkKey] =
-        std::prev(unsizedSegs_.end(),
-                  1);  // need to do this before allocating Buffer because doing so could
-                       // change the segment used
+    segIt = std::prev(unsizedSegs_.end(),
+                      1);  // need to do this before allocating Buffer because doing so
+                           // could change the segment used
+    shard.index[chunkKey] = segIt;
   }
   // following should be safe outside the lock b/c first thing Buffer
   // constructor does is pin (and its still in unsized segs at this point
   // so can't be evicted)
   try {
-    allocateBuffer(chunkIndex_[chunkKey], actualChunkPageSize, initialSize);
+    allocateBuffer(segIt, actualChunkPageSize, initialSize);
   } catch (const OutOfMemory&) {
-    auto bufferIt = chunkIndex_.find(chunkKey);
-    CHECK(bufferIt != chunkIndex_.end());
-    bufferIt->second->buffer =
-        0;  // constructor failed for the buffer object so make sure to mark it zero so
-            // deleteBuffer doesn't try to delete it
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto bufferIt = shard.index.find(chunkKey);
+      CHECK(bufferIt != shard.index.end());
+      bufferIt->second->buffer =
+          0;  // constructor failed for the buffer object so make sure to mark it zero so
+              // deleteBuffer doesn't try to delete it
+    }
     deleteBuffer(chunkKey);
     throw;
   }
-  CHECK(initialSize == 0 || chunkIndex_[chunkKey]->buffer->getMemoryPtr());
-  // chunkIndex_[chunkKey]->buffer->pin();
-  std::lock_guard<std::mutex> lock(chunkIndexMutex_);
-  return chunkIndex_[chunkKey]->buffer;
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto bufferIt = shard.index.find(chunkKey);
+  CHECK(bufferIt != shard.index.end());
+  CHECK(initialSize == 0 || bufferIt->second->buffer->getMemoryPtr());
+  return bufferIt->second->buffer;
 }
 
 BufferList::iterator BufferMgr::evict(BufferList::iterator& evictStart,
@@ -151,7 +166,10 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evictStart,
     }
     numPages += evictIt->numPages;
     if (evictIt->memStatus == USED && evictIt->chunkKey.size() > 0) {
-      chunkIndex_.erase(evictIt->chunkKey);
+      ++numChunkEvictions_;
+      auto& shard = getChunkIndexShard(evictIt->chunkKey);
+      std::lock_guard<std::mutex> shardLock(shard.mutex);
+      shard.index.erase(evictIt->chunkKey);
     }
     evictIt = slabSegments_[slabNum].erase(
         evictIt);  // erase operations returns next iterator - safe if we ever move
@@ -226,8 +244,9 @@ BufferList::iterator BufferMgr::reserveBuffer(
   // Deincrement pin count to reverse effect above
   removeSegment(segIt);
   {
-    std::lock_guard<std::mutex> lock(chunkIndexMutex_);
-    chunkIndex_[newSegIt->chunkKey] = newSegIt;
+    auto& shard = getChunkIndexShard(newSegIt->chunkKey);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.index[newSegIt->chunkKey] = newSegIt;
   }
 
   return newSegIt;
@@ -330,7 +349,36 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t numBytes) {
     throw FailedToCreateFirstSlab(numBytes);
   }
 
-  // If here then we can't add a slab - so we need to evict
+  // Can't grow the pool - try compacting the slabs before resorting to
+  // eviction. Interleaved chunk lifetimes can leave enough total free pages
+  // for the request scattered in runs which are individually too small.
+  if (compactSlabs() >= numPagesRequested) {
+    for (size_t slabNum = 0; slabNum != numSlabs; ++slabNum) {
+      auto segIt = findFreeBufferInSlab(slabNum, numPagesRequested);
+      if (segIt != slabSegments_[slabNum].end()) {
+        return segIt;
+      }
+    }
+  }
+
+  // If here then compaction wasn't enough either - so we need to evict
+
+  // Table cache policies: chunks of PIN tables are treated as unevictable
+  // while the pool's total PIN footprint fits in the reserved quota, and
+  // chunks of BYPASS tables never raise a candidate run's score so they are
+  // always the first to go.
+  const size_t pinnedReservePages =
+      static_cast<size_t>(maxNumPages_ * g_pinned_table_mem_fraction);
+  size_t pinnedPolicyPages = 0;
+  for (const auto& slabSegs : slabSegments_) {
+    for (const auto& seg : slabSegs) {
+      if (seg.memStatus == USED &&
+          getTableCachePolicy(seg.chunkKey) == Data_Namespace::CACHE_PIN) {
+        pinnedPolicyPages += seg.numPages;
+      }
+    }
+  }
+  const bool pinQuotaAvailable = pinnedPolicyPages <= pinnedReservePages;
 
   size_t minScore = std::numeric_limits<size_t>::max();
   // We're going for lowest score here, like golf
@@ -365,6 +413,13 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t numBytes) {
         if (evictIt->memStatus == USED && evictIt->buffer->getPinCount() > 0) {
           break;
         }
+        const auto cache_policy = evictIt->memStatus == USED
+                                      ? getTableCachePolicy(evictIt->chunkKey)
+                                      : Data_Namespace::CACHE_NORMAL;
+        if (cache_policy == Data_Namespace::CACHE_PIN && pinQuotaAvailable) {
+          // Within quota a PIN chunk is as good as pinned.
+          break;
+        }
         pageCount += evictIt->numPages;
         if (evictIt->memStatus == USED) {
           // MAT changed from
@@ -374,7 +429,12 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t numBytes) {
           // chunk score was larger than one large chunk so it always would evict a large
           // chunk so under memory pressure a query would evict its own current chunks and
           // cause reloads rather than evict several smaller unused older chunks.
-          score = std::max(score, static_cast<size_t>(evictIt->lastTouched));
+          if (cache_policy == Data_Namespace::CACHE_PIN) {
+            // Over quota PIN chunks become evictable, but only as a last resort.
+            score = std::max(score, static_cast<size_t>(bufferEpoch_));
+          } else if (cache_policy != Data_Namespace::CACHE_BYPASS) {
+            score = std::max(score, static_cast<size_t>(evictIt->lastTouched));
+          }
         }
         if (pageCount >= numPagesRequested) {
           solutionFound = true;
@@ -413,6 +473,65 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t numBytes) {
   return bestEvictionStart;
 }
 
+size_t BufferMgr::compactSlabs() {
+  // Slides unpinned USED segments towards the front of their slab so the free
+  // pages coalesce behind them. Only FREE segments are erased or respliced;
+  // USED segments keep their list nodes, so the iterators held by the chunk
+  // index and by Buffer::segIt_ stay valid and nothing there needs rewriting.
+  // Pinned segments (and segments whose Buffer is still being constructed)
+  // can't be relocated and act as barriers the free run restarts after.
+  // Returns the number of pages in the largest free run after compaction.
+  size_t largestFreeNumPages = 0;
+  size_t numPagesMoved = 0;
+  for (size_t slabNum = 0; slabNum != slabSegments_.size(); ++slabNum) {
+    auto& segs = slabSegments_[slabNum];
+    auto segIt = segs.begin();
+    while (segIt != segs.end()) {
+      if (segIt->memStatus != FREE) {
+        ++segIt;
+        continue;
+      }
+      auto nextIt = std::next(segIt);
+      if (nextIt == segs.end()) {
+        largestFreeNumPages = std::max(largestFreeNumPages, segIt->numPages);
+        break;
+      }
+      if (nextIt->memStatus == FREE) {  // merge adjacent free segments
+        segIt->numPages += nextIt->numPages;
+        segs.erase(nextIt);
+        continue;
+      }
+      if (!nextIt->buffer || nextIt->buffer->getPinCount() > 0) {
+        // the free run ends at the unmovable segment
+        largestFreeNumPages = std::max(largestFreeNumPages, segIt->numPages);
+        segIt = std::next(nextIt);
+        continue;
+      }
+      // Slide the used segment left over the free gap. The regions can
+      // overlap, which moveSlabData has to handle for a move in this
+      // direction.
+      int8_t* dest = slabs_[slabNum] + segIt->startPage * pageSize_;
+      int8_t* src = slabs_[slabNum] + nextIt->startPage * pageSize_;
+      moveSlabData(dest, src, nextIt->numPages * pageSize_);
+      numPagesMoved += nextIt->numPages;
+      nextIt->startPage = segIt->startPage;
+      nextIt->buffer->mem_ = dest;
+      segIt->startPage = nextIt->startPage + nextIt->numPages;
+      // Move the free segment past the segment it swapped places with and
+      // continue the sweep from it, pushing the gap towards the slab's end.
+      segs.splice(std::next(nextIt), segs, segIt);
+    }
+  }
+  if (numPagesMoved > 0) {
+    ++numCompactions_;
+    numCompactionPagesMoved_ += numPagesMoved;
+    LOG(INFO) << "COMPACTION moved " << numPagesMoved << " pages, largest free block "
+              << largestFreeNumPages << " pages " << getStringMgrType() << ":"
+              << deviceId_;
+  }
+  return largestFreeNumPages;
+}
+
 std::string BufferMgr::printSlab(size_t slabNum) {
   std::ostringstream tss;
   // size_t lastEnd = 0;
@@ -516,6 +635,36 @@ size_t BufferMgr::getInUseSize() {
   return inUse;
 }
 
+size_t BufferMgr::getNumFreePages() {
+  size_t numFreePages = 0;
+  for (auto slabIt = slabSegments_.begin(); slabIt != slabSegments_.end(); ++slabIt) {
+    for (auto segIt = slabIt->begin(); segIt != slabIt->end(); ++segIt) {
+      if (segIt->memStatus == FREE) {
+        numFreePages += segIt->numPages;
+      }
+    }
+  }
+  return numFreePages;
+}
+
+size_t BufferMgr::getLargestFreeBlockNumPages() {
+  size_t largestFreeNumPages = 0;
+  for (auto slabIt = slabSegments_.begin(); slabIt != slabSegments_.end(); ++slabIt) {
+    // adjacent FREE segments count as one run - they only stay unmerged until
+    // the next removeSegment or compaction pass touches them
+    size_t runNumPages = 0;
+    for (auto segIt = slabIt->begin(); segIt != slabIt->end(); ++segIt) {
+      if (segIt->memStatus == FREE) {
+        runNumPages += segIt->numPages;
+        largestFreeNumPages = std::max(largestFreeNumPages, runNumPages);
+      } else {
+        runNumPages = 0;
+      }
+    }
+  }
+  return largestFreeNumPages;
+}
+
 std::string BufferMgr::printSeg(BufferList::iterator& segIt) {
   std::ostringstream tss;
   tss << "SN: " << setfill(' ') << setw(2) << segIt->slabNum;
@@ -542,14 +691,18 @@ std::string BufferMgr::printMap() {
   tss << std::endl
       << "Map Contents: "
       << " " << getStringMgrType() << ":" << deviceId_ << std::endl;
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  for (auto segIt = chunkIndex_.begin(); segIt != chunkIndex_.end(); ++segIt, ++segNum) {
-    //    tss << "Map Entry " << segNum << ": ";
-    //    for (auto vecIt = segIt->first.begin(); vecIt != segIt->first.end(); ++vecIt) {
-    //      tss << *vecIt << ",";
-    //    }
-    //    tss << " " << std::endl;
-    tss << printSeg(segIt->second);
+  for (auto& shard : chunkIndexShards_) {
+    std::lock_guard<std::mutex> chunkIndexLock(shard.mutex);
+    for (auto segIt = shard.index.begin(); segIt != shard.index.end();
+         ++segIt, ++segNum) {
+      //    tss << "Map Entry " << segNum << ": ";
+      //    for (auto vecIt = segIt->first.begin(); vecIt != segIt->first.end(); ++vecIt)
+      //    {
+      //      tss << *vecIt << ",";
+      //    }
+      //    tss << " " << std::endl;
+      tss << printSeg(segIt->second);
+    }
   }
   tss << "--------------------" << std::endl;
   return tss.str();
@@ -573,8 +726,9 @@ void BufferMgr::printSegs() {
 }
 
 bool BufferMgr::isBufferOnDevice(const ChunkKey& key) {
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  if (chunkIndex_.find(key) == chunkIndex_.end()) {
+  auto& shard = getChunkIndexShard(key);
+  std::lock_guard<std::mutex> chunkIndexLock(shard.mutex);
+  if (shard.index.find(key) == shard.index.end()) {
     return false;
   } else {
     return true;
@@ -583,15 +737,16 @@ bool BufferMgr::isBufferOnDevice(const ChunkKey& key) {
 
 /// This method throws a runtime_error when deleting a Chunk that does not exist.
 void BufferMgr::deleteBuffer(const ChunkKey& key, const bool purge) {
-  std::unique_lock<std::mutex> chunkIndexLock(chunkIndexMutex_);
+  auto& shard = getChunkIndexShard(key);
+  std::unique_lock<std::mutex> chunkIndexLock(shard.mutex);
   // Note: purge is currently unused
 
-  // lookup the buffer for the Chunk in chunkIndex_
-  auto bufferIt = chunkIndex_.find(key);
+  // lookup the buffer for the Chunk in the chunk index
+  auto bufferIt = shard.index.find(key);
   // Buffer *buffer = bufferIt->second->buffer;
-  CHECK(bufferIt != chunkIndex_.end());
+  CHECK(bufferIt != shard.index.end());
   auto segIt = bufferIt->second;
-  chunkIndex_.erase(bufferIt);
+  shard.index.erase(bufferIt);
   chunkIndexLock.unlock();
   std::lock_guard<std::mutex> sizedSegsLock(sizedSegsMutex_);
   if (segIt->buffer) {
@@ -603,30 +758,34 @@ void BufferMgr::deleteBuffer(const ChunkKey& key, const bool purge) {
 
 void BufferMgr::deleteBuffersWithPrefix(const ChunkKey& keyPrefix, const bool purge) {
   // Note: purge is unused
-  // lookup the buffer for the Chunk in chunkIndex_
+  // lookup the buffers for the Chunks in the chunk index
   std::lock_guard<std::mutex> sizedSegsLock(
       sizedSegsMutex_);  // Take this lock early to prevent deadlock with
                          // reserveBuffer which needs segsMutex_ and then
-                         // chunkIndexMutex_
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  auto startChunkIt = chunkIndex_.lower_bound(keyPrefix);
-  if (startChunkIt == chunkIndex_.end()) {
-    return;
-  }
+                         // a chunk index shard mutex
+  // Keys sharing keyPrefix remain contiguous within each shard's ordered map,
+  // so the usual lower_bound walk runs once per shard.
+  for (auto& shard : chunkIndexShards_) {
+    std::lock_guard<std::mutex> chunkIndexLock(shard.mutex);
+    auto startChunkIt = shard.index.lower_bound(keyPrefix);
+    if (startChunkIt == shard.index.end()) {
+      continue;
+    }
 
-  auto bufferIt = startChunkIt;
-  while (bufferIt != chunkIndex_.end() &&
-         std::search(bufferIt->first.begin(),
-                     bufferIt->first.begin() + keyPrefix.size(),
-                     keyPrefix.begin(),
-                     keyPrefix.end()) != bufferIt->first.begin() + keyPrefix.size()) {
-    auto segIt = bufferIt->second;
-    if (segIt->buffer) {
-      delete segIt->buffer;  // Delete Buffer for segment
-      segIt->buffer = 0;
+    auto bufferIt = startChunkIt;
+    while (bufferIt != shard.index.end() &&
+           std::search(bufferIt->first.begin(),
+                       bufferIt->first.begin() + keyPrefix.size(),
+                       keyPrefix.begin(),
+                       keyPrefix.end()) != bufferIt->first.begin() + keyPrefix.size()) {
+      auto segIt = bufferIt->second;
+      if (segIt->buffer) {
+        delete segIt->buffer;  // Delete Buffer for segment
+        segIt->buffer = 0;
+      }
+      removeSegment(segIt);
+      shard.index.erase(bufferIt++);
     }
-    removeSegment(segIt);
-    chunkIndex_.erase(bufferIt++);
   }
 }
 
@@ -662,118 +821,176 @@ void BufferMgr::removeSegment(BufferList::iterator& segIt) {
 }
 
 void BufferMgr::checkpoint() {
-  std::lock_guard<std::mutex> lock(globalMutex_);  // granular lock
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-
-  for (auto bufferIt = chunkIndex_.begin(); bufferIt != chunkIndex_.end(); ++bufferIt) {
-    if (bufferIt->second->chunkKey[0] != -1 &&
-        bufferIt->second->buffer->isDirty_) {  // checks that buffer is actual chunk (not
-                                               // just buffer) and is dirty
-
-      parentMgr_->putBuffer(bufferIt->second->chunkKey, bufferIt->second->buffer);
-      bufferIt->second->buffer->clearDirtyBits();
+  mapd_lock_guard<mapd_shared_mutex> lock(globalMutex_);  // granular lock
+
+  for (auto& shard : chunkIndexShards_) {
+    std::lock_guard<std::mutex> chunkIndexLock(shard.mutex);
+    for (auto bufferIt = shard.index.begin(); bufferIt != shard.index.end();
+         ++bufferIt) {
+      if (bufferIt->second->chunkKey[0] != -1 &&
+          bufferIt->second->buffer->isDirty_) {  // checks that buffer is actual chunk
+                                                 // (not just buffer) and is dirty
+
+        parentMgr_->putBuffer(bufferIt->second->chunkKey, bufferIt->second->buffer);
+        bufferIt->second->buffer->clearDirtyBits();
+      }
     }
   }
 }
 
 void BufferMgr::checkpoint(const int db_id, const int tb_id) {
-  std::lock_guard<std::mutex> lock(globalMutex_);  // granular lock
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
+  mapd_lock_guard<mapd_shared_mutex> lock(globalMutex_);  // granular lock
 
   ChunkKey keyPrefix;
   keyPrefix.push_back(db_id);
   keyPrefix.push_back(tb_id);
-  auto startChunkIt = chunkIndex_.lower_bound(keyPrefix);
-  if (startChunkIt == chunkIndex_.end()) {
-    return;
-  }
-
-  auto bufferIt = startChunkIt;
-  while (bufferIt != chunkIndex_.end() &&
-         std::search(bufferIt->first.begin(),
-                     bufferIt->first.begin() + keyPrefix.size(),
-                     keyPrefix.begin(),
-                     keyPrefix.end()) != bufferIt->first.begin() + keyPrefix.size()) {
-    if (bufferIt->second->chunkKey[0] != -1 &&
-        bufferIt->second->buffer->isDirty_) {  // checks that buffer is actual chunk (not
-                                               // just buffer) and is dirty
+  for (auto& shard : chunkIndexShards_) {
+    std::lock_guard<std::mutex> chunkIndexLock(shard.mutex);
+    auto startChunkIt = shard.index.lower_bound(keyPrefix);
+    if (startChunkIt == shard.index.end()) {
+      continue;
+    }
 
-      parentMgr_->putBuffer(bufferIt->second->chunkKey, bufferIt->second->buffer);
-      bufferIt->second->buffer->clearDirtyBits();
+    auto bufferIt = startChunkIt;
+    while (bufferIt != shard.index.end() &&
+           std::search(bufferIt->first.begin(),
+                       bufferIt->first.begin() + keyPrefix.size(),
+                       keyPrefix.begin(),
+                       keyPrefix.end()) != bufferIt->first.begin() + keyPrefix.size()) {
+      if (bufferIt->second->chunkKey[0] != -1 &&
+          bufferIt->second->buffer->isDirty_) {  // checks that buffer is actual chunk
+                                                 // (not just buffer) and is dirty
+
+        parentMgr_->putBuffer(bufferIt->second->chunkKey, bufferIt->second->buffer);
+        bufferIt->second->buffer->clearDirtyBits();
+      }
+      bufferIt++;
     }
-    bufferIt++;
   }
 }
 
 /// Returns a pointer to the Buffer holding the chunk, if it exists; otherwise,
 /// throws a runtime_error.
 AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t numBytes) {
-  std::lock_guard<std::mutex> lock(globalMutex_);  // granular lock
-
-  std::unique_lock<std::mutex> sizedSegsLock(sizedSegsMutex_);
-  std::unique_lock<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  auto bufferIt = chunkIndex_.find(key);
-  bool foundBuffer = bufferIt != chunkIndex_.end();
-  chunkIndexLock.unlock();
-  if (foundBuffer) {
-    CHECK(bufferIt->second->buffer);
-    bufferIt->second->buffer->pin();
-    sizedSegsLock.unlock();
-    bufferIt->second->lastTouched = bufferEpoch_++;  // race
-    if (bufferIt->second->buffer->size() <
-        numBytes) {  // need to fetch part of buffer we don't have - up to numBytes
-      parentMgr_->fetchBuffer(key, bufferIt->second->buffer, numBytes);
-    }
-    return bufferIt->second->buffer;
-  } else {  // If wasn't in pool then we need to fetch it
-    sizedSegsLock.unlock();
-    AbstractBuffer* buffer =
-        createBuffer(key, pageSize_, numBytes);  // createChunk pins for us
-    try {
-      parentMgr_->fetchBuffer(
-          key, buffer, numBytes);  // this should put buffer in a BufferSegment
-    } catch (std::runtime_error& error) {
-      LOG(FATAL) << "Get chunk - Could not find chunk " << keyToString(key)
-                 << " in buffer pool or parent buffer pools. Error was " << error.what();
+  auto& shard = getChunkIndexShard(key);
+  {
+    // The common case - the chunk is already resident - only needs to pin it,
+    // so concurrent getBuffer calls from parallel fragment kernels take the
+    // pool lock shared and don't serialize behind each other's parent fetches
+    // or eviction scans.
+    mapd_shared_lock<mapd_shared_mutex> readLock(globalMutex_);  // granular lock
+    std::unique_lock<std::mutex> sizedSegsLock(sizedSegsMutex_, std::defer_lock);
+    lock_wait_stats::acquire_timed(sizedSegsLock, lock_wait_stats::Subsystem::kBufferMgr);
+    std::unique_lock<std::mutex> chunkIndexLock(shard.mutex);
+    auto bufferIt = shard.index.find(key);
+    bool foundBuffer = bufferIt != shard.index.end();
+    chunkIndexLock.unlock();
+    if (foundBuffer) {
+      CHECK(bufferIt->second->buffer);
+      ++numChunkHits_;
+      bufferIt->second->buffer->pin();
+      sizedSegsLock.unlock();
+      bufferIt->second->lastTouched = bufferEpoch_++;  // race
+      if (bufferIt->second->buffer->size() <
+          numBytes) {  // need to fetch part of buffer we don't have - up to numBytes
+        parentMgr_->fetchBuffer(key, bufferIt->second->buffer, numBytes);
+      }
+      return bufferIt->second->buffer;
+    }
+  }
+  // If wasn't in pool then we need to fetch it - creation can evict, so take
+  // the pool lock exclusive and recheck the index in case another thread
+  // created the chunk while we weren't holding any lock.
+  mapd_lock_guard<mapd_shared_mutex> writeLock(globalMutex_);  // granular lock
+  {
+    std::unique_lock<std::mutex> chunkIndexLock(shard.mutex);
+    auto bufferIt = shard.index.find(key);
+    if (bufferIt != shard.index.end()) {
+      // another thread created the chunk between our shared and exclusive
+      // holds of the pool lock
+      CHECK(bufferIt->second->buffer);
+      ++numChunkHits_;
+      bufferIt->second->buffer->pin();
+      chunkIndexLock.unlock();
+      bufferIt->second->lastTouched = bufferEpoch_++;
+      if (bufferIt->second->buffer->size() < numBytes) {
+        parentMgr_->fetchBuffer(key, bufferIt->second->buffer, numBytes);
+      }
+      return bufferIt->second->buffer;
     }
-    return buffer;
   }
+  ++numChunkMisses_;
+  AbstractBuffer* buffer =
+      createBuffer(key, pageSize_, numBytes);  // createChunk pins for us
+  try {
+    parentMgr_->fetchBuffer(
+        key, buffer, numBytes);  // this should put buffer in a BufferSegment
+  } catch (std::runtime_error& error) {
+    LOG(FATAL) << "Get chunk - Could not find chunk " << keyToString(key)
+               << " in buffer pool or parent buffer pools. Error was " << error.what();
+  }
+  return buffer;
 }
 
 void BufferMgr::fetchBuffer(const ChunkKey& key,
                             AbstractBuffer* destBuffer,
                             const size_t numBytes) {
-  std::unique_lock<std::mutex> lock(globalMutex_);  // granular lock
-  std::unique_lock<std::mutex> sizedSegsLock(sizedSegsMutex_);
-  std::unique_lock<std::mutex> chunkIndexLock(chunkIndexMutex_);
-
-  auto bufferIt = chunkIndex_.find(key);
-  bool foundBuffer = bufferIt != chunkIndex_.end();
-  chunkIndexLock.unlock();
-  AbstractBuffer* buffer;
-  if (!foundBuffer) {
-    sizedSegsLock.unlock();
+  auto& shard = getChunkIndexShard(key);
+  AbstractBuffer* buffer = nullptr;
+  {
+    // as in getBuffer, only the miss path creates (and so may evict), so the
+    // resident case holds the pool lock shared
+    mapd_shared_lock<mapd_shared_mutex> readLock(globalMutex_);  // granular lock
+    std::unique_lock<std::mutex> sizedSegsLock(sizedSegsMutex_, std::defer_lock);
+    lock_wait_stats::acquire_timed(sizedSegsLock, lock_wait_stats::Subsystem::kBufferMgr);
+    std::unique_lock<std::mutex> chunkIndexLock(shard.mutex);
+
+    auto bufferIt = shard.index.find(key);
+    bool foundBuffer = bufferIt != shard.index.end();
+    chunkIndexLock.unlock();
+    if (foundBuffer) {
+      ++numChunkHits_;
+      buffer = bufferIt->second->buffer;
+      buffer->pin();
+      if (numBytes > buffer->size()) {
+        try {
+          parentMgr_->fetchBuffer(key, buffer, numBytes);
+        } catch (std::runtime_error& error) {
+          LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key);
+        }
+      }
+      sizedSegsLock.unlock();
+    }
+  }
+  if (!buffer) {
     CHECK(parentMgr_ != 0);
-    buffer = createBuffer(key, pageSize_, numBytes);  // will pin buffer
-    try {
-      parentMgr_->fetchBuffer(key, buffer, numBytes);
-    } catch (std::runtime_error& error) {
-      LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key);
+    bool createdBuffer = false;
+    {
+      mapd_lock_guard<mapd_shared_mutex> writeLock(globalMutex_);  // granular lock
+      std::unique_lock<std::mutex> chunkIndexLock(shard.mutex);
+      auto bufferIt = shard.index.find(key);
+      if (bufferIt != shard.index.end()) {
+        // raced with another creator of this chunk
+        ++numChunkHits_;
+        buffer = bufferIt->second->buffer;
+        buffer->pin();
+        chunkIndexLock.unlock();
+      } else {
+        chunkIndexLock.unlock();
+        ++numChunkMisses_;
+        buffer = createBuffer(key, pageSize_, numBytes);  // will pin buffer
+        createdBuffer = true;
+      }
     }
-  } else {
-    buffer = bufferIt->second->buffer;
-    buffer->pin();
-    if (numBytes > buffer->size()) {
+    if (createdBuffer || numBytes > buffer->size()) {
       try {
         parentMgr_->fetchBuffer(key, buffer, numBytes);
       } catch (std::runtime_error& error) {
         LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key);
       }
     }
-    sizedSegsLock.unlock();
   }
   size_t chunkSize = numBytes == 0 ? buffer->size() : numBytes;
-  lock.unlock();
   destBuffer->reserve(chunkSize);
   if (buffer->isUpdated()) {
     buffer->read(destBuffer->getMemoryPtr(),
@@ -796,9 +1013,10 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
 AbstractBuffer* BufferMgr::putBuffer(const ChunkKey& key,
                                      AbstractBuffer* srcBuffer,
                                      const size_t numBytes) {
-  std::unique_lock<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  auto bufferIt = chunkIndex_.find(key);
-  bool foundBuffer = bufferIt != chunkIndex_.end();
+  auto& shard = getChunkIndexShard(key);
+  std::unique_lock<std::mutex> chunkIndexLock(shard.mutex);
+  auto bufferIt = shard.index.find(key);
+  bool foundBuffer = bufferIt != shard.index.end();
   chunkIndexLock.unlock();
   AbstractBuffer* buffer;
   if (!foundBuffer) {
@@ -837,13 +1055,13 @@ int BufferMgr::getBufferId() {
 
 /// client is responsible for deleting memory allocated for b->mem_
 AbstractBuffer* BufferMgr::alloc(const size_t numBytes) {
-  std::lock_guard<std::mutex> lock(globalMutex_);
+  mapd_lock_guard<mapd_shared_mutex> lock(globalMutex_);
   ChunkKey chunkKey = {-1, getBufferId()};
   return createBuffer(chunkKey, pageSize_, numBytes);
 }
 
 void BufferMgr::free(AbstractBuffer* buffer) {
-  std::lock_guard<std::mutex> lock(globalMutex_);  // hack for now
+  mapd_lock_guard<mapd_shared_mutex> lock(globalMutex_);  // hack for now
   Buffer* castedBuffer = dynamic_cast<Buffer*>(buffer);
   if (castedBuffer == 0) {
     LOG(FATAL) << "Wrong buffer type - expects base class pointer to Buffer type.";
@@ -852,8 +1070,12 @@ void BufferMgr::free(AbstractBuffer* buffer) {
 }
 
 size_t BufferMgr::getNumChunks() {
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  return chunkIndex_.size();
+  size_t numChunks = 0;
+  for (auto& shard : chunkIndexShards_) {
+    std::lock_guard<std::mutex> chunkIndexLock(shard.mutex);
+    numChunks += shard.index.size();
+  }
+  return numChunks;
 }
 
 size_t BufferMgr::size() {
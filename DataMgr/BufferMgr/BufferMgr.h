@@ -27,11 +27,14 @@
 
 #define BOOST_STACKTRACE_GNU_SOURCE_NOT_REQUIRED 1
 
+#include <array>
+#include <atomic>
 #include <boost/stacktrace.hpp>
 #include <iostream>
 #include <list>
 #include <map>
 #include <mutex>
+#include "../../Shared/mapd_shared_mutex.h"
 #include "../../Shared/types.h"
 #include "../AbstractBuffer.h"
 #include "../AbstractBufferMgr.h"
@@ -127,6 +130,21 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   bool isAllocationCapped() override;
   const std::vector<BufferList>& getSlabSegments();
 
+  // Cache statistics, cumulative since startup. A hit is a getBuffer or
+  // fetchBuffer request satisfied by a resident chunk; a miss had to go to
+  // the parent manager; an eviction removed a resident chunk to make room.
+  size_t getNumChunkHits() const { return numChunkHits_; }
+  size_t getNumChunkMisses() const { return numChunkMisses_; }
+  size_t getNumChunkEvictions() const { return numChunkEvictions_; }
+
+  // Fragmentation metrics. The largest contiguous free run bounds the biggest
+  // allocation that can succeed without growing a slab or evicting; a large
+  // gap between it and the total free page count means the pool is fragmented.
+  size_t getNumFreePages();
+  size_t getLargestFreeBlockNumPages();
+  size_t getNumCompactions() const { return numCompactions_; }
+  size_t getNumCompactionPagesMoved() const { return numCompactionPagesMoved_; }
+
   /// Creates a chunk with the specified key and page size.
   AbstractBuffer* createBuffer(const ChunkKey& key,
                                const size_t pageSize = 0,
@@ -184,19 +202,41 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   void removeSegment(BufferList::iterator& segIt);
   BufferList::iterator findFreeBufferInSlab(const size_t slabNum,
                                             const size_t numPagesRequested);
+  size_t compactSlabs();
   int getBufferId();
   virtual void addSlab(const size_t slabSize) = 0;
   virtual void freeAllMem() = 0;
   virtual void allocateBuffer(BufferList::iterator segIt,
                               const size_t pageSize,
                               const size_t numBytes) = 0;
-  std::mutex chunkIndexMutex_;
+  /// Moves numBytes of slab data from src to dest within the same device;
+  /// dest may overlap src from below (compaction slides segments left).
+  virtual void moveSlabData(int8_t* dest, int8_t* src, const size_t numBytes) = 0;
   std::mutex sizedSegsMutex_;
   std::mutex unsizedSegsMutex_;
   std::mutex bufferIdMutex_;
-  std::mutex globalMutex_;
+  // Readers which only look up and pin an existing buffer take this shared;
+  // paths which can create or evict segments take it exclusive.
+  mapd_shared_mutex globalMutex_;
+
+  // The chunk index is sharded by chunk key hash so concurrent lookups from
+  // parallel fragment kernels don't serialize on a single map mutex. Keys
+  // sharing a prefix stay contiguous within each shard's ordered map, so
+  // prefix operations do the usual lower_bound walk once per shard.
+  static constexpr size_t kNumChunkIndexShards{32};
+  struct ChunkIndexShard {
+    std::mutex mutex;
+    std::map<ChunkKey, BufferList::iterator> index;
+  };
+  std::array<ChunkIndexShard, kNumChunkIndexShards> chunkIndexShards_;
 
-  std::map<ChunkKey, BufferList::iterator> chunkIndex_;
+  ChunkIndexShard& getChunkIndexShard(const ChunkKey& key) {
+    size_t hash{0};
+    for (const auto sub_key : key) {
+      hash = hash * 31 + static_cast<size_t>(sub_key);
+    }
+    return chunkIndexShards_[hash % kNumChunkIndexShards];
+  }
   size_t maxBufferSize_;  /// max number of bytes allocated for the buffer pool
   size_t maxNumPages_;
   size_t numPagesAllocated_;
@@ -208,6 +248,11 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   AbstractBufferMgr* parentMgr_;
   int maxBufferId_;
   unsigned int bufferEpoch_;
+  std::atomic<size_t> numChunkHits_{0};
+  std::atomic<size_t> numChunkMisses_{0};
+  std::atomic<size_t> numChunkEvictions_{0};
+  std::atomic<size_t> numCompactions_{0};
+  std::atomic<size_t> numCompactionPagesMoved_{0};
   // File_Namespace::FileMgr *fileMgr_;
 
   /// Maps sizes of free memory areas to host buffer pool memory addresses
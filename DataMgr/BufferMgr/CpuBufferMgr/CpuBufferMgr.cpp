@@ -16,8 +16,88 @@
 
 #include "CpuBufferMgr.h"
 #include "../../../CudaMgr/CudaMgr.h"
+#include "../../../Shared/Logger.h"
 #include "CpuBuffer.h"
 
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <fstream>
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#endif  // __linux__
+
+bool g_enable_numa_interleaved_cpu_buffers{false};
+bool g_enable_pinned_cpu_buffers{false};
+
+namespace {
+
+#ifdef __linux__
+size_t numa_node_count() {
+  static const size_t count = [] {
+    // the online file holds a range like "0-1" on a dual socket box
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string range;
+    size_t nodes = 1;
+    if (online && std::getline(online, range)) {
+      const auto dash = range.rfind('-');
+      if (dash != std::string::npos) {
+        nodes = std::stoul(range.substr(dash + 1)) + 1;
+      }
+    }
+    return nodes;
+  }();
+  return count;
+}
+
+// Spreads the pages of a freshly allocated slab round-robin across all NUMA
+// nodes. Without this, first touch places a whole slab on the node of
+// whichever thread populates it first, and scans from the other socket lose
+// interconnect bandwidth on every page. Must run before the pages are
+// touched; mbind only binds pages not yet faulted in.
+void interleave_across_numa_nodes(int8_t* addr, const size_t size) {
+  const auto nodes = numa_node_count();
+  if (nodes < 2) {
+    return;
+  }
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  // mbind needs a page aligned range; the slab comes from operator new[]
+  const auto aligned_addr = reinterpret_cast<int8_t*>(
+      (reinterpret_cast<uintptr_t>(addr) + page_size - 1) & ~(page_size - 1));
+  const auto skew = static_cast<size_t>(aligned_addr - addr);
+  if (size <= skew + page_size) {
+    return;
+  }
+  const auto aligned_size = (size - skew) & ~(page_size - 1);
+  unsigned long node_mask = (1UL << nodes) - 1;
+  if (syscall(SYS_mbind,
+              aligned_addr,
+              aligned_size,
+              MPOL_INTERLEAVE,
+              &node_mask,
+              nodes + 1,
+              0UL) != 0) {
+    LOG(WARNING) << "Failed to interleave CPU buffer slab across " << nodes
+                 << " NUMA nodes, errno " << errno;
+  }
+}
+#else
+void interleave_across_numa_nodes(int8_t*, const size_t) {}
+#endif  // __linux__
+
+}  // namespace
+
 namespace Buffer_Namespace {
 
 CpuBufferMgr::CpuBufferMgr(const int deviceId,
@@ -25,9 +105,17 @@ CpuBufferMgr::CpuBufferMgr(const int deviceId,
                            CudaMgr_Namespace::CudaMgr* cudaMgr,
                            const size_t bufferAllocIncrement,
                            const size_t pageSize,
-                           AbstractBufferMgr* parentMgr)
+                           AbstractBufferMgr* parentMgr,
+                           const size_t hugePageSize)
     : BufferMgr(deviceId, maxBufferSize, bufferAllocIncrement, pageSize, parentMgr)
-    , cudaMgr_(cudaMgr) {}
+    , cudaMgr_(cudaMgr)
+    , huge_page_size_(hugePageSize) {
+  if (huge_page_size_ & (huge_page_size_ - 1)) {
+    LOG(WARNING) << "CPU buffer huge page size " << huge_page_size_
+                 << " is not a power of two, ignoring it";
+    huge_page_size_ = 0;
+  }
+}
 
 CpuBufferMgr::~CpuBufferMgr() {
   freeAllMem();
@@ -35,19 +123,90 @@ CpuBufferMgr::~CpuBufferMgr() {
 
 void CpuBufferMgr::addSlab(const size_t slabSize) {
   slabs_.resize(slabs_.size() + 1);
+  slab_is_pinned_.resize(slabs_.size(), false);
+  slab_mmap_bytes_.resize(slabs_.size(), 0);
+  if (g_enable_pinned_cpu_buffers && cudaMgr_) {
+    // Pinned slabs let cuMemcpyHtoD run by DMA at full PCIe bandwidth
+    // instead of staging through a pageable-memory bounce buffer.
+    try {
+      slabs_.back() = cudaMgr_->allocatePinnedHostMem(slabSize);
+      slab_is_pinned_.back() = true;
+      slabSegments_.resize(slabSegments_.size() + 1);
+      slabSegments_[slabSegments_.size() - 1].push_back(
+          BufferSeg(0, slabSize / pageSize_));
+      return;
+    } catch (const std::runtime_error& e) {
+      LOG(WARNING) << "Failed to allocate " << slabSize
+                   << " bytes of pinned host memory, falling back to a pageable "
+                      "slab: "
+                   << e.what();
+    }
+  }
+#ifdef __linux__
+  if (huge_page_size_ > 0) {
+    // hugetlb mappings must be a multiple of the huge page size; the slab
+    // bookkeeping below still only hands out slabSize bytes
+    const auto mmap_bytes =
+        (slabSize + huge_page_size_ - 1) & ~(huge_page_size_ - 1);
+    const int page_shift = __builtin_ctzll(huge_page_size_);
+    const auto addr = mmap(nullptr,
+                           mmap_bytes,
+                           PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                               (page_shift << MAP_HUGE_SHIFT),
+                           -1,
+                           0);
+    if (addr != MAP_FAILED) {
+      slabs_.back() = reinterpret_cast<int8_t*>(addr);
+      slab_mmap_bytes_.back() = mmap_bytes;
+      LOG(INFO) << "Allocated a " << slabSize / (1024 * 1024)
+                << "M CPU buffer slab backed by " << mmap_bytes / huge_page_size_
+                << " huge pages of " << huge_page_size_ / 1024 << "K";
+      if (g_enable_numa_interleaved_cpu_buffers) {
+        interleave_across_numa_nodes(slabs_.back(), mmap_bytes);
+      }
+      slabSegments_.resize(slabSegments_.size() + 1);
+      slabSegments_[slabSegments_.size() - 1].push_back(
+          BufferSeg(0, slabSize / pageSize_));
+      return;
+    }
+    LOG(WARNING) << "Failed to back a " << slabSize
+                 << " byte CPU buffer slab with huge pages of "
+                 << huge_page_size_ << " bytes (errno " << errno
+                 << "), falling back to normal pages; check that enough huge "
+                    "pages are reserved (/proc/sys/vm/nr_hugepages)";
+  }
+#endif  // __linux__
   try {
     slabs_.back() = new int8_t[slabSize];
   } catch (std::bad_alloc&) {
     slabs_.resize(slabs_.size() - 1);
+    slab_is_pinned_.resize(slabs_.size());
+    slab_mmap_bytes_.resize(slabs_.size());
     throw FailedToCreateSlab(slabSize);
   }
+  if (g_enable_numa_interleaved_cpu_buffers) {
+    // pinned slabs are skipped above; their pages are already faulted in so
+    // mbind could not move them anyway
+    interleave_across_numa_nodes(slabs_.back(), slabSize);
+  }
   slabSegments_.resize(slabSegments_.size() + 1);
   slabSegments_[slabSegments_.size() - 1].push_back(BufferSeg(0, slabSize / pageSize_));
 }
 
 void CpuBufferMgr::freeAllMem() {
-  for (auto bufIt = slabs_.begin(); bufIt != slabs_.end(); ++bufIt) {
-    delete[] * bufIt;
+  CHECK_EQ(slabs_.size(), slab_is_pinned_.size());
+  CHECK_EQ(slabs_.size(), slab_mmap_bytes_.size());
+  for (size_t slab_idx = 0; slab_idx < slabs_.size(); ++slab_idx) {
+    if (slab_is_pinned_[slab_idx]) {
+      cudaMgr_->freePinnedHostMem(slabs_[slab_idx]);
+    } else if (slab_mmap_bytes_[slab_idx] > 0) {
+#ifdef __linux__
+      munmap(slabs_[slab_idx], slab_mmap_bytes_[slab_idx]);
+#endif
+    } else {
+      delete[] slabs_[slab_idx];
+    }
   }
 }
 
@@ -65,4 +224,8 @@ void CpuBufferMgr::allocateBuffer(BufferList::iterator segIt,
                                // buffer member
 }
 
+void CpuBufferMgr::moveSlabData(int8_t* dest, int8_t* src, const size_t numBytes) {
+  std::memmove(dest, src, numBytes);  // compaction moves overlap
+}
+
 }  // namespace Buffer_Namespace
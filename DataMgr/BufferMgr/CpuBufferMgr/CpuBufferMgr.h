@@ -17,6 +17,8 @@
 #ifndef CPUBUFFERMGR_H
 #define CPUBUFFERMGR_H
 
+#include <vector>
+
 #include "../BufferMgr.h"
 
 namespace CudaMgr_Namespace {
@@ -32,7 +34,8 @@ class CpuBufferMgr : public BufferMgr {
                CudaMgr_Namespace::CudaMgr* cudaMgr,
                const size_t bufferAllocIncrement = 2147483648,
                const size_t pageSize = 512,
-               AbstractBufferMgr* parentMgr = 0);
+               AbstractBufferMgr* parentMgr = 0,
+               const size_t hugePageSize = 0);
   inline MgrType getMgrType() override { return CPU_MGR; }
   inline std::string getStringMgrType() override { return ToString(CPU_MGR); }
   ~CpuBufferMgr() override;
@@ -43,7 +46,15 @@ class CpuBufferMgr : public BufferMgr {
   void allocateBuffer(BufferList::iterator segIt,
                       const size_t pageSize,
                       const size_t initialSize) override;
+  void moveSlabData(int8_t* dest, int8_t* src, const size_t numBytes) override;
   CudaMgr_Namespace::CudaMgr* cudaMgr_;
+  // When non-zero, slabs are backed by explicit huge pages of this size
+  // (2MB/1GB), cutting dTLB misses on scans over a large buffer pool.
+  size_t huge_page_size_;
+  // tracks per slab whether it came from cuMemHostAlloc (pinned) or new[]
+  std::vector<bool> slab_is_pinned_;
+  // mapping length per slab when it came from mmap (huge pages), else zero
+  std::vector<size_t> slab_mmap_bytes_;
 };
 
 }  // namespace Buffer_Namespace
@@ -18,8 +18,13 @@
 #include "../../../CudaMgr/CudaMgr.h"
 #include "GpuCudaBuffer.h"
 #include "Shared/Logger.h"
+#include "Shared/nvtx_helpers.h"
 //#include "../CudaUtils.h"
 
+#include <algorithm>
+
+bool g_enable_gpu_managed_memory{false};
+
 namespace Buffer_Namespace {
 
 GpuCudaBufferMgr::GpuCudaBufferMgr(const int deviceId,
@@ -48,10 +53,32 @@ GpuCudaBufferMgr::~GpuCudaBufferMgr() {
 }
 
 void GpuCudaBufferMgr::addSlab(const size_t slabSize) {
+  NVTX_RANGE("GpuCudaBufferMgr::addSlab " + std::to_string(slabSize) +
+             " bytes on device " + std::to_string(deviceId_));
   slabs_.resize(slabs_.size() + 1);
   try {
     slabs_.back() = cudaMgr_->allocateDeviceMem(slabSize, deviceId_);
   } catch (std::runtime_error& error) {
+    if (g_enable_gpu_managed_memory) {
+      // Device memory is exhausted; back the overflow slab with managed
+      // memory instead of refusing the slab. The driver keeps as much of it
+      // resident as fits and pages the remainder from host on demand, so a
+      // working set slightly over device capacity degrades by the overflow
+      // fraction rather than punting the whole query to CPU.
+      try {
+        slabs_.back() = cudaMgr_->allocateManagedMem(slabSize, deviceId_);
+        LOG(INFO) << "Device " << deviceId_ << " out of memory for a " << slabSize
+                  << " byte slab, backed it with CUDA managed memory instead";
+        slabSegments_.resize(slabSegments_.size() + 1);
+        slabSegments_[slabSegments_.size() - 1].push_back(
+            BufferSeg(0, slabSize / pageSize_));
+        return;
+      } catch (std::runtime_error& managed_error) {
+        LOG(WARNING) << "Failed to allocate a " << slabSize
+                     << " byte managed memory overflow slab on device " << deviceId_
+                     << ": " << managed_error.what();
+      }
+    }
     slabs_.resize(slabs_.size() - 1);
     throw FailedToCreateSlab(slabSize);
   }
@@ -79,4 +106,17 @@ void GpuCudaBufferMgr::allocateBuffer(BufferList::iterator segIt,
                                    // Buffer in its buffer member
 }
 
+void GpuCudaBufferMgr::moveSlabData(int8_t* dest, int8_t* src, const size_t numBytes) {
+  // cuMemcpyDtoD has no memmove semantics, but compaction only ever slides
+  // data down in memory, so copying forward in chunks no larger than the gap
+  // between src and dest never reads bytes a previous chunk overwrote.
+  CHECK_LT(dest, src);
+  const size_t max_copy_bytes = static_cast<size_t>(src - dest);
+  for (size_t offset = 0; offset < numBytes; offset += max_copy_bytes) {
+    const size_t copy_bytes = std::min(max_copy_bytes, numBytes - offset);
+    cudaMgr_->copyDeviceToDevice(
+        dest + offset, src + offset, copy_bytes, deviceId_, deviceId_);
+  }
+}
+
 }  // namespace Buffer_Namespace
@@ -43,6 +43,7 @@ class GpuCudaBufferMgr : public BufferMgr {
   void allocateBuffer(BufferList::iterator segIt,
                       const size_t pageSize,
                       const size_t initialSize) override;
+  void moveSlabData(int8_t* dest, int8_t* src, const size_t numBytes) override;
   CudaMgr_Namespace::CudaMgr* cudaMgr_;
 };
 
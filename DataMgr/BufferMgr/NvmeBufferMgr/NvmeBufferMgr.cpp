@@ -0,0 +1,119 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NvmeBufferMgr.h"
+#include "../../../Shared/Logger.h"
+#include "../CpuBufferMgr/CpuBuffer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#include <boost/filesystem.hpp>
+
+namespace Buffer_Namespace {
+
+NvmeBufferMgr::NvmeBufferMgr(const int deviceId,
+                             const size_t maxBufferSize,
+                             const std::string& cacheDir,
+                             const size_t bufferAllocIncrement,
+                             const size_t pageSize,
+                             AbstractBufferMgr* parentMgr)
+    : BufferMgr(deviceId, maxBufferSize, bufferAllocIncrement, pageSize, parentMgr)
+    , cache_dir_(cacheDir) {
+  boost::filesystem::create_directories(cache_dir_);
+}
+
+NvmeBufferMgr::~NvmeBufferMgr() {
+  freeAllMem();
+}
+
+void NvmeBufferMgr::addSlab(const size_t slabSize) {
+  slabs_.resize(slabs_.size() + 1);
+  slab_mmap_bytes_.resize(slabs_.size(), 0);
+  const auto slab_path =
+      cache_dir_ + "/mapd_nvme_cache_slab_" + std::to_string(slabs_.size() - 1);
+  const int fd = open(slab_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0) {
+    LOG(WARNING) << "Failed to create NVMe cache slab file " << slab_path << ", errno "
+                 << errno;
+    slabs_.resize(slabs_.size() - 1);
+    slab_mmap_bytes_.resize(slabs_.size());
+    throw FailedToCreateSlab(slabSize);
+  }
+  if (ftruncate(fd, slabSize) != 0) {
+    LOG(WARNING) << "Failed to grow NVMe cache slab file " << slab_path << " to "
+                 << slabSize << " bytes, errno " << errno
+                 << "; is the cache device full?";
+    close(fd);
+    unlink(slab_path.c_str());
+    slabs_.resize(slabs_.size() - 1);
+    slab_mmap_bytes_.resize(slabs_.size());
+    throw FailedToCreateSlab(slabSize);
+  }
+  const auto addr =
+      mmap(nullptr, slabSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // the mapping keeps the storage alive; closing and unlinking right away
+  // means the kernel reclaims the flash space automatically on exit or crash
+  close(fd);
+  unlink(slab_path.c_str());
+  if (addr == MAP_FAILED) {
+    slabs_.resize(slabs_.size() - 1);
+    slab_mmap_bytes_.resize(slabs_.size());
+    throw FailedToCreateSlab(slabSize);
+  }
+  slabs_.back() = reinterpret_cast<int8_t*>(addr);
+  slab_mmap_bytes_.back() = slabSize;
+  LOG(INFO) << "Allocated a " << slabSize / (1024 * 1024)
+            << "M NVMe cache slab under " << cache_dir_;
+  slabSegments_.resize(slabSegments_.size() + 1);
+  slabSegments_[slabSegments_.size() - 1].push_back(BufferSeg(0, slabSize / pageSize_));
+}
+
+void NvmeBufferMgr::freeAllMem() {
+  CHECK_EQ(slabs_.size(), slab_mmap_bytes_.size());
+  for (size_t slab_idx = 0; slab_idx < slabs_.size(); ++slab_idx) {
+    munmap(slabs_[slab_idx], slab_mmap_bytes_[slab_idx]);
+  }
+}
+
+AbstractBuffer* NvmeBufferMgr::putBuffer(const ChunkKey& key,
+                                         AbstractBuffer* d,
+                                         const size_t numBytes) {
+  // Write-through: dirty chunks go straight to the disk level so the cache
+  // never holds data the checkpoint machinery needs to flush. Any cached
+  // copy is now stale; drop it and let the next read re-fill it.
+  if (isBufferOnDevice(key)) {
+    deleteBuffer(key);
+  }
+  return parentMgr_->putBuffer(key, d, numBytes);
+}
+
+void NvmeBufferMgr::allocateBuffer(BufferList::iterator segIt,
+                                   const size_t pageSize,
+                                   const size_t initialSize) {
+  // cache slabs are plain host-addressable memory, so the CPU buffer type
+  // works unchanged; it never talks to a GPU from this level
+  new CpuBuffer(this, segIt, deviceId_, nullptr, pageSize, initialSize);
+}
+
+void NvmeBufferMgr::moveSlabData(int8_t* dest, int8_t* src, const size_t numBytes) {
+  std::memmove(dest, src, numBytes);  // compaction moves overlap
+}
+
+}  // namespace Buffer_Namespace
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NVMEBUFFERMGR_H
+#define NVMEBUFFERMGR_H
+
+#include <string>
+#include <vector>
+
+#include "../BufferMgr.h"
+
+namespace Buffer_Namespace {
+
+// Read-through chunk cache backed by memory-mapped files on local flash,
+// interposed between the disk level and the CPU buffer pool. Slabs are mmap'd
+// files under the configured cache directory, so the regular BufferMgr
+// segment and eviction machinery works on them unchanged while the OS page
+// cache decides which cached pages also stay in RAM. Writes pass straight
+// through to the disk level and invalidate any cached copy, so the cache
+// never holds dirty data and checkpoint durability is identical to the
+// uncached hierarchy.
+class NvmeBufferMgr : public BufferMgr {
+ public:
+  NvmeBufferMgr(const int deviceId,
+                const size_t maxBufferSize,
+                const std::string& cacheDir,
+                const size_t bufferAllocIncrement = 4294967296,
+                const size_t pageSize = 512,
+                AbstractBufferMgr* parentMgr = 0);
+  inline MgrType getMgrType() override { return NVME_MGR; }
+  inline std::string getStringMgrType() override { return ToString(NVME_MGR); }
+  ~NvmeBufferMgr() override;
+
+  AbstractBuffer* putBuffer(const ChunkKey& key,
+                            AbstractBuffer* d,
+                            const size_t numBytes = 0) override;
+
+ private:
+  void addSlab(const size_t slabSize) override;
+  void freeAllMem() override;
+  void allocateBuffer(BufferList::iterator segIt,
+                      const size_t pageSize,
+                      const size_t initialSize) override;
+  void moveSlabData(int8_t* dest, int8_t* src, const size_t numBytes) override;
+  std::string cache_dir_;
+  // mapping length per slab, needed for munmap
+  std::vector<size_t> slab_mmap_bytes_;
+};
+
+}  // namespace Buffer_Namespace
+
+#endif  // NVMEBUFFERMGR_H
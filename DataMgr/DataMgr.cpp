@@ -23,6 +23,7 @@
 #include "../CudaMgr/CudaMgr.h"
 #include "BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
 #include "BufferMgr/GpuCudaBufferMgr/GpuCudaBufferMgr.h"
+#include "BufferMgr/NvmeBufferMgr/NvmeBufferMgr.h"
 #include "FileMgr/GlobalFileMgr.h"
 
 #ifdef __APPLE__
@@ -35,8 +36,14 @@
 #include <boost/filesystem.hpp>
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <limits>
 
+bool g_enable_chunk_cache_warming{false};
+size_t g_chunk_cache_warming_num_chunks{10000};
+size_t g_chunk_cache_warming_bandwidth_mb_per_sec{1024};
+
 using namespace std;
 using namespace Buffer_Namespace;
 using namespace File_Namespace;
@@ -65,9 +72,18 @@ DataMgr::DataMgr(const string& dataDir,
 
   populateMgrs(mapd_parameters, numReaderThreads);
   createTopLevelMetadata();
+  if (g_enable_chunk_cache_warming) {
+    loadChunkHeatmap();
+    last_heatmap_flush_ = std::chrono::steady_clock::now();
+    startChunkCacheWarming();
+  }
 }
 
 DataMgr::~DataMgr() {
+  stopChunkCacheWarming();
+  if (g_enable_chunk_cache_warming) {
+    flushChunkHeatmap();
+  }
   int numLevels = bufferMgrs_.size();
   for (int level = numLevels - 1; level >= 0; --level) {
     for (size_t device = 0; device < bufferMgrs_[level].size(); device++) {
@@ -100,12 +116,37 @@ void DataMgr::populateMgrs(const MapDParameters& mapd_parameters,
   bufferMgrs_.resize(2);
   bufferMgrs_[0].push_back(new GlobalFileMgr(0, dataDir_, userSpecifiedNumReaderThreads));
   levelSizes_.push_back(1);
+  // The CPU pool normally fetches straight from the disk level; with an NVMe
+  // cache configured, a read-through flash cache is interposed in the parent
+  // chain instead. It shares the disk slot of bufferMgrs_ since the
+  // CPU_LEVEL/GPU_LEVEL indices are fixed across the execution layer.
+  AbstractBufferMgr* cpuParentMgr = bufferMgrs_[0][0];
+  if (!mapd_parameters.nvme_cache_path.empty() &&
+      mapd_parameters.nvme_cache_size_bytes > 0) {
+    size_t nvmeSlabSize = std::min(static_cast<size_t>(1L << 32),
+                                   mapd_parameters.nvme_cache_size_bytes);
+    nvmeSlabSize = (nvmeSlabSize / 512) * 512;
+    LOG(INFO) << "Adding a "
+              << (float)mapd_parameters.nvme_cache_size_bytes / (1024 * 1024)
+              << "M NVMe chunk cache at " << mapd_parameters.nvme_cache_path;
+    bufferMgrs_[0].push_back(new NvmeBufferMgr(0,
+                                               mapd_parameters.nvme_cache_size_bytes,
+                                               mapd_parameters.nvme_cache_path,
+                                               nvmeSlabSize,
+                                               512,
+                                               bufferMgrs_[0][0]));
+    levelSizes_[0] = 2;
+    cpuParentMgr = bufferMgrs_[0][1];
+  }
   size_t cpuBufferSize = mapd_parameters.cpu_buffer_mem_bytes;
   if (cpuBufferSize == 0) {  // if size is not specified
     cpuBufferSize = getTotalSystemMemory() *
                     0.8;  // should get free memory instead of this ugly heuristic
   }
-  size_t cpuSlabSize = std::min(static_cast<size_t>(1L << 32), cpuBufferSize);
+  size_t cpuSlabSize = mapd_parameters.cpu_slab_size_bytes != 0
+                           ? mapd_parameters.cpu_slab_size_bytes
+                           : static_cast<size_t>(1L << 32);
+  cpuSlabSize = std::min(cpuSlabSize, cpuBufferSize);
   // cpuSlabSize -= cpuSlabSize % 512 == 0 ? 0 : 512 - (cpuSlabSize % 512);
   cpuSlabSize = (cpuSlabSize / 512) * 512;
   LOG(INFO) << "cpuSlabSize is " << (float)cpuSlabSize / (1024 * 1024) << "M";
@@ -113,8 +154,13 @@ void DataMgr::populateMgrs(const MapDParameters& mapd_parameters,
     LOG(INFO) << "reserved GPU memory is " << (float)reservedGpuMem_ / (1024 * 1024)
               << "M includes render buffer allocation";
     bufferMgrs_.resize(3);
-    bufferMgrs_[1].push_back(new CpuBufferMgr(
-        0, cpuBufferSize, cudaMgr_.get(), cpuSlabSize, 512, bufferMgrs_[0][0]));
+    bufferMgrs_[1].push_back(new CpuBufferMgr(0,
+                                              cpuBufferSize,
+                                              cudaMgr_.get(),
+                                              cpuSlabSize,
+                                              512,
+                                              cpuParentMgr,
+                                              mapd_parameters.cpu_buffer_huge_page_size));
     levelSizes_.push_back(1);
     int numGpus = cudaMgr_->getDeviceCount();
     for (int gpuNum = 0; gpuNum < numGpus; ++gpuNum) {
@@ -122,7 +168,10 @@ void DataMgr::populateMgrs(const MapDParameters& mapd_parameters,
           mapd_parameters.gpu_buffer_mem_bytes != 0
               ? mapd_parameters.gpu_buffer_mem_bytes
               : (cudaMgr_->getDeviceProperties(gpuNum)->globalMem) - (reservedGpuMem_);
-      size_t gpuSlabSize = std::min(static_cast<size_t>(1L << 31), gpuMaxMemSize);
+      size_t gpuSlabSize = mapd_parameters.gpu_slab_size_bytes != 0
+                               ? mapd_parameters.gpu_slab_size_bytes
+                               : static_cast<size_t>(1L << 31);
+      gpuSlabSize = std::min(gpuSlabSize, gpuMaxMemSize);
       gpuSlabSize -= gpuSlabSize % 512 == 0 ? 0 : 512 - (gpuSlabSize % 512);
       LOG(INFO) << "gpuSlabSize is " << (float)gpuSlabSize / (1024 * 1024) << "M";
       bufferMgrs_[2].push_back(new GpuCudaBufferMgr(
@@ -130,8 +179,13 @@ void DataMgr::populateMgrs(const MapDParameters& mapd_parameters,
     }
     levelSizes_.push_back(numGpus);
   } else {
-    bufferMgrs_[1].push_back(new CpuBufferMgr(
-        0, cpuBufferSize, cudaMgr_.get(), cpuSlabSize, 512, bufferMgrs_[0][0]));
+    bufferMgrs_[1].push_back(new CpuBufferMgr(0,
+                                              cpuBufferSize,
+                                              cudaMgr_.get(),
+                                              cpuSlabSize,
+                                              512,
+                                              cpuParentMgr,
+                                              mapd_parameters.cpu_buffer_huge_page_size));
     levelSizes_.push_back(1);
   }
 }
@@ -185,6 +239,9 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
     mi.maxNumPages = cpuBuffer->getMaxSize() / mi.pageSize;
     mi.isAllocationCapped = cpuBuffer->isAllocationCapped();
     mi.numPageAllocated = cpuBuffer->getAllocated() / mi.pageSize;
+    mi.numChunkHits = cpuBuffer->getNumChunkHits();
+    mi.numChunkMisses = cpuBuffer->getNumChunkMisses();
+    mi.numChunkEvictions = cpuBuffer->getNumChunkEvictions();
 
     const std::vector<BufferList> slab_segments = cpuBuffer->getSlabSegments();
     size_t numSlabs = slab_segments.size();
@@ -214,6 +271,9 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
       mi.maxNumPages = gpuBuffer->getMaxSize() / mi.pageSize;
       mi.isAllocationCapped = gpuBuffer->isAllocationCapped();
       mi.numPageAllocated = gpuBuffer->getAllocated() / mi.pageSize;
+      mi.numChunkHits = gpuBuffer->getNumChunkHits();
+      mi.numChunkMisses = gpuBuffer->getNumChunkMisses();
+      mi.numChunkEvictions = gpuBuffer->getNumChunkEvictions();
       const std::vector<BufferList> slab_segments = gpuBuffer->getSlabSegments();
       size_t numSlabs = slab_segments.size();
 
@@ -311,6 +371,12 @@ void DataMgr::clearMemory(const MemoryLevel memLevel) {
     }
   } else {
     bufferMgrs_[memLevel][0]->clearSlabs();
+    if (memLevel == MemoryLevel::CPU_LEVEL && g_enable_chunk_cache_warming) {
+      // clearing CPU memory is the usual post-ETL admin step; re-warm the
+      // hot set in the background so the next dashboards don't run cold
+      stopChunkCacheWarming();
+      startChunkCacheWarming();
+    }
   }
 }
 
@@ -348,9 +414,152 @@ AbstractBuffer* DataMgr::getChunkBuffer(const ChunkKey& key,
   auto level = static_cast<size_t>(memoryLevel);
   assert(level < levelSizes_.size());     // make sure we have a legit buffermgr
   assert(deviceId < levelSizes_[level]);  // make sure we have a legit buffermgr
+  if (g_enable_chunk_cache_warming) {
+    recordChunkAccess(key);
+  }
   return bufferMgrs_[level][deviceId]->getBuffer(key, numBytes);
 }
 
+void DataMgr::recordChunkAccess(const ChunkKey& key) {
+  if (key.empty() || key[0] < 0) {  // skip scratch buffers, they have no identity
+    return;
+  }
+  std::lock_guard<std::mutex> access_lock(chunk_access_mutex_);
+  chunk_access_counts_[key]++;
+}
+
+void DataMgr::loadChunkHeatmap() {
+  std::ifstream heatmap_file(dataDir_ + "/mapd_chunk_heatmap");
+  if (!heatmap_file) {
+    return;
+  }
+  size_t key_size{0};
+  size_t num_entries{0};
+  while (heatmap_file >> key_size) {
+    ChunkKey key(key_size);
+    for (size_t i = 0; i < key_size; ++i) {
+      heatmap_file >> key[i];
+    }
+    uint64_t count{0};
+    heatmap_file >> count;
+    // halve persisted counts so chunks that stop being queried fade out of
+    // the heat map over restarts instead of staying hot forever
+    chunk_access_counts_[key] = count / 2;
+    num_entries++;
+  }
+  LOG(INFO) << "Loaded chunk heat map with " << num_entries << " entries";
+}
+
+void DataMgr::flushChunkHeatmap() {
+  const auto heatmap_path = dataDir_ + "/mapd_chunk_heatmap";
+  const auto tmp_path = heatmap_path + ".tmp";
+  {
+    std::ofstream heatmap_file(tmp_path, std::ios::trunc);
+    if (!heatmap_file) {
+      LOG(WARNING) << "Failed to write chunk heat map to " << tmp_path;
+      return;
+    }
+    std::lock_guard<std::mutex> access_lock(chunk_access_mutex_);
+    for (const auto& entry : chunk_access_counts_) {
+      if (entry.second == 0) {
+        continue;
+      }
+      heatmap_file << entry.first.size();
+      for (const auto key_part : entry.first) {
+        heatmap_file << ' ' << key_part;
+      }
+      heatmap_file << ' ' << entry.second << '\n';
+    }
+  }
+  // write to a temp file and rename so a crash mid-flush can't leave a
+  // truncated heat map behind
+  if (std::rename(tmp_path.c_str(), heatmap_path.c_str()) != 0) {
+    LOG(WARNING) << "Failed to move chunk heat map into place at " << heatmap_path;
+  }
+}
+
+void DataMgr::maybeFlushChunkHeatmap() {
+  if (!g_enable_chunk_cache_warming) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  if (now - last_heatmap_flush_ < std::chrono::minutes(5)) {
+    return;
+  }
+  last_heatmap_flush_ = now;
+  flushChunkHeatmap();
+}
+
+void DataMgr::startChunkCacheWarming() {
+  stop_warming_ = false;
+  warming_thread_ = std::thread(&DataMgr::warmChunkCache, this);
+}
+
+void DataMgr::stopChunkCacheWarming() {
+  stop_warming_ = true;
+  if (warming_thread_.joinable()) {
+    warming_thread_.join();
+  }
+}
+
+void DataMgr::warmChunkCache() {
+  std::vector<std::pair<uint64_t, ChunkKey>> hot_chunks;
+  {
+    std::lock_guard<std::mutex> access_lock(chunk_access_mutex_);
+    for (const auto& entry : chunk_access_counts_) {
+      if (entry.second > 0) {
+        hot_chunks.emplace_back(entry.second, entry.first);
+      }
+    }
+  }
+  if (hot_chunks.empty()) {
+    return;
+  }
+  std::sort(hot_chunks.begin(), hot_chunks.end(), std::greater<>());
+  // only chunks that still exist on disk can be warmed; the metadata walk
+  // also gives us the sizes needed for the bandwidth cap
+  std::vector<std::pair<ChunkKey, ChunkMetadata>> chunkMetadataVec;
+  bufferMgrs_[0][0]->getChunkMetadataVec(chunkMetadataVec);
+  std::map<ChunkKey, size_t> chunk_sizes;
+  for (const auto& chunk_metadata : chunkMetadataVec) {
+    chunk_sizes[chunk_metadata.first] = chunk_metadata.second.numBytes;
+  }
+  size_t warmed_chunks = 0;
+  size_t warmed_bytes = 0;
+  for (const auto& hot_chunk : hot_chunks) {
+    if (stop_warming_ || warmed_chunks >= g_chunk_cache_warming_num_chunks) {
+      break;
+    }
+    const auto size_it = chunk_sizes.find(hot_chunk.second);
+    if (size_it == chunk_sizes.end()) {
+      continue;  // chunk was dropped or rewritten since the heat map was saved
+    }
+    try {
+      auto buffer =
+          getChunkBuffer(hot_chunk.second, MemoryLevel::CPU_LEVEL, 0, size_it->second);
+      buffer->unPin();
+    } catch (const std::runtime_error& e) {
+      LOG(WARNING) << "Stopping chunk cache warming early: " << e.what();
+      break;
+    }
+    warmed_chunks++;
+    warmed_bytes += size_it->second;
+    if (g_chunk_cache_warming_bandwidth_mb_per_sec > 0) {
+      // 1 MB/s is conveniently 1 byte/us; sleep in slices so shutdown isn't
+      // held up behind a large chunk at a low cap
+      auto sleep_us = static_cast<int64_t>(size_it->second /
+                                           g_chunk_cache_warming_bandwidth_mb_per_sec);
+      while (sleep_us > 0 && !stop_warming_) {
+        const auto slice_us = std::min(sleep_us, int64_t(100000));
+        std::this_thread::sleep_for(std::chrono::microseconds(slice_us));
+        sleep_us -= slice_us;
+      }
+    }
+  }
+  LOG(INFO) << "Chunk cache warming finished: prefetched " << warmed_chunks
+            << " chunks, " << warmed_bytes / (1024 * 1024) << "M";
+}
+
 void DataMgr::deleteChunksWithPrefix(const ChunkKey& keyPrefix) {
   int numLevels = bufferMgrs_.size();
   for (int level = numLevels - 1; level >= 0; --level) {
@@ -410,6 +619,7 @@ void DataMgr::checkpoint(const int db_id, const int tb_id) {
       (*deviceIt)->checkpoint(db_id, tb_id);
     }
   }
+  maybeFlushChunkHeatmap();
 }
 
 void DataMgr::checkpoint() {
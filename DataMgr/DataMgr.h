@@ -29,10 +29,14 @@
 #include "BufferMgr/BufferMgr.h"
 #include "MemoryLevel.h"
 
+#include <atomic>
+#include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace File_Namespace {
@@ -59,6 +63,9 @@ struct MemoryInfo {
   size_t maxNumPages;
   size_t numPageAllocated;
   bool isAllocationCapped;
+  size_t numChunkHits;
+  size_t numChunkMisses;
+  size_t numChunkEvictions;
   std::vector<MemoryData> nodeMemoryData;
 };
 
@@ -125,6 +132,15 @@ class DataMgr {
   void convertDB(const std::string basePath);
   void checkpoint();  // checkpoint for whole DB, called from convertDB proc only
   void createTopLevelMetadata() const;
+  void recordChunkAccess(const ChunkKey& key);
+  void loadChunkHeatmap();
+  void flushChunkHeatmap();
+  void maybeFlushChunkHeatmap();
+  // body of the background warming thread; prefetches the hottest chunks
+  // from the persisted heat map into the CPU buffer pool
+  void warmChunkCache();
+  void startChunkCacheWarming();
+  void stopChunkCacheWarming();
 
   std::vector<std::vector<AbstractBufferMgr*>> bufferMgrs_;
   std::unique_ptr<CudaMgr_Namespace::CudaMgr> cudaMgr_;
@@ -133,6 +149,16 @@ class DataMgr {
   size_t reservedGpuMem_;
   std::map<ChunkKey, std::shared_ptr<mapd_shared_mutex>> chunkMutexMap_;
   mapd_shared_mutex chunkMutexMapMutex_;
+
+  // Per-chunk access frequencies, seeded from the persisted heat map at
+  // startup and flushed back periodically; the warming thread replays the
+  // hottest entries into the CPU pool so the first queries of the day don't
+  // all run cold.
+  std::mutex chunk_access_mutex_;
+  std::map<ChunkKey, uint64_t> chunk_access_counts_;
+  std::chrono::steady_clock::time_point last_heatmap_flush_;
+  std::thread warming_thread_;
+  std::atomic<bool> stop_warming_{false};
 };
 }  // namespace Data_Namespace
 
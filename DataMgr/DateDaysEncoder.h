@@ -42,19 +42,24 @@ class DateDaysEncoder : public Encoder {
     CHECK(ti.is_date_in_days());
     T* unencodedData = reinterpret_cast<T*>(srcData);
     auto encodedData = std::make_unique<V[]>(numAppendElems);
-    for (size_t i = 0; i < numAppendElems; ++i) {
-      size_t ri = replicating ? 0 : i;
-      if (unencodedData[ri] == std::numeric_limits<V>::min()) {
-        has_nulls = true;
-        encodedData.get()[i] = static_cast<V>(unencodedData[ri]);
-      } else {
-        date_days_overflow_validator_.validate(unencodedData[ri]);
-        encodedData.get()[i] =
-            DateConverters::get_epoch_days_from_seconds(unencodedData[ri]);
-        const T data = DateConverters::get_epoch_seconds_from_days(encodedData.get()[i]);
-        dataMax = std::max(dataMax, data);
-        dataMin = std::min(dataMin, data);
+    if (replicating) {
+      for (size_t i = 0; i < numAppendElems; ++i) {
+        size_t ri = replicating ? 0 : i;
+        if (unencodedData[ri] == std::numeric_limits<V>::min()) {
+          has_nulls = true;
+          encodedData.get()[i] = static_cast<V>(unencodedData[ri]);
+        } else {
+          date_days_overflow_validator_.validate(unencodedData[ri]);
+          encodedData.get()[i] =
+              DateConverters::get_epoch_days_from_seconds(unencodedData[ri]);
+          const T data =
+              DateConverters::get_epoch_seconds_from_days(encodedData.get()[i]);
+          dataMax = std::max(dataMax, data);
+          dataMin = std::min(dataMin, data);
+        }
       }
+    } else {
+      encodeAndUpdateStats(unencodedData, encodedData.get(), numAppendElems);
     }
     num_elems_ += numAppendElems;
 
@@ -79,6 +84,37 @@ class DateDaysEncoder : public Encoder {
     return chunk_metadata;
   }
 
+  // Encode and scan a whole append buffer with the min/max/null state held in
+  // locals, validating everything up front so a throw cannot leave
+  // half-updated stats behind.
+  void encodeAndUpdateStats(const T* const data,
+                            V* const encoded,
+                            const size_t num_elements) {
+    for (size_t i = 0; i < num_elements; ++i) {
+      if (data[i] != std::numeric_limits<V>::min()) {
+        date_days_overflow_validator_.validate(data[i]);
+      }
+    }
+    T min_val = dataMin;
+    T max_val = dataMax;
+    bool any_nulls = has_nulls;
+    for (size_t i = 0; i < num_elements; ++i) {
+      const T val = data[i];
+      if (val == std::numeric_limits<V>::min()) {
+        any_nulls = true;
+        encoded[i] = static_cast<V>(val);
+      } else {
+        encoded[i] = DateConverters::get_epoch_days_from_seconds(val);
+        const T round_tripped = DateConverters::get_epoch_seconds_from_days(encoded[i]);
+        min_val = std::min(min_val, round_tripped);
+        max_val = std::max(max_val, round_tripped);
+      }
+    }
+    dataMin = min_val;
+    dataMax = max_val;
+    has_nulls = any_nulls;
+  }
+
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
     if (is_null) {
@@ -57,6 +57,8 @@ class DecimalOverflowValidator {
     }
   }
 
+  bool doCheck() const { return do_check_; }
+
   void do_validate(int64_t value) {
     if (!do_check_) {
       return;
@@ -21,17 +21,33 @@
  */
 
 #include "FileBuffer.h"
+#include "Shared/Compressor.h"
+#include <cstring>
 #include <future>
 #include <map>
 #include <thread>
 #include "../../Shared/File.h"
 #include "FileMgr.h"
+#include "UringPageReader.h"
 
 #define METADATA_PAGE_SIZE 4096
 
 using namespace std;
 
 namespace File_Namespace {
+bool g_enable_disk_chunk_compression{false};
+
+// Bulk loads append millions of pages one header write and one data write at
+// a time; coalescing each run of file-contiguous fresh pages into one large
+// sequential write keeps the ingest path syscall count per page near zero.
+bool g_enable_vectored_page_writes{true};
+
+// Chunks which grow past their first page reserve pages in extents - runs of
+// file-contiguous pages - so sequential fragment scans read sequentially laid
+// out disk blocks. Single-page chunks never reserve an extent, which keeps
+// wide tables of small chunks from holding pages they will not use.
+size_t g_chunk_extent_pages{16};
+
 size_t FileBuffer::headerBufferOffset_ = 32;
 
 FileBuffer::FileBuffer(FileMgr* fm,
@@ -46,7 +62,8 @@ FileBuffer::FileBuffer(FileMgr* fm,
   // Create a new FileBuffer
   CHECK(fm_);
   calcHeaderBuffer();
-  pageDataSize_ = pageSize_ - reservedHeaderSize_;
+  pageDataSize_ = pageSize_ - reservedHeaderSize_ -
+                  (g_enable_disk_chunk_compression ? sizeof(int32_t) : 0);
   //@todo reintroduce initialSize - need to develop easy way of
   // differentiating these pre-allocated pages from "written-to" pages
   /*
@@ -74,7 +91,8 @@ FileBuffer::FileBuffer(FileMgr* fm,
     , chunkKey_(chunkKey) {
   CHECK(fm_);
   calcHeaderBuffer();
-  pageDataSize_ = pageSize_ - reservedHeaderSize_;
+  pageDataSize_ = pageSize_ - reservedHeaderSize_ -
+                  (g_enable_disk_chunk_compression ? sizeof(int32_t) : 0);
 }
 
 FileBuffer::FileBuffer(FileMgr* fm,
@@ -112,7 +130,8 @@ FileBuffer::FileBuffer(FileMgr* fm,
           // If we are on first real page
           CHECK(metadataPages_.pageVersions.back().fileId != -1);  // was initialized
           readMetadata(metadataPages_.pageVersions.back());
-          pageDataSize_ = pageSize_ - reservedHeaderSize_;
+          pageDataSize_ = pageSize_ - reservedHeaderSize_ -
+                  (g_enable_disk_chunk_compression ? sizeof(int32_t) : 0);
         }
         MultiPage multiPage(pageSize_);
         multiPages_.push_back(multiPage);
@@ -123,7 +142,8 @@ FileBuffer::FileBuffer(FileMgr* fm,
     }
     if (curPageId == -1) {  // meaning there was only a metadata page
       readMetadata(metadataPages_.pageVersions.back());
-      pageDataSize_ = pageSize_ - reservedHeaderSize_;
+      pageDataSize_ = pageSize_ - reservedHeaderSize_ -
+                  (g_enable_disk_chunk_compression ? sizeof(int32_t) : 0);
     }
   }
   // auto lastHeaderIt = std::prev(headerEndIt);
@@ -179,6 +199,13 @@ void FileBuffer::freePages() {
       fileInfo->freePage(pageIt->pageNum);
     }
   }
+
+  // Reserved extent pages were never written or referenced by any epoch, so
+  // they go straight back on the free list without the contingent marker
+  for (const auto& page : reservedExtentPages_) {
+    fm_->getFileInfoForFileId(page.fileId)->freePageDeferred(page.pageNum);
+  }
+  reservedExtentPages_.clear();
 }
 
 struct readThreadDS {
@@ -211,7 +238,14 @@ static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS)
     // Read the page into the destination (dst) buffer at its
     // current (cur) location
     size_t bytesRead = 0;
-    if (isFirstPage) {
+    if (g_enable_disk_chunk_compression) {
+      std::vector<int8_t> decompressed(fileBuffer->pageDataSize());
+      fileBuffer->readAndDecompressPage(fileInfo, page, decompressed.data());
+      const size_t pageOffset = isFirstPage ? threadDS.t_startPageOffset : 0;
+      bytesRead = min(fileBuffer->pageDataSize() - pageOffset, bytesLeft);
+      memcpy(curPtr, decompressed.data() + pageOffset, bytesRead);
+      isFirstPage = false;
+    } else if (isFirstPage) {
       bytesRead = fileInfo->read(
           page.pageNum * fileBuffer->pageSize() + threadDS.t_startPageOffset +
               fileBuffer->reservedHeaderSize(),
@@ -233,6 +267,48 @@ static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS)
   return (totalBytesRead);
 }
 
+bool FileBuffer::readWithUring(int8_t* const dst,
+                               const size_t numBytes,
+                               const size_t startPage,
+                               const size_t startPageOffset,
+                               const size_t numPagesToRead) {
+  std::vector<PageReadRequest> requests;
+  requests.reserve(numPagesToRead);
+  // Reads go through pread on the raw descriptor, so the FILE* stream
+  // position is never disturbed and concurrent FileInfo::read/write callers
+  // are unaffected. Each file is flushed once per batch so buffered writes
+  // are visible; the pages themselves are checkpointed versions that writers
+  // never touch in place.
+  std::map<int, int> fileDescriptors;  // fileId -> flushed raw descriptor
+  int8_t* curPtr = dst;
+  size_t bytesLeft = numBytes;
+  for (size_t pageNum = startPage; pageNum < startPage + numPagesToRead; ++pageNum) {
+    CHECK(multiPages_[pageNum].pageSize == pageSize_);
+    Page page = multiPages_[pageNum].current();
+    auto fdIt = fileDescriptors.find(page.fileId);
+    if (fdIt == fileDescriptors.end()) {
+      FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+      CHECK(fileInfo);
+      fdIt = fileDescriptors.emplace(page.fileId, fileInfo->flushAndGetDescriptor())
+                 .first;
+    }
+    if (fdIt->second < 0) {
+      return false;
+    }
+    const size_t pageOffset = pageNum == startPage ? startPageOffset : size_t(0);
+    const size_t readSize = min(pageDataSize_ - pageOffset, bytesLeft);
+    requests.push_back(PageReadRequest{
+        fdIt->second,
+        page.pageNum * pageSize_ + reservedHeaderSize_ + pageOffset,
+        readSize,
+        curPtr});
+    curPtr += readSize;
+    bytesLeft -= readSize;
+  }
+  CHECK(bytesLeft == 0);
+  return readPagesWithUring(requests);
+}
+
 void FileBuffer::read(int8_t* const dst,
                       const size_t numBytes,
                       const size_t offset,
@@ -259,6 +335,12 @@ void FileBuffer::read(int8_t* const dst,
 
   CHECK(startPage + numPagesToRead <= multiPages_.size());
 
+  if (g_enable_io_uring_reads && !g_enable_disk_chunk_compression &&
+      uringReadsAvailable() &&
+      readWithUring(dst, numBytes, startPage, startPageOffset, numPagesToRead)) {
+    return;
+  }
+
   size_t numPagesPerThread = 0;
   size_t numBytesCurrent = numBytes;  // total number of bytes still to be read
   size_t bytesRead = 0;               // total number of bytes already being read
@@ -346,6 +428,14 @@ void FileBuffer::copyPage(Page& srcPage,
   FileInfo* srcFileInfo = fm_->getFileInfoForFileId(srcPage.fileId);
   FileInfo* destFileInfo = fm_->getFileInfoForFileId(destPage.fileId);
 
+  if (g_enable_disk_chunk_compression) {
+    std::vector<int8_t> decompressed(pageDataSize_);
+    readAndDecompressPage(srcFileInfo, srcPage, decompressed.data());
+    patchCompressedPage(
+        destFileInfo, destPage, decompressed.data() + offset, offset, numBytes);
+    return;
+  }
+
   int8_t* buffer = new int8_t[numBytes];
   size_t bytesRead = srcFileInfo->read(
       srcPage.pageNum * pageSize_ + offset + reservedHeaderSize_, numBytes, buffer);
@@ -357,7 +447,20 @@ void FileBuffer::copyPage(Page& srcPage,
 }
 
 Page FileBuffer::addNewMultiPage(const int epoch) {
-  Page page = fm_->requestFreePage(pageSize_, false);
+  Page page;
+  if (g_chunk_extent_pages > 1 && !multiPages_.empty()) {
+    // growing chunk: draw from the chunk's reserved extent so consecutive
+    // logical pages stay physically adjacent on disk
+    if (reservedExtentPages_.empty()) {
+      const auto extent = fm_->requestFreePageExtent(pageSize_, g_chunk_extent_pages);
+      reservedExtentPages_.insert(
+          reservedExtentPages_.end(), extent.begin(), extent.end());
+    }
+    page = reservedExtentPages_.front();
+    reservedExtentPages_.pop_front();
+  } else {
+    page = fm_->requestFreePage(pageSize_, false);
+  }
   MultiPage multiPage(pageSize_);
   multiPage.epochs.push_back(epoch);
   multiPage.pageVersions.push_back(page);
@@ -365,10 +468,7 @@ Page FileBuffer::addNewMultiPage(const int epoch) {
   return page;
 }
 
-void FileBuffer::writeHeader(Page& page,
-                             const int pageId,
-                             const int epoch,
-                             const bool writeMetadata) {
+void FileBuffer::composeHeader(int8_t* dest, const int pageId, const int epoch) const {
   int intHeaderSize = chunkKey_.size() + 3;  // does not include chunkSize
   vector<int> header(intHeaderSize);
   // in addition to chunkkey we need size of header, pageId, version
@@ -378,10 +478,19 @@ void FileBuffer::writeHeader(Page& page,
   std::copy(chunkKey_.begin(), chunkKey_.end(), header.begin() + 1);
   header[intHeaderSize - 2] = pageId;
   header[intHeaderSize - 1] = epoch;
+  std::memcpy(dest, &header[0], intHeaderSize * sizeof(int));
+}
+
+void FileBuffer::writeHeader(Page& page,
+                             const int pageId,
+                             const int epoch,
+                             const bool writeMetadata) {
+  int intHeaderSize = chunkKey_.size() + 3;  // does not include chunkSize
+  vector<int8_t> header(intHeaderSize * sizeof(int));
+  composeHeader(&header[0], pageId, epoch);
   FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
   size_t pageSize = writeMetadata ? METADATA_PAGE_SIZE : pageSize_;
-  fileInfo->write(
-      page.pageNum * pageSize, (intHeaderSize) * sizeof(int), (int8_t*)&header[0]);
+  fileInfo->write(page.pageNum * pageSize, header.size(), &header[0]);
 }
 
 void FileBuffer::readMetadata(const Page& page) {
@@ -468,6 +577,34 @@ void FileBuffer::append(int8_t* src,
   size_t initialNumPages = multiPages_.size();
   size_ = size_ + numBytes;
   int epoch = fm_->epoch();
+
+  if (g_enable_vectored_page_writes && !g_enable_disk_chunk_compression) {
+    // patch the tail of the last existing page in place, then hand the fresh
+    // pages to the coalescing writer
+    size_t firstFreshPage = startPage;
+    if (startPage < initialNumPages) {
+      Page page = multiPages_[startPage].current();
+      CHECK(page.fileId >= 0);
+      FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+      size_t bytesWritten = fileInfo->write(
+          page.pageNum * pageSize_ + startPageOffset + reservedHeaderSize_,
+          min(pageDataSize_ - startPageOffset, bytesLeft),
+          curPtr);
+      curPtr += bytesWritten;
+      bytesLeft -= bytesWritten;
+      ++firstFreshPage;
+    }
+    if (firstFreshPage < startPage + numPagesToWrite) {
+      appendPagesVectored(curPtr,
+                          bytesLeft,
+                          firstFreshPage,
+                          startPage + numPagesToWrite - firstFreshPage,
+                          epoch);
+    }
+    CHECK(bytesLeft == 0);
+    return;
+  }
+
   for (size_t pageNum = startPage; pageNum < startPage + numPagesToWrite; ++pageNum) {
     Page page;
     if (pageNum >= initialNumPages) {
@@ -481,7 +618,14 @@ void FileBuffer::append(int8_t* src,
     CHECK(page.fileId >= 0);  // make sure page was initialized
     FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
     size_t bytesWritten;
-    if (pageNum == startPage) {
+    if (g_enable_disk_chunk_compression) {
+      const size_t pageOffset = (pageNum == startPage) ? startPageOffset : 0;
+      if (pageNum >= initialNumPages) {
+        zeroCompressedLen(page);  // fresh page, length field holds garbage
+      }
+      bytesWritten = min(pageDataSize_ - pageOffset, bytesLeft);
+      patchCompressedPage(fileInfo, page, curPtr, pageOffset, bytesWritten);
+    } else if (pageNum == startPage) {
       bytesWritten = fileInfo->write(
           page.pageNum * pageSize_ + startPageOffset + reservedHeaderSize_,
           min(pageDataSize_ - startPageOffset, bytesLeft),
@@ -497,6 +641,46 @@ void FileBuffer::append(int8_t* src,
   CHECK(bytesLeft == 0);
 }
 
+void FileBuffer::appendPagesVectored(int8_t*& curPtr,
+                                     size_t& bytesLeft,
+                                     const size_t firstPageNum,
+                                     const size_t numPages,
+                                     const int epoch) {
+  // allocate all pages up front so runs of file-contiguous pages are visible,
+  // then flush one full-page-image write per run
+  std::vector<Page> pages;
+  pages.reserve(numPages);
+  for (size_t i = 0; i < numPages; ++i) {
+    Page page = addNewMultiPage(epoch);
+    CHECK(page.fileId >= 0);
+    pages.push_back(page);
+  }
+  std::vector<int8_t> staging;
+  size_t runStart = 0;
+  while (runStart < numPages) {
+    size_t runEnd = runStart + 1;
+    while (runEnd < numPages && pages[runEnd].fileId == pages[runStart].fileId &&
+           pages[runEnd].pageNum == pages[runEnd - 1].pageNum + 1) {
+      ++runEnd;
+    }
+    const size_t runPages = runEnd - runStart;
+    staging.assign(runPages * pageSize_, 0);
+    for (size_t i = 0; i < runPages; ++i) {
+      int8_t* pageImage = &staging[i * pageSize_];
+      composeHeader(pageImage, firstPageNum + runStart + i, epoch);
+      const size_t dataBytes = min(pageDataSize_, bytesLeft);
+      std::memcpy(pageImage + reservedHeaderSize_, curPtr, dataBytes);
+      curPtr += dataBytes;
+      bytesLeft -= dataBytes;
+    }
+    FileInfo* fileInfo = fm_->getFileInfoForFileId(pages[runStart].fileId);
+    size_t bytesWritten =
+        fileInfo->write(pages[runStart].pageNum * pageSize_, staging.size(), &staging[0]);
+    CHECK(bytesWritten == staging.size());
+    runStart = runEnd;
+  }
+}
+
 void FileBuffer::write(int8_t* src,
                        const size_t numBytes,
                        const size_t offset,
@@ -532,6 +716,9 @@ void FileBuffer::write(int8_t* src,
     for (size_t pageNum = initialNumPages; pageNum < startPage; ++pageNum) {
       Page page = addNewMultiPage(epoch);
       writeHeader(page, pageNum, epoch);
+      if (g_enable_disk_chunk_compression) {
+        zeroCompressedLen(page);
+      }
     }
   }
   for (size_t pageNum = startPage; pageNum < startPage + numPagesToWrite; ++pageNum) {
@@ -539,6 +726,9 @@ void FileBuffer::write(int8_t* src,
     if (pageNum >= initialNumPages) {
       page = addNewMultiPage(epoch);
       writeHeader(page, pageNum, epoch);
+      if (g_enable_disk_chunk_compression) {
+        zeroCompressedLen(page);
+      }
     } else if (multiPages_[pageNum].epochs.back() <
                epoch) {  // need to create new page b/c this current one lags epoch and we
                          // can't overwrite it also need to copy if we are on first or
@@ -547,6 +737,9 @@ void FileBuffer::write(int8_t* src,
       page = fm_->requestFreePage(pageSize_, false);
       multiPages_[pageNum].epochs.push_back(epoch);
       multiPages_[pageNum].pageVersions.push_back(page);
+      if (g_enable_disk_chunk_compression) {
+        zeroCompressedLen(page);
+      }
       if (pageNum == startPage && startPageOffset > 0) {
         // copyPage takes care of header offset so don't worry
         // about it
@@ -569,7 +762,11 @@ void FileBuffer::write(int8_t* src,
     CHECK(page.fileId >= 0);  // make sure page was initialized
     FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
     size_t bytesWritten;
-    if (pageNum == startPage) {
+    if (g_enable_disk_chunk_compression) {
+      const size_t pageOffset = (pageNum == startPage) ? startPageOffset : 0;
+      bytesWritten = min(pageDataSize_ - pageOffset, bytesLeft);
+      patchCompressedPage(fileInfo, page, curPtr, pageOffset, bytesWritten);
+    } else if (pageNum == startPage) {
       bytesWritten = fileInfo->write(
           page.pageNum * pageSize_ + startPageOffset + reservedHeaderSize_,
           min(pageDataSize_ - startPageOffset, bytesLeft),
@@ -590,4 +787,72 @@ void FileBuffer::write(int8_t* src,
   CHECK(bytesLeft == 0);
 }
 
+void FileBuffer::readAndDecompressPage(FileInfo* file_info,
+                                       const Page& page,
+                                       int8_t* decompressed) const {
+  const size_t base = page.pageNum * pageSize_ + reservedHeaderSize_;
+  int32_t comp_len{0};
+  size_t bytesRead =
+      file_info->read(base, sizeof(int32_t), reinterpret_cast<int8_t*>(&comp_len));
+  CHECK_EQ(bytesRead, sizeof(int32_t));
+  if (comp_len <= 0 || static_cast<size_t>(comp_len) > pageDataSize_) {
+    // Page was allocated but never written through the compressed path; the
+    // uncompressed path would read uninitialized bytes here, we hand back
+    // zeros instead.
+    memset(decompressed, 0, pageDataSize_);
+    return;
+  }
+  std::vector<int8_t> compressed(comp_len);
+  bytesRead = file_info->read(base + sizeof(int32_t), comp_len, compressed.data());
+  CHECK_EQ(bytesRead, static_cast<size_t>(comp_len));
+  BloscCompressor::getCompressor()->decompressOrMemcpy(
+      reinterpret_cast<const uint8_t*>(compressed.data()),
+      comp_len,
+      reinterpret_cast<uint8_t*>(decompressed),
+      pageDataSize_);
+}
+
+void FileBuffer::compressAndWritePage(FileInfo* file_info,
+                                      const Page& page,
+                                      const int8_t* page_data) {
+  std::vector<int8_t> compressed(pageDataSize_);
+  const int32_t comp_len = BloscCompressor::getCompressor()->compressOrMemcpy(
+      reinterpret_cast<const uint8_t*>(page_data),
+      reinterpret_cast<uint8_t*>(compressed.data()),
+      pageDataSize_,
+      0);
+  const size_t base = page.pageNum * pageSize_ + reservedHeaderSize_;
+  size_t bytesWritten = file_info->write(
+      base, sizeof(int32_t), reinterpret_cast<int8_t*>(const_cast<int32_t*>(&comp_len)));
+  CHECK_EQ(bytesWritten, sizeof(int32_t));
+  bytesWritten = file_info->write(base + sizeof(int32_t), comp_len, compressed.data());
+  CHECK_EQ(bytesWritten, static_cast<size_t>(comp_len));
+}
+
+void FileBuffer::patchCompressedPage(FileInfo* file_info,
+                                     const Page& page,
+                                     const int8_t* src,
+                                     const size_t offset_in_page,
+                                     const size_t num_bytes) {
+  CHECK_LE(offset_in_page + num_bytes, pageDataSize_);
+  if (offset_in_page == 0 && num_bytes == pageDataSize_) {
+    compressAndWritePage(file_info, page, src);
+    return;
+  }
+  // Partial page write: decompress the current contents, apply the
+  // modification and write the page back compressed.
+  std::vector<int8_t> decompressed(pageDataSize_);
+  readAndDecompressPage(file_info, page, decompressed.data());
+  memcpy(decompressed.data() + offset_in_page, src, num_bytes);
+  compressAndWritePage(file_info, page, decompressed.data());
+}
+
+void FileBuffer::zeroCompressedLen(const Page& page) {
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  int32_t zero_len{0};
+  fileInfo->write(page.pageNum * pageSize_ + reservedHeaderSize_,
+                  sizeof(int32_t),
+                  reinterpret_cast<int8_t*>(&zero_len));
+}
+
 }  // namespace File_Namespace
@@ -27,6 +27,7 @@
 #include "Page.h"
 #include "Shared/Logger.h"
 
+#include <deque>
 #include <iostream>
 #include <stdexcept>
 
@@ -38,6 +39,21 @@ using namespace Data_Namespace;
 namespace File_Namespace {
 
 class FileMgr;  // forward declaration
+class FileInfo;
+
+// Compress data page payloads on disk (Blosc), trading CPU for disk I/O and
+// space. Only valid for data directories created with the flag enabled.
+extern bool g_enable_disk_chunk_compression;
+
+// Coalesce the freshly allocated pages of a multi-page append into one large
+// sequential write per run of file-contiguous pages, instead of two syscalls
+// (header, data) per page.
+extern bool g_enable_vectored_page_writes;
+
+// Number of pages a growing chunk reserves per extent once it is past its
+// first page; 1 disables extent reservation and pages come from wherever the
+// free list points.
+extern size_t g_chunk_extent_pages;
 
 /**
  * @class   FileBuffer
@@ -148,6 +164,23 @@ class FileBuffer : public AbstractBuffer {
   /// flush/checkpoint.
   bool isDirty() const override { return isDirty_; }
 
+  // Compressed page helpers, active under --enable-disk-chunk-compression.
+  // Each data page payload is stored as a 4-byte compressed length followed by
+  // the Blosc-compressed (or raw, when incompressible) page contents; readers
+  // decompress a whole page and copy out the requested range.
+  void readAndDecompressPage(FileInfo* file_info,
+                             const Page& page,
+                             int8_t* decompressed) const;
+  void compressAndWritePage(FileInfo* file_info,
+                            const Page& page,
+                            const int8_t* page_data);
+  void patchCompressedPage(FileInfo* file_info,
+                           const Page& page,
+                           const int8_t* src,
+                           const size_t offset_in_page,
+                           const size_t num_bytes);
+  void zeroCompressedLen(const Page& page);
+
  private:
   // FileBuffer(const FileBuffer&);      // private copy constructor
   // FileBuffer& operator=(const FileBuffer&); // private overloaded assignment operator
@@ -160,15 +193,35 @@ class FileBuffer : public AbstractBuffer {
                    const int pageId,
                    const int epoch,
                    const bool writeMetadata = false);
+  void composeHeader(int8_t* dest, const int pageId, const int epoch) const;
+
+  /// Composes full page images (header plus data) for the freshly allocated
+  /// pages of an append and writes each run of file-contiguous pages with a
+  /// single large write. Advances curPtr/bytesLeft past the consumed data.
+  void appendPagesVectored(int8_t*& curPtr,
+                           size_t& bytesLeft,
+                           const size_t firstPageNum,
+                           const size_t numPages,
+                           const int epoch);
   void writeMetadata(const int epoch);
   void readMetadata(const Page& page);
   void calcHeaderBuffer();
 
+  /// Batches the page reads of this buffer into io_uring submissions,
+  /// completing directly into dst. Returns false when io_uring is not usable
+  /// so read() falls back to the synchronous threaded path.
+  bool readWithUring(int8_t* const dst,
+                     const size_t numBytes,
+                     const size_t startPage,
+                     const size_t startPageOffset,
+                     const size_t numPagesToRead);
+
   FileMgr* fm_;  // a reference to FileMgr is needed for writing to new pages in available
                  // files
   static size_t headerBufferOffset_;
   MultiPage metadataPages_;
   std::vector<MultiPage> multiPages_;
+  std::deque<Page> reservedExtentPages_;  // extent pages not yet used by a MultiPage
   size_t pageSize_;
   size_t pageDataSize_;
   size_t reservedHeaderSize_;  // lets make this a constant now for simplicity - 128 bytes
@@ -66,6 +66,14 @@ size_t FileInfo::read(const size_t offset, const size_t size, int8_t* buf) {
   return File_Namespace::read(f, offset, size, buf);
 }
 
+int FileInfo::flushAndGetDescriptor() {
+  std::lock_guard<std::mutex> lock(readWriteMutex_);
+  if (fflush(f) != 0) {
+    return -1;
+  }
+  return fileno(f);
+}
+
 void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec,
                                 const int fileMgrEpoch) {
   // HeaderInfo is defined in Page.h
@@ -235,6 +243,31 @@ int FileInfo::getFreePage() {
   return pageNum;
 }
 
+int FileInfo::getFreePageRun(const size_t numPages) {
+  std::lock_guard<std::mutex> lock(freePagesMutex_);
+  if (freePages.size() < numPages) {
+    return -1;
+  }
+  // freePages is sorted, so one pass finds the first run of adjacent pages
+  size_t runStart = 0;
+  size_t runLen = 0;
+  size_t prev = 0;
+  for (const auto pageNum : freePages) {
+    if (runLen == 0 || pageNum != prev + 1) {
+      runStart = pageNum;
+      runLen = 1;
+    } else {
+      ++runLen;
+    }
+    prev = pageNum;
+    if (runLen == numPages) {
+      freePages.erase(freePages.lower_bound(runStart), freePages.upper_bound(pageNum));
+      return static_cast<int>(runStart);
+    }
+  }
+  return -1;
+}
+
 void FileInfo::print(bool pagesummary) {
   std::cout << "File: " << fileId << std::endl;
   std::cout << "Size: " << size() << std::endl;
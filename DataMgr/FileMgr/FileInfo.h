@@ -79,9 +79,18 @@ struct FileInfo {
   void freePageDeferred(int pageId);
   void freePage(int pageId);
   int getFreePage();
+
+  /// Removes and returns the first page of a run of numPages consecutive
+  /// free pages, or -1 if the file contains no such run.
+  int getFreePageRun(const size_t numPages);
   size_t write(const size_t offset, const size_t size, int8_t* buf);
   size_t read(const size_t offset, const size_t size, int8_t* buf);
 
+  /// Flushes buffered writes and returns the raw descriptor, so pread style
+  /// readers (io_uring) see everything written through the stream. Returns -1
+  /// on flush failure.
+  int flushAndGetDescriptor();
+
   void openExistingFile(std::vector<HeaderInfo>& headerVec, const int fileMgrEpoch);
   /// Prints a summary of the file to stdout
   void print(bool pagesummary);
@@ -44,6 +44,18 @@ using namespace std;
 
 namespace File_Namespace {
 
+// Number of workers fsyncing data files at checkpoint; 1 keeps the serial
+// loop. Each file is flushed and fsynced exactly once, by one worker.
+size_t g_checkpoint_sync_threads{1};
+// Skip the flush/fsync/epoch write for tables with no dirty chunks and no
+// deferred page frees, so checkpointing the whole instance only stalls on
+// tables that actually advanced.
+bool g_enable_incremental_checkpoints{false};
+// Pages per data file. Raising it shrinks the file count of large table
+// directories (and the directory scan, backup and open costs that come with
+// it) at the price of coarser file-grained space reclamation.
+size_t g_data_file_pages{MAX_FILE_N_PAGES};
+
 bool headerCompare(const HeaderInfo& firstElem, const HeaderInfo& secondElem) {
   // HeaderInfo.first is a pair of Chunk key with a vector containing
   // pageId and version
@@ -575,6 +587,7 @@ void FileMgr::writeAndSyncDBMetaToDisk() {
 void FileMgr::checkpoint() {
   VLOG(2) << "Checkpointing epoch: " << epoch_;
   mapd_unique_lock<mapd_shared_mutex> chunkIndexWriteLock(chunkIndexMutex_);
+  bool wroteDirtyChunks = false;
   for (auto chunkIt = chunkIndex_.begin(); chunkIt != chunkIndex_.end(); ++chunkIt) {
     /*
     for (auto vecIt = chunkIt->first.begin(); vecIt != chunkIt->first.end(); ++vecIt) {
@@ -585,15 +598,47 @@ void FileMgr::checkpoint() {
     if (chunkIt->second->isDirty_) {
       chunkIt->second->writeMetadata(epoch_);
       chunkIt->second->clearDirtyBits();
+      wroteDirtyChunks = true;
     }
   }
   chunkIndexWriteLock.unlock();
 
+  if (g_enable_incremental_checkpoints && !wroteDirtyChunks) {
+    mapd_shared_lock<mapd_shared_mutex> freePagesReadLock(mutex_free_page);
+    if (free_pages.empty()) {
+      // nothing advanced since the last checkpoint, so there is nothing to
+      // make durable and the fsync pass can be skipped entirely
+      VLOG(2) << "Skipping checkpoint sync for epoch: " << epoch_
+              << ", no dirty chunks or deferred free pages";
+      return;
+    }
+  }
+
   mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
-  for (auto fileIt = files_.begin(); fileIt != files_.end(); ++fileIt) {
-    int status = (*fileIt)->syncToDisk();
-    if (status != 0) {
-      LOG(FATAL) << "Could not sync file to disk";
+  const size_t numSyncThreads =
+      std::max(std::min(g_checkpoint_sync_threads, files_.size()), size_t(1));
+  if (numSyncThreads > 1) {
+    std::vector<std::future<void>> syncThreads;
+    for (size_t threadNum = 0; threadNum < numSyncThreads; ++threadNum) {
+      syncThreads.push_back(
+          std::async(std::launch::async, [this, threadNum, numSyncThreads] {
+            for (size_t fileNum = threadNum; fileNum < files_.size();
+                 fileNum += numSyncThreads) {
+              if (files_[fileNum]->syncToDisk() != 0) {
+                LOG(FATAL) << "Could not sync file to disk";
+              }
+            }
+          }));
+    }
+    for (auto& syncThread : syncThreads) {
+      syncThread.get();
+    }
+  } else {
+    for (auto fileIt = files_.begin(); fileIt != files_.end(); ++fileIt) {
+      int status = (*fileIt)->syncToDisk();
+      if (status != 0) {
+        LOG(FATAL) << "Could not sync file to disk";
+      }
     }
   }
 
@@ -815,13 +860,41 @@ Page FileMgr::requestFreePage(size_t pageSize, const bool isMetadata) {
   if (isMetadata) {
     fileInfo = createFile(pageSize, MAX_FILE_N_METADATA_PAGES);
   } else {
-    fileInfo = createFile(pageSize, MAX_FILE_N_PAGES);
+    fileInfo = createFile(pageSize, g_data_file_pages);
   }
   pageNum = fileInfo->getFreePage();
   assert(pageNum != -1);
   return (Page(fileInfo->fileId, pageNum));
 }
 
+std::vector<Page> FileMgr::requestFreePageExtent(size_t pageSize,
+                                                 const size_t numPages) {
+  std::lock_guard<std::mutex> lock(getPageMutex_);
+  const size_t extentPages = std::min(numPages, g_data_file_pages);
+  const auto makeExtent = [extentPages](const int fileId, const int firstPageNum) {
+    std::vector<Page> extent;
+    extent.reserve(extentPages);
+    for (size_t i = 0; i < extentPages; ++i) {
+      extent.emplace_back(fileId, firstPageNum + i);
+    }
+    return extent;
+  };
+  auto candidateFiles = fileIndex_.equal_range(pageSize);
+  for (auto fileIt = candidateFiles.first; fileIt != candidateFiles.second; ++fileIt) {
+    FileInfo* fileInfo = files_[fileIt->second];
+    const int firstPageNum = fileInfo->getFreePageRun(extentPages);
+    if (firstPageNum != -1) {
+      return makeExtent(fileInfo->fileId, firstPageNum);
+    }
+  }
+  // existing files are too fragmented for a run of this length; a fresh file
+  // always has one
+  FileInfo* fileInfo = createFile(pageSize, g_data_file_pages);
+  const int firstPageNum = fileInfo->getFreePageRun(extentPages);
+  CHECK(firstPageNum != -1);
+  return makeExtent(fileInfo->fileId, firstPageNum);
+}
+
 void FileMgr::requestFreePages(size_t numPagesRequested,
                                size_t pageSize,
                                std::vector<Page>& pages,
@@ -850,7 +923,7 @@ void FileMgr::requestFreePages(size_t numPagesRequested,
     if (isMetadata) {
       fileInfo = createFile(pageSize, MAX_FILE_N_METADATA_PAGES);
     } else {
-      fileInfo = createFile(pageSize, MAX_FILE_N_PAGES);
+      fileInfo = createFile(pageSize, g_data_file_pages);
     }
     int pageNum;
     do {
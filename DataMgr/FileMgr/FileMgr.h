@@ -144,6 +144,12 @@ class FileMgr : public AbstractBufferMgr {  // implements
   // virtual AbstractBuffer* putBuffer(AbstractBuffer *d);
   Page requestFreePage(size_t pagesize, const bool isMetadata);
 
+  /// Removes and returns an extent - a run of numPages file-contiguous free
+  /// pages - creating a new file if no existing file has such a run. Chunks
+  /// draw their pages from extents so logically sequential pages stay
+  /// physically sequential on disk.
+  std::vector<Page> requestFreePageExtent(size_t pageSize, const size_t numPages);
+
   inline MgrType getMgrType() override { return FILE_MGR; };
   inline std::string getStringMgrType() override { return ToString(FILE_MGR); }
   inline std::string printSlabs() override { return "Not Implemented"; }
@@ -132,14 +132,18 @@ FileMgr* GlobalFileMgr::findFileMgr(const int db_id,
                                     const bool removeFromMap) {
   FileMgr* fm = nullptr;
   const auto file_mgr_key = std::make_pair(db_id, tb_id);
-  {
-    mapd_lock_guard<mapd_shared_mutex> read_lock(fileMgrs_mutex_);
+  if (removeFromMap) {
+    mapd_lock_guard<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
+    auto it = fileMgrs_.find(file_mgr_key);
+    if (it != fileMgrs_.end()) {
+      fm = it->second;
+      fileMgrs_.erase(it);
+    }
+  } else {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(fileMgrs_mutex_);
     auto it = fileMgrs_.find(file_mgr_key);
     if (it != fileMgrs_.end()) {
       fm = it->second;
-      if (removeFromMap) {
-        fileMgrs_.erase(it);
-      }
     }
   }
   return fm;
@@ -153,20 +157,36 @@ FileMgr* GlobalFileMgr::getFileMgr(const int db_id, const int tb_id) {
     }
   }
 
-  { /* create new FileMgr for (db_id, tb_id) */
-    const auto file_mgr_key = std::make_pair(db_id, tb_id);
-    mapd_lock_guard<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
-    auto it = fileMgrs_.find(file_mgr_key);
-    if (it != fileMgrs_.end()) {
-      return it->second;
+  /* create new FileMgr for (db_id, tb_id); the data file scan in the FileMgr
+   * constructor can take a while for a big table, so it runs under a per-table
+   * initialization mutex instead of the global map lock - tables initialize
+   * their metadata in parallel and lookups for already initialized tables are
+   * not blocked behind the scan */
+  const auto file_mgr_key = std::make_pair(db_id, tb_id);
+  std::shared_ptr<std::mutex> init_mutex;
+  {
+    std::lock_guard<std::mutex> init_map_lock(fileMgrInitMutexesMutex_);
+    auto& mutex_for_key = fileMgrInitMutexes_[file_mgr_key];
+    if (!mutex_for_key) {
+      mutex_for_key = std::make_shared<std::mutex>();
+    }
+    init_mutex = mutex_for_key;
+  }
+  std::lock_guard<std::mutex> init_lock(*init_mutex);
+  { /* check if another thread created the FileMgr while we waited */
+    FileMgr* fm = findFileMgr(db_id, tb_id);
+    if (fm != nullptr) {
+      return fm;
     }
-    FileMgr* fm =
-        new FileMgr(0, this, file_mgr_key, num_reader_threads_, epoch_, defaultPageSize_);
+  }
+  FileMgr* fm =
+      new FileMgr(0, this, file_mgr_key, num_reader_threads_, epoch_, defaultPageSize_);
+  {
+    mapd_lock_guard<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
     auto it_ok = fileMgrs_.insert(std::make_pair(file_mgr_key, fm));
     CHECK(it_ok.second);
-
-    return fm;
   }
+  return fm;
 }
 
 void GlobalFileMgr::writeFileMgrData(
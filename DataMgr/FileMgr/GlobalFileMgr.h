@@ -28,6 +28,7 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include "../Shared/mapd_shared_mutex.h"
@@ -182,6 +183,10 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
                     /// "mapd_db_version_"
   std::map<std::pair<int, int>, FileMgr*> fileMgrs_;
   mapd_shared_mutex fileMgrs_mutex_;
+  // serializes initialization per table so that the data file scan of one
+  // table does not block lookups or the initialization of other tables
+  std::map<std::pair<int, int>, std::shared_ptr<std::mutex>> fileMgrInitMutexes_;
+  std::mutex fileMgrInitMutexesMutex_;
 };
 
 }  // namespace File_Namespace
@@ -0,0 +1,292 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UringPageReader.h"
+
+#include "Shared/Logger.h"
+
+bool g_enable_io_uring_reads{false};
+size_t g_io_uring_queue_depth{128};
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define HAVE_IO_URING 1
+#endif
+#endif
+
+#ifdef HAVE_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace File_Namespace {
+
+namespace {
+
+// liburing is not a dependency of this tree, so drive the ring with the raw
+// system calls directly.
+int io_uring_setup_syscall(const unsigned entries, io_uring_params* params) {
+  return syscall(__NR_io_uring_setup, entries, params);
+}
+
+int io_uring_enter_syscall(const int ring_fd,
+                           const unsigned to_submit,
+                           const unsigned min_complete,
+                           const unsigned flags) {
+  return syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+// The kernel may complete a read short of the requested size (e.g. when it
+// crosses an internal boundary); finish the tail synchronously rather than
+// resubmitting.
+bool finish_short_read(const PageReadRequest& request, size_t bytes_done) {
+  while (bytes_done < request.size) {
+    const auto bytes_read = pread(request.fd,
+                                  request.dst + bytes_done,
+                                  request.size - bytes_done,
+                                  request.offset + bytes_done);
+    if (bytes_read <= 0) {
+      LOG(WARNING) << "io_uring read tail failed, errno " << errno;
+      return false;
+    }
+    bytes_done += bytes_read;
+  }
+  return true;
+}
+
+// One ring, alive for the duration of one chunk read. Owns the ring
+// descriptor and the three kernel mappings (submission ring, completion
+// ring, SQE array).
+class UringReader {
+ public:
+  explicit UringReader(const unsigned entries) {
+    std::memset(&params_, 0, sizeof(params_));
+    ring_fd_ = io_uring_setup_syscall(entries, &params_);
+    if (ring_fd_ < 0) {
+      return;
+    }
+    sq_ring_bytes_ = params_.sq_off.array + params_.sq_entries * sizeof(unsigned);
+    cq_ring_bytes_ = params_.cq_off.cqes + params_.cq_entries * sizeof(io_uring_cqe);
+#ifdef IORING_FEAT_SINGLE_MMAP
+    const bool single_mmap = params_.features & IORING_FEAT_SINGLE_MMAP;
+#else
+    const bool single_mmap = false;
+#endif
+    if (single_mmap) {
+      sq_ring_bytes_ = cq_ring_bytes_ = std::max(sq_ring_bytes_, cq_ring_bytes_);
+    }
+    sq_ring_ = mmap(nullptr,
+                    sq_ring_bytes_,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    ring_fd_,
+                    IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+      sq_ring_ = nullptr;
+      teardown();
+      return;
+    }
+    if (single_mmap) {
+      cq_ring_ = sq_ring_;
+    } else {
+      cq_ring_ = mmap(nullptr,
+                      cq_ring_bytes_,
+                      PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE,
+                      ring_fd_,
+                      IORING_OFF_CQ_RING);
+      if (cq_ring_ == MAP_FAILED) {
+        cq_ring_ = nullptr;
+        teardown();
+        return;
+      }
+    }
+    sqes_ = static_cast<io_uring_sqe*>(mmap(nullptr,
+                                            params_.sq_entries * sizeof(io_uring_sqe),
+                                            PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE,
+                                            ring_fd_,
+                                            IORING_OFF_SQES));
+    if (sqes_ == MAP_FAILED) {
+      sqes_ = nullptr;
+      teardown();
+      return;
+    }
+    auto sq_base = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq_base + params_.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq_base + params_.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned*>(sq_base + params_.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq_base + params_.sq_off.array);
+    auto cq_base = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq_base + params_.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq_base + params_.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(cq_base + params_.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq_base + params_.cq_off.cqes);
+  }
+
+  ~UringReader() { teardown(); }
+
+  UringReader(const UringReader&) = delete;
+  UringReader& operator=(const UringReader&) = delete;
+
+  bool valid() const { return ring_fd_ >= 0 && sqes_; }
+
+  bool run(const std::vector<PageReadRequest>& requests) {
+    // The iovecs must stay alive until their completions are reaped.
+    std::vector<iovec> iovecs(requests.size());
+    size_t submitted = 0;
+    size_t completed = 0;
+    bool ok = true;
+    while (completed < requests.size()) {
+      unsigned to_submit = 0;
+      unsigned tail = *sq_tail_;
+      const unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+      while (submitted < requests.size() && tail - head < params_.sq_entries) {
+        const auto& request = requests[submitted];
+        iovecs[submitted].iov_base = request.dst;
+        iovecs[submitted].iov_len = request.size;
+        const unsigned slot = tail & sq_mask_;
+        io_uring_sqe& sqe = sqes_[slot];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = request.fd;
+        sqe.off = request.offset;
+        sqe.addr = reinterpret_cast<uintptr_t>(&iovecs[submitted]);
+        sqe.len = 1;
+        sqe.user_data = submitted;
+        sq_array_[slot] = slot;
+        ++tail;
+        ++submitted;
+        ++to_submit;
+      }
+      __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+      if (io_uring_enter_syscall(ring_fd_, to_submit, 1, IORING_ENTER_GETEVENTS) < 0) {
+        LOG(WARNING) << "io_uring_enter failed, errno " << errno;
+        return false;
+      }
+      unsigned cq_head = *cq_head_;
+      const unsigned cq_tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      while (cq_head != cq_tail) {
+        const io_uring_cqe& cqe = cqes_[cq_head & cq_mask_];
+        const auto& request = requests[cqe.user_data];
+        if (cqe.res < 0) {
+          LOG(WARNING) << "io_uring read failed, errno " << -cqe.res;
+          ok = false;
+        } else if (static_cast<size_t>(cqe.res) != request.size &&
+                   !finish_short_read(request, cqe.res)) {
+          ok = false;
+        }
+        ++cq_head;
+        ++completed;
+      }
+      __atomic_store_n(cq_head_, cq_head, __ATOMIC_RELEASE);
+    }
+    return ok;
+  }
+
+ private:
+  void teardown() {
+    if (sqes_) {
+      munmap(sqes_, params_.sq_entries * sizeof(io_uring_sqe));
+      sqes_ = nullptr;
+    }
+    if (cq_ring_ && cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_bytes_);
+    }
+    cq_ring_ = nullptr;
+    if (sq_ring_) {
+      munmap(sq_ring_, sq_ring_bytes_);
+      sq_ring_ = nullptr;
+    }
+    if (ring_fd_ >= 0) {
+      close(ring_fd_);
+      ring_fd_ = -1;
+    }
+  }
+
+  io_uring_params params_;
+  int ring_fd_ = -1;
+  void* sq_ring_ = nullptr;
+  void* cq_ring_ = nullptr;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sq_ring_bytes_ = 0;
+  size_t cq_ring_bytes_ = 0;
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+};
+
+}  // namespace
+
+bool uringReadsAvailable() {
+  static const bool available = [] {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    const int ring_fd = io_uring_setup_syscall(4, &params);
+    if (ring_fd < 0) {
+      LOG(INFO) << "io_uring not available on this kernel, page reads stay synchronous";
+      return false;
+    }
+    close(ring_fd);
+    return true;
+  }();
+  return available;
+}
+
+bool readPagesWithUring(const std::vector<PageReadRequest>& requests) {
+  if (requests.empty()) {
+    return true;
+  }
+  const unsigned entries =
+      std::min(std::max(g_io_uring_queue_depth, size_t(1)), size_t(4096));
+  UringReader reader(entries);
+  if (!reader.valid()) {
+    LOG(WARNING) << "Failed to create io_uring with " << entries << " entries, errno "
+                 << errno;
+    return false;
+  }
+  return reader.run(requests);
+}
+
+}  // namespace File_Namespace
+
+#else  // HAVE_IO_URING
+
+namespace File_Namespace {
+
+bool uringReadsAvailable() {
+  return false;
+}
+
+bool readPagesWithUring(const std::vector<PageReadRequest>&) {
+  return false;
+}
+
+}  // namespace File_Namespace
+
+#endif  // HAVE_IO_URING
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    UringPageReader.h
+ * @brief   Batched asynchronous page reads over io_uring.
+ *
+ * A cold chunk read issues one synchronous read per logical page, which
+ * leaves NVMe queues nearly empty. When enabled, FileBuffer::read collects
+ * the page reads of a chunk into PageReadRequests and submits them all to
+ * one io_uring instance, keeping up to g_io_uring_queue_depth reads in
+ * flight and completing directly into the destination buffer.
+ */
+
+#ifndef DATAMGR_FILEMGR_URINGPAGEREADER_H
+#define DATAMGR_FILEMGR_URINGPAGEREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Batch the page reads of a chunk into io_uring submissions instead of
+// synchronous per page reads. Requires a Linux kernel with io_uring support
+// (5.1+); silently falls back to the synchronous path otherwise.
+extern bool g_enable_io_uring_reads;
+extern size_t g_io_uring_queue_depth;
+
+namespace File_Namespace {
+
+struct PageReadRequest {
+  int fd;         // raw descriptor of the data file holding the page
+  size_t offset;  // byte offset of the read within the file
+  size_t size;    // number of bytes to read
+  int8_t* dst;    // destination; the read completes directly into it
+};
+
+/// True if the running kernel accepts the io_uring system calls. Probed once
+/// and cached.
+bool uringReadsAvailable();
+
+/// Submits all requests to a single io_uring instance, keeping at most
+/// g_io_uring_queue_depth reads in flight, and waits for every completion.
+/// Returns false if the ring could not be created or a read failed; the
+/// caller falls back to the synchronous path and no bytes of dst should be
+/// trusted.
+bool readPagesWithUring(const std::vector<PageReadRequest>& requests);
+
+}  // namespace File_Namespace
+
+#endif  // DATAMGR_FILEMGR_URINGPAGEREADER_H
@@ -41,22 +41,25 @@ class FixedLengthEncoder : public Encoder {
                            const bool replicating = false) override {
     T* unencodedData = reinterpret_cast<T*>(srcData);
     auto encodedData = std::make_unique<V[]>(numAppendElems);
-    for (size_t i = 0; i < numAppendElems; ++i) {
-      size_t ri = replicating ? 0 : i;
-      encodedData.get()[i] = static_cast<V>(unencodedData[ri]);
-      if (unencodedData[ri] != encodedData.get()[i]) {
-        decimal_overflow_validator_.validate(unencodedData[ri]);
-        LOG(ERROR) << "Fixed encoding failed, Unencoded: " +
-                          std::to_string(unencodedData[ri]) +
-                          " encoded: " + std::to_string(encodedData.get()[i]);
-      } else {
-        T data = unencodedData[ri];
-        if (data == std::numeric_limits<V>::min()) {
-          has_nulls = true;
+    if (replicating ||
+        !encodeAndUpdateStats(unencodedData, encodedData.get(), numAppendElems)) {
+      for (size_t i = 0; i < numAppendElems; ++i) {
+        size_t ri = replicating ? 0 : i;
+        encodedData.get()[i] = static_cast<V>(unencodedData[ri]);
+        if (unencodedData[ri] != encodedData.get()[i]) {
+          decimal_overflow_validator_.validate(unencodedData[ri]);
+          LOG(ERROR) << "Fixed encoding failed, Unencoded: " +
+                            std::to_string(unencodedData[ri]) +
+                            " encoded: " + std::to_string(encodedData.get()[i]);
         } else {
-          decimal_overflow_validator_.validate(data);
-          dataMin = std::min(dataMin, data);
-          dataMax = std::max(dataMax, data);
+          T data = unencodedData[ri];
+          if (data == std::numeric_limits<V>::min()) {
+            has_nulls = true;
+          } else {
+            decimal_overflow_validator_.validate(data);
+            dataMin = std::min(dataMin, data);
+            dataMax = std::max(dataMax, data);
+          }
         }
       }
     }
@@ -84,6 +87,46 @@ class FixedLengthEncoder : public Encoder {
     return chunk_metadata;
   }
 
+  // Encode the whole append buffer in one vectorizable pass and scan stats in
+  // a second, instead of branching per value. Returns false without touching
+  // any state when a value does not survive the narrowing cast; the caller
+  // falls back to the per-value path for its validation and error logging.
+  bool encodeAndUpdateStats(const T* const data,
+                            V* const encoded,
+                            const size_t num_elements) {
+    bool lossy = false;
+    for (size_t i = 0; i < num_elements; ++i) {
+      encoded[i] = static_cast<V>(data[i]);
+      lossy |= static_cast<T>(encoded[i]) != data[i];
+    }
+    if (lossy) {
+      return false;
+    }
+    if (decimal_overflow_validator_.doCheck()) {
+      // validate up front so a throw cannot leave half-updated stats behind
+      for (size_t i = 0; i < num_elements; ++i) {
+        if (data[i] != std::numeric_limits<V>::min()) {
+          decimal_overflow_validator_.validate(data[i]);
+        }
+      }
+    }
+    const T null_value = std::numeric_limits<V>::min();
+    T min_val = dataMin;
+    T max_val = dataMax;
+    bool any_nulls = has_nulls;
+    for (size_t i = 0; i < num_elements; ++i) {
+      const T val = data[i];
+      const bool is_null = (val == null_value);
+      any_nulls |= is_null;
+      min_val = std::min(min_val, is_null ? std::numeric_limits<T>::max() : val);
+      max_val = std::max(max_val, is_null ? std::numeric_limits<T>::lowest() : val);
+    }
+    dataMin = min_val;
+    dataMax = max_val;
+    has_nulls = any_nulls;
+    return true;
+  }
+
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
     if (is_null) {
@@ -45,13 +45,8 @@ class NoneEncoder : public Encoder {
     std::vector<T> encoded_data;
     if (replicating) {
       encoded_data.resize(numAppendElems);
-    }
-    for (size_t i = 0; i < numAppendElems; ++i) {
-      size_t ri = replicating ? 0 : i;
-      T data = unencodedData[ri];
-      if (replicating) {
-        encoded_data[i] = data;
-      }
+      T data = unencodedData[0];
+      std::fill(encoded_data.begin(), encoded_data.end(), data);
       if (data == none_encoded_null_value<T>()) {
         has_nulls = true;
       } else {
@@ -59,6 +54,16 @@ class NoneEncoder : public Encoder {
         dataMin = std::min(dataMin, data);
         dataMax = std::max(dataMax, data);
       }
+    } else {
+      if (decimal_overflow_validator_.doCheck()) {
+        // validate up front so a throw cannot leave half-updated stats behind
+        for (size_t i = 0; i < numAppendElems; ++i) {
+          if (unencodedData[i] != none_encoded_null_value<T>()) {
+            decimal_overflow_validator_.validate(unencodedData[i]);
+          }
+        }
+      }
+      updateStats(unencodedData, numAppendElems);
     }
     num_elems_ += numAppendElems;
     buffer_->append(
@@ -84,6 +89,25 @@ class NoneEncoder : public Encoder {
     return chunk_metadata;
   }
 
+  // Batch stats scan over a whole append buffer: a single branch-free pass
+  // the compiler can vectorize, instead of a compare-and-branch per value.
+  void updateStats(const T* const data, const size_t num_elements) {
+    const T null_value = none_encoded_null_value<T>();
+    T min_val = dataMin;
+    T max_val = dataMax;
+    bool any_nulls = has_nulls;
+    for (size_t i = 0; i < num_elements; ++i) {
+      const T val = data[i];
+      const bool is_null = (val == null_value);
+      any_nulls |= is_null;
+      min_val = std::min(min_val, is_null ? std::numeric_limits<T>::max() : val);
+      max_val = std::max(max_val, is_null ? std::numeric_limits<T>::lowest() : val);
+    }
+    dataMin = min_val;
+    dataMax = max_val;
+    has_nulls = any_nulls;
+  }
+
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
     if (is_null) {
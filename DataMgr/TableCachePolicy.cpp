@@ -0,0 +1,66 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TableCachePolicy.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace Data_Namespace {
+
+namespace {
+
+std::mutex policy_map_mutex;
+std::map<std::pair<int, int>, TableCachePolicy> policy_map;
+// Lock free fast path for the common case of no table carrying a policy,
+// so eviction scans in deployments which never use the feature pay nothing.
+std::atomic<size_t> policy_count{0};
+
+}  // namespace
+
+void setTableCachePolicy(const int db_id,
+                         const int table_id,
+                         const TableCachePolicy policy) {
+  std::lock_guard<std::mutex> lock(policy_map_mutex);
+  if (policy == CACHE_NORMAL) {
+    policy_count -= policy_map.erase(std::make_pair(db_id, table_id));
+    return;
+  }
+  const auto it_ok = policy_map.emplace(std::make_pair(db_id, table_id), policy);
+  if (it_ok.second) {
+    ++policy_count;
+  } else {
+    it_ok.first->second = policy;
+  }
+}
+
+void clearTableCachePolicy(const int db_id, const int table_id) {
+  std::lock_guard<std::mutex> lock(policy_map_mutex);
+  policy_count -= policy_map.erase(std::make_pair(db_id, table_id));
+}
+
+TableCachePolicy getTableCachePolicy(const ChunkKey& key) {
+  if (policy_count.load(std::memory_order_relaxed) == 0 || key.size() < 2) {
+    return CACHE_NORMAL;
+  }
+  std::lock_guard<std::mutex> lock(policy_map_mutex);
+  const auto it = policy_map.find(std::make_pair(key[0], key[1]));
+  return it == policy_map.end() ? CACHE_NORMAL : it->second;
+}
+
+}  // namespace Data_Namespace
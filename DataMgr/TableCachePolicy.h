@@ -0,0 +1,41 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TABLECACHEPOLICY_H
+#define TABLECACHEPOLICY_H
+
+#include "../Shared/types.h"
+
+namespace Data_Namespace {
+
+// Per-table buffer pool caching policy. CACHE_PIN chunks are not evicted
+// from the CPU/GPU buffer pools while the pool's total pinned footprint
+// fits within the reserved quota; CACHE_BYPASS chunks are the first
+// eviction candidates, so they never displace anyone else's working set.
+enum TableCachePolicy { CACHE_NORMAL = 0, CACHE_PIN = 1, CACHE_BYPASS = 2 };
+
+// The buffer managers only see chunk keys and can't reach the catalog, so
+// the catalog mirrors every non-default policy into this process wide
+// registry keyed by (db id, table id).
+void setTableCachePolicy(const int db_id,
+                         const int table_id,
+                         const TableCachePolicy policy);
+void clearTableCachePolicy(const int db_id, const int table_id);
+TableCachePolicy getTableCachePolicy(const ChunkKey& key);
+
+}  // namespace Data_Namespace
+
+#endif  // TABLECACHEPOLICY_H
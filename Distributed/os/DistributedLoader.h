@@ -17,24 +17,101 @@
 #ifndef DISTRIBUTEDLOADER_H
 #define DISTRIBUTEDLOADER_H
 
+#include "Fragmenter/InsertDataLoader.h"
 #include "Import/Importer.h"
 #include "LeafAggregator.h"
 
+#include <mutex>
+
+// Loader used by the import paths when running as an aggregator. Parsed
+// batches are hash-partitioned by the table's shard key here on the importing
+// node, through the same InsertDataLoader machinery INSERT uses, and each
+// partition is streamed directly to its owning leaf. The aggregator itself
+// only participates in control-plane operations (checkpoints and epoch
+// management); no row data is re-routed through it.
 class DistributedLoader : public Importer_NS::Loader {
  public:
   DistributedLoader(const Catalog_Namespace::SessionInfo& parent_session_info,
                     const TableDescriptor* t,
                     LeafAggregator* aggregator)
-      : Loader(parent_session_info.getCatalog(), t) {
-    CHECK(false);
+      : Loader(parent_session_info.getCatalog(), t)
+      , parent_session_info_(parent_session_info)
+      , connector_(aggregator)
+      , insert_data_loader_(connector_) {
+    CHECK(aggregator);
   }
 
   bool load(
       const std::vector<std::unique_ptr<Importer_NS::TypedImportBuffer>>& import_buffers,
       const size_t row_count) override {
-    CHECK(false);
-    return false;
+    Fragmenter_Namespace::InsertData ins_data(insert_data_);
+    ins_data.numRows = row_count;
+    ins_data.data = get_data_block_pointers(import_buffers);
+    for (const auto& import_buffer : import_buffers) {
+      ins_data.bypass.push_back(0 == import_buffer->get_replicate_count());
+    }
+    try {
+      // import worker threads load concurrently, but the loader's leaf
+      // round-robin for unsharded tables is stateful; partitioning and the
+      // per-shard sends inside insertData are already parallel
+      std::lock_guard<std::mutex> lock(insert_mutex_);
+      insert_data_loader_.insertData(parent_session_info_, ins_data);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Exception streaming import batch to leaves: " << e.what();
+      return false;
+    }
+    return true;
+  }
+
+  void checkpoint() override {
+    if (getTableDesc()->persistenceLevel ==
+        Data_Namespace::MemoryLevel::DISK_LEVEL) {  // only checkpoint disk-resident
+                                                    // tables
+      connector_.aggregator()->checkpointLeaves(parent_session_info_,
+                                                getCatalog().getCurrentDB().dbId,
+                                                getTableDesc()->tableId);
+    }
+  }
+
+  int32_t getTableEpoch() override {
+    return connector_.aggregator()->get_table_epochLeaf(
+        parent_session_info_, getCatalog().getCurrentDB().dbId, getTableDesc()->tableId);
+  }
+
+  void setTableEpoch(const int32_t new_epoch) override {
+    connector_.aggregator()->set_table_epochLeaf(parent_session_info_,
+                                                 getCatalog().getCurrentDB().dbId,
+                                                 getTableDesc()->tableId,
+                                                 new_epoch);
   }
+
+ private:
+  // Adapts the aggregator's leaf transport to the connector interface
+  // InsertDataLoader partitions through.
+  class AggregatorConnector : public Fragmenter_Namespace::InsertDataLoader::
+                                  DistributedConnector {
+   public:
+    explicit AggregatorConnector(LeafAggregator* aggregator)
+        : aggregator_(aggregator) {}
+
+    size_t leafCount() override { return aggregator_->leafCount(); }
+
+    void insertDataToLeaf(const Catalog_Namespace::SessionInfo& parent_session_info,
+                          const size_t leaf_idx,
+                          Fragmenter_Namespace::InsertData& insert_data) override {
+      aggregator_->insertDataToLeaf(parent_session_info, leaf_idx, insert_data);
+    }
+
+    LeafAggregator* aggregator() const { return aggregator_; }
+
+   private:
+    LeafAggregator* aggregator_;
+  };
+
+  const Catalog_Namespace::SessionInfo& parent_session_info_;
+  AggregatorConnector connector_;
+  Fragmenter_Namespace::InsertDataLoader insert_data_loader_;
+  std::mutex insert_mutex_;
 };
 
 #endif  // DISTRIBUTEDLOADER_H
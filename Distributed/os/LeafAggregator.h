@@ -30,8 +30,16 @@ namespace Catalog_Namespace {
 class SessionInfo;
 }  // namespace Catalog_Namespace
 
+namespace Fragmenter_Namespace {
+struct InsertData;
+}  // namespace Fragmenter_Namespace
+
 class ResultSet;
 
+// Open-source stub of the aggregator side of the distributed layer; every
+// entry point asserts since this build has no leaves. Scale-out concerns such
+// as shard placement, replica groups and read load balancing across replicas
+// belong to the real implementation backing this interface, not here.
 class LeafAggregator {
  public:
   LeafAggregator(const std::vector<LeafHostInfo>& leaves) { CHECK(leaves.empty()); }
@@ -69,12 +77,28 @@ class LeafAggregator {
     CHECK(false);
   }
 
+  void insertDataToLeaf(const Catalog_Namespace::SessionInfo& parent_session_info,
+                        const size_t leaf_idx,
+                        Fragmenter_Namespace::InsertData& insert_data) {
+    CHECK(false);
+  }
+
   void checkpointLeaf(const Catalog_Namespace::SessionInfo& parent_session_info,
                       const int32_t db_id,
                       const int32_t table_id) {
     CHECK(false);
   }
 
+  // Two-phase coordinated checkpoint: every leaf flushes the table
+  // concurrently and the distributed epoch is committed only after all of
+  // them acknowledge, so cluster checkpoint time tracks the slowest leaf
+  // rather than the sum over leaves.
+  void checkpointLeaves(const Catalog_Namespace::SessionInfo& parent_session_info,
+                        const int32_t db_id,
+                        const int32_t table_id) {
+    CHECK(false);
+  }
+
   int32_t get_table_epochLeaf(const Catalog_Namespace::SessionInfo& parent_session_info,
                               const int32_t db_id,
                               const int32_t table_id) {
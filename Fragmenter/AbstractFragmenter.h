@@ -117,6 +117,13 @@ class AbstractFragmenter {
    */
   virtual void dropFragmentsToSize(const size_t maxRows) = 0;
 
+  /**
+   * @brief Drops whole fragments whose retention column chunk metadata
+   * shows every row is older than min_epoch_seconds; no rows are rewritten
+   */
+  virtual size_t dropExpiredFragments(const int retention_column_id,
+                                      const int64_t min_epoch_seconds) = 0;
+
   /**
    * @brief Update chunk stats
    */
@@ -124,6 +131,12 @@ class AbstractFragmenter {
       const ColumnDescriptor* cd,
       std::unordered_map</*fragment_id*/ int, ChunkStats>& stats_map) = 0;
 
+  /**
+   * @brief Clears the metadata dirty marks set by updates and deletes, after
+   * chunk metadata has been recomputed for the marked fragments
+   */
+  virtual void clearMetadataDirtyFlags() = 0;
+
   /**
    * @brief Gets the id of the partitioner
    */
@@ -182,6 +195,12 @@ class AbstractFragmenter {
                               const MetaDataKey& key,
                               UpdelRoll& updel_roll) = 0;
 
+  // Applies the new metadata of every dirty fragment owned by this fragmenter
+  // in one pass, so a committing DML statement doesn't pay a lock round trip
+  // per fragment.
+  virtual void updateMetadata(const Catalog_Namespace::Catalog* catalog,
+                              UpdelRoll& updel_roll) = 0;
+
   virtual void compactRows(const Catalog_Namespace::Catalog* catalog,
                            const TableDescriptor* td,
                            const int fragmentId,
@@ -87,7 +87,8 @@ class FragmentInfo {
       , resultSet(nullptr)
       , numTuples(0)
       , synthesizedNumTuplesIsValid(false)
-      , synthesizedMetadataIsValid(false) {}
+      , synthesizedMetadataIsValid(false)
+      , metadataDirty(false) {}
 
   void setChunkMetadataMap(const std::map<int, ChunkMetadata>& chunkMetadataMap) {
     this->chunkMetadataMap = chunkMetadataMap;
@@ -114,6 +115,12 @@ class FragmentInfo {
   void invalidateChunkMetadataMap() const { synthesizedMetadataIsValid = false; };
   void invalidateNumTuples() const { synthesizedNumTuplesIsValid = false; }
 
+  // Set when an update or delete touches the fragment, cleared once its chunk
+  // metadata has been recomputed. Lets the metadata recomputation skip
+  // fragments which haven't changed since the last run.
+  bool isMetadataDirty() const { return metadataDirty; }
+  void setMetadataDirty(const bool dirty) { metadataDirty = dirty; }
+
   // for unit tests
   static void setUnconditionalVacuum(const double unconditionalVacuum) {
     unconditionalVacuum_ = unconditionalVacuum;
@@ -134,6 +141,7 @@ class FragmentInfo {
   mutable std::map<int, ChunkMetadata> chunkMetadataMap;
   mutable bool synthesizedNumTuplesIsValid;
   mutable bool synthesizedMetadataIsValid;
+  bool metadataDirty;
 
   friend class InsertOrderFragmenter;
   mutable std::shared_ptr<std::mutex> updateMutex_{new std::mutex};
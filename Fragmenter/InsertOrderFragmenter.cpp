@@ -20,6 +20,7 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <set>
 #include <thread>
 #include <type_traits>
 #include "../DataMgr/AbstractBuffer.h"
@@ -27,6 +28,7 @@
 #include "../LockMgr/LockMgr.h"
 #include "../Shared/checked_alloc.h"
 #include "../Shared/thread_count.h"
+#include "InsertWal.h"
 #include "Shared/Logger.h"
 
 #include <LockMgr/TableLockMgr.h>
@@ -40,6 +42,27 @@ using Data_Namespace::DataMgr;
 
 using namespace std;
 
+// When enabled, small streaming inserts skip the per-insert checkpoint and are
+// made durable in batches, once enough rows or time have accumulated. Inserted
+// rows are scannable immediately either way; only durability is deferred, so a
+// crash can lose the rows since the last checkpoint.
+bool g_enable_batched_insert_checkpoints{false};
+size_t g_batched_insert_checkpoint_rows{500000};
+size_t g_batched_insert_checkpoint_interval_ms{1000};
+
+// When non-zero, tables which keep the default fragment_size get their
+// fragment row count derived from this byte budget and the table's physical
+// row width instead of the fixed default row count. Zero disables it.
+size_t g_fragment_size_target_bytes{0};
+
+// Number of independently appendable insert tails (lanes) per table. With the
+// default of 1 all inserts into a table serialize on one tail as before; with
+// more lanes, concurrent insertData calls are routed round-robin to separate
+// lanes, each appending to its own fragments, so parallel loaders scale until
+// the disk saturates. Lanes trade that throughput for up to lanes-1 partially
+// filled fragments at any point in time.
+size_t g_insert_lanes{1};
+
 namespace Fragmenter_Namespace {
 
 InsertOrderFragmenter::InsertOrderFragmenter(
@@ -81,9 +104,39 @@ InsertOrderFragmenter::InsertOrderFragmenter(
     }
   }
   getChunkMetadata();
+  createInsertLanes();
 }
 
-InsertOrderFragmenter::~InsertOrderFragmenter() {}
+void InsertOrderFragmenter::createInsertLanes() {
+  if (g_insert_lanes <= 1) {
+    return;
+  }
+  for (size_t lane_idx = 0; lane_idx < g_insert_lanes; ++lane_idx) {
+    auto lane = std::make_unique<InsertLane>();
+    for (const auto& col : columnMap_) {
+      lane->columnMap.emplace(col.first, Chunk(col.second.get_column_desc()));
+    }
+    for (const auto& var_len_col : varLenColInfo_) {
+      lane->varLenColInfo.insert(std::make_pair(var_len_col.first, size_t(0)));
+    }
+    // each lane starts with no current fragment and creates a fresh one on
+    // its first insert; the tail pinned by getChunkMetadata stays with the
+    // legacy single-lane buffers, which multi-lane inserts never touch
+    insertLanes_.push_back(std::move(lane));
+  }
+}
+
+InsertOrderFragmenter::~InsertOrderFragmenter() {
+  if (unCheckpointedRows_ > 0 &&
+      defaultInsertLevel_ == Data_Namespace::MemoryLevel::DISK_LEVEL) {
+    try {
+      dataMgr_->checkpoint(chunkKeyPrefix_[0], chunkKeyPrefix_[1]);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to flush batched checkpoint for table " << physicalTableId_
+                 << ": " << e.what();
+    }
+  }
+}
 
 void InsertOrderFragmenter::getChunkMetadata() {
   if (defaultInsertLevel_ == Data_Namespace::MemoryLevel::DISK_LEVEL) {
@@ -137,6 +190,7 @@ void InsertOrderFragmenter::getChunkMetadata() {
   }
 
   ssize_t maxFixedColSize = 0;
+  ssize_t rowSizeBytes = 0;
 
   for (auto colIt = columnMap_.begin(); colIt != columnMap_.end(); ++colIt) {
     ssize_t size = colIt->second.get_column_desc()->columnType.get_size();
@@ -146,6 +200,26 @@ void InsertOrderFragmenter::getChunkMetadata() {
                  // number here
     }
     maxFixedColSize = std::max(maxFixedColSize, size);
+    rowSizeBytes += size;
+  }
+
+  if (g_fragment_size_target_bytes > 0 &&
+      maxFragmentRows_ == static_cast<size_t>(DEFAULT_FRAGMENT_ROWS)) {
+    // Size fragments by a byte budget rather than a fixed row count: a very
+    // wide table would otherwise produce fragments too big for a single GPU
+    // while a narrow one pays dispatch overhead per needlessly small
+    // fragment. An explicit per-table fragment_size still wins - only the
+    // default is rescaled.
+    CHECK_GT(rowSizeBytes, 0);
+    maxFragmentRows_ = std::max<size_t>(
+        g_fragment_size_target_bytes / static_cast<size_t>(rowSizeBytes), 1);
+    maxFragmentRows_ = std::min(maxFragmentRows_, maxRows_);
+    if (!fragmentInfoVec_.empty()) {
+      // never shrink below what the last existing fragment already holds, or
+      // insertData would find an over-full insert fragment
+      maxFragmentRows_ = std::max<size_t>(
+          maxFragmentRows_, fragmentInfoVec_.back().getPhysicalNumTuples());
+    }
   }
 
   // this is maximum number of rows assuming everything is fixed length
@@ -167,6 +241,7 @@ void InsertOrderFragmenter::getChunkMetadata() {
         varLenColInfoIt->second = colIt->second.get_buffer()->size();
       }
     }
+    currentInsertFragment_ = &(fragmentInfoVec_.back());
   }
 }
 
@@ -183,20 +258,93 @@ void InsertOrderFragmenter::dropFragmentsToSize(const size_t maxRows) {
     size_t preNumTuples = numTuples_;
     vector<int> dropFragIds;
     size_t targetRows = maxRows * DROP_FRAGMENT_FACTOR;
+    // never drop a fragment an insert lane is still appending to - its chunk
+    // buffers are pinned as that lane's insert buffers
+    std::set<int> laneTailIds;
+    if (currentInsertFragment_) {
+      laneTailIds.insert(currentInsertFragment_->fragmentId);
+    }
+    for (const auto& lane : insertLanes_) {
+      if (lane->currentFragment) {
+        laneTailIds.insert(lane->currentFragment->fragmentId);
+      }
+    }
     while (numTuples_ > targetRows) {
       assert(fragmentInfoVec_.size() > 0);
+      if (laneTailIds.count(fragmentInfoVec_[0].fragmentId)) {
+        break;
+      }
       size_t numFragTuples = fragmentInfoVec_[0].getPhysicalNumTuples();
       dropFragIds.push_back(fragmentInfoVec_[0].fragmentId);
       fragmentInfoVec_.pop_front();
       assert(numTuples_ >= numFragTuples);
       numTuples_ -= numFragTuples;
     }
+    if (dropFragIds.empty()) {
+      return;
+    }
     deleteFragments(dropFragIds);
     LOG(INFO) << "dropFragmentsToSize, numTuples pre: " << preNumTuples
               << " post: " << numTuples_ << " maxRows: " << maxRows;
   }
 }
 
+size_t InsertOrderFragmenter::dropExpiredFragments(const int retention_column_id,
+                                                   const int64_t min_epoch_seconds) {
+  mapd_unique_lock<mapd_shared_mutex> insertLock(insertMutex_);
+
+  // never drop the only fragment - it is the insert buffer
+  if (fragmentInfoVec_.empty() ||
+      numTuples_ == fragmentInfoVec_.back().getPhysicalNumTuples()) {
+    return 0;
+  }
+
+  std::set<int> laneTailIds;
+  if (currentInsertFragment_) {
+    laneTailIds.insert(currentInsertFragment_->fragmentId);
+  }
+  for (const auto& lane : insertLanes_) {
+    if (lane->currentFragment) {
+      laneTailIds.insert(lane->currentFragment->fragmentId);
+    }
+  }
+
+  // fragments are in insert order, which for append workloads is time order;
+  // stop at the first fragment with a live row so out-of-order arrivals are
+  // kept conservatively rather than aged out of the middle of the table
+  vector<int> dropFragIds;
+  size_t droppedTuples = 0;
+  while (fragmentInfoVec_.size() > 1) {
+    auto& fragment = fragmentInfoVec_.front();
+    if (laneTailIds.count(fragment.fragmentId)) {
+      break;
+    }
+    const auto& metadataMap = fragment.getChunkMetadataMapPhysical();
+    const auto chunkMetaIt = metadataMap.find(retention_column_id);
+    if (chunkMetaIt == metadataMap.end()) {
+      break;
+    }
+    // timestamp and date chunk stats are kept in epoch seconds
+    if (chunkMetaIt->second.chunkStats.max.bigintval >= min_epoch_seconds) {
+      break;
+    }
+    const size_t numFragTuples = fragment.getPhysicalNumTuples();
+    dropFragIds.push_back(fragment.fragmentId);
+    fragmentInfoVec_.pop_front();
+    CHECK_GE(numTuples_, numFragTuples);
+    numTuples_ -= numFragTuples;
+    droppedTuples += numFragTuples;
+  }
+  if (dropFragIds.empty()) {
+    return 0;
+  }
+  deleteFragments(dropFragIds);
+  LOG(INFO) << "dropExpiredFragments dropped " << dropFragIds.size()
+            << " fragments (" << droppedTuples << " rows) of table "
+            << physicalTableId_;
+  return droppedTuples;
+}
+
 void InsertOrderFragmenter::deleteFragments(const vector<int>& dropFragIds) {
   // Fix a verified loophole on sharded logical table which is locked using logical
   // tableId while it's its physical tables that can come here when fragments overflow
@@ -212,6 +360,12 @@ void InsertOrderFragmenter::deleteFragments(const vector<int>& dropFragIds) {
     chunkKeyPrefix[1] = catalog_->getLogicalTableId(chunkKeyPrefix[1]);
   }
 
+  // Dropping fragments shifts the rowids of every surviving row, so any
+  // materialized view watermark over this table goes stale.
+  if (const auto logical_td = catalog_->getMetadataForTable(chunkKeyPrefix[1])) {
+    catalog_->invalidateMaterializedViewWatermarks(logical_td->tableName);
+  }
+
   // need to keep lock seq as TableLock >> fragmentInfoMutex_ or
   // SELECT and COPY may enter a deadlock
   using namespace Lock_Namespace;
@@ -228,6 +382,7 @@ void InsertOrderFragmenter::deleteFragments(const vector<int>& dropFragIds) {
       dataMgr_->deleteChunksWithPrefix(fragPrefix);
     }
   }
+  invalidateUniqueKeyIndex();
 }
 
 void InsertOrderFragmenter::updateChunkStats(
@@ -306,27 +461,91 @@ void InsertOrderFragmenter::updateChunkStats(
           fragment.getChunkMetadataMap();  // TODO(adb): needed?
       buf->setDirty();
     } else {
-      LOG(WARNING) << "No chunk stats update found for fragment " << fragment.fragmentId
-                   << ", table " << physicalTableId_ << ", "
-                   << ", column " << column_id;
+      // Fragments skipped by an incremental metadata recompute have no new
+      // stats, so this is not necessarily a problem.
+      VLOG(2) << "No chunk stats update found for fragment " << fragment.fragmentId
+              << ", table " << physicalTableId_ << ", "
+              << ", column " << column_id;
+    }
+  }
+}
+
+void InsertOrderFragmenter::clearMetadataDirtyFlags() {
+  mapd_unique_lock<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
+  for (auto& fragment : fragmentInfoVec_) {
+    fragment.setMetadataDirty(false);
+  }
+}
+
+void InsertOrderFragmenter::checkpointAfterInsert(const InsertData& insertDataStruct) {
+  if (defaultInsertLevel_ ==
+      Data_Namespace::DISK_LEVEL) {  // only checkpoint if data is resident on disk
+    bool do_checkpoint = true;
+    if (g_enable_batched_insert_checkpoints) {
+      unCheckpointedRows_ += insertDataStruct.numRows;
+      const auto now = std::chrono::steady_clock::now();
+      do_checkpoint =
+          unCheckpointedRows_ >= g_batched_insert_checkpoint_rows ||
+          now - lastCheckpointTime_ >=
+              std::chrono::milliseconds(g_batched_insert_checkpoint_interval_ms);
+      if (!do_checkpoint && g_enable_insert_wal) {
+        // the deferred rows must still survive a crash; if the batch cannot
+        // be logged (array columns, log unavailable) checkpoint it now instead
+        const auto table_epoch = catalog_->getTableEpoch(insertDataStruct.databaseId,
+                                                         insertDataStruct.tableId);
+        do_checkpoint = !InsertWal::getInstance().append(
+            insertDataStruct, table_epoch, *catalog_);
+      }
+    }
+    if (do_checkpoint) {
+      dataMgr_->checkpoint(chunkKeyPrefix_[0],
+                           chunkKeyPrefix_[1]);  // need to checkpoint here to remove
+                                                 // window for corruption
+      unCheckpointedRows_ = 0;
+      lastCheckpointTime_ = std::chrono::steady_clock::now();
+      if (g_enable_insert_wal) {
+        InsertWal::getInstance().notifyCheckpointed(chunkKeyPrefix_[0],
+                                                    chunkKeyPrefix_[1]);
+      }
     }
   }
 }
 
 void InsertOrderFragmenter::insertData(InsertData& insertDataStruct) {
+  if (insertDataStruct.replicate_count == 0) {
+    const auto td = catalog_->getMetadataForTable(physicalTableId_);
+    if (td && td->uniqueKeyColumnId > 0) {
+      upsertData(insertDataStruct, td);
+      return;
+    }
+  }
   // TODO: this local lock will need to be centralized when ALTER COLUMN is added, bc
   try {
-    mapd_unique_lock<mapd_shared_mutex> insertLock(
-        insertMutex_);  // prevent two threads from trying to insert into the same table
-                        // simultaneously
-
-    insertDataImpl(insertDataStruct);
-
-    if (defaultInsertLevel_ ==
-        Data_Namespace::DISK_LEVEL) {  // only checkpoint if data is resident on disk
-      dataMgr_->checkpoint(
-          chunkKeyPrefix_[0],
-          chunkKeyPrefix_[1]);  // need to checkpoint here to remove window for corruption
+    if (insertLanes_.empty() || insertDataStruct.replicate_count > 0) {
+      mapd_unique_lock<mapd_shared_mutex> insertLock(
+          insertMutex_);  // prevent two threads from trying to insert into the same table
+                          // simultaneously
+
+      insertDataImpl(insertDataStruct, columnMap_, varLenColInfo_, currentInsertFragment_);
+      dropFragmentsToSize(maxRows_);
+      checkpointAfterInsert(insertDataStruct);
+    } else {
+      // lane mode: appends to different lanes only share the insert mutex in
+      // read mode, so they run concurrently; rolloff and checkpointing still
+      // need the whole table quiesced and upgrade to the write mode. A failed
+      // lane rolls the epoch back below, which also discards whatever the
+      // other lanes appended since the last checkpoint - the same window
+      // batched checkpoints already expose.
+      {
+        mapd_shared_lock<mapd_shared_mutex> insertLock(insertMutex_);
+        auto& lane = *insertLanes_[nextInsertLane_++ % insertLanes_.size()];
+        mapd_unique_lock<mapd_shared_mutex> laneLock(lane.laneMutex);
+        insertDataImpl(
+            insertDataStruct, lane.columnMap, lane.varLenColInfo, lane.currentFragment);
+      }
+      mapd_unique_lock<mapd_shared_mutex> insertLock(insertMutex_);
+      dropFragmentsToSize(maxRows_);
+      checkpointAfterInsert(insertDataStruct);
     }
   } catch (...) {
     int32_t tableEpoch =
@@ -343,10 +562,23 @@ void InsertOrderFragmenter::insertData(InsertData& insertDataStruct) {
 
 void InsertOrderFragmenter::insertDataNoCheckpoint(InsertData& insertDataStruct) {
   // TODO: this local lock will need to be centralized when ALTER COLUMN is added, bc
-  mapd_unique_lock<mapd_shared_mutex> insertLock(
-      insertMutex_);  // prevent two threads from trying to insert into the same table
-                      // simultaneously
-  insertDataImpl(insertDataStruct);
+  if (insertLanes_.empty() || insertDataStruct.replicate_count > 0) {
+    mapd_unique_lock<mapd_shared_mutex> insertLock(
+        insertMutex_);  // prevent two threads from trying to insert into the same table
+                        // simultaneously
+    insertDataImpl(insertDataStruct, columnMap_, varLenColInfo_, currentInsertFragment_);
+    dropFragmentsToSize(maxRows_);
+  } else {
+    {
+      mapd_shared_lock<mapd_shared_mutex> insertLock(insertMutex_);
+      auto& lane = *insertLanes_[nextInsertLane_++ % insertLanes_.size()];
+      mapd_unique_lock<mapd_shared_mutex> laneLock(lane.laneMutex);
+      insertDataImpl(
+          insertDataStruct, lane.columnMap, lane.varLenColInfo, lane.currentFragment);
+    }
+    mapd_unique_lock<mapd_shared_mutex> insertLock(insertMutex_);
+    dropFragmentsToSize(maxRows_);
+  }
 }
 
 void InsertOrderFragmenter::replicateData(const InsertData& insertDataStruct) {
@@ -427,10 +659,14 @@ void InsertOrderFragmenter::replicateData(const InsertData& insertDataStruct) {
   }
 }
 
-void InsertOrderFragmenter::insertDataImpl(InsertData& insertDataStruct) {
+void InsertOrderFragmenter::insertDataImpl(
+    InsertData& insertDataStruct,
+    std::map<int, Chunk_NS::Chunk>& columnMap,
+    std::unordered_map<int, size_t>& varLenColInfo,
+    FragmentInfo*& currentFragmentOfLane) {
   // populate deleted system column of it exists, as it will not come from client
   std::unique_ptr<int8_t[]> data_for_deleted_column;
-  for (const auto& cit : columnMap_) {
+  for (const auto& cit : columnMap) {
     if (cit.second.get_column_desc()->isDeletedCol) {
       data_for_deleted_column.reset(new int8_t[insertDataStruct.numRows]);
       memset(data_for_deleted_column.get(), 0, insertDataStruct.numRows);
@@ -443,10 +679,10 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insertDataStruct) {
   // MAT we need to add a removal of the empty column we pushed onto here
   // for upstream safety.  Should not be a problem but need to fix.
 
-  // insert column to columnMap_ if not yet (ALTER ADD COLUMN)
+  // insert column to columnMap if not yet (ALTER ADD COLUMN)
   for (const auto columnId : insertDataStruct.columnIds) {
-    if (columnMap_.end() == columnMap_.find(columnId)) {
-      columnMap_.emplace(
+    if (columnMap.end() == columnMap.find(columnId)) {
+      columnMap.emplace(
           columnId, Chunk_NS::Chunk(insertDataStruct.columnDescriptors.at(columnId)));
     }
   }
@@ -472,14 +708,14 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insertDataStruct) {
     return;
   }
 
-  FragmentInfo* currentFragment = 0;
-
-  if (fragmentInfoVec_.empty()) {  // if no fragments exist for table
-    currentFragment = createNewFragment(defaultInsertLevel_);
-  } else {
-    currentFragment = &(fragmentInfoVec_.back());
+  if (currentFragmentOfLane == nullptr) {  // no insert tail yet for this lane
+    currentFragmentOfLane = createNewFragment(columnMap, defaultInsertLevel_);
   }
-  size_t startFragment = fragmentInfoVec_.size() - 1;
+  FragmentInfo* currentFragment = currentFragmentOfLane;
+  // the fragments this call actually appends to; with several insert lanes
+  // active the fragments of one lane are not contiguous in fragmentInfoVec_,
+  // so they are tracked explicitly for the shadow metadata commit below
+  std::vector<FragmentInfo*> touchedFragments;
 
   while (numRowsLeft > 0) {  // may have to create multiple fragments for bulk insert
     // loop until done inserting all rows
@@ -488,12 +724,12 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insertDataStruct) {
         maxFragmentRows_ - currentFragment->shadowNumTuples;
     size_t numRowsToInsert = min(rowsLeftInCurrentFragment, numRowsLeft);
     if (rowsLeftInCurrentFragment != 0) {
-      for (auto& varLenColInfoIt : varLenColInfo_) {
+      for (auto& varLenColInfoIt : varLenColInfo) {
         CHECK_LE(varLenColInfoIt.second, maxChunkSize_);
         size_t bytesLeft = maxChunkSize_ - varLenColInfoIt.second;
         auto insertIdIt = inverseInsertDataColIdMap.find(varLenColInfoIt.first);
         if (insertIdIt != inverseInsertDataColIdMap.end()) {
-          auto colMapIt = columnMap_.find(varLenColInfoIt.first);
+          auto colMapIt = columnMap.find(varLenColInfoIt.first);
           numRowsToInsert = std::min(
               numRowsToInsert,
               colMapIt->second.getNumElemsForBytesInsertData(dataCopy[insertIdIt->second],
@@ -505,21 +741,19 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insertDataStruct) {
     }
 
     if (rowsLeftInCurrentFragment == 0 || numRowsToInsert == 0) {
-      currentFragment = createNewFragment(defaultInsertLevel_);
-      if (numRowsInserted == 0) {
-        startFragment++;
-      }
+      currentFragment = createNewFragment(columnMap, defaultInsertLevel_);
+      currentFragmentOfLane = currentFragment;
       rowsLeftInCurrentFragment = maxFragmentRows_;
-      for (auto& varLenColInfoIt : varLenColInfo_) {
+      for (auto& varLenColInfoIt : varLenColInfo) {
         varLenColInfoIt.second = 0;  // reset byte counter
       }
       numRowsToInsert = min(rowsLeftInCurrentFragment, numRowsLeft);
-      for (auto& varLenColInfoIt : varLenColInfo_) {
+      for (auto& varLenColInfoIt : varLenColInfo) {
         CHECK_LE(varLenColInfoIt.second, maxChunkSize_);
         size_t bytesLeft = maxChunkSize_ - varLenColInfoIt.second;
         auto insertIdIt = inverseInsertDataColIdMap.find(varLenColInfoIt.first);
         if (insertIdIt != inverseInsertDataColIdMap.end()) {
-          auto colMapIt = columnMap_.find(varLenColInfoIt.first);
+          auto colMapIt = columnMap.find(varLenColInfoIt.first);
           numRowsToInsert = std::min(
               numRowsToInsert,
               colMapIt->second.getNumElemsForBytesInsertData(dataCopy[insertIdIt->second],
@@ -533,15 +767,19 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insertDataStruct) {
     CHECK_GT(numRowsToInsert, size_t(0));  // would put us into an endless loop as we'd
                                            // never be able to insert anything
 
+    if (touchedFragments.empty() || touchedFragments.back() != currentFragment) {
+      touchedFragments.push_back(currentFragment);
+    }
+
     // for each column, append the data in the appropriate insert buffer
     for (size_t i = 0; i < insertDataStruct.columnIds.size(); ++i) {
       int columnId = insertDataStruct.columnIds[i];
-      auto colMapIt = columnMap_.find(columnId);
-      assert(colMapIt != columnMap_.end());
+      auto colMapIt = columnMap.find(columnId);
+      assert(colMapIt != columnMap.end());
       currentFragment->shadowChunkMetadataMap[columnId] =
           colMapIt->second.appendData(dataCopy[i], numRowsToInsert, numRowsInserted);
-      auto varLenColInfoIt = varLenColInfo_.find(columnId);
-      if (varLenColInfoIt != varLenColInfo_.end()) {
+      auto varLenColInfoIt = varLenColInfo.find(columnId);
+      if (varLenColInfoIt != varLenColInfo.end()) {
         varLenColInfoIt->second = colMapIt->second.get_buffer()->size();
       }
     }
@@ -554,14 +792,14 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insertDataStruct) {
       }
       DataBlockPtr rowIdBlock;
       rowIdBlock.numbersPtr = reinterpret_cast<int8_t*>(rowIdData);
-      auto colMapIt = columnMap_.find(rowIdColId_);
+      auto colMapIt = columnMap.find(rowIdColId_);
       currentFragment->shadowChunkMetadataMap[rowIdColId_] =
           colMapIt->second.appendData(rowIdBlock, numRowsToInsert, numRowsInserted);
       delete[] rowIdData;
     }
 
     currentFragment->shadowNumTuples =
-        fragmentInfoVec_.back().getPhysicalNumTuples() + numRowsToInsert;
+        currentFragment->getPhysicalNumTuples() + numRowsToInsert;
     numRowsLeft -= numRowsToInsert;
     numRowsInserted += numRowsToInsert;
   }
@@ -571,24 +809,27 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insertDataStruct) {
     // has locked fragmentInfoMutex_ while SELECT waits for fragmentInfoMutex_ and
     // COPY_FROM waits for TableWriteLock
     mapd_unique_lock<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
-    for (auto partIt = fragmentInfoVec_.begin() + startFragment;
-         partIt != fragmentInfoVec_.end();
-         ++partIt) {
+    for (auto* partIt : touchedFragments) {
       partIt->setPhysicalNumTuples(partIt->shadowNumTuples);
       partIt->setChunkMetadataMap(partIt->shadowChunkMetadataMap);
     }
+    numTuples_ += insertDataStruct.numRows;
   }
-  numTuples_ += insertDataStruct.numRows;
-  dropFragmentsToSize(maxRows_);
 }
 
 FragmentInfo* InsertOrderFragmenter::createNewFragment(
+    std::map<int, Chunk_NS::Chunk>& columnMap,
     const Data_Namespace::MemoryLevel memoryLevel) {
-  // also sets the new fragment as the insertBuffer for each column
+  // also sets the new fragment as the insertBuffer for each column of the
+  // passed columnMap (the table's, or a lane's)
 
-  maxFragmentId_++;
   FragmentInfo newFragmentInfo;
-  newFragmentInfo.fragmentId = maxFragmentId_;
+  {
+    // reserve the fragment id under the fragment info lock so concurrent lanes
+    // never mint the same id
+    mapd_lock_guard<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
+    newFragmentInfo.fragmentId = ++maxFragmentId_;
+  }
   newFragmentInfo.shadowNumTuples = 0;
   newFragmentInfo.setPhysicalNumTuples(0);
   for (const auto levelSize : dataMgr_->levelSizes_) {
@@ -597,13 +838,13 @@ FragmentInfo* InsertOrderFragmenter::createNewFragment(
   newFragmentInfo.physicalTableId = physicalTableId_;
   newFragmentInfo.shard = shard_;
 
-  for (map<int, Chunk>::iterator colMapIt = columnMap_.begin();
-       colMapIt != columnMap_.end();
+  for (map<int, Chunk>::iterator colMapIt = columnMap.begin();
+       colMapIt != columnMap.end();
        ++colMapIt) {
     // colMapIt->second.unpin_buffer();
     ChunkKey chunkKey = chunkKeyPrefix_;
     chunkKey.push_back(colMapIt->second.get_column_desc()->columnId);
-    chunkKey.push_back(maxFragmentId_);
+    chunkKey.push_back(newFragmentInfo.fragmentId);
     colMapIt->second.createChunkBuffer(
         dataMgr_,
         chunkKey,
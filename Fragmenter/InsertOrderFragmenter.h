@@ -28,7 +28,10 @@
 #include "../Shared/types.h"
 #include "AbstractFragmenter.h"
 
+#include <atomic>
+#include <chrono>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -91,10 +94,15 @@ class InsertOrderFragmenter : public AbstractFragmenter {
 
   void dropFragmentsToSize(const size_t maxRows) override;
 
+  size_t dropExpiredFragments(const int retention_column_id,
+                              const int64_t min_epoch_seconds) override;
+
   void updateChunkStats(
       const ColumnDescriptor* cd,
       std::unordered_map</*fragment_id*/ int, ChunkStats>& stats_map) override;
 
+  void clearMetadataDirtyFlags() override;
+
   /**
    * @brief get fragmenter's id
    */
@@ -161,6 +169,9 @@ class InsertOrderFragmenter : public AbstractFragmenter {
                       const MetaDataKey& key,
                       UpdelRoll& updel_roll) override;
 
+  void updateMetadata(const Catalog_Namespace::Catalog* catalog,
+                      UpdelRoll& updel_roll) override;
+
   void compactRows(const Catalog_Namespace::Catalog* catalog,
                    const TableDescriptor* td,
                    const int fragment_id,
@@ -181,7 +192,24 @@ class InsertOrderFragmenter : public AbstractFragmenter {
       columnMap_; /**< stores a map of column id to metadata about that column */
   std::deque<FragmentInfo>
       fragmentInfoVec_; /**< data about each fragment stored - id and number of rows */
-  // int currentInsertBufferFragmentId_;
+  FragmentInfo* currentInsertFragment_{
+      nullptr}; /**< the fragment the legacy (single-lane) insert buffers append to */
+
+  /**
+   * @struct InsertLane
+   * @brief An independently appendable insert tail: its own per-column insert
+   * chunks (and so its own encoders), var-len byte counters and current
+   * fragment, so concurrent insertData calls routed to different lanes append
+   * without serializing on one tail. Only created when g_insert_lanes > 1.
+   */
+  struct InsertLane {
+    std::map<int, Chunk_NS::Chunk> columnMap;
+    std::unordered_map<int, size_t> varLenColInfo;
+    FragmentInfo* currentFragment{nullptr};
+    mapd_shared_mutex laneMutex;
+  };
+  std::vector<std::unique_ptr<InsertLane>> insertLanes_;
+  std::atomic<size_t> nextInsertLane_{0};
   Data_Namespace::DataMgr* dataMgr_;
   Catalog_Namespace::Catalog* catalog_;
   const int physicalTableId_;
@@ -204,6 +232,22 @@ class InsertOrderFragmenter : public AbstractFragmenter {
   int rowIdColId_;
   std::unordered_map<int, size_t> varLenColInfo_;
   std::shared_ptr<std::mutex> mutex_access_inmem_states;
+  // upsert support (tables declared WITH (UNIQUE_KEY='col')): key value ->
+  // (fragment id, offset in fragment) for every live row, built lazily from
+  // the key column's chunks and advanced incrementally as rows are appended.
+  // uniqueKeyIndexedRows_ records how many rows of each fragment are already
+  // indexed so a refresh only scans the tail grown since the last upsert.
+  // Maintained under insertMutex_ held in write mode; the DML entry points
+  // that move, delete or rewrite keyed rows just invalidate it and the next
+  // upsert rebuilds.
+  std::unordered_map<int64_t, std::pair<int, uint64_t>> uniqueKeyIndex_;
+  std::map<int, size_t> uniqueKeyIndexedRows_;
+  bool uniqueKeyIndexValid_{false};
+  // batched insert checkpointing - rows inserted but not yet made durable and
+  // the time of the last checkpoint; both only touched under insertMutex_
+  size_t unCheckpointedRows_{0};
+  std::chrono::steady_clock::time_point lastCheckpointTime_{
+      std::chrono::steady_clock::now()};
 
   /**
    * @brief creates new fragment, calling createChunk()
@@ -214,15 +258,30 @@ class InsertOrderFragmenter : public AbstractFragmenter {
    */
 
   FragmentInfo* createNewFragment(
+      std::map<int, Chunk_NS::Chunk>& columnMap,
       const Data_Namespace::MemoryLevel memory_level = Data_Namespace::DISK_LEVEL);
   void deleteFragments(const std::vector<int>& dropFragIds);
 
   void getChunkMetadata();
 
   void lockInsertCheckpointData(const InsertData& insertDataStruct);
-  void insertDataImpl(InsertData& insertDataStruct);
+  void insertDataImpl(InsertData& insertDataStruct,
+                      std::map<int, Chunk_NS::Chunk>& columnMap,
+                      std::unordered_map<int, size_t>& varLenColInfo,
+                      FragmentInfo*& currentFragment);
+  void createInsertLanes();
+  void checkpointAfterInsert(const InsertData& insertDataStruct);
   void replicateData(const InsertData& insertDataStruct);
 
+  /**
+   * @brief deduplicating insert for tables with a declared unique key: rows
+   * whose key is already present are rewritten in place through the chunk
+   * update path, the rest are appended
+   */
+  void upsertData(InsertData& insertDataStruct, const TableDescriptor* td);
+  void refreshUniqueKeyIndex(const TableDescriptor* td, const ColumnDescriptor* key_cd);
+  void invalidateUniqueKeyIndex();
+
   InsertOrderFragmenter(const InsertOrderFragmenter&);
   InsertOrderFragmenter& operator=(const InsertOrderFragmenter&);
   // FIX-ME:  Temporary lock; needs removing.
@@ -0,0 +1,358 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InsertWal.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <list>
+#include <set>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "../Catalog/Catalog.h"
+#include "AbstractFragmenter.h"
+#include "Fragmenter.h"
+#include "Shared/Logger.h"
+
+// When enabled together with batched insert checkpoints, insert batches whose
+// checkpoint was deferred are made durable in a per-database write-ahead log
+// and replayed when the database is next opened, so the checkpoint interval
+// can be raised to minutes without widening the crash loss window.
+bool g_enable_insert_wal{false};
+
+namespace Fragmenter_Namespace {
+
+namespace {
+
+const uint32_t kWalRecordMagic{0x4957414C};
+
+template <typename T>
+void append_pod(std::vector<int8_t>& buf, const T val) {
+  const auto* src = reinterpret_cast<const int8_t*>(&val);
+  buf.insert(buf.end(), src, src + sizeof(T));
+}
+
+template <typename T>
+bool read_pod(const std::vector<int8_t>& buf, size_t& off, T& out) {
+  if (off + sizeof(T) > buf.size()) {
+    return false;
+  }
+  std::memcpy(&out, buf.data() + off, sizeof(T));
+  off += sizeof(T);
+  return true;
+}
+
+bool write_all(const int fd, const int8_t* data, size_t bytes) {
+  while (bytes > 0) {
+    const auto written = write(fd, data, bytes);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    bytes -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+bool read_file(const int fd, std::vector<int8_t>& contents) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return false;
+  }
+  contents.resize(st.st_size);
+  size_t off = 0;
+  while (off < contents.size()) {
+    const auto nread = pread(fd, contents.data() + off, contents.size() - off, off);
+    if (nread < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (nread == 0) {
+      contents.resize(off);
+      break;
+    }
+    off += static_cast<size_t>(nread);
+  }
+  return true;
+}
+
+}  // namespace
+
+InsertWal& InsertWal::getInstance() {
+  static InsertWal instance;
+  return instance;
+}
+
+std::shared_ptr<InsertWal::WalFile> InsertWal::getFileForDb(const int db_id) {
+  std::lock_guard<std::mutex> files_lock(files_mutex_);
+  const auto it = files_.find(db_id);
+  return it == files_.end() ? nullptr : it->second;
+}
+
+void InsertWal::openAndReplay(Catalog_Namespace::Catalog& catalog) {
+  const auto db_id = catalog.getCurrentDB().dbId;
+  auto wal = std::make_shared<WalFile>();
+  boost::filesystem::path wal_dir(catalog.getBasePath());
+  wal_dir /= "mapd_wal";
+  if (!boost::filesystem::exists(wal_dir)) {
+    boost::filesystem::create_directory(wal_dir);
+  }
+  wal->path = (wal_dir / ("db_" + std::to_string(db_id) + ".wal")).string();
+  wal->fd = open(wal->path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (wal->fd < 0) {
+    LOG(ERROR) << "Failed to open insert WAL " << wal->path << ": "
+               << std::strerror(errno) << "; inserts will checkpoint immediately";
+    return;
+  }
+  replayLog(*wal, catalog);
+  std::lock_guard<std::mutex> files_lock(files_mutex_);
+  files_[db_id] = wal;
+}
+
+void InsertWal::replayLog(WalFile& wal, Catalog_Namespace::Catalog& catalog) {
+  const auto db_id = catalog.getCurrentDB().dbId;
+  std::vector<int8_t> log;
+  if (!read_file(wal.fd, log)) {
+    LOG(ERROR) << "Failed to read insert WAL " << wal.path << ": "
+               << std::strerror(errno);
+    return;
+  }
+  size_t off = 0;
+  size_t replayed_batches = 0;
+  std::set<int> replayed_tables;
+  std::set<int> failed_tables;
+  while (off < log.size()) {
+    uint32_t magic, payload_bytes;
+    if (!read_pod(log, off, magic) || magic != kWalRecordMagic ||
+        !read_pod(log, off, payload_bytes) || off + payload_bytes > log.size()) {
+      // a torn append from the crash leaves a short or garbled tail; everything
+      // before it was fsynced, so stop here and drop the tail
+      LOG(WARNING) << "Insert WAL " << wal.path
+                   << " ends in an incomplete record, stopping replay";
+      break;
+    }
+    const size_t record_end = off + payload_bytes;
+    int32_t table_id, epoch;
+    uint32_t num_cols;
+    uint64_t num_rows;
+    if (!read_pod(log, off, table_id) || !read_pod(log, off, epoch) ||
+        !read_pod(log, off, num_cols) || !read_pod(log, off, num_rows)) {
+      LOG(WARNING) << "Insert WAL " << wal.path << " has a malformed record header, "
+                   << "stopping replay";
+      break;
+    }
+    // records covered by a later checkpoint carry an older epoch; skip them
+    if (epoch != catalog.getTableEpoch(db_id, table_id) || failed_tables.count(table_id)) {
+      off = record_end;
+      continue;
+    }
+    InsertData insert_data;
+    insert_data.databaseId = db_id;
+    insert_data.tableId = table_id;
+    insert_data.numRows = num_rows;
+    std::list<std::vector<int8_t>> fixed_buffers;
+    std::list<std::vector<std::string>> string_buffers;
+    bool malformed = false;
+    for (uint32_t col = 0; col < num_cols && !malformed; ++col) {
+      int32_t col_id;
+      uint8_t is_varlen_string;
+      uint64_t data_bytes;
+      if (!read_pod(log, off, col_id) || !read_pod(log, off, is_varlen_string) ||
+          !read_pod(log, off, data_bytes) || off + data_bytes > log.size()) {
+        malformed = true;
+        break;
+      }
+      DataBlockPtr block;
+      if (is_varlen_string) {
+        string_buffers.emplace_back();
+        auto& strings = string_buffers.back();
+        strings.reserve(num_rows);
+        const size_t col_end = off + data_bytes;
+        for (uint64_t row = 0; row < num_rows; ++row) {
+          uint32_t len;
+          if (!read_pod(log, off, len) || off + len > col_end) {
+            malformed = true;
+            break;
+          }
+          strings.emplace_back(reinterpret_cast<const char*>(log.data() + off), len);
+          off += len;
+        }
+        block.stringsPtr = &strings;
+      } else {
+        fixed_buffers.emplace_back(log.begin() + off, log.begin() + off + data_bytes);
+        block.numbersPtr = fixed_buffers.back().data();
+        off += data_bytes;
+      }
+      insert_data.columnIds.push_back(col_id);
+      insert_data.data.push_back(block);
+    }
+    if (malformed || off != record_end) {
+      LOG(WARNING) << "Insert WAL " << wal.path << " has a malformed record for table "
+                   << table_id << ", stopping replay";
+      break;
+    }
+    const auto td = catalog.getMetadataForTableImpl(table_id, true);
+    if (!td || !td->fragmenter) {
+      // table was dropped after the batch was logged
+      off = record_end;
+      continue;
+    }
+    try {
+      td->fragmenter->insertDataNoCheckpoint(insert_data);
+      replayed_tables.insert(table_id);
+      ++replayed_batches;
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to replay insert WAL batch for table " << table_id << ": "
+                 << e.what();
+      failed_tables.insert(table_id);
+    }
+    off = record_end;
+  }
+  for (const auto table_id : replayed_tables) {
+    catalog.getDataMgr().checkpoint(db_id, table_id);
+  }
+  if (replayed_batches > 0) {
+    LOG(INFO) << "Replayed " << replayed_batches << " insert batches from " << wal.path;
+  }
+  if (ftruncate(wal.fd, 0) != 0 || fsync(wal.fd) != 0) {
+    LOG(ERROR) << "Failed to truncate insert WAL " << wal.path << ": "
+               << std::strerror(errno);
+  }
+}
+
+bool InsertWal::append(const InsertData& insert_data,
+                       const int32_t table_epoch,
+                       const Catalog_Namespace::Catalog& catalog) {
+  if (insert_data.replicate_count > 0 ||
+      std::count(insert_data.bypass.begin(), insert_data.bypass.end(), true) > 0) {
+    return false;
+  }
+  const auto wal = getFileForDb(insert_data.databaseId);
+  if (!wal) {
+    return false;
+  }
+  std::vector<int8_t> record;
+  append_pod(record, kWalRecordMagic);
+  append_pod(record, uint32_t(0));  // payload size, patched below
+  append_pod(record, int32_t(insert_data.tableId));
+  append_pod(record, table_epoch);
+  append_pod(record, uint32_t(insert_data.columnIds.size()));
+  append_pod(record, uint64_t(insert_data.numRows));
+  for (size_t i = 0; i < insert_data.columnIds.size(); ++i) {
+    const auto cd =
+        catalog.getMetadataForColumn(insert_data.tableId, insert_data.columnIds[i]);
+    if (!cd) {
+      return false;
+    }
+    const auto& ti = cd->columnType;
+    append_pod(record, int32_t(insert_data.columnIds[i]));
+    if (ti.is_varlen()) {
+      if (ti.get_type() == kARRAY) {
+        // array payloads are not serialized; the caller checkpoints instead
+        return false;
+      }
+      append_pod(record, uint8_t(1));
+      const auto& strings = *insert_data.data[i].stringsPtr;
+      uint64_t data_bytes = 0;
+      for (const auto& s : strings) {
+        data_bytes += sizeof(uint32_t) + s.size();
+      }
+      append_pod(record, data_bytes);
+      for (const auto& s : strings) {
+        append_pod(record, uint32_t(s.size()));
+        const auto* chars = reinterpret_cast<const int8_t*>(s.data());
+        record.insert(record.end(), chars, chars + s.size());
+      }
+    } else {
+      append_pod(record, uint8_t(0));
+      const uint64_t data_bytes = insert_data.numRows * ti.get_logical_size();
+      append_pod(record, data_bytes);
+      record.insert(record.end(),
+                    insert_data.data[i].numbersPtr,
+                    insert_data.data[i].numbersPtr + data_bytes);
+    }
+  }
+  const uint32_t payload_bytes = record.size() - 2 * sizeof(uint32_t);
+  std::memcpy(record.data() + sizeof(uint32_t), &payload_bytes, sizeof(uint32_t));
+
+  uint64_t my_lsn;
+  {
+    std::lock_guard<std::mutex> lock(wal->mutex);
+    if (!write_all(wal->fd, record.data(), record.size())) {
+      LOG(ERROR) << "Insert WAL append to " << wal->path
+                 << " failed: " << std::strerror(errno);
+      return false;
+    }
+    my_lsn = ++wal->appended_lsn;
+    ++wal->live_records_per_table[insert_data.tableId];
+  }
+  // group commit: whoever finds no flush in flight syncs everything appended
+  // so far; batches appended while a sync was running share the next one
+  std::unique_lock<std::mutex> lock(wal->mutex);
+  while (wal->flushed_lsn < my_lsn) {
+    if (wal->flush_in_progress) {
+      wal->flush_cv.wait(lock);
+      continue;
+    }
+    wal->flush_in_progress = true;
+    const auto target_lsn = wal->appended_lsn;
+    lock.unlock();
+    const int err = fsync(wal->fd);
+    lock.lock();
+    wal->flush_in_progress = false;
+    if (err == 0 && target_lsn > wal->flushed_lsn) {
+      wal->flushed_lsn = target_lsn;
+    }
+    wal->flush_cv.notify_all();
+    if (err != 0) {
+      LOG(ERROR) << "Insert WAL fsync of " << wal->path
+                 << " failed: " << std::strerror(errno);
+      return false;
+    }
+  }
+  return true;
+}
+
+void InsertWal::notifyCheckpointed(const int db_id, const int table_id) {
+  const auto wal = getFileForDb(db_id);
+  if (!wal) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(wal->mutex);
+  wal->live_records_per_table.erase(table_id);
+  if (wal->live_records_per_table.empty()) {
+    // every logged batch is covered by a checkpoint now; reclaim the file.
+    // Stale records are harmless either way - replay skips them by epoch -
+    // so a failed truncate only costs space.
+    if (ftruncate(wal->fd, 0) != 0) {
+      LOG(WARNING) << "Failed to truncate insert WAL " << wal->path << ": "
+                   << std::strerror(errno);
+    }
+  }
+}
+
+}  // namespace Fragmenter_Namespace
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file	InsertWal.h
+ * @brief	Per-database write-ahead log for insert batches whose checkpoint
+ * was deferred by batched insert checkpointing.
+ */
+#ifndef INSERT_WAL_H
+#define INSERT_WAL_H
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Catalog_Namespace {
+class Catalog;
+}
+
+namespace Fragmenter_Namespace {
+
+struct InsertData;
+
+/**
+ * @type InsertWal
+ * @brief Logs InsertData batches to one append-only file per database so that
+ * batched insert checkpoints can be spaced minutes apart without losing the
+ * rows inserted since the last checkpoint on a crash.
+ *
+ * Each record carries the table epoch that was durable when it was logged;
+ * on startup only records whose epoch matches the table's current epoch are
+ * replayed, so records covered by a later checkpoint are skipped without any
+ * log/checkpoint ordering requirement. Appends are made durable with group
+ * commit: one writer fsyncs on behalf of every batch appended while the
+ * previous fsync was in flight.
+ */
+class InsertWal {
+ public:
+  static InsertWal& getInstance();
+
+  /**
+   * @brief Opens (creating if needed) the log for the catalog's database under
+   * <base_path>/mapd_wal, replays any batches not covered by a checkpoint
+   * through the table fragmenters, checkpoints the replayed tables and
+   * truncates the log. Called once when the database is opened.
+   */
+  void openAndReplay(Catalog_Namespace::Catalog& catalog);
+
+  /**
+   * @brief Durably logs one insert batch. Returns false if the batch cannot
+   * be logged - array columns, or no log open for the database - in which
+   * case the caller must fall back to an immediate checkpoint.
+   */
+  bool append(const InsertData& insert_data,
+              const int32_t table_epoch,
+              const Catalog_Namespace::Catalog& catalog);
+
+  /**
+   * @brief Notes that the table was checkpointed, making its logged records
+   * stale. Once no table has live records the log file is truncated.
+   */
+  void notifyCheckpointed(const int db_id, const int table_id);
+
+ private:
+  InsertWal() {}
+  InsertWal(const InsertWal&) = delete;
+  InsertWal& operator=(const InsertWal&) = delete;
+
+  struct WalFile {
+    int fd{-1};
+    std::string path;
+    // serializes appends and guards the group commit state below; released
+    // around the fsync itself so concurrent appends coalesce into one sync
+    std::mutex mutex;
+    std::condition_variable flush_cv;
+    uint64_t appended_lsn{0};
+    uint64_t flushed_lsn{0};
+    bool flush_in_progress{false};
+    std::map<int, size_t> live_records_per_table;
+  };
+
+  std::shared_ptr<WalFile> getFileForDb(const int db_id);
+  void replayLog(WalFile& wal, Catalog_Namespace::Catalog& catalog);
+
+  std::mutex files_mutex_;
+  std::map<int, std::shared_ptr<WalFile>> files_;
+};
+
+}  // namespace Fragmenter_Namespace
+
+extern bool g_enable_insert_wal;
+
+#endif  // INSERT_WAL_H
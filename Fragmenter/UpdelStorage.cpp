@@ -25,6 +25,7 @@
 #include "DataMgr/DataMgr.h"
 #include "DataMgr/FixedLengthArrayNoneEncoder.h"
 #include "Fragmenter/InsertOrderFragmenter.h"
+#include "LockMgr/TableLockMgr.h"
 #include "QueryEngine/TargetValue.h"
 #include "Shared/ConfigResolve.h"
 #include "Shared/DateConverters.h"
@@ -55,6 +56,58 @@ inline bool is_integral(const SQLTypeInfo& t) {
   return t.is_integer() || t.is_boolean() || t.is_time() || t.is_timeinterval();
 }
 
+namespace {
+
+// Takes the exclusive fragment lock under the statement's table
+// intent-exclusive lock and parks it in the roll so it is held until the
+// statement commits or rolls back. A statement updating several columns of
+// one fragment passes through here once per column; the lockedFragments set
+// keeps it from self-deadlocking on the second pass.
+void lock_fragment_for_dml(const Catalog_Namespace::Catalog* catalog,
+                           const TableDescriptor* td,
+                           const int fragment_id,
+                           UpdelRoll& updel_roll) {
+  const ChunkKey frag_key{catalog->getCurrentDB().dbId, td->tableId, fragment_id};
+  {
+    std::lock_guard<std::mutex> lck(updel_roll.mutex);
+    if (!updel_roll.lockedFragments.insert(frag_key).second) {
+      return;
+    }
+  }
+  auto fragment_lock = Lock_Namespace::TableLockMgr::getWriteLockForFragment(
+      ChunkKey{catalog->getCurrentDB().dbId, td->tableId}, fragment_id);
+  std::lock_guard<std::mutex> lck(updel_roll.mutex);
+  updel_roll.fragmentLocks.push_back(std::move(fragment_lock));
+}
+
+// Columnwise store loop for update values which arrive from the kernel
+// already in the column's own fixed-width type: one aligned store per row,
+// no per-row type dispatch, validation or string handling. The null sentinel
+// is the same on both sides, so it passes through the store and is picked up
+// by tabulate_metadata like any other value.
+template <typename BUFFER_TYPE, typename VALUE_TYPE, typename STAT_TYPE>
+void update_fixed_width_values(int8_t* dbuf_addr,
+                               const std::vector<uint64_t>& frag_offsets,
+                               const std::vector<ScalarTargetValue>& rhs_values,
+                               const SQLTypeInfo& lhs_type,
+                               const size_t rbegin,
+                               const size_t rend,
+                               STAT_TYPE& min_val,
+                               STAT_TYPE& max_val,
+                               int8_t& has_null) {
+  const auto buf = reinterpret_cast<BUFFER_TYPE*>(dbuf_addr);
+  const auto n_rhs_values = rhs_values.size();
+  for (size_t r = rbegin; r < rend; ++r) {
+    const auto vp = boost::get<VALUE_TYPE>(&rhs_values[1 == n_rhs_values ? 0 : r]);
+    CHECK(vp);
+    buf[frag_offsets[r]] = static_cast<BUFFER_TYPE>(*vp);
+    tabulate_metadata(
+        lhs_type, min_val, max_val, has_null, static_cast<STAT_TYPE>(*vp));
+  }
+}
+
+}  // namespace
+
 bool FragmentInfo::unconditionalVacuum_{false};
 
 void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catalog,
@@ -308,6 +361,12 @@ void InsertOrderFragmenter::updateColumns(
   updelRoll.logicalTableId = catalog->getLogicalTableId(td->tableId);
   updelRoll.memoryLevel = memoryLevel;
 
+  if (td->uniqueKeyColumnId > 0) {
+    invalidateUniqueKeyIndex();
+  }
+
+  lock_fragment_for_dml(catalog, td, fragmentId, updelRoll);
+
   size_t num_rows = sourceDataProvider.count();
 
   if (0 == num_rows) {
@@ -591,6 +650,14 @@ void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catal
   updel_roll.logicalTableId = catalog->getLogicalTableId(td->tableId);
   updel_roll.memoryLevel = memory_level;
 
+  if (td->uniqueKeyColumnId > 0 &&
+      (cd->columnId == td->uniqueKeyColumnId || cd->isDeletedCol)) {
+    // a rewritten key value or delete flag makes the mapped offsets stale
+    invalidateUniqueKeyIndex();
+  }
+
+  lock_fragment_for_dml(catalog, td, fragment_id, updel_roll);
+
   const size_t ncore = cpu_threads();
   const auto nrow = frag_offsets.size();
   const auto n_rhs_values = rhs_values.size();
@@ -618,6 +685,22 @@ void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catal
   std::vector<int64_t> max_int64t_per_thread(ncore, std::numeric_limits<int64_t>::min());
   std::vector<int64_t> min_int64t_per_thread(ncore, std::numeric_limits<int64_t>::max());
 
+  // The columnar kernel produces update values already in the column's own
+  // type for the common numeric cases; recognize that shape once so each
+  // worker below can run a plain fixed-width store loop instead of the
+  // per-row variant dispatch, validation and string handling.
+  bool fixed_width_fast_path = false;
+  if (cd->columnType.get_compression() == kENCODING_NONE &&
+      cd->columnType.get_type() == rhs_type.get_type()) {
+    if (cd->columnType.is_integer()) {
+      fixed_width_fast_path = boost::get<int64_t>(&rhs_values.front()) != nullptr;
+    } else if (cd->columnType.get_type() == kFLOAT) {
+      fixed_width_fast_path = boost::get<float>(&rhs_values.front()) != nullptr;
+    } else if (cd->columnType.get_type() == kDOUBLE) {
+      fixed_width_fast_path = boost::get<double>(&rhs_values.front()) != nullptr;
+    }
+  }
+
   // parallel update elements
   std::vector<std::future<void>> threads;
 
@@ -650,6 +733,81 @@ void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catal
          &rhs_values] {
           SQLTypeInfo lhs_type = cd->columnType;
 
+          if (fixed_width_fast_path) {
+            const auto rend = std::min(rbegin + segsz, nrow);
+            if (lhs_type.get_type() == kFLOAT) {
+              update_fixed_width_values<float, float>(dbuf_addr,
+                                                      frag_offsets,
+                                                      rhs_values,
+                                                      lhs_type,
+                                                      rbegin,
+                                                      rend,
+                                                      min_double_per_thread[c],
+                                                      max_double_per_thread[c],
+                                                      has_null_per_thread[c]);
+            } else if (lhs_type.get_type() == kDOUBLE) {
+              update_fixed_width_values<double, double>(dbuf_addr,
+                                                        frag_offsets,
+                                                        rhs_values,
+                                                        lhs_type,
+                                                        rbegin,
+                                                        rend,
+                                                        min_double_per_thread[c],
+                                                        max_double_per_thread[c],
+                                                        has_null_per_thread[c]);
+            } else {
+              switch (lhs_type.get_size()) {
+                case 1:
+                  update_fixed_width_values<int8_t, int64_t>(dbuf_addr,
+                                                             frag_offsets,
+                                                             rhs_values,
+                                                             lhs_type,
+                                                             rbegin,
+                                                             rend,
+                                                             min_int64t_per_thread[c],
+                                                             max_int64t_per_thread[c],
+                                                             has_null_per_thread[c]);
+                  break;
+                case 2:
+                  update_fixed_width_values<int16_t, int64_t>(dbuf_addr,
+                                                              frag_offsets,
+                                                              rhs_values,
+                                                              lhs_type,
+                                                              rbegin,
+                                                              rend,
+                                                              min_int64t_per_thread[c],
+                                                              max_int64t_per_thread[c],
+                                                              has_null_per_thread[c]);
+                  break;
+                case 4:
+                  update_fixed_width_values<int32_t, int64_t>(dbuf_addr,
+                                                              frag_offsets,
+                                                              rhs_values,
+                                                              lhs_type,
+                                                              rbegin,
+                                                              rend,
+                                                              min_int64t_per_thread[c],
+                                                              max_int64t_per_thread[c],
+                                                              has_null_per_thread[c]);
+                  break;
+                case 8:
+                  update_fixed_width_values<int64_t, int64_t>(dbuf_addr,
+                                                              frag_offsets,
+                                                              rhs_values,
+                                                              lhs_type,
+                                                              rbegin,
+                                                              rend,
+                                                              min_int64t_per_thread[c],
+                                                              max_int64t_per_thread[c],
+                                                              has_null_per_thread[c]);
+                  break;
+                default:
+                  CHECK(false);
+              }
+            }
+            return;
+          }
+
           // !! not sure if this is a undocumented convention or a bug, but for a sharded
           // table the dictionary id of a encoded string column is not specified by
           // comp_param in physical table but somehow in logical table :) comp_param in
@@ -974,6 +1132,7 @@ void InsertOrderFragmenter::updateMetadata(const Catalog_Namespace::Catalog* cat
     fragmentInfo.setChunkMetadataMap(chunkMetadata);
     fragmentInfo.shadowNumTuples = updel_roll.numTuples[key];
     fragmentInfo.setPhysicalNumTuples(fragmentInfo.shadowNumTuples);
+    fragmentInfo.setMetadataDirty(true);
     // TODO(ppan): When fragment-level compaction is enable, the following code
     // should suffice. When not (ie. existing code), we'll revert to update
     // InsertOrderFragmenter::varLenColInfo_
@@ -987,6 +1146,36 @@ void InsertOrderFragmenter::updateMetadata(const Catalog_Namespace::Catalog* cat
   }
 }
 
+void InsertOrderFragmenter::updateMetadata(const Catalog_Namespace::Catalog* catalog,
+                                           UpdelRoll& updel_roll) {
+  // Swap in every dirty fragment's new metadata in one pass: the fragment
+  // info lock is taken once for the whole statement and the per-fragment map
+  // copies, which dominate commit time on tables with many fragments, run on
+  // parallel workers. Distinct fragments are distinct objects, so the copies
+  // don't race while the structure is locked.
+  mapd_unique_lock<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
+  std::vector<std::future<void>> threads;
+  for (auto& cm : updel_roll.chunkMetadata) {
+    const auto& key = cm.first;
+    if (key.first->fragmenter != this) {
+      continue;
+    }
+    threads.emplace_back(std::async(std::launch::async, [key, &updel_roll] {
+      auto& fragmentInfo = *key.second;
+      const auto& chunkMetadata = updel_roll.chunkMetadata.at(key);
+      fragmentInfo.shadowChunkMetadataMap = chunkMetadata;
+      fragmentInfo.setChunkMetadataMap(chunkMetadata);
+      fragmentInfo.shadowNumTuples = updel_roll.numTuples.at(key);
+      fragmentInfo.setPhysicalNumTuples(fragmentInfo.shadowNumTuples);
+      fragmentInfo.setMetadataDirty(true);
+    }));
+    if (threads.size() >= (size_t)cpu_threads()) {
+      wait_cleanup_threads(threads);
+    }
+  }
+  wait_cleanup_threads(threads);
+}
+
 auto InsertOrderFragmenter::getChunksForAllColumns(
     const TableDescriptor* td,
     const FragmentInfo& fragment,
@@ -1177,12 +1366,306 @@ auto InsertOrderFragmenter::vacuum_varlen_rows(
   return nbytes_var_data_to_keep;
 }
 
+namespace {
+
+// Fixed width columns arrive in InsertData at their logical width (the
+// encoders narrow on append); dictionary-encoded strings arrive already
+// encoded at the dictionary width.
+inline size_t insert_element_width(const SQLTypeInfo& ti) {
+  return ti.is_string() ? ti.get_size() : ti.get_logical_size();
+}
+
+inline int64_t read_int_value(const int8_t* buf, const size_t idx, const size_t width) {
+  switch (width) {
+    case 1:
+      return buf[idx];
+    case 2:
+      return reinterpret_cast<const int16_t*>(buf)[idx];
+    case 4:
+      return reinterpret_cast<const int32_t*>(buf)[idx];
+    case 8:
+      return reinterpret_cast<const int64_t*>(buf)[idx];
+    default:
+      CHECK(false);
+  }
+  return 0;
+}
+
+inline bool is_int_null_value(const int64_t v, const size_t width) {
+  switch (width) {
+    case 1:
+      return v == inline_int_null_value<int8_t>();
+    case 2:
+      return v == inline_int_null_value<int16_t>();
+    case 4:
+      return v == inline_int_null_value<int32_t>();
+    case 8:
+      return v == inline_int_null_value<int64_t>();
+    default:
+      CHECK(false);
+  }
+  return false;
+}
+
+}  // namespace
+
+void InsertOrderFragmenter::invalidateUniqueKeyIndex() {
+  uniqueKeyIndex_.clear();
+  uniqueKeyIndexedRows_.clear();
+  uniqueKeyIndexValid_ = false;
+}
+
+void InsertOrderFragmenter::refreshUniqueKeyIndex(const TableDescriptor* td,
+                                                  const ColumnDescriptor* key_cd) {
+  if (!uniqueKeyIndexValid_) {
+    uniqueKeyIndex_.clear();
+    uniqueKeyIndexedRows_.clear();
+  }
+  const auto deleted_cd = td->hasDeletedCol ? catalog_->getDeletedColumn(td) : nullptr;
+  const auto& key_ti = key_cd->columnType;
+  const size_t key_width = key_ti.get_size();
+  for (auto& fragment : fragmentInfoVec_) {
+    const size_t nrows = fragment.getPhysicalNumTuples();
+    auto& nindexed = uniqueKeyIndexedRows_[fragment.fragmentId];
+    if (nindexed >= nrows) {
+      continue;
+    }
+    const auto& metadata_map = fragment.getChunkMetadataMapPhysical();
+    auto chunk_meta_it = metadata_map.find(key_cd->columnId);
+    CHECK(chunk_meta_it != metadata_map.end());
+    ChunkKey chunk_key{catalog_->getCurrentDB().dbId,
+                       physicalTableId_,
+                       key_cd->columnId,
+                       fragment.fragmentId};
+    auto chunk = Chunk_NS::Chunk::getChunk(key_cd,
+                                           &catalog_->getDataMgr(),
+                                           chunk_key,
+                                           Data_Namespace::CPU_LEVEL,
+                                           0,
+                                           chunk_meta_it->second.numBytes,
+                                           chunk_meta_it->second.numElements);
+    auto data_addr = chunk->get_buffer()->getMemoryPtr();
+    // rows flagged deleted must not satisfy future probes
+    std::shared_ptr<Chunk_NS::Chunk> deleted_chunk;
+    const int8_t* deleted_addr = nullptr;
+    if (deleted_cd) {
+      auto deleted_meta_it = metadata_map.find(deleted_cd->columnId);
+      if (deleted_meta_it != metadata_map.end()) {
+        ChunkKey deleted_key{catalog_->getCurrentDB().dbId,
+                             physicalTableId_,
+                             deleted_cd->columnId,
+                             fragment.fragmentId};
+        deleted_chunk = Chunk_NS::Chunk::getChunk(deleted_cd,
+                                                  &catalog_->getDataMgr(),
+                                                  deleted_key,
+                                                  Data_Namespace::CPU_LEVEL,
+                                                  0,
+                                                  deleted_meta_it->second.numBytes,
+                                                  deleted_meta_it->second.numElements);
+        deleted_addr = deleted_chunk->get_buffer()->getMemoryPtr();
+      }
+    }
+    for (size_t i = nindexed; i < nrows; ++i) {
+      if (deleted_addr && deleted_addr[i]) {
+        continue;
+      }
+      int64_t key;
+      if (key_ti.is_string()) {
+        key = get_string_index(data_addr + i * key_width, key_width);
+        if (is_null_string_index(key_width, key)) {
+          continue;
+        }
+      } else {
+        key = read_int_value(data_addr, i, key_width);
+        if (is_int_null_value(key, key_width)) {
+          continue;
+        }
+      }
+      uniqueKeyIndex_[key] = std::make_pair(fragment.fragmentId, uint64_t(i));
+    }
+    nindexed = nrows;
+  }
+  uniqueKeyIndexValid_ = true;
+}
+
+void InsertOrderFragmenter::upsertData(InsertData& insertDataStruct,
+                                       const TableDescriptor* td) {
+  mapd_unique_lock<mapd_shared_mutex> insertLock(insertMutex_);
+  try {
+    const auto key_cd =
+        catalog_->getMetadataForColumn(physicalTableId_, td->uniqueKeyColumnId);
+    CHECK(key_cd);
+
+    const auto ncols = insertDataStruct.columnIds.size();
+    std::vector<const ColumnDescriptor*> cds(ncols);
+    ssize_t key_idx = -1;
+    for (size_t i = 0; i < ncols; ++i) {
+      cds[i] = catalog_->getMetadataForColumn(physicalTableId_,
+                                              insertDataStruct.columnIds[i]);
+      CHECK(cds[i]);
+      if (cds[i]->columnType.is_varlen() || cds[i]->columnType.is_geometry()) {
+        throw std::runtime_error("Upsert is not supported on variable length column " +
+                                 cds[i]->columnName);
+      }
+      if (cds[i]->columnId == key_cd->columnId) {
+        key_idx = i;
+      }
+    }
+    if (key_idx < 0) {
+      throw std::runtime_error("Unique key column " + key_cd->columnName +
+                               " is missing from the insert data");
+    }
+
+    refreshUniqueKeyIndex(td, key_cd);
+
+    const auto nrows = insertDataStruct.numRows;
+    const auto& key_ti = key_cd->columnType;
+    const size_t key_width = insert_element_width(key_ti);
+    const auto key_buf = insertDataStruct.data[key_idx].numbersPtr;
+    std::vector<int64_t> keys(nrows);
+    std::vector<bool> key_is_null(nrows);
+    for (size_t r = 0; r < nrows; ++r) {
+      if (key_ti.is_string()) {
+        keys[r] = get_string_index(key_buf + r * key_width, key_width);
+        key_is_null[r] = is_null_string_index(key_width, keys[r]);
+      } else {
+        keys[r] = read_int_value(key_buf, r, key_width);
+        key_is_null[r] = is_int_null_value(keys[r], key_width);
+      }
+    }
+
+    // within one batch the last occurrence of a key wins; earlier occurrences
+    // are dropped so a key is touched at most once below. Null keys never
+    // deduplicate, matching the multiple-nulls-allowed UNIQUE convention.
+    std::unordered_map<int64_t, size_t> last_row_of_key;
+    last_row_of_key.reserve(nrows);
+    for (size_t r = 0; r < nrows; ++r) {
+      if (!key_is_null[r]) {
+        last_row_of_key[keys[r]] = r;
+      }
+    }
+
+    // partition the batch: per-fragment offset/row lists for keys already in
+    // the table, everything else appended
+    std::map<int, std::pair<std::vector<uint64_t>, std::vector<size_t>>> matched;
+    std::vector<size_t> fresh_rows;
+    fresh_rows.reserve(nrows);
+    for (size_t r = 0; r < nrows; ++r) {
+      if (!key_is_null[r]) {
+        if (last_row_of_key[keys[r]] != r) {
+          continue;
+        }
+        const auto hit = uniqueKeyIndex_.find(keys[r]);
+        if (hit != uniqueKeyIndex_.end()) {
+          auto& frag_rows = matched[hit->second.first];
+          frag_rows.first.push_back(hit->second.second);
+          frag_rows.second.push_back(r);
+          continue;
+        }
+      }
+      fresh_rows.push_back(r);
+    }
+
+    // matched rows are rewritten in place, column by column, through the
+    // chunk update path; the key column itself matched and is left untouched
+    UpdelRoll updel_roll;
+    for (auto& frag_entry : matched) {
+      const auto fragment_id = frag_entry.first;
+      const auto& frag_offsets = frag_entry.second.first;
+      const auto& batch_rows = frag_entry.second.second;
+      for (size_t i = 0; i < ncols; ++i) {
+        if (static_cast<ssize_t>(i) == key_idx) {
+          continue;
+        }
+        const auto cd = cds[i];
+        const auto& ti = cd->columnType;
+        const size_t width = insert_element_width(ti);
+        const auto buf = insertDataStruct.data[i].numbersPtr;
+        std::vector<ScalarTargetValue> rhs_values;
+        rhs_values.reserve(batch_rows.size());
+        for (const auto r : batch_rows) {
+          if (ti.is_string()) {
+            const int64_t sidx = get_string_index(buf + r * width, width);
+            if (is_null_string_index(width, sidx)) {
+              rhs_values.emplace_back(NullableString(static_cast<void*>(nullptr)));
+            } else {
+              // passed as a string index; updateColumn resolves it through
+              // the rhs type's dictionary, which here is the column's own
+              rhs_values.emplace_back(sidx);
+            }
+          } else if (ti.get_type() == kFLOAT) {
+            rhs_values.emplace_back(reinterpret_cast<const float*>(buf)[r]);
+          } else if (ti.get_type() == kDOUBLE) {
+            rhs_values.emplace_back(reinterpret_cast<const double*>(buf)[r]);
+          } else {
+            rhs_values.emplace_back(read_int_value(buf, r, width));
+          }
+        }
+        updateColumn(catalog_,
+                     td,
+                     cd,
+                     fragment_id,
+                     frag_offsets,
+                     rhs_values,
+                     cd->columnType,
+                     Data_Namespace::MemoryLevel::CPU_LEVEL,
+                     updel_roll);
+      }
+    }
+
+    if (!fresh_rows.empty()) {
+      // append the rows whose keys were not found, sliced column by column
+      // out of the original blocks
+      InsertData fresh_data;
+      fresh_data.databaseId = insertDataStruct.databaseId;
+      fresh_data.tableId = insertDataStruct.tableId;
+      fresh_data.columnIds = insertDataStruct.columnIds;
+      fresh_data.numRows = fresh_rows.size();
+      std::vector<std::vector<int8_t>> fresh_buffers(ncols);
+      for (size_t i = 0; i < ncols; ++i) {
+        const size_t width = insert_element_width(cds[i]->columnType);
+        auto& buffer = fresh_buffers[i];
+        buffer.resize(fresh_rows.size() * width);
+        const auto src = insertDataStruct.data[i].numbersPtr;
+        for (size_t j = 0; j < fresh_rows.size(); ++j) {
+          memcpy(&buffer[j * width], src + fresh_rows[j] * width, width);
+        }
+        DataBlockPtr block;
+        block.numbersPtr = buffer.data();
+        fresh_data.data.push_back(block);
+        fresh_data.columnDescriptors[cds[i]->columnId] = cds[i];
+      }
+      insertDataImpl(fresh_data, columnMap_, varLenColInfo_, currentInsertFragment_);
+      // the key index is refreshed incrementally from the grown fragment
+      // tails on the next upsert; uniqueKeyIndexedRows_ still holds the
+      // pre-append row counts
+    }
+    dropFragmentsToSize(maxRows_);
+
+    if (matched.empty()) {
+      checkpointAfterInsert(insertDataStruct);
+    } else {
+      // commits the shadow metadata of the updated fragments and checkpoints
+      // the table, covering any appended rows as well
+      updel_roll.commitUpdate();
+    }
+  } catch (...) {
+    int32_t tableEpoch = catalog_->getTableEpoch(insertDataStruct.databaseId,
+                                                 insertDataStruct.tableId);
+    invalidateUniqueKeyIndex();
+    catalog_->setTableEpoch(
+        insertDataStruct.databaseId, insertDataStruct.tableId, tableEpoch);
+    throw;
+  }
+}
+
 void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalog,
                                         const TableDescriptor* td,
                                         const int fragment_id,
                                         const std::vector<uint64_t>& frag_offsets,
                                         const Data_Namespace::MemoryLevel memory_level,
                                         UpdelRoll& updel_roll) {
+  invalidateUniqueKeyIndex();  // vacuum moves rows, the mapped offsets go stale
   auto& fragment = getFragmentInfoFromId(fragment_id);
   auto chunks = getChunksForAllColumns(td, fragment, memory_level);
   const auto ncol = chunks.size();
@@ -1309,14 +1792,28 @@ void UpdelRoll::commitUpdate() {
   }
   const auto td = catalog->getMetadataForTable(logicalTableId);
   CHECK(td);
+  // rows were rewritten in place without changing the table's row count, so
+  // materialized view watermarks over this table can no longer be trusted
+  const_cast<Catalog_Namespace::Catalog*>(catalog)->invalidateMaterializedViewWatermarks(
+      td->tableName);
   // checkpoint all shards regardless, or epoch becomes out of sync
   if (td->persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
     catalog->checkpoint(logicalTableId);
   }
-  // for each dirty fragment
+  // Each physical table's fragmenter swaps all of its dirty fragments'
+  // metadata in one pass, and the fragmenters (shards) commit on parallel
+  // workers, so commit cost no longer grows with a lock round trip per
+  // fragment.
+  std::set<Fragmenter_Namespace::AbstractFragmenter*> fragmenters;
   for (auto& cm : chunkMetadata) {
-    cm.first.first->fragmenter->updateMetadata(catalog, cm.first, *this);
+    fragmenters.insert(cm.first.first->fragmenter);
+  }
+  std::vector<std::future<void>> threads;
+  for (const auto fragmenter : fragmenters) {
+    threads.emplace_back(std::async(
+        std::launch::async, [this, fragmenter] { fragmenter->updateMetadata(catalog, *this); }));
   }
+  Fragmenter_Namespace::wait_cleanup_threads(threads);
   dirtyChunks.clear();
   // flush gpu dirty chunks if update was not on gpu
   if (memoryLevel != Data_Namespace::MemoryLevel::GPU_LEVEL) {
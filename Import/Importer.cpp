@@ -23,10 +23,18 @@
 #include <gdal.h>
 #include <ogrsf_frmts.h>
 #include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include <boost/algorithm/string.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/variant.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cfloat>
+#include <cmath>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
@@ -235,6 +243,38 @@ static const bool is_eol(const char& p, const std::string& line_delims) {
   return false;
 }
 
+// Advances over bytes which don't need special handling in get_row, returning a
+// pointer to the first delimiter, quote, escape, array marker or line ending
+// (or buf_end if there is none). Scans 16 bytes at a time with SSE2 compares
+// where available; the scalar tail also serves as the portable fallback.
+static const char* find_special_char(const char* buf,
+                                     const char* buf_end,
+                                     const char* special,
+                                     const size_t num_special) {
+  const char* p = buf;
+#ifdef __SSE2__
+  for (; p + 16 <= buf_end; p += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hits = _mm_setzero_si128();
+    for (size_t i = 0; i < num_special; ++i) {
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(special[i])));
+    }
+    const int mask = _mm_movemask_epi8(hits);
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; p < buf_end; ++p) {
+    for (size_t i = 0; i < num_special; ++i) {
+      if (*p == special[i]) {
+        return p;
+      }
+    }
+  }
+  return buf_end;
+}
+
 static const char* get_row(const char* buf,
                            const char* buf_end,
                            const char* entire_buf_end,
@@ -251,7 +291,26 @@ static const char* get_row(const char* buf,
   bool strip_quotes = false;
   try_single_thread = false;
   std::string line_endings({copy_params.line_delim, '\r', '\n'});
+  char special[8];
+  size_t num_special = 0;
+  special[num_special++] = copy_params.delimiter;
+  special[num_special++] = copy_params.line_delim;
+  special[num_special++] = '\r';
+  special[num_special++] = '\n';
+  special[num_special++] = copy_params.escape;
+  if (copy_params.quoted) {
+    special[num_special++] = copy_params.quote;
+  }
+  if (is_array != nullptr) {
+    special[num_special++] = copy_params.array_begin;
+    special[num_special++] = copy_params.array_end;
+  }
   for (p = buf; p < entire_buf_end; p++) {
+    // bulk-skip the plain field bytes between special characters
+    p = find_special_char(p, entire_buf_end, special, num_special);
+    if (p == entire_buf_end) {
+      break;
+    }
     if (*p == copy_params.escape && p < entire_buf_end - 1 &&
         *(p + 1) == copy_params.quote) {
       p++;
@@ -2690,16 +2749,6 @@ void Detector::split_raw_data() {
   }
 }
 
-template <class T>
-bool try_cast(const std::string& str) {
-  try {
-    boost::lexical_cast<T>(str);
-  } catch (const boost::bad_lexical_cast& e) {
-    return false;
-  }
-  return true;
-}
-
 inline char* try_strptimes(const char* str, const std::vector<std::string>& formats) {
   std::tm tm_struct;
   char* buf;
@@ -2714,24 +2763,69 @@ inline char* try_strptimes(const char* str, const std::vector<std::string>& form
 
 SQLTypes Detector::detect_sqltype(const std::string& str) {
   SQLTypes type = kTEXT;
-  if (try_cast<double>(str)) {
-    type = kDOUBLE;
-    /*if (try_cast<bool>(str)) {
-      type = kBOOLEAN;
-    }*/
-    if (try_cast<int16_t>(str)) {
-      type = kSMALLINT;
-    } else if (try_cast<int32_t>(str)) {
-      type = kINT;
-    } else if (try_cast<int64_t>(str)) {
-      type = kBIGINT;
-    } else if (try_cast<float>(str)) {
-      type = kFLOAT;
-    }
-  }
-
-  // check for geo types
-  if (type == kTEXT) {
+  // Single pass over the cell to classify its character mix up front. The
+  // loop is a handful of branch-free comparisons per byte, and the counters
+  // settle every numeric candidate with at most one real parse afterwards —
+  // the old cascade of up to five exception-throwing lexical casts per cell
+  // dominated detection time on wide files.
+  const char* cell_begin = str.c_str();
+  const char* cell_end = cell_begin + str.size();
+  const char* p = cell_begin;
+  if (p != cell_end && (*p == '+' || *p == '-')) {
+    ++p;
+  }
+  size_t digits = 0;
+  size_t dots = 0;
+  size_t exponents = 0;
+  bool non_numeric_char = false;
+  for (; p != cell_end; ++p) {
+    const char c = *p;
+    digits += (c >= '0' && c <= '9');
+    dots += (c == '.');
+    if (c == 'e' || c == 'E') {
+      exponents++;
+      if (p + 1 != cell_end && (p[1] == '+' || p[1] == '-')) {
+        ++p;  // sign of the exponent
+      }
+    } else {
+      non_numeric_char |= !((c >= '0' && c <= '9') || c == '.');
+    }
+  }
+  if (digits > 0 && !non_numeric_char && dots <= 1 && exponents <= 1) {
+    if (dots == 0 && exponents == 0) {
+      errno = 0;
+      char* parse_end{nullptr};
+      const int64_t val = std::strtoll(cell_begin, &parse_end, 10);
+      if (parse_end == cell_end && errno != ERANGE) {
+        if (val == static_cast<int16_t>(val)) {
+          return kSMALLINT;
+        }
+        if (val == static_cast<int32_t>(val)) {
+          return kINT;
+        }
+        return kBIGINT;
+      }
+      // integers past the 64 bit range still parse as DOUBLE below, matching
+      // the old lexical_cast behavior
+    }
+    errno = 0;
+    char* parse_end{nullptr};
+    const double val = std::strtod(cell_begin, &parse_end);
+    // over- and underflowing values fall through to text, as lexical_cast
+    // rejected them too
+    if (parse_end == cell_end && errno != ERANGE) {
+      // values that fit a float stay FLOAT, as lexical_cast<float> accepted
+      return std::fabs(val) <= FLT_MAX ? kFLOAT : kDOUBLE;
+    }
+    // pathological mixes like a lone exponent char fall through to text
+  }
+
+  // check for geo types; guarded on the first character so plain text cells
+  // don't pay for an upper-cased copy of themselves
+  const char first_char = str.empty() ? '\0' : str[0];
+  if (first_char == 'P' || first_char == 'p' || first_char == 'L' ||
+      first_char == 'l' || first_char == 'M' || first_char == 'm' ||
+      (isxdigit(first_char) && (str.size() % 2) == 0)) {
     // convert to upper case
     std::string str_upper_case = str;
     std::transform(
@@ -2763,8 +2857,12 @@ SQLTypes Detector::detect_sqltype(const std::string& str) {
     }
   }
 
-  // check for time types
-  if (type == kTEXT) {
+  // check for time types; every supported format opens with a numeric field,
+  // so cells that don't lead with a digit (after optional whitespace, which
+  // strptime skips) can't match and skip the strptime attempts entirely
+  const auto first_non_space = str.find_first_not_of(' ');
+  if (type == kTEXT && first_non_space != std::string::npos &&
+      isdigit(str[first_non_space])) {
     // @TODO
     // make these tests more robust so they don't match stuff they should not
     char* buf;
@@ -3029,7 +3127,14 @@ ImportStatus DataStreamSink::archivePlumber() {
   //                  .parquet("s3://bucket/folder/parquet/mydata")
   //       without the parameter, it means plain or compressed csv files.
   // note: .ORC and AVRO files should follow a similar path to Parquet?
-  if (copy_params.file_type == FileType::PARQUET) {
+  // Local files with an explicit .parquet extension are unambiguous, so they
+  // are routed to the parquet importer even without the WITH parameter.
+  const auto all_local_parquet_files =
+      !boost::istarts_with(file_path, "s3://") &&
+      std::all_of(file_paths.begin(), file_paths.end(), [](const std::string& path) {
+        return boost::iends_with(path, ".parquet");
+      });
+  if (copy_params.file_type == FileType::PARQUET || all_local_parquet_files) {
     import_parquet(file_paths);
   } else
 #endif
@@ -3043,16 +3148,29 @@ ImportStatus DataStreamSink::archivePlumber() {
 inline auto open_parquet_table(const std::string& file_path,
                                std::shared_ptr<arrow::io::ReadableFile>& infile,
                                std::unique_ptr<parquet::arrow::FileReader>& reader,
-                               std::shared_ptr<arrow::Table>& table) {
+                               std::shared_ptr<arrow::Table>& table,
+                               const bool read_full_table = true) {
   using namespace parquet::arrow;
   using ReadableFile = arrow::io::ReadableFile;
   auto mempool = arrow::default_memory_pool();
   PARQUET_THROW_NOT_OK(ReadableFile::Open(file_path, mempool, &infile));
   PARQUET_THROW_NOT_OK(OpenFile(infile, mempool, &reader));
-  PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
-  const auto num_row_groups = reader->num_row_groups();
-  const auto num_columns = table->num_columns();
-  const auto num_rows = table->num_rows();
+  int num_row_groups;
+  int num_columns;
+  int64_t num_rows;
+  if (read_full_table) {
+    PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+    num_row_groups = reader->num_row_groups();
+    num_columns = table->num_columns();
+    num_rows = table->num_rows();
+  } else {
+    // row-group-at-a-time readers only need the counts; pulling them from the
+    // file metadata avoids materializing the whole table up front
+    const auto file_metadata = reader->parquet_reader()->metadata();
+    num_row_groups = file_metadata->num_row_groups();
+    num_columns = file_metadata->num_columns();
+    num_rows = file_metadata->num_rows();
+  }
   LOG(INFO) << "File " << file_path << " has " << num_rows << " rows and " << num_columns
             << " columns in " << num_row_groups << " groups.";
   return std::make_tuple(num_row_groups, num_columns, num_rows);
@@ -3176,7 +3294,7 @@ void Importer::import_local_parquet(const std::string& file_path) {
   int num_row_groups, num_columns;
   int64_t nrow_in_file;
   std::tie(num_row_groups, num_columns, nrow_in_file) =
-      open_parquet_table(file_path, infile, reader, table);
+      open_parquet_table(file_path, infile, reader, table, /*read_full_table=*/false);
   // column_list has no $deleted
   const auto& column_list = get_column_descs();
   // for now geo columns expect a wkt string
@@ -3235,13 +3353,26 @@ void Importer::import_local_parquet(const std::string& file_path) {
         bad_rows_tracker.row_group = slice;
         bad_rows_tracker.importer = this;
       }
+      // read the row group's columns in parallel; decompression and decoding
+      // dominate read time for wide tables
+      std::vector<std::shared_ptr<arrow::Array>> arrays(num_columns);
+      {
+        ThreadController_NS::SimpleThreadController<void> read_controller(max_threads);
+        for (int logic_col_idx = 0; logic_col_idx < num_columns; ++logic_col_idx) {
+          read_controller.checkThreadsStatus();
+          read_controller.startThread([&, logic_col_idx] {
+            PARQUET_THROW_NOT_OK(reader->RowGroup(row_group)
+                                     ->Column(logic_col_idx)
+                                     ->Read(&arrays[logic_col_idx]));
+          });
+        }
+        read_controller.finish();
+      }
       // process arrow arrays to import buffers
       for (int logic_col_idx = 0; logic_col_idx < num_columns; ++logic_col_idx) {
         const auto physical_col_idx = get_physical_col_idx(logic_col_idx);
         const auto cd = cds[physical_col_idx];
-        std::shared_ptr<arrow::Array> array;
-        PARQUET_THROW_NOT_OK(
-            reader->RowGroup(row_group)->Column(logic_col_idx)->Read(&array));
+        const auto& array = arrays[logic_col_idx];
         const size_t array_size = array->length();
         const size_t slice_size = (array_size + num_slices - 1) / num_slices;
         ThreadController_NS::SimpleThreadController<void> thread_controller(num_slices);
@@ -4719,6 +4850,7 @@ void RenderGroupAnalyzer::seedFromExistingTableContents(
 
   // start with a fresh tree
   _rtree = nullptr;
+  _insertLog.clear();
   _numRenderGroups = 0;
 
   // if the table is empty, just make an empty tree
@@ -4839,21 +4971,45 @@ int RenderGroupAnalyzer::insertBoundsAndReturnRenderGroup(
   boost::geometry::expand(bounding_box, Point(bounds[0], bounds[1]));
   boost::geometry::expand(bounding_box, Point(bounds[2], bounds[3]));
 
-  // remainder under mutex to allow this to be multi-threaded
-  std::lock_guard<std::mutex> guard(_rtreeMutex);
+  // The R-tree query dominates the cost of an assignment, so run it under a
+  // shared lock and let importer threads probe the tree concurrently. Boxes
+  // inserted by other threads while we only held the shared lock are replayed
+  // from _insertLog in the short exclusive section below, so the assignment
+  // comes out the same as if query and insert ran under a single mutex.
+  boost::dynamic_bitset<> bits;
+  size_t seen_inserts = 0;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(_rtreeMutex);
+    seen_inserts = _insertLog.size();
+
+    // get the intersecting nodes
+    std::vector<Node> intersects;
+    _rtree->query(boost::geometry::index::intersects(bounding_box),
+                  std::back_inserter(intersects));
+
+    // build bitset of render groups of the intersecting rectangles
+    // clear bit means available, allows use of find_first()
+    bits.resize(_numRenderGroups);
+    bits.set();
+    for (const auto& intersection : intersects) {
+      CHECK(intersection.second < _numRenderGroups);
+      bits.reset(intersection.second);
+    }
+  }
 
-  // get the intersecting nodes
-  std::vector<Node> intersects;
-  _rtree->query(boost::geometry::index::intersects(bounding_box),
-                std::back_inserter(intersects));
+  mapd_unique_lock<mapd_shared_mutex> write_lock(_rtreeMutex);
 
-  // build bitset of render groups of the intersecting rectangles
-  // clear bit means available, allows use of find_first()
-  boost::dynamic_bitset<> bits(_numRenderGroups);
-  bits.set();
-  for (const auto& intersection : intersects) {
-    CHECK(intersection.second < _numRenderGroups);
-    bits.reset(intersection.second);
+  // account for groups created since the query
+  if (bits.size() < static_cast<size_t>(_numRenderGroups)) {
+    bits.resize(_numRenderGroups, true);
+  }
+
+  // replay boxes inserted since the query
+  for (size_t i = seen_inserts; i < _insertLog.size(); i++) {
+    const auto& node = _insertLog[i];
+    if (boost::geometry::intersects(node.first, bounding_box)) {
+      bits.reset(node.second);
+    }
   }
 
   // find first available group
@@ -4868,7 +5024,9 @@ int RenderGroupAnalyzer::insertBoundsAndReturnRenderGroup(
   }
 
   // insert new node
-  _rtree->insert(std::make_pair(bounding_box, firstAvailableRenderGroup));
+  auto node = std::make_pair(bounding_box, firstAvailableRenderGroup);
+  _rtree->insert(node);
+  _insertLog.push_back(node);
 
   // return it
   return firstAvailableRenderGroup;
@@ -50,6 +50,7 @@
 #include "../Fragmenter/Fragmenter.h"
 #include "../Shared/ThreadController.h"
 #include "../Shared/checked_alloc.h"
+#include "../Shared/mapd_shared_mutex.h"
 
 #include "QueryRunner/QueryRunner.h"
 
@@ -675,6 +676,9 @@ class Loader {
  protected:
   void init();
 
+  std::vector<DataBlockPtr> get_data_block_pointers(
+      const std::vector<std::unique_ptr<TypedImportBuffer>>& import_buffers);
+
   virtual bool loadImpl(
       const std::vector<std::unique_ptr<TypedImportBuffer>>& import_buffers,
       size_t row_count,
@@ -694,8 +698,6 @@ class Loader {
   std::map<int, StringDictionary*> dict_map_;
 
  private:
-  std::vector<DataBlockPtr> get_data_block_pointers(
-      const std::vector<std::unique_ptr<TypedImportBuffer>>& import_buffers);
   bool loadToShard(const std::vector<std::unique_ptr<TypedImportBuffer>>& import_buffers,
                    size_t row_count,
                    const TableDescriptor* shard_table,
@@ -866,7 +868,12 @@ class RenderGroupAnalyzer {
   using RTree =
       boost::geometry::index::rtree<Node, boost::geometry::index::quadratic<16>>;
   std::unique_ptr<RTree> _rtree;
-  std::mutex _rtreeMutex;
+  mapd_shared_mutex _rtreeMutex;
+  // Every box inserted since the last seed, in insertion order. Importer
+  // threads query the tree under a shared lock and then replay the log tail
+  // that accumulated while they held it, so only the replay and the insert
+  // itself need the exclusive lock.
+  std::vector<Node> _insertLog;
   int _numRenderGroups;
 };
 
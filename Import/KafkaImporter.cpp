@@ -23,6 +23,7 @@
  * Copyright (c) 2017 MapD Technologies, Inc.  All rights reserved.
  **/
 
+#include <atomic>
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/regex.hpp>
@@ -30,6 +31,7 @@
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <vector>
 
 #include "RowToColumnLoader.h"
 #include "Shared/Logger.h"
@@ -48,15 +50,19 @@
 bool print_error_data = false;
 bool print_transformation = false;
 
-static bool run = true;
+static std::atomic<bool> run{true};
 static bool exit_eof = false;
-static int eof_cnt = 0;
-static int partition_cnt = 0;
-static long msg_cnt = 0;
-static int64_t msg_bytes = 0;
+static std::atomic<int> eof_cnt{0};
+static std::atomic<int> partition_cnt{0};
+static std::atomic<long> msg_cnt{0};
+static std::atomic<int64_t> msg_bytes{0};
 
 class RebalanceCb : public RdKafka::RebalanceCb {
  private:
+  // partitions currently assigned to this consumer, so the global count can be
+  // adjusted when the group rebalances across several consumer threads
+  int assigned_ = 0;
+
   static void part_list_print(const std::vector<RdKafka::TopicPartition*>& partitions) {
     for (unsigned int i = 0; i < partitions.size(); i++) {
       LOG(INFO) << "\t" << partitions[i]->topic() << "[" << partitions[i]->partition()
@@ -74,10 +80,12 @@ class RebalanceCb : public RdKafka::RebalanceCb {
 
     if (err == RdKafka::ERR__ASSIGN_PARTITIONS) {
       consumer->assign(partitions);
-      partition_cnt = (int)partitions.size();
+      partition_cnt += static_cast<int>(partitions.size()) - assigned_;
+      assigned_ = static_cast<int>(partitions.size());
     } else {
       consumer->unassign();
-      partition_cnt = 0;
+      partition_cnt -= assigned_;
+      assigned_ = 0;
     }
     eof_cnt = 0;
   }
@@ -288,34 +296,23 @@ class EventCb : public RdKafka::EventCb {
   }
 };
 
-// reads from a kafka topic (expects delimited string input)
-void kafka_insert(
-    RowToColumnLoader& row_loader,
-    const std::map<std::string,
-                   std::pair<std::unique_ptr<boost::regex>,
-                             std::unique_ptr<std::string>>>& transformations,
-    const Importer_NS::CopyParams& copy_params,
-    const bool remove_quotes,
-    std::string group_id,
-    std::string topic,
-    std::string brokers) {
+/*
+ * Create a consumer from the accumulated global configuration. Each consumer
+ * thread gets its own instance; Kafka's group rebalancing spreads the topic's
+ * partitions across them.
+ */
+RdKafka::KafkaConsumer* create_consumer(const std::string& group_id,
+                                        const std::string& brokers,
+                                        RdKafka::RebalanceCb* rebalance_cb,
+                                        RdKafka::EventCb* event_cb,
+                                        const bool dump_config) {
   std::string errstr;
-  std::string topic_str;
-  std::string mode;
   std::string debug;
-  std::vector<std::string> topics;
-  bool do_conf_dump = false;
-  int use_ccb = 0;
-
-  RebalanceCb ex_rebalance_cb;
 
-  /*
-   * Create configuration objects
-   */
   RdKafka::Conf* conf = RdKafka::Conf::create(RdKafka::Conf::CONF_GLOBAL);
   RdKafka::Conf* tconf = RdKafka::Conf::create(RdKafka::Conf::CONF_TOPIC);
 
-  conf->set("rebalance_cb", &ex_rebalance_cb, errstr);
+  conf->set("rebalance_cb", rebalance_cb, errstr);
 
   if (conf->set("group.id", group_id, errstr) != RdKafka::Conf::CONF_OK) {
     LOG(FATAL) << "could not set  group.id " << errstr;
@@ -341,14 +338,6 @@ void kafka_insert(
     LOG(FATAL) << errstr;
   }
 
-  do_conf_dump = true;
-
-  topics.push_back(topic);
-
-  LOG(INFO) << "Version " << RdKafka::version_str().c_str();
-  LOG(INFO) << RdKafka::version();
-  LOG(INFO) << RdKafka::get_debug_contexts().c_str();
-
   conf->set("metadata.broker.list", brokers, errstr);
 
   // debug = "none";
@@ -358,18 +347,7 @@ void kafka_insert(
     }
   }
 
-  ConsumeCb consume_cb;
-  use_ccb = 0;
-  if (use_ccb) {
-    if (conf->set("consume_cb", &consume_cb, errstr) != RdKafka::Conf::CONF_OK) {
-      LOG(FATAL) << errstr;
-    }
-    // need to set the opaque pointer here for the callbacks
-    //        rd_kafka_conf_set_opaque(conf, this);
-  }
-
-  EventCb ex_event_cb;
-  if (conf->set("event_cb", &ex_event_cb, errstr) != RdKafka::Conf::CONF_OK) {
+  if (conf->set("event_cb", event_cb, errstr) != RdKafka::Conf::CONF_OK) {
     LOG(FATAL) << errstr;
   }
 
@@ -377,7 +355,7 @@ void kafka_insert(
     LOG(FATAL) << errstr;
   }
 
-  if (do_conf_dump) {
+  if (dump_config) {
     int pass;
 
     for (pass = 0; pass < 2; pass++) {
@@ -400,69 +378,169 @@ void kafka_insert(
       }
       LOG(INFO) << "Dump config finished";
     }
+    LOG(INFO) << "FULL Dump config finished";
   }
-  LOG(INFO) << "FULL Dump config finished";
 
   delete tconf;
 
-  /*
-   * Create consumer using accumulated global configuration.
-   */
   RdKafka::KafkaConsumer* consumer = RdKafka::KafkaConsumer::create(conf, errstr);
   if (!consumer) {
-    LOG(ERROR) << "Failed to create consumer: " << errstr;
+    LOG(FATAL) << "Failed to create consumer: " << errstr;
   }
 
   delete conf;
 
-  LOG(INFO) << " Created consumer " << consumer->name();
+  return consumer;
+}
 
-  /*
-   * Subscribe to topics
-   */
-  RdKafka::ErrorCode err = consumer->subscribe(topics);
-  if (err) {
-    LOG(FATAL) << "Failed to subscribe to " << topics.size()
-               << " topics: " << RdKafka::err2str(err);
+size_t get_topic_partition_count(RdKafka::KafkaConsumer* consumer,
+                                 const std::string& topic) {
+  RdKafka::Metadata* metadata;
+  RdKafka::ErrorCode err = consumer->metadata(true, nullptr, &metadata, 10000);
+  if (err != RdKafka::ERR_NO_ERROR) {
+    LOG(WARNING) << "Failed to fetch metadata for topic " << topic << ": "
+                 << RdKafka::err2str(err) << ", falling back to a single consumer";
+    return 1;
+  }
+  size_t partitions = 1;
+  for (const auto topic_metadata : *metadata->topics()) {
+    if (topic_metadata->topic() == topic) {
+      partitions = std::max<size_t>(topic_metadata->partitions()->size(), 1);
+    }
   }
+  delete metadata;
+  return partitions;
+}
 
-  /*
-   * Consume messages
-   */
+/*
+ * Consume messages until shutdown. Offsets are committed only after the
+ * server has accepted the batch they cover, so a crashed importer replays
+ * messages on restart rather than losing them.
+ */
+void consume_loop(
+    RdKafka::KafkaConsumer* consumer,
+    RowToColumnLoader& row_loader,
+    const std::map<std::string,
+                   std::pair<std::unique_ptr<boost::regex>,
+                             std::unique_ptr<std::string>>>& transformations,
+    const Importer_NS::CopyParams& copy_params,
+    const bool remove_quotes) {
   size_t recv_rows = 0;
   int skipped = 0;
   int rows_loaded = 0;
   while (run) {
     RdKafka::Message* msg = consumer->consume(10000);
     if (msg->err() == RdKafka::ERR_NO_ERROR) {
-      if (!use_ccb) {
-        bool added =
-            msg_consume(msg, row_loader, copy_params, transformations, remove_quotes);
-        if (added) {
-          recv_rows++;
-          if (recv_rows == copy_params.batch_size) {
-            recv_rows = 0;
-            row_loader.do_load(rows_loaded, skipped, copy_params);
-            // make sure we now commit that we are up to here to cover the mesages we just
-            // loaded
-            consumer->commitSync();
-          }
-        } else {
-          // LOG(ERROR) << " messsage was skipped ";
-          skipped++;
+      bool added =
+          msg_consume(msg, row_loader, copy_params, transformations, remove_quotes);
+      if (added) {
+        recv_rows++;
+        if (recv_rows == copy_params.batch_size) {
+          recv_rows = 0;
+          row_loader.do_load(rows_loaded, skipped, copy_params);
+          // make sure we now commit that we are up to here to cover the mesages we just
+          // loaded
+          consumer->commitSync();
         }
+      } else {
+        // LOG(ERROR) << " messsage was skipped ";
+        skipped++;
       }
+    } else if (msg->err() == RdKafka::ERR__TIMED_OUT && recv_rows > 0) {
+      // topic went quiet - flush the partial batch rather than holding its
+      // rows and uncommitted offsets indefinitely
+      recv_rows = 0;
+      row_loader.do_load(rows_loaded, skipped, copy_params);
+      consumer->commitSync();
     }
     delete msg;
   }
+}
+
+// reads from a kafka topic (expects delimited string input); runs one consumer
+// thread per topic partition, each loading batches through its own connection
+void kafka_insert(
+    const ThriftClientConnection& conn_details,
+    const std::string& user_name,
+    const std::string& passwd,
+    const std::string& db_name,
+    const std::string& table_name,
+    const std::map<std::string,
+                   std::pair<std::unique_ptr<boost::regex>,
+                             std::unique_ptr<std::string>>>& transformations,
+    const Importer_NS::CopyParams& copy_params,
+    const bool remove_quotes,
+    std::string group_id,
+    std::string topic,
+    std::string brokers,
+    size_t consumer_threads) {
+  std::vector<std::string> topics;
+  topics.push_back(topic);
+
+  LOG(INFO) << "Version " << RdKafka::version_str().c_str();
+  LOG(INFO) << RdKafka::version();
+  LOG(INFO) << RdKafka::get_debug_contexts().c_str();
+
+  RebalanceCb first_rebalance_cb;
+  EventCb first_event_cb;
+  RdKafka::KafkaConsumer* first_consumer =
+      create_consumer(group_id, brokers, &first_rebalance_cb, &first_event_cb, true);
+
+  LOG(INFO) << " Created consumer " << first_consumer->name();
+
+  if (consumer_threads == 0) {
+    consumer_threads = get_topic_partition_count(first_consumer, topic);
+  }
+  LOG(INFO) << "Starting " << consumer_threads << " consumer thread(s) for topic "
+            << topic;
+
+  /*
+   * Subscribe to topics
+   */
+  RdKafka::ErrorCode err = first_consumer->subscribe(topics);
+  if (err) {
+    LOG(FATAL) << "Failed to subscribe to " << topics.size()
+               << " topics: " << RdKafka::err2str(err);
+  }
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < consumer_threads; ++i) {
+    workers.emplace_back([&]() {
+      RebalanceCb rebalance_cb;
+      EventCb event_cb;
+      RdKafka::KafkaConsumer* consumer =
+          create_consumer(group_id, brokers, &rebalance_cb, &event_cb, false);
+      LOG(INFO) << " Created consumer " << consumer->name();
+      RdKafka::ErrorCode worker_err = consumer->subscribe(topics);
+      if (worker_err) {
+        LOG(ERROR) << "Failed to subscribe to " << topics.size()
+                   << " topics: " << RdKafka::err2str(worker_err);
+        run = false;
+        delete consumer;
+        return;
+      }
+      RowToColumnLoader row_loader(conn_details, user_name, passwd, db_name, table_name);
+      consume_loop(consumer, row_loader, transformations, copy_params, remove_quotes);
+      consumer->close();
+      delete consumer;
+    });
+  }
+
+  RowToColumnLoader row_loader(conn_details, user_name, passwd, db_name, table_name);
+  consume_loop(first_consumer, row_loader, transformations, copy_params, remove_quotes);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
 
   /*
    * Stop consumer
    */
-  consumer->close();
-  delete consumer;
+  first_consumer->close();
+  delete first_consumer;
 
-  LOG(INFO) << "Consumed " << msg_cnt << " messages (" << msg_bytes << " bytes)";
+  LOG(INFO) << "Consumed " << msg_cnt.load() << " messages (" << msg_bytes.load()
+            << " bytes)";
   LOG(FATAL) << "Consumer shut down, probably due to an error please review logs";
 };
 
@@ -492,6 +570,7 @@ int main(int argc, char** argv) {
   size_t batch_size = 10000;
   size_t retry_count = 10;
   size_t retry_wait = 5;
+  size_t consumer_threads = 0;
   bool remove_quotes = false;
   std::vector<std::string> xforms;
   std::map<std::string,
@@ -563,6 +642,9 @@ int main(int argc, char** argv) {
   desc.add_options()("brokers",
                      po::value<std::string>(&brokers)->required(),
                      "list of kafka brokers for topic");
+  desc.add_options()("consumer-threads",
+                     po::value<size_t>(&consumer_threads)->default_value(consumer_threads),
+                     "Number of consumer threads (0 = one per topic partition)");
 
   po::positional_options_description positionalOptions;
   positionalOptions.add("table", 1);
@@ -722,15 +804,20 @@ int main(int argc, char** argv) {
 
   Importer_NS::CopyParams copy_params(
       delim, nulls, line_delim, batch_size, retry_count, retry_wait);
-  RowToColumnLoader row_loader(
-      ThriftClientConnection(
-          server_host, port, conn_type, skip_host_verify, ca_cert_name, ca_cert_name),
-      user_name,
-      passwd,
-      db_name,
-      table_name);
-
-  kafka_insert(
-      row_loader, transformations, copy_params, remove_quotes, group_id, topic, brokers);
+  ThriftClientConnection conn_details(
+      server_host, port, conn_type, skip_host_verify, ca_cert_name, ca_cert_name);
+
+  kafka_insert(conn_details,
+               user_name,
+               passwd,
+               db_name,
+               table_name,
+               transformations,
+               copy_params,
+               remove_quotes,
+               group_id,
+               topic,
+               brokers,
+               consumer_threads);
   return 0;
 }
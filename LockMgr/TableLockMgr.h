@@ -16,11 +16,15 @@
 
 #pragma once
 
+#include <Shared/Logger.h>
 #include <Shared/mapd_shared_mutex.h>
 #include <Shared/types.h>
 
+#include <array>
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "LockMgr.h"
@@ -42,14 +46,171 @@ LOCK_TYPE getLockForTableImpl(const Catalog_Namespace::Catalog& cat,
 
 namespace Lock_Namespace {
 
-using MutexType = mapd_shared_mutex;
+/**
+ * @type IntentLock
+ * @brief Hierarchical lock for a table. Statements still lock the whole table
+ * in shared (S) or exclusive (X) mode, but DML locks the table in
+ * intent-exclusive (IX) mode and exclusively locks only the fragments it
+ * rewrites, so UPDATE/DELETE statements touching disjoint fragments of the
+ * same table run concurrently. Mode compatibility follows the classic intent
+ * lock matrix:
+ *
+ *          IS    IX    S     X
+ *    IS    yes   yes   yes   no
+ *    IX    yes   yes   no    no
+ *    S     yes   no    yes   no
+ *    X     no    no    no    no
+ *
+ * S and X are exposed through the lock()/lock_shared() interface of
+ * mapd_shared_mutex, so the existing ReadLock/WriteLock guards keep working
+ * unchanged on top of this type.
+ */
+class IntentLock {
+ public:
+  void lock() { acquire(kExclusive); }
+  void unlock() { release(kExclusive); }
+  bool try_lock() { return tryAcquire(kExclusive); }
+
+  void lock_shared() { acquire(kShared); }
+  void unlock_shared() { release(kShared); }
+  bool try_lock_shared() { return tryAcquire(kShared); }
+
+  void lock_intent_shared() { acquire(kIntentShared); }
+  void unlock_intent_shared() { release(kIntentShared); }
+
+  void lock_intent_exclusive() { acquire(kIntentExclusive); }
+  void unlock_intent_exclusive() { release(kIntentExclusive); }
+
+ private:
+  enum Mode { kIntentShared, kIntentExclusive, kShared, kExclusive, kNumModes };
+
+  bool compatible(const Mode mode) const {
+    switch (mode) {
+      case kIntentShared:
+        return holders_[kExclusive] == 0;
+      case kIntentExclusive:
+        return holders_[kShared] == 0 && holders_[kExclusive] == 0;
+      case kShared:
+        return holders_[kIntentExclusive] == 0 && holders_[kExclusive] == 0;
+      case kExclusive:
+        return holders_[kIntentShared] == 0 && holders_[kIntentExclusive] == 0 &&
+               holders_[kShared] == 0 && holders_[kExclusive] == 0;
+      default:
+        return false;
+    }
+  }
+
+  void acquire(const Mode mode) {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    state_cv_.wait(lock, [this, mode] { return compatible(mode); });
+    ++holders_[mode];
+  }
+
+  bool tryAcquire(const Mode mode) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (!compatible(mode)) {
+      return false;
+    }
+    ++holders_[mode];
+    return true;
+  }
+
+  void release(const Mode mode) {
+    {
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      CHECK_GT(holders_[mode], 0);
+      --holders_[mode];
+    }
+    state_cv_.notify_all();
+  }
+
+  std::mutex state_mutex_;
+  std::condition_variable state_cv_;
+  std::array<int, kNumModes> holders_{{0, 0, 0, 0}};
+};
+
+/// RAII guard for the intent-exclusive mode of IntentLock; movable so it can
+/// be returned from the lock manager helpers and stored in TableLock.
+class IntentExclusiveLock {
+ public:
+  IntentExclusiveLock() : mutex_(nullptr) {}
+  explicit IntentExclusiveLock(IntentLock& mutex) : mutex_(&mutex) {
+    mutex_->lock_intent_exclusive();
+  }
+  IntentExclusiveLock(IntentExclusiveLock&& other) : mutex_(other.mutex_) {
+    other.mutex_ = nullptr;
+  }
+  IntentExclusiveLock& operator=(IntentExclusiveLock&& other) {
+    if (this != &other) {
+      reset();
+      mutex_ = other.mutex_;
+      other.mutex_ = nullptr;
+    }
+    return *this;
+  }
+  ~IntentExclusiveLock() { reset(); }
+  IntentExclusiveLock(const IntentExclusiveLock&) = delete;
+  IntentExclusiveLock& operator=(const IntentExclusiveLock&) = delete;
+
+ private:
+  void reset() {
+    if (mutex_) {
+      mutex_->unlock_intent_exclusive();
+      mutex_ = nullptr;
+    }
+  }
+
+  IntentLock* mutex_;
+};
+
+/// RAII guard for the intent-shared mode of IntentLock.
+class IntentSharedLock {
+ public:
+  IntentSharedLock() : mutex_(nullptr) {}
+  explicit IntentSharedLock(IntentLock& mutex) : mutex_(&mutex) {
+    mutex_->lock_intent_shared();
+  }
+  IntentSharedLock(IntentSharedLock&& other) : mutex_(other.mutex_) {
+    other.mutex_ = nullptr;
+  }
+  IntentSharedLock& operator=(IntentSharedLock&& other) {
+    if (this != &other) {
+      reset();
+      mutex_ = other.mutex_;
+      other.mutex_ = nullptr;
+    }
+    return *this;
+  }
+  ~IntentSharedLock() { reset(); }
+  IntentSharedLock(const IntentSharedLock&) = delete;
+  IntentSharedLock& operator=(const IntentSharedLock&) = delete;
+
+ private:
+  void reset() {
+    if (mutex_) {
+      mutex_->unlock_intent_shared();
+      mutex_ = nullptr;
+    }
+  }
+
+  IntentLock* mutex_;
+};
+
+using MutexType = IntentLock;
 
 using WriteLock = mapd_unique_lock<MutexType>;
 using ReadLock = mapd_shared_lock<MutexType>;
 
+// Fragment-level locks sit below the table intent modes and are plain
+// reader/writer mutexes.
+using FragmentMutexType = mapd_shared_mutex;
+using FragmentWriteLock = mapd_unique_lock<FragmentMutexType>;
+using FragmentReadLock = mapd_shared_lock<FragmentMutexType>;
+
 struct TableLock {
   WriteLock write_lock;
   ReadLock read_lock;
+  IntentExclusiveLock intent_exclusive_lock;
 };
 
 template <class T>
@@ -60,13 +221,25 @@ class TableLockMgrImpl {
     return table_mutex_map_[table_key];
   }
 
+  FragmentMutexType& getFragmentMutex(const ChunkKey table_key, const int fragment_id) {
+    std::lock_guard<std::mutex> access_map_lock(map_mutex_);
+    return fragment_mutex_map_[std::make_pair(table_key, fragment_id)];
+  }
+
   static void getTableLocks(const Catalog_Namespace::Catalog& cat,
                             const std::map<std::string, bool>& table_names,
                             std::vector<TableLock>& table_locks) {
     for (const auto& table_name_itr : table_names) {
       TableLock table_lock;
       if (table_name_itr.second) {
-        table_lock.write_lock = T::getWriteLockForTable(cat, table_name_itr.first);
+        // DML takes the table in intent-exclusive mode; the fragments it
+        // rewrites are locked exclusively underneath (see
+        // InsertOrderFragmenter::updateColumn), so statements writing
+        // disjoint fragments of the same table no longer serialize. SELECTs
+        // still take the table in shared mode, which conflicts with IX, so
+        // readers never observe in-place changes mid-flight.
+        table_lock.intent_exclusive_lock =
+            T::getIntentExclusiveLockForTable(cat, table_name_itr.first);
       } else {
         table_lock.read_lock = T::getReadLockForTable(cat, table_name_itr.first);
       }
@@ -101,11 +274,28 @@ class TableLockMgrImpl {
     return ReadLock(table_lock_mgr.getTableMutex(table_key));
   }
 
+  static IntentExclusiveLock getIntentExclusiveLockForTable(
+      const Catalog_Namespace::Catalog& cat,
+      const std::string& table_name) {
+    return Lock_Helpers::getLockForTableImpl<IntentExclusiveLock, T>(cat, table_name);
+  }
+  static IntentExclusiveLock getIntentExclusiveLockForTable(const ChunkKey table_key) {
+    auto& table_lock_mgr = T::instance();
+    return IntentExclusiveLock(table_lock_mgr.getTableMutex(table_key));
+  }
+
+  static FragmentWriteLock getWriteLockForFragment(const ChunkKey table_key,
+                                                   const int fragment_id) {
+    auto& table_lock_mgr = T::instance();
+    return FragmentWriteLock(table_lock_mgr.getFragmentMutex(table_key, fragment_id));
+  }
+
  protected:
   TableLockMgrImpl() {}
 
   std::mutex map_mutex_;
   std::map<ChunkKey, MutexType> table_mutex_map_;
+  std::map<std::pair<ChunkKey, int>, FragmentMutexType> fragment_mutex_map_;
 };
 
 class TableLockMgr : public TableLockMgrImpl<TableLockMgr> {
@@ -30,6 +30,9 @@
 
 #include "MapDRelease.h"
 
+#include "QueryEngine/AutoVacuum.h"
+#include "QueryEngine/DataRetention.h"
+#include "QueryEngine/PersistentCodeCache.h"
 #include "Shared/Logger.h"
 #include "Shared/MapDParameters.h"
 #include "Shared/file_delete.h"
@@ -58,6 +61,88 @@ unsigned send_timeout{300000};
 extern bool g_cache_string_hash;
 extern size_t g_leaf_count;
 extern bool g_skip_intermediate_count;
+extern bool g_enable_persistent_code_cache;
+extern bool g_enable_admission_control;
+extern size_t g_max_concurrent_small_queries;
+extern size_t g_compression_limit_bytes;
+extern std::string g_query_trace_dir;
+extern std::string g_low_priority_users;
+extern bool g_enable_dynamic_fragment_dispatch;
+extern bool g_enable_null_check_elision;
+extern bool g_enable_hybrid_execution;
+extern bool g_enable_cost_based_device_selection;
+extern bool g_enable_affinity_fragment_dispatch;
+extern double g_fragment_sample_rate;
+extern double g_pinned_table_mem_fraction;
+extern bool g_enable_chunk_prefetch;
+extern size_t g_arrow_stream_export_batch_rows;
+extern bool g_enable_spill_to_disk_reduction;
+extern bool g_enable_gpu_hash_table_cache;
+extern bool g_enable_batched_insert_checkpoints;
+extern size_t g_batched_insert_checkpoint_rows;
+extern size_t g_batched_insert_checkpoint_interval_ms;
+extern bool g_enable_insert_wal;
+extern size_t g_fragment_size_target_bytes;
+extern size_t g_insert_lanes;
+extern size_t g_spill_to_disk_reduction_min_bytes;
+extern bool g_enable_fragment_bloom_filters;
+extern size_t g_fragment_bloom_filter_max_bytes;
+extern bool g_enable_calcite_plan_cache;
+extern size_t g_calcite_plan_cache_max_entries;
+extern bool g_enable_numa_interleaved_cpu_buffers;
+extern bool g_enable_pinned_cpu_buffers;
+extern bool g_enable_io_uring_reads;
+extern size_t g_io_uring_queue_depth;
+extern size_t g_gpu_smem_group_by_max_entries;
+extern bool g_enable_join_build_range_pruning;
+extern bool g_enable_expression_range_pruning;
+extern bool g_enable_parallel_result_set_sort;
+extern bool g_enable_external_sort;
+extern size_t g_external_sort_run_budget;
+extern bool g_enable_metadata_only_aggregates;
+extern bool g_enable_query_result_cache;
+extern bool g_enable_eager_step_result_release;
+extern bool g_enable_runtime_filter_propagation;
+extern bool g_enable_expression_interning;
+extern bool g_enable_codegen_cse;
+extern bool g_enable_connect_credential_cache;
+extern bool g_enable_parallel_window_partition_sort;
+extern bool g_enable_parallel_window_partition_compute;
+extern bool g_enable_sparse_count_distinct;
+extern bool g_enable_cpu_multifrag_kernels;
+extern size_t g_cpu_multifrag_batch_size;
+extern bool g_enable_auto_vacuum;
+extern size_t g_auto_vacuum_interval_seconds;
+extern double g_auto_vacuum_dirty_fragment_fraction;
+extern bool g_enable_data_retention;
+extern size_t g_data_retention_interval_seconds;
+extern bool g_enable_string_dict_index_cache;
+extern bool g_enable_folded_dict_index;
+extern bool g_enable_sorted_dict_cache;
+extern bool g_enable_gpu_mem_reservation;
+extern bool g_enable_gpu_managed_memory;
+extern bool g_enable_chunk_cache_warming;
+extern size_t g_chunk_cache_warming_num_chunks;
+extern size_t g_chunk_cache_warming_bandwidth_mb_per_sec;
+extern bool g_enable_sorted_fragment_pruning;
+extern bool g_enable_tiered_cpu_jit;
+extern bool g_enable_cpu_vectorization;
+extern bool g_enable_parallel_device_reduction;
+extern bool g_enable_streaming_reduction;
+extern bool g_enable_lean_projection_buffers;
+extern bool g_enable_reduction_occupancy_bitmap;
+extern unsigned g_dynamic_watchdog_check_interval;
+extern size_t g_cpu_mem_budget_bytes;
+extern size_t g_cpu_query_mem_budget_bytes;
+extern bool g_enable_gpu_stream_overlap;
+namespace File_Namespace {
+extern bool g_enable_disk_chunk_compression;
+extern bool g_enable_vectored_page_writes;
+extern size_t g_chunk_extent_pages;
+extern size_t g_data_file_pages;
+extern size_t g_checkpoint_sync_threads;
+extern bool g_enable_incremental_checkpoints;
+}  // namespace File_Namespace
 
 bool g_enable_thrift_logs{false};
 
@@ -334,6 +419,37 @@ void MapDProgramOptions::fillOptions() {
                           po::value<size_t>(&mapd_parameters.cpu_buffer_mem_bytes)
                               ->default_value(mapd_parameters.cpu_buffer_mem_bytes),
                           "Size of memory reserved for CPU buffers, in bytes.");
+  help_desc.add_options()("cpu-slab-size-bytes",
+                          po::value<size_t>(&mapd_parameters.cpu_slab_size_bytes)
+                              ->default_value(mapd_parameters.cpu_slab_size_bytes),
+                          "Size of each CPU buffer pool slab, in bytes. 0 uses the "
+                          "default geometry.");
+  help_desc.add_options()(
+      "cpu-buffer-huge-page-size",
+      po::value<size_t>(&mapd_parameters.cpu_buffer_huge_page_size)
+          ->default_value(mapd_parameters.cpu_buffer_huge_page_size),
+      "Back CPU buffer pool slabs with explicit huge pages of this size, in "
+      "bytes (e.g. 2097152 or 1073741824), reducing TLB misses on large "
+      "scans. Requires reserved huge pages (/proc/sys/vm/nr_hugepages). 0 "
+      "uses normal pages.");
+  help_desc.add_options()(
+      "pinned-table-mem-fraction",
+      po::value<double>(&g_pinned_table_mem_fraction)
+          ->default_value(g_pinned_table_mem_fraction),
+      "Fraction of each buffer pool tables with CACHE_POLICY='PIN' may occupy "
+      "before their chunks become evictable again.");
+  help_desc.add_options()("nvme-cache-path",
+                          po::value<std::string>(&mapd_parameters.nvme_cache_path)
+                              ->default_value(mapd_parameters.nvme_cache_path),
+                          "Directory on local flash for a read-through chunk cache "
+                          "between the disk level and the CPU buffer pool. Useful when "
+                          "the data directory lives on slow network storage. Empty "
+                          "disables the cache.");
+  help_desc.add_options()("nvme-cache-size-bytes",
+                          po::value<size_t>(&mapd_parameters.nvme_cache_size_bytes)
+                              ->default_value(mapd_parameters.nvme_cache_size_bytes),
+                          "Maximum size of the NVMe chunk cache, in bytes. Required "
+                          "(non-zero) for nvme-cache-path to take effect.");
   help_desc.add_options()(
       "cpu-only",
       po::value<bool>(&cpu_only)->default_value(cpu_only)->implicit_value(true),
@@ -424,6 +540,11 @@ void MapDProgramOptions::fillOptions() {
                           po::value<size_t>(&mapd_parameters.gpu_buffer_mem_bytes)
                               ->default_value(mapd_parameters.gpu_buffer_mem_bytes),
                           "Size of memory reserved for GPU buffers, in bytes, per GPU.");
+  help_desc.add_options()("gpu-slab-size-bytes",
+                          po::value<size_t>(&mapd_parameters.gpu_slab_size_bytes)
+                              ->default_value(mapd_parameters.gpu_slab_size_bytes),
+                          "Size of each GPU buffer pool slab, in bytes. 0 uses the "
+                          "default geometry.");
   help_desc.add_options()("gpu-input-mem-limit",
                           po::value<double>(&mapd_parameters.gpu_input_mem_limit)
                               ->default_value(mapd_parameters.gpu_input_mem_limit),
@@ -449,6 +570,21 @@ void MapDProgramOptions::fillOptions() {
                           "Enable/disable inner join fragment skipping. This feature is "
                           "considered stable and is enabled by default. This "
                           "parameter will be removed in a future release.");
+  help_desc.add_options()(
+      "low-priority-users",
+      po::value<std::string>(&g_low_priority_users)
+          ->default_value(g_low_priority_users),
+      "Comma-separated list of users whose queries run at low priority: they "
+      "wait for other queries when competing for execution slots and yield "
+      "the devices between fragment kernels. Intended for ETL service "
+      "accounts.");
+  help_desc.add_options()(
+      "max-concurrent-queries",
+      po::value<size_t>(&mapd_parameters.max_concurrent_queries)
+          ->default_value(mapd_parameters.max_concurrent_queries),
+      "Maximum number of queries executing concurrently; additional queries "
+      "wait for a free slot. Metadata calls are not throttled. 0 means "
+      "unbounded.");
   help_desc.add_options()(
       "max-session-duration",
       po::value<int>(&max_session_duration)->default_value(max_session_duration),
@@ -519,12 +655,567 @@ void MapDProgramOptions::fillAdvancedOptions() {
           ->implicit_value(true),
       "Enable additional calcite (query plan) optimizations when a view is part of the "
       "query.");
+  developer_desc.add_options()(
+      "enable-calcite-plan-cache",
+      po::value<bool>(&g_enable_calcite_plan_cache)
+          ->default_value(g_enable_calcite_plan_cache)
+          ->implicit_value(true),
+      "Cache Calcite plans keyed by catalog and query text so repeated queries "
+      "skip the planner; invalidated by DDL.");
+  developer_desc.add_options()(
+      "calcite-plan-cache-max-entries",
+      po::value<size_t>(&g_calcite_plan_cache_max_entries)
+          ->default_value(g_calcite_plan_cache_max_entries),
+      "Maximum number of entries in the Calcite plan cache.");
+  developer_desc.add_options()(
+      "enable-calcite-jni",
+      po::value<bool>(&mapd_parameters.enable_calcite_jni)
+          ->default_value(mapd_parameters.enable_calcite_jni)
+          ->implicit_value(true),
+      "Run the Calcite planner in an embedded JVM over JNI instead of a separate "
+      "java process reached over thrift. Requires a build with ENABLE_CALCITE_JNI.");
+  developer_desc.add_options()(
+      "enable-numa-interleaved-cpu-buffers",
+      po::value<bool>(&g_enable_numa_interleaved_cpu_buffers)
+          ->default_value(g_enable_numa_interleaved_cpu_buffers)
+          ->implicit_value(true),
+      "Interleave CPU buffer pool slab pages across NUMA nodes so multi-socket "
+      "scans get balanced memory bandwidth instead of first-touch placement.");
+  developer_desc.add_options()(
+      "enable-pinned-cpu-buffers",
+      po::value<bool>(&g_enable_pinned_cpu_buffers)
+          ->default_value(g_enable_pinned_cpu_buffers)
+          ->implicit_value(true),
+      "Allocate CPU buffer pool slabs as CUDA pinned host memory so "
+      "host-to-device chunk transfers run at full PCIe bandwidth.");
+  developer_desc.add_options()(
+      "enable-gpu-mem-reservation",
+      po::value<bool>(&g_enable_gpu_mem_reservation)
+          ->default_value(g_enable_gpu_mem_reservation)
+          ->implicit_value(true),
+      "Admit each query's estimated GPU output buffer footprint against "
+      "per-device memory budgets before launching kernels, punting queries "
+      "that don't fit to CPU instead of evicting other queries' chunks.");
+  developer_desc.add_options()(
+      "enable-gpu-managed-memory",
+      po::value<bool>(&g_enable_gpu_managed_memory)
+          ->default_value(g_enable_gpu_managed_memory)
+          ->implicit_value(true),
+      "Back GPU buffer pool slabs that no longer fit in device memory with "
+      "CUDA managed memory instead of failing the slab, so working sets "
+      "slightly over device capacity degrade gradually rather than falling "
+      "back to CPU. Use with gpu-buffer-mem-bytes above device memory.");
+  developer_desc.add_options()(
+      "enable-chunk-cache-warming",
+      po::value<bool>(&g_enable_chunk_cache_warming)
+          ->default_value(g_enable_chunk_cache_warming)
+          ->implicit_value(true),
+      "Record per-chunk access frequencies, persist the heat map in the data "
+      "directory and prefetch the hottest chunks into the CPU buffer pool in "
+      "the background on startup and after clear_cpu_memory.");
+  developer_desc.add_options()(
+      "chunk-cache-warming-num-chunks",
+      po::value<size_t>(&g_chunk_cache_warming_num_chunks)
+          ->default_value(g_chunk_cache_warming_num_chunks),
+      "Maximum number of chunks prefetched by a chunk cache warming pass.");
+  developer_desc.add_options()(
+      "chunk-cache-warming-bandwidth-mb-per-sec",
+      po::value<size_t>(&g_chunk_cache_warming_bandwidth_mb_per_sec)
+          ->default_value(g_chunk_cache_warming_bandwidth_mb_per_sec),
+      "Disk read bandwidth budget for chunk cache warming, in MB/s, so the "
+      "warming pass doesn't starve foreground queries. 0 removes the cap.");
+  developer_desc.add_options()(
+      "enable-parallel-device-reduction",
+      po::value<bool>(&g_enable_parallel_device_reduction)
+          ->default_value(g_enable_parallel_device_reduction)
+          ->implicit_value(true),
+      "Reduce per-device group-by results in pairwise tree order across "
+      "threads instead of a sequential chain, cutting the merge critical "
+      "path on multi-GPU servers.");
+  developer_desc.add_options()(
+      "enable-streaming-reduction",
+      po::value<bool>(&g_enable_streaming_reduction)
+          ->default_value(g_enable_streaming_reduction)
+          ->implicit_value(true),
+      "Reduce each kernel's group-by buffer into the running result as soon "
+      "as the kernel finishes, overlapping reduction with the kernels still "
+      "executing instead of merging everything after the last one.");
+  developer_desc.add_options()(
+      "enable-lean-projection-buffers",
+      po::value<bool>(&g_enable_lean_projection_buffers)
+          ->default_value(g_enable_lean_projection_buffers)
+          ->implicit_value(true),
+      "Size each projection kernel's output buffer by the rows the kernel "
+      "actually scans instead of the query-wide worst case, so selective "
+      "filters over large tables no longer allocate the full scan size per "
+      "kernel.");
+  developer_desc.add_options()(
+      "enable-reduction-occupancy-bitmap",
+      po::value<bool>(&g_enable_reduction_occupancy_bitmap)
+          ->default_value(g_enable_reduction_occupancy_bitmap)
+          ->implicit_value(true),
+      "Append an occupancy bitmap to row-wise perfect hash group-by buffers "
+      "on CPU so result reduction and iteration skip runs of empty entries "
+      "instead of walking every slot of a sparse key range.");
+  developer_desc.add_options()(
+      "cpu-mem-budget-bytes",
+      po::value<size_t>(&g_cpu_mem_budget_bytes)
+          ->default_value(g_cpu_mem_budget_bytes),
+      "Cap on the total metered CPU query memory (result sets, columnar "
+      "conversions and per-query scratch) across all queries, in bytes. "
+      "Reservations beyond the cap fail with an out-of-memory error before "
+      "the host starts swapping. 0 disables the cap.");
+  developer_desc.add_options()(
+      "cpu-query-mem-budget-bytes",
+      po::value<size_t>(&g_cpu_query_mem_budget_bytes)
+          ->default_value(g_cpu_query_mem_budget_bytes),
+      "Cap on the metered CPU memory a single query may hold, in bytes, so "
+      "one runaway query can't exhaust the process-wide budget. 0 disables "
+      "the cap.");
+  developer_desc.add_options()(
+      "dynamic-watchdog-check-interval",
+      po::value<unsigned>(&g_dynamic_watchdog_check_interval)
+          ->default_value(g_dynamic_watchdog_check_interval),
+      "Rows between two dynamic watchdog deadline probes in generated CPU "
+      "code, rounded down to a power of two. Larger values cut the probe "
+      "overhead on long scans at the cost of coarser timeout detection.");
+  developer_desc.add_options()(
+      "enable-gpu-stream-overlap",
+      po::value<bool>(&g_enable_gpu_stream_overlap)
+          ->default_value(g_enable_gpu_stream_overlap)
+          ->implicit_value(true),
+      "Launch each GPU kernel on its own non-blocking CUDA stream so kernel "
+      "execution overlaps the result copy-back of concurrently dispatched "
+      "kernels on the same device. Ignored when the dynamic watchdog is "
+      "enabled.");
+  developer_desc.add_options()(
+      "enable-tiered-cpu-jit",
+      po::value<bool>(&g_enable_tiered_cpu_jit)
+          ->default_value(g_enable_tiered_cpu_jit)
+          ->implicit_value(true),
+      "Compile CPU kernels without IR optimization on first execution and "
+      "reoptimize them in the background, so ad-hoc queries don't wait on the "
+      "full optimization pipeline while repeated runs keep optimized code.");
+  developer_desc.add_options()(
+      "enable-cpu-vectorization",
+      po::value<bool>(&g_enable_cpu_vectorization)
+          ->default_value(g_enable_cpu_vectorization)
+          ->implicit_value(true),
+      "Run LLVM's loop and SLP vectorizers over compiled CPU kernels and "
+      "target the host CPU's instruction set instead of the generic one.");
+  developer_desc.add_options()(
+      "enable-sorted-fragment-pruning",
+      po::value<bool>(&g_enable_sorted_fragment_pruning)
+          ->default_value(g_enable_sorted_fragment_pruning)
+          ->implicit_value(true),
+      "Binary-search the fragment list of tables created with a sort column "
+      "for range predicates on that column, instead of testing every "
+      "fragment's metadata. Assumes fragments stay ordered on the sort "
+      "column.");
+  developer_desc.add_options()(
+      "enable-io-uring-reads",
+      po::value<bool>(&g_enable_io_uring_reads)
+          ->default_value(g_enable_io_uring_reads)
+          ->implicit_value(true),
+      "Batch the page reads of a chunk into io_uring submissions instead of "
+      "synchronous per-page reads. Requires a Linux kernel with io_uring "
+      "support; falls back to the synchronous path otherwise.");
+  developer_desc.add_options()(
+      "io-uring-queue-depth",
+      po::value<size_t>(&g_io_uring_queue_depth)
+          ->default_value(g_io_uring_queue_depth),
+      "Maximum number of in-flight io_uring page reads per chunk.");
   developer_desc.add_options()(
       "enable-columnar-output",
       po::value<bool>(&g_enable_columnar_output)
           ->default_value(g_enable_columnar_output)
           ->implicit_value(true),
       "Enable columnar output for intermediate/final query steps.");
+  developer_desc.add_options()(
+      "arrow-stream-export-batch-rows",
+      po::value<size_t>(&g_arrow_stream_export_batch_rows)
+          ->default_value(g_arrow_stream_export_batch_rows),
+      "When non-zero, serialize CPU Arrow data frame exports as an IPC stream "
+      "of record batches of at most this many rows instead of one monolithic "
+      "record batch. Requires clients that read the Arrow stream format.");
+  developer_desc.add_options()(
+      "enable-disk-chunk-compression",
+      po::value<bool>(&File_Namespace::g_enable_disk_chunk_compression)
+          ->default_value(File_Namespace::g_enable_disk_chunk_compression)
+          ->implicit_value(true),
+      "Compress chunk data pages on disk, decompressing transparently on read. "
+      "Only valid for data directories created with this flag enabled.");
+  developer_desc.add_options()(
+      "enable-vectored-page-writes",
+      po::value<bool>(&File_Namespace::g_enable_vectored_page_writes)
+          ->default_value(File_Namespace::g_enable_vectored_page_writes)
+          ->implicit_value(true),
+      "Coalesce multi-page chunk appends into one large sequential write per "
+      "run of file-contiguous pages instead of two syscalls per page.");
+  developer_desc.add_options()(
+      "chunk-extent-pages",
+      po::value<size_t>(&File_Namespace::g_chunk_extent_pages)
+          ->default_value(File_Namespace::g_chunk_extent_pages),
+      "Number of file-contiguous pages a chunk reserves at a time once it "
+      "grows past one page, keeping sequential fragment scans physically "
+      "sequential on disk. 1 disables extent reservation.");
+  developer_desc.add_options()(
+      "data-file-pages",
+      po::value<size_t>(&File_Namespace::g_data_file_pages)
+          ->default_value(File_Namespace::g_data_file_pages),
+      "Pages per table data file; larger values reduce the file count of big "
+      "table directories.");
+  developer_desc.add_options()(
+      "checkpoint-sync-threads",
+      po::value<size_t>(&File_Namespace::g_checkpoint_sync_threads)
+          ->default_value(File_Namespace::g_checkpoint_sync_threads),
+      "Number of threads fsyncing data files in parallel at checkpoint. 1 "
+      "keeps the serial sync loop.");
+  developer_desc.add_options()(
+      "enable-incremental-checkpoints",
+      po::value<bool>(&File_Namespace::g_enable_incremental_checkpoints)
+          ->default_value(File_Namespace::g_enable_incremental_checkpoints)
+          ->implicit_value(true),
+      "Skip the checkpoint fsync pass for tables with no dirty chunks and no "
+      "deferred page frees, so only tables that actually advanced stall.");
+  developer_desc.add_options()(
+      "enable-chunk-prefetch",
+      po::value<bool>(&g_enable_chunk_prefetch)
+          ->default_value(g_enable_chunk_prefetch)
+          ->implicit_value(true),
+      "Asynchronously read the chunks of upcoming kernels into the CPU buffer "
+      "pool while earlier kernels execute.");
+  developer_desc.add_options()(
+      "enable-batched-insert-checkpoints",
+      po::value<bool>(&g_enable_batched_insert_checkpoints)
+          ->default_value(g_enable_batched_insert_checkpoints)
+          ->implicit_value(true),
+      "Batch the per-insert checkpoints of streaming inserts; rows stay "
+      "immediately scannable but durability is deferred until the row or time "
+      "threshold is reached, so a crash can lose the last batch.");
+  developer_desc.add_options()(
+      "batched-insert-checkpoint-rows",
+      po::value<size_t>(&g_batched_insert_checkpoint_rows)
+          ->default_value(g_batched_insert_checkpoint_rows),
+      "Number of inserted rows which triggers a batched checkpoint.");
+  developer_desc.add_options()(
+      "batched-insert-checkpoint-interval-ms",
+      po::value<size_t>(&g_batched_insert_checkpoint_interval_ms)
+          ->default_value(g_batched_insert_checkpoint_interval_ms),
+      "Maximum time between batched insert checkpoints.");
+  developer_desc.add_options()(
+      "enable-insert-wal",
+      po::value<bool>(&g_enable_insert_wal)
+          ->default_value(g_enable_insert_wal)
+          ->implicit_value(true),
+      "Log insert batches with a deferred checkpoint to a per-database "
+      "write-ahead log and replay them on startup, closing the crash loss "
+      "window of batched insert checkpoints.");
+  developer_desc.add_options()(
+      "fragment-size-target-bytes",
+      po::value<size_t>(&g_fragment_size_target_bytes)
+          ->default_value(g_fragment_size_target_bytes),
+      "Derive the fragment row count of tables using the default fragment_size "
+      "from this byte budget and the table's physical row width instead of a "
+      "fixed row count. Zero disables byte-driven fragment sizing.");
+  developer_desc.add_options()(
+      "insert-lanes",
+      po::value<size_t>(&g_insert_lanes)->default_value(g_insert_lanes),
+      "Number of independently appendable insert tails per table. With more "
+      "than one lane, concurrent insert statements append to different "
+      "fragments in parallel instead of serializing on the table's single "
+      "insert buffer, at the cost of up to lanes-1 partially filled fragments.");
+  developer_desc.add_options()(
+      "enable-gpu-hash-table-cache",
+      po::value<bool>(&g_enable_gpu_hash_table_cache)
+          ->default_value(g_enable_gpu_hash_table_cache)
+          ->implicit_value(true),
+      "Keep built join hash tables resident in GPU memory and reuse them across "
+      "queries; invalidated on table update, delete or epoch change.");
+  developer_desc.add_options()(
+      "enable-spill-to-disk-reduction",
+      po::value<bool>(&g_enable_spill_to_disk_reduction)
+          ->default_value(g_enable_spill_to_disk_reduction)
+          ->implicit_value(true),
+      "Spill partial GROUP BY results to disk during reduction and merge them "
+      "back one at a time, bounding the peak memory of high-cardinality "
+      "aggregations.");
+  developer_desc.add_options()(
+      "spill-to-disk-reduction-min-bytes",
+      po::value<size_t>(&g_spill_to_disk_reduction_min_bytes)
+          ->default_value(g_spill_to_disk_reduction_min_bytes),
+      "Combined partial result size above which spill-to-disk reduction kicks in.");
+  developer_desc.add_options()(
+      "enable-fragment-bloom-filters",
+      po::value<bool>(&g_enable_fragment_bloom_filters)
+          ->default_value(g_enable_fragment_bloom_filters)
+          ->implicit_value(true),
+      "Build per-fragment bloom filters on integer columns and use them to skip "
+      "fragments for equality predicates the min/max stats cannot prune.");
+  developer_desc.add_options()(
+      "fragment-bloom-filter-max-bytes",
+      po::value<size_t>(&g_fragment_bloom_filter_max_bytes)
+          ->default_value(g_fragment_bloom_filter_max_bytes),
+      "Memory budget for the fragment bloom filter cache.");
+  developer_desc.add_options()(
+      "enable-join-build-range-pruning",
+      po::value<bool>(&g_enable_join_build_range_pruning)
+          ->default_value(g_enable_join_build_range_pruning)
+          ->implicit_value(true),
+      "Skip probe-side fragments of inner hash joins whose metadata range "
+      "cannot intersect the build-side join key range.");
+  developer_desc.add_options()(
+      "enable-expression-range-pruning",
+      po::value<bool>(&g_enable_expression_range_pruning)
+          ->default_value(g_enable_expression_range_pruning)
+          ->implicit_value(true),
+      "Skip fragments for predicates on derived expressions (extract, "
+      "date_trunc, floor/ceil, arithmetic) by bounding the expression over "
+      "each fragment's chunk metadata.");
+  developer_desc.add_options()(
+      "enable-parallel-result-set-sort",
+      po::value<bool>(&g_enable_parallel_result_set_sort)
+          ->default_value(g_enable_parallel_result_set_sort)
+          ->implicit_value(true),
+      "Sort full (non top-k) single-column numeric ORDER BY results with "
+      "extracted keys across multiple threads instead of a single-threaded "
+      "comparator sort.");
+  developer_desc.add_options()(
+      "enable-parallel-window-partition-sort",
+      po::value<bool>(&g_enable_parallel_window_partition_sort)
+          ->default_value(g_enable_parallel_window_partition_sort)
+          ->implicit_value(true),
+      "Sort window function partitions across multiple threads instead of one "
+      "partition at a time.");
+  developer_desc.add_options()(
+      "enable-parallel-window-partition-compute",
+      po::value<bool>(&g_enable_parallel_window_partition_compute)
+          ->default_value(g_enable_parallel_window_partition_compute)
+          ->implicit_value(true),
+      "Compute window function values across partitions in parallel; implies "
+      "the parallel partition sort. Functions requiring peer row handling "
+      "stay sequential.");
+  developer_desc.add_options()(
+      "enable-external-sort",
+      po::value<bool>(&g_enable_external_sort)
+          ->default_value(g_enable_external_sort)
+          ->implicit_value(true),
+      "Sort large ORDER BY results as bounded-size runs merged by a streaming "
+      "k-way heap instead of one monolithic sort, and let such sorts proceed "
+      "past the watchdog result size limit.");
+  developer_desc.add_options()(
+      "external-sort-run-budget",
+      po::value<size_t>(&g_external_sort_run_budget)
+          ->default_value(g_external_sort_run_budget),
+      "Memory budget in bytes for each sorted run of an external sort.");
+  developer_desc.add_options()(
+      "enable-metadata-only-aggregates",
+      po::value<bool>(&g_enable_metadata_only_aggregates)
+          ->default_value(g_enable_metadata_only_aggregates)
+          ->implicit_value(true),
+      "Answer unfiltered COUNT(*), MIN and MAX queries from fragment metadata "
+      "instead of scanning, falling back to a scan for tables with deleted "
+      "rows or update-widened chunk stats.");
+  developer_desc.add_options()(
+      "enable-query-result-cache",
+      po::value<bool>(&g_enable_query_result_cache)
+          ->default_value(g_enable_query_result_cache)
+          ->implicit_value(true),
+      "Cache small query results keyed by the execution unit and the table and "
+      "string dictionary generations of its inputs; entries stop matching as "
+      "soon as any input table changes.");
+  developer_desc.add_options()(
+      "enable-eager-step-result-release",
+      po::value<bool>(&g_enable_eager_step_result_release)
+          ->default_value(g_enable_eager_step_result_release)
+          ->implicit_value(true),
+      "Release each execution step's intermediate result buffers as soon as "
+      "the last step reading them has run, instead of holding every step's "
+      "result until the whole query finishes.");
+  developer_desc.add_options()(
+      "enable-runtime-filter-propagation",
+      po::value<bool>(&g_enable_runtime_filter_propagation)
+          ->default_value(g_enable_runtime_filter_propagation)
+          ->implicit_value(true),
+      "Derive range filters on the physical side of inner equijoins against "
+      "intermediate results, so the selectivity of a completed step prunes "
+      "fragments of downstream scans.");
+  developer_desc.add_options()(
+      "enable-expression-interning",
+      po::value<bool>(&g_enable_expression_interning)
+          ->default_value(g_enable_expression_interning)
+          ->implicit_value(true),
+      "Memoize scalar expression translation so repeated subexpressions in "
+      "wide projections share a single analyzer expression instead of being "
+      "re-translated for every occurrence.");
+  developer_desc.add_options()(
+      "enable-codegen-cse",
+      po::value<bool>(&g_enable_codegen_cse)
+          ->default_value(g_enable_codegen_cse)
+          ->implicit_value(true),
+      "Eliminate common subexpressions during code generation, computing "
+      "repeated scalar subexpressions once per row.");
+  developer_desc.add_options()(
+      "enable-connect-credential-cache",
+      po::value<bool>(&g_enable_connect_credential_cache)
+          ->default_value(g_enable_connect_credential_cache)
+          ->implicit_value(true),
+      "Cache a salted digest of credentials that passed password verification "
+      "so clients which reconnect per request skip the slow check. Disable "
+      "when passwords are managed by an external provider (LDAP/REST), whose "
+      "changes the server cannot observe.");
+  developer_desc.add_options()(
+      "enable-sparse-count-distinct",
+      po::value<bool>(&g_enable_sparse_count_distinct)
+          ->default_value(g_enable_sparse_count_distinct)
+          ->implicit_value(true),
+      "Use a compressed bitmap for exact COUNT DISTINCT over wide value ranges, "
+      "allocating only the 64K-bit containers which see a value. CPU only.");
+  developer_desc.add_options()(
+      "enable-cpu-multifrag-kernels",
+      po::value<bool>(&g_enable_cpu_multifrag_kernels)
+          ->default_value(g_enable_cpu_multifrag_kernels)
+          ->implicit_value(true),
+      "Batch multiple fragments into each CPU kernel for aggregate queries to "
+      "amortize per-kernel setup over many small fragments.");
+  developer_desc.add_options()(
+      "cpu-multifrag-batch-size",
+      po::value<size_t>(&g_cpu_multifrag_batch_size)
+          ->default_value(g_cpu_multifrag_batch_size),
+      "Number of fragments batched into each CPU kernel when CPU multifrag "
+      "kernels are enabled.");
+  developer_desc.add_options()(
+      "enable-auto-vacuum",
+      po::value<bool>(&g_enable_auto_vacuum)
+          ->default_value(g_enable_auto_vacuum)
+          ->implicit_value(true),
+      "Run a background thread which vacuums deleted rows and recomputes "
+      "metadata for tables with enough fragments showing deletions, using the "
+      "same locks as OPTIMIZE TABLE.");
+  developer_desc.add_options()(
+      "auto-vacuum-interval-seconds",
+      po::value<size_t>(&g_auto_vacuum_interval_seconds)
+          ->default_value(g_auto_vacuum_interval_seconds),
+      "Seconds the auto vacuum thread sleeps between scans of the catalogs.");
+  developer_desc.add_options()(
+      "auto-vacuum-dirty-fragment-fraction",
+      po::value<double>(&g_auto_vacuum_dirty_fragment_fraction)
+          ->default_value(g_auto_vacuum_dirty_fragment_fraction),
+      "Fraction of a table's fragments with deleted rows before auto vacuum "
+      "compacts the table.");
+  developer_desc.add_options()(
+      "enable-data-retention",
+      po::value<bool>(&g_enable_data_retention)
+          ->default_value(g_enable_data_retention)
+          ->implicit_value(true),
+      "Run a background thread which ages out expired rows of tables declared "
+      "with RETENTION_COLUMN/RETENTION_SECONDS by dropping whole fragments.");
+  developer_desc.add_options()(
+      "data-retention-interval-seconds",
+      po::value<size_t>(&g_data_retention_interval_seconds)
+          ->default_value(g_data_retention_interval_seconds),
+      "Seconds the data retention thread sleeps between scans of the catalogs.");
+  developer_desc.add_options()(
+      "enable-string-dict-index-cache",
+      po::value<bool>(&g_enable_string_dict_index_cache)
+          ->default_value(g_enable_string_dict_index_cache)
+          ->implicit_value(true),
+      "Persist each string dictionary's hash index at checkpoint and restore "
+      "it at startup instead of rebuilding it from the payload file.");
+  developer_desc.add_options()(
+      "enable-folded-dict-index",
+      po::value<bool>(&g_enable_folded_dict_index)
+          ->default_value(g_enable_folded_dict_index)
+          ->implicit_value(true),
+      "Resolve ILIKE equality and prefix patterns against dictionary columns "
+      "through a lazily built case-folded index instead of scanning the whole "
+      "dictionary. Costs roughly one folded copy of each dictionary queried "
+      "this way in memory.");
+  developer_desc.add_options()(
+      "enable-sorted-dict-cache",
+      po::value<bool>(&g_enable_sorted_dict_cache)
+          ->default_value(g_enable_sorted_dict_cache)
+          ->implicit_value(true),
+      "Persist each string dictionary's sorted-id permutation at checkpoint "
+      "and restore it at startup, so range predicates and ORDER BY on "
+      "dictionary columns do not re-sort the dictionary after a restart.");
+  developer_desc.add_options()(
+      "enable-dynamic-fragment-dispatch",
+      po::value<bool>(&g_enable_dynamic_fragment_dispatch)
+          ->default_value(g_enable_dynamic_fragment_dispatch)
+          ->implicit_value(true),
+      "Dispatch per-fragment kernels to GPUs with work stealing instead of a "
+      "static fragment-to-device assignment.");
+  developer_desc.add_options()(
+      "enable-null-check-elision",
+      po::value<bool>(&g_enable_null_check_elision)
+          ->default_value(g_enable_null_check_elision)
+          ->implicit_value(true),
+      "Skip per-value null sentinel checks in generated arithmetic when chunk "
+      "metadata proves no scanned fragment contains nulls.");
+  developer_desc.add_options()(
+      "enable-affinity-fragment-dispatch",
+      po::value<bool>(&g_enable_affinity_fragment_dispatch)
+          ->default_value(g_enable_affinity_fragment_dispatch)
+          ->implicit_value(true),
+      "Assign each fragment to the GPU already caching its chunks instead of "
+      "the static round-robin device assignment, unless that device carries "
+      "more than twice its fair share of the work.");
+  developer_desc.add_options()(
+      "fragment-sample-rate",
+      po::value<double>(&g_fragment_sample_rate)
+          ->default_value(g_fragment_sample_rate),
+      "Fraction of each table's fragments scanned by single table aggregate "
+      "queries, stratified by shard; the covered tuple fraction is returned "
+      "with the result so clients can scale additive aggregates. 0 disables "
+      "sampling and keeps results exact.");
+  developer_desc.add_options()(
+      "enable-hybrid-execution",
+      po::value<bool>(&g_enable_hybrid_execution)
+          ->default_value(g_enable_hybrid_execution)
+          ->implicit_value(true),
+      "Run scan-bound GPU queries on the CPU cores as well: CPU workers pull "
+      "fragment kernels from the same work stealing list as the GPUs.");
+  developer_desc.add_options()(
+      "enable-cost-based-device-selection",
+      po::value<bool>(&g_enable_cost_based_device_selection)
+          ->default_value(g_enable_cost_based_device_selection)
+          ->implicit_value(true),
+      "Pick CPU vs GPU per query step from estimated transfer and kernel "
+      "cost, corrected by measured execution times, instead of defaulting "
+      "to GPU.");
+  developer_desc.add_options()(
+      "enable-admission-control",
+      po::value<bool>(&g_enable_admission_control)
+          ->default_value(g_enable_admission_control)
+          ->implicit_value(true),
+      "Run CPU-mode queries concurrently on a bounded pool of dedicated executors "
+      "instead of serializing them behind GPU queries on the default executor.");
+  developer_desc.add_options()(
+      "max-concurrent-small-queries",
+      po::value<size_t>(&g_max_concurrent_small_queries)
+          ->default_value(g_max_concurrent_small_queries),
+      "Number of admission control slots for concurrent CPU-mode queries.");
+  developer_desc.add_options()(
+      "compression-limit-bytes",
+      po::value<size_t>(&g_compression_limit_bytes)
+          ->default_value(g_compression_limit_bytes),
+      "Compress result sets transferred between endpoints which are larger "
+      "than this size, in bytes. Lower it when the network between cluster "
+      "nodes, not compression throughput, is the bottleneck.");
+  developer_desc.add_options()(
+      "query-trace-dir",
+      po::value<std::string>(&g_query_trace_dir)->default_value(g_query_trace_dir),
+      "Write a Chrome trace-event JSON timeline (Calcite, codegen, fetch, "
+      "kernels, reduction) for every query into this directory. Empty "
+      "disables tracing.");
+  developer_desc.add_options()(
+      "enable-persistent-code-cache",
+      po::value<bool>(&g_enable_persistent_code_cache)
+          ->default_value(g_enable_persistent_code_cache)
+          ->implicit_value(true),
+      "Persist generated code (CPU objects and GPU PTX) under the data directory so "
+      "restarted servers skip recompilation of already-seen query shapes.");
   developer_desc.add_options()("enable-legacy-syntax",
                                po::value<bool>(&enable_legacy_syntax)
                                    ->default_value(enable_legacy_syntax)
@@ -542,6 +1233,13 @@ void MapDProgramOptions::fillAdvancedOptions() {
           ->default_value(g_enable_smem_group_by)
           ->implicit_value(true),
       "Enable using GPU shared memory for some GROUP BY queries.");
+  developer_desc.add_options()(
+      "gpu-smem-group-by-max-entries",
+      po::value<size_t>(&g_gpu_smem_group_by_max_entries)
+          ->default_value(g_gpu_smem_group_by_max_entries),
+      "Cap the group-by entry count eligible for GPU shared memory "
+      "aggregation. 0 allows every entry count that fits the per-block shared "
+      "memory capacity of the device.");
   developer_desc.add_options()("enable-window-functions",
                                po::value<bool>(&g_enable_window_functions)
                                    ->default_value(g_enable_window_functions)
@@ -753,6 +1451,10 @@ boost::optional<int> MapDProgramOptions::parse_command_line(int argc,
       }
     }
   }
+  if (g_enable_persistent_code_cache) {
+    PersistentCodeCache::getInstance().init(base_path);
+  }
+
   // add all parameters to be displayed on startup
   LOG(INFO) << "OmniSci started with data directory at '" << base_path << "'";
   LOG(INFO) << " Watchdog is set to " << enable_watchdog;
@@ -910,6 +1612,23 @@ int main(int argc, char** argv) {
                                  prog_config_opts.base_path + "/mapd_data");
   std::thread heartbeat_thread(heartbeat);
 
+  std::thread auto_vacuum_thread;
+  if (g_enable_auto_vacuum && !prog_config_opts.read_only) {
+    auto_vacuum_thread =
+        std::thread(auto_vacuum,
+                    std::ref(g_running),
+                    static_cast<unsigned int>(g_auto_vacuum_interval_seconds),
+                    prog_config_opts.mapd_parameters);
+  }
+
+  std::thread data_retention_thread;
+  if (g_enable_data_retention && !prog_config_opts.read_only) {
+    data_retention_thread =
+        std::thread(data_retention,
+                    std::ref(g_running),
+                    static_cast<unsigned int>(g_data_retention_interval_seconds));
+  }
+
   if (!g_enable_thrift_logs) {
     apache::thrift::GlobalOutput.setOutputFunction([](const char* msg) {});
   }
@@ -999,6 +1718,12 @@ int main(int argc, char** argv) {
 
   g_running = false;
   file_delete_thread.join();
+  if (auto_vacuum_thread.joinable()) {
+    auto_vacuum_thread.join();
+  }
+  if (data_retention_thread.joinable()) {
+    data_retention_thread.join();
+  }
   heartbeat_thread.join();
 
   return 0;
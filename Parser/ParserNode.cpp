@@ -30,10 +30,13 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/function.hpp>
+#include <boost/regex.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <limits>
 #include <random>
+#include <sstream>
 #include <stdexcept>
 #include <type_traits>
 #include <typeinfo>
@@ -1595,6 +1598,15 @@ size_t InsertValuesStmt::determineLeafIndex(const Catalog_Namespace::Catalog& ca
   const ColumnDescriptor* shardColumn = catalog.getShardColumnMetadataForTable(td);
   CHECK(shardColumn);
 
+  if (value_lists.size() > 1) {
+    // Rows of one multi-row INSERT can hash to different shards and therefore
+    // different leaves; routing them is a per-row decision the aggregator
+    // doesn't make yet.
+    throw std::runtime_error(
+        "Multi-row INSERT is not supported on sharded tables in distributed mode.");
+  }
+  const auto& value_list = value_lists.front();
+
   if (column_list.empty()) {
     auto all_cols =
         catalog.getAllColumnMetadataForTable(td->tableId, false, false, false);
@@ -1683,14 +1695,30 @@ size_t InsertValuesStmt::determineLeafIndex(const Catalog_Namespace::Catalog& ca
 void InsertValuesStmt::analyze(const Catalog_Namespace::Catalog& catalog,
                                Analyzer::Query& query) const {
   InsertStmt::analyze(catalog, query);
-  std::vector<std::shared_ptr<Analyzer::TargetEntry>>& tlist =
-      query.get_targetlist_nonconst();
   const auto tableId = query.get_result_table_id();
   const std::list<const ColumnDescriptor*> non_phys_cols =
       catalog.getAllColumnMetadataForTable(tableId, false, false, false);
-  if (non_phys_cols.size() != value_list.size()) {
-    throw std::runtime_error("Insert has more target columns than expressions.");
+  for (const auto& value_list : value_lists) {
+    if (non_phys_cols.size() != value_list.size()) {
+      throw std::runtime_error("Insert has more target columns than expressions.");
+    }
+  }
+  analyzeValueList(catalog, query, value_lists.front(), query.get_targetlist_nonconst());
+  // Rows after the first get the same columnwise analysis and coercion and
+  // ride along on the query, so a 10k-row VALUES list costs one parse and one
+  // plan instead of 10k.
+  for (size_t i = 1; i < value_lists.size(); ++i) {
+    std::vector<std::shared_ptr<Analyzer::TargetEntry>> row_tlist;
+    analyzeValueList(catalog, query, value_lists[i], row_tlist);
+    query.add_values_list(std::move(row_tlist));
   }
+}
+
+void InsertValuesStmt::analyzeValueList(
+    const Catalog_Namespace::Catalog& catalog,
+    Analyzer::Query& query,
+    const std::list<std::unique_ptr<Expr>>& value_list,
+    std::vector<std::shared_ptr<Analyzer::TargetEntry>>& tlist) const {
   std::list<int>::const_iterator it = query.get_result_col_list().begin();
   for (auto& v : value_list) {
     auto e = v->analyze(catalog, query);
@@ -2099,6 +2127,95 @@ decltype(auto) get_vacuum_def(TableDescriptor& td,
   });
 }
 
+Data_Namespace::TableCachePolicy cache_policy_from_string(const std::string& policy_uc) {
+  if (policy_uc == "NORMAL") {
+    return Data_Namespace::CACHE_NORMAL;
+  }
+  if (policy_uc == "PIN") {
+    return Data_Namespace::CACHE_PIN;
+  }
+  if (policy_uc == "BYPASS") {
+    return Data_Namespace::CACHE_BYPASS;
+  }
+  throw std::runtime_error("CACHE_POLICY must be NORMAL, PIN or BYPASS");
+}
+
+decltype(auto) get_cache_policy_def(TableDescriptor& td,
+                                    const NameValueAssign* p,
+                                    const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td](const auto policy_uc) {
+    td.cachePolicy = cache_policy_from_string(policy_uc);
+  });
+}
+
+decltype(auto) get_retention_column_def(TableDescriptor& td,
+                                        const NameValueAssign* p,
+                                        const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td, &columns](const auto col_upper) {
+    size_t index = 1;
+    for (const auto& cd : columns) {
+      if (boost::to_upper_copy<std::string>(cd.columnName) == col_upper) {
+        const auto type = cd.columnType.get_type();
+        // expiry is decided from the column's chunk metadata, whose min/max
+        // are kept in epoch seconds for these types
+        if (type != kTIMESTAMP && type != kDATE) {
+          throw std::runtime_error("Retention column " + cd.columnName +
+                                   " must be a TIMESTAMP or DATE column");
+        }
+        td.retentionColumnId = index;
+        return;
+      }
+      ++index;
+      if (cd.columnType.is_geometry()) {
+        index += cd.columnType.get_physical_cols();
+      }
+    }
+    throw std::runtime_error("Specified retention column " + col_upper +
+                             " doesn't exist");
+  });
+}
+
+decltype(auto) get_retention_seconds_def(TableDescriptor& td,
+                                         const NameValueAssign* p,
+                                         const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<IntLiteral>(p, [&td](const auto val) {
+    if (val <= 0) {
+      throw std::runtime_error("RETENTION_SECONDS must be a positive number.");
+    }
+    td.retentionSeconds = val;
+  });
+}
+
+decltype(auto) get_unique_key_def(TableDescriptor& td,
+                                  const NameValueAssign* p,
+                                  const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td, &columns](const auto key_upper) {
+    size_t index = 1;
+    for (const auto& cd : columns) {
+      if (boost::to_upper_copy<std::string>(cd.columnName) == key_upper) {
+        const auto& ti = cd.columnType;
+        // the upsert path compares raw stored key values, so the key must be a
+        // type whose insert buffer representation and chunk representation
+        // agree value-for-value: integers and dictionary-encoded text
+        if (!ti.is_integer() &&
+            !(ti.is_string() && ti.get_compression() == kENCODING_DICT)) {
+          throw std::runtime_error("Unique key column " + cd.columnName +
+                                   " must be an integer or dictionary-encoded text "
+                                   "column");
+        }
+        td.uniqueKeyColumnId = index;
+        return;
+      }
+      ++index;
+      if (cd.columnType.is_geometry()) {
+        index += cd.columnType.get_physical_cols();
+      }
+    }
+    throw std::runtime_error("Specified unique key column " + key_upper +
+                             " doesn't exist");
+  });
+}
+
 decltype(auto) get_sort_column_def(TableDescriptor& td,
                                    const NameValueAssign* p,
                                    const std::list<ColumnDescriptor>& columns) {
@@ -2118,7 +2235,11 @@ static const std::map<const std::string, const TableDefFuncPtr> tableDefFuncMap
     {"partitions"s, get_partions_def},
     {"shard_count"s, get_shard_count_def},
     {"vacuum"s, get_vacuum_def},
-    {"sort_column"s, get_sort_column_def}};
+    {"sort_column"s, get_sort_column_def},
+    {"cache_policy"s, get_cache_policy_def},
+    {"unique_key"s, get_unique_key_def},
+    {"retention_column"s, get_retention_column_def},
+    {"retention_seconds"s, get_retention_seconds_def}};
 
 void get_table_definitions(TableDescriptor& td,
                            const std::unique_ptr<NameValueAssign>& p,
@@ -2127,7 +2248,9 @@ void get_table_definitions(TableDescriptor& td,
   if (it == tableDefFuncMap.end()) {
     throw std::runtime_error("Invalid CREATE TABLE option " + *p->get_name() +
                              ". Should be FRAGMENT_SIZE, PAGE_SIZE, MAX_ROWS, "
-                             "PARTITIONS, VACUUM, SORT_COLUMN or SHARD_COUNT.");
+                             "PARTITIONS, VACUUM, SORT_COLUMN, CACHE_POLICY, "
+                             "UNIQUE_KEY, RETENTION_COLUMN, RETENTION_SECONDS or "
+                             "SHARD_COUNT.");
   }
   return it->second(td, p.get(), columns);
 }
@@ -2216,6 +2339,28 @@ void CreateTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
       get_table_definitions(td, p, columns);
     }
   }
+  if (td.uniqueKeyColumnId) {
+    if (td.shardedColumnId && td.shardedColumnId != td.uniqueKeyColumnId) {
+      // each shard deduplicates independently, so the key is only global when
+      // it is also what rows are sharded on
+      throw std::runtime_error(
+          "UNIQUE_KEY column of a sharded table must be the shard key");
+    }
+    for (const auto& cd : columns) {
+      const auto& ti = cd.columnType;
+      if (ti.is_varlen() || ti.is_geometry()) {
+        // matched rows are rewritten through the in-place chunk update path,
+        // which handles fixed width and dictionary-encoded columns only
+        throw std::runtime_error("UNIQUE_KEY is not supported on tables with "
+                                 "variable length column " +
+                                 cd.columnName);
+      }
+    }
+  }
+  if ((td.retentionColumnId != 0) != (td.retentionSeconds != 0)) {
+    throw std::runtime_error(
+        "RETENTION_COLUMN and RETENTION_SECONDS must be specified together");
+  }
   td.keyMetainfo = serialize_key_metainfo(shard_key_def, shared_dict_defs);
   catalog.createShardedTable(td, columns, shared_dict_defs);
   // TODO (max): It's transactionally unsafe, should be fixed: we may create object w/o
@@ -2321,6 +2466,33 @@ void InsertIntoTableAsSelectStmt::LocalConnector::checkpoint(
   catalog.getDataMgr().checkpoint(dbId, tableId);
 }
 
+void InsertIntoTableAsSelectStmt::DistributedConnector::checkpointTables(
+    const Catalog_Namespace::SessionInfo& session,
+    const std::vector<int>& table_ids) {
+  for (const auto table_id : table_ids) {
+    checkpoint(session, table_id);
+  }
+}
+
+void InsertIntoTableAsSelectStmt::LocalConnector::checkpointTables(
+    const Catalog_Namespace::SessionInfo& session,
+    const std::vector<int>& table_ids) {
+  // each physical shard has its own file manager and epoch, so their flushes
+  // are independent; run them concurrently and surface the first failure only
+  // after every flush has settled
+  std::vector<std::future<void>> worker_threads;
+  for (const auto table_id : table_ids) {
+    worker_threads.push_back(std::async(
+        std::launch::async, [this, &session, table_id] { checkpoint(session, table_id); }));
+  }
+  for (auto& child : worker_threads) {
+    child.wait();
+  }
+  for (auto& child : worker_threads) {
+    child.get();
+  }
+}
+
 void InsertIntoTableAsSelectStmt::LocalConnector::rollback(
     const Catalog_Namespace::SessionInfo& session,
     int tableId) {
@@ -2598,6 +2770,25 @@ void InsertIntoTableAsSelectStmt::populateData(
     thread_end_idx[0] = result_rows->entryCount();
   }
 
+  auto rollback_all = [&] {
+    try {
+      if (created_td->nShards) {
+        const auto shard_tables = catalog.getPhysicalTablesDescriptors(created_td);
+        for (const auto ptd : shard_tables) {
+          leafs_connector_->rollback(session, ptd->tableId);
+        }
+      }
+      leafs_connector_->rollback(session, created_td->tableId);
+    } catch (...) {
+      // eat it
+    }
+  };
+
+  // Depth-one write pipeline: while the fragmenter (or the leaves) write
+  // package N, the worker threads already convert package N + 1, so neither
+  // the conversion threads nor the insert path sit idle for long.
+  std::future<void> pending_insert;
+
   while (start_row < num_rows) {
     try {
       value_converters.clear();
@@ -2665,31 +2856,56 @@ void InsertIntoTableAsSelectStmt::populateData(
         value_converters[col_idx]->addDataBlocksToInsertData(insert_data);
       }
 
-      insertDataLoader.insertData(session, insert_data);
+      // The previous package must be written out before its converters, which
+      // own the data blocks, can be released; its errors surface here.
+      if (pending_insert.valid()) {
+        pending_insert.get();
+      }
+      // The converters move into the writer so their data blocks stay alive
+      // until the write completes; the loop builds fresh ones for the next
+      // package meanwhile.
+      auto converters = std::make_shared<
+          std::vector<std::unique_ptr<TargetValueConverter>>>(
+          std::move(value_converters));
+      pending_insert = std::async(
+          std::launch::async,
+          [&insertDataLoader, &session, converters, insert_data]() mutable {
+            insertDataLoader.insertData(session, insert_data);
+          });
     } catch (...) {
-      try {
-        if (created_td->nShards) {
-          const auto shard_tables = catalog.getPhysicalTablesDescriptors(created_td);
-          for (const auto ptd : shard_tables) {
-            leafs_connector_->rollback(session, ptd->tableId);
-          }
+      if (pending_insert.valid()) {
+        try {
+          pending_insert.get();
+        } catch (...) {
+          // eat it, the first failure is the one to report
         }
-        leafs_connector_->rollback(session, created_td->tableId);
-      } catch (...) {
-        // eat it
       }
+      rollback_all();
       throw;
     }
     start_row += num_rows_to_process;
     num_rows_to_process = std::min(num_rows - start_row, max_number_of_rows_per_package);
   }
 
+  if (pending_insert.valid()) {
+    try {
+      pending_insert.get();
+    } catch (...) {
+      rollback_all();
+      throw;
+    }
+  }
+
   if (!is_temporary) {
+    // two-phase: flush every physical shard concurrently, then checkpoint the
+    // logical table only once all of them have landed
     if (created_td->nShards) {
       const auto shard_tables = catalog.getPhysicalTablesDescriptors(created_td);
+      std::vector<int> shard_table_ids;
       for (const auto ptd : shard_tables) {
-        leafs_connector_->checkpoint(session, ptd->tableId);
+        shard_table_ids.push_back(ptd->tableId);
       }
+      leafs_connector_->checkpointTables(session, shard_table_ids);
     }
     leafs_connector_->checkpoint(session, created_td->tableId);
   }
@@ -2789,6 +3005,7 @@ void DropTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
       catalog, *table, LockType::CheckpointLock);
   auto table_write_lock = TableLockMgr::getWriteLockForTable(catalog, *table);
   catalog.dropTable(td);
+  catalog.dropMaterializedViews(*table);
 }
 
 void TruncateTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
@@ -3300,6 +3517,32 @@ void AddColumnStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   catalog.roll(true);
 }
 
+void AlterTableParamStmt::execute(const Catalog_Namespace::SessionInfo& session) {
+  auto& catalog = session.getCatalog();
+  const TableDescriptor* td = catalog.getMetadataForTable(*table);
+  if (td == nullptr) {
+    throw std::runtime_error("Table " + *table + " does not exist.");
+  }
+  if (td->isView) {
+    throw std::runtime_error(*table +
+                             " is a view. ALTER TABLE parameters are not "
+                             "supported on views.");
+  }
+  check_alter_table_privilege(session, td);
+  const auto param_name = boost::to_lower_copy<std::string>(*param->get_name());
+  if (param_name != "cache_policy") {
+    throw std::runtime_error("Invalid ALTER TABLE parameter " + *param->get_name() +
+                             ". Only CACHE_POLICY is supported.");
+  }
+  const auto literal = dynamic_cast<const StringLiteral*>(param->get_value());
+  if (!literal) {
+    throw std::runtime_error("CACHE_POLICY must be a string literal.");
+  }
+  const auto policy = cache_policy_from_string(
+      boost::to_upper_copy<std::string>(*literal->get_stringval()));
+  catalog.setTableCachePolicy(td, policy);
+}
+
 void RenameColumnStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   auto& catalog = session.getCatalog();
   const TableDescriptor* td = catalog.getMetadataForTable(*table);
@@ -3696,6 +3939,9 @@ void CopyTableStmt::execute(const Catalog_Namespace::SessionInfo& session,
                          std::to_string(rows_rejected) + " recs in " +
                          std::to_string((double)total_time / 1000.0) + " secs");
       }
+      if (rows_completed > 0) {
+        MaterializedViewRegistry::instance().refreshViews(session, *table);
+      }
     } else {
       throw std::runtime_error("Table '" + *table + "' must exist before COPY FROM");
     }
@@ -4195,29 +4441,27 @@ void ExportQueryStmt::execute(const Catalog_Namespace::SessionInfo& session) {
     }
     outfile << copy_params.line_delim;
   }
-  while (true) {
-    const auto crt_row = results->getNextRow(true, true);
-    if (crt_row.empty()) {
-      break;
-    }
+  // Formats one row into the given stream. Used both by the serial iterator
+  // path and by the per-thread segment buffers of the parallel path.
+  auto format_row = [&](std::ostream& os, const std::vector<TargetValue>& crt_row) {
     bool not_first = false;
     for (size_t i = 0; i < results->colCount(); ++i) {
       bool is_null;
       const auto tv = crt_row[i];
       const auto scalar_tv = boost::get<ScalarTargetValue>(&tv);
       if (not_first) {
-        outfile << copy_params.delimiter;
+        os << copy_params.delimiter;
       } else {
         not_first = true;
       }
       if (copy_params.quoted) {
-        outfile << copy_params.quote;
+        os << copy_params.quote;
       }
       const auto& ti = td[i].get_type_info();
       if (!scalar_tv) {
-        outfile << datum_to_string(crt_row[i], ti, " | ");
+        os << datum_to_string(crt_row[i], ti, " | ");
         if (copy_params.quoted) {
-          outfile << copy_params.quote;
+          os << copy_params.quote;
         }
         continue;
       }
@@ -4248,16 +4492,16 @@ void ExportQueryStmt::execute(const Catalog_Namespace::SessionInfo& session) {
             is_null = false;
         }
         if (is_null) {
-          outfile << copy_params.null_str;
+          os << copy_params.null_str;
         } else if (ti.get_type() == kTIME) {
           const auto t = static_cast<time_t>(int_val);
           std::tm tm_struct;
           gmtime_r(&t, &tm_struct);
           char buf[9];
           strftime(buf, 9, "%T", &tm_struct);
-          outfile << buf;
+          os << buf;
         } else {
-          outfile << int_val;
+          os << int_val;
         }
       } else if (boost::get<double>(scalar_tv)) {
         auto real_val = *(boost::get<double>(scalar_tv));
@@ -4267,52 +4511,97 @@ void ExportQueryStmt::execute(const Catalog_Namespace::SessionInfo& session) {
           is_null = (real_val == NULL_DOUBLE);
         }
         if (is_null) {
-          outfile << copy_params.null_str;
+          os << copy_params.null_str;
         } else if (ti.get_type() == kNUMERIC) {
-          outfile << std::setprecision(ti.get_precision()) << real_val;
+          os << std::setprecision(ti.get_precision()) << real_val;
         } else {
-          outfile << std::setprecision(std::numeric_limits<double>::digits10 + 1)
-                  << real_val;
+          os << std::setprecision(std::numeric_limits<double>::digits10 + 1) << real_val;
         }
       } else if (boost::get<float>(scalar_tv)) {
         CHECK_EQ(kFLOAT, ti.get_type());
         auto real_val = *(boost::get<float>(scalar_tv));
         if (real_val == NULL_FLOAT) {
-          outfile << copy_params.null_str;
+          os << copy_params.null_str;
         } else {
-          outfile << std::setprecision(std::numeric_limits<float>::digits10 + 1)
-                  << real_val;
+          os << std::setprecision(std::numeric_limits<float>::digits10 + 1) << real_val;
         }
       } else {
         auto s = boost::get<NullableString>(scalar_tv);
         is_null = !s || boost::get<void*>(s);
         if (is_null) {
-          outfile << copy_params.null_str;
+          os << copy_params.null_str;
         } else {
           auto s_notnull = boost::get<std::string>(s);
           CHECK(s_notnull);
           if (!copy_params.quoted) {
-            outfile << *s_notnull;
+            os << *s_notnull;
           } else {
             size_t q = s_notnull->find(copy_params.quote);
             if (q == std::string::npos) {
-              outfile << *s_notnull;
+              os << *s_notnull;
             } else {
               std::string str(*s_notnull);
               while (q != std::string::npos) {
                 str.insert(q, 1, copy_params.escape);
                 q = str.find(copy_params.quote, q + 2);
               }
-              outfile << str;
+              os << str;
             }
           }
         }
       }
       if (copy_params.quoted) {
-        outfile << copy_params.quote;
+        os << copy_params.quote;
       }
     }
-    outfile << copy_params.line_delim;
+    os << copy_params.line_delim;
+  };
+
+  // Decimal targets are formatted from their double representation, which only
+  // the iterator interface provides; keep them on the serial path.
+  bool has_decimal_target = false;
+  for (const auto& target : targets) {
+    if (target.get_type_info().is_decimal()) {
+      has_decimal_target = true;
+    }
+  }
+
+  const size_t num_worker_threads = std::thread::hardware_concurrency();
+  const bool can_go_parallel = !results->isTruncated() && !has_decimal_target &&
+                               num_worker_threads > 1 && results->entryCount() > 20000;
+
+  if (can_go_parallel) {
+    // Partition the result set entries across worker threads, let each thread
+    // format its range into a private segment buffer and concatenate the
+    // segments in order, so formatting no longer serializes on one core.
+    const size_t entry_count = results->entryCount();
+    const size_t stride = (entry_count + num_worker_threads - 1) / num_worker_threads;
+    std::vector<std::future<std::string>> worker_segments;
+    for (size_t start_entry = 0; start_entry < entry_count; start_entry += stride) {
+      const auto end_entry = std::min(start_entry + stride, entry_count);
+      worker_segments.push_back(
+          std::async(std::launch::async, [&results, &format_row, start_entry, end_entry] {
+            std::ostringstream segment;
+            for (size_t i = start_entry; i < end_entry; ++i) {
+              const auto crt_row = results->getRowAt(i);
+              if (!crt_row.empty()) {
+                format_row(segment, crt_row);
+              }
+            }
+            return segment.str();
+          }));
+    }
+    for (auto& segment : worker_segments) {
+      outfile << segment.get();
+    }
+  } else {
+    while (true) {
+      const auto crt_row = results->getNextRow(true, true);
+      if (crt_row.empty()) {
+        break;
+      }
+      format_row(outfile, crt_row);
+    }
   }
   outfile.close();
 }
@@ -4381,6 +4670,179 @@ void DropViewStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   catalog.dropTable(td);
 }
 
+void CreateMaterializedViewStmt::execute(
+    const Catalog_Namespace::SessionInfo& session) {
+  auto& catalog = session.getCatalog();
+  const auto& select_query = get_select_query();
+  // The base table comes from the parsed plan, not the query text, so quoted
+  // names, subqueries and joins are all classified correctly.
+  const auto query_ra =
+      Lock_Namespace::parse_to_ra(catalog, pg_shim(select_query), session);
+  std::map<std::string, bool> table_names;
+  Lock_Namespace::getTableNames(table_names, query_ra);
+  if (table_names.size() != size_t(1)) {
+    throw std::runtime_error(
+        "Materialized view queries must select from exactly one table.");
+  }
+  const auto base_table_name = table_names.begin()->first;
+  // The refresh splices a rowid watermark right after the table name, so the
+  // FROM clause must be exactly the bare base table name; an alias or a
+  // subquery would make the incremental delta query wrong.
+  boost::smatch what;
+  const boost::regex from_expr{R"(\bFROM\s+([A-Za-z_][A-Za-z0-9\$_]*))",
+                               boost::regex::icase};
+  if (!boost::regex_search(select_query, what, from_expr) ||
+      !boost::iequals(what[1].str(), base_table_name)) {
+    throw std::runtime_error(
+        "Materialized view queries must name the base table directly in their "
+        "FROM clause.");
+  }
+  const boost::regex clause_expr{R"(^\s+(WHERE|GROUP)\b)", boost::regex::icase};
+  const std::string rest =
+      select_query.substr(what.position(1) + what.length(1));
+  if (!rest.empty() && !boost::regex_search(rest, clause_expr)) {
+    throw std::runtime_error(
+        "Materialized view queries must select from a single table without "
+        "aliases, joins or subqueries.");
+  }
+  const boost::regex group_by_expr{R"(\bGROUP\s+BY\b)", boost::regex::icase};
+  if (!boost::regex_search(select_query, group_by_expr)) {
+    throw std::runtime_error(
+        "Materialized view queries must be GROUP BY aggregates; the view "
+        "stores partial aggregates which readers re-aggregate.");
+  }
+  const auto td = catalog.getMetadataForTable(base_table_name);
+  if (td == nullptr) {
+    throw std::runtime_error("Table " + base_table_name + " does not exist.");
+  }
+  if (td->isView) {
+    throw std::runtime_error(
+        "Materialized views over views are not supported.");
+  }
+  // Captured before population; rows racing in during the initial scan are
+  // picked up again by the first refresh.
+  const size_t base_row_count = td->fragmenter ? td->fragmenter->getNumRows() : 0;
+  CreateTableAsSelectStmt::execute(session);
+  // Persisted in the catalog so the registration survives restarts.
+  catalog.createMaterializedView(Catalog_Namespace::MaterializedViewRecord{
+      get_table(),
+      base_table_name,
+      select_query,
+      static_cast<int64_t>(base_row_count),
+      false});
+}
+
+void RefreshMaterializedViewStmt::execute(
+    const Catalog_Namespace::SessionInfo& session) {
+  MaterializedViewRegistry::instance().refreshView(session, view_name_);
+}
+
+MaterializedViewRegistry& MaterializedViewRegistry::instance() {
+  static MaterializedViewRegistry registry;
+  return registry;
+}
+
+void MaterializedViewRegistry::refreshViews(
+    const Catalog_Namespace::SessionInfo& session,
+    const std::string& base_table_name) {
+  const auto records = session.getCatalog().getMaterializedViews(base_table_name);
+  if (records.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(refresh_mutex_);
+  for (const auto& record : records) {
+    refreshEntry(session, record);
+  }
+}
+
+void MaterializedViewRegistry::refreshView(
+    const Catalog_Namespace::SessionInfo& session,
+    const std::string& view_table_name) {
+  auto& catalog = session.getCatalog();
+  Catalog_Namespace::MaterializedViewRecord record;
+  if (!catalog.getMaterializedView(view_table_name, record)) {
+    throw std::runtime_error("Materialized view " + view_table_name +
+                             " does not exist.");
+  }
+  std::lock_guard<std::mutex> lock(refresh_mutex_);
+  // re-read under the lock so a refresh racing this one is observed
+  if (catalog.getMaterializedView(view_table_name, record)) {
+    refreshEntry(session, record);
+  }
+}
+
+void MaterializedViewRegistry::refreshEntry(
+    const Catalog_Namespace::SessionInfo& session,
+    const Catalog_Namespace::MaterializedViewRecord& record) {
+  auto& catalog = session.getCatalog();
+  const auto td = catalog.getMetadataForTable(record.baseTableName);
+  if (td == nullptr || td->fragmenter == nullptr) {
+    return;
+  }
+  const size_t crt_row_count = td->fragmenter->getNumRows();
+  // The watermark only delimits the unrolled rows while the base table has
+  // seen nothing but appends. Updates, deletes, vacuum and fragment drops all
+  // raise needsFullRefresh through the catalog (a shrinking row count is a
+  // second, independent tell), and the view is then rebuilt from scratch.
+  if (record.needsFullRefresh ||
+      crt_row_count < static_cast<size_t>(record.lastRefreshRowCount)) {
+    const auto view_td = catalog.getMetadataForTable(record.viewName);
+    if (view_td == nullptr) {
+      return;
+    }
+    catalog.truncateTable(view_td);
+    InsertIntoTableAsSelectStmt insert_stmt(new std::string(record.viewName),
+                                            new std::string(record.selectQuery),
+                                            nullptr);
+    try {
+      insert_stmt.execute(session);
+    } catch (const std::exception& e) {
+      // The flag stays raised (and the view empty), so the next refresh
+      // rebuilds again.
+      LOG(ERROR) << "Full refresh of materialized view " << record.viewName
+                 << " failed: " << e.what();
+      return;
+    }
+    catalog.updateMaterializedViewWatermark(record.viewName,
+                                            static_cast<int64_t>(crt_row_count));
+    return;
+  }
+  if (crt_row_count <= static_cast<size_t>(record.lastRefreshRowCount)) {
+    return;
+  }
+  // Restrict the view query to the appended rowid range; rowid grows with
+  // insertion order, so the range covers exactly the unrolled rows and the
+  // executor prunes old fragments through the rowid quals.
+  const std::string watermark =
+      "rowid >= " + std::to_string(record.lastRefreshRowCount) +
+      " AND rowid < " + std::to_string(crt_row_count);
+  boost::smatch what;
+  const boost::regex from_expr{
+      "\\bFROM\\s+" + record.baseTableName + "\\b(\\s+WHERE\\b)?",
+      boost::regex::icase};
+  CHECK(boost::regex_search(record.selectQuery, what, from_expr));
+  std::string delta_query = record.selectQuery;
+  if (what[1].matched) {
+    delta_query.insert(what.position(0) + what.length(0),
+                       " " + watermark + " AND");
+  } else {
+    delta_query.insert(what.position(0) + what.length(0), " WHERE " + watermark);
+  }
+  InsertIntoTableAsSelectStmt insert_stmt(new std::string(record.viewName),
+                                          new std::string(delta_query),
+                                          nullptr);
+  try {
+    insert_stmt.execute(session);
+  } catch (const std::exception& e) {
+    // Leave the watermark untouched so the next refresh retries the range.
+    LOG(ERROR) << "Refresh of materialized view " << record.viewName
+               << " failed: " << e.what();
+    return;
+  }
+  catalog.updateMaterializedViewWatermark(record.viewName,
+                                          static_cast<int64_t>(crt_row_count));
+}
+
 void CreateDBStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   if (!session.get_currentUser().isSuper) {
     throw std::runtime_error(
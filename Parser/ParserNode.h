@@ -27,7 +27,11 @@
 #include <cstdint>
 #include <cstring>
 #include <list>
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include <boost/core/noncopyable.hpp>
 #include "../Analyzer/Analyzer.h"
 #include "../Catalog/Catalog.h"
 #include "../Distributed/AggregatedResult.h"
@@ -1025,6 +1029,12 @@ class InsertIntoTableAsSelectStmt : public DDLStmt {
         std::string& sql_query_string) = 0;
     virtual void checkpoint(const Catalog_Namespace::SessionInfo& parent_session_info,
                             int tableId) = 0;
+    // Checkpoints a group of tables as one coordinated flush. The base
+    // implementation falls back to checkpointing them one by one; connectors
+    // which can flush participants concurrently should override it.
+    virtual void checkpointTables(
+        const Catalog_Namespace::SessionInfo& parent_session_info,
+        const std::vector<int>& table_ids);
     virtual void rollback(const Catalog_Namespace::SessionInfo& parent_session_info,
                           int tableId) = 0;
   };
@@ -1043,6 +1053,8 @@ class InsertIntoTableAsSelectStmt : public DDLStmt {
                           const size_t leaf_idx,
                           Fragmenter_Namespace::InsertData& insert_data) override;
     void checkpoint(const Catalog_Namespace::SessionInfo& session, int tableId) override;
+    void checkpointTables(const Catalog_Namespace::SessionInfo& session,
+                          const std::vector<int>& table_ids) override;
     void rollback(const Catalog_Namespace::SessionInfo& session, int tableId) override;
     std::list<ColumnDescriptor> getColumnDescriptors(AggregatedResult& result,
                                                      bool for_create);
@@ -1086,6 +1098,73 @@ class CreateTableAsSelectStmt : public InsertIntoTableAsSelectStmt {
   std::list<std::unique_ptr<NameValueAssign>> storage_options_;
 };
 
+/*
+ * @type CreateMaterializedViewStmt
+ * @brief CREATE MATERIALIZED VIEW statement. The view is a regular table
+ * populated CTAS-style from a single table GROUP BY query and registered for
+ * incremental maintenance: rows ingested into the base table afterwards are
+ * aggregated and appended to the view as partial rollup rows, so readers
+ * re-aggregate the view instead of rescanning the base table.
+ */
+class CreateMaterializedViewStmt : public CreateTableAsSelectStmt {
+ public:
+  CreateMaterializedViewStmt(const std::string& view_name,
+                             const std::string& select_query)
+      : CreateTableAsSelectStmt(new std::string(view_name),
+                                new std::string(select_query),
+                                false,
+                                false,
+                                nullptr) {}
+
+  void execute(const Catalog_Namespace::SessionInfo& session) override;
+};
+
+/*
+ * @type RefreshMaterializedViewStmt
+ * @brief REFRESH MATERIALIZED VIEW statement, folds base table rows ingested
+ * through paths without an automatic refresh hook into the view.
+ */
+class RefreshMaterializedViewStmt : public DDLStmt {
+ public:
+  explicit RefreshMaterializedViewStmt(const std::string& view_name)
+      : view_name_(view_name) {}
+
+  void execute(const Catalog_Namespace::SessionInfo& session) override;
+
+ private:
+  const std::string view_name_;
+};
+
+/**
+ * Keeps materialized aggregate views fresh as their base tables change. The
+ * registrations themselves live in the catalog (mapd_materialized_views), so
+ * they survive a server restart; this class only serializes refreshes. Each
+ * view remembers the base table row count it has rolled up so far; a refresh
+ * re-runs the view query restricted to the appended rowid range and inserts
+ * the resulting partial aggregate rows into the view. When the base table
+ * sees anything other than appends - an in-place update, a delete, vacuum or
+ * a fragment drop - the rowid watermark is no longer meaningful and the view
+ * is rebuilt from scratch instead.
+ */
+class MaterializedViewRegistry : boost::noncopyable {
+ public:
+  static MaterializedViewRegistry& instance();
+
+  // Folds rows appended to the base table since the last refresh into every
+  // view registered over it. A no-op for tables without materialized views.
+  void refreshViews(const Catalog_Namespace::SessionInfo& session,
+                    const std::string& base_table_name);
+
+  void refreshView(const Catalog_Namespace::SessionInfo& session,
+                   const std::string& view_table_name);
+
+ private:
+  void refreshEntry(const Catalog_Namespace::SessionInfo& session,
+                    const Catalog_Namespace::MaterializedViewRecord& record);
+
+  std::mutex refresh_mutex_;
+};
+
 /*
  * @type DropTableStmt
  * @brief DROP TABLE statement
@@ -1140,6 +1219,15 @@ class OptimizeTableStmt : public DDLStmt {
     return false;
   }
 
+  bool shouldRecommendEncodings() const {
+    for (const auto& e : options_) {
+      if (boost::iequals(*(e->get_name()), "RECOMMEND_ENCODINGS")) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   void execute(const Catalog_Namespace::SessionInfo& session) override {
     // Should pass optimize params to the table optimizer
     CHECK(false);
@@ -1263,6 +1351,20 @@ class AddColumnStmt : public DDLStmt {
   std::list<std::unique_ptr<ColumnDef>> coldefs;
 };
 
+/*
+ * @type AlterTableParamStmt
+ * @brief ALTER TABLE <table> SET <param> = <value>
+ */
+class AlterTableParamStmt : public DDLStmt {
+ public:
+  AlterTableParamStmt(std::string* tab, NameValueAssign* p) : table(tab), param(p) {}
+  void execute(const Catalog_Namespace::SessionInfo& session) override;
+
+ private:
+  std::unique_ptr<std::string> table;
+  std::unique_ptr<NameValueAssign> param;
+};
+
 /*
  * @type CopyTableStmt
  * @brief COPY ... FROM ...
@@ -1825,22 +1927,39 @@ class InsertStmt : public DMLStmt {
  */
 class InsertValuesStmt : public InsertStmt {
  public:
-  InsertValuesStmt(std::string* t, std::list<std::string*>* c, std::list<Expr*>* v)
+  InsertValuesStmt(std::string* t,
+                   std::list<std::string*>* c,
+                   std::list<std::list<Expr*>*>* r)
       : InsertStmt(t, c) {
-    CHECK(v);
-    for (const auto e : *v) {
-      value_list.emplace_back(e);
+    CHECK(r);
+    CHECK(!r->empty());
+    for (const auto row : *r) {
+      value_lists.emplace_back();
+      auto& value_list = value_lists.back();
+      for (const auto e : *row) {
+        value_list.emplace_back(e);
+      }
+      delete row;
     }
-    delete v;
+    delete r;
+  }
+  const std::vector<std::list<std::unique_ptr<Expr>>>& get_value_lists() const {
+    return value_lists;
   }
-  const std::list<std::unique_ptr<Expr>>& get_value_list() const { return value_list; }
   void analyze(const Catalog_Namespace::Catalog& catalog,
                Analyzer::Query& query) const override;
 
   size_t determineLeafIndex(const Catalog_Namespace::Catalog& catalog, size_t num_leafs);
 
  private:
-  std::list<std::unique_ptr<Expr>> value_list;
+  // One entry per VALUES row; all rows are analyzed and inserted through a
+  // single parse and plan.
+  std::vector<std::list<std::unique_ptr<Expr>>> value_lists;
+
+  void analyzeValueList(const Catalog_Namespace::Catalog& catalog,
+                        Analyzer::Query& query,
+                        const std::list<std::unique_ptr<Expr>>& value_list,
+                        std::vector<std::shared_ptr<Analyzer::TargetEntry>>& tlist) const;
 };
 
 /*
@@ -53,7 +53,7 @@ class ParserWrapper {
   // HACK:  This needs to go away as calcite takes over parsing
   enum class DMLType : int { Insert = 0, Delete, Update, Upsert, NotDML };
 
-  enum class ExplainType { None, IR, OptimizedIR, Calcite, Other };
+  enum class ExplainType { None, IR, OptimizedIR, Calcite, Analyze, Other };
 
   ParserWrapper(std::string query_string);
   std::string process(std::string user,
@@ -81,9 +81,12 @@ class ParserWrapper {
 
   bool isSelectExplain() const {
     return explain_type_ == ExplainType::Calcite || explain_type_ == ExplainType::IR ||
-           explain_type_ == ExplainType::OptimizedIR;
+           explain_type_ == ExplainType::OptimizedIR ||
+           explain_type_ == ExplainType::Analyze;
   }
 
+  bool isAnalyzeExplain() const { return explain_type_ == ExplainType::Analyze; }
+
   bool isIRExplain() const {
     return explain_type_ == ExplainType::IR || explain_type_ == ExplainType::OptimizedIR;
   }
@@ -125,6 +128,7 @@ class ParserWrapper {
   static const std::string explain_str;
   static const std::string calcite_explain_str;
   static const std::string optimized_explain_str;
+  static const std::string analyze_explain_str;
   static const std::string optimize_str;
   static const std::string validate_str;
 };
@@ -8,6 +8,10 @@
     auto inputStr = boost::algorithm::trim_right_copy_if(inputStrOrig, boost::is_any_of(";") || boost::is_space()) + ";"; \
     boost::regex create_view_expr{R"(CREATE\s+VIEW\s+(IF\s+NOT\s+EXISTS\s+)?([A-Za-z_][A-Za-z0-9\$_]*)\s+AS\s+(.*);?)", \
                                   boost::regex::extended | boost::regex::icase};                                        \
+    boost::regex create_mat_view_expr{R"(CREATE\s+MATERIALIZED\s+VIEW\s+([A-Za-z_][A-Za-z0-9\$_]*)\s+AS\s+(.*);?)",     \
+                                      boost::regex::extended | boost::regex::icase};                                    \
+    boost::regex refresh_mat_view_expr{R"(REFRESH\s+MATERIALIZED\s+VIEW\s+([A-Za-z_][A-Za-z0-9\$_]*)\s*;?)",            \
+                                       boost::regex::extended | boost::regex::icase};                                   \
     std::lock_guard<std::mutex> lock(mutex_);                                                                           \
     boost::smatch what;                                                                                                 \
     const auto trimmed_input = boost::algorithm::trim_copy(inputStr);                                                   \
@@ -18,6 +22,14 @@
       parseTrees.emplace_back(new CreateViewStmt(view_name, select_query, if_not_exists));                              \
       return 0;                                                                                                         \
     }                                                                                                                   \
+    if (boost::regex_match(trimmed_input.cbegin(), trimmed_input.cend(), what, create_mat_view_expr)) {                 \
+      parseTrees.emplace_back(new CreateMaterializedViewStmt(what[1].str(), what[2].str()));                            \
+      return 0;                                                                                                         \
+    }                                                                                                                   \
+    if (boost::regex_match(trimmed_input.cbegin(), trimmed_input.cend(), what, refresh_mat_view_expr)) {                \
+      parseTrees.emplace_back(new RefreshMaterializedViewStmt(what[1].str()));                                          \
+      return 0;                                                                                                         \
+    }                                                                                                                   \
     std::istringstream ss(inputStr);                                                                                    \
     lexer.switch_streams(&ss,0);                                                                                        \
     yyparse(parseTrees);                                                                                                \
@@ -127,6 +139,7 @@ sql:		/* schema {	$<nodeval>$ = $<nodeval>1; } */
 	| rename_table_statement { $<nodeval>$ = $<nodeval>1; }
 	| rename_column_statement { $<nodeval>$ = $<nodeval>1; }
 	| add_column_statement { $<nodeval>$ = $<nodeval>1; }
+	| alter_table_param_statement { $<nodeval>$ = $<nodeval>1; }
 	| copy_table_statement { $<nodeval>$ = $<nodeval>1; }
 	| create_database_statement { $<nodeval>$ = $<nodeval>1; }
 	| drop_database_statement { $<nodeval>$ = $<nodeval>1; }
@@ -312,6 +325,13 @@ add_column_statement:
 		}
 		;
 
+alter_table_param_statement:
+		ALTER TABLE table SET name_eq_value
+		{
+		   $<nodeval>$ = new AlterTableParamStmt($<stringval>3, dynamic_cast<NameValueAssign*>($<nodeval>5));
+		}
+		;
+
 copy_table_statement:
 	COPY table FROM STRING opt_with_option_list
 	{
@@ -631,9 +651,9 @@ delete_statement:
 	;
 
 insert_statement:
-		INSERT INTO table opt_column_commalist VALUES '(' atom_commalist ')'
+		INSERT INTO table opt_column_commalist VALUES insert_value_commalist
 		{
-			$<nodeval>$ = new InsertValuesStmt($<stringval>3, $<slistval>4, reinterpret_cast<std::list<Expr*>*>($<listval>7));
+			$<nodeval>$ = new InsertValuesStmt($<stringval>3, $<slistval>4, reinterpret_cast<std::list<std::list<Expr*>*>*>($<listval>6));
 		}
 		| INSERT INTO table opt_column_commalist SELECTSTRING
 		{
@@ -641,6 +661,16 @@ insert_statement:
 		}
 	;
 
+insert_value_commalist:
+		'(' atom_commalist ')'
+	{ $<listval>$ = new std::list<Node*>(1, reinterpret_cast<Node*>($<listval>2)); }
+	|	insert_value_commalist ',' '(' atom_commalist ')'
+	{
+		$<listval>$ = $<listval>1;
+		$<listval>$->push_back(reinterpret_cast<Node*>($<listval>4));
+	}
+	;
+
 /* NOT SUPPORTED
 open_statement:
 		OPEN cursor
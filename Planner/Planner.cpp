@@ -347,7 +347,7 @@ void Optimizer::process_targetlist() {
     final_tlist.push_back(new_tle);
   }
   if (cur_plan == nullptr) {
-    cur_plan = new ValuesScan(final_tlist);
+    cur_plan = new ValuesScan(final_tlist, query.get_values_lists());
   } else {
     cur_plan->set_targetlist(final_tlist);
   }
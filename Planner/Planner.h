@@ -142,7 +142,20 @@ class Scan : public Plan {
 class ValuesScan : public Plan {
  public:
   ValuesScan(const std::vector<std::shared_ptr<Analyzer::TargetEntry>>& t) : Plan(t) {}
+  ValuesScan(const std::vector<std::shared_ptr<Analyzer::TargetEntry>>& t,
+             const std::vector<std::vector<std::shared_ptr<Analyzer::TargetEntry>>>&
+                 values_lists)
+      : Plan(t), values_lists_(values_lists) {}
   void print() const override;
+  // Rows after the first for multi-row INSERT VALUES; the targetlist is the
+  // first row.
+  const std::vector<std::vector<std::shared_ptr<Analyzer::TargetEntry>>>&
+  get_values_lists() const {
+    return values_lists_;
+  }
+
+ private:
+  const std::vector<std::vector<std::shared_ptr<Analyzer::TargetEntry>>> values_lists_;
 };
 
 /*
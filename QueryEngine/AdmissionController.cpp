@@ -0,0 +1,53 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AdmissionController.h"
+
+#include "Shared/Logger.h"
+
+bool g_enable_admission_control{false};
+size_t g_max_concurrent_small_queries{4};
+
+AdmissionController& AdmissionController::getInstance() {
+  static AdmissionController instance;
+  return instance;
+}
+
+AdmissionController::AdmissionController()
+    : slot_in_use_(std::max(g_max_concurrent_small_queries, size_t(1)), false) {}
+
+AdmissionController::Slot AdmissionController::admitSmallQuery() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    for (size_t i = 0; i < slot_in_use_.size(); ++i) {
+      if (!slot_in_use_[i]) {
+        slot_in_use_[i] = true;
+        return Slot(this, i);
+      }
+    }
+    cv_.wait(lock);
+  }
+}
+
+void AdmissionController::releaseSlot(const size_t slot_index) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_LT(slot_index, slot_in_use_.size());
+    CHECK(slot_in_use_[slot_index]);
+    slot_in_use_[slot_index] = false;
+  }
+  cv_.notify_one();
+}
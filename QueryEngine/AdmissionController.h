@@ -0,0 +1,95 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    AdmissionController.h
+ * @brief   Admission control for concurrent query execution. Small CPU-mode
+ *          queries are admitted into a bounded pool of slots, each slot mapping
+ *          to a dedicated executor so those queries no longer wait behind
+ *          long-running queries serialized on the default executor. Heavy
+ *          (GPU or large CPU) queries keep the existing single-executor
+ *          serialization and are unaffected.
+ */
+
+#ifndef QUERYENGINE_ADMISSIONCONTROLLER_H
+#define QUERYENGINE_ADMISSIONCONTROLLER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+class AdmissionController {
+ public:
+  // RAII admission slot. Move-only; the slot is returned to the pool on
+  // destruction. slotIndex() identifies which small-query executor to use.
+  class Slot {
+   public:
+    Slot() : controller_(nullptr), slot_index_(0) {}
+    Slot(AdmissionController* controller, const size_t slot_index)
+        : controller_(controller), slot_index_(slot_index) {}
+    Slot(const Slot&) = delete;
+    Slot& operator=(const Slot&) = delete;
+    Slot(Slot&& other) noexcept
+        : controller_(other.controller_), slot_index_(other.slot_index_) {
+      other.controller_ = nullptr;
+    }
+    Slot& operator=(Slot&& other) noexcept {
+      if (this != &other) {
+        release();
+        controller_ = other.controller_;
+        slot_index_ = other.slot_index_;
+        other.controller_ = nullptr;
+      }
+      return *this;
+    }
+    ~Slot() { release(); }
+
+    bool valid() const { return controller_ != nullptr; }
+    size_t slotIndex() const { return slot_index_; }
+
+   private:
+    void release() {
+      if (controller_) {
+        controller_->releaseSlot(slot_index_);
+        controller_ = nullptr;
+      }
+    }
+
+    AdmissionController* controller_;
+    size_t slot_index_;
+  };
+
+  static AdmissionController& getInstance();
+
+  // Blocks until one of the small-query slots is free; returns the slot which
+  // must be held for the duration of the query.
+  Slot admitSmallQuery();
+
+ private:
+  AdmissionController();
+
+  void releaseSlot(const size_t slot_index);
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<bool> slot_in_use_;
+};
+
+extern bool g_enable_admission_control;
+extern size_t g_max_concurrent_small_queries;
+
+#endif  // QUERYENGINE_ADMISSIONCONTROLLER_H
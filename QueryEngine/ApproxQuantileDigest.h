@@ -0,0 +1,132 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QUERYENGINE_APPROXQUANTILEDIGEST_H
+#define QUERYENGINE_APPROXQUANTILEDIGEST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Mergeable quantile sketch in the spirit of the t-digest. Incoming values are
+// buffered and periodically merged into a bounded list of weighted centroids;
+// the merge rule keeps centroids near the distribution tails small, so extreme
+// quantiles stay accurate while the sketch size is independent of the input
+// cardinality. Updated from generated CPU code through agg_approx_median, like
+// the COUNT DISTINCT std::set fallback, and merged across devices and
+// fragments during result set reduction.
+class ApproxQuantileDigest {
+ public:
+  void add(const double val) {
+    buffer_.push_back(val);
+    total_weight_ += 1;
+    if (buffer_.size() >= kBufferSize) {
+      compress();
+    }
+  }
+
+  // Folds the other digest into this one, the other side is left untouched.
+  void mergeDigest(const ApproxQuantileDigest& other) {
+    centroids_.insert(
+        centroids_.end(), other.centroids_.begin(), other.centroids_.end());
+    buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+    total_weight_ += other.total_weight_;
+    compress();
+  }
+
+  bool empty() const { return total_weight_ == 0; }
+
+  // Returns the approximate value at the given quantile, interpolating
+  // linearly between adjacent centroid means.
+  double quantile(const double q) {
+    compress();
+    if (centroids_.empty()) {
+      return 0;
+    }
+    const double target = q * total_weight_;
+    double weight_so_far = 0;
+    double prev_mid_weight = 0;
+    double prev_mean = centroids_.front().mean;
+    for (const auto& centroid : centroids_) {
+      const double mid_weight = weight_so_far + centroid.weight / 2;
+      if (target <= mid_weight) {
+        if (mid_weight == prev_mid_weight) {
+          return centroid.mean;
+        }
+        const double frac = (target - prev_mid_weight) / (mid_weight - prev_mid_weight);
+        return prev_mean + frac * (centroid.mean - prev_mean);
+      }
+      weight_so_far += centroid.weight;
+      prev_mid_weight = mid_weight;
+      prev_mean = centroid.mean;
+    }
+    return centroids_.back().mean;
+  }
+
+ private:
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+
+  void compress() {
+    if (buffer_.empty() && centroids_.size() <= kCompression) {
+      return;
+    }
+    std::vector<Centroid> pending;
+    pending.reserve(centroids_.size() + buffer_.size());
+    pending.insert(pending.end(), centroids_.begin(), centroids_.end());
+    for (const auto val : buffer_) {
+      pending.push_back(Centroid{val, 1});
+    }
+    buffer_.clear();
+    std::sort(pending.begin(),
+              pending.end(),
+              [](const Centroid& lhs, const Centroid& rhs) {
+                return lhs.mean < rhs.mean;
+              });
+    centroids_.clear();
+    double weight_before_last = 0;
+    for (const auto& centroid : pending) {
+      if (!centroids_.empty()) {
+        auto& last = centroids_.back();
+        const double projected_weight = last.weight + centroid.weight;
+        // Cap the cluster weight by 4 * N * q * (1 - q) / compression, the
+        // standard t-digest bound which shrinks the clusters near the tails.
+        const double q_mid =
+            (weight_before_last + projected_weight / 2) / total_weight_;
+        const double weight_limit =
+            4 * total_weight_ * q_mid * (1 - q_mid) / kCompression + 1;
+        if (projected_weight <= weight_limit) {
+          last.mean += (centroid.mean - last.mean) * centroid.weight / projected_weight;
+          last.weight = projected_weight;
+          continue;
+        }
+        weight_before_last += last.weight;
+      }
+      centroids_.push_back(centroid);
+    }
+  }
+
+  static constexpr size_t kBufferSize{2048};
+  static constexpr size_t kCompression{300};
+
+  std::vector<Centroid> centroids_;
+  std::vector<double> buffer_;
+  double total_weight_{0};
+};
+
+#endif  // QUERYENGINE_APPROXQUANTILEDIGEST_H
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QUERYENGINE_APPROXTOPKSKETCH_H
+#define QUERYENGINE_APPROXTOPKSKETCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Mergeable heavy hitters sketch based on the SpaceSaving algorithm. A bounded
+// set of monitored values is kept with an observed count and an error bound;
+// when an unmonitored value arrives and the set is full, the value with the
+// smallest count is replaced and the new value inherits that count as its
+// error. The capacity is a small multiple of the requested k, so the top k
+// answers stay accurate as long as the heavy hitters dominate the stream.
+// Updated from generated CPU code through agg_approx_top_k, like the quantile
+// digest, and merged across devices and fragments during result set reduction.
+class ApproxTopKSketch {
+ public:
+  explicit ApproxTopKSketch(const size_t k)
+      : k_(k)
+      , capacity_(k * kCapacityScale < kMinCapacity ? kMinCapacity
+                                                    : k * kCapacityScale) {}
+
+  void add(const int64_t val) {
+    auto it = counters_.find(val);
+    if (it != counters_.end()) {
+      it->second.count += 1;
+      return;
+    }
+    if (counters_.size() < capacity_) {
+      counters_.emplace(val, Counter{1, 0});
+      return;
+    }
+    // Evict the smallest counter; the newcomer inherits its count as the
+    // error bound, the defining SpaceSaving move.
+    auto min_it = counters_.begin();
+    for (auto counter_it = counters_.begin(); counter_it != counters_.end();
+         ++counter_it) {
+      if (counter_it->second.count < min_it->second.count) {
+        min_it = counter_it;
+      }
+    }
+    const auto min_count = min_it->second.count;
+    counters_.erase(min_it);
+    counters_.emplace(val, Counter{min_count + 1, min_count});
+  }
+
+  // Folds the other sketch into this one, the other side is left untouched.
+  void mergeSketch(const ApproxTopKSketch& other) {
+    for (const auto& kv : other.counters_) {
+      auto it = counters_.find(kv.first);
+      if (it != counters_.end()) {
+        it->second.count += kv.second.count;
+        it->second.error += kv.second.error;
+      } else {
+        counters_.insert(kv);
+      }
+    }
+    if (counters_.size() > capacity_) {
+      auto sorted = sortedCounters();
+      sorted.resize(capacity_);
+      counters_.clear();
+      for (const auto& kv : sorted) {
+        counters_.insert(kv);
+      }
+    }
+  }
+
+  bool empty() const { return counters_.empty(); }
+
+  size_t k() const { return k_; }
+
+  // Returns the k-th most frequent value seen so far, or false when fewer
+  // than k distinct values were observed.
+  bool topValue(int64_t& val) const {
+    if (counters_.size() < k_) {
+      return false;
+    }
+    const auto sorted = sortedCounters();
+    val = sorted[k_ - 1].first;
+    return true;
+  }
+
+ private:
+  struct Counter {
+    uint64_t count;
+    uint64_t error;
+  };
+
+  std::vector<std::pair<int64_t, Counter>> sortedCounters() const {
+    std::vector<std::pair<int64_t, Counter>> sorted(counters_.begin(),
+                                                    counters_.end());
+    std::sort(sorted.begin(),
+              sorted.end(),
+              [](const std::pair<int64_t, Counter>& lhs,
+                 const std::pair<int64_t, Counter>& rhs) {
+                if (lhs.second.count != rhs.second.count) {
+                  return lhs.second.count > rhs.second.count;
+                }
+                // Prefer the better attested counter, then break ties by value
+                // to keep the answer deterministic across merges.
+                if (lhs.second.error != rhs.second.error) {
+                  return lhs.second.error < rhs.second.error;
+                }
+                return lhs.first < rhs.first;
+              });
+    return sorted;
+  }
+
+  static constexpr size_t kCapacityScale{8};
+  static constexpr size_t kMinCapacity{64};
+
+  const size_t k_;
+  const size_t capacity_;
+  std::unordered_map<int64_t, Counter> counters_;
+};
+
+#endif  // QUERYENGINE_APPROXTOPKSKETCH_H
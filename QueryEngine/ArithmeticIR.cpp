@@ -79,7 +79,12 @@ llvm::Value* CodeGenerator::codegenIntArith(const Analyzer::BinOper* bin_oper,
   const auto& lhs_type = lhs->get_type_info();
   const auto& rhs_type = rhs->get_type_info();
   const auto int_typename = numeric_or_time_interval_type_name(lhs_type, rhs_type);
-  const auto null_check_suffix = get_null_check_suffix(lhs_type, rhs_type);
+  auto null_check_suffix = get_null_check_suffix(lhs_type, rhs_type);
+  if (!null_check_suffix.empty() && isNullFreeOperand(lhs) && isNullFreeOperand(rhs)) {
+    // chunk metadata proves neither operand can be null; compile the
+    // null-free form of the operation
+    null_check_suffix.clear();
+  }
   const auto& oper_type = rhs_type.is_timeinterval() ? rhs_type : lhs_type;
   switch (bin_oper->get_optype()) {
     case kMINUS:
@@ -104,13 +109,15 @@ llvm::Value* CodeGenerator::codegenIntArith(const Analyzer::BinOper* bin_oper,
                         null_check_suffix,
                         oper_type);
     case kDIVIDE:
-      return codegenDiv(lhs_lv,
+      return codegenDiv(bin_oper,
+                        lhs_lv,
                         rhs_lv,
                         null_check_suffix.empty() ? "" : int_typename,
                         null_check_suffix,
                         oper_type);
     case kMODULO:
-      return codegenMod(lhs_lv,
+      return codegenMod(bin_oper,
+                        lhs_lv,
                         rhs_lv,
                         null_check_suffix.empty() ? "" : int_typename,
                         null_check_suffix,
@@ -131,7 +138,12 @@ llvm::Value* CodeGenerator::codegenFpArith(const Analyzer::BinOper* bin_oper,
   const auto& lhs_type = lhs->get_type_info();
   const auto& rhs_type = rhs->get_type_info();
   const auto fp_typename = numeric_type_name(lhs_type);
-  const auto null_check_suffix = get_null_check_suffix(lhs_type, rhs_type);
+  auto null_check_suffix = get_null_check_suffix(lhs_type, rhs_type);
+  if (!null_check_suffix.empty() && isNullFreeOperand(lhs) && isNullFreeOperand(rhs)) {
+    // chunk metadata proves neither operand can be null; compile the
+    // null-free form of the operation
+    null_check_suffix.clear();
+  }
   llvm::ConstantFP* fp_null{lhs_type.get_type() == kFLOAT
                                 ? cgen_state_->llFp(NULL_FLOAT)
                                 : cgen_state_->llFp(NULL_DOUBLE)};
@@ -152,7 +164,8 @@ llvm::Value* CodeGenerator::codegenFpArith(const Analyzer::BinOper* bin_oper,
                  : cgen_state_->emitCall("mul_" + fp_typename + null_check_suffix,
                                          {lhs_lv, rhs_lv, fp_null});
     case kDIVIDE:
-      return codegenDiv(lhs_lv,
+      return codegenDiv(bin_oper,
+                        lhs_lv,
                         rhs_lv,
                         null_check_suffix.empty() ? "" : fp_typename,
                         null_check_suffix,
@@ -204,6 +217,50 @@ bool CodeGenerator::checkExpressionRanges(const Analyzer::BinOper* bin_oper,
   return false;
 }
 
+// Returns true iff the expression's range, derived from chunk metadata, fits
+// within [min, max], making a runtime overflow check unnecessary.
+bool CodeGenerator::checkExpressionRange(const Analyzer::Expr* expr,
+                                         int64_t min,
+                                         int64_t max) {
+  if (is_temporary_column(expr) || cgen_state_->query_infos_.empty()) {
+    return false;
+  }
+  const auto range = getExpressionRange(expr, cgen_state_->query_infos_, executor());
+  return range.getType() == ExpressionRangeType::Integer && range.getIntMin() >= min &&
+         range.getIntMax() <= max;
+}
+
+// Returns true iff the divisor's range, derived from chunk metadata, proves it
+// can never be zero, so no division by zero check is needed. The null sentinel
+// is handled by the nullable operation itself and is never zero.
+bool CodeGenerator::checkExpressionRangeExcludesZero(const Analyzer::Expr* expr) {
+  if (is_temporary_column(expr) || cgen_state_->query_infos_.empty()) {
+    return false;
+  }
+  const auto range = getExpressionRange(expr, cgen_state_->query_infos_, executor());
+  return range.getType() == ExpressionRangeType::Integer &&
+         (range.getIntMin() > 0 || range.getIntMax() < 0);
+}
+
+// Returns true iff the operand cannot be null at runtime: either its type is
+// NOT NULL, or it is a physical column whose chunk metadata shows no nulls in
+// any of the scanned fragments.
+bool CodeGenerator::isNullFreeOperand(const Analyzer::Expr* expr) {
+  if (expr->get_type_info().get_notnull()) {
+    return true;
+  }
+  if (!g_enable_null_check_elision) {
+    return false;
+  }
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr);
+  if (!col_var || dynamic_cast<const Analyzer::Var*>(expr) ||
+      is_temporary_column(col_var) || cgen_state_->query_infos_.empty()) {
+    return false;
+  }
+  const auto range = getExpressionRange(col_var, cgen_state_->query_infos_, executor());
+  return range.getType() != ExpressionRangeType::Invalid && !range.hasNulls();
+}
+
 llvm::Value* CodeGenerator::codegenAdd(const Analyzer::BinOper* bin_oper,
                                        llvm::Value* lhs_lv,
                                        llvm::Value* rhs_lv,
@@ -394,7 +451,8 @@ llvm::Value* CodeGenerator::codegenMul(const Analyzer::BinOper* bin_oper,
   return ret;
 }
 
-llvm::Value* CodeGenerator::codegenDiv(llvm::Value* lhs_lv,
+llvm::Value* CodeGenerator::codegenDiv(const Analyzer::BinOper* bin_oper,
+                                       llvm::Value* lhs_lv,
                                        llvm::Value* rhs_lv,
                                        const std::string& null_typename,
                                        const std::string& null_check_suffix,
@@ -412,35 +470,43 @@ llvm::Value* CodeGenerator::codegenDiv(llvm::Value* lhs_lv,
       llvm::Value* chosen_max{nullptr};
       llvm::Value* chosen_min{nullptr};
       std::tie(chosen_max, chosen_min) = cgen_state_->inlineIntMaxMin(8, true);
-      auto decimal_div_ok = llvm::BasicBlock::Create(
-          cgen_state_->context_, "decimal_div_ok", cgen_state_->row_func_);
-      if (!null_check_suffix.empty()) {
-        codegenSkipOverflowCheckForNull(lhs_lv, rhs_lv, decimal_div_ok, ti);
-      }
-      auto decimal_div_fail = llvm::BasicBlock::Create(
-          cgen_state_->context_, "decimal_div_fail", cgen_state_->row_func_);
       auto lhs_max = static_cast<llvm::ConstantInt*>(chosen_max)->getSExtValue() /
                      exp_to_scale(ti.get_scale());
-      auto lhs_max_lv =
-          llvm::ConstantInt::get(get_int_type(64, cgen_state_->context_), lhs_max);
-      llvm::Value* detected{nullptr};
-      if (ti.get_notnull()) {
-        detected = cgen_state_->ir_builder_.CreateICmpSGT(lhs_lv, lhs_max_lv);
-      } else {
-        detected = toBool(cgen_state_->emitCall(
-            "gt_" + numeric_type_name(ti) + "_nullable",
-            {lhs_lv,
-             lhs_max_lv,
-             cgen_state_->llInt(inline_int_null_val(ti)),
-             cgen_state_->inlineIntNull(SQLTypeInfo(kBOOLEAN, false))}));
+      // the scale-up multiply cannot overflow when the metadata range of the
+      // dividend is bounded by the scaled-down type maximum
+      const bool need_overflow_check =
+          !checkExpressionRange(bin_oper->get_left_operand(),
+                                static_cast<llvm::ConstantInt*>(chosen_min)->getSExtValue(),
+                                lhs_max);
+      if (need_overflow_check) {
+        auto decimal_div_ok = llvm::BasicBlock::Create(
+            cgen_state_->context_, "decimal_div_ok", cgen_state_->row_func_);
+        if (!null_check_suffix.empty()) {
+          codegenSkipOverflowCheckForNull(lhs_lv, rhs_lv, decimal_div_ok, ti);
+        }
+        auto decimal_div_fail = llvm::BasicBlock::Create(
+            cgen_state_->context_, "decimal_div_fail", cgen_state_->row_func_);
+        auto lhs_max_lv =
+            llvm::ConstantInt::get(get_int_type(64, cgen_state_->context_), lhs_max);
+        llvm::Value* detected{nullptr};
+        if (ti.get_notnull()) {
+          detected = cgen_state_->ir_builder_.CreateICmpSGT(lhs_lv, lhs_max_lv);
+        } else {
+          detected = toBool(cgen_state_->emitCall(
+              "gt_" + numeric_type_name(ti) + "_nullable",
+              {lhs_lv,
+               lhs_max_lv,
+               cgen_state_->llInt(inline_int_null_val(ti)),
+               cgen_state_->inlineIntNull(SQLTypeInfo(kBOOLEAN, false))}));
+        }
+        cgen_state_->ir_builder_.CreateCondBr(detected, decimal_div_fail, decimal_div_ok);
+
+        cgen_state_->ir_builder_.SetInsertPoint(decimal_div_fail);
+        cgen_state_->ir_builder_.CreateRet(
+            cgen_state_->llInt(Executor::ERR_OVERFLOW_OR_UNDERFLOW));
+
+        cgen_state_->ir_builder_.SetInsertPoint(decimal_div_ok);
       }
-      cgen_state_->ir_builder_.CreateCondBr(detected, decimal_div_fail, decimal_div_ok);
-
-      cgen_state_->ir_builder_.SetInsertPoint(decimal_div_fail);
-      cgen_state_->ir_builder_.CreateRet(
-          cgen_state_->llInt(Executor::ERR_OVERFLOW_OR_UNDERFLOW));
-
-      cgen_state_->ir_builder_.SetInsertPoint(decimal_div_ok);
 
       lhs_lv = null_typename.empty()
                    ? cgen_state_->ir_builder_.CreateMul(lhs_lv, scale_lv)
@@ -460,26 +526,34 @@ llvm::Value* CodeGenerator::codegenDiv(llvm::Value* lhs_lv,
     return cgen_state_->emitCall("safe_div_" + numeric_type_name(ti),
                                  {lhs_lv, rhs_lv, null_lv});
   }
-  cgen_state_->needs_error_check_ = true;
-  auto div_ok =
-      llvm::BasicBlock::Create(cgen_state_->context_, "div_ok", cgen_state_->row_func_);
-  if (!null_check_suffix.empty()) {
-    codegenSkipOverflowCheckForNull(lhs_lv, rhs_lv, div_ok, ti);
-  }
-  auto div_zero =
-      llvm::BasicBlock::Create(cgen_state_->context_, "div_zero", cgen_state_->row_func_);
+  // the division by zero check isn't needed when the metadata range of the
+  // divisor excludes zero
+  const bool need_zero_check =
+      !checkExpressionRangeExcludesZero(bin_oper->get_right_operand());
+  llvm::BasicBlock* div_ok{nullptr};
+  llvm::BasicBlock* div_zero{nullptr};
   auto zero_const = rhs_lv->getType()->isIntegerTy()
                         ? llvm::ConstantInt::get(rhs_lv->getType(), 0, true)
                         : llvm::ConstantFP::get(rhs_lv->getType(), 0.);
-  cgen_state_->ir_builder_.CreateCondBr(
-      zero_const->getType()->isFloatingPointTy()
-          ? cgen_state_->ir_builder_.CreateFCmp(
-                llvm::FCmpInst::FCMP_ONE, rhs_lv, zero_const)
-          : cgen_state_->ir_builder_.CreateICmp(
-                llvm::ICmpInst::ICMP_NE, rhs_lv, zero_const),
-      div_ok,
-      div_zero);
-  cgen_state_->ir_builder_.SetInsertPoint(div_ok);
+  if (need_zero_check) {
+    cgen_state_->needs_error_check_ = true;
+    div_ok = llvm::BasicBlock::Create(
+        cgen_state_->context_, "div_ok", cgen_state_->row_func_);
+    if (!null_check_suffix.empty()) {
+      codegenSkipOverflowCheckForNull(lhs_lv, rhs_lv, div_ok, ti);
+    }
+    div_zero = llvm::BasicBlock::Create(
+        cgen_state_->context_, "div_zero", cgen_state_->row_func_);
+    cgen_state_->ir_builder_.CreateCondBr(
+        zero_const->getType()->isFloatingPointTy()
+            ? cgen_state_->ir_builder_.CreateFCmp(
+                  llvm::FCmpInst::FCMP_ONE, rhs_lv, zero_const)
+            : cgen_state_->ir_builder_.CreateICmp(
+                  llvm::ICmpInst::ICMP_NE, rhs_lv, zero_const),
+        div_ok,
+        div_zero);
+    cgen_state_->ir_builder_.SetInsertPoint(div_ok);
+  }
   auto ret =
       zero_const->getType()->isIntegerTy()
           ? (null_typename.empty()
@@ -495,9 +569,11 @@ llvm::Value* CodeGenerator::codegenDiv(llvm::Value* lhs_lv,
                         rhs_lv,
                         ti.get_type() == kFLOAT ? cgen_state_->llFp(NULL_FLOAT)
                                                 : cgen_state_->llFp(NULL_DOUBLE)}));
-  cgen_state_->ir_builder_.SetInsertPoint(div_zero);
-  cgen_state_->ir_builder_.CreateRet(cgen_state_->llInt(Executor::ERR_DIV_BY_ZERO));
-  cgen_state_->ir_builder_.SetInsertPoint(div_ok);
+  if (need_zero_check) {
+    cgen_state_->ir_builder_.SetInsertPoint(div_zero);
+    cgen_state_->ir_builder_.CreateRet(cgen_state_->llInt(Executor::ERR_DIV_BY_ZERO));
+    cgen_state_->ir_builder_.SetInsertPoint(div_ok);
+  }
   return ret;
 }
 
@@ -549,7 +625,8 @@ llvm::Value* CodeGenerator::codegenDeciDiv(const Analyzer::BinOper* bin_oper,
   }
   const auto int_typename = numeric_or_time_interval_type_name(lhs_type, rhs_type);
   const auto null_check_suffix = get_null_check_suffix(lhs_type, rhs_type);
-  return codegenDiv(lhs_lv,
+  return codegenDiv(bin_oper,
+                    lhs_lv,
                     rhs_lv,
                     null_check_suffix.empty() ? "" : int_typename,
                     null_check_suffix,
@@ -557,33 +634,43 @@ llvm::Value* CodeGenerator::codegenDeciDiv(const Analyzer::BinOper* bin_oper,
                     /*upscale*/ false);
 }
 
-llvm::Value* CodeGenerator::codegenMod(llvm::Value* lhs_lv,
+llvm::Value* CodeGenerator::codegenMod(const Analyzer::BinOper* bin_oper,
+                                       llvm::Value* lhs_lv,
                                        llvm::Value* rhs_lv,
                                        const std::string& null_typename,
                                        const std::string& null_check_suffix,
                                        const SQLTypeInfo& ti) {
   CHECK_EQ(lhs_lv->getType(), rhs_lv->getType());
   CHECK(ti.is_integer());
-  cgen_state_->needs_error_check_ = true;
-  // Generate control flow for division by zero error handling.
-  auto mod_ok =
-      llvm::BasicBlock::Create(cgen_state_->context_, "mod_ok", cgen_state_->row_func_);
-  auto mod_zero =
-      llvm::BasicBlock::Create(cgen_state_->context_, "mod_zero", cgen_state_->row_func_);
-  auto zero_const = llvm::ConstantInt::get(rhs_lv->getType(), 0, true);
-  cgen_state_->ir_builder_.CreateCondBr(
-      cgen_state_->ir_builder_.CreateICmp(llvm::ICmpInst::ICMP_NE, rhs_lv, zero_const),
-      mod_ok,
-      mod_zero);
-  cgen_state_->ir_builder_.SetInsertPoint(mod_ok);
+  // Generate control flow for division by zero error handling, unless the
+  // metadata range of the divisor excludes zero.
+  const bool need_zero_check =
+      !checkExpressionRangeExcludesZero(bin_oper->get_right_operand());
+  llvm::BasicBlock* mod_ok{nullptr};
+  llvm::BasicBlock* mod_zero{nullptr};
+  if (need_zero_check) {
+    cgen_state_->needs_error_check_ = true;
+    mod_ok =
+        llvm::BasicBlock::Create(cgen_state_->context_, "mod_ok", cgen_state_->row_func_);
+    mod_zero = llvm::BasicBlock::Create(
+        cgen_state_->context_, "mod_zero", cgen_state_->row_func_);
+    auto zero_const = llvm::ConstantInt::get(rhs_lv->getType(), 0, true);
+    cgen_state_->ir_builder_.CreateCondBr(
+        cgen_state_->ir_builder_.CreateICmp(llvm::ICmpInst::ICMP_NE, rhs_lv, zero_const),
+        mod_ok,
+        mod_zero);
+    cgen_state_->ir_builder_.SetInsertPoint(mod_ok);
+  }
   auto ret = null_typename.empty()
                  ? cgen_state_->ir_builder_.CreateSRem(lhs_lv, rhs_lv)
                  : cgen_state_->emitCall(
                        "mod_" + null_typename + null_check_suffix,
                        {lhs_lv, rhs_lv, cgen_state_->llInt(inline_int_null_val(ti))});
-  cgen_state_->ir_builder_.SetInsertPoint(mod_zero);
-  cgen_state_->ir_builder_.CreateRet(cgen_state_->llInt(Executor::ERR_DIV_BY_ZERO));
-  cgen_state_->ir_builder_.SetInsertPoint(mod_ok);
+  if (need_zero_check) {
+    cgen_state_->ir_builder_.SetInsertPoint(mod_zero);
+    cgen_state_->ir_builder_.CreateRet(cgen_state_->llInt(Executor::ERR_DIV_BY_ZERO));
+    cgen_state_->ir_builder_.SetInsertPoint(mod_ok);
+  }
   return ret;
 }
 
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AutoVacuum.h"
+#include "TableOptimizer.h"
+
+#include "Catalog/Catalog.h"
+#include "LockMgr/LockMgr.h"
+#include "LockMgr/TableLockMgr.h"
+#include "Shared/Logger.h"
+
+#include <chrono>
+#include <thread>
+
+bool g_enable_auto_vacuum{false};
+size_t g_auto_vacuum_interval_seconds{300};
+double g_auto_vacuum_dirty_fragment_fraction{0.25};
+
+namespace {
+
+// Fraction of a table's fragments whose $deleted column metadata shows at
+// least one deleted row. The chunk metadata only records whether a fragment
+// has deletions, not how many, so the threshold is over dirty fragments.
+double dirty_fragment_fraction(const Catalog_Namespace::Catalog& cat,
+                               const TableDescriptor* td,
+                               const ColumnDescriptor* cd) {
+  ChunkKey chunk_key_prefix{cat.getCurrentDB().dbId, td->tableId, cd->columnId};
+  std::vector<std::pair<ChunkKey, ChunkMetadata>> chunk_metadata_vec;
+  cat.getDataMgr().getChunkMetadataVecForKeyPrefix(chunk_metadata_vec, chunk_key_prefix);
+  if (chunk_metadata_vec.empty()) {
+    return 0.;
+  }
+  size_t dirty_fragments = 0;
+  for (const auto& chunk_metadata : chunk_metadata_vec) {
+    if (chunk_metadata.second.chunkStats.max.tinyintval == 1) {
+      ++dirty_fragments;
+    }
+  }
+  return static_cast<double>(dirty_fragments) /
+         static_cast<double>(chunk_metadata_vec.size());
+}
+
+void vacuum_table(const Catalog_Namespace::Catalog& cat,
+                  const std::string& table_name,
+                  const MapDParameters& mapd_parameters) {
+  // Same locks as the OPTIMIZE TABLE handler; writers and checkpoints to this
+  // table wait, everything else proceeds.
+  auto chkpt_lock = Lock_Namespace::getTableLock<mapd_shared_mutex, mapd_unique_lock>(
+      cat, table_name, Lock_Namespace::LockType::CheckpointLock);
+  auto table_write_lock =
+      Lock_Namespace::TableLockMgr::getWriteLockForTable(cat, table_name);
+
+  const auto td = cat.getMetadataForTable(table_name, /*populateFragmenter=*/true);
+  if (!td) {
+    return;
+  }
+  auto executor =
+      Executor::getExecutor(cat.getCurrentDB().dbId, "", "", mapd_parameters, nullptr);
+  const TableOptimizer optimizer(td, executor.get(), cat);
+  optimizer.vacuumDeletedRows();
+  optimizer.recomputeMetadata();
+}
+
+}  // namespace
+
+void auto_vacuum(std::atomic<bool>& program_is_running,
+                 const unsigned int wait_interval_seconds,
+                 const MapDParameters mapd_parameters) {
+  const auto wait_duration = std::chrono::seconds(wait_interval_seconds);
+  while (program_is_running) {
+    std::this_thread::sleep_for(wait_duration);
+    if (!program_is_running) {
+      break;
+    }
+    for (const auto& cat : Catalog_Namespace::Catalog::getAllCatalogs()) {
+      for (const auto td : cat->getAllTableMetadata()) {
+        if (!program_is_running) {
+          return;
+        }
+        if (td->isView || !td->hasDeletedCol || td->shard >= 0 ||
+            td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL) {
+          continue;
+        }
+        const auto cd = cat->getDeletedColumn(td);
+        if (!cd) {
+          continue;
+        }
+        const auto dirty_fraction = dirty_fragment_fraction(*cat, td, cd);
+        if (dirty_fraction < g_auto_vacuum_dirty_fragment_fraction) {
+          continue;
+        }
+        LOG(INFO) << "Auto vacuum: compacting table " << td->tableName << " ("
+                  << dirty_fraction * 100. << "% of fragments have deleted rows)";
+        try {
+          vacuum_table(*cat, td->tableName, mapd_parameters);
+        } catch (const std::exception& e) {
+          LOG(ERROR) << "Auto vacuum failed for table " << td->tableName << ": "
+                     << e.what();
+        }
+      }
+    }
+  }
+  VLOG(1) << "auto vacuum thread exiting";
+}
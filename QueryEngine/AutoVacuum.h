@@ -0,0 +1,33 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QUERYENGINE_AUTOVACUUM_H
+#define QUERYENGINE_AUTOVACUUM_H
+
+#include "Shared/MapDParameters.h"
+
+#include <atomic>
+
+// Background vacuum loop, run on its own thread like file_delete. Wakes up
+// periodically, scans every registered catalog for tables whose $deleted
+// column metadata shows enough fragments with deleted rows, and runs the same
+// vacuum plus metadata recompute as OPTIMIZE TABLE under the same checkpoint
+// and table write locks, one table at a time.
+void auto_vacuum(std::atomic<bool>& program_is_running,
+                 const unsigned int wait_interval_seconds,
+                 const MapDParameters mapd_parameters);
+
+#endif  // QUERYENGINE_AUTOVACUUM_H
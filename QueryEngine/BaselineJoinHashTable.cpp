@@ -27,6 +27,8 @@
 std::vector<std::pair<BaselineJoinHashTable::HashTableCacheKey,
                       BaselineJoinHashTable::HashTableCacheValue>>
     BaselineJoinHashTable::hash_table_cache_;
+std::vector<std::pair<BaselineJoinHashTable::HashTableCacheKey, size_t>>
+    BaselineJoinHashTable::tuple_count_cache_;
 std::mutex BaselineJoinHashTable::hash_table_cache_mutex_;
 
 std::shared_ptr<BaselineJoinHashTable> BaselineJoinHashTable::getInstance(
@@ -169,6 +171,12 @@ BaselineJoinHashTable::CompositeKeyInfo BaselineJoinHashTable::getCompositeKeyIn
       sd_inner_proxy_per_key.emplace_back();
       sd_outer_proxy_per_key.emplace_back();
     }
+    if (inner_col->get_table_id() > 0) {
+      // Tie the cache key to the inner table's current epoch so hash tables
+      // built before a checkpoint or rollback never validate against newer data.
+      cache_key_chunks_for_column.push_back(executor_->getCatalog()->getTableEpoch(
+          executor_->getCatalog()->getCurrentDB().dbId, inner_col->get_table_id()));
+    }
     cache_key_chunks.push_back(cache_key_chunks_for_column);
   }
   return {sd_inner_proxy_per_key, sd_outer_proxy_per_key, cache_key_chunks};
@@ -225,34 +233,67 @@ void BaselineJoinHashTable::reifyWithLayout(
     const auto columns_for_device = fetchColumnsForDevice(fragments, device_id);
     columns_per_device.push_back(columns_for_device);
   }
+  size_t tuple_count{0};
   if (layout == JoinHashTableInterface::HashType::OneToMany) {
     CHECK(!columns_per_device.front().join_columns.empty());
     emitted_keys_count_ = columns_per_device.front().join_columns.front().num_elems;
-    size_t tuple_count;
     std::tie(tuple_count, std::ignore) = approximateTupleCount(columns_per_device);
-    const auto entry_count = 2 * std::max(tuple_count, size_t(1));
+    tuple_count = std::max(tuple_count, size_t(1));
+    const auto entry_count = 2 * tuple_count;
 
     entry_count_ =
         get_entries_per_device(entry_count, shard_count, device_count, memory_level_);
   }
-  std::vector<std::future<void>> init_threads;
-  for (int device_id = 0; device_id < device_count; ++device_id) {
-    const auto fragments =
-        shard_count
-            ? only_shards_for_device(query_info.fragments, device_id, device_count)
-            : query_info.fragments;
-    init_threads.push_back(std::async(std::launch::async,
-                                      &BaselineJoinHashTable::reifyForDevice,
-                                      this,
-                                      columns_per_device[device_id],
-                                      layout,
-                                      device_id));
-  }
-  for (auto& init_thread : init_threads) {
-    init_thread.wait();
+  // The entry count above is only an estimate; the fill kernels report a full
+  // table instead of overrunning it. Grow and rebuild from the fetched columns
+  // until the build fits (the kernels don't support rehashing a populated
+  // table in place), then feed the corrected cardinality back into the tuple
+  // count cache so later builds of the same data start from the observed size.
+  while (true) {
+    std::vector<std::future<void>> init_threads;
+    for (int device_id = 0; device_id < device_count; ++device_id) {
+      const auto fragments =
+          shard_count
+              ? only_shards_for_device(query_info.fragments, device_id, device_count)
+              : query_info.fragments;
+      init_threads.push_back(std::async(std::launch::async,
+                                        &BaselineJoinHashTable::reifyForDevice,
+                                        this,
+                                        columns_per_device[device_id],
+                                        layout,
+                                        device_id));
+    }
+    for (auto& init_thread : init_threads) {
+      init_thread.wait();
+    }
+    try {
+      for (auto& init_thread : init_threads) {
+        init_thread.get();
+      }
+    } catch (const HashTableFull&) {
+      // A one-to-one build which ran out of slots was defeated by duplicate
+      // keys, not by undersizing; let the caller fall back to one-to-many.
+      if (layout != JoinHashTableInterface::HashType::OneToMany ||
+          2 * entry_count_ >
+              static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        throw;
+      }
+      freeHashBufferMemory();
+      tuple_count *= 2;
+      entry_count_ *= 2;
+      continue;
+    }
+    break;
   }
-  for (auto& init_thread : init_threads) {
-    init_thread.get();
+  if (layout == JoinHashTableInterface::HashType::OneToMany &&
+      getInnerTableId() > 0) {
+    const auto inner_outer_pairs = normalize_column_pairs(
+        condition_.get(), *executor_->getCatalog(), executor_->getTemporaryTables());
+    const auto composite_key_info = getCompositeKeyInfo(inner_outer_pairs);
+    putTupleCountToCache({columns_per_device.front().join_columns.front().num_elems,
+                          composite_key_info.cache_key_chunks,
+                          condition_->get_optype()},
+                         tuple_count);
   }
 }
 
@@ -274,15 +315,26 @@ std::pair<size_t, size_t> BaselineJoinHashTable::approximateTupleCount(
 
   CHECK(!columns_per_device.empty() && !columns_per_device.front().join_columns.empty());
 
+  const auto composite_key_info = getCompositeKeyInfo(inner_outer_pairs);
+  const HashTableCacheKey cache_key{
+      columns_per_device.front().join_columns.front().num_elems,
+      composite_key_info.cache_key_chunks,
+      condition_->get_optype()};
+
   if (effective_memory_level == Data_Namespace::MemoryLevel::CPU_LEVEL) {
-    const auto composite_key_info = getCompositeKeyInfo(inner_outer_pairs);
-    HashTableCacheKey cache_key{columns_per_device.front().join_columns.front().num_elems,
-                                composite_key_info.cache_key_chunks,
-                                condition_->get_optype()};
     const auto cached_count_info = getApproximateTupleCountFromCache(cache_key);
     if (cached_count_info.first >= 0) {
       return std::make_pair(cached_count_info.first, cached_count_info.second);
     }
+  }
+  // A previous build of the same data already observed the cardinality; skip
+  // the count distinct estimator pass entirely.
+  const auto cached_tuple_count = getCachedTupleCount(cache_key);
+  if (cached_tuple_count >= 0) {
+    return std::make_pair(static_cast<size_t>(cached_tuple_count), 0);
+  }
+
+  if (effective_memory_level == Data_Namespace::MemoryLevel::CPU_LEVEL) {
     int thread_count = cpu_threads();
     std::vector<uint8_t> hll_buffer_all_cpus(thread_count * padded_size_bytes);
     auto hll_result = &hll_buffer_all_cpus[0];
@@ -475,6 +527,8 @@ void BaselineJoinHashTable::reifyForDevice(const ColumnsForDevice& columns_for_d
                                           device_id);
   if (err) {
     switch (err) {
+      case ERR_HASH_TABLE_FULL:
+        throw HashTableFull();
       case ERR_FAILED_TO_FETCH_COLUMN:
         throw FailedToFetchColumn();
       case ERR_FAILED_TO_JOIN_ON_VIRTUAL_COLUMN:
@@ -922,6 +976,21 @@ int BaselineJoinHashTable::initHashTableForDevice(
       throw TooManyHashEntries();
     }
 
+    // Bail out with a descriptive reason before attempting an allocation which
+    // cannot succeed, rather than aborting mid-build on an OutOfMemory error.
+    // TODO(engine): probing is done by the compiled query kernel against a fully
+    // resident table, so a build side larger than device memory would need
+    // partition-wise kernel dispatch (radix-partition both sides and probe one
+    // partition pair at a time) to stay on GPU.
+    const auto device_props = data_mgr.getCudaMgr()->getDeviceProperties(device_id);
+    CHECK(device_props);
+    if (hash_table_size > device_props->globalMem) {
+      throw HashJoinFail(
+          "Hash table for join exceeds GPU device memory (" +
+          std::to_string(hash_table_size) + " > " +
+          std::to_string(device_props->globalMem) + " bytes)");
+    }
+
     VLOG(1) << "Initializing GPU Hash Table for device " << device_id << " with "
             << entry_count_ << " hash entries and " << one_to_many_hash_entries
             << " entries in the one to many buffer";
@@ -1175,6 +1244,29 @@ std::pair<ssize_t, size_t> BaselineJoinHashTable::getApproximateTupleCountFromCa
   return std::make_pair(-1, 0);
 }
 
+ssize_t BaselineJoinHashTable::getCachedTupleCount(const HashTableCacheKey& key) const {
+  std::lock_guard<std::mutex> hash_table_cache_lock(hash_table_cache_mutex_);
+  for (const auto& kv : tuple_count_cache_) {
+    if (kv.first == key) {
+      return kv.second;
+    }
+  }
+  return -1;
+}
+
+void BaselineJoinHashTable::putTupleCountToCache(const HashTableCacheKey& key,
+                                                 const size_t tuple_count) {
+  std::lock_guard<std::mutex> hash_table_cache_lock(hash_table_cache_mutex_);
+  for (auto& kv : tuple_count_cache_) {
+    if (kv.first == key) {
+      // Overwrite a stale estimate with the count observed by this build.
+      kv.second = tuple_count;
+      return;
+    }
+  }
+  tuple_count_cache_.emplace_back(key, tuple_count);
+}
+
 bool BaselineJoinHashTable::isBitwiseEq() const {
   return condition_->get_optype() == kBW_EQ;
 }
@@ -80,6 +80,7 @@ class BaselineJoinHashTable : public JoinHashTableInterface {
     return []() -> void {
       std::lock_guard<std::mutex> guard(hash_table_cache_mutex_);
       hash_table_cache_.clear();
+      tuple_count_cache_.clear();
     };
   }
 
@@ -108,7 +109,9 @@ class BaselineJoinHashTable : public JoinHashTableInterface {
     const std::vector<JoinColumn> join_columns;
     const std::vector<JoinColumnTypeInfo> join_column_types;
     const std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
-    const std::vector<JoinBucketInfo> join_buckets;
+    // Not const: the overlaps bucket tuning loop rewrites the bucket sizes
+    // in place when it coarsens the grid.
+    std::vector<JoinBucketInfo> join_buckets;
   };
 
   virtual ColumnsForDevice fetchColumnsForDevice(
@@ -183,10 +186,15 @@ class BaselineJoinHashTable : public JoinHashTableInterface {
     const size_t num_elements;
     const std::vector<ChunkKey> chunk_keys;
     const SQLOps optype;
+    // Only set for overlaps joins, where the same column can be bucketed at
+    // different granularities; zero for regular baseline hash joins.
+    const double overlaps_hashjoin_bucket_threshold = 0.;
 
     bool operator==(const struct HashTableCacheKey& that) const {
       return num_elements == that.num_elements && chunk_keys == that.chunk_keys &&
-             optype == that.optype;
+             optype == that.optype &&
+             overlaps_hashjoin_bucket_threshold ==
+                 that.overlaps_hashjoin_bucket_threshold;
     }
   };
 
@@ -197,6 +205,10 @@ class BaselineJoinHashTable : public JoinHashTableInterface {
   std::pair<ssize_t, size_t> getApproximateTupleCountFromCache(
       const HashTableCacheKey&) const;
 
+  ssize_t getCachedTupleCount(const HashTableCacheKey&) const;
+
+  void putTupleCountToCache(const HashTableCacheKey&, const size_t tuple_count);
+
   bool isBitwiseEq() const;
 
   void freeHashBufferMemory();
@@ -231,8 +243,14 @@ class BaselineJoinHashTable : public JoinHashTableInterface {
   };
 
   static std::vector<std::pair<HashTableCacheKey, HashTableCacheValue>> hash_table_cache_;
+  // Build-side tuple counts observed by previous executions. Unlike
+  // hash_table_cache_, entries are added by GPU builds too, where the table
+  // itself cannot be cached, and are corrected when a build overflows its
+  // estimate and has to grow.
+  static std::vector<std::pair<HashTableCacheKey, size_t>> tuple_count_cache_;
   static std::mutex hash_table_cache_mutex_;
 
+  static const int ERR_HASH_TABLE_FULL{-1};
   static const int ERR_FAILED_TO_FETCH_COLUMN{-3};
   static const int ERR_FAILED_TO_JOIN_ON_VIRTUAL_COLUMN{-4};
 };
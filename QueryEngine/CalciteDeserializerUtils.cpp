@@ -39,6 +39,10 @@ SQLTypeInfo get_agg_type(const SQLAgg agg_kind, const Analyzer::Expr* arg_expr)
       return SQLTypeInfo(kBIGINT, false);
     case kSAMPLE:
       return arg_expr->get_type_info();
+    case kAPPROX_MEDIAN:
+      return SQLTypeInfo(kDOUBLE, false);
+    case kAPPROX_TOP_K:
+      return arg_expr->get_type_info();
     default:
       CHECK(false);
   }
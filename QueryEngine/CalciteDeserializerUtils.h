@@ -110,6 +110,12 @@ inline SQLAgg to_agg_kind(const std::string& agg_name) {
   if (agg_name == std::string("SAMPLE") || agg_name == std::string("LAST_SAMPLE")) {
     return kSAMPLE;
   }
+  if (agg_name == std::string("APPROX_MEDIAN")) {
+    return kAPPROX_MEDIAN;
+  }
+  if (agg_name == std::string("APPROX_TOP_K")) {
+    return kAPPROX_TOP_K;
+  }
   throw std::runtime_error("Aggregate function " + agg_name + " not supported");
 }
 
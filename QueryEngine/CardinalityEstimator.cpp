@@ -18,6 +18,72 @@
 #include "ExpressionRewrite.h"
 #include "RelAlgExecutor.h"
 
+#include <sstream>
+
+namespace {
+
+// Cache key for an estimator execution unit: the expressions it evaluates plus
+// the generation and epoch of every physical input table. Any insert, delete
+// or rollback changes the key, so cached estimations never outlive the data
+// they were computed from.
+std::string cardinality_cache_key(const RelAlgExecutionUnit& ra_exe_unit,
+                                  const Catalog_Namespace::Catalog& cat,
+                                  const Executor* executor) {
+  std::ostringstream os;
+  for (const auto& input_desc : ra_exe_unit.input_descs) {
+    const auto table_id = input_desc.getTableId();
+    os << "table(" << table_id;
+    if (table_id > 0) {
+      const auto& table_generation = executor->getTableGeneration(table_id);
+      os << "," << table_generation.tuple_count << "," << table_generation.start_rowid
+         << "," << cat.getTableEpoch(cat.getCurrentDB().dbId, table_id);
+    }
+    os << ")";
+  }
+  for (const auto& simple_qual : ra_exe_unit.simple_quals) {
+    os << simple_qual->toString();
+  }
+  for (const auto& qual : ra_exe_unit.quals) {
+    os << qual->toString();
+  }
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    for (const auto& qual : join_condition.quals) {
+      os << qual->toString();
+    }
+  }
+  CHECK(ra_exe_unit.estimator);
+  for (const auto& expr : ra_exe_unit.estimator->getArgument()) {
+    if (expr) {
+      os << expr->toString();
+    }
+  }
+  return os.str();
+}
+
+}  // namespace
+
+std::unordered_map<std::string, size_t> CardinalityCache::cardinality_cache_;
+std::mutex CardinalityCache::cardinality_cache_mutex_;
+
+void CardinalityCache::set(const std::string& key, const size_t estimation) {
+  std::lock_guard<std::mutex> cache_lock(cardinality_cache_mutex_);
+  cardinality_cache_[key] = estimation;
+}
+
+std::pair<size_t, bool> CardinalityCache::get(const std::string& key) {
+  std::lock_guard<std::mutex> cache_lock(cardinality_cache_mutex_);
+  const auto it = cardinality_cache_.find(key);
+  if (it == cardinality_cache_.end()) {
+    return {0, false};
+  }
+  return {it->second, true};
+}
+
+void CardinalityCache::clear() {
+  std::lock_guard<std::mutex> cache_lock(cardinality_cache_mutex_);
+  cardinality_cache_.clear();
+}
+
 size_t ResultSet::getNDVEstimator() const {
   CHECK(dynamic_cast<const Analyzer::NDVEstimator*>(estimator_.get()));
   CHECK(host_estimator_buffer_);
@@ -37,6 +103,11 @@ size_t RelAlgExecutor::getNDVEstimation(const WorkUnit& work_unit,
                                         const CompilationOptions& co,
                                         const ExecutionOptions& eo) {
   const auto estimator_exe_unit = create_ndv_execution_unit(work_unit.exe_unit);
+  const auto cache_key = cardinality_cache_key(estimator_exe_unit, cat_, executor_);
+  const auto cached_estimation = CardinalityCache::get(cache_key);
+  if (cached_estimation.second) {
+    return cached_estimation.first;
+  }
   int32_t error_code{0};
   size_t one{1};
   ColumnCacheMap column_cache;
@@ -66,7 +137,9 @@ size_t RelAlgExecutor::getNDVEstimation(const WorkUnit& work_unit,
   if (!estimator_result) {
     return 1;
   }
-  return std::max(estimator_result->getNDVEstimator(), size_t(1));
+  const auto estimation = std::max(estimator_result->getNDVEstimator(), size_t(1));
+  CardinalityCache::set(cache_key, estimation);
+  return estimation;
 }
 
 RelAlgExecutionUnit create_ndv_execution_unit(const RelAlgExecutionUnit& ra_exe_unit) {
@@ -30,6 +30,10 @@
 #include "../Analyzer/Analyzer.h"
 #include "Shared/Logger.h"
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 class CardinalityEstimationRequired : public std::runtime_error {
  public:
   CardinalityEstimationRequired() : std::runtime_error("CardinalityEstimationRequired") {}
@@ -113,4 +117,21 @@ ResultSetPtr reduce_estimator_results(
     const RelAlgExecutionUnit& ra_exe_unit,
     std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device);
 
+// Results of previously executed estimator queries, keyed by the estimated
+// expressions and the generation and epoch of every input table. Repeat
+// queries skip the estimation pass; an insert or rollback changes the key,
+// so stale entries are never returned.
+class CardinalityCache {
+ public:
+  static void set(const std::string& key, const size_t estimation);
+
+  static std::pair<size_t, bool> get(const std::string& key);
+
+  static void clear();
+
+ private:
+  static std::unordered_map<std::string, size_t> cardinality_cache_;
+  static std::mutex cardinality_cache_mutex_;
+};
+
 #endif  // QUERYENGINE_CARDINALITYESTIMATOR_H
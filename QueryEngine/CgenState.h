@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "DictStringLengthTable.h"
 #include "IRCodegenUtils.h"
 #include "InValuesBitmap.h"
 #include "InputMetadata.h"
@@ -197,6 +198,12 @@ struct CgenState {
     in_values_bitmaps_.emplace_back(std::move(in_values_bitmap));
     return in_values_bitmaps_.back().get();
   }
+
+  const DictStringLengthTable* addDictStringLengthTable(
+      std::unique_ptr<DictStringLengthTable>& dict_length_table) {
+    dict_length_tables_.emplace_back(std::move(dict_length_table));
+    return dict_length_tables_.back().get();
+  }
   // look up a runtime function based on the name, return type and type of
   // the arguments and call it; x64 only, don't call from GPU codegen
   llvm::Value* emitExternalCall(const std::string& fname,
@@ -253,6 +260,11 @@ struct CgenState {
   llvm::ValueToValueMapTy vmap_;  // used for cloning the runtime module
   llvm::IRBuilder<> ir_builder_;
   std::unordered_map<int, std::vector<llvm::Value*>> fetch_cache_;
+  // Values already generated for scalar subexpressions, keyed by the canonical
+  // form of the expression, so repeated subexpressions are computed once per
+  // row. Snapshotted and restored by Executor::FetchCacheAnchor wherever
+  // control flow diverges, for the same reason as fetch_cache_.
+  std::unordered_map<std::string, std::vector<llvm::Value*>> cse_cache_;
   struct FunctionOperValue {
     const Analyzer::FunctionOper* foper;
     llvm::Value* lv;
@@ -265,6 +277,7 @@ struct CgenState {
   std::vector<llvm::Value*> outer_join_match_found_per_level_;
   std::unordered_map<int, llvm::Value*> scan_idx_to_hash_pos_;
   std::vector<std::unique_ptr<const InValuesBitmap>> in_values_bitmaps_;
+  std::vector<std::unique_ptr<const DictStringLengthTable>> dict_length_tables_;
   const std::vector<InputTableInfo>& query_infos_;
   bool needs_error_check_;
 
@@ -103,7 +103,9 @@ class CodeGenerator {
 
   static bool prioritizeQuals(const RelAlgExecutionUnit& ra_exe_unit,
                               std::vector<Analyzer::Expr*>& primary_quals,
-                              std::vector<Analyzer::Expr*>& deferred_quals);
+                              std::vector<Analyzer::Expr*>& deferred_quals,
+                              const std::vector<InputTableInfo>& query_infos,
+                              const Executor* executor);
 
   struct ExecutorRequired : public std::runtime_error {
     ExecutorRequired()
@@ -111,6 +113,12 @@ class CodeGenerator {
   };
 
  private:
+  // Type-based dispatch for the public codegen entry point, which layers the
+  // common subexpression cache on top of this.
+  std::vector<llvm::Value*> codegenDispatch(const Analyzer::Expr*,
+                                            const bool fetch_columns,
+                                            const CompilationOptions&);
+
   std::vector<llvm::Value*> codegen(const Analyzer::Constant*,
                                     const EncodingType enc_type,
                                     const int dict_id,
@@ -288,7 +296,8 @@ class CodeGenerator {
                           const SQLTypeInfo&,
                           bool downscale = true);
 
-  llvm::Value* codegenDiv(llvm::Value*,
+  llvm::Value* codegenDiv(const Analyzer::BinOper*,
+                          llvm::Value*,
                           llvm::Value*,
                           const std::string& null_typename,
                           const std::string& null_check_suffix,
@@ -297,7 +306,8 @@ class CodeGenerator {
 
   llvm::Value* codegenDeciDiv(const Analyzer::BinOper*, const CompilationOptions&);
 
-  llvm::Value* codegenMod(llvm::Value*,
+  llvm::Value* codegenMod(const Analyzer::BinOper*,
+                          llvm::Value*,
                           llvm::Value*,
                           const std::string& null_typename,
                           const std::string& null_check_suffix,
@@ -344,6 +354,12 @@ class CodeGenerator {
   llvm::Value* codegenLogicalShortCircuit(const Analyzer::BinOper*,
                                           const CompilationOptions&);
 
+  // Evaluates LENGTH / CHAR_LENGTH on a dictionary-encoded column as a
+  // gather from a per-dictionary precomputed length table, which works on
+  // GPU as well; returns null when the argument shape doesn't allow it.
+  llvm::Value* codegenDictCharLength(const Analyzer::CharLengthExpr* expr,
+                                     const CompilationOptions& co);
+
   llvm::Value* codegenDictLike(const std::shared_ptr<Analyzer::Expr> arg,
                                const Analyzer::Constant* pattern,
                                const bool ilike,
@@ -384,6 +400,12 @@ class CodeGenerator {
 
   bool checkExpressionRanges(const Analyzer::BinOper*, int64_t, int64_t);
 
+  bool checkExpressionRange(const Analyzer::Expr*, int64_t, int64_t);
+
+  bool checkExpressionRangeExcludesZero(const Analyzer::Expr*);
+
+  bool isNullFreeOperand(const Analyzer::Expr* expr);
+
   struct ArgNullcheckBBs {
     llvm::BasicBlock* args_null_bb;
     llvm::BasicBlock* args_notnull_bb;
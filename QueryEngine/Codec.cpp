@@ -83,6 +83,65 @@ llvm::Instruction* FixedWidthReal::codegenDecode(llvm::Value* byte_stream,
   return llvm::CallInst::Create(f, args);
 }
 
+DictFixedWidthInt::DictFixedWidthInt(const size_t code_byte_width,
+                                     const size_t value_byte_width,
+                                     const int64_t dict_offset)
+    : code_byte_width_{code_byte_width}
+    , value_byte_width_{value_byte_width}
+    , dict_offset_{dict_offset} {}
+
+llvm::Instruction* DictFixedWidthInt::codegenDecode(llvm::Value* byte_stream,
+                                                    llvm::Value* pos,
+                                                    llvm::Module* module) const {
+  auto& context = getGlobalLLVMContext();
+  auto f = module->getFunction("fixed_width_dict_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), code_byte_width_),
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), value_byte_width_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), dict_offset_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
+
+LinearFixedWidthInt::LinearFixedWidthInt(const size_t byte_width,
+                                         const int64_t base,
+                                         const int64_t slope)
+    : byte_width_{byte_width}, base_{base}, slope_{slope} {}
+
+llvm::Instruction* LinearFixedWidthInt::codegenDecode(llvm::Value* byte_stream,
+                                                      llvm::Value* pos,
+                                                      llvm::Module* module) const {
+  auto& context = getGlobalLLVMContext();
+  auto f = module->getFunction("fixed_width_linear_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), byte_width_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), base_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), slope_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
+
+RunLengthInt::RunLengthInt(const size_t value_byte_width, const int64_t run_count)
+    : value_byte_width_{value_byte_width}, run_count_{run_count} {}
+
+llvm::Instruction* RunLengthInt::codegenDecode(llvm::Value* byte_stream,
+                                               llvm::Value* pos,
+                                               llvm::Module* module) const {
+  auto& context = getGlobalLLVMContext();
+  auto f = module->getFunction("run_length_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), value_byte_width_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), run_count_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
+
 FixedWidthSmallDate::FixedWidthSmallDate(const size_t byte_width)
     : byte_width_{byte_width}, null_val_{byte_width == 4 ? NULL_INT : NULL_SMALLINT} {}
 
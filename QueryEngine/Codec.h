@@ -76,6 +76,52 @@ class FixedWidthReal : public Decoder {
   const bool is_double_;
 };
 
+// Per-chunk dictionary encoding: a codes array followed by the dictionary of
+// decoded values at dict_offset bytes into the chunk.
+class DictFixedWidthInt : public Decoder {
+ public:
+  DictFixedWidthInt(const size_t code_byte_width,
+                    const size_t value_byte_width,
+                    const int64_t dict_offset);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* module) const override;
+
+ private:
+  const size_t code_byte_width_;
+  const size_t value_byte_width_;
+  const int64_t dict_offset_;
+};
+
+// Delta-of-delta encoding for append-ordered time columns: narrow per-row
+// residuals against the base + slope * pos line stored in the chunk metadata.
+class LinearFixedWidthInt : public Decoder {
+ public:
+  LinearFixedWidthInt(const size_t byte_width, const int64_t base, const int64_t slope);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* module) const override;
+
+ private:
+  const size_t byte_width_;
+  const int64_t base_;
+  const int64_t slope_;
+};
+
+// Run-length encoding: ascending int64 run end positions followed by one value
+// per run; the decode binary-searches the run containing the position.
+class RunLengthInt : public Decoder {
+ public:
+  RunLengthInt(const size_t value_byte_width, const int64_t run_count);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* module) const override;
+
+ private:
+  const size_t value_byte_width_;
+  const int64_t run_count_;
+};
+
 class FixedWidthSmallDate : public Decoder {
  public:
   FixedWidthSmallDate(const size_t byte_width);
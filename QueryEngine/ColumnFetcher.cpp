@@ -15,6 +15,7 @@
  */
 
 #include "ColumnFetcher.h"
+#include "Descriptors/QueryFragmentDescriptor.h"
 #include "Execute.h"
 
 ColumnFetcher::ColumnFetcher(Executor* executor, const ColumnCacheMap& column_cache)
@@ -74,7 +75,8 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
             std::shared_ptr<const ColumnarResults>(columnarize_result(
                 executor->row_set_mem_owner_,
                 get_temporary_table(executor->temporary_tables_, hash_col.get_table_id()),
-                frag_id))));
+                frag_id,
+                &catalog.getDataMgr()))));
       }
       col_frag = column_cache[table_id][frag_id].get();
     }
@@ -137,6 +139,7 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
     std::list<ChunkIter>& chunk_iter_holder,
     const Data_Namespace::MemoryLevel memory_level,
     const int device_id) const {
+  INJECT_TIMER(getOneTableColumnFragment);
   static std::mutex varlen_chunk_mutex;  // TODO(alex): remove
   static std::mutex chunk_list_mutex;
   const auto fragments_it = all_tables_fragments.find(table_id);
@@ -209,6 +212,7 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
     const std::map<int, const TableFragments*>& all_tables_fragments,
     const Data_Namespace::MemoryLevel memory_level,
     const int device_id) const {
+  INJECT_TIMER(getAllTableColumnFragments);
   const auto fragments_it = all_tables_fragments.find(table_id);
   CHECK(fragments_it != all_tables_fragments.end());
   const auto fragments = fragments_it->second;
@@ -222,6 +226,9 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
     auto column_it = columnarized_scan_table_cache_.find(col_desc);
     if (column_it == columnarized_scan_table_cache_.end()) {
       for (size_t frag_id = 0; frag_id < frag_count; ++frag_id) {
+        if (executor_->interrupted_) {
+          throw QueryInterrupted();
+        }
         std::list<std::shared_ptr<Chunk_NS::Chunk>> chunk_holder;
         std::list<ChunkIter> chunk_iter_holder;
         const auto& fragment = (*fragments)[frag_id];
@@ -256,6 +263,167 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
       table_column, 0, &executor_->getCatalog()->getDataMgr(), memory_level, device_id);
 }
 
+const int8_t* ColumnFetcher::linearizeColumnFragments(
+    const int table_id,
+    const int col_id,
+    const std::map<int, const TableFragments*>& all_tables_fragments,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_id) const {
+  INJECT_TIMER(linearizeColumnFragments);
+  const auto fragments_it = all_tables_fragments.find(table_id);
+  CHECK(fragments_it != all_tables_fragments.end());
+  const auto fragments = fragments_it->second;
+  const auto frag_count = fragments->size();
+  const InputColDescriptor col_desc(col_id, table_id, int(0));
+  CHECK(col_desc.getScanDesc().getSourceType() == InputSourceType::TABLE);
+  CHECK_GT(table_id, 0);
+  const auto& cat = *executor_->getCatalog();
+  auto cd = get_column_descriptor(col_id, table_id, cat);
+  CHECK(cd);
+  const bool is_varlen = cd->columnType.get_size() < 0;
+  LinearizedVarlenChunk* merged{nullptr};
+  std::lock_guard<std::mutex> linearization_guard(linearization_mutex_);
+  auto merged_it = linearized_varlen_chunk_cache_.find(col_desc);
+  if (merged_it != linearized_varlen_chunk_cache_.end()) {
+    merged = merged_it->second.get();
+  } else {
+    // Gather every fragment's chunk at CPU level; the chunks only have to
+    // stay pinned until their contents land in the merged buffers.
+    std::list<std::shared_ptr<Chunk_NS::Chunk>> chunk_holder;
+    std::vector<size_t> elem_counts;
+    size_t total_elems{0};
+    size_t total_data_size{0};
+    for (size_t frag_id = 0; frag_id < frag_count; ++frag_id) {
+      if (executor_->interrupted_) {
+        throw QueryInterrupted();
+      }
+      const auto& fragment = (*fragments)[frag_id];
+      if (fragment.isEmptyPhysicalFragment()) {
+        continue;
+      }
+      auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_id);
+      CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+      ChunkKey chunk_key{
+          cat.getCurrentDB().dbId, fragment.physicalTableId, col_id, fragment.fragmentId};
+      auto chunk = Chunk_NS::Chunk::getChunk(cd,
+                                             &cat.getDataMgr(),
+                                             chunk_key,
+                                             Data_Namespace::CPU_LEVEL,
+                                             0,
+                                             chunk_meta_it->second.numBytes,
+                                             chunk_meta_it->second.numElements);
+      CHECK(chunk);
+      chunk_holder.push_back(chunk);
+      elem_counts.push_back(chunk_meta_it->second.numElements);
+      total_elems += chunk_meta_it->second.numElements;
+      total_data_size += chunk->get_buffer()->size();
+    }
+    CHECK(!chunk_holder.empty());
+    auto linearized = boost::make_unique<LinearizedVarlenChunk>();
+    linearized->data_size = total_data_size;
+    linearized->data_buf.reset(reinterpret_cast<int8_t*>(checked_malloc(total_data_size)));
+    if (is_varlen) {
+      // The merged index carries one offset per element plus the trailing end
+      // offset; every offset fits the narrow StringOffsetT only as long as the
+      // packed values do.
+      CHECK_LT(total_data_size,
+               static_cast<size_t>(std::numeric_limits<StringOffsetT>::max()));
+      linearized->index_size = (total_elems + 1) * sizeof(StringOffsetT);
+      linearized->index_buf.reset(
+          reinterpret_cast<int8_t*>(checked_malloc(linearized->index_size)));
+    }
+    auto merged_index = reinterpret_cast<StringOffsetT*>(linearized->index_buf.get());
+    size_t elem_pos{0};
+    size_t data_pos{0};
+    size_t frag_idx{0};
+    for (const auto& chunk : chunk_holder) {
+      const auto data_buf = chunk->get_buffer();
+      CHECK(data_buf->getMemoryPtr());
+      memcpy(linearized->data_buf.get() + data_pos, data_buf->getMemoryPtr(), data_buf->size());
+      if (is_varlen) {
+        const auto index_buf = chunk->get_index_buf();
+        CHECK(index_buf);
+        CHECK(index_buf->getMemoryPtr());
+        const auto frag_offsets =
+            reinterpret_cast<const StringOffsetT*>(index_buf->getMemoryPtr());
+        const auto frag_elem_count = elem_counts[frag_idx];
+        CHECK_EQ((frag_elem_count + 1) * sizeof(StringOffsetT), index_buf->size());
+        if (elem_pos == 0) {
+          merged_index[0] = frag_offsets[0];
+        }
+        // Rebase by the bytes packed before this fragment, preserving the
+        // negative sign which marks nulls. Entry zero of every later fragment
+        // is covered by the previous fragment's end offset, which already
+        // carries the right sign for the preceding row.
+        const auto data_off = static_cast<StringOffsetT>(data_pos);
+        for (size_t i = 1; i <= frag_elem_count; ++i) {
+          merged_index[elem_pos + i] = frag_offsets[i] >= 0 ? frag_offsets[i] + data_off
+                                                            : frag_offsets[i] - data_off;
+        }
+        elem_pos += frag_elem_count;
+      }
+      data_pos += data_buf->size();
+      ++frag_idx;
+    }
+    // Mirror Chunk_NS::Chunk::begin_iterator for the merged buffers.
+    auto& iter = linearized->iter;
+    iter.type_info = cd->columnType;
+    iter.skip = 1;
+    iter.skip_size = cd->columnType.get_size();
+    if (is_varlen) {
+      iter.current_pos = iter.start_pos = linearized->index_buf.get();
+      iter.end_pos =
+          linearized->index_buf.get() + linearized->index_size - sizeof(StringOffsetT);
+      iter.second_buf = linearized->data_buf.get();
+    } else {
+      iter.current_pos = iter.start_pos = linearized->data_buf.get();
+      iter.end_pos = linearized->data_buf.get() + linearized->data_size;
+      iter.second_buf = nullptr;
+    }
+    iter.num_elems = total_elems;
+    merged = linearized.get();
+    linearized_varlen_chunk_cache_.emplace(col_desc, std::move(linearized));
+  }
+  if (memory_level == Data_Namespace::CPU_LEVEL) {
+    return reinterpret_cast<int8_t*>(&merged->iter);
+  }
+  CHECK_EQ(Data_Namespace::GPU_LEVEL, memory_level);
+  auto gpu_iter_it = merged->gpu_iters.find(device_id);
+  if (gpu_iter_it != merged->gpu_iters.end()) {
+    return gpu_iter_it->second;
+  }
+  auto& data_mgr = cat.getDataMgr();
+  auto data_buf_gpu = CudaAllocator::alloc(&data_mgr, merged->data_size, device_id);
+  copy_to_gpu(&data_mgr,
+              reinterpret_cast<CUdeviceptr>(data_buf_gpu),
+              merged->data_buf.get(),
+              merged->data_size,
+              device_id);
+  auto chunk_iter_gpu = merged->iter;
+  if (is_varlen) {
+    auto index_buf_gpu = CudaAllocator::alloc(&data_mgr, merged->index_size, device_id);
+    copy_to_gpu(&data_mgr,
+                reinterpret_cast<CUdeviceptr>(index_buf_gpu),
+                merged->index_buf.get(),
+                merged->index_size,
+                device_id);
+    chunk_iter_gpu.current_pos = chunk_iter_gpu.start_pos = index_buf_gpu;
+    chunk_iter_gpu.end_pos = index_buf_gpu + merged->index_size - sizeof(StringOffsetT);
+    chunk_iter_gpu.second_buf = data_buf_gpu;
+  } else {
+    chunk_iter_gpu.current_pos = chunk_iter_gpu.start_pos = data_buf_gpu;
+    chunk_iter_gpu.end_pos = data_buf_gpu + merged->data_size;
+  }
+  auto iter_gpu = CudaAllocator::alloc(&data_mgr, sizeof(ChunkIter), device_id);
+  copy_to_gpu(&data_mgr,
+              reinterpret_cast<CUdeviceptr>(iter_gpu),
+              &chunk_iter_gpu,
+              sizeof(ChunkIter),
+              device_id);
+  merged->gpu_iters.emplace(device_id, iter_gpu);
+  return iter_gpu;
+}
+
 const int8_t* ColumnFetcher::getResultSetColumn(
     const InputColDescriptor* col_desc,
     const Data_Namespace::MemoryLevel memory_level,
@@ -307,10 +475,13 @@ const int8_t* ColumnFetcher::getResultSetColumn(
     auto& frag_id_to_result = columnarized_table_cache_[table_id];
     int frag_id = 0;
     if (frag_id_to_result.empty() || !frag_id_to_result.count(frag_id)) {
-      frag_id_to_result.insert(
-          std::make_pair(frag_id,
-                         std::shared_ptr<const ColumnarResults>(columnarize_result(
-                             executor_->row_set_mem_owner_, buffer, frag_id))));
+      frag_id_to_result.insert(std::make_pair(
+          frag_id,
+          std::shared_ptr<const ColumnarResults>(
+              columnarize_result(executor_->row_set_mem_owner_,
+                                 buffer,
+                                 frag_id,
+                                 &executor_->getCatalog()->getDataMgr()))));
     }
     CHECK_NE(size_t(0), columnarized_table_cache_.count(table_id));
     result = columnarized_table_cache_[table_id][frag_id].get();
@@ -319,3 +490,60 @@ const int8_t* ColumnFetcher::getResultSetColumn(
   return transferColumnIfNeeded(
       result, col_id, &executor_->getCatalog()->getDataMgr(), memory_level, device_id);
 }
+
+void ColumnFetcher::prefetchFragmentsToCpu(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& query_infos,
+    const std::vector<FragmentsList>& frag_lists,
+    const Catalog_Namespace::Catalog& cat) {
+  std::map<int, const TableFragments*> all_tables_fragments;
+  QueryFragmentDescriptor::computeAllTablesFragments(
+      all_tables_fragments, ra_exe_unit, query_infos);
+  for (const auto& frag_list : frag_lists) {
+    for (const auto& frags_per_table : frag_list) {
+      const auto fragments_it = all_tables_fragments.find(frags_per_table.table_id);
+      if (fragments_it == all_tables_fragments.end()) {
+        continue;
+      }
+      const auto fragments = fragments_it->second;
+      for (const auto frag_id : frags_per_table.fragment_ids) {
+        if (frag_id >= fragments->size()) {
+          continue;
+        }
+        const auto& fragment = (*fragments)[frag_id];
+        if (fragment.isEmptyPhysicalFragment()) {
+          continue;
+        }
+        for (const auto& col_id : ra_exe_unit.input_col_descs) {
+          CHECK(col_id);
+          if (col_id->getScanDesc().getSourceType() != InputSourceType::TABLE ||
+              col_id->getScanDesc().getTableId() != frags_per_table.table_id) {
+            continue;
+          }
+          const auto cd = get_column_descriptor_maybe(
+              col_id->getColId(), frags_per_table.table_id, cat);
+          if (!cd || cd->isVirtualCol) {
+            continue;
+          }
+          auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_id->getColId());
+          if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+            continue;
+          }
+          ChunkKey chunk_key{cat.getCurrentDB().dbId,
+                             fragment.physicalTableId,
+                             col_id->getColId(),
+                             fragment.fragmentId};
+          // Pin briefly at CPU level; dropping the chunk right away leaves the
+          // buffer resident in the pool for the kernel's own fetch.
+          Chunk_NS::Chunk::getChunk(cd,
+                                    &cat.getDataMgr(),
+                                    chunk_key,
+                                    Data_Namespace::CPU_LEVEL,
+                                    0,
+                                    chunk_meta_it->second.numBytes,
+                                    chunk_meta_it->second.numElements);
+        }
+      }
+    }
+  }
+}
@@ -18,6 +18,8 @@
 
 #include "Execute.h"
 
+#include "Shared/checked_alloc.h"
+
 class ColumnFetcher {
  public:
   ColumnFetcher(Executor* executor, const ColumnCacheMap& column_cache);
@@ -59,6 +61,27 @@ class ColumnFetcher {
                                    const Data_Namespace::MemoryLevel memory_level,
                                    const int device_id) const;
 
+  // Stitches the varlen chunks of a column into one linearized chunk -- packed
+  // values plus a rebased offset buffer spanning every fragment -- and returns
+  // a ChunkIter over it, copied to the device for GPU execution. Varlen
+  // columns cannot be columnarized by value, so this is the all-fragments
+  // representation for them; kernels index it by global row id and read the
+  // values coalesced instead of chasing per-fragment chunk iterators.
+  const int8_t* linearizeColumnFragments(
+      const int table_id,
+      const int col_id,
+      const std::map<int, const TableFragments*>& all_tables_fragments,
+      const Data_Namespace::MemoryLevel memory_level,
+      const int device_id) const;
+
+  // Reads the chunks needed by the given kernels into the CPU buffer pool,
+  // overlapping disk I/O with execution of earlier kernels; the kernels' own
+  // fetches then hit the pool instead of disk.
+  static void prefetchFragmentsToCpu(const RelAlgExecutionUnit& ra_exe_unit,
+                                     const std::vector<InputTableInfo>& query_infos,
+                                     const std::vector<FragmentsList>& frag_lists,
+                                     const Catalog_Namespace::Catalog& cat);
+
  private:
   static const int8_t* transferColumnIfNeeded(
       const ColumnarResults* columnar_results,
@@ -84,5 +107,17 @@ class ColumnFetcher {
   mutable std::unordered_map<InputColDescriptor, std::unique_ptr<const ColumnarResults>>
       columnarized_scan_table_cache_;
 
+  struct LinearizedVarlenChunk {
+    std::unique_ptr<int8_t, CheckedAllocDeleter> index_buf;  // rebased offsets
+    std::unique_ptr<int8_t, CheckedAllocDeleter> data_buf;   // packed values
+    size_t index_size{0};
+    size_t data_size{0};
+    ChunkIter iter;                     // iterator over the host buffers
+    std::map<int, int8_t*> gpu_iters;  // device iterator per device id
+  };
+  mutable std::mutex linearization_mutex_;
+  mutable std::unordered_map<InputColDescriptor, std::unique_ptr<LinearizedVarlenChunk>>
+      linearized_varlen_chunk_cache_;
+
   friend class QueryCompilationDescriptor;
 };
@@ -17,6 +17,8 @@
 #include "ColumnarResults.h"
 #include "Descriptors/RowSetMemoryOwner.h"
 
+#include "../DataMgr/DataMgr.h"
+#include "../Shared/ThreadPool.h"
 #include "../Shared/thread_count.h"
 
 #include <atomic>
@@ -37,18 +39,72 @@ int64_t fixed_encoding_nullable_val(const int64_t val, const SQLTypeInfo& type_i
   return val;
 }
 
+/*
+ * Processes and decodes a TargetValue and writes it into the given column
+ * buffer's cell at the given row index. Shared by ColumnarResults and
+ * ColumnarBatchIterator.
+ *
+ * NOTE: this is not supposed to be processing varlen types, and they should be
+ * handled differently outside this function.
+ */
+inline void write_back_cell(const TargetValue& col_val,
+                            const size_t row_idx,
+                            const SQLTypeInfo& type_info,
+                            int8_t* column_buffer) {
+  const auto scalar_col_val = boost::get<ScalarTargetValue>(&col_val);
+  CHECK(scalar_col_val);
+  auto i64_p = boost::get<int64_t>(scalar_col_val);
+  if (i64_p) {
+    const auto val = fixed_encoding_nullable_val(*i64_p, type_info);
+    switch (type_info.get_size()) {
+      case 1:
+        ((int8_t*)column_buffer)[row_idx] = static_cast<int8_t>(val);
+        break;
+      case 2:
+        ((int16_t*)column_buffer)[row_idx] = static_cast<int16_t>(val);
+        break;
+      case 4:
+        ((int32_t*)column_buffer)[row_idx] = static_cast<int32_t>(val);
+        break;
+      case 8:
+        ((int64_t*)column_buffer)[row_idx] = val;
+        break;
+      default:
+        CHECK(false);
+    }
+  } else {
+    CHECK(type_info.is_fp());
+    switch (type_info.get_type()) {
+      case kFLOAT: {
+        auto float_p = boost::get<float>(scalar_col_val);
+        ((float*)column_buffer)[row_idx] = static_cast<float>(*float_p);
+        break;
+      }
+      case kDOUBLE: {
+        auto double_p = boost::get<double>(scalar_col_val);
+        ((double*)column_buffer)[row_idx] = static_cast<double>(*double_p);
+        break;
+      }
+      default:
+        CHECK(false);
+    }
+  }
+}
+
 }  // namespace
 
 ColumnarResults::ColumnarResults(
     const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const ResultSet& rows,
     const size_t num_columns,
-    const std::vector<SQLTypeInfo>& target_types)
+    const std::vector<SQLTypeInfo>& target_types,
+    Data_Namespace::DataMgr* data_mgr)
     : column_buffers_(num_columns)
     , num_rows_(use_parallel_algorithms(rows) || rows.isFastColumnarConversionPossible()
                     ? rows.entryCount()
                     : rows.rowCount())
-    , target_types_(target_types) {
+    , target_types_(target_types)
+    , data_mgr_(data_mgr) {
   column_buffers_.resize(num_columns);
   for (size_t i = 0; i < num_columns; ++i) {
     const bool is_varlen = target_types[i].is_array() ||
@@ -58,9 +114,8 @@ ColumnarResults::ColumnarResults(
     if (is_varlen) {
       throw ColumnarConversionNotSupported();
     }
-    column_buffers_[i] = reinterpret_cast<const int8_t*>(
-        checked_malloc(num_rows_ * target_types[i].get_size()));
-    row_set_mem_owner->addColBuffer(column_buffers_[i]);
+    column_buffers_[i] =
+        allocateBuffer(row_set_mem_owner, num_rows_ * target_types[i].get_size());
   }
   std::atomic<size_t> row_idx{0};
   const auto do_work = [num_columns, this](const std::vector<TargetValue>& crt_row,
@@ -74,27 +129,53 @@ ColumnarResults::ColumnarResults(
     materializeAllColumns(rows, num_columns);
   } else {
     if (use_parallel_algorithms(rows)) {
+      // Two passes with per-thread write cursors instead of a shared atomic
+      // cursor: the first pass counts each range's non-empty entries (a cheap
+      // bitmap or key probe through isRowAtEmpty), a prefix sum turns the
+      // counts into per-thread output positions, and the second pass
+      // materializes rows contention-free and in entry order.
       const size_t worker_count = cpu_threads();
-      std::vector<std::future<void>> conversion_threads;
       const auto entry_count = rows.entryCount();
-      for (size_t i = 0,
-                  start_entry = 0,
-                  stride = (entry_count + worker_count - 1) / worker_count;
-           i < worker_count && start_entry < entry_count;
+      const auto stride = (entry_count + worker_count - 1) / worker_count;
+      std::vector<size_t> range_row_counts(worker_count, 0);
+      std::vector<std::future<void>> count_threads;
+      for (size_t i = 0, start_entry = 0; i < worker_count && start_entry < entry_count;
            ++i, start_entry += stride) {
         const auto end_entry = std::min(start_entry + stride, entry_count);
-        conversion_threads.push_back(std::async(
-            std::launch::async,
-            [&rows, &do_work, &row_idx](const size_t start, const size_t end) {
-              for (size_t i = start; i < end; ++i) {
-                const auto crt_row = rows.getRowAtNoTranslations(i);
+        count_threads.push_back(ThreadPool_NS::ThreadPool::instance().submit(
+            [&rows, &range_row_counts, i, start_entry, end_entry] {
+              size_t range_row_count{0};
+              for (size_t entry_idx = start_entry; entry_idx < end_entry; ++entry_idx) {
+                if (!rows.isRowAtEmpty(entry_idx)) {
+                  ++range_row_count;
+                }
+              }
+              range_row_counts[i] = range_row_count;
+            }));
+      }
+      for (auto& child : count_threads) {
+        child.wait();
+      }
+      for (auto& child : count_threads) {
+        child.get();
+      }
+      std::vector<size_t> range_write_cursors(worker_count, 0);
+      for (size_t i = 1; i < worker_count; ++i) {
+        range_write_cursors[i] = range_write_cursors[i - 1] + range_row_counts[i - 1];
+      }
+      std::vector<std::future<void>> conversion_threads;
+      for (size_t i = 0, start_entry = 0; i < worker_count && start_entry < entry_count;
+           ++i, start_entry += stride) {
+        const auto end_entry = std::min(start_entry + stride, entry_count);
+        conversion_threads.push_back(ThreadPool_NS::ThreadPool::instance().submit(
+            [&rows, &do_work, write_cursor = range_write_cursors[i], start_entry, end_entry]() mutable {
+              for (size_t entry_idx = start_entry; entry_idx < end_entry; ++entry_idx) {
+                const auto crt_row = rows.getRowAtNoTranslations(entry_idx);
                 if (!crt_row.empty()) {
-                  do_work(crt_row, row_idx.fetch_add(1));
+                  do_work(crt_row, write_cursor++);
                 }
               }
-            },
-            start_entry,
-            end_entry));
+            }));
       }
       for (auto& child : conversion_threads) {
         child.wait();
@@ -102,7 +183,8 @@ ColumnarResults::ColumnarResults(
       for (auto& child : conversion_threads) {
         child.get();
       }
-      num_rows_ = row_idx;
+      num_rows_ = std::accumulate(
+          range_row_counts.begin(), range_row_counts.end(), size_t(0));
       rows.setCachedRowCount(num_rows_);
       return;
     }
@@ -132,9 +214,33 @@ ColumnarResults::ColumnarResults(
     throw ColumnarConversionNotSupported();
   }
   const auto buf_size = num_rows * target_type.get_size();
-  column_buffers_[0] = reinterpret_cast<const int8_t*>(checked_malloc(buf_size));
+  column_buffers_[0] = row_set_mem_owner->allocate(buf_size);
   memcpy(((void*)column_buffers_[0]), one_col_buffer, buf_size);
-  row_set_mem_owner->addColBuffer(column_buffers_[0]);
+}
+
+ColumnarResults::~ColumnarResults() {
+  for (auto pool_buffer : pool_buffers_) {
+    data_mgr_->free(pool_buffer);
+  }
+}
+
+// Carves the buffer out of the CPU buffer pool when a DataMgr was supplied,
+// falling back to the arena if the pool can't satisfy the request even after
+// evicting; arena-backed buffers live as long as the row set memory owner.
+int8_t* ColumnarResults::allocateBuffer(
+    const std::shared_ptr<RowSetMemoryOwner>& row_set_mem_owner,
+    const size_t num_bytes) {
+  if (data_mgr_) {
+    try {
+      auto pool_buffer =
+          data_mgr_->alloc(Data_Namespace::CPU_LEVEL, 0, num_bytes);
+      pool_buffers_.push_back(pool_buffer);
+      return pool_buffer->getMemoryPtr();
+    } catch (const std::runtime_error&) {
+      // fall through to the arena
+    }
+  }
+  return row_set_mem_owner->allocate(num_bytes);
 }
 
 std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
@@ -162,10 +268,8 @@ std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
   }
   for (size_t col_idx = 0; col_idx < col_count; ++col_idx) {
     const auto byte_width = (*nonempty_it)->getColumnType(col_idx).get_size();
-    auto write_ptr =
-        reinterpret_cast<int8_t*>(checked_malloc(byte_width * total_row_count));
+    auto write_ptr = row_set_mem_owner->allocate(byte_width * total_row_count);
     merged_results->column_buffers_.push_back(write_ptr);
-    row_set_mem_owner->addColBuffer(write_ptr);
     for (auto& rs : sub_results) {
       CHECK_EQ(col_count, rs->column_buffers_.size());
       if (!rs->size()) {
@@ -190,45 +294,10 @@ std::unique_ptr<ColumnarResults> ColumnarResults::mergeResults(
 inline void ColumnarResults::writeBackCell(const TargetValue& col_val,
                                            const size_t row_idx,
                                            const size_t column_idx) {
-  const auto scalar_col_val = boost::get<ScalarTargetValue>(&col_val);
-  CHECK(scalar_col_val);
-  auto i64_p = boost::get<int64_t>(scalar_col_val);
-  const auto& type_info = target_types_[column_idx];
-  if (i64_p) {
-    const auto val = fixed_encoding_nullable_val(*i64_p, type_info);
-    switch (target_types_[column_idx].get_size()) {
-      case 1:
-        ((int8_t*)column_buffers_[column_idx])[row_idx] = static_cast<int8_t>(val);
-        break;
-      case 2:
-        ((int16_t*)column_buffers_[column_idx])[row_idx] = static_cast<int16_t>(val);
-        break;
-      case 4:
-        ((int32_t*)column_buffers_[column_idx])[row_idx] = static_cast<int32_t>(val);
-        break;
-      case 8:
-        ((int64_t*)column_buffers_[column_idx])[row_idx] = val;
-        break;
-      default:
-        CHECK(false);
-    }
-  } else {
-    CHECK(target_types_[column_idx].is_fp());
-    switch (target_types_[column_idx].get_type()) {
-      case kFLOAT: {
-        auto float_p = boost::get<float>(scalar_col_val);
-        ((float*)column_buffers_[column_idx])[row_idx] = static_cast<float>(*float_p);
-        break;
-      }
-      case kDOUBLE: {
-        auto double_p = boost::get<double>(scalar_col_val);
-        ((double*)column_buffers_[column_idx])[row_idx] = static_cast<double>(*double_p);
-        break;
-      }
-      default:
-        CHECK(false);
-    }
-  }
+  write_back_cell(col_val,
+                  row_idx,
+                  target_types_[column_idx],
+                  const_cast<int8_t*>(column_buffers_[column_idx]));
 }
 
 /*
@@ -276,15 +345,13 @@ void ColumnarResults::copyAllNonLazyColumns(
   std::vector<std::future<void>> direct_copy_threads;
   for (size_t col_idx = 0; col_idx < num_columns; col_idx++) {
     if (is_column_non_lazily_fetched(col_idx)) {
-      direct_copy_threads.push_back(std::async(
-          std::launch::async,
-          [&rows, this](const size_t column_index) {
+      direct_copy_threads.push_back(ThreadPool_NS::ThreadPool::instance().submit(
+          [&rows, this, column_index = col_idx] {
             const size_t column_size = num_rows_ * target_types_[column_index].get_size();
             rows.copyColumnIntoBuffer(column_index,
                                       const_cast<int8_t*>(column_buffers_[column_index]),
                                       column_size);
-          },
-          col_idx));
+          }));
     }
   }
 
@@ -343,18 +410,18 @@ void ColumnarResults::materializeAllLazyColumns(
          i < worker_count && start_entry < entry_count;
          ++i, start_entry += stride) {
       const auto end_entry = std::min(start_entry + stride, entry_count);
-      conversion_threads.push_back(std::async(
-          std::launch::async,
-          [&rows, &do_work_just_lazy_columns, &lazy_fetch_info](
-              const size_t start, const size_t end, const bool skip_non_lazy_columns) {
-            for (size_t i = start; i < end; ++i) {
+      conversion_threads.push_back(ThreadPool_NS::ThreadPool::instance().submit(
+          [&rows,
+           &do_work_just_lazy_columns,
+           &lazy_fetch_info,
+           start_entry,
+           end_entry,
+           skip_non_lazy_columns] {
+            for (size_t i = start_entry; i < end_entry; ++i) {
               const auto crt_row = rows.getRowAtNoTranslations(i, skip_non_lazy_columns);
               do_work_just_lazy_columns(crt_row, i, lazy_fetch_info);
             }
-          },
-          start_entry,
-          end_entry,
-          skip_non_lazy_columns));
+          }));
     }
 
     for (auto& child : conversion_threads) {
@@ -365,3 +432,70 @@ void ColumnarResults::materializeAllLazyColumns(
     }
   }
 }
+
+ColumnarBatchIterator::ColumnarBatchIterator(
+    const ResultSet& rows,
+    const std::vector<SQLTypeInfo>& target_types,
+    const size_t batch_size)
+    : rows_(rows)
+    , target_types_(target_types)
+    , batch_size_(batch_size)
+    , direct_copy_eligible_([&rows]() {
+      if (!rows.isFastColumnarConversionPossible()) {
+        return false;
+      }
+      const auto& lazy_fetch_info = rows.getLazyFetchInfo();
+      return std::none_of(lazy_fetch_info.begin(),
+                          lazy_fetch_info.end(),
+                          [](const ColumnLazyFetchInfo& col_lazy_fetch) {
+                            return col_lazy_fetch.is_lazily_fetched;
+                          });
+    }())
+    , crt_row_idx_(0)
+    , total_row_count_(direct_copy_eligible_ ? rows.entryCount() : 0) {
+  CHECK_GT(batch_size_, size_t(0));
+  column_buffers_.reserve(target_types_.size());
+  for (const auto& ti : target_types_) {
+    const bool is_varlen = ti.is_array() ||
+                           (ti.is_string() && ti.get_compression() == kENCODING_NONE) ||
+                           ti.is_geometry();
+    if (is_varlen) {
+      throw ColumnarConversionNotSupported();
+    }
+    column_buffers_.emplace_back(batch_size_ * ti.get_size());
+  }
+  if (!direct_copy_eligible_) {
+    rows_.moveToBegin();
+  }
+}
+
+size_t ColumnarBatchIterator::nextBatch() {
+  if (direct_copy_eligible_) {
+    if (crt_row_idx_ >= total_row_count_) {
+      return 0;
+    }
+    const auto batch_row_count = std::min(batch_size_, total_row_count_ - crt_row_idx_);
+    for (size_t col_idx = 0; col_idx < target_types_.size(); ++col_idx) {
+      rows_.copyColumnRangeIntoBuffer(
+          col_idx, crt_row_idx_, batch_row_count, column_buffers_[col_idx].data());
+    }
+    crt_row_idx_ += batch_row_count;
+    return batch_row_count;
+  }
+  size_t batch_row_count = 0;
+  while (batch_row_count < batch_size_) {
+    const auto crt_row = rows_.getNextRow(false, false);
+    if (crt_row.empty()) {
+      break;
+    }
+    CHECK_EQ(target_types_.size(), crt_row.size());
+    for (size_t col_idx = 0; col_idx < target_types_.size(); ++col_idx) {
+      write_back_cell(crt_row[col_idx],
+                      batch_row_count,
+                      target_types_[col_idx],
+                      column_buffers_[col_idx].data());
+    }
+    ++batch_row_count;
+  }
+  return batch_row_count;
+}
@@ -24,6 +24,11 @@
 #include <memory>
 #include <unordered_map>
 
+namespace Data_Namespace {
+class AbstractBuffer;
+class DataMgr;
+}  // namespace Data_Namespace
+
 class ColumnarConversionNotSupported : public std::runtime_error {
  public:
   ColumnarConversionNotSupported()
@@ -33,16 +38,24 @@ class ColumnarConversionNotSupported : public std::runtime_error {
 
 class ColumnarResults {
  public:
+  // When a DataMgr is supplied the column buffers are carved out of its CPU
+  // buffer pool instead of the row set arena, so large intermediate
+  // materializations are accounted against the same budget as the chunk cache
+  // (evicting cold chunks under pressure) rather than growing the process heap
+  // unbounded. Pool buffers are returned when this object is destroyed.
   ColumnarResults(const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
                   const ResultSet& rows,
                   const size_t num_columns,
-                  const std::vector<SQLTypeInfo>& target_types);
+                  const std::vector<SQLTypeInfo>& target_types,
+                  Data_Namespace::DataMgr* data_mgr = nullptr);
 
   ColumnarResults(const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
                   const int8_t* one_col_buffer,
                   const size_t num_rows,
                   const SQLTypeInfo& target_type);
 
+  ~ColumnarResults();
+
   static std::unique_ptr<ColumnarResults> mergeResults(
       const std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
       const std::vector<std::unique_ptr<ColumnarResults>>& sub_results);
@@ -60,6 +73,8 @@ class ColumnarResults {
  private:
   ColumnarResults(const size_t num_rows, const std::vector<SQLTypeInfo>& target_types)
       : num_rows_(num_rows), target_types_(target_types) {}
+  int8_t* allocateBuffer(const std::shared_ptr<RowSetMemoryOwner>& row_set_mem_owner,
+                         const size_t num_bytes);
   inline void writeBackCell(const TargetValue& col_val,
                             const size_t row_idx,
                             const size_t column_idx);
@@ -74,6 +89,51 @@ class ColumnarResults {
   std::vector<const int8_t*> column_buffers_;
   size_t num_rows_;
   const std::vector<SQLTypeInfo> target_types_;
+  Data_Namespace::DataMgr* data_mgr_{nullptr};
+  std::vector<Data_Namespace::AbstractBuffer*> pool_buffers_;
+};
+
+/*
+ * Iterates a result set in fixed-size columnar batches. Each batch exposes one
+ * contiguous buffer per column holding values at the column's logical width,
+ * so export paths can consume results without per-value TargetValue variants.
+ * Columnar projections are copied straight out of the result set storage; all
+ * other layouts fall back to row iteration, converted one batch at a time so
+ * the peak footprint stays bounded by the batch size rather than the full
+ * result.
+ */
+class ColumnarBatchIterator {
+ public:
+  ColumnarBatchIterator(const ResultSet& rows,
+                        const std::vector<SQLTypeInfo>& target_types,
+                        const size_t batch_size);
+
+  // Converts the next batch, returning the number of rows in it. Returns zero
+  // once the result set is exhausted.
+  size_t nextBatch();
+
+  const int8_t* getColumnBuffer(const size_t col_idx) const {
+    CHECK_LT(col_idx, column_buffers_.size());
+    return column_buffers_[col_idx].data();
+  }
+
+  const SQLTypeInfo& getColumnType(const size_t col_idx) const {
+    CHECK_LT(col_idx, target_types_.size());
+    return target_types_[col_idx];
+  }
+
+  size_t batchSize() const { return batch_size_; }
+
+ private:
+  const ResultSet& rows_;
+  const std::vector<SQLTypeInfo> target_types_;
+  const size_t batch_size_;
+  // Columnar projections without lazy columns can be copied directly from the
+  // result set storage, bypassing row iteration altogether.
+  const bool direct_copy_eligible_;
+  std::vector<std::vector<int8_t>> column_buffers_;
+  size_t crt_row_idx_;
+  size_t total_row_count_;
 };
 
 typedef std::
@@ -19,7 +19,7 @@
 
 enum class ExecutorDeviceType { CPU, GPU };
 
-enum class ExecutorOptLevel { Default, LoopStrengthReduction };
+enum class ExecutorOptLevel { Default, LoopStrengthReduction, Off };
 
 enum class ExecutorExplainType { Default, Optimized };
 
@@ -45,6 +45,8 @@ struct ExecutionOptions {
   const bool find_push_down_candidates;
   const bool just_calcite_explain;
   const double gpu_input_mem_limit_percent;  // punt to CPU if input memory exceeds this
+  const bool low_priority = false;  // batch-class query; yields to interactive
+                                    // queries at fragment kernel boundaries
 };
 
 #endif  // QUERYENGINE_COMPILATIONOPTIONS_H
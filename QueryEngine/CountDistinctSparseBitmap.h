@@ -0,0 +1,91 @@
+/*
+ * Copyright 2018 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QUERYENGINE_COUNTDISTINCTSPARSEBITMAP_H
+#define QUERYENGINE_COUNTDISTINCTSPARSEBITMAP_H
+
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+// Roaring-style compressed bitmap for exact COUNT DISTINCT over sparse domains.
+// The value range is split into 64K-bit containers which are only materialized
+// when a value inside them is seen, so memory is proportional to the number of
+// touched containers instead of the full range. Updated from generated CPU code
+// through agg_count_distinct_sparse_bitmap, like the std::set fallback.
+class CountDistinctSparseBitmap {
+ public:
+  static constexpr uint64_t kContainerBits{64 * 1024};
+  static constexpr uint64_t kContainerWords{kContainerBits / 64};
+
+  void set(const uint64_t bit_idx) {
+    const auto container_idx = bit_idx / kContainerBits;
+    if (container_idx != cached_container_idx_) {
+      auto& container = containers_[container_idx];
+      if (container.empty()) {
+        container.resize(kContainerWords, 0);
+      }
+      // Node-based map, the mapped vector stays put across rehashes.
+      cached_container_ = &container;
+      cached_container_idx_ = container_idx;
+    }
+    const auto bit_in_container = bit_idx % kContainerBits;
+    (*cached_container_)[bit_in_container / 64] |= uint64_t(1)
+                                                   << (bit_in_container % 64);
+  }
+
+  size_t size() const {
+    size_t set_size = 0;
+    for (const auto& idx_and_container : containers_) {
+      for (const auto word : idx_and_container.second) {
+        set_size += std::bitset<64>(word).count();
+      }
+    }
+    return set_size;
+  }
+
+  // Makes both sides the union, following bitmap_set_union semantics.
+  void unionWith(CountDistinctSparseBitmap& other) {
+    for (const auto& idx_and_container : other.containers_) {
+      auto& container = containers_[idx_and_container.first];
+      if (container.empty()) {
+        container = idx_and_container.second;
+        continue;
+      }
+      for (size_t i = 0; i < kContainerWords; ++i) {
+        container[i] |= idx_and_container.second[i];
+      }
+    }
+    other.containers_ = containers_;
+    invalidateCache();
+    other.invalidateCache();
+  }
+
+ private:
+  void invalidateCache() {
+    cached_container_idx_ = std::numeric_limits<uint64_t>::max();
+    cached_container_ = nullptr;
+  }
+
+  std::unordered_map<uint64_t, std::vector<uint64_t>> containers_;
+  // Cache the last touched container, consecutive values usually hit it.
+  uint64_t cached_container_idx_{std::numeric_limits<uint64_t>::max()};
+  std::vector<uint64_t>* cached_container_{nullptr};
+};
+
+#endif  // QUERYENGINE_COUNTDISTINCTSPARSEBITMAP_H
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataRetention.h"
+
+#include "Catalog/Catalog.h"
+#include "LockMgr/LockMgr.h"
+#include "LockMgr/TableLockMgr.h"
+#include "Shared/Logger.h"
+
+#include <chrono>
+#include <ctime>
+#include <thread>
+
+bool g_enable_data_retention{true};
+size_t g_data_retention_interval_seconds{300};
+
+namespace {
+
+// Same locks as a DML writer: writers and checkpoints to this table wait
+// while the expired fragment prefix is clipped off, everything else proceeds.
+void age_out_table(Catalog_Namespace::Catalog& cat, const std::string& table_name) {
+  auto chkpt_lock = Lock_Namespace::getTableLock<mapd_shared_mutex, mapd_unique_lock>(
+      cat, table_name, Lock_Namespace::LockType::CheckpointLock);
+  auto table_write_lock =
+      Lock_Namespace::TableLockMgr::getWriteLockForTable(cat, table_name);
+
+  const auto td = cat.getMetadataForTable(table_name, /*populateFragmenter=*/true);
+  if (!td || !td->retentionColumnId || td->retentionSeconds <= 0) {
+    return;
+  }
+  const int64_t min_epoch_seconds =
+      static_cast<int64_t>(std::time(nullptr)) - td->retentionSeconds;
+  size_t dropped_rows = 0;
+  for (const auto physical_td : cat.getPhysicalTablesDescriptors(td)) {
+    CHECK(physical_td->fragmenter);
+    dropped_rows += physical_td->fragmenter->dropExpiredFragments(
+        td->retentionColumnId, min_epoch_seconds);
+  }
+  if (dropped_rows) {
+    cat.checkpoint(td->tableId);
+    LOG(INFO) << "Data retention: aged out " << dropped_rows << " rows of table "
+              << td->tableName;
+  }
+}
+
+}  // namespace
+
+void data_retention(std::atomic<bool>& program_is_running,
+                    const unsigned int wait_interval_seconds) {
+  const auto wait_duration = std::chrono::seconds(wait_interval_seconds);
+  while (program_is_running) {
+    std::this_thread::sleep_for(wait_duration);
+    if (!program_is_running) {
+      break;
+    }
+    for (const auto& cat : Catalog_Namespace::Catalog::getAllCatalogs()) {
+      for (const auto td : cat->getAllTableMetadata()) {
+        if (!program_is_running) {
+          return;
+        }
+        if (td->isView || td->shard >= 0 || !td->retentionColumnId ||
+            td->retentionSeconds <= 0 ||
+            td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL) {
+          continue;
+        }
+        try {
+          age_out_table(*cat, td->tableName);
+        } catch (const std::exception& e) {
+          LOG(ERROR) << "Data retention failed for table " << td->tableName << ": "
+                     << e.what();
+        }
+      }
+    }
+  }
+  VLOG(1) << "data retention thread exiting";
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QUERYENGINE_DATARETENTION_H
+#define QUERYENGINE_DATARETENTION_H
+
+#include <atomic>
+
+// Background retention loop, run on its own thread like auto_vacuum. Wakes up
+// periodically and, for every table declared WITH (RETENTION_COLUMN=...,
+// RETENTION_SECONDS=...), drops whole fragments whose retention column chunk
+// metadata shows only expired rows - a metadata delete plus page free, no row
+// rewriting - then checkpoints the table.
+void data_retention(std::atomic<bool>& program_is_running,
+                    const unsigned int wait_interval_seconds);
+
+#endif  // QUERYENGINE_DATARETENTION_H
@@ -24,55 +24,11 @@
 #include <ctime>
 #include <iostream>
 
-extern "C" NEVER_INLINE DEVICE int64_t create_epoch(int32_t year) {
-  // Note this is not general purpose
-  // it has a final assumption that the year being passed can never be a leap
-  // year
-  // use 2001 epoch time 31 March as start
-
-  int64_t new_time = kEpochAdjustedDays * kSecsPerDay;
-  bool forward = true;
-  int32_t years_offset = year - kEpochAdjustedYears;
-  // convert year_offset to positive
-  if (years_offset < 0) {
-    forward = false;
-    years_offset = -years_offset;
-  }
-  // now get number of 400 year cycles in the years_offset;
-
-  int32_t year400 = years_offset / 400;
-  int32_t years_remaining = years_offset - (year400 * 400);
-  int32_t year100 = years_remaining / 100;
-  years_remaining -= year100 * 100;
-  int32_t year4 = years_remaining / 4;
-  years_remaining -= year4 * 4;
-
-  // get new date I know the final year will never be a leap year
-  if (forward) {
-    new_time += (year400 * kDaysPer400Years + year100 * kDaysPer100Years +
-                 year4 * kDaysPer4Years + years_remaining * kDaysPerYear -
-                 kDaysInJanuary - kDaysInFebruary) *
-                kSecsPerDay;
-  } else {
-    new_time -= (year400 * kDaysPer400Years + year100 * kDaysPer100Years +
-                 year4 * kDaysPer4Years + years_remaining * kDaysPerYear +
-                 // one more day for leap year of 2000 when going backward;
-                 1 + kDaysInJanuary + kDaysInFebruary) *
-                kSecsPerDay;
-  };
-
-  return new_time;
-}
-
 /*
  * @brief support the SQL DATE_TRUNC function
  */
 extern "C" NEVER_INLINE DEVICE int64_t DateTruncate(DatetruncField field,
                                                     const int64_t timeval) {
-  STATIC_QUAL const int32_t month_lengths[2][kMonsPerYear] = {
-      {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
-      {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}};
-
   STATIC_QUAL const uint32_t cumulative_month_epoch_starts[kMonsPerYear] = {0,
                                                                             2678400,
                                                                             5270400,
@@ -220,81 +176,29 @@ extern "C" NEVER_INLINE DEVICE int64_t DateTruncate(DatetruncField field,
       break;
   }
 
-  // use ExtractFromTime functions where available
-  // have to do some extra work for these ones
-  tm tm_struct;
-  gmtime_r_newlib(timeval, tm_struct);
+  // civil-calendar truncation for the remaining fields; the month, quarter and
+  // year cases only land here for timestamps outside the unsigned fast-path
+  // range
+  int64_t days = timeval / kSecsPerDay;
+  if (timeval % kSecsPerDay < 0) {
+    --days;
+  }
+  int32_t year;
+  uint32_t month, day;
+  civil_from_days(days, year, month, day);
   switch (field) {
-    case dtMONTH: {
-      // clear the time
-      int64_t day = (timeval / kSecsPerDay) * kSecsPerDay;
-      if (day < 0) {
-        {
-          day -= kSecsPerDay;
-        }
-      }
-      // calculate the day of month offset
-      int32_t dom = tm_struct.tm_mday;
-      return (day - (static_cast<int64_t>(dom - 1) * kSecsPerDay));
-    }
-    case dtQUARTER: {
-      // clear the time
-      int64_t day = (timeval / kSecsPerDay) * kSecsPerDay;
-      if (day < 0) {
-        {
-          day -= kSecsPerDay;
-        }
-      }
-      // calculate the day of month offset
-      int32_t dom = tm_struct.tm_mday;
-      // go to the start of the current month
-      day = day - ((dom - 1) * kSecsPerDay);
-      // find what month we are
-      int32_t mon = tm_struct.tm_mon;
-      // find start of quarter
-      int32_t start_of_quarter = tm_struct.tm_mon / 3 * 3;
-      int32_t year = tm_struct.tm_year + kYearBase;
-      // are we in a leap year
-      int32_t leap_year = 0;
-      // only matters if month is March so save some mod operations
-      if (mon == 2) {
-        if (((year % 400) == 0) || ((year % 4) == 0 && ((year % 100) != 0))) {
-          leap_year = 1;
-        }
-      }
-      // now walk back until at correct quarter start
-      for (; mon > start_of_quarter; mon--) {
-        day = day - (month_lengths[0 + leap_year][mon - 1] * kSecsPerDay);
-      }
-      return day;
-    }
-    case dtYEAR: {
-      // clear the time
-      int64_t day = (timeval / kSecsPerDay) * kSecsPerDay;
-      if (day < 0) {
-        {
-          day -= kSecsPerDay;
-        }
-      }
-      // calculate the day of year offset
-      int32_t doy = tm_struct.tm_yday;
-      return day - ((doy)*kSecsPerDay);
-    }
-    case dtDECADE: {
-      int32_t year = tm_struct.tm_year + kYearBase;
-      int32_t decade_start = ((year - 1) / 10) * 10 + 1;
-      return create_epoch(decade_start);
-    }
-    case dtCENTURY: {
-      int32_t year = tm_struct.tm_year + kYearBase;
-      int32_t century_start = ((year - 1) / 100) * 100 + 1;
-      return create_epoch(century_start);
-    }
-    case dtMILLENNIUM: {
-      int32_t year = tm_struct.tm_year + kYearBase;
-      int32_t millennium_start = ((year - 1) / 1000) * 1000 + 1;
-      return create_epoch(millennium_start);
-    }
+    case dtMONTH:
+      return days_from_civil(year, month, 1) * kSecsPerDay;
+    case dtQUARTER:
+      return days_from_civil(year, (month - 1) / 3 * 3 + 1, 1) * kSecsPerDay;
+    case dtYEAR:
+      return days_from_civil(year, 1, 1) * kSecsPerDay;
+    case dtDECADE:
+      return days_from_civil(((year - 1) / 10) * 10 + 1, 1, 1) * kSecsPerDay;
+    case dtCENTURY:
+      return days_from_civil(((year - 1) / 100) * 100 + 1, 1, 1) * kSecsPerDay;
+    case dtMILLENNIUM:
+      return days_from_civil(((year - 1) / 1000) * 1000 + 1, 1, 1) * kSecsPerDay;
     default:
 #ifdef __CUDACC__
       return -1;
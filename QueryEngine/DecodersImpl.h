@@ -147,6 +147,91 @@ SUFFIX(fixed_width_small_date_decode_noinline)(const int8_t* byte_stream,
       byte_stream, byte_width, null_val, ret_null_val, pos);
 }
 
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(fixed_width_dict_decode)(const int8_t* byte_stream,
+                                const int32_t code_byte_width,
+                                const int32_t value_byte_width,
+                                const int64_t dict_offset,
+                                const int64_t pos) {
+  // Chunk layout: an array of per-chunk dictionary codes, code_byte_width bytes
+  // each, followed at byte offset dict_offset by the dictionary itself,
+  // value_byte_width bytes per entry. Both lookups stay inline in the scan
+  // loop, so a 20-distinct-value INT column reads one byte per row instead of
+  // four.
+  const int64_t code =
+      SUFFIX(fixed_width_int_decode)(byte_stream, code_byte_width, pos);
+  return SUFFIX(fixed_width_int_decode)(
+      byte_stream + dict_offset, value_byte_width, code);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(fixed_width_dict_decode_noinline)(const int8_t* byte_stream,
+                                         const int32_t code_byte_width,
+                                         const int32_t value_byte_width,
+                                         const int64_t dict_offset,
+                                         const int64_t pos) {
+  return SUFFIX(fixed_width_dict_decode)(
+      byte_stream, code_byte_width, value_byte_width, dict_offset, pos);
+}
+
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(fixed_width_linear_decode)(const int8_t* byte_stream,
+                                  const int32_t byte_width,
+                                  const int64_t base,
+                                  const int64_t slope,
+                                  const int64_t pos) {
+  // Delta-of-delta layout for append-ordered time columns: the chunk stores
+  // the first value as base, the typical inter-row delta as slope and one
+  // narrow residual per row against the base + slope * pos line. Regularly
+  // spaced timestamps leave near-zero residuals that fit a byte, and unlike
+  // cumulative delta chains the decode stays O(1) per position.
+  return base + slope * pos +
+         SUFFIX(fixed_width_int_decode)(byte_stream, byte_width, pos);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(fixed_width_linear_decode_noinline)(const int8_t* byte_stream,
+                                           const int32_t byte_width,
+                                           const int64_t base,
+                                           const int64_t slope,
+                                           const int64_t pos) {
+  return SUFFIX(fixed_width_linear_decode)(byte_stream, byte_width, base, slope, pos);
+}
+
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(run_length_decode)(const int8_t* byte_stream,
+                          const int32_t value_byte_width,
+                          const int64_t run_count,
+                          const int64_t pos) {
+  // Chunk layout: run_count exclusive run end positions as ascending int64
+  // values, followed by the run values, value_byte_width bytes each. Binary
+  // search for the run containing pos keeps the decode random access, which
+  // the position-based scan and lazy fetch paths require.
+  const int64_t* run_ends = reinterpret_cast<const int64_t*>(byte_stream);
+  int64_t lo = 0;
+  int64_t hi = run_count - 1;
+  while (lo < hi) {
+    const int64_t mid = (lo + hi) >> 1;
+    if (run_ends[mid] <= pos) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return SUFFIX(fixed_width_int_decode)(
+      byte_stream + run_count * static_cast<int64_t>(sizeof(int64_t)),
+      value_byte_width,
+      lo);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(run_length_decode_noinline)(const int8_t* byte_stream,
+                                   const int32_t value_byte_width,
+                                   const int64_t run_count,
+                                   const int64_t pos) {
+  return SUFFIX(run_length_decode)(byte_stream, value_byte_width, run_count, pos);
+}
+
 #undef SUFFIX
 
 #endif  // QUERYENGINE_DECODERSIMPL_H
@@ -81,6 +81,14 @@ ColSlotContext::ColSlotContext(const std::vector<Analyzer::Expr*>& col_expr_list
         continue;
       }
 
+      if (agg_info.is_agg && agg_info.agg_kind == kAPPROX_TOP_K) {
+        // The slot holds a pointer-sized handle to the heavy hitters sketch,
+        // regardless of the argument type.
+        addSlotForColumn(sizeof(int64_t), col_expr_idx);
+        ++col_expr_idx;
+        continue;
+      }
+
       const auto col_expr_bitwidth =
           consider_argument_logical_size(agg_info, col_expr)
               ? std::max(get_bit_width(chosen_type), get_bit_width(agg_info.agg_arg_type))
@@ -16,9 +16,23 @@
 
 #include "QueryFragmentDescriptor.h"
 
+#include <random>
+
 #include <DataMgr/DataMgr.h>
 #include "../Execute.h"
 
+// Route each fragment to the GPU which already caches its chunks instead of
+// the fragmenter's static round-robin device assignment, so steady-state
+// repeated queries stop re-transferring data resident on another device.
+bool g_enable_affinity_fragment_dispatch{false};
+
+// Fraction of the outer table's fragments an aggregate query scans in
+// approximate query mode; 0 disables sampling. A fresh sample is drawn per
+// query, stratified by shard, and kernels run unchanged over the subset; the
+// covered tuple fraction is reported back with the result so additive
+// aggregates can be scaled up.
+double g_fragment_sample_rate{0.};
+
 QueryFragmentDescriptor::QueryFragmentDescriptor(
     const RelAlgExecutionUnit& ra_exe_unit,
     const std::vector<InputTableInfo>& query_infos,
@@ -63,6 +77,7 @@ void QueryFragmentDescriptor::buildFragmentKernelMap(
     const ExecutorDeviceType& device_type,
     const bool enable_multifrag_kernels,
     const bool enable_inner_join_fragment_skipping,
+    const bool allow_fragment_sampling,
     Executor* executor) {
   if (enable_multifrag_kernels) {
     buildMultifragKernelMap(ra_exe_unit,
@@ -70,11 +85,44 @@ void QueryFragmentDescriptor::buildFragmentKernelMap(
                             device_count,
                             device_type,
                             enable_inner_join_fragment_skipping,
+                            allow_fragment_sampling,
                             executor);
   } else {
     buildFragmentPerKernelMap(
-        ra_exe_unit, frag_offsets, device_count, device_type, executor);
+        ra_exe_unit, frag_offsets, device_count, device_type, allow_fragment_sampling, executor);
+  }
+}
+
+std::set<size_t> QueryFragmentDescriptor::pickSampledFragments(
+    const TableFragments& fragments) {
+  std::map<int, std::vector<size_t>> fragment_indices_per_shard;
+  for (size_t i = 0; i < fragments.size(); ++i) {
+    fragment_indices_per_shard[fragments[i].shard].push_back(i);
   }
+  std::set<size_t> sampled_fragment_indices;
+  std::mt19937 gen(std::random_device{}());
+  for (auto& shard_and_indices : fragment_indices_per_shard) {
+    auto& indices = shard_and_indices.second;
+    // Keep at least one fragment per shard so every stratum is represented.
+    const size_t sample_count = std::max(
+        static_cast<size_t>(g_fragment_sample_rate * indices.size() + 0.5), size_t(1));
+    std::shuffle(indices.begin(), indices.end(), gen);
+    indices.resize(std::min(sample_count, indices.size()));
+    sampled_fragment_indices.insert(indices.begin(), indices.end());
+  }
+  size_t total_tuples{0};
+  size_t sampled_tuples{0};
+  for (size_t i = 0; i < fragments.size(); ++i) {
+    const auto num_tuples = fragments[i].getNumTuples();
+    total_tuples += num_tuples;
+    if (sampled_fragment_indices.count(i)) {
+      sampled_tuples += num_tuples;
+    }
+  }
+  sampled_fraction_ = total_tuples > 0
+                          ? static_cast<double>(sampled_tuples) / total_tuples
+                          : 1.0;
+  return sampled_fragment_indices;
 }
 
 void QueryFragmentDescriptor::buildFragmentPerKernelMap(
@@ -82,6 +130,7 @@ void QueryFragmentDescriptor::buildFragmentPerKernelMap(
     const std::vector<uint64_t>& frag_offsets,
     const int device_count,
     const ExecutorDeviceType& device_type,
+    const bool allow_fragment_sampling,
     Executor* executor) {
   const auto& outer_table_desc = ra_exe_unit.input_descs.front();
   const int outer_table_id = outer_table_desc.getTableId();
@@ -90,15 +139,36 @@ void QueryFragmentDescriptor::buildFragmentPerKernelMap(
   const auto outer_fragments = it->second;
   outer_fragments_size_ = outer_fragments->size();
 
+  const bool sample_fragments = allow_fragment_sampling &&
+                                g_fragment_sample_rate > 0. &&
+                                g_fragment_sample_rate < 1. &&
+                                outer_fragments->size() > 1;
+  std::set<size_t> sampled_fragment_indices;
+  if (sample_fragments) {
+    sampled_fragment_indices = pickSampledFragments(*outer_fragments);
+  }
+
   const auto num_bytes_for_row = executor->getNumBytesForFetchedRow();
 
-  for (size_t i = 0; i < outer_fragments->size(); ++i) {
+  const auto sorted_fragment_range = executor->getSortedFragmentRange(
+      outer_table_desc, *outer_fragments, ra_exe_unit.simple_quals);
+  for (size_t i = sorted_fragment_range.first; i < sorted_fragment_range.second; ++i) {
     const auto& fragment = (*outer_fragments)[i];
+    if (sample_fragments && !sampled_fragment_indices.count(i)) {
+      continue;
+    }
     const auto skip_frag = executor->skipFragment(
         outer_table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
     if (skip_frag.first) {
       continue;
     }
+    if (executor->skipFragmentForJoinBuildRange(ra_exe_unit, outer_table_desc, fragment)) {
+      continue;
+    }
+    if (executor->skipFragmentByExpressionRange(
+            ra_exe_unit, outer_table_desc, fragment)) {
+      continue;
+    }
     // NOTE: Using kernel index instead of frag index now
     outer_fragment_tuple_sizes_.push_back(fragment.getNumTuples());
     rowid_lookup_key_ = std::max(rowid_lookup_key_, skip_frag.second);
@@ -111,6 +181,15 @@ void QueryFragmentDescriptor::buildFragmentPerKernelMap(
     int device_id = (device_type == ExecutorDeviceType::CPU || fragment.shard == -1)
                         ? fragment.deviceIds[static_cast<int>(memory_level)]
                         : fragment.shard % chosen_device_count;
+    if (fragment.shard != -1) {
+      has_sharded_fragments_ = true;
+    }
+    if (g_enable_affinity_fragment_dispatch &&
+        device_type == ExecutorDeviceType::GPU && fragment.shard == -1 &&
+        chosen_device_count > 1) {
+      device_id = chooseDeviceByChunkAffinity(
+          ra_exe_unit, fragment, outer_table_id, chosen_device_count, device_id, executor);
+    }
 
     if (device_type == ExecutorDeviceType::GPU) {
       checkDeviceMemoryUsage(fragment, device_id, num_bytes_for_row);
@@ -146,6 +225,7 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
     const int device_count,
     const ExecutorDeviceType& device_type,
     const bool enable_inner_join_fragment_skipping,
+    const bool allow_fragment_sampling,
     Executor* executor) {
   // Allocate all the fragments of the tables involved in the query to available
   // devices. The basic idea: the device is decided by the outer table in the
@@ -158,12 +238,27 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
   const auto outer_fragments = it->second;
   outer_fragments_size_ = outer_fragments->size();
 
+  const bool sample_fragments = allow_fragment_sampling &&
+                                g_fragment_sample_rate > 0. &&
+                                g_fragment_sample_rate < 1. &&
+                                outer_fragments->size() > 1;
+  std::set<size_t> sampled_fragment_indices;
+  if (sample_fragments) {
+    sampled_fragment_indices = pickSampledFragments(*outer_fragments);
+  }
+
   const auto inner_table_id_to_join_condition = executor->getInnerTabIdToJoinCond();
   const auto num_bytes_for_row = executor->getNumBytesForFetchedRow();
 
-  for (size_t outer_frag_id = 0; outer_frag_id < outer_fragments->size();
+  const auto sorted_fragment_range = executor->getSortedFragmentRange(
+      outer_table_desc, *outer_fragments, ra_exe_unit.simple_quals);
+  for (size_t outer_frag_id = sorted_fragment_range.first;
+       outer_frag_id < sorted_fragment_range.second;
        ++outer_frag_id) {
     const auto& fragment = (*outer_fragments)[outer_frag_id];
+    if (sample_fragments && !sampled_fragment_indices.count(outer_frag_id)) {
+      continue;
+    }
     auto skip_frag = executor->skipFragment(outer_table_desc,
                                             fragment,
                                             ra_exe_unit.simple_quals,
@@ -177,10 +272,27 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
     if (skip_frag.first) {
       continue;
     }
-    const int device_id =
+    if (executor->skipFragmentForJoinBuildRange(
+            ra_exe_unit, outer_table_desc, fragment)) {
+      continue;
+    }
+    if (executor->skipFragmentByExpressionRange(
+            ra_exe_unit, outer_table_desc, fragment)) {
+      continue;
+    }
+    int device_id =
         fragment.shard == -1
             ? fragment.deviceIds[static_cast<int>(Data_Namespace::GPU_LEVEL)]
             : fragment.shard % device_count;
+    if (fragment.shard != -1) {
+      has_sharded_fragments_ = true;
+    }
+    if (g_enable_affinity_fragment_dispatch &&
+        device_type == ExecutorDeviceType::GPU && fragment.shard == -1 &&
+        device_count > 1) {
+      device_id = chooseDeviceByChunkAffinity(
+          ra_exe_unit, fragment, outer_table_id, device_count, device_id, executor);
+    }
     if (device_type == ExecutorDeviceType::GPU) {
       checkDeviceMemoryUsage(fragment, device_id, num_bytes_for_row);
     }
@@ -249,6 +361,60 @@ bool QueryFragmentDescriptor::terminateDispatchMaybe(
   return false;
 }
 
+int QueryFragmentDescriptor::chooseDeviceByChunkAffinity(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const int table_id,
+    const int device_count,
+    const int default_device_id,
+    Executor* executor) {
+  const auto catalog = executor->getCatalog();
+  CHECK(catalog);
+  auto& data_mgr = catalog->getDataMgr();
+  const auto& metadata_map = fragment.getChunkMetadataMapPhysical();
+  std::vector<size_t> resident_bytes(device_count, 0);
+  for (const auto& input_col_desc : ra_exe_unit.input_col_descs) {
+    if (input_col_desc->getScanDesc().getTableId() != table_id) {
+      continue;
+    }
+    const auto meta_it = metadata_map.find(input_col_desc->getColId());
+    if (meta_it == metadata_map.end()) {
+      continue;
+    }
+    const ChunkKey chunk_key{catalog->getCurrentDB().dbId,
+                             table_id,
+                             input_col_desc->getColId(),
+                             fragment.fragmentId};
+    for (int device_id = 0; device_id < device_count; ++device_id) {
+      if (data_mgr.isBufferOnDevice(chunk_key, Data_Namespace::GPU_LEVEL, device_id)) {
+        resident_bytes[device_id] += meta_it->second.numBytes;
+      }
+    }
+  }
+  const auto best_it = std::max_element(resident_bytes.begin(), resident_bytes.end());
+  if (*best_it == 0) {
+    // Nothing cached anywhere; keep the static assignment, which spreads cold
+    // fragments across the devices.
+    return default_device_id;
+  }
+  const int affinity_device_id = best_it - resident_bytes.begin();
+  // Affinity loses to balance once the preferred device carries more than
+  // twice its fair share of the tuples assigned so far; at that point moving
+  // work matters more than saving the transfer.
+  size_t total_tuples{fragment.getNumTuples()};
+  for (const auto& kv : tuple_count_per_device_) {
+    total_tuples += kv.second;
+  }
+  const auto affinity_tuples_it = tuple_count_per_device_.find(affinity_device_id);
+  const size_t affinity_tuples =
+      affinity_tuples_it == tuple_count_per_device_.end() ? 0
+                                                          : affinity_tuples_it->second;
+  if (affinity_tuples > 2 * (total_tuples / device_count)) {
+    return default_device_id;
+  }
+  return affinity_device_id;
+}
+
 void QueryFragmentDescriptor::checkDeviceMemoryUsage(
     const Fragmenter_Namespace::FragmentInfo& fragment,
     const int device_id,
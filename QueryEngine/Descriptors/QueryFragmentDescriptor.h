@@ -23,6 +23,7 @@
 #ifndef QUERYENGINE_QUERYFRAGMENTDESCRIPTOR_H
 #define QUERYENGINE_QUERYFRAGMENTDESCRIPTOR_H
 
+#include <algorithm>
 #include <deque>
 #include <map>
 #include <memory>
@@ -70,8 +71,14 @@ class QueryFragmentDescriptor {
                               const ExecutorDeviceType& device_type,
                               const bool enable_multifrag_kernels,
                               const bool enable_inner_join_fragment_skipping,
+                              const bool allow_fragment_sampling,
                               Executor* executor);
 
+  // Fraction of the outer table's tuples covered by the scheduled kernels
+  // when fragment sampling is active, 1.0 otherwise. Clients scale additive
+  // aggregates by its inverse.
+  double sampledFraction() const { return sampled_fraction_; }
+
   template <typename DISPATCH_FCN>
   void assignFragsToMultiDispatch(DISPATCH_FCN f) const {
     for (const auto& kv : kernels_per_device_) {
@@ -100,6 +107,70 @@ class QueryFragmentDescriptor {
     }
   }
 
+  // Work stealing re-assigns kernels to whichever device frees up first, so it
+  // is only valid when fragments are not pinned to a device for shard
+  // colocation and the dispatch cannot terminate early on a rowid lookup.
+  bool allowsWorkStealingDispatch() const {
+    return !has_sharded_fragments_ && rowid_lookup_key_ < 0;
+  }
+
+  // Hands out every kernel without a fixed device assignment; the caller's
+  // per-device workers pull from the resulting list as they finish.
+  template <typename DISPATCH_FCN>
+  void assignFragsToWorkStealingDispatch(DISPATCH_FCN f) const {
+    for (const auto& kv : kernels_per_device_) {
+      for (const auto& kernel_id : kv.second) {
+        CHECK_LT(kernel_id, fragments_per_kernel_.size());
+        f(fragments_per_kernel_[kernel_id]);
+      }
+    }
+  }
+
+  // Coalesces runs of per-fragment kernels into multi-fragment batches, using
+  // the same per-table merge rules as the multifrag kernel map, so CPU workers
+  // amortize kernel setup over several fragments. Only valid when the dispatch
+  // cannot terminate early on a rowid lookup (rowid_lookup_key_ < 0).
+  template <typename DISPATCH_FCN>
+  void assignFragsToBatchedKernelDispatch(DISPATCH_FCN f,
+                                          const size_t batch_size) const {
+    CHECK_GE(batch_size, size_t(1));
+    CHECK_LT(rowid_lookup_key_, int64_t(0));
+    FragmentsList batched_frag_list;
+    size_t kernels_in_batch{0};
+    const auto flush_batch = [&] {
+      if (kernels_in_batch > 0) {
+        f(batched_frag_list);
+        batched_frag_list.clear();
+        kernels_in_batch = 0;
+      }
+    };
+    for (const auto& kv : kernels_per_device_) {
+      for (const auto& kernel_id : kv.second) {
+        CHECK_LT(kernel_id, fragments_per_kernel_.size());
+        const auto& frag_list = fragments_per_kernel_[kernel_id];
+        if (batched_frag_list.empty()) {
+          batched_frag_list = frag_list;
+        } else {
+          CHECK_EQ(batched_frag_list.size(), frag_list.size());
+          for (size_t j = 0; j < frag_list.size(); ++j) {
+            CHECK_EQ(batched_frag_list[j].table_id, frag_list[j].table_id);
+            auto& curr_frag_ids = batched_frag_list[j].fragment_ids;
+            for (const auto frag_id : frag_list[j].fragment_ids) {
+              if (std::find(curr_frag_ids.begin(), curr_frag_ids.end(), frag_id) ==
+                  curr_frag_ids.end()) {
+                curr_frag_ids.push_back(frag_id);
+              }
+            }
+          }
+        }
+        if (++kernels_in_batch == batch_size) {
+          flush_batch();
+        }
+      }
+    }
+    flush_batch();
+  }
+
   bool shouldCheckWorkUnitWatchdog() const {
     return rowid_lookup_key_ < 0 && fragments_per_kernel_.size() > 0;
   }
@@ -107,6 +178,7 @@ class QueryFragmentDescriptor {
  protected:
   size_t outer_fragments_size_ = 0;
   int64_t rowid_lookup_key_ = -1;
+  bool has_sharded_fragments_ = false;
 
   std::map<int, const TableFragments*> selected_tables_fragments_;
 
@@ -115,6 +187,7 @@ class QueryFragmentDescriptor {
   std::vector<size_t> outer_fragment_tuple_sizes_;
 
   double gpu_input_mem_limit_percent_;
+  double sampled_fraction_ = 1.0;
   std::map<size_t, size_t> tuple_count_per_device_;
   std::map<size_t, size_t> available_gpu_mem_bytes_;
 
@@ -122,6 +195,7 @@ class QueryFragmentDescriptor {
                                  const std::vector<uint64_t>& frag_offsets,
                                  const int device_count,
                                  const ExecutorDeviceType& device_type,
+                                 const bool allow_fragment_sampling,
                                  Executor* executor);
 
   void buildMultifragKernelMap(const RelAlgExecutionUnit& ra_exe_unit,
@@ -129,8 +203,13 @@ class QueryFragmentDescriptor {
                                const int device_count,
                                const ExecutorDeviceType& device_type,
                                const bool enable_inner_join_fragment_skipping,
+                               const bool allow_fragment_sampling,
                                Executor* executor);
 
+  // Draws the per-query fragment sample, stratified by shard so every shard
+  // stays represented, and records the covered tuple fraction.
+  std::set<size_t> pickSampledFragments(const TableFragments& fragments);
+
   const size_t getOuterFragmentTupleSize(const size_t frag_index) const {
     if (frag_index < outer_fragment_tuple_sizes_.size()) {
       return outer_fragment_tuple_sizes_[frag_index];
@@ -145,6 +224,16 @@ class QueryFragmentDescriptor {
   void checkDeviceMemoryUsage(const Fragmenter_Namespace::FragmentInfo& fragment,
                               const int device_id,
                               const size_t num_cols);
+
+  int chooseDeviceByChunkAffinity(const RelAlgExecutionUnit& ra_exe_unit,
+                                  const Fragmenter_Namespace::FragmentInfo& fragment,
+                                  const int table_id,
+                                  const int device_count,
+                                  const int default_device_id,
+                                  Executor* executor);
 };
 
+extern bool g_enable_affinity_fragment_dispatch;
+extern double g_fragment_sample_rate;
+
 #endif  // QUERYENGINE_QUERYFRAGMENTDESCRIPTOR_H
@@ -24,7 +24,13 @@
 #include "ColSlotContext.h"
 
 bool g_enable_smem_group_by{true};
+size_t g_gpu_smem_group_by_max_entries{0};
+// Append a one-bit-per-entry occupancy bitmap to row-wise perfect hash buffers
+// on CPU; kernels mark each entry they claim, so reduction and iteration can
+// skip runs of empty entries instead of reading every slot of a sparse range.
+bool g_enable_reduction_occupancy_bitmap{true};
 extern bool g_enable_columnar_output;
+extern bool g_enable_hybrid_execution;
 
 namespace {
 
@@ -249,11 +255,17 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
            *
            **/
           if (cuda_mgr->isArchMaxwellOrLaterForAll()) {
-            // TODO(Saman): threshold should be eventually set as an optimized policy per
-            // architecture.
+            // By default allow every entry the hardware can hold: one 8 byte
+            // bin per group plus one for nulls, up to the per-block shared
+            // memory capacity (48KB-96KB depending on architecture).
+            // --gpu-smem-group-by-max-entries caps it lower when occupancy
+            // matters more than avoiding global memory atomics.
             gpu_smem_max_threshold =
-                std::min((cuda_mgr->isArchVoltaForAll()) ? 4095LU : 2047LU,
-                         (cuda_mgr->getMaxSharedMemoryForAll() / sizeof(int64_t) - 1));
+                cuda_mgr->getMaxSharedMemoryForAll() / sizeof(int64_t) - 1;
+            if (g_gpu_smem_group_by_max_entries > 0) {
+              gpu_smem_max_threshold =
+                  std::min(gpu_smem_max_threshold, g_gpu_smem_group_by_max_entries);
+            }
           }
         }
 
@@ -336,7 +348,7 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
       UNREACHABLE() << "Unknown query type";
   }
 
-  return std::make_unique<QueryMemoryDescriptor>(
+  auto query_mem_desc = std::make_unique<QueryMemoryDescriptor>(
       executor,
       ra_exe_unit,
       query_infos,
@@ -357,6 +369,20 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
       output_columnar_hint,
       render_info && render_info->isPotentialInSituRender(),
       must_use_baseline_sort);
+  // The bitmap only pays off once the entry range is big enough for empty runs
+  // to dominate the reduction walk; small dense buffers reduce quickly anyway.
+  // Hybrid execution is excluded since it reduces CPU and GPU buffers, which
+  // would disagree on the layout, against each other.
+  constexpr size_t min_entry_count_for_occupancy_bitmap{4096};
+  query_mem_desc->has_occupancy_bitmap_ =
+      g_enable_reduction_occupancy_bitmap && !g_enable_hybrid_execution &&
+      device_type == ExecutorDeviceType::CPU &&
+      query_mem_desc->getQueryDescriptionType() ==
+          QueryDescriptionType::GroupByPerfectHash &&
+      !query_mem_desc->hasKeylessHash() && !query_mem_desc->didOutputColumnar() &&
+      !query_mem_desc->mustUseBaselineSort() &&
+      query_mem_desc->getEntryCount() >= min_entry_count_for_occupancy_bitmap;
+  return query_mem_desc;
 }
 
 QueryMemoryDescriptor::QueryMemoryDescriptor(
@@ -538,6 +564,9 @@ bool QueryMemoryDescriptor::operator==(const QueryMemoryDescriptor& other) const
   if (force_4byte_float_ != other.force_4byte_float_) {
     return false;
   }
+  if (has_occupancy_bitmap_ != other.has_occupancy_bitmap_) {
+    return false;
+  }
   if (group_col_widths_ != other.group_col_widths_) {
     return false;
   }
@@ -919,11 +948,25 @@ size_t QueryMemoryDescriptor::getBufferSizeBytes(
                   getTotalBytesOfColumnarBuffers();
   } else {
     total_bytes = getRowSize() * entry_count_;
+    if (has_occupancy_bitmap_) {
+      total_bytes += getOccupancyBitmapSizeBytes();
+    }
   }
 
   return total_bytes;
 }
 
+size_t QueryMemoryDescriptor::getOccupancyBitmapOffset() const {
+  CHECK(has_occupancy_bitmap_);
+  CHECK(!output_columnar_ && !keyless_hash_);
+  return getRowSize() * entry_count_;
+}
+
+size_t QueryMemoryDescriptor::getOccupancyBitmapSizeBytes() const {
+  CHECK(has_occupancy_bitmap_);
+  return align_to_int64((entry_count_ + 7) / 8);
+}
+
 void QueryMemoryDescriptor::setOutputColumnar(const bool val) {
   output_columnar_ = val;
   if (isLogicalSizedColumnsAllowed()) {
@@ -227,7 +227,12 @@ class QueryMemoryDescriptor {
   void clearTargetGroupbyIndices() { target_groupby_indices_.clear(); }
 
   size_t getEntryCount() const { return entry_count_; }
-  void setEntryCount(const size_t val) { entry_count_ = val; }
+  void setEntryCount(const size_t val) {
+    entry_count_ = val;
+    // an occupancy bitmap is laid out after the entries, so any buffer
+    // described with a changed entry count no longer carries one
+    has_occupancy_bitmap_ = false;
+  }
 
   int64_t getMinVal() const { return min_val_; }
   int64_t getMaxVal() const { return max_val_; }
@@ -254,6 +259,13 @@ class QueryMemoryDescriptor {
 
   bool mustUseBaselineSort() const { return must_use_baseline_sort_; }
 
+  // One-bit-per-entry occupancy bitmap appended to row-wise perfect hash
+  // buffers on CPU; kernels mark each entry they claim so reduction and
+  // iteration can skip empty runs without reading the wide rows.
+  bool hasOccupancyBitmap() const { return has_occupancy_bitmap_; }
+  size_t getOccupancyBitmapOffset() const;
+  size_t getOccupancyBitmapSizeBytes() const;
+
   // TODO(adb): remove and store this info more naturally in another
   // member
   bool forceFourByteFloat() const { return force_4byte_float_; }
@@ -332,6 +344,7 @@ class QueryMemoryDescriptor {
   bool output_columnar_;
   bool render_output_;
   bool must_use_baseline_sort_;
+  bool has_occupancy_bitmap_{false};
 
   bool force_4byte_float_;
 
@@ -106,7 +106,9 @@ DAG build_dag(const RelAlgNode* sink) {
           (dynamic_cast<const RelModify*>(node) && input_num == 1) ||
           (input_num == 2 && (dynamic_cast<const RelJoin*>(node) ||
                               dynamic_cast<const RelLeftDeepInnerJoin*>(node))) ||
-          (input_num > 2 && (dynamic_cast<const RelLeftDeepInnerJoin*>(node))));
+          (input_num > 2 && (dynamic_cast<const RelLeftDeepInnerJoin*>(node))) ||
+          (input_num >= 2 && dynamic_cast<const RelLogicalUnion*>(node)) ||
+          (input_num >= 1 && dynamic_cast<const RelTableFunction*>(node)));
     for (size_t i = 0; i < input_num; ++i) {
       const auto input = node->getInput(i);
       CHECK(input);
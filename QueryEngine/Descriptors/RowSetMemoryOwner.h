@@ -17,6 +17,10 @@
 #pragma once
 
 #include "../StringDictionary/StringDictionaryProxy.h"
+#include "../ApproxQuantileDigest.h"
+#include "../ApproxTopKSketch.h"
+#include "../CountDistinctSparseBitmap.h"
+#include "Shared/Arena.h"
 #include "Shared/Logger.h"
 
 #include <boost/noncopyable.hpp>
@@ -32,12 +36,11 @@ class ResultSet;
 
 class RowSetMemoryOwner : boost::noncopyable {
  public:
-  void addCountDistinctBuffer(int8_t* count_distinct_buffer,
-                              const size_t bytes,
-                              const bool system_allocated) {
+  // Allocates from the arena which backs this owner; the memory stays valid
+  // until the owner itself is destroyed and is released in bulk with it.
+  int8_t* allocate(const size_t num_bytes) {
     std::lock_guard<std::mutex> lock(state_mutex_);
-    count_distinct_bitmaps_.emplace_back(
-        CountDistinctBitmapBuffer{count_distinct_buffer, bytes, system_allocated});
+    return static_cast<int8_t*>(arena_.allocate(num_bytes));
   }
 
   void addCountDistinctSet(std::set<int64_t>* count_distinct_set) {
@@ -45,9 +48,20 @@ class RowSetMemoryOwner : boost::noncopyable {
     count_distinct_sets_.push_back(count_distinct_set);
   }
 
-  void addGroupByBuffer(int64_t* group_by_buffer) {
+  void addCountDistinctSparseBitmap(
+      CountDistinctSparseBitmap* count_distinct_sparse_bitmap) {
     std::lock_guard<std::mutex> lock(state_mutex_);
-    group_by_buffers_.push_back(group_by_buffer);
+    count_distinct_sparse_bitmaps_.push_back(count_distinct_sparse_bitmap);
+  }
+
+  void addApproxMedianDigest(ApproxQuantileDigest* approx_median_digest) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    approx_median_digests_.push_back(approx_median_digest);
+  }
+
+  void addApproxTopKSketch(ApproxTopKSketch* approx_top_k_sketch) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    approx_top_k_sketches_.push_back(approx_top_k_sketch);
   }
 
   void addVarlenBuffer(void* varlen_buffer) {
@@ -101,22 +115,25 @@ class RowSetMemoryOwner : boost::noncopyable {
     return lit_str_dict_proxy_.get();
   }
 
+  // Takes ownership of a buffer which was malloc'd elsewhere, like the
+  // linearized multi-fragment columns built by the column fetcher.
   void addColBuffer(const void* col_buffer) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     col_buffers_.push_back(const_cast<void*>(col_buffer));
   }
 
   ~RowSetMemoryOwner() {
-    for (const auto& count_distinct_buffer : count_distinct_bitmaps_) {
-      if (count_distinct_buffer.system_allocated) {
-        free(count_distinct_buffer.ptr);
-      }
-    }
     for (auto count_distinct_set : count_distinct_sets_) {
       delete count_distinct_set;
     }
-    for (auto group_by_buffer : group_by_buffers_) {
-      free(group_by_buffer);
+    for (auto count_distinct_sparse_bitmap : count_distinct_sparse_bitmaps_) {
+      delete count_distinct_sparse_bitmap;
+    }
+    for (auto approx_median_digest : approx_median_digests_) {
+      delete approx_median_digest;
+    }
+    for (auto approx_top_k_sketch : approx_top_k_sketches_) {
+      delete approx_top_k_sketch;
     }
     for (auto varlen_buffer : varlen_buffers_) {
       free(varlen_buffer);
@@ -131,15 +148,11 @@ class RowSetMemoryOwner : boost::noncopyable {
   }
 
  private:
-  struct CountDistinctBitmapBuffer {
-    int8_t* ptr;
-    const size_t size;
-    const bool system_allocated;
-  };
-
-  std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
+  Arena arena_;
   std::vector<std::set<int64_t>*> count_distinct_sets_;
-  std::vector<int64_t*> group_by_buffers_;
+  std::vector<CountDistinctSparseBitmap*> count_distinct_sparse_bitmaps_;
+  std::vector<ApproxQuantileDigest*> approx_median_digests_;
+  std::vector<ApproxTopKSketch*> approx_top_k_sketches_;
   std::vector<void*> varlen_buffers_;
   std::list<std::string> strings_;
   std::list<std::vector<int64_t>> arrays_;
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DeviceCostModel.h"
+
+#include <glog/logging.h>
+
+bool g_enable_cost_based_device_selection{false};
+
+namespace {
+
+// Effective host-to-device bandwidth, bytes per millisecond. Deliberately
+// below the PCIe 3.0 x16 peak to account for the many-small-chunk transfer
+// pattern of fragment fetches.
+const double kBusBytesPerMs{8. * 1000. * 1000.};
+
+// Weight of a new observation; past throughput decays geometrically so the
+// model adapts to load changes without chasing single-query noise.
+const double kObservationWeight{0.2};
+
+}  // namespace
+
+DeviceCostModel& DeviceCostModel::getInstance() {
+  static DeviceCostModel instance;
+  return instance;
+}
+
+ExecutorDeviceType DeviceCostModel::chooseDeviceType(const size_t input_rows,
+                                                     const size_t input_bytes,
+                                                     const size_t gpu_resident_bytes) {
+  double cpu_rows_per_ms;
+  double gpu_rows_per_ms;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cpu_rows_per_ms = cpu_rows_per_ms_;
+    gpu_rows_per_ms = gpu_rows_per_ms_;
+  }
+  const auto transfer_bytes =
+      input_bytes > gpu_resident_bytes ? input_bytes - gpu_resident_bytes : size_t(0);
+  const double cpu_time_ms = static_cast<double>(input_rows) / cpu_rows_per_ms;
+  const double gpu_time_ms = static_cast<double>(transfer_bytes) / kBusBytesPerMs +
+                             static_cast<double>(input_rows) / gpu_rows_per_ms;
+  VLOG(1) << "Device cost model: " << input_rows << " rows, " << input_bytes
+          << " bytes (" << gpu_resident_bytes << " GPU resident), estimated CPU "
+          << cpu_time_ms << " ms vs GPU " << gpu_time_ms << " ms";
+  return cpu_time_ms < gpu_time_ms ? ExecutorDeviceType::CPU : ExecutorDeviceType::GPU;
+}
+
+void DeviceCostModel::recordExecution(const ExecutorDeviceType device_type,
+                                      const size_t input_rows,
+                                      const int64_t execution_time_ms) {
+  // Sub-millisecond steps are dominated by fixed overhead and tell us nothing
+  // about throughput.
+  if (execution_time_ms <= 0 || input_rows == 0) {
+    return;
+  }
+  const double observed_rows_per_ms =
+      static_cast<double>(input_rows) / static_cast<double>(execution_time_ms);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& rows_per_ms =
+      device_type == ExecutorDeviceType::GPU ? gpu_rows_per_ms_ : cpu_rows_per_ms_;
+  rows_per_ms = (1. - kObservationWeight) * rows_per_ms +
+                kObservationWeight * observed_rows_per_ms;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    DeviceCostModel.h
+ * @brief   Cost model for per-step CPU vs GPU device selection. Each device's
+ *          execution time is estimated from the input volume, how much of the
+ *          input already resides in GPU memory (transfer over the bus is the
+ *          dominant fixed cost for short queries), and per-device throughput
+ *          figures. The throughput figures start from conservative seeds and
+ *          are corrected by the measured execution time of every step, so the
+ *          model converges on the actual hardware without offline calibration.
+ */
+
+#ifndef QUERYENGINE_DEVICECOSTMODEL_H
+#define QUERYENGINE_DEVICECOSTMODEL_H
+
+#include "CompilationOptions.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+class DeviceCostModel {
+ public:
+  static DeviceCostModel& getInstance();
+
+  // Picks the cheaper device for a step reading `input_rows` rows spanning
+  // `input_bytes`, of which `gpu_resident_bytes` are already in GPU memory.
+  ExecutorDeviceType chooseDeviceType(const size_t input_rows,
+                                      const size_t input_bytes,
+                                      const size_t gpu_resident_bytes);
+
+  // Folds the measured execution time of a finished step into the throughput
+  // estimate for the device it ran on.
+  void recordExecution(const ExecutorDeviceType device_type,
+                       const size_t input_rows,
+                       const int64_t execution_time_ms);
+
+ private:
+  DeviceCostModel() {}
+
+  std::mutex mutex_;
+  // Seeds only; every executed step moves these toward the measured rate.
+  double cpu_rows_per_ms_{10. * 1000.};
+  double gpu_rows_per_ms_{1000. * 1000.};
+};
+
+extern bool g_enable_cost_based_device_selection;
+
+#endif  // QUERYENGINE_DEVICECOSTMODEL_H
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DictStringLengthTable.h"
+#include "CodeGenerator.h"
+#include "Execute.h"
+#ifdef HAVE_CUDA
+#include "GpuMemUtils.h"
+#endif  // HAVE_CUDA
+#include "../Parser/ParserNode.h"
+#include "../StringDictionary/StringDictionaryProxy.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+extern "C" int32_t char_length_encoded(const char* str, const int32_t str_len);
+
+namespace {
+
+// Length vectors are immutable for a given generation since dictionary ids
+// are append-only, so they can be shared across queries and executors.
+std::mutex dict_length_cache_mutex;
+std::map<std::tuple<int, size_t, bool>, std::shared_ptr<const std::vector<int32_t>>>
+    dict_length_cache;
+
+std::shared_ptr<const std::vector<int32_t>> get_or_compute_lengths(
+    const int dict_id,
+    StringDictionaryProxy* sdp,
+    const size_t entry_count,
+    const bool encoded_count) {
+  const auto cache_key = std::make_tuple(dict_id, entry_count, encoded_count);
+  {
+    std::lock_guard<std::mutex> lock(dict_length_cache_mutex);
+    const auto it = dict_length_cache.find(cache_key);
+    if (it != dict_length_cache.end()) {
+      return it->second;
+    }
+  }
+  auto lengths = std::make_shared<std::vector<int32_t>>(entry_count);
+  for (size_t string_id = 0; string_id < entry_count; ++string_id) {
+    const auto string_bytes = sdp->getStringBytes(static_cast<int32_t>(string_id));
+    const auto byte_count = static_cast<int32_t>(string_bytes.second);
+    (*lengths)[string_id] = encoded_count
+                                ? char_length_encoded(string_bytes.first, byte_count)
+                                : byte_count;
+  }
+  std::lock_guard<std::mutex> lock(dict_length_cache_mutex);
+  const auto it_ok = dict_length_cache.emplace(cache_key, lengths);
+  return it_ok.first->second;
+}
+
+}  // namespace
+
+DictStringLengthTable::DictStringLengthTable(
+    const int dict_id,
+    StringDictionaryProxy* sdp,
+    const bool encoded_count,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_count,
+    Data_Namespace::DataMgr* data_mgr)
+    : memory_level_(memory_level), device_count_(device_count) {
+#ifdef HAVE_CUDA
+  CHECK(memory_level_ == Data_Namespace::CPU_LEVEL ||
+        memory_level == Data_Namespace::GPU_LEVEL);
+#else
+  CHECK_EQ(Data_Namespace::CPU_LEVEL, memory_level_);
+#endif  // HAVE_CUDA
+  lengths_ = get_or_compute_lengths(dict_id, sdp, sdp->storageEntryCount(), encoded_count);
+#ifdef HAVE_CUDA
+  if (memory_level_ == Data_Namespace::GPU_LEVEL) {
+    const auto table_bytes = lengths_->size() * sizeof(int32_t);
+    for (int device_id = 0; device_id < device_count_; ++device_id) {
+      auto gpu_table = CudaAllocator::alloc(data_mgr, table_bytes, device_id);
+      copy_to_gpu(data_mgr,
+                  reinterpret_cast<CUdeviceptr>(gpu_table),
+                  lengths_->data(),
+                  table_bytes,
+                  device_id);
+      tables_.push_back(reinterpret_cast<const int32_t*>(gpu_table));
+    }
+  } else {
+    tables_.push_back(lengths_->data());
+  }
+#else
+  CHECK_EQ(1, device_count_);
+  tables_.push_back(lengths_->data());
+#endif  // HAVE_CUDA
+}
+
+llvm::Value* DictStringLengthTable::codegen(llvm::Value* string_id,
+                                            Executor* executor) const {
+  CHECK(!tables_.empty());
+  std::vector<std::shared_ptr<const Analyzer::Constant>> constants_owned;
+  std::vector<const Analyzer::Constant*> constants;
+  for (const auto table : tables_) {
+    const int64_t table_handle = reinterpret_cast<int64_t>(table);
+    const auto table_handle_literal = std::dynamic_pointer_cast<Analyzer::Constant>(
+        Parser::IntLiteral::analyzeValue(table_handle));
+    CHECK(table_handle_literal);
+    CHECK_EQ(kENCODING_NONE, table_handle_literal->get_type_info().get_compression());
+    constants_owned.push_back(table_handle_literal);
+    constants.push_back(table_handle_literal.get());
+  }
+  CodeGenerator code_generator(executor);
+  const auto table_handle_lvs =
+      code_generator.codegenHoistedConstants(constants, kENCODING_NONE, 0);
+  CHECK_EQ(size_t(1), table_handle_lvs.size());
+  const auto null_val =
+      static_cast<int32_t>(inline_int_null_val(SQLTypeInfo(kINT, false)));
+  return executor->cgen_state_->emitCall(
+      "char_length_dict",
+      {executor->cgen_state_->castToTypeIn(table_handle_lvs.front(), 64),
+       string_id,
+       executor->cgen_state_->llInt(static_cast<int32_t>(lengths_->size())),
+       executor->cgen_state_->llInt(null_val)});
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QUERYENGINE_DICTSTRINGLENGTHTABLE_H
+#define QUERYENGINE_DICTSTRINGLENGTHTABLE_H
+
+#include "../DataMgr/DataMgr.h"
+
+#include <llvm/IR/Value.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Executor;
+class StringDictionaryProxy;
+
+// Precomputed LENGTH / CHAR_LENGTH results for every id of a string
+// dictionary. String lengths only depend on the dictionary payload, so they
+// are evaluated once per distinct id instead of once per row and the kernel
+// reduces to an id-indexed gather, which runs fine on GPU. The per-id vector
+// is cached across queries keyed on the dictionary generation (ids are
+// append-only, so a generation fully determines the table contents); the
+// per-device copies follow the same lifetime rules as InValuesBitmap.
+class DictStringLengthTable {
+ public:
+  DictStringLengthTable(const int dict_id,
+                        StringDictionaryProxy* sdp,
+                        const bool encoded_count,
+                        const Data_Namespace::MemoryLevel memory_level,
+                        const int device_count,
+                        Data_Namespace::DataMgr* data_mgr);
+
+  llvm::Value* codegen(llvm::Value* string_id, Executor* executor) const;
+
+ private:
+  std::shared_ptr<const std::vector<int32_t>> lengths_;
+  std::vector<const int32_t*> tables_;
+  const Data_Namespace::MemoryLevel memory_level_;
+  const int device_count_;
+};
+
+#endif  // QUERYENGINE_DICTSTRINGLENGTHTABLE_H
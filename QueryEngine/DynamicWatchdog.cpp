@@ -32,11 +32,14 @@ static __inline__ uint64_t read_cycle_counter(void) {
 #endif
 }
 
-extern "C" uint64_t dynamic_watchdog_init(unsigned ms_budget) {
-  static uint64_t dw_cycle_start = 0ULL;
-  static uint64_t dw_cycle_budget = 0ULL;
-  static std::atomic_bool dw_abort{false};
+// File scope (rather than locals of the control function below) so the hot
+// timeout probe reads them directly instead of routing every check through a
+// function call and its mode dispatch.
+static uint64_t dw_cycle_start = 0ULL;
+static uint64_t dw_cycle_budget = 0ULL;
+static std::atomic_bool dw_abort{false};
 
+extern "C" uint64_t dynamic_watchdog_init(unsigned ms_budget) {
   if (ms_budget == static_cast<unsigned>(DW_DEADLINE)) {
     if (dw_abort.load()) {
       {
@@ -65,10 +68,18 @@ extern "C" uint64_t dynamic_watchdog_init(unsigned ms_budget) {
   return dw_cycle_budget;
 }
 
-// timeout detection
+// timeout detection; called from generated code once per check interval, so
+// the no-timeout path is one counter read and two compares
 extern "C" bool dynamic_watchdog() {
+  if (dw_cycle_budget == 0ULL) {
+    return false;  // Uninitialized watchdog can't check time
+  }
+  if (dw_abort.load(std::memory_order_relaxed)) {
+    LOG(INFO) << "TIMEOUT: thread " << std::this_thread::get_id() << ": aborted";
+    return true;
+  }
   auto clock = read_cycle_counter();
-  auto dw_deadline = dynamic_watchdog_init(static_cast<unsigned>(DW_DEADLINE));
+  auto dw_deadline = dw_cycle_start + dw_cycle_budget;
   if (clock > dw_deadline) {
     LOG(INFO) << "TIMEOUT: thread " << std::this_thread::get_id() << ": clock " << clock
               << ", deadline " << dw_deadline;
@@ -20,16 +20,19 @@
 #include "BaselineJoinHashTable.h"
 #include "CodeGenerator.h"
 #include "ColumnFetcher.h"
+#include "DateTimeTranslator.h"
 #include "Descriptors/QueryCompilationDescriptor.h"
 #include "Descriptors/QueryFragmentDescriptor.h"
 #include "DynamicWatchdog.h"
 #include "EquiJoinCondition.h"
 #include "ExpressionRewrite.h"
+#include "FragmentBloomFilter.h"
 #include "GpuMemUtils.h"
 #include "InPlaceSort.h"
 #include "JsonAccessors.h"
 #include "OutputBufferInitialization.h"
 #include "OverlapsJoinHashTable.h"
+#include "QueryPriorityGate.h"
 #include "QueryRewrite.h"
 #include "QueryTemplateGenerator.h"
 #include "RuntimeFunctions.h"
@@ -66,11 +69,21 @@ bool g_enable_debug_timer{false};
 bool g_enable_watchdog{false};
 bool g_enable_dynamic_watchdog{false};
 unsigned g_dynamic_watchdog_time_limit{10000};
+// Rows between two deadline probes in generated CPU code; rounded down to a
+// power of two so the check compiles to a single AND. The timeout budget has
+// millisecond granularity, so a few thousand rows between probes costs no
+// precision while keeping the probe off the per-row path.
+unsigned g_dynamic_watchdog_check_interval{1024};
 bool g_allow_cpu_retry{true};
 bool g_null_div_by_zero{false};
+// Skip per-value null sentinel checks in generated code when chunk metadata
+// proves none of the scanned fragments contain nulls.
+bool g_enable_null_check_elision{true};
 unsigned g_trivial_loop_join_threshold{1000};
 bool g_from_table_reordering{true};
 bool g_inner_join_fragment_skipping{true};
+bool g_enable_join_build_range_pruning{false};
+bool g_enable_expression_range_pruning{false};
 extern bool g_enable_smem_group_by;
 extern std::unique_ptr<llvm::Module> udf_gpu_module;
 extern std::unique_ptr<llvm::Module> udf_cpu_module;
@@ -86,6 +99,16 @@ bool g_strip_join_covered_quals{false};
 size_t g_constrained_by_in_threshold{10};
 size_t g_big_group_threshold{20000};
 bool g_enable_window_functions{true};
+bool g_enable_dynamic_fragment_dispatch{false};
+bool g_enable_chunk_prefetch{false};
+bool g_enable_cpu_multifrag_kernels{false};
+size_t g_cpu_multifrag_batch_size{8};
+bool g_enable_hybrid_execution{false};
+bool g_enable_gpu_mem_reservation{false};
+bool g_enable_sorted_fragment_pruning{false};
+bool g_enable_parallel_device_reduction{false};
+bool g_enable_streaming_reduction{false};
+bool g_enable_lean_projection_buffers{true};
 
 int const Executor::max_gpu_count;
 
@@ -115,9 +138,10 @@ std::shared_ptr<Executor> Executor::getExecutor(
     const std::string& debug_dir,
     const std::string& debug_file,
     const MapDParameters mapd_parameters,
-    ::QueryRenderer::QueryRenderManager* render_manager) {
+    ::QueryRenderer::QueryRenderManager* render_manager,
+    const size_t executor_index) {
   INJECT_TIMER(getExecutor);
-  const auto executor_key = std::make_pair(db_id, render_manager);
+  const auto executor_key = std::make_tuple(db_id, render_manager, executor_index);
   {
     mapd_shared_lock<mapd_shared_mutex> read_lock(executors_cache_mutex_);
     auto it = executors_.find(executor_key);
@@ -787,6 +811,7 @@ ResultSetPtr Executor::reduceMultiDeviceResults(
     std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device,
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const QueryMemoryDescriptor& query_mem_desc) const {
+  INJECT_TIMER(reduceMultiDeviceResults);
   if (ra_exe_unit.estimator) {
     return reduce_estimator_results(ra_exe_unit, results_per_device);
   }
@@ -849,6 +874,28 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
     }
   } else {
     reduced_results = first;
+    if (g_enable_parallel_device_reduction && results_per_device.size() > 2) {
+      // Pairwise tree reduction: the sequential chain below pays n - 1
+      // dependent reduce steps for n devices, while reducing disjoint pairs
+      // concurrently pays ceil(log2(n)) rounds. Only layouts with a fixed
+      // per-device entry count take this path; baseline hash keeps the chain
+      // because its merged buffer must be grown to hold every device's
+      // entries first.
+      for (size_t stride = 1; stride < results_per_device.size(); stride <<= 1) {
+        std::vector<std::future<void>> reduction_threads;
+        for (size_t i = 0; i + stride < results_per_device.size(); i += stride * 2) {
+          reduction_threads.push_back(
+              std::async(std::launch::async, [&results_per_device, i, stride] {
+                results_per_device[i].first->getStorage()->reduce(
+                    *(results_per_device[i + stride].first->getStorage()), {});
+              }));
+        }
+        for (auto& reduction_thread : reduction_threads) {
+          reduction_thread.get();
+        }
+      }
+      return reduced_results;
+    }
   }
 
   for (size_t i = 1; i < results_per_device.size(); ++i) {
@@ -864,11 +911,15 @@ ResultSetPtr Executor::reduceSpeculativeTopN(
     std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device,
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const QueryMemoryDescriptor& query_mem_desc) const {
-  if (results_per_device.size() == 1) {
+  if (results_per_device.size() == 1 &&
+      ra_exe_unit.sort_info.order_entries.size() == 1) {
+    // A single device's rows are already ordered by the device sort; trailing
+    // tie breaker entries are only applied during the reduction below.
     return std::move(results_per_device.front().first);
   }
   const auto top_n = ra_exe_unit.sort_info.limit + ra_exe_unit.sort_info.offset;
-  SpeculativeTopNMap m;
+  const auto sorted_val_idx = speculative_topn_sorted_val_index(ra_exe_unit);
+  SpeculativeTopNMap m(sorted_val_idx);
   for (const auto& result : results_per_device) {
     auto rows = result.first;
     CHECK(rows);
@@ -878,10 +929,10 @@ ResultSetPtr Executor::reduceSpeculativeTopN(
     SpeculativeTopNMap that(
         *rows,
         ra_exe_unit.target_exprs,
-        std::max(size_t(10000 * std::max(1, static_cast<int>(log(top_n)))), top_n));
+        std::max(size_t(10000 * std::max(1, static_cast<int>(log(top_n)))), top_n),
+        sorted_val_idx);
     m.reduce(that);
   }
-  CHECK_EQ(size_t(1), ra_exe_unit.sort_info.order_entries.size());
   const auto desc = ra_exe_unit.sort_info.order_entries.front().is_desc;
   return m.asRows(ra_exe_unit, row_set_mem_owner, query_mem_desc, this, top_n, desc);
 }
@@ -1040,6 +1091,53 @@ RelAlgExecutionUnit replace_scan_limit(const RelAlgExecutionUnit& ra_exe_unit_in
           ra_exe_unit_in.query_features};
 }
 
+// Admits the query's estimated per-device GPU buffer footprint against each
+// device's memory budget before any kernel launches. Queries which don't fit
+// alongside the reservations already outstanding are punted to CPU up front,
+// instead of starting on GPU and evicting other queries' hot chunks one
+// segment at a time until an allocation finally fails. The ledger is static
+// because GPU memory is shared across all executors in the process.
+class GpuMemReservation {
+ public:
+  GpuMemReservation(const std::map<int, size_t>& bytes_per_device,
+                    const std::map<int, size_t>& budget_per_device)
+      : bytes_per_device_(bytes_per_device) {
+    std::lock_guard<std::mutex> lock(reservation_mutex_);
+    for (const auto& device_bytes : bytes_per_device_) {
+      const auto budget_it = budget_per_device.find(device_bytes.first);
+      CHECK(budget_it != budget_per_device.end());
+      if (reserved_bytes_[device_bytes.first] + device_bytes.second >
+          budget_it->second) {
+        LOG(INFO) << "Estimated GPU buffer footprint of " << device_bytes.second
+                  << " bytes does not fit on device " << device_bytes.first << ", "
+                  << reserved_bytes_[device_bytes.first] << " of " << budget_it->second
+                  << " bytes already reserved by other queries; punt to CPU";
+        throw QueryMustRunOnCpu();
+      }
+    }
+    for (const auto& device_bytes : bytes_per_device_) {
+      reserved_bytes_[device_bytes.first] += device_bytes.second;
+    }
+  }
+
+  ~GpuMemReservation() {
+    std::lock_guard<std::mutex> lock(reservation_mutex_);
+    for (const auto& device_bytes : bytes_per_device_) {
+      CHECK_GE(reserved_bytes_[device_bytes.first], device_bytes.second);
+      reserved_bytes_[device_bytes.first] -= device_bytes.second;
+    }
+  }
+
+ private:
+  const std::map<int, size_t> bytes_per_device_;
+
+  static std::mutex reservation_mutex_;
+  static std::map<int, size_t> reserved_bytes_;
+};
+
+std::mutex GpuMemReservation::reservation_mutex_;
+std::map<int, size_t> GpuMemReservation::reserved_bytes_;
+
 }  // namespace
 
 ResultSetPtr Executor::executeWorkUnit(
@@ -1120,8 +1218,36 @@ ResultSetPtr Executor::executeWorkUnitImpl(
     ColumnFetcher column_fetcher(this, column_cache);
     std::unique_ptr<QueryCompilationDescriptor> query_comp_desc_owned;
     std::unique_ptr<QueryMemoryDescriptor> query_mem_desc_owned;
+    std::unique_ptr<QueryCompilationDescriptor> cpu_query_comp_desc_owned;
+    std::unique_ptr<QueryMemoryDescriptor> cpu_query_mem_desc_owned;
     try {
       INJECT_TIMER(execution_dispatch_comp);
+      if (g_enable_hybrid_execution && device_type == ExecutorDeviceType::GPU &&
+          !is_agg && !render_info && !ra_exe_unit.estimator) {
+        // Hybrid execution runs scan kernels on the CPU pool alongside the
+        // GPUs, so compile the CPU flavor too. Compile it first: the plan
+        // state the fragment fetch decisions read must come from the primary
+        // (GPU) compilation below.
+        try {
+          std::tie(cpu_query_comp_desc_owned, cpu_query_mem_desc_owned) =
+              execution_dispatch.compile(max_groups_buffer_entry_guess,
+                                         crt_min_byte_width,
+                                         {ExecutorDeviceType::CPU,
+                                          co.hoist_literals_,
+                                          co.opt_level_,
+                                          co.with_dynamic_watchdog_,
+                                          co.explain_type_},
+                                         eo,
+                                         column_fetcher,
+                                         has_cardinality_estimation);
+        } catch (const std::exception& e) {
+          LOG(WARNING) << "CPU compilation for hybrid execution failed, "
+                          "running GPU only: "
+                       << e.what();
+          cpu_query_comp_desc_owned = nullptr;
+          cpu_query_mem_desc_owned = nullptr;
+        }
+      }
       std::tie(query_comp_desc_owned, query_mem_desc_owned) =
           execution_dispatch.compile(max_groups_buffer_entry_guess,
                                      crt_min_byte_width,
@@ -1179,6 +1305,25 @@ ResultSetPtr Executor::executeWorkUnitImpl(
 
       const auto context_count =
           get_context_count(device_type, available_cpus, available_gpus.size());
+      std::unique_ptr<GpuMemReservation> gpu_mem_reservation;
+      if (g_enable_gpu_mem_reservation &&
+          query_comp_desc_owned->getDeviceType() == ExecutorDeviceType::GPU) {
+        // the estimate only covers the output buffers; input chunks are
+        // admitted separately by checkDeviceMemoryUsage during kernel
+        // assignment
+        const auto gpu_mem_infos =
+            cat.getDataMgr().getMemoryInfo(Data_Namespace::MemoryLevel::GPU_LEVEL);
+        const size_t buffer_bytes =
+            query_mem_desc_owned->getBufferSizeBytes(ExecutorDeviceType::GPU);
+        std::map<int, size_t> footprints;
+        std::map<int, size_t> budgets;
+        for (size_t device_id = 0; device_id < gpu_mem_infos.size(); ++device_id) {
+          footprints[device_id] = buffer_bytes;
+          budgets[device_id] =
+              gpu_mem_infos[device_id].maxNumPages * gpu_mem_infos[device_id].pageSize;
+        }
+        gpu_mem_reservation.reset(new GpuMemReservation(footprints, budgets));
+      }
       dispatchFragments(dispatch,
                         execution_dispatch,
                         query_infos,
@@ -1188,6 +1333,8 @@ ResultSetPtr Executor::executeWorkUnitImpl(
                         context_count,
                         *query_comp_desc_owned,
                         *query_mem_desc_owned,
+                        cpu_query_comp_desc_owned.get(),
+                        cpu_query_mem_desc_owned.get(),
                         fragment_descriptor,
                         available_gpus,
                         available_cpus);
@@ -1209,11 +1356,14 @@ ResultSetPtr Executor::executeWorkUnitImpl(
     }
     if (is_agg) {
       try {
-        return collectAllDeviceResults(execution_dispatch,
-                                       ra_exe_unit.target_exprs,
-                                       *query_mem_desc_owned,
-                                       query_comp_desc_owned->getDeviceType(),
-                                       row_set_mem_owner);
+        auto reduced_results =
+            collectAllDeviceResults(execution_dispatch,
+                                    ra_exe_unit.target_exprs,
+                                    *query_mem_desc_owned,
+                                    query_comp_desc_owned->getDeviceType(),
+                                    row_set_mem_owner);
+        reduced_results->setFractionSampled(fragment_descriptor.sampledFraction());
+        return reduced_results;
       } catch (ReductionRanOutOfSlots&) {
         *error_code = ERR_OUT_OF_SLOTS;
         std::vector<TargetInfo> targets;
@@ -1244,7 +1394,8 @@ void Executor::executeWorkUnitPerFragment(const RelAlgExecutionUnit& ra_exe_unit
                                           const CompilationOptions& co,
                                           const ExecutionOptions& eo,
                                           const Catalog_Namespace::Catalog& cat,
-                                          PerFragmentCB& cb) {
+                                          PerFragmentCB& cb,
+                                          const std::set<size_t>& fragment_indexes) {
   const auto ra_exe_unit = addDeletedColumn(ra_exe_unit_in);
 
   int error_code = 0;
@@ -1261,25 +1412,44 @@ void Executor::executeWorkUnitPerFragment(const RelAlgExecutionUnit& ra_exe_unit
   CHECK_EQ(size_t(1), ra_exe_unit.input_descs.size());
   const auto table_id = ra_exe_unit.input_descs[0].getTableId();
   const auto& outer_fragments = table_info.info.fragments;
-  for (size_t fragment_index = 0; fragment_index < outer_fragments.size();
-       ++fragment_index) {
+  // The fragment scans are independent of each other, so run them concurrently
+  // the same way the regular fragment dispatch does.
+  std::vector<std::future<void>> dispatch_threads;
+  for (const auto fragment_index : fragment_indexes) {
+    CHECK_LT(fragment_index, outer_fragments.size());
     // We may want to consider in the future allowing this to execute on devices other
     // than CPU
-    execution_dispatch.run(co.device_type_,
-                           0,
-                           eo,
-                           column_fetcher,
-                           *query_comp_desc_owned,
-                           *query_mem_desc_owned,
-                           {{table_id, {fragment_index}}},
-                           -1);
+    dispatch_threads.push_back(std::async(std::launch::async,
+                                          [&execution_dispatch,
+                                           &co,
+                                           &eo,
+                                           &column_fetcher,
+                                           &query_comp_desc_owned,
+                                           &query_mem_desc_owned,
+                                           table_id,
+                                           fragment_index] {
+                                            execution_dispatch.run(
+                                                co.device_type_,
+                                                0,
+                                                eo,
+                                                column_fetcher,
+                                                *query_comp_desc_owned,
+                                                *query_mem_desc_owned,
+                                                {{table_id, {fragment_index}}},
+                                                -1);
+                                          }));
+  }
+  for (auto& dispatch_thread : dispatch_threads) {
+    dispatch_thread.wait();
+  }
+  for (auto& dispatch_thread : dispatch_threads) {
+    dispatch_thread.get();
   }
 
-  const auto& all_fragment_results = execution_dispatch.getFragmentResults();
-
-  for (size_t fragment_index = 0; fragment_index < outer_fragments.size();
-       ++fragment_index) {
-    const auto fragment_results = all_fragment_results[fragment_index];
+  for (const auto& fragment_results : execution_dispatch.getFragmentResults()) {
+    CHECK_EQ(size_t(1), fragment_results.second.size());
+    const auto fragment_index = fragment_results.second.front();
+    CHECK_LT(fragment_index, outer_fragments.size());
     cb(fragment_results.first, outer_fragments[fragment_index]);
   }
 }
@@ -1343,11 +1513,9 @@ void fill_entries_for_empty_input(std::vector<TargetInfo>& target_infos,
       const auto& count_distinct_desc =
           query_mem_desc.getCountDistinctDescriptor(target_idx);
       if (count_distinct_desc.impl_type_ == CountDistinctImplType::Bitmap) {
-        auto count_distinct_buffer = static_cast<int8_t*>(
-            checked_calloc(count_distinct_desc.bitmapPaddedSizeBytes(), 1));
-        CHECK(row_set_mem_owner);
-        row_set_mem_owner->addCountDistinctBuffer(
-            count_distinct_buffer, count_distinct_desc.bitmapPaddedSizeBytes(), true);
+        auto count_distinct_buffer =
+            row_set_mem_owner->allocate(count_distinct_desc.bitmapPaddedSizeBytes());
+        memset(count_distinct_buffer, 0, count_distinct_desc.bitmapPaddedSizeBytes());
         entry.push_back(reinterpret_cast<int64_t>(count_distinct_buffer));
         continue;
       }
@@ -1360,7 +1528,9 @@ void fill_entries_for_empty_input(std::vector<TargetInfo>& target_infos,
       }
     }
     const bool float_argument_input = takes_float_argument(agg_info);
-    if (agg_info.agg_kind == kCOUNT || agg_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
+    if (agg_info.agg_kind == kCOUNT || agg_info.agg_kind == kAPPROX_COUNT_DISTINCT ||
+        agg_info.agg_kind == kAPPROX_MEDIAN || agg_info.agg_kind == kAPPROX_TOP_K) {
+      // An empty handle makes the sketch-backed aggregates read out as null.
       entry.push_back(0);
     } else if (agg_info.agg_kind == kAVG) {
       entry.push_back(inline_null_val(agg_info.agg_arg_type, float_argument_input));
@@ -1536,13 +1706,41 @@ void Executor::dispatchFragments(
     const size_t context_count,
     const QueryCompilationDescriptor& query_comp_desc,
     const QueryMemoryDescriptor& query_mem_desc,
+    const QueryCompilationDescriptor* cpu_query_comp_desc,
+    const QueryMemoryDescriptor* cpu_query_mem_desc,
     QueryFragmentDescriptor& fragment_descriptor,
     std::unordered_set<int>& available_gpus,
     int& available_cpus) {
+  INJECT_TIMER(dispatchFragments);
   std::vector<std::future<void>> query_threads;
   const auto& ra_exe_unit = execution_dispatch.getExecutionUnit();
   CHECK(!ra_exe_unit.input_descs.empty());
 
+  // Two-class workload scheduling: interactive queries register with the
+  // priority gate before they contend for the executor lock (see
+  // RelAlgExecutor::executeRelAlgQueryNoRetry), and batch-class queries yield
+  // here at every fragment kernel boundary while any interactive query is in
+  // flight or queued. Preempting between fragments needs no kernel
+  // cancellation and keeps each individual yield short.
+  const bool low_priority = eo.low_priority;
+  const auto gated_dispatch = [&dispatch, low_priority](
+                                  const ExecutorDeviceType chosen_device_type,
+                                  int chosen_device_id,
+                                  const QueryCompilationDescriptor& query_comp_desc,
+                                  const QueryMemoryDescriptor& query_mem_desc,
+                                  const FragmentsList& frag_list,
+                                  const int64_t rowid_lookup_key) {
+    if (low_priority) {
+      QueryPriorityGate::getInstance().waitForHighPriorityQueries();
+    }
+    dispatch(chosen_device_type,
+             chosen_device_id,
+             query_comp_desc,
+             query_mem_desc,
+             frag_list,
+             rowid_lookup_key);
+  };
+
   const auto device_type = query_comp_desc.getDeviceType();
   const bool uses_lazy_fetch =
       plan_state_->allow_lazy_fetch_ &&
@@ -1553,17 +1751,60 @@ void Executor::dispatchFragments(
   const auto device_count = deviceCount(device_type);
   CHECK_GT(device_count, 0);
 
+  // Hybrid execution adds CPU workers to the GPU work stealing pool below, so
+  // scan-bound queries use the otherwise idle cores. Restricted to projections
+  // whose CPU and GPU kernels produce byte-identical row layouts, since the
+  // union of the per-kernel results assumes one layout across devices.
+  bool hybrid_execution = cpu_query_comp_desc && cpu_query_mem_desc &&
+                          device_type == ExecutorDeviceType::GPU && !is_agg &&
+                          !use_multifrag_kernel;
+  if (hybrid_execution &&
+      (cpu_query_mem_desc->getQueryDescriptionType() !=
+           query_mem_desc.getQueryDescriptionType() ||
+       cpu_query_mem_desc->didOutputColumnar() != query_mem_desc.didOutputColumnar() ||
+       cpu_query_mem_desc->getRowSize() != query_mem_desc.getRowSize())) {
+    VLOG(1) << "CPU and GPU output layouts differ, running GPU only";
+    hybrid_execution = false;
+  }
+
+  // Fragment sampling only makes sense for single table aggregates; joins and
+  // projections would return partial rows rather than scalable aggregates.
+  const bool allow_fragment_sampling = is_agg && ra_exe_unit.input_descs.size() == 1;
   fragment_descriptor.buildFragmentKernelMap(ra_exe_unit,
                                              execution_dispatch.getFragOffsets(),
                                              device_count,
                                              device_type,
                                              use_multifrag_kernel,
                                              g_inner_join_fragment_skipping,
+                                             allow_fragment_sampling,
                                              this);
   if (eo.with_watchdog && fragment_descriptor.shouldCheckWorkUnitWatchdog()) {
     checkWorkUnitWatchdog(ra_exe_unit, table_infos, *catalog_, device_type, device_count);
   }
 
+  std::future<void> chunk_prefetch_thread;
+  if (g_enable_chunk_prefetch) {
+    auto prefetch_lists = std::make_shared<std::vector<FragmentsList>>();
+    fragment_descriptor.assignFragsToWorkStealingDispatch(
+        [&prefetch_lists](const FragmentsList& frag_list) {
+          prefetch_lists->push_back(frag_list);
+        });
+    if (prefetch_lists->size() > 1) {
+      // Warm the CPU buffer pool for upcoming kernels while earlier ones run;
+      // the first kernel fetches its own chunks either way, so skip it.
+      prefetch_lists->erase(prefetch_lists->begin());
+      chunk_prefetch_thread =
+          std::async(std::launch::async, [this, prefetch_lists, &ra_exe_unit, &table_infos] {
+            try {
+              ColumnFetcher::prefetchFragmentsToCpu(
+                  ra_exe_unit, table_infos, *prefetch_lists, *catalog_);
+            } catch (const std::exception& e) {
+              LOG(WARNING) << "Chunk prefetch failed: " << e.what();
+            }
+          });
+    }
+  }
+
   if (use_multifrag_kernel) {
     VLOG(1) << "Dispatching multifrag kernels";
     VLOG(1) << query_mem_desc.toString();
@@ -1574,12 +1815,12 @@ void Executor::dispatchFragments(
     // GPU, we want the multifrag kernel path to save the overhead of allocating an output
     // buffer per fragment.
     auto multifrag_kernel_dispatch =
-        [&query_threads, &dispatch, query_comp_desc, query_mem_desc](
+        [&query_threads, &gated_dispatch, query_comp_desc, query_mem_desc](
             const int device_id,
             const FragmentsList& frag_list,
             const int64_t rowid_lookup_key) {
           query_threads.push_back(std::async(std::launch::async,
-                                             dispatch,
+                                             gated_dispatch,
                                              ExecutorDeviceType::GPU,
                                              device_id,
                                              query_comp_desc,
@@ -1589,6 +1830,92 @@ void Executor::dispatchFragments(
         };
     fragment_descriptor.assignFragsToMultiDispatch(multifrag_kernel_dispatch);
 
+  } else if (((g_enable_dynamic_fragment_dispatch && device_count > 1) ||
+              hybrid_execution) &&
+             device_type == ExecutorDeviceType::GPU &&
+             fragment_descriptor.allowsWorkStealingDispatch()) {
+    VLOG(1) << "Dispatching kernels with work stealing across " << device_count
+            << " devices" << (hybrid_execution ? " and the CPU worker pool" : "");
+    VLOG(1) << query_mem_desc.toString();
+
+    // Per-device workers pull kernels off a shared list as they finish, so
+    // fragment-size skew no longer leaves devices idle while one grinds
+    // through the fat fragments its static assignment gave it.
+    auto kernel_queue = std::make_shared<std::vector<FragmentsList>>();
+    fragment_descriptor.assignFragsToWorkStealingDispatch(
+        [&kernel_queue](const FragmentsList& frag_list) {
+          if (frag_list.size()) {
+            kernel_queue->push_back(frag_list);
+          }
+        });
+    auto next_kernel = std::make_shared<std::atomic<size_t>>(0);
+    for (int device_id = 0; device_id < device_count; ++device_id) {
+      query_threads.push_back(std::async(
+          std::launch::async,
+          [&gated_dispatch, kernel_queue, next_kernel, device_id, query_comp_desc, query_mem_desc] {
+            size_t kernel_idx;
+            while ((kernel_idx = next_kernel->fetch_add(1)) < kernel_queue->size()) {
+              gated_dispatch(ExecutorDeviceType::GPU,
+                       device_id,
+                       query_comp_desc,
+                       query_mem_desc,
+                       (*kernel_queue)[kernel_idx],
+                       -1);
+            }
+          }));
+    }
+    if (hybrid_execution) {
+      // CPU workers pull from the same kernel list, so the split between the
+      // device classes tracks their actual per-fragment throughput instead of
+      // a static ratio: whichever side finishes a kernel first takes the next
+      // one.
+      for (int cpu_worker = 0; cpu_worker < available_cpus; ++cpu_worker) {
+        query_threads.push_back(std::async(
+            std::launch::async,
+            [&gated_dispatch, kernel_queue, next_kernel, cpu_query_comp_desc,
+             cpu_query_mem_desc] {
+              size_t kernel_idx;
+              while ((kernel_idx = next_kernel->fetch_add(1)) < kernel_queue->size()) {
+                gated_dispatch(ExecutorDeviceType::CPU,
+                               0,
+                               *cpu_query_comp_desc,
+                               *cpu_query_mem_desc,
+                               (*kernel_queue)[kernel_idx],
+                               -1);
+              }
+            }));
+      }
+    }
+  } else if (g_enable_cpu_multifrag_kernels && device_type == ExecutorDeviceType::CPU &&
+             eo.allow_multifrag && is_agg && !uses_lazy_fetch &&
+             fragment_descriptor.allowsWorkStealingDispatch()) {
+    VLOG(1) << "Dispatching batched CPU kernels, " << g_cpu_multifrag_batch_size
+            << " fragments per kernel";
+    VLOG(1) << query_mem_desc.toString();
+
+    // The generated CPU entry point already iterates the fragment list the way
+    // the GPU multifrag kernels do; batching fragments per kernel amortizes
+    // the QueryExecutionContext creation and output buffer initialization
+    // which dominate short queries over many small fragments. Scan-only
+    // queries keep the per-fragment granularity, matching the multifrag
+    // kernel path above.
+    auto batched_kernel_dispatch =
+        [&query_threads, &gated_dispatch, query_comp_desc, query_mem_desc](
+            const FragmentsList& frag_list) {
+          if (!frag_list.size()) {
+            return;
+          }
+          query_threads.push_back(std::async(std::launch::async,
+                                             gated_dispatch,
+                                             ExecutorDeviceType::CPU,
+                                             0,
+                                             query_comp_desc,
+                                             query_mem_desc,
+                                             frag_list,
+                                             int64_t(-1)));
+        };
+    fragment_descriptor.assignFragsToBatchedKernelDispatch(batched_kernel_dispatch,
+                                                           g_cpu_multifrag_batch_size);
   } else {
     VLOG(1) << "Dispatching kernel per fragment";
     VLOG(1) << query_mem_desc.toString();
@@ -1608,7 +1935,7 @@ void Executor::dispatchFragments(
 
     size_t frag_list_idx{0};
     auto fragment_per_kernel_dispatch = [&query_threads,
-                                         &dispatch,
+                                         &gated_dispatch,
                                          &frag_list_idx,
                                          &device_type,
                                          query_comp_desc,
@@ -1621,7 +1948,7 @@ void Executor::dispatchFragments(
       CHECK_GE(device_id, 0);
 
       query_threads.push_back(std::async(std::launch::async,
-                                         dispatch,
+                                         gated_dispatch,
                                          device_type,
                                          device_id,
                                          query_comp_desc,
@@ -1638,6 +1965,9 @@ void Executor::dispatchFragments(
   for (auto& child : query_threads) {
     child.wait();
   }
+  if (chunk_prefetch_thread.valid()) {
+    chunk_prefetch_thread.wait();
+  }
   for (auto& child : query_threads) {
     child.get();
   }
@@ -1693,12 +2023,21 @@ bool Executor::skipFragmentPair(
         inner_table_id_to_join_condition,
     const RelAlgExecutionUnit& ra_exe_unit,
     const ExecutorDeviceType device_type) {
-  if (device_type != ExecutorDeviceType::GPU) {
-    return false;
-  }
   CHECK(table_idx >= 0 &&
         static_cast<size_t>(table_idx) < ra_exe_unit.input_descs.size());
   const int inner_table_id = ra_exe_unit.input_descs[table_idx].getTableId();
+  if (g_enable_sorted_fragment_pruning &&
+      skipFragmentPairBySortedJoinKey(outer_fragment_info,
+                                      inner_fragment_info,
+                                      inner_table_id,
+                                      table_idx,
+                                      inner_table_id_to_join_condition,
+                                      ra_exe_unit)) {
+    return true;
+  }
+  if (device_type != ExecutorDeviceType::GPU) {
+    return false;
+  }
   // Both tables need to be sharded the same way.
   if (outer_fragment_info.shard == -1 || inner_fragment_info.shard == -1 ||
       outer_fragment_info.shard == inner_fragment_info.shard) {
@@ -1743,6 +2082,100 @@ bool Executor::skipFragmentPair(
   return shard_count;
 }
 
+// When both sides of an equi-join are tables kept ordered on their join key
+// (TableDescriptor::sortedColumnId), per-fragment min/max metadata for the key
+// gives each fragment a tight key interval and most outer/inner fragment pairs
+// have disjoint intervals; such pairs cannot produce any matches and are
+// dropped from the dispatch. Unlike the shard-based check above this works on
+// CPU as well as GPU. Conservative: any shape it doesn't recognize (casts
+// around the key columns, composite keys, missing metadata) falls through to
+// the full cross product of fragments.
+bool Executor::skipFragmentPairBySortedJoinKey(
+    const Fragmenter_Namespace::FragmentInfo& outer_fragment_info,
+    const Fragmenter_Namespace::FragmentInfo& inner_fragment_info,
+    const int inner_table_id,
+    const int table_idx,
+    const std::unordered_map<int, const Analyzer::BinOper*>&
+        inner_table_id_to_join_condition,
+    const RelAlgExecutionUnit& ra_exe_unit) {
+  const Analyzer::BinOper* join_condition{nullptr};
+  if (ra_exe_unit.join_quals.empty()) {
+    const auto condition_it = inner_table_id_to_join_condition.find(inner_table_id);
+    if (condition_it != inner_table_id_to_join_condition.end()) {
+      join_condition = condition_it->second;
+    }
+  } else {
+    CHECK_EQ(plan_state_->join_info_.equi_join_tautologies_.size(),
+             plan_state_->join_info_.join_hash_tables_.size());
+    for (size_t i = 0; i < plan_state_->join_info_.join_hash_tables_.size(); ++i) {
+      if (plan_state_->join_info_.join_hash_tables_[i]->getInnerTableRteIdx() ==
+          table_idx) {
+        join_condition = plan_state_->join_info_.equi_join_tautologies_[i].get();
+      }
+    }
+  }
+  if (!join_condition || join_condition->get_optype() != kEQ) {
+    return false;
+  }
+  const auto lhs_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(join_condition->get_left_operand());
+  const auto rhs_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(join_condition->get_right_operand());
+  if (!lhs_col || !rhs_col) {
+    return false;
+  }
+  const auto inner_col = lhs_col->get_rte_idx() == table_idx ? lhs_col : rhs_col;
+  const auto outer_col = inner_col == lhs_col ? rhs_col : lhs_col;
+  if (inner_col->get_rte_idx() != table_idx || outer_col->get_rte_idx() != 0) {
+    return false;
+  }
+  const int outer_table_id = ra_exe_unit.input_descs[0].getTableId();
+  if (outer_table_id < 0 || inner_table_id < 0 ||
+      outer_col->get_table_id() != outer_table_id ||
+      inner_col->get_table_id() != inner_table_id) {
+    return false;
+  }
+  const auto outer_td = catalog_->getMetadataForTable(outer_table_id);
+  const auto inner_td = catalog_->getMetadataForTable(inner_table_id);
+  if (!outer_td || !inner_td ||
+      outer_td->sortedColumnId != outer_col->get_column_id() ||
+      inner_td->sortedColumnId != inner_col->get_column_id() ||
+      outer_td->sortedColumnId <= 0 || inner_td->sortedColumnId <= 0) {
+    return false;
+  }
+  const auto& key_type = inner_col->get_type_info();
+  if (!key_type.is_integer() && !key_type.is_time()) {
+    return false;
+  }
+  if (key_type.is_timestamp() &&
+      key_type.get_dimension() != outer_col->get_type_info().get_dimension()) {
+    // metadata holds values in each column's own precision
+    return false;
+  }
+  const auto frag_key_range =
+      [](const Fragmenter_Namespace::FragmentInfo& fragment_info,
+         const Analyzer::ColumnVar* col,
+         std::pair<int64_t, int64_t>& range) -> bool {
+    const auto& metadata_map = fragment_info.getChunkMetadataMap();
+    const auto chunk_meta_it = metadata_map.find(col->get_column_id());
+    if (chunk_meta_it == metadata_map.end()) {
+      return false;
+    }
+    const auto& col_ti = col->get_type_info();
+    range = {extract_min_stat(chunk_meta_it->second.chunkStats, col_ti),
+             extract_max_stat(chunk_meta_it->second.chunkStats, col_ti)};
+    return true;
+  };
+  std::pair<int64_t, int64_t> outer_range;
+  std::pair<int64_t, int64_t> inner_range;
+  if (!frag_key_range(outer_fragment_info, outer_col, outer_range) ||
+      !frag_key_range(inner_fragment_info, inner_col, inner_range)) {
+    return false;
+  }
+  return outer_range.second < inner_range.first ||
+         inner_range.second < outer_range.first;
+}
+
 namespace {
 
 const ColumnDescriptor* try_get_column_descriptor(const InputColDescriptor* col_desc,
@@ -1870,6 +2303,12 @@ Executor::FetchResult Executor::fetchChunks(
     std::vector<const int8_t*> frag_col_buffers(
         plan_state_->global_to_local_col_ids_.size());
     for (const auto& col_id : col_global_ids) {
+      // Chunk fetches can page columns in from disk one by one; bail out
+      // between them so an interrupt doesn't have to wait for the whole
+      // working set to land in memory.
+      if (interrupted_) {
+        throw QueryInterrupted();
+      }
       CHECK(col_id);
       const int table_id = col_id->getScanDesc().getTableId();
       const auto cd = try_get_column_descriptor(col_id.get(), cat);
@@ -1900,12 +2339,25 @@ Executor::FetchResult Executor::fetchChunks(
             col_id.get(), memory_level_for_column, device_id);
       } else {
         if (needFetchAllFragments(*col_id, ra_exe_unit, selected_fragments)) {
-          frag_col_buffers[it->second] =
-              column_fetcher.getAllTableColumnFragments(table_id,
+          const bool is_real_string = cd && cd->columnType.is_string() &&
+                                      cd->columnType.get_compression() == kENCODING_NONE;
+          if (is_real_string || (cd && cd->columnType.is_array())) {
+            // Varlen columns can't be columnarized by value; linearize the
+            // fragments into one chunk instead.
+            frag_col_buffers[it->second] =
+                column_fetcher.linearizeColumnFragments(table_id,
                                                         col_id->getColId(),
                                                         all_tables_fragments,
                                                         memory_level_for_column,
                                                         device_id);
+          } else {
+            frag_col_buffers[it->second] =
+                column_fetcher.getAllTableColumnFragments(table_id,
+                                                          col_id->getColId(),
+                                                          all_tables_fragments,
+                                                          memory_level_for_column,
+                                                          device_id);
+          }
         } else {
           frag_col_buffers[it->second] =
               column_fetcher.getOneTableColumnFragment(table_id,
@@ -2002,8 +2454,10 @@ class AggregateReductionEgress {
                         QueryExecutionContext* query_exe_context) {
     int64_t val1;
     const bool float_argument_input = takes_float_argument(agg_info);
-    if (is_distinct_target(agg_info)) {
-      CHECK(agg_info.agg_kind == kCOUNT || agg_info.agg_kind == kAPPROX_COUNT_DISTINCT);
+    if (is_distinct_target(agg_info) || agg_info.agg_kind == kAPPROX_MEDIAN ||
+        agg_info.agg_kind == kAPPROX_TOP_K) {
+      CHECK(agg_info.agg_kind == kCOUNT || agg_info.agg_kind == kAPPROX_COUNT_DISTINCT ||
+            agg_info.agg_kind == kAPPROX_MEDIAN || agg_info.agg_kind == kAPPROX_TOP_K);
       val1 = out_vec[out_vec_idx][0];
       error_code = 0;
     } else {
@@ -2120,7 +2574,7 @@ int32_t Executor::executePlanWithoutGroupBy(
   const auto hoist_buf = serializeLiterals(compilation_result.literal_values, device_id);
   const auto join_hash_table_ptrs = getJoinHashTablePtrs(device_type, device_id);
   std::unique_ptr<OutVecOwner> output_memory_scope;
-  if (g_enable_dynamic_watchdog && interrupted_) {
+  if (interrupted_) {
     return ERR_INTERRUPTED;
   }
   if (device_type == ExecutorDeviceType::CPU) {
@@ -2255,7 +2709,7 @@ int32_t Executor::executePlanWithGroupBy(
   auto hoist_buf = serializeLiterals(compilation_result.literal_values, device_id);
   int32_t error_code = device_type == ExecutorDeviceType::GPU ? 0 : start_rowid;
   const auto join_hash_table_ptrs = getJoinHashTablePtrs(device_type, device_id);
-  if (g_enable_dynamic_watchdog && interrupted_) {
+  if (interrupted_) {
     return ERR_INTERRUPTED;
   }
 
@@ -2410,13 +2864,12 @@ void Executor::executeSimpleInsert(const Planner::RootPlan* root_plan) {
   const auto& col_id_list = root_plan->get_result_col_list();
   std::vector<const ColumnDescriptor*> col_descriptors;
   std::vector<int> col_ids;
-  std::unordered_map<int, std::unique_ptr<uint8_t[]>> col_buffers;
+  std::unordered_map<int, std::vector<uint8_t>> col_buffers;
   std::unordered_map<int, std::vector<std::string>> str_col_buffers;
   std::unordered_map<int, std::vector<ArrayDatum>> arr_col_buffers;
   auto& cat = root_plan->getCatalog();
   const auto table_descriptor = cat.getMetadataForTable(table_id);
   const auto shard_tables = cat.getPhysicalTablesDescriptors(table_descriptor);
-  const TableDescriptor* shard{nullptr};
   for (const int col_id : col_id_list) {
     const auto cd = get_column_descriptor(col_id, table_id, cat);
     const auto col_enc = cd->columnType.get_compression();
@@ -2431,8 +2884,7 @@ void Executor::executeSimpleInsert(const Planner::RootPlan* root_plan) {
         case kENCODING_DICT: {
           const auto dd = cat.getMetadataForDict(cd->columnType.get_comp_param());
           CHECK(dd);
-          const auto it_ok = col_buffers.emplace(
-              col_id, std::unique_ptr<uint8_t[]>(new uint8_t[cd->columnType.get_size()]));
+          const auto it_ok = col_buffers.emplace(col_id, std::vector<uint8_t>{});
           CHECK(it_ok.second);
           break;
         }
@@ -2448,223 +2900,257 @@ void Executor::executeSimpleInsert(const Planner::RootPlan* root_plan) {
           arr_col_buffers.insert(std::make_pair(col_id, std::vector<ArrayDatum>{}));
       CHECK(it_ok.second);
     } else {
-      const auto it_ok = col_buffers.emplace(
-          col_id,
-          std::unique_ptr<uint8_t[]>(
-              new uint8_t[cd->columnType.get_logical_size()]()));  // changed to zero-init
-                                                                   // the buffer
+      const auto it_ok = col_buffers.emplace(col_id, std::vector<uint8_t>{});
       CHECK(it_ok.second);
     }
     col_descriptors.push_back(cd);
     col_ids.push_back(col_id);
   }
-  size_t col_idx = 0;
-  Fragmenter_Namespace::InsertData insert_data;
-  insert_data.databaseId = cat.getCurrentDB().dbId;
-  insert_data.tableId = table_id;
-  int64_t int_col_val{0};
-  for (auto target_entry : targets) {
-    auto col_cv = dynamic_cast<const Analyzer::Constant*>(target_entry->get_expr());
-    if (!col_cv) {
-      auto col_cast = dynamic_cast<const Analyzer::UOper*>(target_entry->get_expr());
-      CHECK(col_cast);
-      CHECK_EQ(kCAST, col_cast->get_optype());
-      col_cv = dynamic_cast<const Analyzer::Constant*>(col_cast->get_operand());
-    }
-    CHECK(col_cv);
-    const auto cd = col_descriptors[col_idx];
-    auto col_datum = col_cv->get_constval();
-    auto col_type = cd->columnType.get_type();
-    uint8_t* col_data_bytes{nullptr};
-    if (!cd->columnType.is_array() && !cd->columnType.is_geometry() &&
-        (!cd->columnType.is_string() ||
-         cd->columnType.get_compression() == kENCODING_DICT)) {
-      const auto col_data_bytes_it = col_buffers.find(col_ids[col_idx]);
-      CHECK(col_data_bytes_it != col_buffers.end());
-      col_data_bytes = col_data_bytes_it->second.get();
-    }
-    switch (col_type) {
-      case kBOOLEAN: {
-        auto col_data = col_data_bytes;
-        *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
-                                          : (col_datum.boolval ? 1 : 0);
-        break;
-      }
-      case kTINYINT: {
-        auto col_data = reinterpret_cast<int8_t*>(col_data_bytes);
-        *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
-                                          : col_datum.tinyintval;
-        int_col_val = col_datum.tinyintval;
-        break;
-      }
-      case kSMALLINT: {
-        auto col_data = reinterpret_cast<int16_t*>(col_data_bytes);
-        *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
-                                          : col_datum.smallintval;
-        int_col_val = col_datum.smallintval;
-        break;
-      }
-      case kINT: {
-        auto col_data = reinterpret_cast<int32_t*>(col_data_bytes);
-        *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
-                                          : col_datum.intval;
-        int_col_val = col_datum.intval;
-        break;
+  // Appends one VALUES row to the columnwise buffers and returns the shard the
+  // row belongs to, if the table is sharded.
+  auto process_row = [&](const std::vector<std::shared_ptr<Analyzer::TargetEntry>>&
+                             row_targets) -> const TableDescriptor* {
+    size_t col_idx = 0;
+    int64_t int_col_val{0};
+    const TableDescriptor* shard{nullptr};
+    for (const auto& target_entry : row_targets) {
+      auto col_cv = dynamic_cast<const Analyzer::Constant*>(target_entry->get_expr());
+      if (!col_cv) {
+        auto col_cast = dynamic_cast<const Analyzer::UOper*>(target_entry->get_expr());
+        CHECK(col_cast);
+        CHECK_EQ(kCAST, col_cast->get_optype());
+        col_cv = dynamic_cast<const Analyzer::Constant*>(col_cast->get_operand());
       }
-      case kBIGINT:
-      case kDECIMAL:
-      case kNUMERIC: {
-        auto col_data = reinterpret_cast<int64_t*>(col_data_bytes);
-        *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
-                                          : col_datum.bigintval;
-        int_col_val = col_datum.bigintval;
-        break;
-      }
-      case kFLOAT: {
-        auto col_data = reinterpret_cast<float*>(col_data_bytes);
-        *col_data = col_datum.floatval;
-        break;
+      CHECK(col_cv);
+      const auto cd = col_descriptors[col_idx];
+      auto col_datum = col_cv->get_constval();
+      auto col_type = cd->columnType.get_type();
+      uint8_t* col_data_bytes{nullptr};
+      if (!cd->columnType.is_array() && !cd->columnType.is_geometry() &&
+          (!cd->columnType.is_string() ||
+           cd->columnType.get_compression() == kENCODING_DICT)) {
+        const auto col_data_bytes_it = col_buffers.find(col_ids[col_idx]);
+        CHECK(col_data_bytes_it != col_buffers.end());
+        auto& buffer = col_data_bytes_it->second;
+        const size_t col_width = cd->columnType.is_string()
+                                     ? cd->columnType.get_size()
+                                     : cd->columnType.get_logical_size();
+        buffer.resize(buffer.size() + col_width, 0);  // zero-initialized like before
+        col_data_bytes = buffer.data() + buffer.size() - col_width;
       }
-      case kDOUBLE: {
-        auto col_data = reinterpret_cast<double*>(col_data_bytes);
-        *col_data = col_datum.doubleval;
-        break;
-      }
-      case kTEXT:
-      case kVARCHAR:
-      case kCHAR: {
-        switch (cd->columnType.get_compression()) {
-          case kENCODING_NONE:
-            str_col_buffers[col_ids[col_idx]].push_back(
-                col_datum.stringval ? *col_datum.stringval : "");
-            break;
-          case kENCODING_DICT: {
-            switch (cd->columnType.get_size()) {
-              case 1:
-                int_col_val = insert_one_dict_str(
-                    reinterpret_cast<uint8_t*>(col_data_bytes), cd, col_cv, cat);
-                break;
-              case 2:
-                int_col_val = insert_one_dict_str(
-                    reinterpret_cast<uint16_t*>(col_data_bytes), cd, col_cv, cat);
-                break;
-              case 4:
-                int_col_val = insert_one_dict_str(
-                    reinterpret_cast<int32_t*>(col_data_bytes), cd, col_cv, cat);
-                break;
-              default:
-                CHECK(false);
-            }
-            break;
-          }
-          default:
-            CHECK(false);
+      switch (col_type) {
+        case kBOOLEAN: {
+          auto col_data = col_data_bytes;
+          *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
+                                            : (col_datum.boolval ? 1 : 0);
+          break;
         }
-        break;
-      }
-      case kTIME:
-      case kTIMESTAMP:
-      case kDATE: {
-        auto col_data = reinterpret_cast<int64_t*>(col_data_bytes);
-        *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
-                                          : col_datum.bigintval;
-        break;
-      }
-      case kARRAY: {
-        const auto is_null = col_cv->get_is_null();
-        const auto size = cd->columnType.get_size();
-        const SQLTypeInfo elem_ti = cd->columnType.get_elem_type();
-        if (is_null) {
-          if (size > 0) {
-            // NULL fixlen array: fill with scalar NULL sentinels
-            int8_t* buf = (int8_t*)checked_malloc(size);
-            for (int8_t* p = buf; (p - buf) < size; p += elem_ti.get_size()) {
-              put_null(static_cast<void*>(p), elem_ti, "");
+        case kTINYINT: {
+          auto col_data = reinterpret_cast<int8_t*>(col_data_bytes);
+          *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
+                                            : col_datum.tinyintval;
+          int_col_val = col_datum.tinyintval;
+          break;
+        }
+        case kSMALLINT: {
+          auto col_data = reinterpret_cast<int16_t*>(col_data_bytes);
+          *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
+                                            : col_datum.smallintval;
+          int_col_val = col_datum.smallintval;
+          break;
+        }
+        case kINT: {
+          auto col_data = reinterpret_cast<int32_t*>(col_data_bytes);
+          *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
+                                            : col_datum.intval;
+          int_col_val = col_datum.intval;
+          break;
+        }
+        case kBIGINT:
+        case kDECIMAL:
+        case kNUMERIC: {
+          auto col_data = reinterpret_cast<int64_t*>(col_data_bytes);
+          *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
+                                            : col_datum.bigintval;
+          int_col_val = col_datum.bigintval;
+          break;
+        }
+        case kFLOAT: {
+          auto col_data = reinterpret_cast<float*>(col_data_bytes);
+          *col_data = col_datum.floatval;
+          break;
+        }
+        case kDOUBLE: {
+          auto col_data = reinterpret_cast<double*>(col_data_bytes);
+          *col_data = col_datum.doubleval;
+          break;
+        }
+        case kTEXT:
+        case kVARCHAR:
+        case kCHAR: {
+          switch (cd->columnType.get_compression()) {
+            case kENCODING_NONE:
+              str_col_buffers[col_ids[col_idx]].push_back(
+                  col_datum.stringval ? *col_datum.stringval : "");
+              break;
+            case kENCODING_DICT: {
+              switch (cd->columnType.get_size()) {
+                case 1:
+                  int_col_val = insert_one_dict_str(
+                      reinterpret_cast<uint8_t*>(col_data_bytes), cd, col_cv, cat);
+                  break;
+                case 2:
+                  int_col_val = insert_one_dict_str(
+                      reinterpret_cast<uint16_t*>(col_data_bytes), cd, col_cv, cat);
+                  break;
+                case 4:
+                  int_col_val = insert_one_dict_str(
+                      reinterpret_cast<int32_t*>(col_data_bytes), cd, col_cv, cat);
+                  break;
+                default:
+                  CHECK(false);
+              }
+              break;
             }
-            arr_col_buffers[col_ids[col_idx]].emplace_back(size, buf, is_null);
-          } else {
-            arr_col_buffers[col_ids[col_idx]].emplace_back(0, nullptr, is_null);
+            default:
+              CHECK(false);
           }
           break;
         }
-        const auto l = col_cv->get_value_list();
-        size_t len = l.size() * elem_ti.get_size();
-        if (size > 0 && static_cast<size_t>(size) != len) {
-          throw std::runtime_error("Array column " + cd->columnName + " expects " +
-                                   std::to_string(size / elem_ti.get_size()) +
-                                   " values, " + "received " + std::to_string(l.size()));
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE: {
+          auto col_data = reinterpret_cast<int64_t*>(col_data_bytes);
+          *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType)
+                                            : col_datum.bigintval;
+          break;
         }
-        if (elem_ti.is_string()) {
-          CHECK(kENCODING_DICT == elem_ti.get_compression());
-          CHECK(4 == elem_ti.get_size());
+        case kARRAY: {
+          const auto is_null = col_cv->get_is_null();
+          const auto size = cd->columnType.get_size();
+          const SQLTypeInfo elem_ti = cd->columnType.get_elem_type();
+          if (is_null) {
+            if (size > 0) {
+              // NULL fixlen array: fill with scalar NULL sentinels
+              int8_t* buf = (int8_t*)checked_malloc(size);
+              for (int8_t* p = buf; (p - buf) < size; p += elem_ti.get_size()) {
+                put_null(static_cast<void*>(p), elem_ti, "");
+              }
+              arr_col_buffers[col_ids[col_idx]].emplace_back(size, buf, is_null);
+            } else {
+              arr_col_buffers[col_ids[col_idx]].emplace_back(0, nullptr, is_null);
+            }
+            break;
+          }
+          const auto l = col_cv->get_value_list();
+          size_t len = l.size() * elem_ti.get_size();
+          if (size > 0 && static_cast<size_t>(size) != len) {
+            throw std::runtime_error("Array column " + cd->columnName + " expects " +
+                                     std::to_string(size / elem_ti.get_size()) +
+                                     " values, " + "received " + std::to_string(l.size()));
+          }
+          if (elem_ti.is_string()) {
+            CHECK(kENCODING_DICT == elem_ti.get_compression());
+            CHECK(4 == elem_ti.get_size());
 
-          int8_t* buf = (int8_t*)checked_malloc(len);
-          int32_t* p = reinterpret_cast<int32_t*>(buf);
+            int8_t* buf = (int8_t*)checked_malloc(len);
+            int32_t* p = reinterpret_cast<int32_t*>(buf);
 
-          int elemIndex = 0;
-          for (auto& e : l) {
-            auto c = std::dynamic_pointer_cast<Analyzer::Constant>(e);
-            CHECK(c);
+            int elemIndex = 0;
+            for (auto& e : l) {
+              auto c = std::dynamic_pointer_cast<Analyzer::Constant>(e);
+              CHECK(c);
 
-            int_col_val =
-                insert_one_dict_str(&p[elemIndex], cd->columnName, elem_ti, c.get(), cat);
+              int_col_val =
+                  insert_one_dict_str(&p[elemIndex], cd->columnName, elem_ti, c.get(), cat);
 
-            elemIndex++;
-          }
-          arr_col_buffers[col_ids[col_idx]].push_back(ArrayDatum(len, buf, is_null));
+              elemIndex++;
+            }
+            arr_col_buffers[col_ids[col_idx]].push_back(ArrayDatum(len, buf, is_null));
 
-        } else {
-          int8_t* buf = (int8_t*)checked_malloc(len);
-          int8_t* p = buf;
-          for (auto& e : l) {
-            auto c = std::dynamic_pointer_cast<Analyzer::Constant>(e);
-            CHECK(c);
-            p = Importer_NS::appendDatum(p, c->get_constval(), elem_ti);
+          } else {
+            int8_t* buf = (int8_t*)checked_malloc(len);
+            int8_t* p = buf;
+            for (auto& e : l) {
+              auto c = std::dynamic_pointer_cast<Analyzer::Constant>(e);
+              CHECK(c);
+              p = Importer_NS::appendDatum(p, c->get_constval(), elem_ti);
+            }
+            arr_col_buffers[col_ids[col_idx]].push_back(ArrayDatum(len, buf, is_null));
           }
-          arr_col_buffers[col_ids[col_idx]].push_back(ArrayDatum(len, buf, is_null));
+          break;
         }
-        break;
+        case kPOINT:
+        case kLINESTRING:
+        case kPOLYGON:
+        case kMULTIPOLYGON:
+          str_col_buffers[col_ids[col_idx]].push_back(
+              col_datum.stringval ? *col_datum.stringval : "");
+          break;
+        default:
+          CHECK(false);
       }
-      case kPOINT:
-      case kLINESTRING:
-      case kPOLYGON:
-      case kMULTIPOLYGON:
-        str_col_buffers[col_ids[col_idx]].push_back(
-            col_datum.stringval ? *col_datum.stringval : "");
-        break;
-      default:
-        CHECK(false);
+      ++col_idx;
+      if (col_idx == static_cast<size_t>(table_descriptor->shardedColumnId)) {
+        const auto shard_count = shard_tables.size();
+        const size_t shard_idx = SHARD_FOR_KEY(int_col_val, shard_count);
+        shard = shard_tables[shard_idx];
+      }
+    }
+    return shard;
+  };
+  auto flush_rows = [&](const size_t num_rows, const TableDescriptor* flush_td) {
+    Fragmenter_Namespace::InsertData insert_data;
+    insert_data.databaseId = cat.getCurrentDB().dbId;
+    insert_data.tableId = table_id;
+    for (auto& kv : col_buffers) {
+      insert_data.columnIds.push_back(kv.first);
+      DataBlockPtr p;
+      p.numbersPtr = reinterpret_cast<int8_t*>(kv.second.data());
+      insert_data.data.push_back(p);
+    }
+    for (auto& kv : str_col_buffers) {
+      insert_data.columnIds.push_back(kv.first);
+      DataBlockPtr p;
+      p.stringsPtr = &kv.second;
+      insert_data.data.push_back(p);
+    }
+    for (auto& kv : arr_col_buffers) {
+      insert_data.columnIds.push_back(kv.first);
+      DataBlockPtr p;
+      p.arraysPtr = &kv.second;
+      insert_data.data.push_back(p);
+    }
+    insert_data.numRows = num_rows;
+    flush_td->fragmenter->insertData(insert_data);
+    for (auto& kv : col_buffers) {
+      kv.second.clear();
+    }
+    for (auto& kv : str_col_buffers) {
+      kv.second.clear();
+    }
+    for (auto& kv : arr_col_buffers) {
+      kv.second.clear();
+    }
+  };
+  const auto& values_lists = values_plan->get_values_lists();
+  if (table_descriptor->shardedColumnId) {
+    // Each row hashes to its own shard, so sharded tables flush row by row;
+    // the parse and plan are still paid only once for the whole VALUES list.
+    const auto shard = process_row(targets);
+    CHECK(shard);
+    flush_rows(1, shard);
+    for (const auto& row : values_lists) {
+      const auto row_shard = process_row(row);
+      CHECK(row_shard);
+      flush_rows(1, row_shard);
     }
-    ++col_idx;
-    if (col_idx == static_cast<size_t>(table_descriptor->shardedColumnId)) {
-      const auto shard_count = shard_tables.size();
-      const size_t shard_idx = SHARD_FOR_KEY(int_col_val, shard_count);
-      shard = shard_tables[shard_idx];
-    }
-  }
-  for (const auto& kv : col_buffers) {
-    insert_data.columnIds.push_back(kv.first);
-    DataBlockPtr p;
-    p.numbersPtr = reinterpret_cast<int8_t*>(kv.second.get());
-    insert_data.data.push_back(p);
-  }
-  for (auto& kv : str_col_buffers) {
-    insert_data.columnIds.push_back(kv.first);
-    DataBlockPtr p;
-    p.stringsPtr = &kv.second;
-    insert_data.data.push_back(p);
-  }
-  for (auto& kv : arr_col_buffers) {
-    insert_data.columnIds.push_back(kv.first);
-    DataBlockPtr p;
-    p.arraysPtr = &kv.second;
-    insert_data.data.push_back(p);
-  }
-  insert_data.numRows = 1;
-  if (shard) {
-    shard->fragmenter->insertData(insert_data);
   } else {
-    table_descriptor->fragmenter->insertData(insert_data);
+    process_row(targets);
+    for (const auto& row : values_lists) {
+      process_row(row);
+    }
+    flush_rows(1 + values_lists.size(), table_descriptor);
   }
 }
 
@@ -2901,6 +3387,21 @@ std::pair<bool, int64_t> Executor::skipFragment(
     const std::vector<uint64_t>& frag_offsets,
     const size_t frag_idx) {
   const int table_id = table_desc.getTableId();
+  // A fragment whose deleted column metadata shows a minimum of true consists
+  // entirely of deleted rows and cannot contribute to any result; skip it
+  // outright instead of scanning it just to filter everything out.
+  if (table_id > 0 && fragment.getNumTuples() > 0) {
+    const auto td = catalog_->getMetadataForTable(table_id);
+    const auto deleted_cd = td ? catalog_->getDeletedColumn(td) : nullptr;
+    if (deleted_cd) {
+      const auto deleted_meta_it =
+          fragment.getChunkMetadataMap().find(deleted_cd->columnId);
+      if (deleted_meta_it != fragment.getChunkMetadataMap().end() &&
+          deleted_meta_it->second.chunkStats.min.tinyintval == 1) {
+        return {true, -1};
+      }
+    }
+  }
   for (const auto simple_qual : simple_quals) {
     const auto comp_expr =
         std::dynamic_pointer_cast<const Analyzer::BinOper>(simple_qual);
@@ -2995,6 +3496,22 @@ std::pair<bool, int64_t> Executor::skipFragment(
           return {true, -1};
         } else if (is_rowid) {
           return {false, rhs_val - start_rowid};
+        } else if (g_enable_fragment_bloom_filters && table_id > 0 &&
+                   fragment.physicalTableId >= 0 &&
+                   chunk_meta_it != fragment.getChunkMetadataMap().end() &&
+                   lhs_col->get_type_info().is_integer()) {
+          // The min/max range covers the probe value; ask the (lazily built)
+          // per-fragment bloom filter whether the value can actually be there.
+          const auto cd = get_column_descriptor(col_id, table_id, *catalog_);
+          const ChunkKey chunk_key{catalog_->getCurrentDB().dbId,
+                                   fragment.physicalTableId,
+                                   col_id,
+                                   fragment.fragmentId};
+          const auto filter = FragmentBloomFilterCache::getOrBuild(
+              *catalog_, cd, chunk_key, chunk_meta_it->second);
+          if (filter && !filter->maybeContains(rhs_val)) {
+            return {true, -1};
+          }
         }
         break;
       default:
@@ -3004,6 +3521,112 @@ std::pair<bool, int64_t> Executor::skipFragment(
   return {false, -1};
 }
 
+// For a table kept ordered on TableDescriptor::sortedColumnId, fragment
+// min/max metadata for the sort column is monotone across the fragment list,
+// so a range predicate on that column selects a contiguous run of fragments
+// which can be found by binary search instead of testing every fragment's
+// metadata. Returns the [start, end) subrange of fragments worth handing to
+// skipFragment; fragments outside it cannot satisfy the sort column
+// predicates. Falls back to the full range whenever the predicate shape or
+// metadata doesn't support the search.
+std::pair<size_t, size_t> Executor::getSortedFragmentRange(
+    const InputDescriptor& table_desc,
+    const std::deque<Fragmenter_Namespace::FragmentInfo>& fragments,
+    const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals) {
+  const std::pair<size_t, size_t> full_range{0, fragments.size()};
+  if (!g_enable_sorted_fragment_pruning || fragments.size() < 2) {
+    return full_range;
+  }
+  const int table_id = table_desc.getTableId();
+  if (table_id < 0) {
+    return full_range;
+  }
+  const auto td = catalog_->getMetadataForTable(table_id);
+  if (!td || td->sortedColumnId <= 0) {
+    return full_range;
+  }
+  const int col_id = td->sortedColumnId;
+  size_t range_start = 0;
+  size_t range_end = fragments.size();
+  for (const auto& simple_qual : simple_quals) {
+    const auto comp_expr =
+        std::dynamic_pointer_cast<const Analyzer::BinOper>(simple_qual);
+    if (!comp_expr) {
+      continue;
+    }
+    const auto lhs_col =
+        dynamic_cast<const Analyzer::ColumnVar*>(comp_expr->get_left_operand());
+    if (!lhs_col || lhs_col->get_table_id() != table_id || lhs_col->get_rte_idx() ||
+        lhs_col->get_column_id() != col_id) {
+      continue;
+    }
+    const auto rhs_const =
+        dynamic_cast<const Analyzer::Constant*>(comp_expr->get_right_operand());
+    if (!rhs_const) {
+      continue;
+    }
+    const auto& lhs_type = lhs_col->get_type_info();
+    if (!lhs_type.is_integer() && !lhs_type.is_time()) {
+      continue;
+    }
+    if (lhs_type.is_timestamp() &&
+        lhs_type.get_dimension() != rhs_const->get_type_info().get_dimension()) {
+      // metadata holds values in the column's precision; leave precision
+      // rescaling to the per-fragment path rather than duplicating it here
+      continue;
+    }
+    CodeGenerator code_generator(this);
+    const auto rhs_val = code_generator.codegenIntConst(rhs_const)->getSExtValue();
+    bool missing_metadata = false;
+    const auto frag_stats = [&fragments, &missing_metadata, col_id, &lhs_type](
+                                const size_t frag_idx) -> std::pair<int64_t, int64_t> {
+      const auto& metadata_map = fragments[frag_idx].getChunkMetadataMap();
+      const auto chunk_meta_it = metadata_map.find(col_id);
+      if (chunk_meta_it == metadata_map.end()) {
+        missing_metadata = true;
+        return {0, 0};
+      }
+      return {extract_min_stat(chunk_meta_it->second.chunkStats, lhs_type),
+              extract_max_stat(chunk_meta_it->second.chunkStats, lhs_type)};
+    };
+    const auto optype = comp_expr->get_optype();
+    if (optype == kGE || optype == kGT || optype == kEQ) {
+      // drop the leading fragments whose max is entirely below the bound
+      size_t lo = range_start;
+      size_t hi = range_end;
+      while (lo < hi && !missing_metadata) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const auto stats = frag_stats(mid);
+        if (stats.second < rhs_val || (optype == kGT && stats.second <= rhs_val)) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      range_start = lo;
+    }
+    if (optype == kLE || optype == kLT || optype == kEQ) {
+      // drop the trailing fragments whose min is entirely above the bound
+      size_t lo = range_start;
+      size_t hi = range_end;
+      while (lo < hi && !missing_metadata) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const auto stats = frag_stats(mid);
+        if (stats.first > rhs_val || (optype == kLT && stats.first >= rhs_val)) {
+          hi = mid;
+        } else {
+          lo = mid + 1;
+        }
+      }
+      range_end = hi;
+    }
+    if (missing_metadata) {
+      return full_range;
+    }
+  }
+  return {range_start, range_end};
+}
+
 /*
  *   The skipFragmentInnerJoins process all quals stored in the execution unit's
  * join_quals and gather all the ones that meet the "simple_qual" characteristics
@@ -3061,7 +3684,449 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
   return skip_frag;
 }
 
-std::map<std::pair<int, ::QueryRenderer::QueryRenderManager*>, std::shared_ptr<Executor>>
+bool Executor::skipFragmentForJoinBuildRange(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const InputDescriptor& table_desc,
+    const Fragmenter_Namespace::FragmentInfo& fragment) {
+  if (!g_enable_join_build_range_pruning) {
+    return false;
+  }
+  // Outer rows without a match still surface in non-inner joins.
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    if (join_condition.type != JoinType::INNER) {
+      return false;
+    }
+  }
+  CHECK(plan_state_);
+  for (const auto& hash_table : plan_state_->join_info_.join_hash_tables_) {
+    const auto perfect_hash_table = std::dynamic_pointer_cast<JoinHashTable>(hash_table);
+    if (!perfect_hash_table) {
+      continue;
+    }
+    if (perfect_hash_table->getJoinOpType() == kBW_EQ) {
+      // Bitwise equality matches null keys, which the metadata range can't bound.
+      continue;
+    }
+    const auto outer_col = perfect_hash_table->getProbeColumn();
+    if (!outer_col || outer_col->get_rte_idx() != 0 ||
+        outer_col->get_table_id() != table_desc.getTableId()) {
+      continue;
+    }
+    const auto& outer_ti = outer_col->get_type_info();
+    if (!outer_ti.is_integer() && !outer_ti.is_time()) {
+      continue;
+    }
+    const auto build_range = perfect_hash_table->getBuildKeyRange();
+    if (build_range.getType() != ExpressionRangeType::Integer) {
+      continue;
+    }
+    const auto chunk_meta_it =
+        fragment.getChunkMetadataMap().find(outer_col->get_column_id());
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+      continue;
+    }
+    const auto chunk_min =
+        extract_min_stat(chunk_meta_it->second.chunkStats, outer_ti);
+    const auto chunk_max =
+        extract_max_stat(chunk_meta_it->second.chunkStats, outer_ti);
+    if (chunk_min > build_range.getIntMax() || chunk_max < build_range.getIntMin()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace {
+
+// Floor division, for mapping a timestamp to its containing period window
+// without the round-toward-zero bias of operator/ on negative epochs.
+int64_t floor_div(const int64_t dividend, const int64_t divisor) {
+  const auto quotient = dividend / divisor;
+  return quotient - (dividend % divisor != 0 && (dividend ^ divisor) < 0 ? 1 : 0);
+}
+
+// Bounds the value of a scalar expression over a single fragment, substituting
+// the fragment's own chunk metadata at column leaves. getExpressionRange can't
+// be reused for this: its ColumnVar case consults the executor's whole-table
+// column range cache, which is exactly the granularity per-fragment pruning
+// needs to beat. Any expression shape not handled below yields an invalid
+// range, which disables pruning for the enclosing predicate.
+ExpressionRange get_fragment_expr_range(
+    const Analyzer::Expr* expr,
+    const int table_id,
+    const Fragmenter_Namespace::FragmentInfo& fragment) {
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr);
+  if (col_var) {
+    if (col_var->get_table_id() != table_id || col_var->get_rte_idx() != 0) {
+      return ExpressionRange::makeInvalidRange();
+    }
+    const auto& ti = col_var->get_type_info();
+    const auto chunk_meta_it =
+        fragment.getChunkMetadataMap().find(col_var->get_column_id());
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end() ||
+        chunk_meta_it->second.numElements == 0) {
+      return ExpressionRange::makeInvalidRange();
+    }
+    const auto& chunk_stats = chunk_meta_it->second.chunkStats;
+    if ((ti.is_integer() || ti.is_time()) &&
+        ti.get_compression() != kENCODING_DATE_IN_DAYS) {
+      return ExpressionRange::makeIntRange(extract_min_stat(chunk_stats, ti),
+                                           extract_max_stat(chunk_stats, ti),
+                                           0,
+                                           chunk_stats.has_nulls);
+    }
+    if (ti.get_type() == kFLOAT) {
+      return ExpressionRange::makeFloatRange(
+          chunk_stats.min.floatval, chunk_stats.max.floatval, chunk_stats.has_nulls);
+    }
+    if (ti.get_type() == kDOUBLE) {
+      return ExpressionRange::makeDoubleRange(
+          chunk_stats.min.doubleval, chunk_stats.max.doubleval, chunk_stats.has_nulls);
+    }
+    return ExpressionRange::makeInvalidRange();
+  }
+  if (dynamic_cast<const Analyzer::Constant*>(expr)) {
+    return getExpressionRange(expr, {}, nullptr);
+  }
+  const auto u_oper = dynamic_cast<const Analyzer::UOper*>(expr);
+  if (u_oper) {
+    if (u_oper->get_optype() != kCAST) {
+      return ExpressionRange::makeInvalidRange();
+    }
+    const auto arg_range =
+        get_fragment_expr_range(u_oper->get_operand(), table_id, fragment);
+    const auto& ti = u_oper->get_type_info();
+    const auto& arg_ti = u_oper->get_operand()->get_type_info();
+    if (arg_range.getType() == ExpressionRangeType::Integer) {
+      if ((ti.is_integer() || ti.is_time()) && !ti.is_decimal() &&
+          !arg_ti.is_decimal() &&
+          !(ti.is_timestamp() && arg_ti.is_timestamp() &&
+            ti.get_dimension() != arg_ti.get_dimension())) {
+        return arg_range;
+      }
+      if (ti.get_type() == kDOUBLE && !arg_ti.is_decimal()) {
+        return ExpressionRange::makeDoubleRange(
+            arg_range.getIntMin(), arg_range.getIntMax(), arg_range.hasNulls());
+      }
+      return ExpressionRange::makeInvalidRange();
+    }
+    if (arg_range.getType() == ExpressionRangeType::Float &&
+        ti.get_type() == kDOUBLE) {
+      return ExpressionRange::makeDoubleRange(
+          arg_range.getFpMin(), arg_range.getFpMax(), arg_range.hasNulls());
+    }
+    if ((arg_range.getType() == ExpressionRangeType::Float &&
+         ti.get_type() == kFLOAT) ||
+        (arg_range.getType() == ExpressionRangeType::Double &&
+         ti.get_type() == kDOUBLE)) {
+      return arg_range;
+    }
+    return ExpressionRange::makeInvalidRange();
+  }
+  const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(expr);
+  if (bin_oper && IS_ARITHMETIC(bin_oper->get_optype())) {
+    if (bin_oper->get_type_info().is_decimal()) {
+      // decimal arithmetic rescales its operands in ways the interval
+      // operators below don't model
+      return ExpressionRange::makeInvalidRange();
+    }
+    const auto lhs_range =
+        get_fragment_expr_range(bin_oper->get_left_operand(), table_id, fragment);
+    const auto rhs_range =
+        get_fragment_expr_range(bin_oper->get_right_operand(), table_id, fragment);
+    if (lhs_range.getType() != rhs_range.getType() ||
+        lhs_range.getType() == ExpressionRangeType::Invalid) {
+      return ExpressionRange::makeInvalidRange();
+    }
+    try {
+      switch (bin_oper->get_optype()) {
+        case kPLUS:
+          return lhs_range + rhs_range;
+        case kMINUS:
+          return lhs_range - rhs_range;
+        case kMULTIPLY:
+          return lhs_range * rhs_range;
+        case kDIVIDE: {
+          if (lhs_range.getType() == ExpressionRangeType::Integer) {
+            return lhs_range / rhs_range;
+          }
+          // the shared operator only divides integer intervals; grid cell
+          // expressions divide by a fractional cell size, so cover the
+          // floating point case here
+          if (rhs_range.getFpMin() <= 0 && rhs_range.getFpMax() >= 0) {
+            return ExpressionRange::makeInvalidRange();
+          }
+          const double candidates[]{lhs_range.getFpMin() / rhs_range.getFpMin(),
+                                    lhs_range.getFpMin() / rhs_range.getFpMax(),
+                                    lhs_range.getFpMax() / rhs_range.getFpMin(),
+                                    lhs_range.getFpMax() / rhs_range.getFpMax()};
+          const auto div_min = *std::min_element(std::begin(candidates),
+                                                 std::end(candidates));
+          const auto div_max = *std::max_element(std::begin(candidates),
+                                                 std::end(candidates));
+          const bool div_has_nulls = lhs_range.hasNulls() || rhs_range.hasNulls();
+          return lhs_range.getType() == ExpressionRangeType::Double
+                     ? ExpressionRange::makeDoubleRange(
+                           div_min, div_max, div_has_nulls)
+                     : ExpressionRange::makeFloatRange(
+                           div_min, div_max, div_has_nulls);
+        }
+        default:
+          return ExpressionRange::makeInvalidRange();
+      }
+    } catch (...) {
+      // checked arithmetic on the interval endpoints overflowed
+      return ExpressionRange::makeInvalidRange();
+    }
+  }
+  const auto extract_expr = dynamic_cast<const Analyzer::ExtractExpr*>(expr);
+  if (extract_expr) {
+    const auto arg_range =
+        get_fragment_expr_range(extract_expr->get_from_expr(), table_id, fragment);
+    if (arg_range.getType() != ExpressionRangeType::Integer) {
+      return ExpressionRange::makeInvalidRange();
+    }
+    const auto& arg_ti = extract_expr->get_from_expr()->get_type_info();
+    const auto field = extract_expr->get_field();
+    if (field == kEPOCH && !arg_ti.is_high_precision_timestamp()) {
+      return arg_range;
+    }
+    const int64_t min_val = DateTimeTranslator::getExtractFromTimeConstantValue(
+        arg_range.getIntMin(), field, arg_ti);
+    const int64_t max_val = DateTimeTranslator::getExtractFromTimeConstantValue(
+        arg_range.getIntMax(), field, arg_ti);
+    if (field == kYEAR) {
+      // monotone in the timestamp, so the endpoints bound the fragment
+      return ExpressionRange::makeIntRange(min_val, max_val, 0, arg_range.hasNulls());
+    }
+    int64_t period_secs{0};
+    switch (field) {
+      case kHOUR:
+      case kQUARTERDAY:
+        period_secs = 24 * 60 * 60;
+        break;
+      case kMINUTE:
+        period_secs = 60 * 60;
+        break;
+      case kSECOND:
+        period_secs = 60;
+        break;
+      case kDOW:
+      case kISODOW:
+        period_secs = 7 * 24 * 60 * 60;
+        break;
+      default:
+        return ExpressionRange::makeInvalidRange();
+    }
+    // Periodic fields still yield a usable bound when the whole fragment sits
+    // inside one period window and the field doesn't wrap across it (a wrap
+    // within the window always shows up as min_val > max_val, since the
+    // pre-wrap values are the high tail of the cycle). Time-ordered fragments
+    // routinely span less than a day, which is what makes extract(hour ...)
+    // predicates prunable.
+    const int64_t period =
+        arg_ti.is_high_precision_timestamp()
+            ? period_secs * DateTimeUtils::get_timestamp_precision_scale(
+                                arg_ti.get_dimension())
+            : period_secs;
+    if (floor_div(arg_range.getIntMin(), period) ==
+            floor_div(arg_range.getIntMax(), period) &&
+        min_val <= max_val) {
+      return ExpressionRange::makeIntRange(min_val, max_val, 0, arg_range.hasNulls());
+    }
+    return ExpressionRange::makeInvalidRange();
+  }
+  const auto datetrunc_expr = dynamic_cast<const Analyzer::DatetruncExpr*>(expr);
+  if (datetrunc_expr) {
+    const auto arg_range = get_fragment_expr_range(
+        datetrunc_expr->get_from_expr(), table_id, fragment);
+    if (arg_range.getType() != ExpressionRangeType::Integer) {
+      return ExpressionRange::makeInvalidRange();
+    }
+    const auto& arg_ti = datetrunc_expr->get_from_expr()->get_type_info();
+    return ExpressionRange::makeIntRange(
+        DateTimeTranslator::getDateTruncConstantValue(
+            arg_range.getIntMin(), datetrunc_expr->get_field(), arg_ti),
+        DateTimeTranslator::getDateTruncConstantValue(
+            arg_range.getIntMax(), datetrunc_expr->get_field(), arg_ti),
+        0,
+        arg_range.hasNulls());
+  }
+  const auto func_oper = dynamic_cast<const Analyzer::FunctionOper*>(expr);
+  if (func_oper && func_oper->getArity() == 1 &&
+      (func_oper->getName() == "FLOOR" || func_oper->getName() == "CEIL")) {
+    const auto arg_range =
+        get_fragment_expr_range(func_oper->getArg(0), table_id, fragment);
+    const auto& ti = func_oper->get_type_info();
+    const bool is_floor = func_oper->getName() == "FLOOR";
+    switch (arg_range.getType()) {
+      case ExpressionRangeType::Integer:
+        return ti.is_integer() ? arg_range : ExpressionRange::makeInvalidRange();
+      case ExpressionRangeType::Float:
+        if (ti.get_type() != kFLOAT) {
+          return ExpressionRange::makeInvalidRange();
+        }
+        return ExpressionRange::makeFloatRange(
+            is_floor ? std::floor(arg_range.getFpMin())
+                     : std::ceil(arg_range.getFpMin()),
+            is_floor ? std::floor(arg_range.getFpMax())
+                     : std::ceil(arg_range.getFpMax()),
+            arg_range.hasNulls());
+      case ExpressionRangeType::Double:
+        if (ti.get_type() != kDOUBLE) {
+          return ExpressionRange::makeInvalidRange();
+        }
+        return ExpressionRange::makeDoubleRange(
+            is_floor ? std::floor(arg_range.getFpMin())
+                     : std::ceil(arg_range.getFpMin()),
+            is_floor ? std::floor(arg_range.getFpMax())
+                     : std::ceil(arg_range.getFpMax()),
+            arg_range.hasNulls());
+      default:
+        return ExpressionRange::makeInvalidRange();
+    }
+  }
+  return ExpressionRange::makeInvalidRange();
+}
+
+}  // namespace
+
+bool Executor::skipFragmentByExpressionRange(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const InputDescriptor& table_desc,
+    const Fragmenter_Namespace::FragmentInfo& fragment) {
+  if (!g_enable_expression_range_pruning) {
+    return false;
+  }
+  const int table_id = table_desc.getTableId();
+  if (table_id < 0 || fragment.getNumTuples() == 0) {
+    return false;
+  }
+  for (const auto& qual : ra_exe_unit.quals) {
+    const auto comp_expr = std::dynamic_pointer_cast<const Analyzer::BinOper>(qual);
+    if (!comp_expr || comp_expr->get_qualifier() != kONE) {
+      continue;
+    }
+    auto optype = comp_expr->get_optype();
+    if (optype != kGE && optype != kGT && optype != kLE && optype != kLT &&
+        optype != kEQ) {
+      continue;
+    }
+    const Analyzer::Expr* expr_side = comp_expr->get_left_operand();
+    auto const_side =
+        dynamic_cast<const Analyzer::Constant*>(comp_expr->get_right_operand());
+    if (!const_side) {
+      const_side = dynamic_cast<const Analyzer::Constant*>(expr_side);
+      if (!const_side) {
+        continue;
+      }
+      expr_side = comp_expr->get_right_operand();
+      optype = COMMUTE_COMPARISON(optype);
+    }
+    if (const_side->get_is_null()) {
+      continue;
+    }
+    if (dynamic_cast<const Analyzer::ColumnVar*>(expr_side)) {
+      // plain column predicates are simple_quals, already covered by
+      // skipFragment
+      continue;
+    }
+    const auto expr_range = get_fragment_expr_range(expr_side, table_id, fragment);
+    const auto& const_ti = const_side->get_type_info();
+    int64_t range_min{0};
+    int64_t range_max{0};
+    int64_t rhs_val{0};
+    if (expr_range.getType() == ExpressionRangeType::Integer) {
+      if (!const_ti.is_integer() && !const_ti.is_time()) {
+        continue;
+      }
+      const auto& expr_ti = expr_side->get_type_info();
+      if ((expr_ti.is_timestamp() || const_ti.is_timestamp()) &&
+          expr_ti.get_dimension() != const_ti.get_dimension()) {
+        // leave precision rescaling to codegen rather than duplicating it here
+        continue;
+      }
+      range_min = expr_range.getIntMin();
+      range_max = expr_range.getIntMax();
+      rhs_val = get_value_from_datum<int64_t>(const_side->get_constval(),
+                                              const_ti.get_type());
+    } else if (expr_range.getType() == ExpressionRangeType::Float ||
+               expr_range.getType() == ExpressionRangeType::Double) {
+      if (!const_ti.is_fp()) {
+        continue;
+      }
+      const double fp_rhs_val = get_value_from_datum<double>(
+          const_side->get_constval(), const_ti.get_type());
+      // NULL rows can't satisfy a comparison, so a range with nulls still
+      // prunes; only the non-null bounds matter
+      switch (optype) {
+        case kGE:
+          if (expr_range.getFpMax() < fp_rhs_val) {
+            return true;
+          }
+          break;
+        case kGT:
+          if (expr_range.getFpMax() <= fp_rhs_val) {
+            return true;
+          }
+          break;
+        case kLE:
+          if (expr_range.getFpMin() > fp_rhs_val) {
+            return true;
+          }
+          break;
+        case kLT:
+          if (expr_range.getFpMin() >= fp_rhs_val) {
+            return true;
+          }
+          break;
+        case kEQ:
+          if (expr_range.getFpMin() > fp_rhs_val ||
+              expr_range.getFpMax() < fp_rhs_val) {
+            return true;
+          }
+          break;
+        default:
+          break;
+      }
+      continue;
+    } else {
+      continue;
+    }
+    switch (optype) {
+      case kGE:
+        if (range_max < rhs_val) {
+          return true;
+        }
+        break;
+      case kGT:
+        if (range_max <= rhs_val) {
+          return true;
+        }
+        break;
+      case kLE:
+        if (range_min > rhs_val) {
+          return true;
+        }
+        break;
+      case kLT:
+        if (range_min >= rhs_val) {
+          return true;
+        }
+        break;
+      case kEQ:
+        if (range_min > rhs_val || range_max < rhs_val) {
+          return true;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+std::map<std::tuple<int, ::QueryRenderer::QueryRenderManager*, size_t>,
+         std::shared_ptr<Executor>>
     Executor::executors_;
-std::mutex Executor::execute_mutex_;
 mapd_shared_mutex Executor::executors_cache_mutex_;
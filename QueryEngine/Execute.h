@@ -56,14 +56,17 @@
 
 #include <unistd.h>
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdlib>
 #include <deque>
 #include <functional>
+#include <future>
 #include <limits>
 #include <map>
 #include <mutex>
+#include <set>
 #include <stack>
 #include <unordered_map>
 #include <unordered_set>
@@ -71,11 +74,13 @@
 extern bool g_enable_watchdog;
 extern bool g_enable_dynamic_watchdog;
 extern unsigned g_dynamic_watchdog_time_limit;
+extern unsigned g_dynamic_watchdog_check_interval;
 extern unsigned g_trivial_loop_join_threshold;
 extern bool g_from_table_reordering;
 extern bool g_enable_filter_push_down;
 extern bool g_allow_cpu_retry;
 extern bool g_null_div_by_zero;
+extern bool g_enable_null_check_elision;
 extern bool g_bigint_count;
 extern bool g_inner_join_fragment_skipping;
 extern float g_filter_push_down_low_frac;
@@ -199,12 +204,13 @@ template <typename PtrTy>
 inline const ColumnarResults* rows_to_columnar_results(
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const PtrTy& result,
-    const int number) {
+    const int number,
+    Data_Namespace::DataMgr* data_mgr = nullptr) {
   std::vector<SQLTypeInfo> col_types;
   for (size_t i = 0; i < result->colCount(); ++i) {
     col_types.push_back(get_logical_type_info(result->getColType(i)));
   }
-  return new ColumnarResults(row_set_mem_owner, *result, number, col_types);
+  return new ColumnarResults(row_set_mem_owner, *result, number, col_types, data_mgr);
 }
 
 // TODO(alex): Adjust interfaces downstream and make this not needed.
@@ -220,10 +226,12 @@ inline std::vector<Analyzer::Expr*> get_exprs_not_owned(
 inline const ColumnarResults* columnarize_result(
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner,
     const ResultSetPtr& result,
-    const int frag_id) {
+    const int frag_id,
+    Data_Namespace::DataMgr* data_mgr = nullptr) {
   INJECT_TIMER(columnarize_result);
   CHECK_EQ(0, frag_id);
-  return rows_to_columnar_results(row_set_mem_owner, result, result->colCount());
+  return rows_to_columnar_results(
+      row_set_mem_owner, result, result->colCount(), data_mgr);
 }
 
 class CompilationRetryNoLazyFetch : public std::runtime_error {
@@ -257,6 +265,11 @@ class QueryMustRunOnCpu : public std::runtime_error {
   QueryMustRunOnCpu() : std::runtime_error("Query must run in cpu mode.") {}
 };
 
+class QueryInterrupted : public std::runtime_error {
+ public:
+  QueryInterrupted() : std::runtime_error("Query execution has been interrupted") {}
+};
+
 class SringConstInResultSet : public std::runtime_error {
  public:
   SringConstInResultSet()
@@ -346,12 +359,16 @@ class Executor {
       const std::string& debug_dir = "",
       const std::string& debug_file = "",
       const MapDParameters mapd_parameters = MapDParameters(),
-      ::QueryRenderer::QueryRenderManager* render_manager = nullptr);
+      ::QueryRenderer::QueryRenderManager* render_manager = nullptr,
+      const size_t executor_index = 0);
 
   static void nukeCacheOfExecutors() {
-    std::lock_guard<std::mutex> flush_lock(
-        execute_mutex_);  // don't want native code to vanish while executing
     mapd_unique_lock<mapd_shared_mutex> lock(executors_cache_mutex_);
+    // don't want native code to vanish while executing
+    std::vector<std::unique_lock<std::mutex>> execute_locks;
+    for (auto& executor_entry : executors_) {
+      execute_locks.emplace_back(executor_entry.second->execute_mutex_);
+    }
     (decltype(executors_){}).swap(executors_);
   }
 
@@ -540,8 +557,15 @@ class Executor {
     RenderInfo* render_info_;
     std::vector<std::pair<ResultSetPtr, std::vector<size_t>>> all_fragment_results_;
     std::atomic_flag dynamic_watchdog_set_ = ATOMIC_FLAG_INIT;
+    // Rows collected so far across kernels, used to skip remaining fragments
+    // once a LIMIT without ORDER BY has enough rows from any fragments.
+    std::atomic<int64_t> rows_returned_{0};
     static std::mutex reduce_mutex_;
 
+    bool limitQuotaApplies(const QueryMemoryDescriptor& query_mem_desc) const;
+
+    bool canStreamReduce(const QueryMemoryDescriptor& query_mem_desc) const;
+
     void runImpl(const ExecutorDeviceType chosen_device_type,
                  int chosen_device_id,
                  const ExecutionOptions& eo,
@@ -618,14 +642,17 @@ class Executor {
   /**
    * @brief Compiles and dispatches a work unit per fragment processing results with the
    * per fragment callback.
-   * Currently used for computing metrics over fragments (metadata).
+   * Currently used for computing metrics over fragments (metadata). Only the fragments
+   * whose index is in fragment_indexes are scanned; they are processed concurrently
+   * since they are independent of each other.
    */
   void executeWorkUnitPerFragment(const RelAlgExecutionUnit& ra_exe_unit,
                                   const InputTableInfo& table_info,
                                   const CompilationOptions& co,
                                   const ExecutionOptions& eo,
                                   const Catalog_Namespace::Catalog& cat,
-                                  PerFragmentCB& cb);
+                                  PerFragmentCB& cb,
+                                  const std::set<size_t>& fragment_indexes);
 
   ResultSetPtr executeExplain(const QueryCompilationDescriptor&);
 
@@ -661,6 +688,8 @@ class Executor {
       const size_t context_count,
       const QueryCompilationDescriptor& query_comp_desc,
       const QueryMemoryDescriptor& query_mem_desc,
+      const QueryCompilationDescriptor* cpu_query_comp_desc,
+      const QueryMemoryDescriptor* cpu_query_mem_desc,
       QueryFragmentDescriptor& fragment_descriptor,
       std::unordered_set<int>& available_gpus,
       int& available_cpus);
@@ -682,6 +711,15 @@ class Executor {
                         const RelAlgExecutionUnit& ra_exe_unit,
                         const ExecutorDeviceType device_type);
 
+  bool skipFragmentPairBySortedJoinKey(
+      const Fragmenter_Namespace::FragmentInfo& outer_fragment_info,
+      const Fragmenter_Namespace::FragmentInfo& inner_fragment_info,
+      const int inner_table_id,
+      const int table_idx,
+      const std::unordered_map<int, const Analyzer::BinOper*>&
+          inner_table_id_to_join_condition,
+      const RelAlgExecutionUnit& ra_exe_unit);
+
   FetchResult fetchChunks(const ColumnFetcher&,
                           const RelAlgExecutionUnit& ra_exe_unit,
                           const int device_id,
@@ -911,6 +949,15 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  // Binary-searches the fragment list of a sort-ordered table for the
+  // contiguous run of fragments which can satisfy range predicates on the
+  // sort column; fragments outside the returned [start, end) range need not
+  // be tested by skipFragment at all.
+  std::pair<size_t, size_t> getSortedFragmentRange(
+      const InputDescriptor& table_desc,
+      const std::deque<Fragmenter_Namespace::FragmentInfo>& fragments,
+      const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals);
+
   std::pair<bool, int64_t> skipFragmentInnerJoins(
       const InputDescriptor& table_desc,
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -918,6 +965,24 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  // Skip an outer fragment whose probe column metadata range cannot intersect
+  // the build-side key range of a perfect hash join table. Only applies to
+  // queries where every join level is an inner join.
+  bool skipFragmentForJoinBuildRange(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const InputDescriptor& table_desc,
+      const Fragmenter_Namespace::FragmentInfo& fragment);
+
+  // Skip a fragment excluded by a predicate on a derived expression, e.g.
+  // extract(hour from ts) or a floor()-based grid cell. The expression's
+  // value over the fragment is bounded on the fly from the chunk metadata of
+  // the columns it references, acting as a zone map for expressions that
+  // have no stored statistics of their own.
+  bool skipFragmentByExpressionRange(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const InputDescriptor& table_desc,
+      const Fragmenter_Namespace::FragmentInfo& fragment);
+
   using CodeCacheKey = std::vector<std::string>;
   typedef std::vector<std::tuple<void*,
                                  std::unique_ptr<llvm::ExecutionEngine>,
@@ -935,6 +1000,16 @@ class Executor {
       llvm::Module*,
       CodeCache&);
 
+  // Recompiles the snapshotted module at full optimization on a background
+  // thread and swaps the result into cpu_code_cache_ under the execute lock,
+  // replacing the tier 0 entry compiled without IR optimization.
+  void launchTieredRecompilation(const CodeCacheKey& key,
+                                 const std::string& module_ir,
+                                 const std::string& query_func_name,
+                                 const std::string& multifrag_func_name,
+                                 const std::vector<std::string>& live_func_names,
+                                 const CompilationOptions& co);
+
   std::vector<int8_t> serializeLiterals(
       const std::unordered_map<int, CgenState::LiteralValues>& literals,
       const int device_id);
@@ -952,12 +1027,18 @@ class Executor {
   class FetchCacheAnchor {
    public:
     FetchCacheAnchor(CgenState* cgen_state)
-        : cgen_state_(cgen_state), saved_fetch_cache(cgen_state_->fetch_cache_) {}
-    ~FetchCacheAnchor() { cgen_state_->fetch_cache_.swap(saved_fetch_cache); }
+        : cgen_state_(cgen_state)
+        , saved_fetch_cache(cgen_state_->fetch_cache_)
+        , saved_cse_cache(cgen_state_->cse_cache_) {}
+    ~FetchCacheAnchor() {
+      cgen_state_->fetch_cache_.swap(saved_fetch_cache);
+      cgen_state_->cse_cache_.swap(saved_cse_cache);
+    }
 
    private:
     CgenState* cgen_state_;
     std::unordered_map<int, std::vector<llvm::Value*>> saved_fetch_cache;
+    std::unordered_map<std::string, std::vector<llvm::Value*>> saved_cse_cache;
   };
 
   llvm::Value* spillDoubleElement(llvm::Value* elem_val, llvm::Type* elem_ty);
@@ -981,6 +1062,13 @@ class Executor {
   CodeCache cpu_code_cache_;
   CodeCache gpu_code_cache_;
 
+  // Tiered JIT bookkeeping: each background reoptimization owns an
+  // LLVMContext which must outlive the engine it put in cpu_code_cache_, and
+  // the pending futures keep the jobs joinable at shutdown.
+  std::mutex tiered_jit_mutex_;
+  std::vector<std::unique_ptr<llvm::LLVMContext>> tiered_jit_contexts_;
+  std::vector<std::future<void>> tiered_jit_jobs_;
+
   ::QueryRenderer::QueryRenderManager* render_manager_;
 
   static const size_t baseline_threshold{
@@ -1001,10 +1089,15 @@ class Executor {
   StringDictionaryGenerations string_dictionary_generations_;
   TableGenerations table_generations_;
 
-  static std::map<std::pair<int, ::QueryRenderer::QueryRenderManager*>,
+  // Executors are additionally keyed by an index so admission control can run
+  // small queries on dedicated executors instead of queueing them behind the
+  // default one; index 0 is the default executor.
+  static std::map<std::tuple<int, ::QueryRenderer::QueryRenderManager*, size_t>,
                   std::shared_ptr<Executor>>
       executors_;
-  static std::mutex execute_mutex_;
+  // Serializes queries on this executor; not static, so queries routed to
+  // different executors by admission control can run concurrently.
+  std::mutex execute_mutex_;
   static mapd_shared_mutex executors_cache_mutex_;
 
   static const int32_t ERR_DIV_BY_ZERO{1};
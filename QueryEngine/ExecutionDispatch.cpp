@@ -19,11 +19,16 @@
 #include "Descriptors/QueryFragmentDescriptor.h"
 #include "DynamicWatchdog.h"
 #include "Execute.h"
+#include "StreamingTopN.h"
 
 #include "DataMgr/BufferMgr/BufferMgr.h"
 
+#include <algorithm>
 #include <numeric>
 
+extern bool g_enable_streaming_reduction;
+extern bool g_enable_lean_projection_buffers;
+
 std::mutex Executor::ExecutionDispatch::reduce_mutex_;
 
 namespace {
@@ -53,6 +58,33 @@ bool need_to_hold_chunk(const Chunk_NS::Chunk* chunk,
 
 }  // namespace
 
+bool Executor::ExecutionDispatch::limitQuotaApplies(
+    const QueryMemoryDescriptor& query_mem_desc) const {
+  // A LIMIT without ORDER BY is satisfied by any scan_limit rows, so once
+  // earlier kernels have produced that many there is no reason to touch the
+  // remaining fragments. Sorted and aggregated queries still need them all.
+  return ra_exe_unit_.scan_limit && ra_exe_unit_.sort_info.order_entries.empty() &&
+         query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection;
+}
+
+bool Executor::ExecutionDispatch::canStreamReduce(
+    const QueryMemoryDescriptor& query_mem_desc) const {
+  // Streaming reduction folds each finished kernel's buffer into the first
+  // collected result while other kernels are still running, so it is limited
+  // to layouts whose buffers reduce pairwise in place and to queries whose
+  // collection step does not need the per-device results (the estimator,
+  // render, speculative top-n and sharded top paths all do).
+  if (ra_exe_unit_.estimator || render_info_) {
+    return false;
+  }
+  if (!ra_exe_unit_.sort_info.order_entries.empty()) {
+    return false;
+  }
+  const auto query_desc_type = query_mem_desc.getQueryDescriptionType();
+  return query_desc_type == QueryDescriptionType::GroupByPerfectHash ||
+         query_desc_type == QueryDescriptionType::NonGroupedAggregate;
+}
+
 void Executor::ExecutionDispatch::runImpl(
     const ExecutorDeviceType chosen_device_type,
     int chosen_device_id,
@@ -65,6 +97,21 @@ void Executor::ExecutionDispatch::runImpl(
   const auto memory_level = chosen_device_type == ExecutorDeviceType::GPU
                                 ? Data_Namespace::GPU_LEVEL
                                 : Data_Namespace::CPU_LEVEL;
+  if (limitQuotaApplies(query_mem_desc) &&
+      rows_returned_.load(std::memory_order_relaxed) >=
+          static_cast<int64_t>(ra_exe_unit_.scan_limit)) {
+    // The limit quota is already met; skip the chunk fetch and kernel launch
+    // for this fragment entirely.
+    return;
+  }
+  if (executor_->interrupted_) {
+    // Every kernel passes through here, so this is the fragment boundary
+    // poll: once the flag is up the remaining kernels bail out before
+    // fetching their chunks.
+    std::lock_guard<std::mutex> lock(reduce_mutex_);
+    *error_code_ = ERR_INTERRUPTED;
+    return;
+  }
   const int outer_table_id = ra_exe_unit_.input_descs[0].getTableId();
   CHECK_GE(frag_list.size(), size_t(1));
   CHECK_EQ(frag_list[0].table_id, outer_table_id);
@@ -116,9 +163,32 @@ void Executor::ExecutionDispatch::runImpl(
   std::unique_ptr<QueryExecutionContext> query_exe_context_owned;
   const bool do_render = render_info_ && render_info_->isPotentialInSituRender();
 
+  auto kernel_mem_desc = query_mem_desc;
+  if (g_enable_lean_projection_buffers &&
+      query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection &&
+      ra_exe_unit_.input_descs.size() == size_t(1) && ra_exe_unit_.join_quals.empty() &&
+      !use_streaming_top_n(ra_exe_unit_, query_mem_desc.didOutputColumnar())) {
+    // A single-table projection kernel appends each matched row at its
+    // matched-row counter, so it can never emit more rows than it scans; cap
+    // this kernel's output buffer at its input row count instead of allocating
+    // the query-wide entry count per kernel. The bounds check compiled into
+    // the kernel still uses the query-wide count, which is safe since the
+    // counter stays below the cap. Joins can match more rows than the outer
+    // fragment feeds in and streaming top-n heaps have a fixed size, so both
+    // keep the full buffer.
+    int64_t input_row_count{0};
+    for (const auto& frag_num_rows : fetch_result.num_rows) {
+      CHECK(!frag_num_rows.empty());
+      input_row_count += frag_num_rows.front();
+    }
+    kernel_mem_desc.setEntryCount(
+        std::min(kernel_mem_desc.getEntryCount(),
+                 static_cast<size_t>(std::max<int64_t>(input_row_count, 1))));
+  }
+
   try {
     query_exe_context_owned =
-        query_mem_desc.getQueryExecutionContext(ra_exe_unit_,
+        kernel_mem_desc.getQueryExecutionContext(ra_exe_unit_,
                                                 executor_,
                                                 chosen_device_type,
                                                 chosen_device_id,
@@ -126,7 +196,7 @@ void Executor::ExecutionDispatch::runImpl(
                                                 fetch_result.frag_offsets,
                                                 row_set_mem_owner_,
                                                 compilation_result.output_columnar,
-                                                query_mem_desc.sortOnGpu(),
+                                                kernel_mem_desc.sortOnGpu(),
                                                 do_render ? render_info_ : nullptr);
   } catch (const OutOfHostMemory& e) {
     std::lock_guard<std::mutex> lock(reduce_mutex_);
@@ -197,7 +267,19 @@ void Executor::ExecutionDispatch::runImpl(
       *error_code_ = err;
     }
     if (!needs_skip_result(device_results)) {
-      all_fragment_results_.emplace_back(std::move(device_results), outer_tab_frag_ids);
+      if (g_enable_streaming_reduction && !err && canStreamReduce(query_mem_desc) &&
+          !all_fragment_results_.empty()) {
+        // merge this kernel's buffer into the first collected result right
+        // away, overlapping reduction with the kernels still in flight;
+        // collectAllDeviceResults then finds a single pre-reduced buffer
+        all_fragment_results_.front().first->getStorage()->reduce(
+            *device_results->getStorage(), {});
+      } else {
+        all_fragment_results_.emplace_back(std::move(device_results), outer_tab_frag_ids);
+        if (limitQuotaApplies(query_mem_desc)) {
+          rows_returned_ += all_fragment_results_.back().first->rowCount();
+        }
+      }
     }
   }
 }
@@ -315,6 +397,9 @@ void Executor::ExecutionDispatch::run(const ExecutorDeviceType chosen_device_typ
     std::lock_guard<std::mutex> lock(reduce_mutex_);
     *error_code_ = ERR_STRING_CONST_IN_RESULTSET;
     LOG(INFO) << e.what();
+  } catch (const QueryInterrupted&) {
+    std::lock_guard<std::mutex> lock(reduce_mutex_);
+    *error_code_ = ERR_INTERRUPTED;
   }
 }
 
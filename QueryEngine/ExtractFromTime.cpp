@@ -147,6 +147,38 @@ DEVICE int32_t extract_year_fast(const int64_t lcltime) {
   return year;
 }
 
+// Days since 1970-01-01 to (year, month, day), Gregorian calendar. Pure
+// integer arithmetic with no branches beyond the era floor division, so the
+// surrounding per-row loop stays vectorizable on CPU and divergence-free on
+// GPU.
+DEVICE void civil_from_days(const int64_t days,
+                            int32_t& year,
+                            uint32_t& month,
+                            uint32_t& day) {
+  const int64_t z = days + 719468;
+  const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const uint32_t doe = static_cast<uint32_t>(z - era * 146097);
+  const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int64_t y = static_cast<int64_t>(yoe) + era * 400;
+  const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const uint32_t mp = (5 * doy + 2) / 153;
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = mp < 10 ? mp + 3 : mp - 9;
+  year = static_cast<int32_t>(y + (month <= 2));
+}
+
+// Inverse of civil_from_days: (year, month, day) to days since 1970-01-01.
+DEVICE int64_t days_from_civil(const int32_t year,
+                               const uint32_t month,
+                               const uint32_t day) {
+  const int32_t y = year - (month <= 2);
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const uint32_t yoe = static_cast<uint32_t>(y - era * 400);
+  const uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
 DEVICE tm gmtime_r_newlib(const int64_t lcltime, tm& res) {
   const int32_t month_lengths[2][kMonsPerYear] = {
       {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
@@ -292,21 +324,29 @@ extern "C" NEVER_INLINE DEVICE int64_t ExtractFromTime(ExtractField field,
       break;
   }
 
-  tm tm_struct;
-  gmtime_r_newlib(timeval, tm_struct);
+  // civil-calendar math for the remaining fields; the month, quarter and year
+  // cases only land here for timestamps outside the unsigned fast-path range
+  int64_t days = timeval / kSecsPerDay;
+  if (timeval % kSecsPerDay < 0) {
+    --days;
+  }
+  int32_t year;
+  uint32_t month, day;
+  civil_from_days(days, year, month, day);
   switch (field) {
     case kYEAR:
-      return 1900 + tm_struct.tm_year;
+      return year;
     case kQUARTER:
-      return (tm_struct.tm_mon) / 3 + 1;
+      return (month - 1) / 3 + 1;
     case kMONTH:
-      return tm_struct.tm_mon + 1;
+      return month;
     case kDAY:
-      return tm_struct.tm_mday;
+      return day;
     case kDOY:
-      return tm_struct.tm_yday + 1;
+      return days - days_from_civil(year, 1, 1) + 1;
     case kWEEK: {
-      int32_t doy = tm_struct.tm_yday;         // numbered from 0
+      int32_t doy =
+          static_cast<int32_t>(days - days_from_civil(year, 1, 1));  // numbered from 0
       int32_t dow = extract_dow(timeval) + 1;  // use Sunday 1 - Saturday 7
       int32_t week = (doy / 7) + 1;
       // now adjust for offset at start of year
@@ -88,6 +88,17 @@ enum ExtractField {
 // Shared by DateTruncate
 DEVICE int32_t extract_dow(const int64_t lcltime);
 
+// Branchless civil-calendar conversions between days since 1970-01-01 and
+// (year, month, day) — no loops or table walks, valid over the full timestamp
+// range. Shared by ExtractFromTime and DateTruncate.
+DEVICE void civil_from_days(const int64_t days,
+                            int32_t& year,
+                            uint32_t& month,
+                            uint32_t& day);
+DEVICE int64_t days_from_civil(const int32_t year,
+                               const uint32_t month,
+                               const uint32_t day);
+
 DEVICE tm gmtime_r_newlib(const int64_t lcltime, tm& res);
 
 extern "C" DEVICE NEVER_INLINE int64_t ExtractFromTime(ExtractField field,
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FragmentBloomFilter.h"
+
+#include "../Catalog/Catalog.h"
+#include "../Chunk/Chunk.h"
+#include "MurmurHash.h"
+
+#include "Shared/Logger.h"
+
+bool g_enable_fragment_bloom_filters{false};
+size_t g_fragment_bloom_filter_max_bytes{size_t(1) << 30};
+
+std::vector<FragmentBloomFilterCache::CacheEntry> FragmentBloomFilterCache::cache_;
+size_t FragmentBloomFilterCache::cache_bytes_{0};
+std::mutex FragmentBloomFilterCache::cache_mutex_;
+
+namespace {
+
+// ~8 bits per element with three probes gives a false positive rate of a few
+// percent, which only costs a needless fragment scan, never a wrong result.
+const size_t g_bits_per_element{8};
+const size_t g_num_probes{3};
+
+size_t bit_array_size_for(const size_t num_elements) {
+  size_t bits{64};
+  while (bits < num_elements * g_bits_per_element) {
+    bits <<= 1;
+  }
+  return bits;
+}
+
+template <typename T>
+void add_chunk_values(FragmentBloomFilter& filter,
+                      const int8_t* ptr,
+                      const size_t num_elements) {
+  const auto vals = reinterpret_cast<const T*>(ptr);
+  for (size_t i = 0; i < num_elements; ++i) {
+    filter.add(static_cast<int64_t>(vals[i]));
+  }
+}
+
+// Only fixed width integer chunks whose buffer holds the (possibly narrowed)
+// values verbatim are eligible; everything else would need per-element
+// decoding which this fast path deliberately avoids.
+ssize_t eligible_element_width(const ColumnDescriptor* cd) {
+  const auto& ti = cd->columnType;
+  if (!ti.is_integer()) {
+    return -1;
+  }
+  switch (ti.get_compression()) {
+    case kENCODING_NONE:
+      return ti.get_size();
+    case kENCODING_FIXED:
+      return ti.get_comp_param() / 8;
+    default:
+      return -1;
+  }
+}
+
+}  // namespace
+
+FragmentBloomFilter::FragmentBloomFilter(const size_t num_elements) {
+  const auto bits = bit_array_size_for(num_elements);
+  bit_array_.resize(bits / 64, 0);
+  bit_mask_ = bits - 1;
+}
+
+size_t FragmentBloomFilter::estimateBitArrayBytes(const size_t num_elements) {
+  return bit_array_size_for(num_elements) / 8;
+}
+
+void FragmentBloomFilter::add(const int64_t val) {
+  const auto h1 = MurmurHash64A(&val, sizeof(val), 0);
+  const auto h2 = MurmurHash64A(&val, sizeof(val), h1 | 1);
+  for (size_t i = 0; i < g_num_probes; ++i) {
+    const auto bit = (h1 + i * h2) & bit_mask_;
+    bit_array_[bit >> 6] |= uint64_t(1) << (bit & 63);
+  }
+}
+
+bool FragmentBloomFilter::maybeContains(const int64_t val) const {
+  const auto h1 = MurmurHash64A(&val, sizeof(val), 0);
+  const auto h2 = MurmurHash64A(&val, sizeof(val), h1 | 1);
+  for (size_t i = 0; i < g_num_probes; ++i) {
+    const auto bit = (h1 + i * h2) & bit_mask_;
+    if (!(bit_array_[bit >> 6] & (uint64_t(1) << (bit & 63)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<FragmentBloomFilter> FragmentBloomFilterCache::getOrBuild(
+    const Catalog_Namespace::Catalog& catalog,
+    const ColumnDescriptor* cd,
+    const ChunkKey& chunk_key,
+    const ChunkMetadata& chunk_metadata) {
+  const auto element_width = eligible_element_width(cd);
+  if (element_width <= 0 || chunk_metadata.numElements == 0 ||
+      chunk_metadata.numBytes !=
+          chunk_metadata.numElements * static_cast<size_t>(element_width)) {
+    return nullptr;
+  }
+  // In-place updates change neither the chunk size nor necessarily its stats,
+  // so staleness is tracked through the table epoch, which every checkpointed
+  // DML commit advances. Tables without disk persistence have no epoch to
+  // lean on and are not eligible.
+  const auto td = catalog.getMetadataForTable(chunk_key[1]);
+  if (!td || td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL) {
+    return nullptr;
+  }
+  const auto table_epoch = catalog.getTableEpoch(chunk_key[0], chunk_key[1]);
+  const auto estimated_bytes =
+      FragmentBloomFilter::estimateBitArrayBytes(chunk_metadata.numElements);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+      if (it->chunk_key == chunk_key) {
+        if (it->num_elements == chunk_metadata.numElements &&
+            it->num_bytes == chunk_metadata.numBytes &&
+            it->table_epoch == table_epoch) {
+          return it->filter;
+        }
+        // the chunk grew, was rewritten or its table committed DML since the
+        // filter was built
+        cache_bytes_ -= it->filter->bitArrayBytes();
+        cache_.erase(it);
+        break;
+      }
+    }
+    if (cache_bytes_ + estimated_bytes > g_fragment_bloom_filter_max_bytes) {
+      LOG(WARNING) << "Fragment bloom filter cache is full, not building a filter for "
+                   << showChunk(chunk_key);
+      return nullptr;
+    }
+    // reserve the budget before the build so concurrent builds cannot
+    // collectively overshoot the cap
+    cache_bytes_ += estimated_bytes;
+  }
+  std::shared_ptr<FragmentBloomFilter> filter;
+  try {
+    filter = std::make_shared<FragmentBloomFilter>(chunk_metadata.numElements);
+    auto& data_mgr = catalog.getDataMgr();
+    const auto chunk = Chunk_NS::Chunk::getChunk(cd,
+                                                 &data_mgr,
+                                                 chunk_key,
+                                                 Data_Namespace::CPU_LEVEL,
+                                                 0,
+                                                 chunk_metadata.numBytes,
+                                                 chunk_metadata.numElements);
+    const auto buffer_ptr = chunk->get_buffer()->getMemoryPtr();
+    CHECK(buffer_ptr);
+    switch (element_width) {
+      case 1:
+        add_chunk_values<int8_t>(*filter, buffer_ptr, chunk_metadata.numElements);
+        break;
+      case 2:
+        add_chunk_values<int16_t>(*filter, buffer_ptr, chunk_metadata.numElements);
+        break;
+      case 4:
+        add_chunk_values<int32_t>(*filter, buffer_ptr, chunk_metadata.numElements);
+        break;
+      case 8:
+        add_chunk_values<int64_t>(*filter, buffer_ptr, chunk_metadata.numElements);
+        break;
+      default:
+        CHECK(false);
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    cache_bytes_ -= estimated_bytes;
+    throw;
+  }
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  for (const auto& entry : cache_) {
+    if (entry.chunk_key == chunk_key) {
+      // another thread built the same filter first, keep theirs
+      cache_bytes_ -= estimated_bytes;
+      return entry.filter;
+    }
+  }
+  cache_.emplace_back(CacheEntry{chunk_key,
+                                 chunk_metadata.numElements,
+                                 chunk_metadata.numBytes,
+                                 table_epoch,
+                                 filter});
+  return filter;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    FragmentBloomFilter.h
+ * @brief   Per-fragment bloom filters used to extend the min/max based fragment
+ *          skipping in Executor::skipFragment to equality predicates on sparse
+ *          columns, where the min/max range of every fragment covers the probe
+ *          value but only a few fragments actually contain it.
+ *
+ * Filters are built lazily from the CPU copy of a chunk on the first equality
+ * probe against it and cached process-wide, keyed by chunk key and validated
+ * against the chunk metadata and the table epoch: appends change the element
+ * count and every checkpointed DML commit, including in-place updates which
+ * leave the chunk size untouched, advances the epoch, so stale entries stop
+ * matching.
+ */
+
+#ifndef QUERYENGINE_FRAGMENTBLOOMFILTER_H
+#define QUERYENGINE_FRAGMENTBLOOMFILTER_H
+
+#include "../DataMgr/ChunkMetadata.h"
+#include "../Shared/types.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+extern bool g_enable_fragment_bloom_filters;
+extern size_t g_fragment_bloom_filter_max_bytes;
+
+namespace Catalog_Namespace {
+class Catalog;
+}
+
+struct ColumnDescriptor;
+
+class FragmentBloomFilter {
+ public:
+  explicit FragmentBloomFilter(const size_t num_elements);
+
+  void add(const int64_t val);
+
+  bool maybeContains(const int64_t val) const;
+
+  size_t bitArrayBytes() const { return bit_array_.size() * sizeof(uint64_t); }
+
+  // Size of the bit array a filter for num_elements values would allocate,
+  // used to check the cache budget before paying for a build.
+  static size_t estimateBitArrayBytes(const size_t num_elements);
+
+ private:
+  std::vector<uint64_t> bit_array_;
+  uint64_t bit_mask_;
+};
+
+class FragmentBloomFilterCache {
+ public:
+  // Returns the filter for the given chunk, building it from the chunk data on
+  // first use. Returns nullptr if the column type or encoding is not eligible,
+  // or if building the filter would push the cache over its memory budget.
+  static std::shared_ptr<FragmentBloomFilter> getOrBuild(
+      const Catalog_Namespace::Catalog& catalog,
+      const ColumnDescriptor* cd,
+      const ChunkKey& chunk_key,
+      const ChunkMetadata& chunk_metadata);
+
+ private:
+  struct CacheEntry {
+    ChunkKey chunk_key;
+    // metadata and epoch snapshot at build time; a mismatch marks the entry
+    // stale
+    size_t num_elements;
+    size_t num_bytes;
+    int32_t table_epoch;
+    std::shared_ptr<FragmentBloomFilter> filter;
+  };
+
+  static std::vector<CacheEntry> cache_;
+  static size_t cache_bytes_;
+  static std::mutex cache_mutex_;
+};
+
+#endif  // QUERYENGINE_FRAGMENTBLOOMFILTER_H
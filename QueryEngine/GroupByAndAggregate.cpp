@@ -18,6 +18,8 @@
 #include "AggregateUtils.h"
 #include "Allocators/CudaAllocator.h"
 
+#include "ApproxQuantileDigest.h"
+#include "ApproxTopKSketch.h"
 #include "CardinalityEstimator.h"
 #include "CodeGenerator.h"
 #include "Descriptors/QueryMemoryDescriptor.h"
@@ -48,6 +50,7 @@
 
 bool g_cluster{false};
 bool g_bigint_count{false};
+bool g_enable_sparse_count_distinct{false};
 int g_hll_precision_bits{11};
 extern size_t g_leaf_count;
 
@@ -557,6 +560,15 @@ CountDistinctDescriptors GroupByAndAggregate::initCountDistinctDescriptors() {
           if (bitmap_sz_bits <= 0 || bitmap_sz_bits > MAX_BITMAP_BITS) {
             count_distinct_impl_type = CountDistinctImplType::StdSet;
           }
+          // Wide ranges are usually sparse; the compressed bitmap only
+          // materializes the 64K-bit containers which actually see a value and
+          // also covers ranges beyond the dense limit, as long as the range is
+          // known. CPU only, so leave leaf nodes on the dense/set paths.
+          const int64_t MIN_SPARSE_BITMAP_BITS{64 * 1000 * 1000L};
+          if (g_enable_sparse_count_distinct && !g_cluster && bitmap_sz_bits > 0 &&
+              bitmap_sz_bits > MIN_SPARSE_BITMAP_BITS) {
+            count_distinct_impl_type = CountDistinctImplType::SparseBitmap;
+          }
         }
       }
       if (agg_info.agg_kind == kAPPROX_COUNT_DISTINCT &&
@@ -803,13 +815,24 @@ bool GroupByAndAggregate::supportedExprForGpuSharedMemUsage(Analyzer::Expr* expr
 
 bool GroupByAndAggregate::gpuCanHandleOrderEntries(
     const std::list<Analyzer::OrderEntry>& order_entries) {
-  if (order_entries.size() > 1) {  // TODO(alex): lift this restriction
-    return false;
-  }
+  bool is_first_entry = true;
   for (const auto order_entry : order_entries) {
     CHECK_GE(order_entry.tle_no, 1);
     CHECK_LE(static_cast<size_t>(order_entry.tle_no), ra_exe_unit_.target_exprs.size());
     const auto target_expr = ra_exe_unit_.target_exprs[order_entry.tle_no - 1];
+    if (!is_first_entry) {
+      // Only the first entry drives the device sort. Trailing entries are
+      // tolerated on the speculative top-n path, where the reduction breaks
+      // ties on the host; they must reference the group by key since only its
+      // value is exact in every partial result.
+      if (ra_exe_unit_.sort_info.algorithm != SortAlgorithm::SpeculativeTopN ||
+          dynamic_cast<Analyzer::AggExpr*>(target_expr) ||
+          !target_expr->get_type_info().is_integer()) {
+        return false;
+      }
+      continue;
+    }
+    is_first_entry = false;
     if (!dynamic_cast<Analyzer::AggExpr*>(target_expr)) {
       return false;
     }
@@ -1023,54 +1046,59 @@ llvm::Value* GroupByAndAggregate::codegenOutputSlot(
                                     : query_mem_desc.getRowSize() / sizeof(int64_t);
   CodeGenerator code_generator(executor_);
   if (use_streaming_top_n(ra_exe_unit_, query_mem_desc.didOutputColumnar())) {
-    const auto& only_order_entry = ra_exe_unit_.sort_info.order_entries.front();
-    CHECK_GE(only_order_entry.tle_no, int(1));
-    const size_t target_idx = only_order_entry.tle_no - 1;
-    CHECK_LT(target_idx, ra_exe_unit_.target_exprs.size());
-    const auto order_entry_expr = ra_exe_unit_.target_exprs[target_idx];
-    const auto chosen_bytes =
-        static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(target_idx));
-    auto order_entry_lv = executor_->cgen_state_->castToTypeIn(
-        code_generator.codegen(order_entry_expr, true, co).front(), chosen_bytes * 8);
+    const auto& order_entries = ra_exe_unit_.sort_info.order_entries;
+    CHECK_GE(order_entries.size(), size_t(1));
+    CHECK_LE(order_entries.size(), size_t(2));
     const uint32_t n = ra_exe_unit_.sort_info.offset + ra_exe_unit_.sort_info.limit;
-    std::string fname = "get_bin_from_k_heap";
-    const auto& oe_ti = order_entry_expr->get_type_info();
-    llvm::Value* null_key_lv = nullptr;
-    if (oe_ti.is_integer() || oe_ti.is_decimal() || oe_ti.is_time()) {
-      const size_t bit_width = order_entry_lv->getType()->getIntegerBitWidth();
-      switch (bit_width) {
-        case 32:
-          null_key_lv = LL_INT(static_cast<int32_t>(inline_int_null_val(oe_ti)));
-          break;
-        case 64:
-          null_key_lv = LL_INT(static_cast<int64_t>(inline_int_null_val(oe_ti)));
-          break;
-        default:
-          CHECK(false);
-      }
-      fname += "_int" + std::to_string(bit_width) + "_t";
-    } else {
-      CHECK(oe_ti.is_fp());
-      if (order_entry_lv->getType()->isDoubleTy()) {
-        null_key_lv = LL_FP(static_cast<double>(inline_fp_null_val(oe_ti)));
+    std::string fname =
+        order_entries.size() == 1 ? "get_bin_from_k_heap" : "get_bin_from_k_heap_2keys";
+    std::vector<llvm::Value*> args{groups_buffer, LL_INT(n), LL_INT(row_size_quad)};
+    // on ties the two-key heap falls back to the second entry, so the kept
+    // rows are the top n under the composite order
+    for (const auto& order_entry : order_entries) {
+      CHECK_GE(order_entry.tle_no, int(1));
+      const size_t target_idx = order_entry.tle_no - 1;
+      CHECK_LT(target_idx, ra_exe_unit_.target_exprs.size());
+      const auto order_entry_expr = ra_exe_unit_.target_exprs[target_idx];
+      const auto chosen_bytes =
+          static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(target_idx));
+      auto order_entry_lv = executor_->cgen_state_->castToTypeIn(
+          code_generator.codegen(order_entry_expr, true, co).front(), chosen_bytes * 8);
+      const auto& oe_ti = order_entry_expr->get_type_info();
+      llvm::Value* null_key_lv = nullptr;
+      if (oe_ti.is_integer() || oe_ti.is_decimal() || oe_ti.is_time()) {
+        const size_t bit_width = order_entry_lv->getType()->getIntegerBitWidth();
+        switch (bit_width) {
+          case 32:
+            null_key_lv = LL_INT(static_cast<int32_t>(inline_int_null_val(oe_ti)));
+            break;
+          case 64:
+            null_key_lv = LL_INT(static_cast<int64_t>(inline_int_null_val(oe_ti)));
+            break;
+          default:
+            CHECK(false);
+        }
+        fname += "_int" + std::to_string(bit_width) + "_t";
       } else {
-        null_key_lv = LL_FP(static_cast<float>(inline_fp_null_val(oe_ti)));
+        CHECK(oe_ti.is_fp());
+        if (order_entry_lv->getType()->isDoubleTy()) {
+          null_key_lv = LL_FP(static_cast<double>(inline_fp_null_val(oe_ti)));
+        } else {
+          null_key_lv = LL_FP(static_cast<float>(inline_fp_null_val(oe_ti)));
+        }
+        fname += order_entry_lv->getType()->isDoubleTy() ? "_double" : "_float";
       }
-      fname += order_entry_lv->getType()->isDoubleTy() ? "_double" : "_float";
+      const auto key_slot_idx =
+          get_heap_key_slot_index(ra_exe_unit_.target_exprs, target_idx);
+      args.push_back(
+          LL_INT(static_cast<uint32_t>(query_mem_desc.getColOffInBytes(key_slot_idx))));
+      args.push_back(LL_BOOL(order_entry.is_desc));
+      args.push_back(LL_BOOL(!oe_ti.get_notnull()));
+      args.push_back(LL_BOOL(order_entry.nulls_first));
+      args.push_back(null_key_lv);
+      args.push_back(order_entry_lv);
     }
-    const auto key_slot_idx =
-        get_heap_key_slot_index(ra_exe_unit_.target_exprs, target_idx);
-    return emitCall(
-        fname,
-        {groups_buffer,
-         LL_INT(n),
-         LL_INT(row_size_quad),
-         LL_INT(static_cast<uint32_t>(query_mem_desc.getColOffInBytes(key_slot_idx))),
-         LL_BOOL(only_order_entry.is_desc),
-         LL_BOOL(!order_entry_expr->get_type_info().get_notnull()),
-         LL_BOOL(only_order_entry.nulls_first),
-         null_key_lv,
-         order_entry_lv});
+    return emitCall(fname, args);
   } else {
     const auto group_expr_lv =
         LL_BUILDER.CreateLoad(get_arg_by_name(ROW_FUNC, "old_total_matched"));
@@ -1253,6 +1281,16 @@ GroupByAndAggregate::codegenSingleColumnPerfectHash(
     return std::make_tuple(&*groups_buffer,
                            emitCall(get_group_fn_name, get_group_fn_args));
   }
+  if (query_mem_desc.hasOccupancyBitmap() &&
+      get_group_fn_name == "get_group_value_fast") {
+    // mark the entry occupied as the kernel claims it, so reduction and
+    // iteration can skip empty runs without reading the wide rows
+    get_group_fn_name += "_with_occupancy";
+    get_group_fn_args.push_back(LL_BUILDER.CreateGEP(
+        groups_buffer,
+        LL_INT(static_cast<int64_t>(query_mem_desc.getOccupancyBitmapOffset() /
+                                    sizeof(int64_t)))));
+  }
   return std::make_tuple(emitCall(get_group_fn_name, get_group_fn_args), nullptr);
 }
 
@@ -1282,10 +1320,18 @@ std::tuple<llvm::Value*, llvm::Value*> GroupByAndAggregate::codegenMultiColumnPe
     emitCall(set_matching_func_name, set_matching_func_arg);
     return std::make_tuple(groups_buffer, hash_lv);
   } else {
-    return std::make_tuple(
-        emitCall("get_matching_group_value_perfect_hash",
-                 {groups_buffer, hash_lv, group_key, key_size_lv, LL_INT(row_size_quad)}),
-        nullptr);
+    std::string get_matching_fn_name{"get_matching_group_value_perfect_hash"};
+    std::vector<llvm::Value*> get_matching_fn_args{
+        groups_buffer, hash_lv, group_key, key_size_lv, LL_INT(row_size_quad)};
+    if (query_mem_desc.hasOccupancyBitmap()) {
+      get_matching_fn_name += "_with_occupancy";
+      get_matching_fn_args.push_back(LL_BUILDER.CreateGEP(
+          groups_buffer,
+          LL_INT(static_cast<int64_t>(query_mem_desc.getOccupancyBitmapOffset() /
+                                      sizeof(int64_t)))));
+    }
+    return std::make_tuple(emitCall(get_matching_fn_name, get_matching_fn_args),
+                           nullptr);
   }
 }
 
@@ -1636,6 +1682,46 @@ extern "C" void agg_count_distinct_skip_val(int64_t* agg,
   }
 }
 
+extern "C" void agg_count_distinct_sparse_bitmap(int64_t* agg,
+                                                 const int64_t val,
+                                                 const int64_t min_val) {
+  reinterpret_cast<CountDistinctSparseBitmap*>(*agg)->set(
+      static_cast<uint64_t>(val - min_val));
+}
+
+extern "C" void agg_count_distinct_sparse_bitmap_skip_val(int64_t* agg,
+                                                          const int64_t val,
+                                                          const int64_t min_val,
+                                                          const int64_t skip_val) {
+  if (val != skip_val) {
+    agg_count_distinct_sparse_bitmap(agg, val, min_val);
+  }
+}
+
+extern "C" void agg_approx_median(int64_t* agg, const double val) {
+  reinterpret_cast<ApproxQuantileDigest*>(*agg)->add(val);
+}
+
+extern "C" void agg_approx_median_skip_val(int64_t* agg,
+                                           const double val,
+                                           const double skip_val) {
+  if (val != skip_val) {
+    agg_approx_median(agg, val);
+  }
+}
+
+extern "C" void agg_approx_top_k(int64_t* agg, const int64_t val) {
+  reinterpret_cast<ApproxTopKSketch*>(*agg)->add(val);
+}
+
+extern "C" void agg_approx_top_k_skip_val(int64_t* agg,
+                                          const int64_t val,
+                                          const int64_t skip_val) {
+  if (val != skip_val) {
+    agg_approx_top_k(agg, val);
+  }
+}
+
 void GroupByAndAggregate::codegenCountDistinct(
     const size_t target_idx,
     const Analyzer::Expr* target_expr,
@@ -1670,6 +1756,10 @@ void GroupByAndAggregate::codegenCountDistinct(
   if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::Bitmap) {
     agg_fname += "_bitmap";
     agg_args.push_back(LL_INT(static_cast<int64_t>(count_distinct_descriptor.min_val)));
+  } else if (count_distinct_descriptor.impl_type_ ==
+             CountDistinctImplType::SparseBitmap) {
+    agg_fname += "_sparse_bitmap";
+    agg_args.push_back(LL_INT(static_cast<int64_t>(count_distinct_descriptor.min_val)));
   }
   if (agg_info.skip_null_val) {
     auto null_lv = executor_->cgen_state_->castToTypeIn(
@@ -1704,6 +1794,61 @@ void GroupByAndAggregate::codegenCountDistinct(
   }
 }
 
+void GroupByAndAggregate::codegenApproxMedian(const Analyzer::Expr* target_expr,
+                                              std::vector<llvm::Value*>& agg_args,
+                                              const ExecutorDeviceType device_type) {
+  if (device_type == ExecutorDeviceType::GPU) {
+    // The quantile digest lives in host memory, like the COUNT DISTINCT
+    // std::set fallback.
+    throw QueryMustRunOnCpu();
+  }
+  const auto agg_info = get_target_info(target_expr, g_bigint_count);
+  auto val_lv = agg_args.back();
+  if (val_lv->getType()->isFloatTy()) {
+    val_lv = executor_->cgen_state_->ir_builder_.CreateFPExt(
+        val_lv, llvm::Type::getDoubleTy(LL_CONTEXT));
+  } else if (!val_lv->getType()->isDoubleTy()) {
+    val_lv = executor_->cgen_state_->ir_builder_.CreateSIToFP(
+        val_lv, llvm::Type::getDoubleTy(LL_CONTEXT));
+  }
+  agg_args.back() = val_lv;
+  std::string agg_fname{"agg_approx_median"};
+  if (agg_info.skip_null_val) {
+    // Nullable arguments were already converted to the double null sentinel.
+    agg_fname += "_skip_val";
+    agg_args.push_back(
+        executor_->cgen_state_->inlineFpNull(SQLTypeInfo(kDOUBLE, false)));
+  }
+  executor_->cgen_state_->emitExternalCall(
+      agg_fname, llvm::Type::getVoidTy(LL_CONTEXT), agg_args);
+}
+
+void GroupByAndAggregate::codegenApproxTopK(const Analyzer::Expr* target_expr,
+                                            std::vector<llvm::Value*>& agg_args,
+                                            const ExecutorDeviceType device_type) {
+  if (device_type == ExecutorDeviceType::GPU) {
+    // The heavy hitters sketch lives in host memory, like the quantile digest.
+    throw QueryMustRunOnCpu();
+  }
+  const auto agg_info = get_target_info(target_expr, g_bigint_count);
+  auto val_lv = agg_args.back();
+  CHECK(val_lv->getType()->isIntegerTy());
+  if (val_lv->getType()->getIntegerBitWidth() < 64) {
+    // Narrower integers and dictionary keys are widened to the slot width.
+    val_lv = executor_->cgen_state_->ir_builder_.CreateSExt(
+        val_lv, get_int_type(64, LL_CONTEXT));
+  }
+  agg_args.back() = val_lv;
+  std::string agg_fname{"agg_approx_top_k"};
+  if (agg_info.skip_null_val) {
+    agg_fname += "_skip_val";
+    agg_args.push_back(
+        LL_INT(static_cast<int64_t>(inline_int_null_val(agg_info.agg_arg_type))));
+  }
+  executor_->cgen_state_->emitExternalCall(
+      agg_fname, llvm::Type::getVoidTy(LL_CONTEXT), agg_args);
+}
+
 llvm::Value* GroupByAndAggregate::getAdditionalLiteral(const int32_t off) {
   CHECK_LT(off, 0);
   const auto lit_buff_lv = get_arg_by_name(ROW_FUNC, "literals");
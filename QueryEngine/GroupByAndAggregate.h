@@ -40,6 +40,7 @@
 #include <vector>
 
 extern bool g_enable_smem_group_by;
+extern size_t g_gpu_smem_group_by_max_entries;
 extern bool g_bigint_count;
 
 class ReductionRanOutOfSlots : public std::runtime_error {
@@ -278,6 +279,14 @@ class GroupByAndAggregate {
                             const QueryMemoryDescriptor&,
                             const ExecutorDeviceType);
 
+  void codegenApproxMedian(const Analyzer::Expr* target_expr,
+                           std::vector<llvm::Value*>& agg_args,
+                           const ExecutorDeviceType);
+
+  void codegenApproxTopK(const Analyzer::Expr* target_expr,
+                         std::vector<llvm::Value*>& agg_args,
+                         const ExecutorDeviceType);
+
   llvm::Value* getAdditionalLiteral(const int32_t off);
 
   std::vector<llvm::Value*> codegenAggArg(const Analyzer::Expr* target_expr,
@@ -391,6 +400,13 @@ inline std::vector<int8_t> get_col_byte_widths(
         ++col_expr_idx;
         continue;
       }
+      if (agg_info.is_agg && agg_info.agg_kind == kAPPROX_TOP_K) {
+        // The slot holds a pointer-sized handle to the heavy hitters sketch,
+        // regardless of the argument type.
+        col_widths.push_back(sizeof(int64_t));
+        ++col_expr_idx;
+        continue;
+      }
       const auto col_expr_bitwidth = get_bit_width(chosen_type);
       CHECK_EQ(size_t(0), col_expr_bitwidth % 8);
       col_widths.push_back(static_cast<int8_t>(col_expr_bitwidth >> 3));
@@ -209,6 +209,27 @@ extern "C" ALWAYS_INLINE DEVICE int64_t* get_group_value_fast(
   return groups_buffer + off + 1;
 }
 
+extern "C" ALWAYS_INLINE DEVICE int64_t* get_group_value_fast_with_occupancy(
+    int64_t* groups_buffer,
+    const int64_t key,
+    const int64_t min_key,
+    const int64_t bucket,
+    const uint32_t row_size_quad,
+    int64_t* occupancy_bitmap) {
+  int64_t key_diff = key - min_key;
+  if (bucket) {
+    key_diff /= bucket;
+  }
+  // only generated for CPU, where each kernel thread owns its buffer, so the
+  // plain read-modify-write of the bitmap word is race free
+  occupancy_bitmap[key_diff >> 6] |= int64_t(1) << (key_diff & 63);
+  int64_t off = key_diff * row_size_quad;
+  if (groups_buffer[off] == EMPTY_KEY_64) {
+    groups_buffer[off] = key;
+  }
+  return groups_buffer + off + 1;
+}
+
 extern "C" ALWAYS_INLINE DEVICE int64_t* get_group_value_fast_with_original_key(
     int64_t* groups_buffer,
     const int64_t key,
@@ -76,6 +76,17 @@ inline int64_t translate_str_id_to_outer_dict(const int64_t elem,
       static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
   const auto sd_outer_dict_proxy =
       static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
+  // when a translation map was built up front, stay in id space
+  const auto translation_map =
+      sd_inner_dict_proxy->getCachedTranslationMap(sd_outer_dict_proxy);
+  if (translation_map && elem >= 0 &&
+      elem < static_cast<int64_t>(translation_map->size())) {
+    const auto outer_id = (*translation_map)[elem];
+    if (outer_id > max_elem || outer_id < min_elem) {
+      return StringDictionary::INVALID_STR_ID;
+    }
+    return outer_id;
+  }
   const auto elem_str = sd_inner_dict_proxy->getString(elem);
   const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
   if (outer_id > max_elem || outer_id < min_elem) {
@@ -84,6 +95,35 @@ inline int64_t translate_str_id_to_outer_dict(const int64_t elem,
   return outer_id;
 }
 
+/**
+ * The hash table build and count loops below do one dependent load or
+ * read-modify-write on a random hash slot per row and stall on memory once the
+ * table outgrows the caches. Decoding the element a fixed distance ahead of
+ * the current row lets its slot be software-prefetched while the in-flight
+ * rows resolve; the column read itself is sequential and stays cheap. Returns
+ * false when the lookahead row contributes no slot. Probes which go through a
+ * string dictionary translation are left alone -- the translation dwarfs the
+ * cache miss this hides.
+ */
+constexpr size_t g_hash_join_prefetch_distance{16};
+
+inline bool lookahead_join_column_element(const JoinColumnTypeInfo& type_info,
+                                          const JoinColumn& join_column,
+                                          const size_t lookahead_idx,
+                                          int64_t& elem) {
+  if (lookahead_idx >= join_column.num_elems) {
+    return false;
+  }
+  elem = get_join_column_element_value(type_info, join_column, lookahead_idx);
+  if (elem == type_info.null_val) {
+    if (!type_info.uses_bw_eq) {
+      return false;
+    }
+    elem = type_info.translated_null_val;
+  }
+  return true;
+}
+
 }  // namespace
 #endif
 
@@ -148,6 +188,16 @@ DEVICE auto fill_hash_join_buff_impl(int32_t* buff,
     }
     CHECK_GE(elem, type_info.min_val)
         << "Element " << elem << " less than min val " << type_info.min_val;
+    if (!sd_inner_proxy) {
+      int64_t prefetch_elem;
+      if (lookahead_join_column_element(
+              type_info,
+              join_column,
+              i + g_hash_join_prefetch_distance * step,
+              prefetch_elem)) {
+        __builtin_prefetch(slot_sel(prefetch_elem), 1);
+      }
+    }
 #endif
     int32_t* entry_ptr = slot_sel(elem);
     if (mapd_cas(entry_ptr, invalid_slot_val, i) != invalid_slot_val) {
@@ -246,6 +296,17 @@ DEVICE int fill_hash_join_buff_sharded_impl(int32_t* buff,
     }
     CHECK_GE(elem, type_info.min_val)
         << "Element " << elem << " less than min val " << type_info.min_val;
+    if (!sd_inner_proxy) {
+      int64_t prefetch_elem;
+      if (lookahead_join_column_element(
+              type_info,
+              join_column,
+              i + g_hash_join_prefetch_distance * step,
+              prefetch_elem) &&
+          SHARD_FOR_KEY(prefetch_elem, shard_info.num_shards) == shard_info.shard) {
+        __builtin_prefetch(slot_sel(prefetch_elem), 1);
+      }
+    }
 #endif
     int32_t* entry_ptr = slot_sel(elem);
     if (mapd_cas(entry_ptr, invalid_slot_val, i) != invalid_slot_val) {
@@ -555,6 +616,17 @@ GLOBAL void SUFFIX(count_matches)(int32_t* count_buff,
     }
     CHECK_GE(elem, type_info.min_val)
         << "Element " << elem << " less than min val " << type_info.min_val;
+    if (!sd_inner_proxy) {
+      int64_t prefetch_elem;
+      if (lookahead_join_column_element(
+              type_info,
+              join_column,
+              i + g_hash_join_prefetch_distance * step,
+              prefetch_elem)) {
+        __builtin_prefetch(
+            SUFFIX(get_hash_slot)(count_buff, prefetch_elem, type_info.min_val), 1);
+      }
+    }
 #endif
     int32_t* entry_ptr = SUFFIX(get_hash_slot)(count_buff, elem, type_info.min_val);
     mapd_add(entry_ptr, int32_t(1));
@@ -602,6 +674,23 @@ GLOBAL void SUFFIX(count_matches_sharded)(int32_t* count_buff,
     }
     CHECK_GE(elem, type_info.min_val)
         << "Element " << elem << " less than min val " << type_info.min_val;
+    if (!sd_inner_proxy) {
+      int64_t prefetch_elem;
+      if (lookahead_join_column_element(
+              type_info,
+              join_column,
+              i + g_hash_join_prefetch_distance * step,
+              prefetch_elem)) {
+        __builtin_prefetch(
+            SUFFIX(get_hash_slot_sharded)(count_buff,
+                                          prefetch_elem,
+                                          type_info.min_val,
+                                          shard_info.entry_count_per_shard,
+                                          shard_info.num_shards,
+                                          shard_info.device_count),
+            1);
+      }
+    }
 #endif
     int32_t* entry_ptr = SUFFIX(get_hash_slot_sharded)(count_buff,
                                                        elem,
@@ -726,6 +815,20 @@ GLOBAL void SUFFIX(fill_row_ids)(int32_t* buff,
     }
     CHECK_GE(elem, type_info.min_val)
         << "Element " << elem << " less than min val " << type_info.min_val;
+    if (!sd_inner_proxy) {
+      int64_t prefetch_elem;
+      if (lookahead_join_column_element(
+              type_info,
+              join_column,
+              i + g_hash_join_prefetch_distance * step,
+              prefetch_elem)) {
+        // both the position slot and its count slot get touched
+        const int32_t* prefetch_pos_ptr =
+            SUFFIX(get_hash_slot)(pos_buff, prefetch_elem, type_info.min_val);
+        __builtin_prefetch(prefetch_pos_ptr, 0);
+        __builtin_prefetch(count_buff + (prefetch_pos_ptr - pos_buff), 1);
+      }
+    }
 #endif
     int32_t* pos_ptr = SUFFIX(get_hash_slot)(pos_buff, elem, type_info.min_val);
 #ifndef __CUDACC__
@@ -783,6 +886,25 @@ GLOBAL void SUFFIX(fill_row_ids_sharded)(int32_t* buff,
     }
     CHECK_GE(elem, type_info.min_val)
         << "Element " << elem << " less than min val " << type_info.min_val;
+    if (!sd_inner_proxy) {
+      int64_t prefetch_elem;
+      if (lookahead_join_column_element(
+              type_info,
+              join_column,
+              i + g_hash_join_prefetch_distance * step,
+              prefetch_elem)) {
+        // both the position slot and its count slot get touched
+        const int32_t* prefetch_pos_ptr =
+            SUFFIX(get_hash_slot_sharded)(pos_buff,
+                                          prefetch_elem,
+                                          type_info.min_val,
+                                          shard_info.entry_count_per_shard,
+                                          shard_info.num_shards,
+                                          shard_info.device_count);
+        __builtin_prefetch(prefetch_pos_ptr, 0);
+        __builtin_prefetch(count_buff + (prefetch_pos_ptr - pos_buff), 1);
+      }
+    }
 #endif
     int32_t* pos_ptr = SUFFIX(get_hash_slot_sharded)(pos_buff,
                                                      elem,
@@ -22,9 +22,56 @@
 
 // Driver methods for the IR generation.
 
+bool g_enable_codegen_cse{true};
+
+namespace {
+
+// Expression kinds worth eliminating as common subexpressions. Columns and
+// constants are already cached (fetch_cache_, the literal buffer), extension
+// function calls go through ext_call_cache_ and IN lists carry codegen-time
+// state of their own, so none of those are routed through the CSE cache.
+bool is_cse_eligible(const Analyzer::Expr* expr) {
+  const auto u_oper = dynamic_cast<const Analyzer::UOper*>(expr);
+  if (u_oper) {
+    return u_oper->get_optype() != kUNNEST;
+  }
+  return dynamic_cast<const Analyzer::BinOper*>(expr) ||
+         dynamic_cast<const Analyzer::CaseExpr*>(expr) ||
+         dynamic_cast<const Analyzer::ExtractExpr*>(expr) ||
+         dynamic_cast<const Analyzer::DateaddExpr*>(expr) ||
+         dynamic_cast<const Analyzer::DatediffExpr*>(expr) ||
+         dynamic_cast<const Analyzer::DatetruncExpr*>(expr) ||
+         dynamic_cast<const Analyzer::CharLengthExpr*>(expr) ||
+         dynamic_cast<const Analyzer::KeyForStringExpr*>(expr) ||
+         dynamic_cast<const Analyzer::CardinalityExpr*>(expr) ||
+         dynamic_cast<const Analyzer::LikeExpr*>(expr) ||
+         dynamic_cast<const Analyzer::RegexpExpr*>(expr);
+}
+
+}  // namespace
+
 std::vector<llvm::Value*> CodeGenerator::codegen(const Analyzer::Expr* expr,
                                                  const bool fetch_columns,
                                                  const CompilationOptions& co) {
+  if (!g_enable_codegen_cse || !expr || !is_cse_eligible(expr)) {
+    return codegenDispatch(expr, fetch_columns, co);
+  }
+  const auto cache_key =
+      expr->toString() + (fetch_columns ? "|fetch" : "|no_fetch");
+  const auto it = cgen_state_->cse_cache_.find(cache_key);
+  if (it != cgen_state_->cse_cache_.end()) {
+    return it->second;
+  }
+  const auto result = codegenDispatch(expr, fetch_columns, co);
+  // FetchCacheAnchor drops this entry again when the insert happens inside a
+  // divergent region, since the value wouldn't dominate uses past the merge.
+  cgen_state_->cse_cache_.emplace(cache_key, result);
+  return result;
+}
+
+std::vector<llvm::Value*> CodeGenerator::codegenDispatch(const Analyzer::Expr* expr,
+                                                         const bool fetch_columns,
+                                                         const CompilationOptions& co) {
   if (!expr) {
     return {posArg(expr)};
   }
@@ -528,6 +575,13 @@ Executor::GroupColLLVMValue Executor::groupByColumnCodegen(
                   {group_key,
                    code_generator.posArg(arr_expr),
                    cgen_state_->llInt(log2_bytes(elem_ti.get_logical_size()))});
+    // Decode the array datum once per row, here in the preheader; the loop
+    // body then reads elements with plain indexed loads instead of routing
+    // every element through the ChunkIter accessor again.
+    const auto array_buff_ptr = cgen_state_->emitExternalCall(
+        (array_ti.get_size() > 0) ? "fast_fixlen_array_buff" : "array_buff",
+        llvm::PointerType::get(get_int_type(8, cgen_state_->context_), 0),
+        {group_key, code_generator.posArg(arr_expr)});
     cgen_state_->ir_builder_.CreateBr(array_loop_head);
     cgen_state_->ir_builder_.SetInsertPoint(array_loop_head);
     CHECK(array_len);
@@ -544,17 +598,16 @@ Executor::GroupColLLVMValue Executor::groupByColumnCodegen(
     cgen_state_->ir_builder_.CreateStore(
         cgen_state_->ir_builder_.CreateAdd(array_idx, cgen_state_->llInt(int32_t(1))),
         array_idx_ptr);
-    const auto array_at_fname = "array_at_" + numeric_type_name(elem_ti);
     const auto ar_ret_ty =
         elem_ti.is_fp()
             ? (elem_ti.get_type() == kDOUBLE
                    ? llvm::Type::getDoubleTy(cgen_state_->context_)
                    : llvm::Type::getFloatTy(cgen_state_->context_))
             : get_int_type(elem_ti.get_logical_size() * 8, cgen_state_->context_);
-    group_key = cgen_state_->emitExternalCall(
-        array_at_fname,
-        ar_ret_ty,
-        {group_key, code_generator.posArg(arr_expr), array_idx});
+    const auto elem_buff = cgen_state_->ir_builder_.CreateBitCast(
+        array_buff_ptr, llvm::PointerType::get(ar_ret_ty, 0));
+    group_key = cgen_state_->ir_builder_.CreateLoad(
+        cgen_state_->ir_builder_.CreateGEP(elem_buff, array_idx));
     if (need_patch_unnest_double(
             elem_ti, isArchMaxwell(co.device_type_), thread_mem_shared)) {
       key_to_cache = spillDoubleElement(group_key, ar_ret_ty);
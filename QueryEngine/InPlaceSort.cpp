@@ -103,10 +103,14 @@ void inplace_sort_gpu(const std::list<Analyzer::OrderEntry>& order_entries,
                       Data_Namespace::DataMgr* data_mgr,
                       const int device_id) {
   ThrustAllocator alloc(data_mgr, device_id);
-  CHECK_EQ(size_t(1), order_entries.size());
+  CHECK(!order_entries.empty());
   const auto idx_buff = group_by_buffers.second -
                         align_to_int64(query_mem_desc.getEntryCount() * sizeof(int32_t));
-  for (const auto& order_entry : order_entries) {
+  // Only the first entry drives the device sort; trailing entries (allowed on
+  // the speculative top-n path only) are tie breakers applied during the
+  // host-side reduction.
+  {
+    const auto& order_entry = order_entries.front();
     const auto target_idx = order_entry.tle_no - 1;
     const auto val_buff =
         group_by_buffers.second + query_mem_desc.getColOffInBytes(target_idx);
@@ -18,6 +18,9 @@
 #include "DeepCopyVisitor.h"
 #include "RelAlgExecutor.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace {
 
 class BindFilterToOutermostVisitor : public DeepCopyVisitor {
@@ -45,6 +48,26 @@ class CollectInputColumnsVisitor
   }
 };
 
+// Probe results are cached so repeated queries with the same predicates don't
+// pay the preflight count again. The key folds in the table's current tuple
+// count upper bound, which moves on every append, so a cached selectivity is
+// implicitly invalidated when the table grows; only successful probes are
+// cached. Guarded by a mutex since concurrent sessions share this cache.
+std::mutex selectivity_cache_mutex;
+std::unordered_map<std::string, FilterSelectivity> selectivity_cache;
+
+std::string make_selectivity_cache_key(
+    const int table_id,
+    const size_t table_generation,
+    const std::list<std::shared_ptr<Analyzer::Expr>>& quals) {
+  std::string key =
+      std::to_string(table_id) + ":" + std::to_string(table_generation);
+  for (const auto& qual : quals) {
+    key += ":" + qual->toString();
+  }
+  return key;
+}
+
 }  // namespace
 
 /**
@@ -53,6 +76,9 @@ class CollectInputColumnsVisitor
  * related to those filters.
  * Later, these stats are used to decide whether
  * a filter should be pushed down or not.
+ * The count runs over a single sampled fragment rather than the whole table
+ * and the passing fraction is extrapolated from it; results are cached per
+ * predicate set and table generation.
  */
 FilterSelectivity RelAlgExecutor::getFilterSelectivity(
     const std::vector<std::shared_ptr<Analyzer::Expr>>& filter_expressions,
@@ -96,9 +122,30 @@ FilterSelectivity RelAlgExecutor::getFilterSelectivity(
   int32_t error_code{0};
   size_t one{1};
   ResultSetPtr filtered_result;
-  const auto table_infos = get_table_infos(input_descs, executor_);
+  auto table_infos = get_table_infos(input_descs, executor_);
   CHECK_EQ(size_t(1), table_infos.size());
   const size_t total_rows_upper_bound = table_infos.front().info.getNumTuplesUpperBound();
+  const auto cache_key = make_selectivity_cache_key(
+      table_infos.front().table_id, total_rows_upper_bound, quals);
+  {
+    std::lock_guard<std::mutex> cache_lock(selectivity_cache_mutex);
+    const auto cache_it = selectivity_cache.find(cache_key);
+    if (cache_it != selectivity_cache.end()) {
+      return cache_it->second;
+    }
+  }
+  // Count over a single sampled fragment instead of the full table. The middle
+  // fragment is used since with append-only loads the first and last fragments
+  // are the most likely to be unrepresentative of the table as a whole.
+  auto& probe_fragments = table_infos.front().info.fragments;
+  size_t probe_rows = total_rows_upper_bound;
+  if (probe_fragments.size() > 1) {
+    const auto sample_fragment = probe_fragments[probe_fragments.size() / 2];
+    probe_fragments.assign(1, sample_fragment);
+    table_infos.front().info.setPhysicalNumTuples(
+        sample_fragment.getPhysicalNumTuples());
+    probe_rows = sample_fragment.getPhysicalNumTuples();
+  }
   try {
     ColumnCacheMap column_cache;
     filtered_result = executor_->executeWorkUnit(&error_code,
@@ -127,8 +174,14 @@ FilterSelectivity RelAlgExecutor::getFilterSelectivity(
   const auto count_ptr = boost::get<int64_t>(count_scalar_tv);
   CHECK(count_ptr);
   const auto rows_passing = *count_ptr;
-  const auto rows_total = std::max(total_rows_upper_bound, size_t(1));
-  return {true, static_cast<float>(rows_passing) / rows_total, total_rows_upper_bound};
+  const auto rows_total = std::max(probe_rows, size_t(1));
+  const FilterSelectivity selectivity{
+      true, static_cast<float>(rows_passing) / rows_total, total_rows_upper_bound};
+  {
+    std::lock_guard<std::mutex> cache_lock(selectivity_cache_mutex);
+    selectivity_cache.emplace(cache_key, selectivity);
+  }
+  return selectivity;
 }
 
 /**
@@ -181,7 +234,8 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryWithFilterPushDown(
                                        eo.dynamic_watchdog_time_limit,
                                        /*find_push_down_candidates=*/false,
                                        /*just_calcite_explain=*/false,
-                                       eo.gpu_input_mem_limit_percent};
+                                       eo.gpu_input_mem_limit_percent,
+                                       eo.low_priority};
 
     // Dispatch the subqueries first
     for (auto subquery : subqueries_) {
@@ -222,11 +222,19 @@ size_t get_hash_entry_count(const ExpressionRange& col_range, const bool is_bw_e
 
 }  // namespace
 
+bool g_enable_gpu_hash_table_cache{false};
+
 std::vector<std::pair<JoinHashTable::JoinHashTableCacheKey,
                       std::shared_ptr<std::vector<int32_t>>>>
     JoinHashTable::join_hash_table_cache_;
 std::mutex JoinHashTable::join_hash_table_cache_mutex_;
 
+#ifdef HAVE_CUDA
+std::vector<JoinHashTable::JoinHashTableGpuCacheEntry>
+    JoinHashTable::join_hash_table_gpu_cache_;
+std::mutex JoinHashTable::join_hash_table_gpu_cache_mutex_;
+#endif
+
 size_t get_shard_count(const Analyzer::BinOper* join_condition,
                        const RelAlgExecutionUnit& ra_exe_unit,
                        const Executor* executor) {
@@ -293,11 +301,11 @@ size_t get_shard_count(
   if (!shard_count_less_or_equal_device_count(inner_td->tableId, executor)) {
     return 0;
   }
-  // The two columns involved must be the ones on which the tables have been sharded on.
-  return (inner_td->shardedColumnId == inner_col->get_column_id() &&
-          outer_td->shardedColumnId == outer_col->get_column_id()) ||
-                 (outer_td->shardedColumnId == inner_col->get_column_id() &&
-                  inner_td->shardedColumnId == inner_col->get_column_id())
+  // The two columns involved must be the ones on which the tables have been sharded on;
+  // only then do rows with equal join keys live in colocated shards and the join can be
+  // executed shard-local instead of against the whole inner table.
+  return inner_td->shardedColumnId == inner_col->get_column_id() &&
+                 outer_td->shardedColumnId == outer_col->get_column_id()
              ? inner_td->nShards
              : 0;
 }
@@ -481,6 +489,12 @@ std::deque<Fragmenter_Namespace::FragmentInfo> only_shards_for_device(
   return shards_for_device;
 }
 
+const Analyzer::ColumnVar* JoinHashTable::getProbeColumn() const {
+  const auto cols = get_cols(
+      qual_bin_oper_.get(), *executor_->getCatalog(), executor_->temporary_tables_);
+  return dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
+}
+
 void JoinHashTable::reify(const int device_count) {
   CHECK_LT(0, device_count);
   const auto& catalog = *executor_->getCatalog();
@@ -498,6 +512,7 @@ void JoinHashTable::reify(const int device_count) {
 #ifdef HAVE_CUDA
   gpu_hash_table_buff_.resize(device_count);
   gpu_hash_table_err_buff_.resize(device_count);
+  gpu_hash_table_buff_cached_.resize(device_count, false);
 #endif  // HAVE_CUDA
   std::vector<std::future<void>> init_threads;
   const int shard_count = shardCount();
@@ -615,6 +630,12 @@ ChunkKey JoinHashTable::genHashTableKey(
   if (fragments.size() < 2) {
     hash_table_key.push_back(fragments.front().fragmentId);
   }
+  if (inner_col->get_table_id() > 0) {
+    // Tie the cache key to the inner table's current epoch so hash tables built
+    // before a checkpoint or rollback never validate against newer data.
+    hash_table_key.push_back(executor_->getCatalog()->getTableEpoch(
+        executor_->getCatalog()->getCurrentDB().dbId, inner_col->get_table_id()));
+  }
   return hash_table_key;
 }
 
@@ -752,6 +773,12 @@ void JoinHashTable::initHashTableOnCpu(
       sd_outer_proxy = executor_->getStringDictionaryProxy(
           outer_col->get_comp_param(), executor_->row_set_mem_owner_, true);
       CHECK(sd_outer_proxy);
+      if (num_elements >= sd_inner_proxy->storageEntryCount()) {
+        // With at least as many rows as inner dictionary entries it is
+        // cheaper to translate every id once up front than to decompress and
+        // re-hash a string per row inside the fill loop.
+        sd_inner_proxy->getOrBuildTranslationMap(sd_outer_proxy);
+      }
     }
     int thread_count = cpu_threads();
     std::vector<std::thread> init_cpu_buff_threads;
@@ -843,6 +870,9 @@ void JoinHashTable::initOneToManyHashTableOnCpu(
     sd_outer_proxy = executor_->getStringDictionaryProxy(
         outer_col->get_comp_param(), executor_->row_set_mem_owner_, true);
     CHECK(sd_outer_proxy);
+    if (num_elements >= sd_inner_proxy->storageEntryCount()) {
+      sd_inner_proxy->getOrBuildTranslationMap(sd_outer_proxy);
+    }
   }
   int thread_count = cpu_threads();
   std::vector<std::future<void>> init_threads;
@@ -920,6 +950,19 @@ void JoinHashTable::initHashTableForDevice(
       CHECK_GT(shards_per_device, 0u);
       hash_entry_info.hash_entry_count = entries_per_shard * shards_per_device;
     }
+    // The shard to device assignment depends on the device count, so sharded
+    // hash tables are not safe to reuse across queries and are never cached.
+    if (g_enable_gpu_hash_table_cache && !shard_count &&
+        effective_memory_level == Data_Namespace::GPU_LEVEL && !chunk_key.empty() &&
+        inner_col->get_table_id() > 0) {
+      const auto cached_buff =
+          getGpuHashTableFromCache(chunk_key, num_elements, cols, device_id);
+      if (cached_buff) {
+        gpu_hash_table_buff_[device_id] = cached_buff;
+        gpu_hash_table_buff_cached_[device_id] = true;
+        return;
+      }
+    }
     gpu_hash_table_buff_[device_id] = CudaAllocator::allocGpuAbstractBuffer(
         &data_mgr,
         hash_entry_info.getNormalizedHashEntryCount() * sizeof(int32_t),
@@ -1020,6 +1063,11 @@ void JoinHashTable::initHashTableForDevice(
     if (err) {
       throw NeedsOneToManyHash();
     }
+    if (g_enable_gpu_hash_table_cache && !shard_count &&
+        inner_col->get_table_id() > 0) {
+      putGpuHashTableToCache(chunk_key, num_elements, cols, device_id);
+      gpu_hash_table_buff_cached_[device_id] = true;
+    }
 #else
     CHECK(false);
 #endif
@@ -1057,6 +1105,18 @@ void JoinHashTable::initOneToManyHashTable(
   const auto& ti = inner_col->get_type_info();
   auto& data_mgr = executor_->getCatalog()->getDataMgr();
   if (memory_level_ == Data_Namespace::GPU_LEVEL) {
+    // See the sharding note in initHashTableForDevice.
+    if (g_enable_gpu_hash_table_cache && !shard_count &&
+        effective_memory_level == Data_Namespace::GPU_LEVEL && !chunk_key.empty() &&
+        inner_col->get_table_id() > 0) {
+      const auto cached_buff =
+          getGpuHashTableFromCache(chunk_key, num_elements, cols, device_id);
+      if (cached_buff) {
+        gpu_hash_table_buff_[device_id] = cached_buff;
+        gpu_hash_table_buff_cached_[device_id] = true;
+        return;
+      }
+    }
     const size_t total_count = 2 * hash_entry_count + num_elements;
     gpu_hash_table_buff_[device_id] = CudaAllocator::allocGpuAbstractBuffer(
         &data_mgr, total_count * sizeof(int32_t), device_id);
@@ -1132,23 +1192,35 @@ void JoinHashTable::initOneToManyHashTable(
           executor_->blockSize(),
           executor_->gridSize());
     }
+    if (g_enable_gpu_hash_table_cache && !shard_count && !chunk_key.empty() &&
+        inner_col->get_table_id() > 0) {
+      putGpuHashTableToCache(chunk_key, num_elements, cols, device_id);
+      gpu_hash_table_buff_cached_[device_id] = true;
+    }
 #else
     CHECK(false);
 #endif
   }
 }
 
+JoinHashTable::JoinHashTableCacheKey JoinHashTable::makeCacheKey(
+    const ChunkKey& chunk_key,
+    const size_t num_elements,
+    const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols) const {
+  const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
+  return {col_range_,
+          *cols.first,
+          outer_col ? *outer_col : *cols.first,
+          num_elements,
+          chunk_key,
+          qual_bin_oper_->get_optype()};
+}
+
 void JoinHashTable::initHashTableOnCpuFromCache(
     const ChunkKey& chunk_key,
     const size_t num_elements,
     const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols) {
-  const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
-  JoinHashTableCacheKey cache_key{col_range_,
-                                  *cols.first,
-                                  outer_col ? *outer_col : *cols.first,
-                                  num_elements,
-                                  chunk_key,
-                                  qual_bin_oper_->get_optype()};
+  const auto cache_key = makeCacheKey(chunk_key, num_elements, cols);
   std::lock_guard<std::mutex> join_hash_table_cache_lock(join_hash_table_cache_mutex_);
   for (const auto& kv : join_hash_table_cache_) {
     if (kv.first == cache_key) {
@@ -1163,13 +1235,7 @@ void JoinHashTable::putHashTableOnCpuToCache(
     const ChunkKey& chunk_key,
     const size_t num_elements,
     const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols) {
-  const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
-  JoinHashTableCacheKey cache_key{col_range_,
-                                  *cols.first,
-                                  outer_col ? *outer_col : *cols.first,
-                                  num_elements,
-                                  chunk_key,
-                                  qual_bin_oper_->get_optype()};
+  const auto cache_key = makeCacheKey(chunk_key, num_elements, cols);
   std::lock_guard<std::mutex> join_hash_table_cache_lock(join_hash_table_cache_mutex_);
   for (const auto& kv : join_hash_table_cache_) {
     if (kv.first == cache_key) {
@@ -1179,6 +1245,50 @@ void JoinHashTable::putHashTableOnCpuToCache(
   join_hash_table_cache_.emplace_back(cache_key, cpu_hash_table_buff_);
 }
 
+#ifdef HAVE_CUDA
+Data_Namespace::AbstractBuffer* JoinHashTable::getGpuHashTableFromCache(
+    const ChunkKey& chunk_key,
+    const size_t num_elements,
+    const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+    const int device_id) {
+  const auto cache_key = makeCacheKey(chunk_key, num_elements, cols);
+  std::lock_guard<std::mutex> gpu_cache_lock(join_hash_table_gpu_cache_mutex_);
+  for (const auto& entry : join_hash_table_gpu_cache_) {
+    if (entry.device_id == device_id && entry.key == cache_key) {
+      return entry.buffer;
+    }
+  }
+  return nullptr;
+}
+
+void JoinHashTable::putGpuHashTableToCache(
+    const ChunkKey& chunk_key,
+    const size_t num_elements,
+    const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+    const int device_id) {
+  const auto cache_key = makeCacheKey(chunk_key, num_elements, cols);
+  auto& data_mgr = executor_->getCatalog()->getDataMgr();
+  std::lock_guard<std::mutex> gpu_cache_lock(join_hash_table_gpu_cache_mutex_);
+  for (const auto& entry : join_hash_table_gpu_cache_) {
+    if (entry.device_id == device_id && entry.key == cache_key) {
+      return;
+    }
+  }
+  join_hash_table_gpu_cache_.push_back(
+      {cache_key, device_id, gpu_hash_table_buff_[device_id], &data_mgr});
+}
+#endif  // HAVE_CUDA
+
+void JoinHashTable::invalidateGpuCache() {
+#ifdef HAVE_CUDA
+  std::lock_guard<std::mutex> gpu_cache_lock(join_hash_table_gpu_cache_mutex_);
+  for (auto& entry : join_hash_table_gpu_cache_) {
+    CudaAllocator::freeGpuAbstractBuffer(entry.data_mgr, entry.buffer);
+  }
+  join_hash_table_gpu_cache_.clear();
+#endif  // HAVE_CUDA
+}
+
 llvm::Value* JoinHashTable::codegenHashTableLoad(const size_t table_idx) {
   const auto hash_ptr = codegenHashTableLoad(table_idx, executor_);
   if (hash_ptr->getType()->isIntegerTy(64)) {
@@ -1448,9 +1558,15 @@ void JoinHashTable::freeHashBufferGpuMemory() {
 #ifdef HAVE_CUDA
   const auto& catalog = *executor_->getCatalog();
   auto& data_mgr = catalog.getDataMgr();
-  for (auto& buf : gpu_hash_table_buff_) {
+  for (size_t device_id = 0; device_id < gpu_hash_table_buff_.size(); ++device_id) {
+    auto& buf = gpu_hash_table_buff_[device_id];
     if (buf) {
-      CudaAllocator::freeGpuAbstractBuffer(&data_mgr, buf);
+      // Buffers handed out by the GPU hash table cache are owned by the cache
+      // and freed on invalidation.
+      if (!gpu_hash_table_buff_cached_[device_id]) {
+        CudaAllocator::freeGpuAbstractBuffer(&data_mgr, buf);
+      }
+      gpu_hash_table_buff_cached_[device_id] = false;
       buf = nullptr;
     }
   }
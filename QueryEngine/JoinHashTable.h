@@ -49,6 +49,8 @@
 class Executor;
 struct HashEntryInfo;
 
+extern bool g_enable_gpu_hash_table_cache;
+
 class JoinHashTable : public JoinHashTableInterface {
  public:
   static std::shared_ptr<JoinHashTable> getInstance(
@@ -97,6 +99,16 @@ class JoinHashTable : public JoinHashTableInterface {
 
   HashType getHashType() const noexcept override { return hash_type_; }
 
+  // Range of the build-side join keys, used to prune probe-side fragments whose
+  // metadata range cannot intersect it.
+  ExpressionRange getBuildKeyRange() const { return col_range_; }
+
+  // The probe-side join column, or nullptr if the probe expression is not a
+  // plain column reference.
+  const Analyzer::ColumnVar* getProbeColumn() const;
+
+  SQLOps getJoinOpType() const { return qual_bin_oper_->get_optype(); }
+
   size_t offsetBufferOff() const noexcept override;
 
   size_t countBufferOff() const noexcept override;
@@ -116,11 +128,16 @@ class JoinHashTable : public JoinHashTableInterface {
 
   static auto yieldCacheInvalidator() -> std::function<void()> {
     return []() -> void {
-      std::lock_guard<std::mutex> guard(join_hash_table_cache_mutex_);
-      join_hash_table_cache_.clear();
+      {
+        std::lock_guard<std::mutex> guard(join_hash_table_cache_mutex_);
+        join_hash_table_cache_.clear();
+      }
+      invalidateGpuCache();
     };
   }
 
+  static void invalidateGpuCache();
+
   virtual ~JoinHashTable() {}
 
  private:
@@ -195,6 +212,18 @@ class JoinHashTable : public JoinHashTableInterface {
       const ChunkKey& chunk_key,
       const size_t num_elements,
       const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols);
+#ifdef HAVE_CUDA
+  Data_Namespace::AbstractBuffer* getGpuHashTableFromCache(
+      const ChunkKey& chunk_key,
+      const size_t num_elements,
+      const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+      const int device_id);
+  void putGpuHashTableToCache(
+      const ChunkKey& chunk_key,
+      const size_t num_elements,
+      const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+      const int device_id);
+#endif
   void initHashTableOnCpu(
       const int8_t* col_buff,
       const size_t num_elements,
@@ -246,6 +275,9 @@ class JoinHashTable : public JoinHashTableInterface {
 #ifdef HAVE_CUDA
   std::vector<Data_Namespace::AbstractBuffer*> gpu_hash_table_buff_;
   std::vector<Data_Namespace::AbstractBuffer*> gpu_hash_table_err_buff_;
+  // Per-device flags marking hash table buffers owned by the GPU cache rather
+  // than this instance; such buffers must not be freed with the instance.
+  std::vector<bool> gpu_hash_table_buff_cached_;
 #endif
   ExpressionRange col_range_;
   Executor* executor_;
@@ -271,10 +303,29 @@ class JoinHashTable : public JoinHashTableInterface {
     }
   };
 
+  JoinHashTableCacheKey makeCacheKey(
+      const ChunkKey& chunk_key,
+      const size_t num_elements,
+      const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols) const;
+
   static std::vector<
       std::pair<JoinHashTableCacheKey, std::shared_ptr<std::vector<int32_t>>>>
       join_hash_table_cache_;
   static std::mutex join_hash_table_cache_mutex_;
+
+#ifdef HAVE_CUDA
+  // Cross-query cache of fully built GPU hash tables, keyed like the CPU cache
+  // plus the device id. Cached tables stay resident in the GPU buffer pool
+  // under DataMgr accounting and are freed on cache invalidation.
+  struct JoinHashTableGpuCacheEntry {
+    const JoinHashTableCacheKey key;
+    const int device_id;
+    Data_Namespace::AbstractBuffer* buffer;
+    Data_Namespace::DataMgr* data_mgr;
+  };
+  static std::vector<JoinHashTableGpuCacheEntry> join_hash_table_gpu_cache_;
+  static std::mutex join_hash_table_gpu_cache_mutex_;
+#endif
 };
 
 inline std::string get_table_name_by_id(const int table_id,
@@ -49,6 +49,11 @@ class FailedToJoinOnVirtualColumn : public HashJoinFail {
   FailedToJoinOnVirtualColumn() : HashJoinFail("Cannot join on rowid") {}
 };
 
+class HashTableFull : public HashJoinFail {
+ public:
+  HashTableFull() : HashJoinFail("No free entries left in the join hash table") {}
+};
+
 struct HashJoinMatchingSet {
   llvm::Value* elements;
   llvm::Value* count;
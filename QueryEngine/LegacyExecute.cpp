@@ -17,6 +17,8 @@
 #include "Execute.h"
 #include "QueryRewrite.h"
 
+#include "Shared/LockWaitStats.h"
+
 #include "Shared/scope.h"
 
 // The legacy way of executing queries. Don't change it, it's going away.
@@ -42,10 +44,9 @@ std::shared_ptr<ResultSet> Executor::execute(
   const auto stmt_type = root_plan->get_stmt_type();
   // capture the lock acquistion time
   auto clock_begin = timer_start();
-  std::lock_guard<std::mutex> lock(execute_mutex_);
-  if (g_enable_dynamic_watchdog) {
-    resetInterrupt();
-  }
+  lock_wait_stats::TimedLockGuard<std::mutex> lock(
+      execute_mutex_, lock_wait_stats::Subsystem::kExecutor);
+  resetInterrupt();
   ScopeGuard restore_metainfo_cache = [this] { clearMetaInfoCache(); };
   int64_t queue_time_ms = timer_stop(clock_begin);
   ScopeGuard row_set_holder = [this] { row_set_mem_owner_ = nullptr; };
@@ -16,6 +16,7 @@
 
 #include "CodeGenerator.h"
 #include "Execute.h"
+#include "ExpressionRange.h"
 #include "NullableValue.h"
 
 #include <llvm/IR/MDBuilder.h>
@@ -115,6 +116,74 @@ Likelihood get_likelihood(const Analyzer::Expr* expr) {
   return Likelihood();
 }
 
+// Estimates the fraction of rows which pass a comparison qual from the
+// expression ranges of its operands, which are seeded by the chunk metadata of
+// the scanned table. Returns an invalid Likelihood when no usable range
+// information is available.
+Likelihood get_metadata_based_likelihood(const Analyzer::Expr* expr,
+                                         const std::vector<InputTableInfo>& query_infos,
+                                         const Executor* executor) {
+  const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(expr);
+  if (!bin_oper || !IS_COMPARISON(bin_oper->get_optype()) ||
+      bin_oper->get_qualifier() != kONE) {
+    return Likelihood();
+  }
+  try {
+    const auto lhs_range =
+        getExpressionRange(bin_oper->get_left_operand(), query_infos, executor);
+    const auto rhs_range =
+        getExpressionRange(bin_oper->get_right_operand(), query_infos, executor);
+    if (lhs_range.getType() != ExpressionRangeType::Integer ||
+        rhs_range.getType() != ExpressionRangeType::Integer ||
+        rhs_range.getIntMin() != rhs_range.getIntMax() ||
+        lhs_range.getIntMin() > lhs_range.getIntMax()) {
+      return Likelihood();
+    }
+    const auto val = rhs_range.getIntMin();
+    const auto span = static_cast<double>(lhs_range.getIntMax()) -
+                      static_cast<double>(lhs_range.getIntMin()) + 1.;
+    double pass_fraction{0.};
+    switch (bin_oper->get_optype()) {
+      case kEQ:
+        pass_fraction = 1. / span;
+        break;
+      case kNE:
+        pass_fraction = 1. - 1. / span;
+        break;
+      case kLT:
+        pass_fraction = (val - lhs_range.getIntMin()) / span;
+        break;
+      case kLE:
+        pass_fraction = (val - lhs_range.getIntMin() + 1.) / span;
+        break;
+      case kGT:
+        pass_fraction = (lhs_range.getIntMax() - val) / span;
+        break;
+      case kGE:
+        pass_fraction = (lhs_range.getIntMax() - val + 1.) / span;
+        break;
+      default:
+        return Likelihood();
+    }
+    return Likelihood(
+        static_cast<float>(std::min(std::max(pass_fraction, 0.), 1.)));
+  } catch (...) {
+    return Likelihood();
+  }
+}
+
+// An explicit likelihood hint on the qual wins; without one, fall back to the
+// chunk metadata based estimate.
+Likelihood get_qual_likelihood(const Analyzer::Expr* expr,
+                               const std::vector<InputTableInfo>& query_infos,
+                               const Executor* executor) {
+  const auto hinted_likelihood = get_likelihood(expr);
+  if (hinted_likelihood.isValid()) {
+    return hinted_likelihood;
+  }
+  return get_metadata_based_likelihood(expr, query_infos, executor);
+}
+
 Weight get_weight(const Analyzer::Expr* expr, int depth = 0) {
   auto like_expr = dynamic_cast<const Analyzer::LikeExpr*>(expr);
   if (like_expr) {
@@ -156,7 +225,9 @@ Weight get_weight(const Analyzer::Expr* expr, int depth = 0) {
 
 bool CodeGenerator::prioritizeQuals(const RelAlgExecutionUnit& ra_exe_unit,
                                     std::vector<Analyzer::Expr*>& primary_quals,
-                                    std::vector<Analyzer::Expr*>& deferred_quals) {
+                                    std::vector<Analyzer::Expr*>& deferred_quals,
+                                    const std::vector<InputTableInfo>& query_infos,
+                                    const Executor* executor) {
   for (auto expr : ra_exe_unit.simple_quals) {
     if (should_defer_eval(expr)) {
       deferred_quals.push_back(expr.get());
@@ -165,24 +236,32 @@ bool CodeGenerator::prioritizeQuals(const RelAlgExecutionUnit& ra_exe_unit,
     primary_quals.push_back(expr.get());
   }
 
-  bool short_circuit = false;
+  // Pick the qual most likely to discard a row as the short-circuit qual and
+  // defer everything else behind it.
+  const Analyzer::Expr* short_circuit_qual{nullptr};
+  Likelihood short_circuit_likelihood;
+  for (auto expr : ra_exe_unit.quals) {
+    const auto likelihood = get_qual_likelihood(expr.get(), query_infos, executor);
+    if (likelihood < 0.10 && !contains_unsafe_division(expr.get()) &&
+        (!short_circuit_qual || likelihood < short_circuit_likelihood.getValue())) {
+      short_circuit_qual = expr.get();
+      short_circuit_likelihood = likelihood;
+    }
+  }
 
   for (auto expr : ra_exe_unit.quals) {
-    if (get_likelihood(expr.get()) < 0.10 && !contains_unsafe_division(expr.get())) {
-      if (!short_circuit) {
-        primary_quals.push_back(expr.get());
-        short_circuit = true;
-        continue;
-      }
+    if (expr.get() == short_circuit_qual) {
+      primary_quals.push_back(expr.get());
+      continue;
     }
-    if (short_circuit || should_defer_eval(expr)) {
+    if (short_circuit_qual || should_defer_eval(expr)) {
       deferred_quals.push_back(expr.get());
       continue;
     }
     primary_quals.push_back(expr.get());
   }
 
-  return short_circuit;
+  return short_circuit_qual != nullptr;
 }
 
 llvm::Value* CodeGenerator::codegenLogicalShortCircuit(const Analyzer::BinOper* bin_oper,
@@ -19,6 +19,7 @@
 #include "ExtensionFunctionsWhitelist.h"
 #include "LLVMFunctionAttributesUtil.h"
 #include "OutputBufferInitialization.h"
+#include "PersistentCodeCache.h"
 #include "QueryTemplateGenerator.h"
 
 #include "Shared/mapdpath.h"
@@ -30,6 +31,7 @@ static_assert(false, "LLVM Version >= 4 is required.");
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/MCJIT.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/IR/Attributes.h>
 #include <llvm/IR/GlobalValue.h>
 #include <llvm/IR/InstIterator.h>
@@ -39,6 +41,7 @@ static_assert(false, "LLVM Version >= 4 is required.");
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/FormattedStream.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/TargetRegistry.h>
@@ -51,9 +54,13 @@ static_assert(false, "LLVM Version >= 4 is required.");
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Vectorize.h>
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Intrinsics.h"
 
+#include <chrono>
+#include <future>
+
 #if LLVM_VERSION_MAJOR >= 7
 #include <llvm/Transforms/Scalar/InstSimplifyPass.h>
 #include <llvm/Transforms/Utils.h>
@@ -68,6 +75,12 @@ std::unique_ptr<llvm::Module> udf_cpu_module;
 std::unique_ptr<llvm::Module> rt_udf_gpu_module;
 std::unique_ptr<llvm::Module> rt_udf_cpu_module;
 
+bool g_enable_tiered_cpu_jit{false};
+
+// Run LLVM's loop and SLP vectorizers over the CPU module and target the host
+// CPU's instruction set, so straight-line query loops compile to SIMD code.
+bool g_enable_cpu_vectorization{true};
+
 namespace {
 
 void verify_function_ir(const llvm::Function* func) {
@@ -124,6 +137,18 @@ void optimize_ir(llvm::Function* query_func,
   if (co.opt_level_ == ExecutorOptLevel::LoopStrengthReduction) {
     pass_manager.add(llvm::createLoopStrengthReducePass());
   }
+  if (co.device_type_ == ExecutorDeviceType::CPU && g_enable_cpu_vectorization) {
+    // canonicalize the query loops first so the vectorizers can recognize
+    // them, then let SLP pick up whatever straight-line code remains scalar
+    pass_manager.add(llvm::createCFGSimplificationPass());
+    pass_manager.add(llvm::createEarlyCSEPass());
+    pass_manager.add(llvm::createLICMPass());
+    pass_manager.add(llvm::createLoopRotatePass());
+    pass_manager.add(llvm::createLoopVectorizePass());
+    pass_manager.add(llvm::createSLPVectorizerPass());
+    pass_manager.add(llvm::createInstructionCombiningPass());
+    pass_manager.add(llvm::createCFGSimplificationPass());
+  }
   pass_manager.run(*module);
 
   eliminate_dead_self_recursive_funcs(*module, live_funcs);
@@ -139,6 +164,35 @@ std::string serialize_llvm_object(const T* llvm_obj) {
   return ss.str();
 }
 
+// Persists MCJIT object buffers through PersistentCodeCache so recompiling an
+// already-seen module on a restarted server only pays for IR serialization and
+// relocation, not instruction selection.
+class PersistentObjectCache : public llvm::ObjectCache {
+ public:
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef obj) override {
+    PersistentCodeCache::getInstance().put(
+        "cpu_obj", moduleHash(module), obj.getBuffer().str());
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override {
+    std::string blob;
+    if (!PersistentCodeCache::getInstance().lookup(
+            "cpu_obj", moduleHash(module), blob)) {
+      return nullptr;
+    }
+    return llvm::MemoryBuffer::getMemBufferCopy(blob);
+  }
+
+ private:
+  static std::string moduleHash(const llvm::Module* module) {
+    return PersistentCodeCache::hashKey({serialize_llvm_object(module)},
+                                        LLVM_VERSION_STRING);
+  }
+};
+
+PersistentObjectCache g_persistent_object_cache;
+
 }  // namespace
 
 std::vector<std::pair<void*, void*>> Executor::getCodeFromCache(const CodeCacheKey& key,
@@ -184,7 +238,9 @@ std::unique_ptr<llvm::ExecutionEngine> CodeGenerator::generateNativeCPUCode(
   auto module = func->getParent();
   // run optimizations
 #ifndef WITH_JIT_DEBUG
-  optimize_ir(func, module, live_funcs, co);
+  if (co.opt_level_ != ExecutorOptLevel::Off) {
+    optimize_ir(func, module, live_funcs, co);
+  }
 #endif  // WITH_JIT_DEBUG
 
   llvm::ExecutionEngine* execution_engine{nullptr};
@@ -204,9 +260,26 @@ std::unique_ptr<llvm::ExecutionEngine> CodeGenerator::generateNativeCPUCode(
   llvm::TargetOptions to;
   to.EnableFastISel = true;
   eb.setTargetOptions(to);
+  if (g_enable_cpu_vectorization) {
+    // target the host microarchitecture instead of the generic one so the
+    // vectorized loops can use the full SIMD width of the machine
+    eb.setMCPU(llvm::sys::getHostCPUName());
+    llvm::StringMap<bool> host_features;
+    if (llvm::sys::getHostCPUFeatures(host_features)) {
+      std::vector<std::string> features;
+      for (const auto& feature : host_features) {
+        features.push_back((feature.second ? "+" : "-") + feature.first().str());
+      }
+      eb.setMAttrs(features);
+    }
+  }
   execution_engine = eb.create();
   CHECK(execution_engine);
 
+  if (g_enable_persistent_code_cache) {
+    execution_engine->setObjectCache(&g_persistent_object_cache);
+  }
+
   execution_engine->finalizeObject();
 
   return std::unique_ptr<llvm::ExecutionEngine>(execution_engine);
@@ -228,6 +301,45 @@ std::vector<std::pair<void*, void*>> Executor::optimizeAndCodegenCPU(
     return cached_code;
   }
 
+  if (g_enable_tiered_cpu_jit && co.opt_level_ != ExecutorOptLevel::Off) {
+    // Tier 0: compile without IR optimization so the first run starts right
+    // away, then rebuild the optimized version in the background and swap it
+    // into the code cache for subsequent runs. The module is snapshotted as
+    // textual IR before codegen consumes it; the background job re-parses the
+    // snapshot into its own LLVMContext so it never touches cgen_state_.
+    std::string module_ir;
+    {
+      llvm::raw_string_ostream os(module_ir);
+      module->print(os, nullptr);
+    }
+    const auto query_func_name = query_func->getName().str();
+    const auto multifrag_func_name = multifrag_query_func->getName().str();
+    std::vector<std::string> live_func_names;
+    for (const auto live_func : live_funcs) {
+      live_func_names.push_back(live_func->getName().str());
+    }
+
+    const CompilationOptions tier0_co{co.device_type_,
+                                      co.hoist_literals_,
+                                      ExecutorOptLevel::Off,
+                                      co.with_dynamic_watchdog_,
+                                      co.explain_type_};
+    auto execution_engine =
+        CodeGenerator::generateNativeCPUCode(query_func, live_funcs, tier0_co);
+    auto native_code = execution_engine->getPointerToFunction(multifrag_query_func);
+    CHECK(native_code);
+
+    addCodeToCache(key,
+                   {{std::make_tuple(native_code, execution_engine.release(), nullptr)}},
+                   module,
+                   cpu_code_cache_);
+
+    launchTieredRecompilation(
+        key, module_ir, query_func_name, multifrag_func_name, live_func_names, co);
+
+    return {std::make_pair(native_code, nullptr)};
+  }
+
   auto execution_engine =
       CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
   auto native_code = execution_engine->getPointerToFunction(multifrag_query_func);
@@ -241,6 +353,70 @@ std::vector<std::pair<void*, void*>> Executor::optimizeAndCodegenCPU(
   return {std::make_pair(native_code, nullptr)};
 }
 
+void Executor::launchTieredRecompilation(const CodeCacheKey& key,
+                                         const std::string& module_ir,
+                                         const std::string& query_func_name,
+                                         const std::string& multifrag_func_name,
+                                         const std::vector<std::string>& live_func_names,
+                                         const CompilationOptions& co) {
+  std::lock_guard<std::mutex> lock(tiered_jit_mutex_);
+  // drop jobs which already finished so the list doesn't grow with every
+  // novel query shape
+  tiered_jit_jobs_.erase(
+      std::remove_if(tiered_jit_jobs_.begin(),
+                     tiered_jit_jobs_.end(),
+                     [](std::future<void>& job) {
+                       return job.wait_for(std::chrono::seconds(0)) ==
+                              std::future_status::ready;
+                     }),
+      tiered_jit_jobs_.end());
+  tiered_jit_jobs_.push_back(std::async(
+      std::launch::async,
+      [this, key, module_ir, query_func_name, multifrag_func_name, live_func_names, co] {
+        try {
+          std::unique_ptr<llvm::LLVMContext> context(new llvm::LLVMContext());
+          llvm::SMDiagnostic err;
+          auto mem_buff = llvm::MemoryBuffer::getMemBuffer(module_ir, "", false);
+          auto owned_module = llvm::parseIR(mem_buff->getMemBufferRef(), err, *context);
+          if (!owned_module) {
+            LOG(WARNING) << "Tiered JIT reoptimization could not parse module IR: "
+                         << err.getMessage().str();
+            return;
+          }
+          auto module = owned_module.release();
+          auto query_func = module->getFunction(query_func_name);
+          auto multifrag_query_func = module->getFunction(multifrag_func_name);
+          CHECK(query_func);
+          CHECK(multifrag_query_func);
+          std::unordered_set<llvm::Function*> live_funcs;
+          for (const auto& live_func_name : live_func_names) {
+            if (auto live_func = module->getFunction(live_func_name)) {
+              live_funcs.insert(live_func);
+            }
+          }
+          auto execution_engine =
+              CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+          auto native_code = execution_engine->getPointerToFunction(multifrag_query_func);
+          CHECK(native_code);
+          // No query runs on this executor without holding its execute lock,
+          // so swapping the cache entry can't destroy code a kernel is
+          // executing.
+          std::lock_guard<std::mutex> execute_lock(execute_mutex_);
+          addCodeToCache(
+              key,
+              {{std::make_tuple(native_code, execution_engine.release(), nullptr)}},
+              module,
+              cpu_code_cache_);
+          std::lock_guard<std::mutex> tiered_lock(tiered_jit_mutex_);
+          tiered_jit_contexts_.push_back(std::move(context));
+        } catch (const std::exception& e) {
+          LOG(WARNING) << "Tiered JIT reoptimization failed, keeping the tier 0 "
+                          "version: "
+                       << e.what();
+        }
+      }));
+}
+
 namespace {
 
 std::string cpp_to_llvm_name(const std::string& s) {
@@ -453,6 +629,22 @@ declare i64* @get_bin_from_k_heap_int32_t(i64*, i32, i32, i32, i1, i1, i1, i32,
 declare i64* @get_bin_from_k_heap_int64_t(i64*, i32, i32, i32, i1, i1, i1, i64, i64);
 declare i64* @get_bin_from_k_heap_float(i64*, i32, i32, i32, i1, i1, i1, float, float);
 declare i64* @get_bin_from_k_heap_double(i64*, i32, i32, i32, i1, i1, i1, double, double);
+declare i64* @get_bin_from_k_heap_2keys_int32_t_int32_t(i64*, i32, i32, i32, i1, i1, i1, i32, i32, i32, i1, i1, i1, i32, i32);
+declare i64* @get_bin_from_k_heap_2keys_int32_t_int64_t(i64*, i32, i32, i32, i1, i1, i1, i32, i32, i32, i1, i1, i1, i64, i64);
+declare i64* @get_bin_from_k_heap_2keys_int32_t_float(i64*, i32, i32, i32, i1, i1, i1, i32, i32, i32, i1, i1, i1, float, float);
+declare i64* @get_bin_from_k_heap_2keys_int32_t_double(i64*, i32, i32, i32, i1, i1, i1, i32, i32, i32, i1, i1, i1, double, double);
+declare i64* @get_bin_from_k_heap_2keys_int64_t_int32_t(i64*, i32, i32, i32, i1, i1, i1, i64, i64, i32, i1, i1, i1, i32, i32);
+declare i64* @get_bin_from_k_heap_2keys_int64_t_int64_t(i64*, i32, i32, i32, i1, i1, i1, i64, i64, i32, i1, i1, i1, i64, i64);
+declare i64* @get_bin_from_k_heap_2keys_int64_t_float(i64*, i32, i32, i32, i1, i1, i1, i64, i64, i32, i1, i1, i1, float, float);
+declare i64* @get_bin_from_k_heap_2keys_int64_t_double(i64*, i32, i32, i32, i1, i1, i1, i64, i64, i32, i1, i1, i1, double, double);
+declare i64* @get_bin_from_k_heap_2keys_float_int32_t(i64*, i32, i32, i32, i1, i1, i1, float, float, i32, i1, i1, i1, i32, i32);
+declare i64* @get_bin_from_k_heap_2keys_float_int64_t(i64*, i32, i32, i32, i1, i1, i1, float, float, i32, i1, i1, i1, i64, i64);
+declare i64* @get_bin_from_k_heap_2keys_float_float(i64*, i32, i32, i32, i1, i1, i1, float, float, i32, i1, i1, i1, float, float);
+declare i64* @get_bin_from_k_heap_2keys_float_double(i64*, i32, i32, i32, i1, i1, i1, float, float, i32, i1, i1, i1, double, double);
+declare i64* @get_bin_from_k_heap_2keys_double_int32_t(i64*, i32, i32, i32, i1, i1, i1, double, double, i32, i1, i1, i1, i32, i32);
+declare i64* @get_bin_from_k_heap_2keys_double_int64_t(i64*, i32, i32, i32, i1, i1, i1, double, double, i32, i1, i1, i1, i64, i64);
+declare i64* @get_bin_from_k_heap_2keys_double_float(i64*, i32, i32, i32, i1, i1, i1, double, double, i32, i1, i1, i1, float, float);
+declare i64* @get_bin_from_k_heap_2keys_double_double(i64*, i32, i32, i32, i1, i1, i1, double, double, i32, i1, i1, i1, double, double);
 )" + gen_array_any_all_sigs() +
     gen_translate_null_key_sigs();
 
@@ -522,6 +714,13 @@ void link_udf_module(const std::unique_ptr<llvm::Module>& udf_module,
   udf_module_copy->setDataLayout(module.getDataLayout());
   udf_module_copy->setTargetTriple(module.getTargetTriple());
 
+  std::vector<std::string> udf_function_names;
+  for (auto& f : *udf_module_copy) {
+    if (!f.isDeclaration()) {
+      udf_function_names.push_back(f.getName().str());
+    }
+  }
+
   // Initialize linker with module for RuntimeFunctions.bc
   llvm::Linker ld(module);
   bool link_error = false;
@@ -531,6 +730,19 @@ void link_udf_module(const std::unique_ptr<llvm::Module>& udf_module,
   if (link_error) {
     throw std::runtime_error("link_udf_module: *** error linking module ***");
   }
+
+  // Inline the linked UDF bodies into their callers: left as opaque per-row
+  // calls they defeat both inlining and vectorization of the scan loop, which
+  // is where UDF-bearing queries lose their throughput. The always-inliner
+  // pass at the head of the optimization pipeline picks these up.
+  for (const auto& udf_function_name : udf_function_names) {
+    auto linked_func = module.getFunction(udf_function_name);
+    if (linked_func && !linked_func->isDeclaration()) {
+      linked_func->removeFnAttr(llvm::Attribute::NoInline);
+      linked_func->removeFnAttr(llvm::Attribute::OptimizeNone);
+      mark_function_always_inline(linked_func);
+    }
+  }
 }
 
 }  // namespace
@@ -670,8 +882,23 @@ CodeGenerator::GPUCode CodeGenerator::generateNativeGPUCode(
   std::vector<std::tuple<void*, llvm::ExecutionEngine*, GpuCompilationContext*>>
       cached_functions;
 
-  const auto ptx =
-      generatePTX(cuda_llir, gpu_target.nvptx_target_machine, gpu_target.cgen_state);
+  // Cache the PTX (not the cubin: cubins depend on the installed driver) so a
+  // restarted server skips IR optimization and PTX generation for query shapes
+  // it has compiled before.
+  std::string ptx;
+  std::string ptx_cache_key;
+  if (g_enable_persistent_code_cache) {
+    const auto device_props = gpu_target.cuda_mgr->getDeviceProperties(0);
+    ptx_cache_key = PersistentCodeCache::hashKey(
+        {cuda_llir}, std::string(LLVM_VERSION_STRING) + "_" + device_props->arch);
+  }
+  if (ptx_cache_key.empty() ||
+      !PersistentCodeCache::getInstance().lookup("gpu_ptx", ptx_cache_key, ptx)) {
+    ptx = generatePTX(cuda_llir, gpu_target.nvptx_target_machine, gpu_target.cgen_state);
+    if (!ptx_cache_key.empty()) {
+      PersistentCodeCache::getInstance().put("gpu_ptx", ptx_cache_key, ptx);
+    }
+  }
 
   auto cubin_result = ptx_to_cubin(ptx, gpu_target.block_size, gpu_target.cuda_mgr);
   auto& option_keys = cubin_result.option_keys;
@@ -681,15 +908,29 @@ CodeGenerator::GPUCode CodeGenerator::generateNativeGPUCode(
   const auto num_options = option_keys.size();
 
   auto func_name = wrapper_func->getName().str();
+  // Loading the cubin is a separate driver call per device, each producing
+  // that device's module and kernel handles. The driver context is
+  // thread-local and the loads are independent, so fan them out instead of
+  // finalizing one device at a time.
+  std::vector<std::future<GpuCompilationContext*>> load_futures;
   for (int device_id = 0; device_id < gpu_target.cuda_mgr->getDeviceCount();
        ++device_id) {
-    auto gpu_context = new GpuCompilationContext(cubin,
-                                                 func_name,
-                                                 device_id,
-                                                 gpu_target.cuda_mgr,
-                                                 num_options,
-                                                 &option_keys[0],
-                                                 &option_values[0]);
+    load_futures.push_back(std::async(
+        std::launch::async,
+        [&cubin, &func_name, &gpu_target, num_options, &option_keys, &option_values](
+            const int device_id) {
+          return new GpuCompilationContext(cubin,
+                                           func_name,
+                                           device_id,
+                                           gpu_target.cuda_mgr,
+                                           num_options,
+                                           &option_keys[0],
+                                           &option_values[0]);
+        },
+        device_id));
+  }
+  for (auto& load_future : load_futures) {
+    auto gpu_context = load_future.get();
     auto native_code = gpu_context->kernel();
     auto native_module = gpu_context->module();
     CHECK(native_code);
@@ -1119,6 +1360,12 @@ std::vector<std::string> get_agg_fnames(const std::vector<Analyzer::Expr*>& targ
       case kAPPROX_COUNT_DISTINCT:
         result.emplace_back("agg_approximate_count_distinct");
         break;
+      case kAPPROX_MEDIAN:
+        result.emplace_back("agg_approx_median");
+        break;
+      case kAPPROX_TOP_K:
+        result.emplace_back("agg_approx_top_k");
+        break;
       default:
         CHECK(false);
     }
@@ -1313,8 +1560,13 @@ void Executor::createErrorCheckControlFlow(llvm::Function* query_func,
             call_watchdog_lv =
                 ir_builder.CreateICmp(llvm::ICmpInst::ICMP_SLT, pos, crit_edge_threshold);
           } else {
-            // CPU path: run watchdog for every 64th row
-            auto dw_predicate = ir_builder.CreateAnd(pos, uint64_t(0x3f));
+            // CPU path: probe the watchdog deadline once per check interval,
+            // rounded down to a power of two to keep the predicate a single AND
+            uint64_t check_interval{1};
+            while (check_interval * 2 <= g_dynamic_watchdog_check_interval) {
+              check_interval *= 2;
+            }
+            auto dw_predicate = ir_builder.CreateAnd(pos, check_interval - 1);
             call_watchdog_lv = ir_builder.CreateICmp(
                 llvm::ICmpInst::ICMP_EQ, dw_predicate, cgen_state_->llInt(int64_t(0LL)));
           }
@@ -1493,6 +1745,9 @@ bool always_clone_runtime_function(const llvm::Function* func) {
          func->getName() == "fixed_width_double_decode" ||
          func->getName() == "fixed_width_float_decode" ||
          func->getName() == "fixed_width_small_date_decode" ||
+         func->getName() == "fixed_width_dict_decode" ||
+         func->getName() == "fixed_width_linear_decode" ||
+         func->getName() == "run_length_decode" ||
          func->getName() == "record_error_code";
 }
 
@@ -1538,6 +1793,7 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
       const auto& count_distinct_descriptor =
           query_mem_desc->getCountDistinctDescriptor(i);
       if (count_distinct_descriptor.impl_type_ == CountDistinctImplType::StdSet ||
+          count_distinct_descriptor.impl_type_ == CountDistinctImplType::SparseBitmap ||
           (count_distinct_descriptor.impl_type_ != CountDistinctImplType::Invalid &&
            !co.hoist_literals_)) {
         throw QueryMustRunOnCpu();
@@ -1771,8 +2027,11 @@ bool Executor::compileBody(const RelAlgExecutionUnit& ra_exe_unit,
   // generate the code for the filter
   std::vector<Analyzer::Expr*> primary_quals;
   std::vector<Analyzer::Expr*> deferred_quals;
-  bool short_circuited =
-      CodeGenerator::prioritizeQuals(ra_exe_unit, primary_quals, deferred_quals);
+  bool short_circuited = CodeGenerator::prioritizeQuals(ra_exe_unit,
+                                                        primary_quals,
+                                                        deferred_quals,
+                                                        group_by_and_aggregate.query_infos_,
+                                                        this);
   if (short_circuited) {
     VLOG(1) << "Prioritized " << std::to_string(primary_quals.size()) << " quals, "
             << "short-circuited and deferred " << std::to_string(deferred_quals.size())
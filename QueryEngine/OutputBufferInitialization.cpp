@@ -176,6 +176,8 @@ int64_t get_agg_initial_val(const SQLAgg agg,
     }
     case kCOUNT:
     case kAPPROX_COUNT_DISTINCT:
+    case kAPPROX_MEDIAN:
+    case kAPPROX_TOP_K:
       return 0;
     case kMIN: {
       switch (byte_width) {
@@ -23,6 +23,16 @@
 
 #include "Execute.h"
 
+namespace {
+
+// Bucket threshold tuning bounds: a geometry occupying more than this many
+// grid cells on average means the buckets are too fine for the column, and
+// each doubling of the threshold coarsens the grid by one step.
+constexpr size_t target_overlaps_keys_per_row{20};
+constexpr size_t max_overlaps_bucket_tuning_steps{10};
+
+}  // namespace
+
 std::shared_ptr<OverlapsJoinHashTable> OverlapsJoinHashTable::getInstance(
     const std::shared_ptr<Analyzer::BinOper> condition,
     const std::vector<InputTableInfo>& query_infos,
@@ -90,6 +100,27 @@ void OverlapsJoinHashTable::reifyWithLayout(
 
   size_t tuple_count;
   std::tie(tuple_count, emitted_keys_count_) = approximateTupleCount(columns_per_device);
+
+  // The bucket size for a dimension is derived from the smallest bounding box
+  // edge seen in the column, so a handful of small geometries force a fine
+  // grid and every large geometry then lands in a huge number of cells. That
+  // skews bucket occupancy and blows up the one-to-many payload. Double the
+  // bucket threshold until the average number of cells a geometry occupies is
+  // reasonable, re-estimating the entry and key counts at each step.
+  const auto num_elems = columns_per_device.front().join_columns.front().num_elems;
+  size_t tuning_steps{0};
+  while (num_elems > 0 && tuning_steps < max_overlaps_bucket_tuning_steps &&
+         emitted_keys_count_ > target_overlaps_keys_per_row * num_elems) {
+    overlaps_hashjoin_bucket_threshold_ *= 2.;
+    VLOG(1) << "Overlaps join would emit " << emitted_keys_count_ << " keys for "
+            << num_elems << " rows; retrying with bucket threshold "
+            << overlaps_hashjoin_bucket_threshold_;
+    recomputeBucketSizes(columns_per_device);
+    std::tie(tuple_count, emitted_keys_count_) =
+        approximateTupleCount(columns_per_device);
+    ++tuning_steps;
+  }
+
   const auto entry_count = 2 * std::max(tuple_count, size_t(1));
 
   entry_count_ =
@@ -152,7 +183,8 @@ BaselineJoinHashTable::ColumnsForDevice OverlapsJoinHashTable::fetchColumnsForDe
       computeBucketSizes(bucket_sizes_for_dimension_,
                          join_columns.back(),
                          inner_outer_pairs,
-                         join_column_info.num_elems);
+                         join_column_info.num_elems,
+                         overlaps_hashjoin_bucket_threshold_);
     }
     const auto elem_ti = ti.get_elem_type();
     CHECK(elem_ti.is_fp());
@@ -186,7 +218,8 @@ std::pair<size_t, size_t> OverlapsJoinHashTable::approximateTupleCount(
     const auto composite_key_info = getCompositeKeyInfo(inner_outer_pairs);
     HashTableCacheKey cache_key{columns_per_device.front().join_columns.front().num_elems,
                                 composite_key_info.cache_key_chunks,
-                                condition_->get_optype()};
+                                condition_->get_optype(),
+                                overlaps_hashjoin_bucket_threshold_};
     const auto cached_count_info = getApproximateTupleCountFromCache(cache_key);
     if (cached_count_info.first >= 0) {
       return std::make_pair(cached_count_info.first, cached_count_info.second);
@@ -335,7 +368,8 @@ int OverlapsJoinHashTable::initHashTableOnCpu(
   CHECK(!join_bucket_info.empty());
   HashTableCacheKey cache_key{join_columns.front().num_elems,
                               composite_key_info.cache_key_chunks,
-                              condition_->get_optype()};
+                              condition_->get_optype(),
+                              overlaps_hashjoin_bucket_threshold_};
   initHashTableOnCpuFromCache(cache_key);
   if (cpu_hash_table_buff_) {
     return 0;
@@ -694,7 +728,8 @@ void OverlapsJoinHashTable::computeBucketSizes(
     std::vector<double>& bucket_sizes_for_dimension,
     const JoinColumn& join_column,
     const std::vector<InnerOuter>& inner_outer_pairs,
-    const size_t row_count) {
+    const size_t row_count,
+    const double bucket_threshold) {
   // No coalesced keys for overlaps joins yet
   CHECK_EQ(inner_outer_pairs.size(), 1u);
 
@@ -718,15 +753,12 @@ void OverlapsJoinHashTable::computeBucketSizes(
   std::vector<double> local_bucket_sizes(num_dims, std::numeric_limits<double>::max());
 
   VLOG(1) << "Computing bucketed hashjoin with minimum bucket size "
-          << std::to_string(g_overlaps_hashjoin_bucket_threshold);
+          << std::to_string(bucket_threshold);
 
   const auto effective_memory_level = getEffectiveMemoryLevel(inner_outer_pairs);
   if (effective_memory_level == Data_Namespace::MemoryLevel::CPU_LEVEL) {
     const int thread_count = cpu_threads();
-    compute_bucket_sizes(local_bucket_sizes,
-                         join_column,
-                         g_overlaps_hashjoin_bucket_threshold,
-                         thread_count);
+    compute_bucket_sizes(local_bucket_sizes, join_column, bucket_threshold, thread_count);
   }
 #ifdef HAVE_CUDA
   else {
@@ -740,7 +772,7 @@ void OverlapsJoinHashTable::computeBucketSizes(
 
     compute_bucket_sizes_on_device(device_bucket_sizes_gpu,
                                    join_columns_gpu,
-                                   g_overlaps_hashjoin_bucket_threshold,
+                                   bucket_threshold,
                                    executor_->blockSize(),
                                    executor_->gridSize());
     copy_from_gpu(&data_mgr,
@@ -759,3 +791,22 @@ void OverlapsJoinHashTable::computeBucketSizes(
 
   return;
 }
+
+void OverlapsJoinHashTable::recomputeBucketSizes(
+    std::vector<ColumnsForDevice>& columns_per_device) {
+  const auto inner_outer_pairs = normalize_column_pairs(
+      condition_.get(), *executor_->getCatalog(), executor_->getTemporaryTables());
+  CHECK(!columns_per_device.empty());
+  CHECK(!columns_per_device.front().join_columns.empty());
+  bucket_sizes_for_dimension_.clear();
+  computeBucketSizes(bucket_sizes_for_dimension_,
+                     columns_per_device.front().join_columns.front(),
+                     inner_outer_pairs,
+                     columns_per_device.front().join_columns.front().num_elems,
+                     overlaps_hashjoin_bucket_threshold_);
+  for (auto& columns_for_device : columns_per_device) {
+    for (auto& join_bucket : columns_for_device.join_buckets) {
+      join_bucket.bucket_sizes_for_dimension = bucket_sizes_for_dimension_;
+    }
+  }
+}
@@ -35,7 +35,8 @@ class OverlapsJoinHashTable : public BaselineJoinHashTable {
                               JoinHashTableInterface::HashType::OneToOne,
                               entry_count,
                               column_map,
-                              executor) {}
+                              executor)
+      , overlaps_hashjoin_bucket_threshold_(g_overlaps_hashjoin_bucket_threshold) {}
 
   ~OverlapsJoinHashTable() override {}
 
@@ -92,9 +93,18 @@ class OverlapsJoinHashTable : public BaselineJoinHashTable {
   void computeBucketSizes(std::vector<double>& bucket_sizes_for_dimension,
                           const JoinColumn& join_column,
                           const std::vector<InnerOuter>& inner_outer_pairs,
-                          const size_t row_count);
+                          const size_t row_count,
+                          const double bucket_threshold);
+
+  // Re-derives the per-dimension bucket sizes from the current bucket
+  // threshold and pushes them into the already fetched per-device columns,
+  // so the key count can be re-estimated without refetching anything.
+  void recomputeBucketSizes(std::vector<ColumnsForDevice>& columns_per_device);
 
   std::vector<double> bucket_sizes_for_dimension_;
+  // Per-join copy of g_overlaps_hashjoin_bucket_threshold, grown by the
+  // bucket tuning loop in reifyWithLayout when the geometry column is skewed.
+  double overlaps_hashjoin_bucket_threshold_;
 };
 
 #endif  // QUERYENGINE_OVERLAPSHASHTABLE_H
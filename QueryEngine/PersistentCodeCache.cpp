@@ -0,0 +1,116 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PersistentCodeCache.h"
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Shared/Logger.h"
+
+bool g_enable_persistent_code_cache{false};
+
+PersistentCodeCache& PersistentCodeCache::getInstance() {
+  static PersistentCodeCache instance;
+  return instance;
+}
+
+void PersistentCodeCache::init(const std::string& base_path) {
+  const auto cache_path = boost::filesystem::path(base_path) / "code_cache";
+  boost::system::error_code err;
+  boost::filesystem::create_directories(cache_path, err);
+  if (err) {
+    LOG(WARNING) << "Failed to create code cache directory '" << cache_path.string()
+                 << "': " << err.message() << "; persistent code cache disabled";
+    return;
+  }
+  cache_dir_ = cache_path.string();
+  enabled_ = true;
+}
+
+std::string PersistentCodeCache::entryPath(const std::string& domain,
+                                           const std::string& key_hash) const {
+  return (boost::filesystem::path(cache_dir_) / (domain + "_" + key_hash + ".bin"))
+      .string();
+}
+
+bool PersistentCodeCache::lookup(const std::string& domain,
+                                 const std::string& key_hash,
+                                 std::string& blob) const {
+  if (!enabled_) {
+    return false;
+  }
+  std::ifstream in(entryPath(domain, key_hash), std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  if (!in.good() && !in.eof()) {
+    return false;
+  }
+  blob = ss.str();
+  return !blob.empty();
+}
+
+void PersistentCodeCache::put(const std::string& domain,
+                              const std::string& key_hash,
+                              const std::string& blob) const {
+  if (!enabled_ || blob.empty()) {
+    return;
+  }
+  // Serialize writers and publish via rename so concurrent readers never see a
+  // partially written entry.
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  const auto final_path = entryPath(domain, key_hash);
+  const auto tmp_path = final_path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      LOG(WARNING) << "Failed to open code cache entry '" << tmp_path
+                   << "' for writing";
+      return;
+    }
+    out.write(blob.data(), blob.size());
+    if (!out.good()) {
+      LOG(WARNING) << "Failed to write code cache entry '" << tmp_path << "'";
+      return;
+    }
+  }
+  boost::system::error_code err;
+  boost::filesystem::rename(tmp_path, final_path, err);
+  if (err) {
+    LOG(WARNING) << "Failed to publish code cache entry '" << final_path
+                 << "': " << err.message();
+  }
+}
+
+std::string PersistentCodeCache::hashKey(const std::vector<std::string>& key,
+                                         const std::string& version_tag) {
+  size_t hash{0};
+  boost::hash_combine(hash, version_tag);
+  for (const auto& component : key) {
+    boost::hash_combine(hash, component);
+  }
+  std::ostringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return ss.str();
+}
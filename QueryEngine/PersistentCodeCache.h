@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    PersistentCodeCache.h
+ * @brief   On-disk cache for generated code artifacts (CPU object buffers and
+ *          GPU PTX), so a restarted server does not pay the full JIT cost again
+ *          for query shapes it has already compiled. Entries are keyed by a
+ *          hash of the in-memory code cache key plus a version tag covering the
+ *          LLVM version and target properties; a version mismatch simply
+ *          results in a cache miss.
+ */
+
+#ifndef QUERYENGINE_PERSISTENTCODECACHE_H
+#define QUERYENGINE_PERSISTENTCODECACHE_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+class PersistentCodeCache {
+ public:
+  static PersistentCodeCache& getInstance();
+
+  // Points the cache at <base_path>/code_cache, creating the directory if
+  // needed. Until init is called (or if it fails), lookup/put are no-ops.
+  void init(const std::string& base_path);
+
+  bool isEnabled() const { return enabled_; }
+
+  // The domain separates artifact kinds ("cpu_obj", "gpu_ptx") so hashes
+  // cannot collide across them.
+  bool lookup(const std::string& domain,
+              const std::string& key_hash,
+              std::string& blob) const;
+
+  void put(const std::string& domain,
+           const std::string& key_hash,
+           const std::string& blob) const;
+
+  // Hashes the serialized IR components of a code cache key together with a
+  // version tag; the tag must change whenever the artifact format does.
+  static std::string hashKey(const std::vector<std::string>& key,
+                             const std::string& version_tag);
+
+ private:
+  PersistentCodeCache() = default;
+
+  std::string entryPath(const std::string& domain, const std::string& key_hash) const;
+
+  bool enabled_ = false;
+  std::string cache_dir_;
+  mutable std::mutex write_mutex_;
+};
+
+extern bool g_enable_persistent_code_cache;
+
+#endif  // QUERYENGINE_PERSISTENTCODECACHE_H
@@ -26,6 +26,10 @@
 #include "SpeculativeTopN.h"
 #include "StreamingTopN.h"
 
+#include "Shared/nvtx_helpers.h"
+
+bool g_enable_gpu_stream_overlap{false};
+
 QueryExecutionContext::QueryExecutionContext(
     const RelAlgExecutionUnit& ra_exe_unit,
     const QueryMemoryDescriptor& query_mem_desc,
@@ -191,6 +195,7 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
     const std::vector<int64_t>& join_hash_tables,
     RenderAllocatorMap* render_allocator_map) {
   INJECT_TIMER(lauchGpuCode);
+  NVTX_RANGE("launchGpuCode device " + std::to_string(device_id));
 #ifdef HAVE_CUDA
   CHECK(gpu_allocator_);
   CHECK(query_buffers_);
@@ -208,6 +213,17 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
   uint32_t num_fragments = col_buffers.size();
   std::vector<int32_t> error_codes(grid_size_x * block_size_x);
 
+  CUstream cu_stream{nullptr};
+  const bool use_kernel_stream{g_enable_gpu_stream_overlap && !g_enable_dynamic_watchdog};
+  if (use_kernel_stream) {
+    // A non-blocking stream doesn't synchronize with the legacy default stream,
+    // so this kernel can execute while a concurrent dispatch thread copies its
+    // finished results back on the default stream of the same device. Disabled
+    // under the dynamic watchdog, whose timing events assume the default
+    // stream.
+    checkCudaErrors(cuStreamCreate(&cu_stream, CU_STREAM_NON_BLOCKING));
+  }
+
   CUevent start0, stop0;  // preparation
   cuEventCreate(&start0, 0);
   cuEventCreate(&stop0, 0);
@@ -292,7 +308,7 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
                          block_size_y,
                          block_size_z,
                          query_mem_desc_.sharedMemBytes(ExecutorDeviceType::GPU),
-                         nullptr,
+                         cu_stream,
                          &param_ptrs[0],
                          nullptr));
     } else {
@@ -306,10 +322,14 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
                          block_size_y,
                          block_size_z,
                          query_mem_desc_.sharedMemBytes(ExecutorDeviceType::GPU),
-                         nullptr,
+                         cu_stream,
                          &param_ptrs[0],
                          nullptr));
     }
+    if (use_kernel_stream) {
+      checkCudaErrors(cuStreamSynchronize(cu_stream));
+      checkCudaErrors(cuStreamDestroy(cu_stream));
+    }
     if (g_enable_dynamic_watchdog) {
       executor_->registerActiveModule(cu_functions[device_id].second, device_id);
       cuEventRecord(stop1, 0);
@@ -417,7 +437,7 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
                                      block_size_y,
                                      block_size_z,
                                      0,
-                                     nullptr,
+                                     cu_stream,
                                      &param_ptrs[0],
                                      nullptr));
     } else {
@@ -430,10 +450,14 @@ std::vector<int64_t*> QueryExecutionContext::launchGpuCode(
                                      block_size_y,
                                      block_size_z,
                                      0,
-                                     nullptr,
+                                     cu_stream,
                                      &param_ptrs[0],
                                      nullptr));
     }
+    if (use_kernel_stream) {
+      checkCudaErrors(cuStreamSynchronize(cu_stream));
+      checkCudaErrors(cuStreamDestroy(cu_stream));
+    }
 
     if (g_enable_dynamic_watchdog) {
       executor_->registerActiveModule(cu_functions[device_id].second, device_id);
@@ -737,37 +761,41 @@ std::vector<CUdeviceptr> QueryExecutionContext::prepareKernelParams(
   std::vector<CUdeviceptr> params(KERN_PARAM_COUNT, 0);
   const uint64_t num_fragments = static_cast<uint64_t>(col_buffers.size());
   const size_t col_count{num_fragments > 0 ? col_buffers.front().size() : 0};
+
+  // All the small kernel inputs are packed into one staging buffer and moved
+  // with a single allocation and a single host-to-device copy. Short queries
+  // spend a measurable share of their GPU time in launch setup, and a dozen
+  // small cuMemcpyHtoD calls each pay the full driver round-trip; one copy
+  // pays it once. Every section is 8-byte aligned within the buffer.
+  std::vector<int8_t> staging;
+  const auto append = [&staging](const void* src, const size_t num_bytes) {
+    const size_t offset = staging.size();
+    staging.resize(offset + align_to_int64(num_bytes));
+    if (src) {
+      memcpy(&staging[offset], src, num_bytes);
+    }
+    return offset;
+  };
+
+  size_t col_ptrs_offset{0};
+  size_t multifrag_offset{0};
   if (col_count) {
-    std::vector<CUdeviceptr> multifrag_col_dev_buffers;
-    for (auto frag_col_buffers : col_buffers) {
-      std::vector<CUdeviceptr> col_dev_buffers;
-      for (auto col_buffer : frag_col_buffers) {
+    std::vector<CUdeviceptr> col_dev_buffers;
+    col_dev_buffers.reserve(num_fragments * col_count);
+    for (const auto& frag_col_buffers : col_buffers) {
+      for (const auto col_buffer : frag_col_buffers) {
         col_dev_buffers.push_back(reinterpret_cast<CUdeviceptr>(col_buffer));
       }
-      auto col_buffers_dev_ptr = reinterpret_cast<CUdeviceptr>(
-          gpu_allocator_->alloc(col_count * sizeof(CUdeviceptr)));
-      copy_to_gpu(data_mgr,
-                  col_buffers_dev_ptr,
-                  &col_dev_buffers[0],
-                  col_count * sizeof(CUdeviceptr),
-                  device_id);
-      multifrag_col_dev_buffers.push_back(col_buffers_dev_ptr);
     }
-    params[COL_BUFFERS] = reinterpret_cast<CUdeviceptr>(
-        gpu_allocator_->alloc(num_fragments * sizeof(CUdeviceptr)));
-    copy_to_gpu(data_mgr,
-                params[COL_BUFFERS],
-                &multifrag_col_dev_buffers[0],
-                num_fragments * sizeof(CUdeviceptr),
-                device_id);
-  }
-  params[NUM_FRAGMENTS] =
-      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(sizeof(uint64_t)));
-  copy_to_gpu(
-      data_mgr, params[NUM_FRAGMENTS], &num_fragments, sizeof(uint64_t), device_id);
-  CUdeviceptr literals_and_addr_mapping = reinterpret_cast<CUdeviceptr>(
-      gpu_allocator_->alloc(literal_buff.size() + 2 * sizeof(int64_t)));
-  CHECK_EQ(CUdeviceptr{0}, literals_and_addr_mapping % 8);
+    col_ptrs_offset =
+        append(&col_dev_buffers[0], col_dev_buffers.size() * sizeof(CUdeviceptr));
+    // The per-fragment pointer array points back into this buffer; it is
+    // filled in once the device base address is known.
+    multifrag_offset = append(nullptr, num_fragments * sizeof(CUdeviceptr));
+  }
+
+  const auto num_fragments_offset = append(&num_fragments, sizeof(uint64_t));
+
   std::vector<int64_t> additional_literal_bytes;
   const auto count_distinct_bitmap_mem = query_buffers_->getCountDistinctBitmapPtr();
   if (count_distinct_bitmap_mem) {
@@ -777,32 +805,28 @@ std::vector<CUdeviceptr> QueryExecutionContext::prepareKernelParams(
     additional_literal_bytes.push_back(
         reinterpret_cast<int64_t>(count_distinct_bitmap_host_mem));
     additional_literal_bytes.push_back(static_cast<int64_t>(count_distinct_bitmap_mem));
-    copy_to_gpu(data_mgr,
-                literals_and_addr_mapping,
-                &additional_literal_bytes[0],
-                additional_literal_bytes.size() * sizeof(additional_literal_bytes[0]),
-                device_id);
-  }
-  params[LITERALS] = literals_and_addr_mapping + additional_literal_bytes.size() *
-                                                     sizeof(additional_literal_bytes[0]);
+  }
+  const auto addr_mapping_size =
+      additional_literal_bytes.size() * sizeof(additional_literal_bytes[0]);
+  const auto literals_offset =
+      append(nullptr, addr_mapping_size + literal_buff.size());
+  if (!additional_literal_bytes.empty()) {
+    memcpy(&staging[literals_offset], &additional_literal_bytes[0], addr_mapping_size);
+  }
   if (!literal_buff.empty()) {
     CHECK(hoist_literals);
-    copy_to_gpu(
-        data_mgr, params[LITERALS], &literal_buff[0], literal_buff.size(), device_id);
+    memcpy(
+        &staging[literals_offset + addr_mapping_size], &literal_buff[0], literal_buff.size());
   }
+
   CHECK_EQ(num_rows.size(), col_buffers.size());
   std::vector<int64_t> flatened_num_rows;
   for (auto& nums : num_rows) {
     CHECK_EQ(nums.size(), num_tables);
     flatened_num_rows.insert(flatened_num_rows.end(), nums.begin(), nums.end());
   }
-  params[NUM_ROWS] = reinterpret_cast<CUdeviceptr>(
-      gpu_allocator_->alloc(sizeof(int64_t) * flatened_num_rows.size()));
-  copy_to_gpu(data_mgr,
-              params[NUM_ROWS],
-              &flatened_num_rows[0],
-              sizeof(int64_t) * flatened_num_rows.size(),
-              device_id);
+  const auto num_rows_offset =
+      append(&flatened_num_rows[0], sizeof(int64_t) * flatened_num_rows.size());
 
   CHECK_EQ(frag_offsets.size(), col_buffers.size());
   std::vector<int64_t> flatened_frag_offsets;
@@ -811,58 +835,62 @@ std::vector<CUdeviceptr> QueryExecutionContext::prepareKernelParams(
     flatened_frag_offsets.insert(
         flatened_frag_offsets.end(), offsets.begin(), offsets.end());
   }
-  params[FRAG_ROW_OFFSETS] = reinterpret_cast<CUdeviceptr>(
-      gpu_allocator_->alloc(sizeof(int64_t) * flatened_frag_offsets.size()));
-  copy_to_gpu(data_mgr,
-              params[FRAG_ROW_OFFSETS],
-              &flatened_frag_offsets[0],
-              sizeof(int64_t) * flatened_frag_offsets.size(),
-              device_id);
-  int32_t max_matched{scan_limit};
-  params[MAX_MATCHED] =
-      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(sizeof(max_matched)));
-  copy_to_gpu(
-      data_mgr, params[MAX_MATCHED], &max_matched, sizeof(max_matched), device_id);
-
-  int32_t total_matched{0};
-  params[TOTAL_MATCHED] =
-      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(sizeof(total_matched)));
-  copy_to_gpu(
-      data_mgr, params[TOTAL_MATCHED], &total_matched, sizeof(total_matched), device_id);
+  const auto frag_offsets_offset =
+      append(&flatened_frag_offsets[0], sizeof(int64_t) * flatened_frag_offsets.size());
 
+  const int32_t max_matched{scan_limit};
+  const auto max_matched_offset = append(&max_matched, sizeof(max_matched));
+
+  const int32_t total_matched{0};
+  const auto total_matched_offset = append(&total_matched, sizeof(total_matched));
+
+  size_t init_agg_vals_offset{0};
   if (is_group_by && !output_columnar_) {
     auto cmpt_sz = align_to_int64(query_mem_desc_.getColsSize()) / sizeof(int64_t);
     auto cmpt_val_buff = compact_init_vals(cmpt_sz, init_agg_vals, query_mem_desc_);
-    params[INIT_AGG_VALS] =
-        reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(cmpt_sz * sizeof(int64_t)));
-    copy_to_gpu(data_mgr,
-                params[INIT_AGG_VALS],
-                &cmpt_val_buff[0],
-                cmpt_sz * sizeof(int64_t),
-                device_id);
+    init_agg_vals_offset = append(&cmpt_val_buff[0], cmpt_sz * sizeof(int64_t));
   } else {
-    params[INIT_AGG_VALS] = reinterpret_cast<CUdeviceptr>(
-        gpu_allocator_->alloc(init_agg_vals.size() * sizeof(int64_t)));
-    copy_to_gpu(data_mgr,
-                params[INIT_AGG_VALS],
-                &init_agg_vals[0],
-                init_agg_vals.size() * sizeof(int64_t),
-                device_id);
-  }
-
-  params[ERROR_CODE] = reinterpret_cast<CUdeviceptr>(
-      gpu_allocator_->alloc(error_codes.size() * sizeof(error_codes[0])));
-  copy_to_gpu(data_mgr,
-              params[ERROR_CODE],
-              &error_codes[0],
-              error_codes.size() * sizeof(error_codes[0]),
-              device_id);
+    init_agg_vals_offset =
+        append(&init_agg_vals[0], init_agg_vals.size() * sizeof(int64_t));
+  }
+
+  const auto error_code_offset =
+      append(&error_codes[0], error_codes.size() * sizeof(error_codes[0]));
 
-  params[NUM_TABLES] =
-      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(sizeof(uint32_t)));
-  copy_to_gpu(data_mgr, params[NUM_TABLES], &num_tables, sizeof(uint32_t), device_id);
+  const auto num_tables_offset = append(&num_tables, sizeof(uint32_t));
 
   const auto hash_table_count = join_hash_tables.size();
+  size_t join_hash_tables_offset{0};
+  if (hash_table_count > 1) {
+    join_hash_tables_offset =
+        append(&join_hash_tables[0], hash_table_count * sizeof(int64_t));
+  }
+
+  const auto dev_base =
+      reinterpret_cast<CUdeviceptr>(gpu_allocator_->alloc(staging.size()));
+  CHECK_EQ(CUdeviceptr{0}, dev_base % 8);
+  if (col_count) {
+    std::vector<CUdeviceptr> multifrag_col_dev_buffers(num_fragments);
+    for (uint64_t frag_idx = 0; frag_idx < num_fragments; ++frag_idx) {
+      multifrag_col_dev_buffers[frag_idx] =
+          dev_base + col_ptrs_offset + frag_idx * col_count * sizeof(CUdeviceptr);
+    }
+    memcpy(&staging[multifrag_offset],
+           &multifrag_col_dev_buffers[0],
+           num_fragments * sizeof(CUdeviceptr));
+    params[COL_BUFFERS] = dev_base + multifrag_offset;
+  }
+  copy_to_gpu(data_mgr, dev_base, &staging[0], staging.size(), device_id);
+
+  params[NUM_FRAGMENTS] = dev_base + num_fragments_offset;
+  params[LITERALS] = dev_base + literals_offset + addr_mapping_size;
+  params[NUM_ROWS] = dev_base + num_rows_offset;
+  params[FRAG_ROW_OFFSETS] = dev_base + frag_offsets_offset;
+  params[MAX_MATCHED] = dev_base + max_matched_offset;
+  params[TOTAL_MATCHED] = dev_base + total_matched_offset;
+  params[INIT_AGG_VALS] = dev_base + init_agg_vals_offset;
+  params[ERROR_CODE] = dev_base + error_code_offset;
+  params[NUM_TABLES] = dev_base + num_tables_offset;
   switch (hash_table_count) {
     case 0: {
       params[JOIN_HASH_TABLES] = CUdeviceptr(0);
@@ -871,13 +899,7 @@ std::vector<CUdeviceptr> QueryExecutionContext::prepareKernelParams(
       params[JOIN_HASH_TABLES] = static_cast<CUdeviceptr>(join_hash_tables[0]);
       break;
     default: {
-      params[JOIN_HASH_TABLES] = reinterpret_cast<CUdeviceptr>(
-          gpu_allocator_->alloc(hash_table_count * sizeof(int64_t)));
-      copy_to_gpu(data_mgr,
-                  params[JOIN_HASH_TABLES],
-                  &join_hash_tables[0],
-                  hash_table_count * sizeof(int64_t),
-                  device_id);
+      params[JOIN_HASH_TABLES] = dev_base + join_hash_tables_offset;
     } break;
   }
 
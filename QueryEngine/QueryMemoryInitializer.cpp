@@ -58,7 +58,8 @@ void check_total_bitmap_memory(const QueryMemoryDescriptor& query_mem_desc) {
 }
 
 int64_t* alloc_group_by_buffer(const size_t numBytes,
-                               RenderAllocatorMap* render_allocator_map) {
+                               RenderAllocatorMap* render_allocator_map,
+                               RowSetMemoryOwner* row_set_mem_owner) {
   if (render_allocator_map) {
     // NOTE(adb): If we got here, we are performing an in-situ rendering query and are not
     // using CUDA buffers. Therefore we need to allocate result set storage using CPU
@@ -67,7 +68,7 @@ int64_t* alloc_group_by_buffer(const size_t numBytes,
     auto render_allocator_ptr = render_allocator_map->getRenderAllocator(gpu_idx);
     return reinterpret_cast<int64_t*>(render_allocator_ptr->alloc(numBytes));
   } else {
-    return reinterpret_cast<int64_t*>(checked_malloc(numBytes));
+    return reinterpret_cast<int64_t*>(row_set_mem_owner->allocate(numBytes));
   }
 }
 
@@ -230,6 +231,13 @@ QueryMemoryInitializer::QueryMemoryInitializer(
                  actual_entry_count,
                  warp_size,
                  executor);
+      if (query_mem_desc.hasOccupancyBitmap()) {
+        // all entries start out empty; kernels set bits as they claim entries
+        memset(reinterpret_cast<int8_t*>(group_by_buffer_template.get()) +
+                   query_mem_desc.getOccupancyBitmapOffset(),
+               0,
+               query_mem_desc.getOccupancyBitmapSizeBytes());
+      }
     }
   }
 
@@ -252,17 +260,14 @@ QueryMemoryInitializer::QueryMemoryInitializer(
   const auto group_buffers_count = !query_mem_desc.isGroupBy() ? 1 : num_buffers_;
 
   for (size_t i = 0; i < group_buffers_count; i += step) {
-    auto group_by_buffer =
-        alloc_group_by_buffer(actual_group_buffer_size, render_allocator_map);
+    auto group_by_buffer = alloc_group_by_buffer(
+        actual_group_buffer_size, render_allocator_map, row_set_mem_owner_.get());
     if (!query_mem_desc.lazyInitGroups(device_type)) {
       CHECK(group_by_buffer_template);
       memcpy(group_by_buffer + index_buffer_qw,
              group_by_buffer_template.get(),
              group_buffer_size);
     }
-    if (!render_allocator_map) {
-      row_set_mem_owner_->addGroupByBuffer(group_by_buffer);
-    }
     group_by_buffers_.push_back(group_by_buffer);
     for (size_t j = 1; j < step; ++j) {
       group_by_buffers_.push_back(nullptr);
@@ -355,6 +360,8 @@ void QueryMemoryInitializer::initColumnarGroups(
   for (const auto target_expr : executor->plan_state_->target_exprs_) {
     const auto agg_info = get_target_info(target_expr, g_bigint_count);
     CHECK(!is_distinct_target(agg_info));
+    CHECK_NE(kAPPROX_MEDIAN, agg_info.agg_kind);
+    CHECK_NE(kAPPROX_TOP_K, agg_info.agg_kind);
   }
   const int32_t agg_col_count = query_mem_desc.getSlotCount();
   auto buffer_ptr = reinterpret_cast<int8_t*>(groups_buffer);
@@ -423,8 +430,19 @@ void QueryMemoryInitializer::initColumnPerRow(const QueryMemoryDescriptor& query
     } else {
       CHECK_EQ(static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(col_idx)),
                sizeof(int64_t));
-      init_val =
-          bm_sz > 0 ? allocateCountDistinctBitmap(bm_sz) : allocateCountDistinctSet();
+      if (bm_sz > 0) {
+        init_val = allocateCountDistinctBitmap(bm_sz);
+      } else if (bm_sz == -2) {
+        init_val = allocateCountDistinctSparseBitmap();
+      } else if (bm_sz == -3) {
+        init_val = allocateApproxMedianDigest();
+      } else if (bm_sz == -4) {
+        const auto k_it = approx_top_k_by_slot_.find(col_idx);
+        CHECK(k_it != approx_top_k_by_slot_.end());
+        init_val = allocateApproxTopKSketch(k_it->second);
+      } else {
+        init_val = allocateCountDistinctSet();
+      }
       ++init_vec_idx;
     }
     switch (query_mem_desc.getPaddedSlotWidthBytes(col_idx)) {
@@ -475,9 +493,7 @@ void QueryMemoryInitializer::allocateCountDistinctGpuMem(
                                    count_distinct_bitmap_mem_bytes_);
 
   count_distinct_bitmap_crt_ptr_ = count_distinct_bitmap_host_mem_ =
-      static_cast<int8_t*>(checked_malloc(count_distinct_bitmap_mem_bytes_));
-  row_set_mem_owner_->addCountDistinctBuffer(
-      count_distinct_bitmap_host_mem_, count_distinct_bitmap_mem_bytes_, true);
+      row_set_mem_owner_->allocate(count_distinct_bitmap_mem_bytes_);
 }
 
 // deferred is true for group by queries; initGroups will allocate a bitmap
@@ -514,6 +530,12 @@ std::vector<ssize_t> QueryMemoryInitializer::allocateCountDistinctBuffers(
         } else {
           init_agg_vals_[agg_col_idx] = allocateCountDistinctBitmap(bitmap_byte_sz);
         }
+      } else if (count_distinct_desc.impl_type_ == CountDistinctImplType::SparseBitmap) {
+        if (deferred) {
+          agg_bitmap_size[agg_col_idx] = -2;
+        } else {
+          init_agg_vals_[agg_col_idx] = allocateCountDistinctSparseBitmap();
+        }
       } else {
         CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
         if (deferred) {
@@ -522,6 +544,34 @@ std::vector<ssize_t> QueryMemoryInitializer::allocateCountDistinctBuffers(
           init_agg_vals_[agg_col_idx] = allocateCountDistinctSet();
         }
       }
+    } else if (agg_info.is_agg && agg_info.agg_kind == kAPPROX_MEDIAN) {
+      // The quantile digest rides the count distinct buffer machinery, its
+      // slot also holds a handle to host-side state.
+      const auto agg_col_idx = query_mem_desc.getSlotIndexForSingleSlotCol(target_idx);
+      CHECK_LT(static_cast<size_t>(agg_col_idx), agg_col_count);
+      CHECK_EQ(static_cast<size_t>(query_mem_desc.getLogicalSlotWidthBytes(agg_col_idx)),
+               sizeof(int64_t));
+      if (deferred) {
+        agg_bitmap_size[agg_col_idx] = -3;
+      } else {
+        init_agg_vals_[agg_col_idx] = allocateApproxMedianDigest();
+      }
+    } else if (agg_info.is_agg && agg_info.agg_kind == kAPPROX_TOP_K) {
+      // Like the quantile digest, the heavy hitters sketch rides the count
+      // distinct buffer machinery and stores a handle in its slot.
+      const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+      CHECK(agg_expr && agg_expr->get_error_rate());
+      const size_t k = agg_expr->get_error_rate()->get_constval().intval;
+      const auto agg_col_idx = query_mem_desc.getSlotIndexForSingleSlotCol(target_idx);
+      CHECK_LT(static_cast<size_t>(agg_col_idx), agg_col_count);
+      CHECK_EQ(static_cast<size_t>(query_mem_desc.getLogicalSlotWidthBytes(agg_col_idx)),
+               sizeof(int64_t));
+      if (deferred) {
+        agg_bitmap_size[agg_col_idx] = -4;
+        approx_top_k_by_slot_[agg_col_idx] = k;
+      } else {
+        init_agg_vals_[agg_col_idx] = allocateApproxTopKSketch(k);
+      }
     }
   }
 
@@ -533,11 +583,10 @@ int64_t QueryMemoryInitializer::allocateCountDistinctBitmap(const size_t bitmap_
     CHECK(count_distinct_bitmap_crt_ptr_);
     auto ptr = count_distinct_bitmap_crt_ptr_;
     count_distinct_bitmap_crt_ptr_ += bitmap_byte_sz;
-    row_set_mem_owner_->addCountDistinctBuffer(ptr, bitmap_byte_sz, false);
     return reinterpret_cast<int64_t>(ptr);
   }
-  auto count_distinct_buffer = static_cast<int8_t*>(checked_calloc(bitmap_byte_sz, 1));
-  row_set_mem_owner_->addCountDistinctBuffer(count_distinct_buffer, bitmap_byte_sz, true);
+  auto count_distinct_buffer = row_set_mem_owner_->allocate(bitmap_byte_sz);
+  memset(count_distinct_buffer, 0, bitmap_byte_sz);
   return reinterpret_cast<int64_t>(count_distinct_buffer);
 }
 
@@ -547,6 +596,24 @@ int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
   return reinterpret_cast<int64_t>(count_distinct_set);
 }
 
+int64_t QueryMemoryInitializer::allocateCountDistinctSparseBitmap() {
+  auto count_distinct_sparse_bitmap = new CountDistinctSparseBitmap();
+  row_set_mem_owner_->addCountDistinctSparseBitmap(count_distinct_sparse_bitmap);
+  return reinterpret_cast<int64_t>(count_distinct_sparse_bitmap);
+}
+
+int64_t QueryMemoryInitializer::allocateApproxMedianDigest() {
+  auto digest = new ApproxQuantileDigest();
+  row_set_mem_owner_->addApproxMedianDigest(digest);
+  return reinterpret_cast<int64_t>(digest);
+}
+
+int64_t QueryMemoryInitializer::allocateApproxTopKSketch(const size_t k) {
+  auto sketch = new ApproxTopKSketch(k);
+  row_set_mem_owner_->addApproxTopKSketch(sketch);
+  return reinterpret_cast<int64_t>(sketch);
+}
+
 #ifdef HAVE_CUDA
 GpuGroupByBuffers QueryMemoryInitializer::prepareTopNHeapsDevBuffer(
     const QueryMemoryDescriptor& query_mem_desc,
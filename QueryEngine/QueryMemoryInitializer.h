@@ -24,6 +24,7 @@
 
 #include "Rendering/RenderAllocator.h"
 
+#include <map>
 #include <memory>
 
 #ifdef HAVE_CUDA
@@ -117,6 +118,12 @@ class QueryMemoryInitializer {
 
   int64_t allocateCountDistinctSet();
 
+  int64_t allocateCountDistinctSparseBitmap();
+
+  int64_t allocateApproxMedianDigest();
+
+  int64_t allocateApproxTopKSketch(const size_t k);
+
 #ifdef HAVE_CUDA
   GpuGroupByBuffers prepareTopNHeapsDevBuffer(const QueryMemoryDescriptor& query_mem_desc,
                                               const CUdeviceptr init_agg_vals_dev_ptr,
@@ -182,6 +189,10 @@ class QueryMemoryInitializer {
   int8_t* count_distinct_bitmap_crt_ptr_;
   int8_t* count_distinct_bitmap_host_mem_;
 
+  // k per deferred APPROX_TOP_K slot; the bitmap size vector only carries a
+  // sentinel for those.
+  std::map<size_t, size_t> approx_top_k_by_slot_;
+
   DeviceAllocator* device_allocator_{nullptr};
 
   friend class Executor;  // Accesses result_sets_
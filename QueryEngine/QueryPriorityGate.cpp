@@ -0,0 +1,54 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryPriorityGate.h"
+
+#include <chrono>
+
+QueryPriorityGate::HighPriorityScope::HighPriorityScope() {
+  QueryPriorityGate::getInstance().enter();
+}
+
+QueryPriorityGate::HighPriorityScope::~HighPriorityScope() {
+  QueryPriorityGate::getInstance().leave();
+}
+
+QueryPriorityGate& QueryPriorityGate::getInstance() {
+  static QueryPriorityGate instance;
+  return instance;
+}
+
+void QueryPriorityGate::enter() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  high_priority_active_++;
+}
+
+void QueryPriorityGate::leave() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    high_priority_active_--;
+  }
+  cv_.notify_all();
+}
+
+void QueryPriorityGate::waitForHighPriorityQueries() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // each fragment boundary yields for at most five seconds, so batch queries
+  // still make (slow) progress under a saturated interactive load
+  cv_.wait_for(lock, std::chrono::seconds(5), [this] {
+    return high_priority_active_ == 0;
+  });
+}
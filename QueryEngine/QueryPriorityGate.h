@@ -0,0 +1,64 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    QueryPriorityGate.h
+ * @brief   Two-class query priority coordination. Interactive (default
+ *          priority) queries register themselves while their fragment kernels
+ *          are dispatching; batch (low priority) queries poll the gate at
+ *          fragment kernel boundaries and yield the devices while any
+ *          interactive query is in flight, bounding interactive latency under
+ *          mixed dashboard/ETL load without killing batch work.
+ */
+
+#ifndef QUERYENGINE_QUERYPRIORITYGATE_H
+#define QUERYENGINE_QUERYPRIORITYGATE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+class QueryPriorityGate {
+ public:
+  // RAII registration of an interactive query for the duration of its
+  // fragment dispatch.
+  class HighPriorityScope {
+   public:
+    HighPriorityScope();
+    ~HighPriorityScope();
+    HighPriorityScope(const HighPriorityScope&) = delete;
+    HighPriorityScope& operator=(const HighPriorityScope&) = delete;
+  };
+
+  static QueryPriorityGate& getInstance();
+
+  // Called by low priority dispatch loops between fragment kernels; blocks
+  // while interactive queries are executing. The wait is bounded so a steady
+  // stream of dashboard queries cannot starve batch work forever.
+  void waitForHighPriorityQueries();
+
+ private:
+  QueryPriorityGate() {}
+
+  void enter();
+  void leave();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t high_priority_active_{0};
+};
+
+#endif  // QUERYENGINE_QUERYPRIORITYGATE_H
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2018 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryResultCache.h"
+#include "ResultSet.h"
+
+namespace {
+
+const size_t max_cached_result_sets{64};
+
+}  // namespace
+
+QueryResultCache& QueryResultCache::instance() {
+  static QueryResultCache cache;
+  return cache;
+}
+
+ResultSetPtr QueryResultCache::get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  const auto it = entries_by_key_.find(key);
+  if (it == entries_by_key_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  const auto& rows = entries_.front().second;
+  rows->moveToBegin();
+  return rows;
+}
+
+void QueryResultCache::put(const std::string& key, const ResultSetPtr& rows) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  const auto it = entries_by_key_.find(key);
+  if (it != entries_by_key_.end()) {
+    it->second->second = rows;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+  entries_.emplace_front(key, rows);
+  entries_by_key_.emplace(key, entries_.begin());
+  if (entries_.size() > max_cached_result_sets) {
+    entries_by_key_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+
+void QueryResultCache::clear() {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  entries_.clear();
+  entries_by_key_.clear();
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2018 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QUERYENGINE_QUERYRESULTCACHE_H
+#define QUERYENGINE_QUERYRESULTCACHE_H
+
+#include "RelAlgExecutionUnit.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Process-wide LRU cache for small, fully materialized result sets. Entries are
+// keyed by a fingerprint of the execution unit together with the table and
+// string dictionary generations of all inputs, so a key can only hit again
+// while every input is unchanged; entries for stale generations simply age out.
+// The cached ResultSet keeps its own RowSetMemoryOwner alive through the
+// shared pointer, which also covers any transient string dictionaries.
+class QueryResultCache {
+ public:
+  static QueryResultCache& instance();
+
+  // Returns the cached result set for the given key, or nullptr on a miss.
+  // A hit refreshes the entry's LRU position and rewinds the result set.
+  ResultSetPtr get(const std::string& key);
+
+  void put(const std::string& key, const ResultSetPtr& rows);
+
+  void clear();
+
+ private:
+  QueryResultCache() = default;
+
+  std::mutex cache_mutex_;
+  // Most recently used entries at the front.
+  std::list<std::pair<std::string, ResultSetPtr>> entries_;
+  std::unordered_map<std::string,
+                     std::list<std::pair<std::string, ResultSetPtr>>::iterator>
+      entries_by_key_;
+};
+
+#endif  // QUERYENGINE_QUERYRESULTCACHE_H
@@ -23,6 +23,7 @@
 #include "RelLeftDeepInnerJoin.h"
 #include "Rendering/RenderRelAlgUtils.h"
 #include "RexVisitor.h"
+#include "TableFunctions.h"
 
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
@@ -163,6 +164,11 @@ RANodeOutput get_node_output(const RelAlgNode* ra_node) {
     CHECK_EQ(size_t(0), logical_values_node->inputCount());
     return n_outputs(logical_values_node, logical_values_node->size());
   }
+  const auto table_func_node = dynamic_cast<const RelTableFunction*>(ra_node);
+  if (table_func_node) {
+    // Table function output count doesn't depend on the input
+    return n_outputs(table_func_node, table_func_node->size());
+  }
   CHECK(false);
   return outputs;
 }
@@ -1444,6 +1450,10 @@ class RelAlgAbstractInterpreter {
         ra_node = dispatchLogicalValues(crt_node);
       } else if (rel_op == std::string("LogicalTableModify")) {
         ra_node = dispatchModify(crt_node);
+      } else if (rel_op == std::string("LogicalUnion")) {
+        ra_node = dispatchUnion(crt_node);
+      } else if (rel_op == std::string("LogicalTableFunctionScan")) {
+        ra_node = dispatchTableFunction(crt_node);
       } else {
         throw QueryNotSupported(std::string("Node ") + rel_op + " not supported yet");
       }
@@ -1536,6 +1546,62 @@ class RelAlgAbstractInterpreter {
         collation, limit > 0 ? limit : 0, offset, inputs.front());
   }
 
+  std::shared_ptr<RelLogicalUnion> dispatchUnion(const rapidjson::Value& union_ra) {
+    const auto inputs = getRelAlgInputs(union_ra);
+    CHECK_GE(inputs.size(), size_t(2));
+    const auto& all = field(union_ra, "all");
+    CHECK(all.IsBool());
+    if (!all.GetBool()) {
+      throw QueryNotSupported("UNION without ALL not supported yet");
+    }
+    return std::make_shared<RelLogicalUnion>(inputs, true);
+  }
+
+  std::shared_ptr<RelTableFunction> dispatchTableFunction(
+      const rapidjson::Value& table_func_ra) {
+    const auto inputs = getRelAlgInputs(table_func_ra);
+    const auto& invocation = field(table_func_ra, "invocation");
+    CHECK(invocation.IsObject());
+    const auto function_name = json_str(field(invocation, "op"));
+    const auto table_function = TableFunctionRegistry::get(function_name);
+    if (!table_function) {
+      throw QueryNotSupported("Table function " + function_name + " not supported");
+    }
+    if (inputs.size() != table_function->cursor_arg_count) {
+      throw QueryNotSupported("Table function " + function_name + " expects " +
+                              std::to_string(table_function->cursor_arg_count) +
+                              " cursor argument(s)");
+    }
+    // The cursor arguments have become inputs of the scan node; the literal
+    // operands of the invocation are the remaining scalar arguments.
+    const auto& operands = field(invocation, "operands");
+    CHECK(operands.IsArray());
+    std::vector<std::unique_ptr<const RexLiteral>> scalar_inputs;
+    for (auto operands_it = operands.Begin(); operands_it != operands.End();
+         ++operands_it) {
+      if (operands_it->IsObject() && operands_it->HasMember("literal")) {
+        scalar_inputs.emplace_back(parse_literal(*operands_it));
+      }
+    }
+    if (scalar_inputs.size() != table_function->scalar_arg_count) {
+      throw QueryNotSupported("Table function " + function_name + " expects " +
+                              std::to_string(table_function->scalar_arg_count) +
+                              " literal argument(s)");
+    }
+    const auto& tuple_type_arr = field(table_func_ra, "rowType");
+    CHECK(tuple_type_arr.IsArray());
+    std::vector<TargetMetaInfo> tuple_type;
+    for (auto tuple_type_arr_it = tuple_type_arr.Begin();
+         tuple_type_arr_it != tuple_type_arr.End();
+         ++tuple_type_arr_it) {
+      const auto component_type = parse_type(*tuple_type_arr_it);
+      const auto component_name = json_str(field(*tuple_type_arr_it, "name"));
+      tuple_type.emplace_back(component_name, component_type);
+    }
+    return std::make_shared<RelTableFunction>(
+        function_name, inputs, scalar_inputs, tuple_type);
+  }
+
   std::shared_ptr<RelModify> dispatchModify(const rapidjson::Value& logical_modify_ra) {
     const auto inputs = getRelAlgInputs(logical_modify_ra);
     CHECK_EQ(size_t(1), inputs.size());
@@ -1671,8 +1737,16 @@ std::shared_ptr<const RelAlgNode> deserialize_ra_dag(
     const Catalog_Namespace::Catalog& cat,
     RelAlgExecutor* ra_executor,
     const RenderQueryOptions* render_opts) {
+  // Parse in situ: the plan text is copied once into a scratch buffer and
+  // every string value in the DOM becomes a pointer into it, so building the
+  // document does no per-string allocation or copying. That's most of the
+  // deserialization cost on large generated plans, where thousands of
+  // operator names, field names and literals dominate the document. The
+  // scratch buffer only has to outlive the document, which doesn't escape
+  // this function; the interpreter copies what it keeps.
+  std::vector<char> scratch(query_ra.c_str(), query_ra.c_str() + query_ra.size() + 1);
   rapidjson::Document query_ast;
-  query_ast.Parse(query_ra.c_str());
+  query_ast.ParseInsitu(scratch.data());
   CHECK(!query_ast.HasParseError());
   CHECK(query_ast.IsObject());
   RelAlgNode::resetRelAlgFirstId();
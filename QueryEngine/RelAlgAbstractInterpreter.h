@@ -1378,6 +1378,85 @@ class RelLogicalValues : public RelAlgNode {
   const std::vector<TargetMetaInfo> tuple_type_;
 };
 
+// UNION ALL over two or more children with matching schemas. The children are
+// executed as regular steps and their result storage is stitched together, so
+// no temporary table materialization is needed for the union itself.
+class RelLogicalUnion : public RelAlgNode {
+ public:
+  RelLogicalUnion(const std::vector<std::shared_ptr<const RelAlgNode>>& inputs,
+                  const bool is_all)
+      : is_all_(is_all) {
+    CHECK_GE(inputs.size(), size_t(2));
+    for (const auto& input : inputs) {
+      inputs_.push_back(input);
+    }
+  }
+
+  bool isAll() const { return is_all_; }
+
+  std::string toString() const override {
+    return "(RelLogicalUnion<" + std::to_string(reinterpret_cast<uint64_t>(this)) + ">)";
+  }
+
+  size_t size() const override { return inputs_[0]->size(); }
+
+  std::shared_ptr<RelAlgNode> deepCopy() const override {
+    return std::make_shared<RelLogicalUnion>(inputs_, is_all_);
+  }
+
+ private:
+  const bool is_all_;
+};
+
+// A table function invocation, i.e. TABLE(row_copier(CURSOR(...), 2)). Calcite
+// turns the cursor arguments into inputs of the scan node; the remaining scalar
+// arguments are kept on the node and must be literals for now.
+class RelTableFunction : public RelAlgNode {
+ public:
+  RelTableFunction(const std::string& function_name,
+                   const std::vector<std::shared_ptr<const RelAlgNode>>& inputs,
+                   std::vector<std::unique_ptr<const RexLiteral>>& scalar_inputs,
+                   const std::vector<TargetMetaInfo>& tuple_type)
+      : function_name_(function_name), tuple_type_(tuple_type) {
+    for (const auto& input : inputs) {
+      inputs_.push_back(input);
+    }
+    scalar_inputs_ = std::move(scalar_inputs);
+  }
+
+  const std::string& getFunctionName() const { return function_name_; }
+
+  size_t getScalarInputsSize() const { return scalar_inputs_.size(); }
+
+  const RexLiteral* getScalarInput(const size_t idx) const {
+    CHECK_LT(idx, scalar_inputs_.size());
+    return scalar_inputs_[idx].get();
+  }
+
+  const std::vector<TargetMetaInfo> getTupleType() const { return tuple_type_; }
+
+  std::string toString() const override {
+    return "(RelTableFunction<" + std::to_string(reinterpret_cast<uint64_t>(this)) +
+           "> " + function_name_ + ")";
+  }
+
+  size_t size() const override { return tuple_type_.size(); }
+
+  std::shared_ptr<RelAlgNode> deepCopy() const override {
+    std::vector<std::unique_ptr<const RexLiteral>> scalar_inputs_copy;
+    for (const auto& scalar_input : scalar_inputs_) {
+      scalar_inputs_copy.push_back(scalar_input->deepCopy());
+    }
+    return std::make_shared<RelTableFunction>(
+        function_name_, inputs_, scalar_inputs_copy, tuple_type_);
+  }
+
+ private:
+  const std::string function_name_;
+  std::vector<std::unique_ptr<const RexLiteral>> scalar_inputs_;
+  const std::vector<TargetMetaInfo> tuple_type_;
+};
+
 class QueryNotSupported : public std::runtime_error {
  public:
   QueryNotSupported(const std::string& reason) : std::runtime_error(reason) {}
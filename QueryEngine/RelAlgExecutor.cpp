@@ -20,24 +20,38 @@
 #include "CalciteDeserializerUtils.h"
 #include "CardinalityEstimator.h"
 #include "ColumnFetcher.h"
+#include "DeviceCostModel.h"
 #include "EquiJoinCondition.h"
 #include "ExpressionRewrite.h"
 #include "FromTableReordering.h"
 #include "InputMetadata.h"
 #include "JoinFilterPushDown.h"
 #include "QueryPhysicalInputsCollector.h"
+#include "QueryPriorityGate.h"
+#include "QueryResultCache.h"
 #include "RangeTableIndexVisitor.h"
 #include "RexVisitor.h"
+#include "TableFunctions.h"
+#include "TypePunning.h"
 #include "UsedColumnsVisitor.h"
 #include "WindowContext.h"
 
 #include "../Parser/ParserNode.h"
+#include "../Shared/LockWaitStats.h"
+#include "../Shared/SqlTypesLayout.h"
 #include "../Shared/measure.h"
 
 #include <algorithm>
+#include <limits>
+#include <map>
 #include <numeric>
+#include <sstream>
 
 bool g_skip_intermediate_count{true};
+bool g_enable_metadata_only_aggregates{true};
+bool g_enable_query_result_cache{false};
+bool g_enable_eager_step_result_release{false};
+bool g_enable_runtime_filter_propagation{false};
 
 namespace {
 
@@ -82,13 +96,23 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const std::string& que
   const auto ra = deserialize_ra_dag(
       query_ra, cat_, this, render_info ? render_info->getRenderQueryOptsPtr() : nullptr);
 
+  // Interactive queries register with the priority gate before contending for
+  // the executor lock. GPU queries serialize on that lock, so an interactive
+  // query queued behind a batch query must already be visible to the batch
+  // dispatch loop's fragment-boundary polls; registering after the lock would
+  // have it wait on a gate nobody can raise.
+  std::unique_ptr<QueryPriorityGate::HighPriorityScope> high_priority_scope;
+  if (!eo.low_priority) {
+    high_priority_scope.reset(new QueryPriorityGate::HighPriorityScope());
+  }
+
   // capture the lock acquistion time
   auto clock_begin = timer_start();
-  std::lock_guard<std::mutex> lock(executor_->execute_mutex_);
+  lock_wait_stats::TimedLockGuard<std::mutex> lock(
+      executor_->execute_mutex_, lock_wait_stats::Subsystem::kExecutor);
   int64_t queue_time_ms = timer_stop(clock_begin);
-  if (g_enable_dynamic_watchdog) {
-    executor_->resetInterrupt();
-  }
+  // Clear any interrupt left over from a previous query on this executor.
+  executor_->resetInterrupt();
   ScopeGuard row_set_holder = [this, &render_info] {
     if (render_info) {
       // need to hold onto the RowSetMemOwner for potential
@@ -272,9 +296,7 @@ void RelAlgExecutor::prepareLeafExecution(
     const TableGenerations& table_generations) {
   // capture the lock acquistion time
   auto clock_begin = timer_start();
-  if (g_enable_dynamic_watchdog) {
-    executor_->resetInterrupt();
-  }
+  executor_->resetInterrupt();
   queue_time_ms_ = timer_stop(clock_begin);
   executor_->row_set_mem_owner_ = std::make_shared<RowSetMemoryOwner>();
   executor_->table_generations_ = table_generations;
@@ -290,6 +312,40 @@ ExecutionResult RelAlgExecutor::executeRelAlgSubQuery(const RexSubQuery* subquer
   return executeRelAlgSeq(ed_list, co, eo, nullptr, 0);
 }
 
+namespace {
+
+// For each step, the index of the last later step which reads its result, or
+// -1 if no later step does. The input tree of every step is walked down to the
+// bodies of other steps, which is where consumers pick up temporary tables.
+std::vector<ssize_t> get_last_consumer_step(
+    const std::vector<RaExecutionDesc>& exec_descs) {
+  std::unordered_map<const RelAlgNode*, size_t> body_to_step;
+  for (size_t i = 0; i < exec_descs.size(); ++i) {
+    body_to_step.emplace(exec_descs[i].getBody(), i);
+  }
+  std::vector<ssize_t> last_consumer(exec_descs.size(), -1);
+  for (size_t i = 0; i < exec_descs.size(); ++i) {
+    std::vector<const RelAlgNode*> work{exec_descs[i].getBody()};
+    std::unordered_set<const RelAlgNode*> visited;
+    while (!work.empty()) {
+      const auto node = work.back();
+      work.pop_back();
+      for (size_t input_idx = 0; input_idx < node->inputCount(); ++input_idx) {
+        const auto input = node->getInput(input_idx);
+        const auto step_it = body_to_step.find(input);
+        if (step_it != body_to_step.end()) {
+          last_consumer[step_it->second] = i;
+        } else if (visited.insert(input).second) {
+          work.push_back(input);
+        }
+      }
+    }
+  }
+  return last_consumer;
+}
+
+}  // namespace
+
 ExecutionResult RelAlgExecutor::executeRelAlgSeq(std::vector<RaExecutionDesc>& exec_descs,
                                                  const CompilationOptions& co,
                                                  const ExecutionOptions& eo,
@@ -308,6 +364,8 @@ ExecutionResult RelAlgExecutor::executeRelAlgSeq(std::vector<RaExecutionDesc>& e
   CHECK(!exec_descs.empty());
   const auto exec_desc_count = eo.just_explain ? size_t(1) : exec_descs.size();
 
+  const auto last_consumer_step = get_last_consumer_step(exec_descs);
+
   size_t i = 0;
   for (auto it = exec_descs.begin(); it != exec_descs.end(); ++it, i++) {
     // only render on the last step
@@ -317,6 +375,17 @@ ExecutionResult RelAlgExecutor::executeRelAlgSeq(std::vector<RaExecutionDesc>& e
                       eo,
                       (it == std::prev(exec_descs.end()) ? render_info : nullptr),
                       queue_time_ms);
+    if (g_enable_eager_step_result_release && !eo.just_explain) {
+      // Steps no later step reads from can release their result buffers now,
+      // so the peak memory of a multi-step query tracks the live steps
+      // instead of the whole sequence.
+      for (size_t j = 0; j < i; ++j) {
+        if (last_consumer_step[j] == static_cast<ssize_t>(i)) {
+          eraseFromTemporaryTables(-exec_descs[j].getBody()->getId());
+          exec_descs[j].setResult(ExecutionResult(ResultSetPtr(nullptr), {}));
+        }
+      }
+    }
   }
 
   return exec_descs[exec_desc_count - 1].getResult();
@@ -377,7 +446,8 @@ void RelAlgExecutor::executeRelAlgStep(
       eo.dynamic_watchdog_time_limit,
       eo.find_push_down_candidates,
       eo.just_calcite_explain,
-      eo.gpu_input_mem_limit_percent};
+      eo.gpu_input_mem_limit_percent,
+      eo.low_priority};
 
   const auto compound = dynamic_cast<const RelCompound*>(body);
   if (compound) {
@@ -459,6 +529,18 @@ void RelAlgExecutor::executeRelAlgStep(
     exec_desc.setResult(executeModify(modify, eo_work_unit));
     return;
   }
+  const auto union_node = dynamic_cast<const RelLogicalUnion*>(body);
+  if (union_node) {
+    exec_desc.setResult(executeUnion(union_node, queue_time_ms));
+    addTemporaryTable(-union_node->getId(), exec_desc.getResult().getDataPtr());
+    return;
+  }
+  const auto table_func_node = dynamic_cast<const RelTableFunction*>(body);
+  if (table_func_node) {
+    exec_desc.setResult(executeTableFunction(table_func_node, queue_time_ms));
+    addTemporaryTable(-table_func_node->getId(), exec_desc.getResult().getDataPtr());
+    return;
+  }
   CHECK(false);
 }
 
@@ -1560,6 +1642,143 @@ ExecutionResult RelAlgExecutor::executeLogicalValues(
   return {rs, tuple_type};
 }
 
+ExecutionResult RelAlgExecutor::executeUnion(const RelLogicalUnion* union_node,
+                                             const int64_t queue_time_ms) {
+  CHECK(union_node->isAll());
+  CHECK_GE(union_node->inputCount(), size_t(2));
+  // The children have already run as regular steps; stitch their result
+  // storage together instead of materializing the union into a new table.
+  ResultSetPtr union_rows;
+  std::vector<TargetMetaInfo> union_meta;
+  for (size_t i = 0; i < union_node->inputCount(); ++i) {
+    const auto input = union_node->getInput(i);
+    if (dynamic_cast<const RelScan*>(input)) {
+      throw std::runtime_error("UNION ALL of a bare table scan not supported yet");
+    }
+    const auto it = temporary_tables_.find(-input->getId());
+    CHECK(it != temporary_tables_.end());
+    const auto& input_meta = input->getOutputMetainfo();
+    if (!union_rows) {
+      union_rows = it->second;
+      union_meta = input_meta;
+      continue;
+    }
+    if (input_meta.size() != union_meta.size()) {
+      throw std::runtime_error("UNION ALL inputs must have the same column count");
+    }
+    for (size_t col_idx = 0; col_idx < union_meta.size(); ++col_idx) {
+      if (input_meta[col_idx].get_type_info() != union_meta[col_idx].get_type_info()) {
+        throw std::runtime_error("UNION ALL input column types don't match");
+      }
+    }
+    if (!(it->second->getQueryMemDesc() == union_rows->getQueryMemDesc())) {
+      throw std::runtime_error("UNION ALL input result layouts don't match");
+    }
+    union_rows->append(*it->second);
+  }
+  CHECK(union_rows);
+  union_rows->setQueueTime(queue_time_ms);
+  union_node->setOutputMetainfo(union_meta);
+  return {union_rows, union_meta};
+}
+
+ExecutionResult RelAlgExecutor::executeTableFunction(
+    const RelTableFunction* table_func_node,
+    const int64_t queue_time_ms) {
+  if (g_cluster) {
+    throw std::runtime_error("Table functions not supported in distributed mode yet");
+  }
+  const auto table_function =
+      TableFunctionRegistry::get(table_func_node->getFunctionName());
+  CHECK(table_function);
+  // The cursor arguments have already run as regular steps; convert their
+  // results to the columnar batch layout the table function consumes.
+  std::vector<std::unique_ptr<ColumnarResults>> columnar_inputs;
+  std::vector<TableFunctionInputBatch> input_batches;
+  std::vector<size_t> input_row_counts;
+  for (size_t i = 0; i < table_func_node->inputCount(); ++i) {
+    const auto input = table_func_node->getInput(i);
+    if (dynamic_cast<const RelScan*>(input)) {
+      throw std::runtime_error(
+          "Table functions over a bare table scan not supported yet");
+    }
+    const auto it = temporary_tables_.find(-input->getId());
+    CHECK(it != temporary_tables_.end());
+    const auto& input_meta = input->getOutputMetainfo();
+    std::vector<SQLTypeInfo> input_types;
+    for (const auto& input_meta_component : input_meta) {
+      input_types.push_back(input_meta_component.get_type_info());
+    }
+    auto columnar_input =
+        boost::make_unique<ColumnarResults>(executor_->getRowSetMemoryOwner(),
+                                            *it->second,
+                                            input_types.size(),
+                                            input_types);
+    input_batches.push_back(TableFunctionInputBatch{
+        columnar_input->getColumnBuffers(), input_types, columnar_input->size()});
+    input_row_counts.push_back(columnar_input->size());
+    columnar_inputs.push_back(std::move(columnar_input));
+  }
+  std::vector<int64_t> scalar_args;
+  for (size_t i = 0; i < table_func_node->getScalarInputsSize(); ++i) {
+    const auto scalar_input = table_func_node->getScalarInput(i);
+    if (scalar_input->getType() != kDECIMAL || scalar_input->getScale() != unsigned(0)) {
+      throw std::runtime_error(
+          "Only integer literal arguments are supported for table functions");
+    }
+    scalar_args.push_back(scalar_input->getVal<int64_t>());
+  }
+  const auto output_row_capacity =
+      table_function->output_row_capacity(input_row_counts, scalar_args);
+  // The output uses the columnar projection layout, one 8 byte slot per column
+  // and row, so downstream steps can consume it like any other result.
+  const auto& tuple_type = table_func_node->getTupleType();
+  QueryMemoryDescriptor query_mem_desc(
+      executor_, output_row_capacity, QueryDescriptionType::Projection);
+  query_mem_desc.setOutputColumnar(true);
+  for (size_t i = 0; i < tuple_type.size(); ++i) {
+    query_mem_desc.addColSlotInfo({std::make_tuple(8, 8)});
+  }
+  std::vector<TargetInfo> target_infos;
+  for (const auto& tuple_type_component : tuple_type) {
+    target_infos.emplace_back(TargetInfo{false,
+                                         kCOUNT,
+                                         tuple_type_component.get_type_info(),
+                                         SQLTypeInfo(kNULLT, false),
+                                         false,
+                                         false});
+  }
+  table_func_node->setOutputMetainfo(tuple_type);
+  auto rs = std::make_shared<ResultSet>(target_infos,
+                                        ExecutorDeviceType::CPU,
+                                        query_mem_desc,
+                                        executor_->getRowSetMemoryOwner(),
+                                        executor_);
+  if (output_row_capacity == 0) {
+    return {rs, tuple_type};
+  }
+  const auto storage = rs->allocateStorage();
+  auto buff = storage->getUnderlyingBuffer();
+  TableFunctionOutputBatch output_batch;
+  const auto& output_mem_desc = rs->getQueryMemDesc();
+  for (size_t i = 0; i < tuple_type.size(); ++i) {
+    output_batch.col_buffers.push_back(
+        reinterpret_cast<int64_t*>(buff + output_mem_desc.getColOffInBytes(i)));
+  }
+  output_batch.allocated_rows = output_row_capacity;
+  const auto output_row_count =
+      table_function->impl(input_batches, scalar_args, output_batch);
+  CHECK_LE(output_row_count, output_row_capacity);
+  // Emptiness of a columnar projection entry is tracked in the first output
+  // column, so mark the unused tail of the buffers accordingly.
+  const auto first_col_buffer = output_batch.col_buffers.front();
+  for (size_t row_idx = output_row_count; row_idx < output_row_capacity; ++row_idx) {
+    first_col_buffer[row_idx] = EMPTY_KEY_64;
+  }
+  rs->setQueueTime(queue_time_ms);
+  return {rs, tuple_type};
+}
+
 namespace {
 
 // TODO(alex): Once we're fully migrated to the relational algebra model, change
@@ -1842,6 +2061,109 @@ RelAlgExecutionUnit decide_approx_count_distinct_implementation(
   return ra_exe_unit;
 }
 
+std::shared_ptr<Analyzer::Expr> make_range_bound_qual(
+    const Analyzer::ColumnVar* phys_col,
+    const int64_t bound,
+    const SQLOps comparator) {
+  const auto& col_ti = phys_col->get_type_info();
+  Datum d;
+  d.bigintval = bound;
+  // A bound which does not fit the column type cannot be represented as a
+  // constant of that type; just skip it, the filter is only an optimization.
+  switch (col_ti.get_type()) {
+    case kTINYINT:
+      if (bound < std::numeric_limits<int8_t>::min() ||
+          bound > std::numeric_limits<int8_t>::max()) {
+        return nullptr;
+      }
+      d.tinyintval = bound;
+      break;
+    case kSMALLINT:
+      if (bound < std::numeric_limits<int16_t>::min() ||
+          bound > std::numeric_limits<int16_t>::max()) {
+        return nullptr;
+      }
+      d.smallintval = bound;
+      break;
+    case kINT:
+      if (bound < std::numeric_limits<int32_t>::min() ||
+          bound > std::numeric_limits<int32_t>::max()) {
+        return nullptr;
+      }
+      d.intval = bound;
+      break;
+    case kBIGINT:
+      break;
+    default:
+      return nullptr;
+  }
+  const auto bound_expr =
+      makeExpr<Analyzer::Constant>(SQLTypeInfo(col_ti.get_type(), true), false, d);
+  return makeExpr<Analyzer::BinOper>(
+      kBOOLEAN, comparator, kONE, phys_col->deep_copy(), bound_expr);
+}
+
+// Turn the ranges of completed upstream steps into filters on their physical
+// join partners. An equijoin against an intermediate result can only keep rows
+// whose key falls inside the range the previous step actually produced, so the
+// derived quals are redundant for correctness but let skipFragment() prune
+// fragments of the physical table and shrink downstream hash tables. Restricted
+// to inner joins: an outer join must keep unmatched rows of the preserved side.
+void propagate_intermediate_range_filters(
+    RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const Executor* executor) {
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    if (join_condition.type != JoinType::INNER) {
+      continue;
+    }
+    for (const auto& qual : join_condition.quals) {
+      const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual.get());
+      if (!bin_oper || bin_oper->get_optype() != kEQ) {
+        continue;
+      }
+      const auto lhs_col =
+          dynamic_cast<const Analyzer::ColumnVar*>(bin_oper->get_left_operand());
+      const auto rhs_col =
+          dynamic_cast<const Analyzer::ColumnVar*>(bin_oper->get_right_operand());
+      if (!lhs_col || !rhs_col) {
+        continue;
+      }
+      const Analyzer::ColumnVar* temp_col{nullptr};
+      const Analyzer::ColumnVar* phys_col{nullptr};
+      if (lhs_col->get_table_id() < 0 && rhs_col->get_table_id() > 0) {
+        temp_col = lhs_col;
+        phys_col = rhs_col;
+      } else if (rhs_col->get_table_id() < 0 && lhs_col->get_table_id() > 0) {
+        temp_col = rhs_col;
+        phys_col = lhs_col;
+      } else {
+        continue;
+      }
+      if (!phys_col->get_type_info().is_integer()) {
+        continue;
+      }
+      // The intermediate range comes from the result set metadata synthesized
+      // for the temporary table, the same source computeColRangesCache uses
+      // for physical inputs.
+      const auto temp_range = getExpressionRange(temp_col, table_infos, executor);
+      if (temp_range.getType() != ExpressionRangeType::Integer ||
+          temp_range.getIntMin() > temp_range.getIntMax()) {
+        continue;
+      }
+      const auto min_qual =
+          make_range_bound_qual(phys_col, temp_range.getIntMin(), kGE);
+      const auto max_qual =
+          make_range_bound_qual(phys_col, temp_range.getIntMax(), kLE);
+      if (!min_qual || !max_qual) {
+        continue;
+      }
+      ra_exe_unit.simple_quals.push_back(min_qual);
+      ra_exe_unit.simple_quals.push_back(max_qual);
+    }
+  }
+}
+
 void build_render_targets(
     RenderInfo& render_info,
     const std::vector<Analyzer::Expr*>& work_unit_target_exprs,
@@ -1873,8 +2195,330 @@ void build_render_targets(
   }
 }
 
+const size_t max_cacheable_result_rows{100000};
+
+bool work_unit_is_cacheable(const RelAlgExecutionUnit& ra_exe_unit,
+                            const ExecutionOptions& eo,
+                            const RenderInfo* render_info) {
+  if (eo.just_explain || eo.just_validate || eo.just_calcite_explain || render_info) {
+    return false;
+  }
+  if (g_cluster || ra_exe_unit.estimator || is_window_execution_unit(ra_exe_unit)) {
+    return false;
+  }
+  for (const auto& input_desc : ra_exe_unit.input_descs) {
+    // Temporary tables have no generations to key the entry on.
+    if (input_desc.getSourceType() != InputSourceType::TABLE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Fingerprints the execution unit together with the generations and epochs of
+// all inputs. Any append to an input table or string dictionary changes the
+// generations and any checkpointed DML commit - updates and deletes rewrite
+// rows without changing the tuple count - advances the table epoch, so a hit
+// is only possible while every input is unchanged.
+std::string result_cache_key(const RelAlgExecutionUnit& ra_exe_unit,
+                             const CompilationOptions& co,
+                             const TableGenerations& table_generations,
+                             const StringDictionaryGenerations& dict_generations,
+                             const Catalog_Namespace::Catalog& cat) {
+  const auto db_id = cat.getCurrentDB().dbId;
+  std::ostringstream os;
+  os << db_id << "|" << static_cast<int>(co.device_type_);
+  os << "|";
+  for (const auto& input_desc : ra_exe_unit.input_descs) {
+    os << input_desc.getTableId() << ":" << input_desc.getNestLevel() << ":"
+       << (input_desc.getTableId() > 0
+               ? cat.getTableEpoch(db_id, input_desc.getTableId())
+               : -1)
+       << ",";
+  }
+  os << "|";
+  for (const auto& input_col_desc : ra_exe_unit.input_col_descs) {
+    os << input_col_desc->getScanDesc().getTableId() << ":"
+       << input_col_desc->getColId() << ",";
+  }
+  for (const auto& qual : ra_exe_unit.simple_quals) {
+    os << "|" << qual->toString();
+  }
+  for (const auto& qual : ra_exe_unit.quals) {
+    os << "|" << qual->toString();
+  }
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    os << "|" << static_cast<int>(join_condition.type);
+    for (const auto& qual : join_condition.quals) {
+      os << qual->toString();
+    }
+  }
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    os << "|" << (groupby_expr ? groupby_expr->toString() : "NULL");
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    os << "|" << target_expr->toString();
+  }
+  for (const auto& order_entry : ra_exe_unit.sort_info.order_entries) {
+    os << "|" << order_entry.tle_no << ":" << order_entry.is_desc << ":"
+       << order_entry.nulls_first;
+  }
+  os << "|" << ra_exe_unit.sort_info.limit << ":" << ra_exe_unit.sort_info.offset << ":"
+     << ra_exe_unit.scan_limit;
+  // Order the generation maps so equal contents always print the same key.
+  const std::map<uint32_t, TableGeneration> ordered_table_generations(
+      table_generations.asMap().begin(), table_generations.asMap().end());
+  for (const auto& table_generation : ordered_table_generations) {
+    os << "|" << table_generation.first << ":"
+       << table_generation.second.tuple_count << ":"
+       << table_generation.second.start_rowid;
+  }
+  const std::map<uint32_t, size_t> ordered_dict_generations(
+      dict_generations.asMap().begin(), dict_generations.asMap().end());
+  for (const auto& dict_generation : ordered_dict_generations) {
+    os << "|" << dict_generation.first << ":" << dict_generation.second;
+  }
+  return os.str();
+}
+
+// Sums the step's input volume for the device cost model: total rows, total
+// chunk bytes and the subset of those bytes already resident in GPU memory.
+// Intermediate (negative table id) inputs have no physical chunks; they are
+// CPU resident by construction and counted as transfer bytes for the GPU.
+void compute_input_volume(const RelAlgExecutionUnit& ra_exe_unit,
+                          const std::vector<InputTableInfo>& table_infos,
+                          const Catalog_Namespace::Catalog& cat,
+                          size_t& input_rows,
+                          size_t& input_bytes,
+                          size_t& gpu_resident_bytes) {
+  input_rows = 0;
+  input_bytes = 0;
+  gpu_resident_bytes = 0;
+  auto& data_mgr = cat.getDataMgr();
+  const int gpu_count =
+      data_mgr.gpusPresent() ? data_mgr.getCudaMgr()->getDeviceCount() : 0;
+  for (const auto& table_info : table_infos) {
+    input_rows += table_info.info.getNumTuples();
+  }
+  for (const auto& input_col_desc : ra_exe_unit.input_col_descs) {
+    const auto table_id = input_col_desc->getScanDesc().getTableId();
+    const auto col_id = input_col_desc->getColId();
+    for (const auto& table_info : table_infos) {
+      if (table_info.table_id != table_id) {
+        continue;
+      }
+      for (const auto& fragment : table_info.info.fragments) {
+        const auto& metadata_map = fragment.getChunkMetadataMapPhysical();
+        const auto meta_it = metadata_map.find(col_id);
+        if (meta_it == metadata_map.end()) {
+          continue;
+        }
+        input_bytes += meta_it->second.numBytes;
+        if (table_id < 0) {
+          continue;
+        }
+        const ChunkKey chunk_key{
+            cat.getCurrentDB().dbId, table_id, col_id, fragment.fragmentId};
+        for (int device_id = 0; device_id < gpu_count; ++device_id) {
+          if (data_mgr.isBufferOnDevice(
+                  chunk_key, Data_Namespace::GPU_LEVEL, device_id)) {
+            gpu_resident_bytes += meta_it->second.numBytes;
+            break;
+          }
+        }
+      }
+      break;
+    }
+  }
+}
+
 }  // namespace
 
+// Answers unfiltered COUNT(*), MIN and MAX over a single physical table straight
+// from fragment metadata instead of launching a scan: the fragmenter already
+// keeps the exact tuple count per fragment and min/max stats per chunk, so these
+// queries reduce to a merge over the metadata the executor would otherwise only
+// use for fragment skipping. Returns nullptr whenever the query shape or the
+// table state disqualifies the shortcut, in which case the caller proceeds down
+// the regular execution path.
+ResultSetPtr RelAlgExecutor::tryMetadataOnlyAggregate(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos) {
+  if (ra_exe_unit.input_descs.size() != size_t(1) || table_infos.size() != size_t(1) ||
+      !ra_exe_unit.simple_quals.empty() || !ra_exe_unit.quals.empty() ||
+      !ra_exe_unit.join_quals.empty() || ra_exe_unit.estimator) {
+    return nullptr;
+  }
+  if (ra_exe_unit.groupby_exprs.size() != size_t(1) ||
+      ra_exe_unit.groupby_exprs.front()) {
+    return nullptr;
+  }
+  const auto table_id = ra_exe_unit.input_descs.front().getTableId();
+  if (table_id <= 0) {
+    // Intermediate results only carry synthesized metadata, physical tables only.
+    return nullptr;
+  }
+  std::vector<TargetInfo> target_infos;
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+    if (!agg_expr || agg_expr->get_is_distinct()) {
+      return nullptr;
+    }
+    switch (agg_expr->get_aggtype()) {
+      case kCOUNT:
+        if (agg_expr->get_arg()) {
+          // COUNT(col) skips nulls and the stats only record whether nulls exist.
+          return nullptr;
+        }
+        break;
+      case kMIN:
+      case kMAX: {
+        const auto col_var =
+            dynamic_cast<const Analyzer::ColumnVar*>(agg_expr->get_arg());
+        if (!col_var) {
+          return nullptr;
+        }
+        const auto& arg_ti = col_var->get_type_info();
+        // Chunk stats order dictionary encoded strings by id, not by value, so
+        // only numeric, time and decimal columns qualify.
+        if (arg_ti.is_string() || !(arg_ti.is_number() || arg_ti.is_time())) {
+          return nullptr;
+        }
+        break;
+      }
+      default:
+        return nullptr;
+    }
+    auto target_info = get_target_info(target_expr, g_bigint_count);
+    // MIN and MAX read out as null when the table is empty or every row is
+    // null, whatever the column's declared nullability says.
+    target_info.sql_type.set_notnull(false);
+    if (target_info.agg_arg_type.get_type() != kNULLT) {
+      target_info.agg_arg_type.set_notnull(false);
+    }
+    target_infos.push_back(target_info);
+  }
+  if (target_infos.empty()) {
+    return nullptr;
+  }
+  const auto td = cat_.getMetadataForTable(table_id);
+  if (!td) {
+    return nullptr;
+  }
+  const auto deleted_cd = td->hasDeletedCol ? cat_.getDeletedColumn(td) : nullptr;
+  const auto& fragments = table_infos.front().info.fragments;
+  size_t row_count = 0;
+  for (const auto& fragment : fragments) {
+    // An update widens chunk stats into bounds instead of exact extremes and a
+    // delete leaves the dropped rows in the tuple counts; either way the
+    // metadata no longer answers exactly, so such tables take the regular path
+    // until OPTIMIZE TABLE recomputes their metadata.
+    if (fragment.isMetadataDirty()) {
+      return nullptr;
+    }
+    if (deleted_cd) {
+      const auto& metadata_map = fragment.getChunkMetadataMapPhysical();
+      const auto deleted_it = metadata_map.find(deleted_cd->columnId);
+      if (deleted_it == metadata_map.end() ||
+          deleted_it->second.chunkStats.max.tinyintval == 1) {
+        return nullptr;
+      }
+    }
+    row_count += fragment.getPhysicalNumTuples();
+  }
+  std::vector<int64_t> entry;
+  for (size_t target_idx = 0; target_idx < target_infos.size(); ++target_idx) {
+    const auto& target_info = target_infos[target_idx];
+    if (target_info.agg_kind == kCOUNT) {
+      entry.push_back(static_cast<int64_t>(row_count));
+      continue;
+    }
+    const auto agg_expr =
+        dynamic_cast<const Analyzer::AggExpr*>(ra_exe_unit.target_exprs[target_idx]);
+    CHECK(agg_expr);
+    const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(agg_expr->get_arg());
+    CHECK(col_var);
+    const auto& arg_ti = col_var->get_type_info();
+    const bool float_argument_input = takes_float_argument(target_info);
+    // Encoders initialize their stats to the type's extremes, which makes a
+    // fragment with no non-null values an identity element of the merge; a
+    // merged minimum above the merged maximum therefore means a null result.
+    if (arg_ti.is_fp()) {
+      double min_val = std::numeric_limits<double>::max();
+      double max_val = std::numeric_limits<double>::lowest();
+      for (const auto& fragment : fragments) {
+        const auto& metadata_map = fragment.getChunkMetadataMapPhysical();
+        const auto meta_it = metadata_map.find(col_var->get_column_id());
+        if (meta_it == metadata_map.end()) {
+          return nullptr;
+        }
+        const auto& stats = meta_it->second.chunkStats;
+        if (arg_ti.get_type() == kFLOAT) {
+          min_val = std::min(min_val, static_cast<double>(stats.min.floatval));
+          max_val = std::max(max_val, static_cast<double>(stats.max.floatval));
+        } else {
+          min_val = std::min(min_val, stats.min.doubleval);
+          max_val = std::max(max_val, stats.max.doubleval);
+        }
+      }
+      if (min_val > max_val) {
+        if (float_argument_input) {
+          int64_t null_bits{0};
+          *reinterpret_cast<float*>(may_alias_ptr(&null_bits)) =
+              static_cast<float>(inline_fp_null_val(target_info.sql_type));
+          entry.push_back(null_bits);
+        } else {
+          const auto double_null = inline_fp_null_val(target_info.sql_type);
+          entry.push_back(
+              *reinterpret_cast<const int64_t*>(may_alias_ptr(&double_null)));
+        }
+      } else {
+        const double result_val = target_info.agg_kind == kMIN ? min_val : max_val;
+        if (float_argument_input) {
+          int64_t result_bits{0};
+          *reinterpret_cast<float*>(may_alias_ptr(&result_bits)) =
+              static_cast<float>(result_val);
+          entry.push_back(result_bits);
+        } else {
+          entry.push_back(
+              *reinterpret_cast<const int64_t*>(may_alias_ptr(&result_val)));
+        }
+      }
+    } else {
+      int64_t min_val = std::numeric_limits<int64_t>::max();
+      int64_t max_val = std::numeric_limits<int64_t>::min();
+      for (const auto& fragment : fragments) {
+        const auto& metadata_map = fragment.getChunkMetadataMapPhysical();
+        const auto meta_it = metadata_map.find(col_var->get_column_id());
+        if (meta_it == metadata_map.end()) {
+          return nullptr;
+        }
+        const auto& stats = meta_it->second.chunkStats;
+        min_val = std::min(min_val, extract_min_stat(stats, arg_ti));
+        max_val = std::max(max_val, extract_max_stat(stats, arg_ti));
+      }
+      if (min_val > max_val) {
+        entry.push_back(inline_int_null_val(target_info.sql_type));
+      } else {
+        entry.push_back(target_info.agg_kind == kMIN ? min_val : max_val);
+      }
+    }
+  }
+  QueryMemoryDescriptor query_mem_desc(
+      executor_, /*entry_count=*/1, QueryDescriptionType::NonGroupedAggregate);
+  for (size_t i = 0; i < target_infos.size(); ++i) {
+    query_mem_desc.addColSlotInfo({std::make_tuple(8, 8)});
+  }
+  auto rs = std::make_shared<ResultSet>(target_infos,
+                                        ExecutorDeviceType::CPU,
+                                        query_mem_desc,
+                                        executor_->getRowSetMemoryOwner(),
+                                        executor_);
+  rs->allocateStorage();
+  rs->fillOneEntry(entry);
+  return rs;
+}
+
 ExecutionResult RelAlgExecutor::executeWorkUnit(
     const RelAlgExecutor::WorkUnit& work_unit,
     const std::vector<TargetMetaInfo>& targets_meta,
@@ -1924,12 +2568,45 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
     return result;
   }
+
+  const bool use_result_cache = g_enable_query_result_cache && leaf_results_.empty() &&
+                                work_unit_is_cacheable(work_unit.exe_unit, eo, render_info);
+  std::string cache_key;
+  if (use_result_cache) {
+    cache_key = result_cache_key(work_unit.exe_unit,
+                                 co,
+                                 executor_->table_generations_,
+                                 executor_->string_dictionary_generations_,
+                                 cat_);
+    const auto cached_rows = QueryResultCache::instance().get(cache_key);
+    if (cached_rows) {
+      VLOG(1) << "Query result cache hit";
+      ExecutionResult cached_result(cached_rows, targets_meta);
+      cached_result.setQueueTime(queue_time_ms);
+      return cached_result;
+    }
+  }
   int32_t error_code{0};
 
   const auto table_infos = get_table_infos(work_unit.exe_unit, executor_);
 
+  if (g_enable_metadata_only_aggregates && !g_cluster && !eo.just_explain &&
+      !eo.just_validate && !render_info) {
+    const auto metadata_only_rows =
+        tryMetadataOnlyAggregate(work_unit.exe_unit, table_infos);
+    if (metadata_only_rows) {
+      VLOG(1) << "Aggregate answered from fragment metadata";
+      ExecutionResult metadata_only_result(metadata_only_rows, targets_meta);
+      metadata_only_result.setQueueTime(queue_time_ms);
+      return metadata_only_result;
+    }
+  }
+
   auto ra_exe_unit = decide_approx_count_distinct_implementation(
       work_unit.exe_unit, table_infos, executor_, co.device_type_, target_exprs_owned_);
+  if (g_enable_runtime_filter_propagation && !eo.just_explain) {
+    propagate_intermediate_range_filters(ra_exe_unit, table_infos, executor_);
+  }
   auto max_groups_buffer_entry_guess = work_unit.max_groups_buffer_entry_guess;
   if (is_window_execution_unit(ra_exe_unit)) {
     CHECK_EQ(table_infos.size(), size_t(1));
@@ -1949,6 +2626,26 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   }
 
+  size_t cost_model_input_rows{0};
+  if (g_enable_cost_based_device_selection &&
+      co.device_type_ == ExecutorDeviceType::GPU && !eo.just_explain &&
+      !eo.just_validate && !render_info) {
+    size_t input_bytes{0};
+    size_t gpu_resident_bytes{0};
+    compute_input_volume(ra_exe_unit,
+                         table_infos,
+                         cat_,
+                         cost_model_input_rows,
+                         input_bytes,
+                         gpu_resident_bytes);
+    if (DeviceCostModel::getInstance().chooseDeviceType(
+            cost_model_input_rows, input_bytes, gpu_resident_bytes) ==
+        ExecutorDeviceType::CPU) {
+      VLOG(1) << "Cost model picked CPU for this step";
+      co.device_type_ = ExecutorDeviceType::CPU;
+    }
+  }
+
   ExecutionResult result{std::make_shared<ResultSet>(std::vector<TargetInfo>{},
                                                      co.device_type_,
                                                      QueryMemoryDescriptor(),
@@ -1956,6 +2653,7 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
                                                      executor_),
                          {}};
 
+  auto exec_clock_begin = timer_start();
   try {
     result = {executor_->executeWorkUnit(
                   &error_code,
@@ -1990,6 +2688,10 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
                                          column_cache),
               targets_meta};
   }
+  if (g_enable_cost_based_device_selection && cost_model_input_rows && !error_code) {
+    DeviceCostModel::getInstance().recordExecution(
+        co.device_type_, cost_model_input_rows, timer_stop(exec_clock_begin));
+  }
 
   result.setQueueTime(queue_time_ms);
   if (render_info) {
@@ -2003,6 +2705,10 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   }
   if (!error_code) {
+    if (use_result_cache && result.getRows() &&
+        result.getRows()->rowCount() <= max_cacheable_result_rows) {
+      QueryResultCache::instance().put(cache_key, result.getRows());
+    }
     return result;
   }
   handlePersistentError(error_code);
@@ -2119,7 +2825,8 @@ ExecutionResult RelAlgExecutor::handleRetry(
                                    eo.dynamic_watchdog_time_limit,
                                    false,
                                    false,
-                                   eo.gpu_input_mem_limit_percent};
+                                   eo.gpu_input_mem_limit_percent,
+                                   eo.low_priority};
   ExecutionResult result{std::make_shared<ResultSet>(std::vector<TargetInfo>{},
                                                      co.device_type_,
                                                      QueryMemoryDescriptor(),
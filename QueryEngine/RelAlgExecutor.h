@@ -209,6 +209,9 @@ class RelAlgExecutor : private StorageIOFacility<RelAlgExecutorTraits> {
 
   ExecutionResult executeLogicalValues(const RelLogicalValues*, const ExecutionOptions&);
   ExecutionResult executeModify(const RelModify* modify, const ExecutionOptions& eo);
+  ExecutionResult executeUnion(const RelLogicalUnion*, const int64_t queue_time_ms);
+  ExecutionResult executeTableFunction(const RelTableFunction*,
+                                       const int64_t queue_time_ms);
 
   // TODO(alex): just move max_groups_buffer_entry_guess to RelAlgExecutionUnit once
   //             we deprecate the plan-based executor paths and remove WorkUnit
@@ -232,6 +235,9 @@ class RelAlgExecutor : private StorageIOFacility<RelAlgExecutorTraits> {
                                   const int64_t queue_time_ms,
                                   const ssize_t previous_count = -1);
 
+  ResultSetPtr tryMetadataOnlyAggregate(const RelAlgExecutionUnit& ra_exe_unit,
+                                        const std::vector<InputTableInfo>& table_infos);
+
   size_t getNDVEstimation(const WorkUnit& work_unit,
                           const bool is_agg,
                           const CompilationOptions& co,
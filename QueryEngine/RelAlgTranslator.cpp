@@ -28,6 +28,7 @@
 #include "WindowContext.h"
 
 #include <future>
+#include <sstream>
 #include "../Analyzer/Analyzer.h"
 #include "../Parser/ParserNode.h"
 #include "../Shared/likely.h"
@@ -159,10 +160,102 @@ std::pair<Datum, bool> datum_from_scalar_tv(const ScalarTargetValue* scalar_tv,
   return {d, is_null_const};
 }
 
+// Builds a structural key for memoizing translations. RexScalar::toString is
+// not fidelity-preserving enough for this purpose (it omits operator result
+// types, so e.g. casts of one operand to two different types would collide),
+// hence the explicit encoding. Returns false for node kinds we never memoize:
+// window functions are registered per expression instance and sub-queries
+// carry their own execution results.
+bool append_translation_key(const RexScalar* rex, std::ostringstream& os) {
+  const auto rex_input = dynamic_cast<const RexInput*>(rex);
+  if (rex_input) {
+    os << "in:" << rex_input->getIndex() << "@" << rex_input->getSourceNode();
+    return true;
+  }
+  const auto rex_literal = dynamic_cast<const RexLiteral*>(rex);
+  if (rex_literal) {
+    os << "lit:" << rex_literal->toString() << ":" << rex_literal->getType() << ","
+       << rex_literal->getTargetType() << "," << rex_literal->getScale() << ","
+       << rex_literal->getPrecision() << "," << rex_literal->getTypeScale() << ","
+       << rex_literal->getTypePrecision();
+    return true;
+  }
+  if (dynamic_cast<const RexWindowFunctionOperator*>(rex) ||
+      dynamic_cast<const RexSubQuery*>(rex)) {
+    return false;
+  }
+  const auto rex_case = dynamic_cast<const RexCase*>(rex);
+  if (rex_case) {
+    os << "case(";
+    for (size_t i = 0; i < rex_case->branchCount(); ++i) {
+      if (!append_translation_key(rex_case->getWhen(i), os)) {
+        return false;
+      }
+      os << "->";
+      if (!append_translation_key(rex_case->getThen(i), os)) {
+        return false;
+      }
+      os << ";";
+    }
+    if (rex_case->getElse()) {
+      os << "else:";
+      if (!append_translation_key(rex_case->getElse(), os)) {
+        return false;
+      }
+    }
+    os << ")";
+    return true;
+  }
+  const auto rex_operator = dynamic_cast<const RexOperator*>(rex);
+  if (rex_operator) {
+    const auto rex_function = dynamic_cast<const RexFunctionOperator*>(rex);
+    if (rex_function) {
+      os << "fn:" << rex_function->getName();
+    } else {
+      os << "op:" << rex_operator->getOperator();
+    }
+    const auto& ti = rex_operator->getType();
+    os << "/" << ti.get_type() << "," << ti.get_subtype() << "," << ti.get_dimension()
+       << "," << ti.get_scale() << "," << ti.get_notnull() << ","
+       << ti.get_compression() << "," << ti.get_comp_param() << "(";
+    for (size_t i = 0; i < rex_operator->size(); ++i) {
+      if (!append_translation_key(rex_operator->getOperand(i), os)) {
+        return false;
+      }
+      os << ";";
+    }
+    os << ")";
+    return true;
+  }
+  return false;
+}
+
 }  // namespace
 
+bool g_enable_expression_interning{false};
+
 std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateScalarRex(
     const RexScalar* rex) const {
+  std::string cache_key;
+  if (g_enable_expression_interning) {
+    std::ostringstream key_stream;
+    if (append_translation_key(rex, key_stream)) {
+      cache_key = key_stream.str();
+      const auto it = translation_cache_.find(cache_key);
+      if (it != translation_cache_.end()) {
+        return it->second;
+      }
+    }
+  }
+  auto result = translateScalarRexImpl(rex);
+  if (!cache_key.empty()) {
+    translation_cache_.emplace(cache_key, result);
+  }
+  return result;
+}
+
+std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateScalarRexImpl(
+    const RexScalar* rex) const {
   const auto rex_input = dynamic_cast<const RexInput*>(rex);
   if (rex_input) {
     return translateInput(rex_input);
@@ -218,6 +311,47 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateAggregateRex(
             "1 and 100");
       }
     }
+    if (agg_kind == kAPPROX_TOP_K) {
+      if (rex->size() != 2) {
+        throw std::runtime_error(
+            "APPROX_TOP_K requires two arguments, the column and k");
+      }
+      // k rides the same literal operand slot as the APPROX_COUNT_DISTINCT
+      // error rate.
+      err_rate = std::dynamic_pointer_cast<Analyzer::Constant>(
+          scalar_sources[rex->getOperand(1)]);
+      if (!err_rate || err_rate->get_type_info().get_type() != kINT ||
+          err_rate->get_constval().intval < 1 ||
+          err_rate->get_constval().intval > 1000) {
+        throw std::runtime_error(
+            "APPROX_TOP_K's second parameter should be an INTEGER literal between 1 "
+            "and 1000");
+      }
+    }
+  }
+  if (agg_kind == kAPPROX_MEDIAN) {
+    if (g_cluster) {
+      throw std::runtime_error("APPROX_MEDIAN not supported in distributed mode yet");
+    }
+    CHECK(arg_expr);
+    const auto& arg_ti = arg_expr->get_type_info();
+    if (!arg_ti.is_number() || arg_ti.is_decimal()) {
+      throw std::runtime_error(
+          "APPROX_MEDIAN is only supported on integer and floating point columns");
+    }
+  }
+  if (agg_kind == kAPPROX_TOP_K) {
+    if (g_cluster) {
+      throw std::runtime_error("APPROX_TOP_K not supported in distributed mode yet");
+    }
+    CHECK(arg_expr);
+    const auto& arg_ti = arg_expr->get_type_info();
+    if (!arg_ti.is_integer() && !arg_ti.is_time() &&
+        !(arg_ti.is_string() && arg_ti.get_compression() == kENCODING_DICT)) {
+      throw std::runtime_error(
+          "APPROX_TOP_K is only supported on integer, timestamp and dictionary "
+          "encoded string columns");
+    }
   }
   const auto agg_ti = get_agg_type(agg_kind, arg_expr.get());
   return makeExpr<Analyzer::AggExpr>(agg_ti, agg_kind, arg_expr, is_distinct, err_rate);
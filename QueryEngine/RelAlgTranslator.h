@@ -62,6 +62,8 @@ class RelAlgTranslator {
       const std::vector<std::shared_ptr<Analyzer::Expr>>& scalar_sources);
 
  private:
+  std::shared_ptr<Analyzer::Expr> translateScalarRexImpl(const RexScalar* rex) const;
+
   static std::shared_ptr<Analyzer::Expr> translateLiteral(const RexLiteral*);
 
   std::shared_ptr<Analyzer::Expr> translateScalarSubquery(const RexSubQuery*) const;
@@ -171,6 +173,11 @@ class RelAlgTranslator {
   time_t now_;
   const bool just_explain_;
   QueryFeatureDescriptor& feature_stash_;
+  // Memoized translations keyed by the structural form of the Rex tree, so
+  // repeated subexpressions share one Analyzer::Expr instance instead of
+  // being re-translated for every occurrence.
+  mutable std::unordered_map<std::string, std::shared_ptr<Analyzer::Expr>>
+      translation_cache_;
 };
 
 struct QualsConjunctiveForm {
@@ -40,6 +40,11 @@
 #include <bitset>
 #include <future>
 #include <numeric>
+#include <queue>
+
+bool g_enable_parallel_result_set_sort{false};
+bool g_enable_external_sort{false};
+size_t g_external_sort_run_budget{128 * 1024 * 1024};
 
 ResultSetStorage::ResultSetStorage(const std::vector<TargetInfo>& targets,
                                    const QueryMemoryDescriptor& query_mem_desc,
@@ -51,7 +56,9 @@ ResultSetStorage::ResultSetStorage(const std::vector<TargetInfo>& targets,
     , buff_is_provided_(buff_is_provided) {
   for (const auto& target_info : targets_) {
     if (target_info.agg_kind == kCOUNT ||
-        target_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
+        target_info.agg_kind == kAPPROX_COUNT_DISTINCT ||
+        target_info.agg_kind == kAPPROX_MEDIAN ||
+        target_info.agg_kind == kAPPROX_TOP_K) {
       target_init_vals_.push_back(0);
       continue;
     }
@@ -423,6 +430,14 @@ int64_t ResultSet::getQueueTime() const {
   return queue_time_ms_;
 }
 
+void ResultSet::setFractionSampled(const double fraction_sampled) {
+  fraction_sampled_ = fraction_sampled;
+}
+
+double ResultSet::getFractionSampled() const {
+  return fraction_sampled_;
+}
+
 int64_t ResultSet::getRenderTime() const {
   return render_time_ms_;
 }
@@ -494,16 +509,26 @@ void ResultSet::sort(const std::list<Analyzer::OrderEntry>& order_entries,
     return;
   }
 
-  if (g_enable_watchdog && (entryCount() > Executor::baseline_threshold)) {
+  if (g_enable_watchdog && !g_enable_external_sort &&
+      (entryCount() > Executor::baseline_threshold)) {
     throw WatchdogException("Sorting the result would be too slow");
   }
 
   permutation_ = initPermutationBuffer(0, 1);
 
+  if (!use_heap && g_enable_parallel_result_set_sort &&
+      canUseParallelKeySort(order_entries)) {
+    parallelSortPermutation(order_entries.front());
+    return;
+  }
+
   auto compare = createComparator(order_entries, use_heap);
 
   if (use_heap) {
     topPermutation(permutation_, top_n, compare);
+  } else if (g_enable_external_sort &&
+             permutation_.size() * sizeof(uint32_t) > g_external_sort_run_budget) {
+    externalSortPermutation(compare);
   } else {
     sortPermutation(compare);
   }
@@ -760,6 +785,237 @@ void ResultSet::sortPermutation(
   std::sort(permutation_.begin(), permutation_.end(), compare);
 }
 
+void ResultSet::externalSortPermutation(
+    const std::function<bool(const uint32_t, const uint32_t)> compare) {
+  const size_t run_entries = std::max(g_external_sort_run_budget / sizeof(uint32_t),
+                                      static_cast<size_t>(1) << 20);
+  const size_t num_runs = (permutation_.size() + run_entries - 1) / run_entries;
+  std::vector<std::future<void>> sort_futures;
+  for (size_t run = 0; run < num_runs; ++run) {
+    sort_futures.emplace_back(
+        std::async(std::launch::async, [this, run, run_entries, num_runs, &compare] {
+          const auto run_begin = permutation_.begin() + run * run_entries;
+          const auto run_end =
+              run + 1 == num_runs ? permutation_.end() : run_begin + run_entries;
+          std::sort(run_begin, run_end, compare);
+        }));
+  }
+  for (auto& sort_future : sort_futures) {
+    sort_future.wait();
+  }
+  for (auto& sort_future : sort_futures) {
+    sort_future.get();
+  }
+  if (num_runs < 2) {
+    return;
+  }
+  // Stream a k-way merge of the sorted runs; the heap holds each run's next
+  // entry, ordered by the same comparator.
+  const auto run_end_position = [this, run_entries](const size_t run) {
+    return std::min((run + 1) * run_entries, permutation_.size());
+  };
+  std::vector<size_t> run_positions(num_runs);
+  using RunHead = std::pair<uint32_t, size_t>;  // permutation entry, run index
+  const auto heap_compare = [&compare](const RunHead& lhs, const RunHead& rhs) {
+    return compare(rhs.first, lhs.first);
+  };
+  std::priority_queue<RunHead, std::vector<RunHead>, decltype(heap_compare)> run_heap(
+      heap_compare);
+  for (size_t run = 0; run < num_runs; ++run) {
+    run_positions[run] = run * run_entries;
+    if (run_positions[run] < run_end_position(run)) {
+      run_heap.emplace(permutation_[run_positions[run]++], run);
+    }
+  }
+  std::vector<uint32_t> merged;
+  merged.reserve(permutation_.size());
+  while (!run_heap.empty()) {
+    const auto run_head = run_heap.top();
+    run_heap.pop();
+    merged.push_back(run_head.first);
+    const auto run = run_head.second;
+    if (run_positions[run] < run_end_position(run)) {
+      run_heap.emplace(permutation_[run_positions[run]++], run);
+    }
+  }
+  permutation_.swap(merged);
+}
+
+namespace {
+
+// A permutation entry with its sort key extracted once, so sorting compares
+// plain integers instead of re-reading the result set per comparison. The key
+// is transformed so that unsigned ascending order matches the requested ORDER
+// BY direction; null_rank places nulls at the requested end independently of
+// the key domain.
+struct KeyedPermutationEntry {
+  uint64_t key;
+  uint32_t entry_idx;
+  uint8_t null_rank;
+};
+
+inline bool keyed_permutation_less(const KeyedPermutationEntry& lhs,
+                                   const KeyedPermutationEntry& rhs) {
+  return lhs.null_rank != rhs.null_rank ? lhs.null_rank < rhs.null_rank
+                                        : lhs.key < rhs.key;
+}
+
+}  // namespace
+
+bool ResultSet::canUseParallelKeySort(
+    const std::list<Analyzer::OrderEntry>& order_entries) const {
+  if (order_entries.size() != 1) {
+    return false;
+  }
+  const auto& order_entry = order_entries.front();
+  CHECK_GE(order_entry.tle_no, 1);
+  const auto& target_info = targets_[order_entry.tle_no - 1];
+  if (is_distinct_target(target_info) || target_info.agg_kind == kAVG) {
+    return false;
+  }
+  // Dictionary encoded strings order by the payload string, not the id.
+  const auto& entry_ti = get_compact_type(target_info);
+  return entry_ti.is_number() || entry_ti.is_time() || entry_ti.is_boolean();
+}
+
+void ResultSet::parallelSortPermutation(const Analyzer::OrderEntry& order_entry) {
+  if (query_mem_desc_.didOutputColumnar()) {
+    doParallelSortPermutation(ColumnWiseTargetAccessor(this), order_entry);
+  } else {
+    doParallelSortPermutation(RowWiseTargetAccessor(this), order_entry);
+  }
+}
+
+template <typename BUFFER_ITERATOR_TYPE>
+void ResultSet::doParallelSortPermutation(const BUFFER_ITERATOR_TYPE& buffer_itr,
+                                          const Analyzer::OrderEntry& order_entry) {
+  const auto& target_info = targets_[order_entry.tle_no - 1];
+  const auto entry_ti = get_compact_type(target_info);
+  bool float_argument_input = takes_float_argument(target_info);
+  // Mirrors the float width resolution in ResultSetComparator::operator().
+  if (entry_ti.get_type() == kFLOAT) {
+    const auto is_col_lazy = !lazy_fetch_info_.empty() &&
+                             lazy_fetch_info_[order_entry.tle_no - 1].is_lazily_fetched;
+    if (query_mem_desc_.getPaddedSlotWidthBytes(order_entry.tle_no - 1) ==
+        sizeof(float)) {
+      float_argument_input = query_mem_desc_.didOutputColumnar() ? !is_col_lazy : true;
+    }
+  }
+  const uint8_t null_rank = order_entry.nulls_first ? 0 : 2;
+  const auto entry_count = permutation_.size();
+  std::vector<KeyedPermutationEntry> keyed_permutation(entry_count);
+  const size_t worker_count = cpu_threads();
+  const auto stride = (entry_count + worker_count - 1) / worker_count;
+  std::vector<size_t> chunk_offsets{0};
+  std::vector<std::future<void>> extraction_threads;
+  for (size_t start = 0; start < entry_count; start += stride) {
+    const auto end = std::min(start + stride, entry_count);
+    chunk_offsets.push_back(end);
+    extraction_threads.push_back(std::async(
+        std::launch::async,
+        [this,
+         &buffer_itr,
+         &keyed_permutation,
+         &order_entry,
+         &entry_ti,
+         float_argument_input,
+         null_rank](const size_t start, const size_t end) {
+          for (size_t i = start; i < end; ++i) {
+            const auto entry_idx = permutation_[i];
+            const auto storage_lookup_result = findStorage(entry_idx);
+            const auto v =
+                buffer_itr.getColumnInternal(storage_lookup_result.storage_ptr->buff_,
+                                             storage_lookup_result.fixedup_entry_idx,
+                                             order_entry.tle_no - 1,
+                                             storage_lookup_result);
+            auto& keyed_entry = keyed_permutation[i];
+            keyed_entry.entry_idx = entry_idx;
+            if (isNull(entry_ti, v, float_argument_input)) {
+              keyed_entry.key = 0;
+              keyed_entry.null_rank = null_rank;
+              continue;
+            }
+            keyed_entry.null_rank = 1;
+            uint64_t key;
+            if (entry_ti.is_fp()) {
+              if (float_argument_input) {
+                const auto u = static_cast<uint32_t>(v.i1);
+                key = (u & 0x80000000U) ? ~u : (u | 0x80000000U);
+              } else {
+                const auto u = static_cast<uint64_t>(v.i1);
+                key = (u & 0x8000000000000000ULL) ? ~u : (u | 0x8000000000000000ULL);
+              }
+            } else {
+              key = static_cast<uint64_t>(v.i1) ^ 0x8000000000000000ULL;
+            }
+            keyed_entry.key = order_entry.is_desc ? ~key : key;
+          }
+        },
+        start,
+        end));
+  }
+  for (auto& child : extraction_threads) {
+    child.wait();
+  }
+  for (auto& child : extraction_threads) {
+    child.get();
+  }
+
+  std::vector<std::future<void>> sort_threads;
+  for (size_t i = 0; i + 1 < chunk_offsets.size(); ++i) {
+    sort_threads.push_back(std::async(
+        std::launch::async,
+        [&keyed_permutation](const size_t start, const size_t end) {
+          std::sort(keyed_permutation.begin() + start,
+                    keyed_permutation.begin() + end,
+                    keyed_permutation_less);
+        },
+        chunk_offsets[i],
+        chunk_offsets[i + 1]));
+  }
+  for (auto& child : sort_threads) {
+    child.wait();
+  }
+  for (auto& child : sort_threads) {
+    child.get();
+  }
+
+  // Merge adjacent runs pairwise until a single sorted run remains.
+  while (chunk_offsets.size() > 2) {
+    std::vector<size_t> merged_offsets{chunk_offsets.front()};
+    std::vector<std::future<void>> merge_threads;
+    size_t i = 0;
+    for (; i + 2 < chunk_offsets.size(); i += 2) {
+      merge_threads.push_back(std::async(
+          std::launch::async,
+          [&keyed_permutation](const size_t start, const size_t mid, const size_t end) {
+            std::inplace_merge(keyed_permutation.begin() + start,
+                               keyed_permutation.begin() + mid,
+                               keyed_permutation.begin() + end,
+                               keyed_permutation_less);
+          },
+          chunk_offsets[i],
+          chunk_offsets[i + 1],
+          chunk_offsets[i + 2]));
+      merged_offsets.push_back(chunk_offsets[i + 2]);
+    }
+    if (merged_offsets.back() != chunk_offsets.back()) {
+      merged_offsets.push_back(chunk_offsets.back());
+    }
+    for (auto& child : merge_threads) {
+      child.wait();
+    }
+    for (auto& child : merge_threads) {
+      child.get();
+    }
+    chunk_offsets.swap(merged_offsets);
+  }
+
+  for (size_t i = 0; i < entry_count; ++i) {
+    permutation_[i] = keyed_permutation[i].entry_idx;
+  }
+}
+
 void ResultSet::radixSortOnGpu(
     const std::list<Analyzer::OrderEntry>& order_entries) const {
   auto data_mgr = &executor_->catalog_->getDataMgr();
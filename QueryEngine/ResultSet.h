@@ -36,6 +36,7 @@
 #include <atomic>
 #include <functional>
 #include <list>
+#include <unordered_map>
 
 /*
  * Stores the underlying buffer and the meta-data for a result set. The buffer
@@ -186,6 +187,10 @@ class ResultSetStorage {
                                   const size_t target_logical_idx,
                                   const ResultSetStorage& that) const;
 
+  void reduceOneApproxMedianSlot(int8_t* this_ptr1, const int8_t* that_ptr1) const;
+
+  void reduceOneApproxTopKSlot(int8_t* this_ptr1, const int8_t* that_ptr1) const;
+
   void fillOneEntryRowWise(const std::vector<int64_t>& entry);
 
   void fillOneEntryColWise(const std::vector<int64_t>& entry);
@@ -245,6 +250,8 @@ struct ArrowResult {
   int8_t* df_dev_ptr;  // Only for device memory deallocation
 };
 
+extern size_t g_arrow_stream_export_batch_rows;
+
 void deallocate_arrow_result(const ArrowResult& result,
                              const ExecutorDeviceType device_type,
                              const size_t device_id,
@@ -440,6 +447,12 @@ class ResultSet {
 
   int64_t getQueueTime() const;
 
+  // Fraction of the input tuples scanned when fragment sampling was active,
+  // 1.0 for exact results.
+  void setFractionSampled(const double fraction_sampled);
+
+  double getFractionSampled() const;
+
   int64_t getRenderTime() const;
 
   void moveToBegin() const;
@@ -498,6 +511,14 @@ class ResultSet {
       const std::vector<std::string>& col_names,
       const int32_t first_n) const;
 
+  // Serializes the rows as an Arrow IPC stream of record batches of at most
+  // max_batch_rows rows; the batches are zero-copy slices of the converted
+  // columns.
+  SerializedArrowOutput getSerializedArrowStream(
+      const std::vector<std::string>& col_names,
+      const int32_t first_n,
+      const size_t max_batch_rows) const;
+
   ArrowResult getArrowCopy(Data_Namespace::DataMgr* data_mgr,
                            const ExecutorDeviceType device_type,
                            const size_t device_id,
@@ -525,6 +546,11 @@ class ResultSet {
                             int8_t* output_buffer,
                             const size_t output_buffer_size) const;
 
+  void copyColumnRangeIntoBuffer(const size_t column_idx,
+                                 const size_t start_row,
+                                 const size_t num_rows,
+                                 int8_t* output_buffer) const;
+
   /*
    * Determines if it is possible to directly form a ColumnarResults class from this
    * result set, bypassing the default row-wise columnarization. It is currently only
@@ -759,6 +785,26 @@ class ResultSet {
 
   void sortPermutation(const std::function<bool(const uint32_t, const uint32_t)> compare);
 
+  // Merge sort of the permutation buffer for results past the run budget:
+  // bounded-size runs are sorted in parallel, then a k-way heap merge streams
+  // them into the final order. Keeps huge ORDER BY queries off the single
+  // monolithic std::sort the watchdog would otherwise reject.
+  void externalSortPermutation(
+      const std::function<bool(const uint32_t, const uint32_t)> compare);
+
+  // Parallel sort of the permutation buffer for a single numeric, time or
+  // boolean order entry: the sort key of every entry is extracted once into a
+  // contiguous buffer, per-thread runs are sorted by cheap integer comparisons
+  // and merged. Multi-column ORDER BY, strings and count distinct stay on the
+  // comparator path.
+  bool canUseParallelKeySort(const std::list<Analyzer::OrderEntry>& order_entries) const;
+
+  void parallelSortPermutation(const Analyzer::OrderEntry& order_entry);
+
+  template <typename BUFFER_ITERATOR_TYPE>
+  void doParallelSortPermutation(const BUFFER_ITERATOR_TYPE& buffer_itr,
+                                 const Analyzer::OrderEntry& order_entry);
+
   std::vector<uint32_t> initPermutationBuffer(const size_t start, const size_t step);
 
   void parallelTop(const std::list<Analyzer::OrderEntry>& order_entries,
@@ -771,6 +817,12 @@ class ResultSet {
                       const std::list<Analyzer::OrderEntry>& order_entries,
                       const size_t top_n);
 
+  // Merges fully sorted per-device permutation slices into permutation_ by
+  // parallel rounds of pairwise merges; used by the baseline sort when there
+  // is no LIMIT to truncate to.
+  void mergeSortedPermutations(std::vector<std::vector<uint32_t>>& sorted_runs,
+                               const std::list<Analyzer::OrderEntry>& order_entries);
+
   bool canUseFastBaselineSort(const std::list<Analyzer::OrderEntry>& order_entries,
                               const size_t top_n);
 
@@ -824,6 +876,7 @@ class ResultSet {
   std::vector<uint32_t> permutation_;
   int64_t queue_time_ms_;
   int64_t render_time_ms_;
+  double fraction_sampled_{1.0};
   const Executor* executor_;  // TODO(alex): remove
 
   std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_;
@@ -888,8 +941,18 @@ inline ResultSetRowIterator& ResultSetRowIterator::operator++(void) {
   return *this;
 }
 
+// When enabled, reductions over partial result sets whose combined footprint
+// exceeds g_spill_to_disk_reduction_min_bytes spill the not-yet-merged partial
+// buffers to disk and stream them back one at a time, bounding the peak memory
+// of high-cardinality GROUP BY reductions. Partial result sets are consumed
+// (their buffers released) as they are merged in this mode.
+extern bool g_enable_spill_to_disk_reduction;
+extern size_t g_spill_to_disk_reduction_min_bytes;
+
 class ResultSetManager {
  public:
+  ~ResultSetManager();
+
   ResultSet* reduce(std::vector<ResultSet*>&);
 
   std::shared_ptr<ResultSet> getOwnResultSet();
@@ -897,7 +960,12 @@ class ResultSetManager {
   void rewriteVarlenAggregates(ResultSet*);
 
  private:
+  void spillStorage(ResultSet* result_set);
+  void restoreStorage(ResultSet* result_set);
+  void dropStorage(ResultSet* result_set);
+
   std::shared_ptr<ResultSet> rs_;
+  std::unordered_map<ResultSet*, std::string> spill_files_;
 };
 
 class RowSortException : public std::runtime_error {
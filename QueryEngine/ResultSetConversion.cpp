@@ -373,10 +373,10 @@ void print_serialized_records(const uint8_t* data,
   ARROW_THROW_NOT_OK(ipc::ReadRecordBatch(schema, &buffer_reader, &batch));
 }
 
-key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
-  if (!data->size()) {
-    return IPC_PRIVATE;
-  }
+// Allocates a shared memory segment of the given size and returns its key
+// along with the attached address. The caller must shmdt() the address once
+// done writing; the segment itself lives until the client removes it.
+std::pair<key_t, void*> get_shm(const size_t shmsz) {
   // Generate a new key for a shared memory segment. Keys to shared memory segments
   // are OS global, so we need to try a new key if we encounter a collision. It seems
   // incremental keygen would be deterministically worst-case. If we use a hash
@@ -384,7 +384,6 @@ key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
   // the same nonce, so using rand() in lieu of a better approach
   // TODO(ptaylor): Is this common? Are these assumptions true?
   auto key = static_cast<key_t>(rand());
-  const auto shmsz = data->size();
   int shmid = -1;
   // IPC_CREAT - indicates we want to create a new segment for this key if it doesn't
   // exist IPC_EXCL - ensures failure if a segment already exists for this key
@@ -408,9 +407,17 @@ key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
     throw std::runtime_error("failed to attach a shared memory");
   }
 
+  return {key, ipc_ptr};
+}
+
+key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
+  if (!data->size()) {
+    return IPC_PRIVATE;
+  }
+  const auto key_and_ptr = get_shm(data->size());
+  const auto key = key_and_ptr.first;
+  const auto ipc_ptr = key_and_ptr.second;
   // copy the arrow records buffer to shared memory
-  // TODO(ptaylor): I'm sure it's possible to tell Arrow's RecordBatchStreamWriter to
-  // write directly to the shared memory segment as a sink
   memcpy(ipc_ptr, data->data(), data->size());
   // detach from the shared memory segment
   shmdt(ipc_ptr);
@@ -419,6 +426,11 @@ key_t get_and_copy_to_shm(const std::shared_ptr<Buffer>& data) {
 
 }  // namespace arrow
 
+// When non-zero, CPU Arrow exports are serialized as an IPC stream of record
+// batches of at most this many rows instead of one monolithic batch, so
+// clients can start consuming before the last batch is written out.
+size_t g_arrow_stream_export_batch_rows{0};
+
 std::shared_ptr<const std::vector<std::string>> ResultSet::getDictionary(
     const int dict_id) const {
   const auto sdp =
@@ -617,6 +629,40 @@ std::shared_ptr<arrow::RecordBatch> ResultSet::convertToArrow(
   return getArrowBatch(arrow::schema(fields), first_n);
 }
 
+ResultSet::SerializedArrowOutput ResultSet::getSerializedArrowStream(
+    const std::vector<std::string>& col_names,
+    const int32_t first_n,
+    const size_t max_batch_rows) const {
+  CHECK_GT(max_batch_rows, size_t(0));
+  arrow::ipc::DictionaryMemo dict_memo;
+  std::shared_ptr<arrow::RecordBatch> arrow_copy =
+      convertToArrow(col_names, dict_memo, first_n);
+  std::shared_ptr<arrow::Buffer> serialized_schema;
+  ARROW_THROW_NOT_OK(arrow::ipc::SerializeSchema(
+      *arrow_copy->schema(), arrow::default_memory_pool(), &serialized_schema));
+
+  // Emit the rows as an IPC stream of bounded record batches. The slices
+  // share the converted columns' buffers, so chunking adds no extra copies of
+  // the column data.
+  std::shared_ptr<arrow::io::BufferOutputStream> stream;
+  ARROW_THROW_NOT_OK(
+      arrow::io::BufferOutputStream::Create(1 << 20, arrow::default_memory_pool(), &stream));
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+  ARROW_THROW_NOT_OK(
+      arrow::ipc::RecordBatchStreamWriter::Open(stream.get(), arrow_copy->schema(), &writer));
+  const int64_t num_rows = arrow_copy->num_rows();
+  for (int64_t offset = 0; offset < num_rows;
+       offset += static_cast<int64_t>(max_batch_rows)) {
+    const auto batch_rows =
+        std::min<int64_t>(max_batch_rows, num_rows - offset);
+    ARROW_THROW_NOT_OK(writer->WriteRecordBatch(*arrow_copy->Slice(offset, batch_rows)));
+  }
+  ARROW_THROW_NOT_OK(writer->Close());
+  std::shared_ptr<arrow::Buffer> serialized_records;
+  ARROW_THROW_NOT_OK(stream->Finish(&serialized_records));
+  return {serialized_schema, serialized_records};
+}
+
 ResultSet::SerializedArrowOutput ResultSet::getSerializedArrowOutput(
     const std::vector<std::string>& col_names,
     const int32_t first_n) const {
@@ -642,9 +688,41 @@ ResultSet::SerializedArrowOutput ResultSet::getSerializedArrowOutput(
 //   shmctl(shmid, IPC_RMID, 0);
 ArrowResult ResultSet::getArrowCopyOnCpu(const std::vector<std::string>& col_names,
                                          const int32_t first_n) const {
-  const auto serialized_arrow_output = getSerializedArrowOutput(col_names, first_n);
-  const auto& serialized_schema = serialized_arrow_output.schema;
-  const auto& serialized_records = serialized_arrow_output.records;
+  if (g_arrow_stream_export_batch_rows > 0) {
+    // The size of an IPC stream isn't known before it is written, so the
+    // chunked export serializes to a growable buffer first and copies it into
+    // shared memory afterwards.
+    const auto serialized_arrow_output =
+        getSerializedArrowStream(col_names, first_n, g_arrow_stream_export_batch_rows);
+    const auto& serialized_schema = serialized_arrow_output.schema;
+    const auto& serialized_records = serialized_arrow_output.records;
+
+    const auto schema_key = arrow::get_and_copy_to_shm(serialized_schema);
+    CHECK(schema_key != IPC_PRIVATE);
+    std::vector<char> schema_handle_buffer(sizeof(key_t), 0);
+    memcpy(&schema_handle_buffer[0],
+           reinterpret_cast<const unsigned char*>(&schema_key),
+           sizeof(key_t));
+
+    const auto record_key = arrow::get_and_copy_to_shm(serialized_records);
+    std::vector<char> record_handle_buffer(sizeof(key_t), 0);
+    memcpy(&record_handle_buffer[0],
+           reinterpret_cast<const unsigned char*>(&record_key),
+           sizeof(key_t));
+
+    return {schema_handle_buffer,
+            serialized_schema->size(),
+            record_handle_buffer,
+            serialized_records->size(),
+            nullptr};
+  }
+
+  arrow::ipc::DictionaryMemo dict_memo;
+  std::shared_ptr<arrow::RecordBatch> arrow_copy =
+      convertToArrow(col_names, dict_memo, first_n);
+  std::shared_ptr<arrow::Buffer> serialized_schema;
+  ARROW_THROW_NOT_OK(arrow::ipc::SerializeSchema(
+      *arrow_copy->schema(), arrow::default_memory_pool(), &serialized_schema));
 
   const auto schema_key = arrow::get_and_copy_to_shm(serialized_schema);
   CHECK(schema_key != IPC_PRIVATE);
@@ -653,7 +731,22 @@ ArrowResult ResultSet::getArrowCopyOnCpu(const std::vector<std::string>& col_nam
          reinterpret_cast<const unsigned char*>(&schema_key),
          sizeof(key_t));
 
-  const auto record_key = arrow::get_and_copy_to_shm(serialized_records);
+  // The record batch size is known up front, so serialize it straight into
+  // the shared memory segment instead of through an intermediate heap buffer.
+  int64_t records_size = 0;
+  ARROW_THROW_NOT_OK(arrow::ipc::GetRecordBatchSize(*arrow_copy, &records_size));
+  key_t record_key = IPC_PRIVATE;
+  if (records_size > 0) {
+    const auto key_and_ptr = arrow::get_shm(records_size);
+    record_key = key_and_ptr.first;
+    const auto ipc_ptr = key_and_ptr.second;
+    auto shm_buffer = std::make_shared<arrow::MutableBuffer>(
+        reinterpret_cast<uint8_t*>(ipc_ptr), records_size);
+    arrow::io::FixedSizeBufferWriter shm_writer(shm_buffer);
+    ARROW_THROW_NOT_OK(arrow::ipc::SerializeRecordBatch(
+        *arrow_copy, arrow::default_memory_pool(), &shm_writer));
+    shmdt(ipc_ptr);
+  }
   std::vector<char> record_handle_buffer(sizeof(key_t), 0);
   memcpy(&record_handle_buffer[0],
          reinterpret_cast<const unsigned char*>(&record_key),
@@ -662,7 +755,7 @@ ArrowResult ResultSet::getArrowCopyOnCpu(const std::vector<std::string>& col_nam
   return {schema_handle_buffer,
           serialized_schema->size(),
           record_handle_buffer,
-          serialized_records->size(),
+          records_size,
           nullptr};
 }
 
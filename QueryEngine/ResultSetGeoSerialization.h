@@ -85,18 +85,13 @@ void unpack_geo_vector(std::vector<T>& output, const int8_t* input_ptr, const si
   }
 }
 
-template <typename T>
-void decompress_geo_coords_geoint32(std::vector<T>& dec,
+void decompress_geo_coords_geoint32(std::vector<double>& dec,
                                     const int8_t* enc,
                                     const size_t sz) {
   const auto compressed_coords = reinterpret_cast<const int32_t*>(enc);
   const auto num_coords = sz / sizeof(int32_t);
   dec.resize(num_coords);
-  for (size_t i = 0; i < num_coords; i += 2) {
-    dec[i] = Geo_namespace::decompress_longitude_coord_geoint32(compressed_coords[i]);
-    dec[i + 1] =
-        Geo_namespace::decompress_lattitude_coord_geoint32(compressed_coords[i + 1]);
-  }
+  Geo_namespace::decompress_geoint32_coords(compressed_coords, dec.data(), num_coords);
 }
 
 template <typename T>
@@ -24,6 +24,8 @@
 
 #include "../Shared/geo_types.h"
 #include "../Shared/likely.h"
+#include "ApproxQuantileDigest.h"
+#include "ApproxTopKSketch.h"
 #include "Execute.h"
 #include "ParserNode.h"
 #include "QueryEngine/TargetValue.h"
@@ -1140,6 +1142,49 @@ void ResultSet::copyColumnIntoBuffer(const size_t column_idx,
   }
 }
 
+/**
+ * Copies a row range of the given column into output_buffer, spanning storages
+ * as needed. Like copyColumnIntoBuffer, this requires a columnar and completely
+ * compacted result set (e.g., columnar projections).
+ */
+void ResultSet::copyColumnRangeIntoBuffer(const size_t column_idx,
+                                          const size_t start_row,
+                                          const size_t num_rows,
+                                          int8_t* output_buffer) const {
+  CHECK(isFastColumnarConversionPossible());
+  CHECK_LT(column_idx, query_mem_desc_.getSlotCount());
+  CHECK(output_buffer);
+  const auto column_width_size = query_mem_desc_.getPaddedSlotWidthBytes(column_idx);
+  size_t rows_copied = 0;
+  size_t storage_start_row = 0;
+
+  const auto copy_from_storage = [&](const ResultSetStorage* storage) {
+    const size_t crt_storage_row_count = storage->query_mem_desc_.getEntryCount();
+    if (rows_copied < num_rows &&
+        start_row < storage_start_row + crt_storage_row_count) {
+      const size_t local_start =
+          std::max(start_row, storage_start_row) - storage_start_row;
+      const size_t local_count =
+          std::min(crt_storage_row_count - local_start, num_rows - rows_copied);
+      const size_t column_offset =
+          storage->query_mem_desc_.getColOffInBytes(column_idx);
+      const int8_t* storage_buffer = storage->getUnderlyingBuffer() + column_offset +
+                                     local_start * column_width_size;
+      std::memcpy(output_buffer + rows_copied * column_width_size,
+                  storage_buffer,
+                  local_count * column_width_size);
+      rows_copied += local_count;
+    }
+    storage_start_row += crt_storage_row_count;
+  };
+
+  copy_from_storage(storage_.get());
+  for (size_t i = 0; i < appended_storage_.size(); ++i) {
+    copy_from_storage(appended_storage_[i].get());
+  }
+  CHECK_EQ(num_rows, rows_copied);
+}
+
 // Interprets ptr1, ptr2 as the ptr and len pair used for variable length data.
 TargetValue ResultSet::makeVarlenTargetValue(const int8_t* ptr1,
                                              const int8_t compact_sz1,
@@ -1618,6 +1663,31 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
       }
     }
   }
+  if (target_info.is_agg && target_info.agg_kind == kAPPROX_MEDIAN) {
+    // The slot holds a handle to the quantile digest, not the value itself.
+    if (!ival) {
+      return NULL_DOUBLE;
+    }
+    const auto digest = reinterpret_cast<ApproxQuantileDigest*>(ival);
+    if (digest->empty()) {
+      return NULL_DOUBLE;
+    }
+    return ScalarTargetValue(digest->quantile(0.5));
+  }
+  if (target_info.is_agg && target_info.agg_kind == kAPPROX_TOP_K) {
+    // The slot holds a handle to the heavy hitters sketch at the full slot
+    // width; the dictionary key override above doesn't apply to it. Swap the
+    // handle for the k-th most frequent value and let the regular integer and
+    // string paths below finish the job.
+    const auto handle = read_int_from_buff(ptr, compact_sz);
+    const auto sketch = reinterpret_cast<const ApproxTopKSketch*>(handle);
+    int64_t top_val{0};
+    if (handle && sketch->topValue(top_val)) {
+      ival = top_val;
+    } else {
+      ival = chosen_type.is_string() ? NULL_INT : inline_int_null_val(chosen_type);
+    }
+  }
   if (chosen_type.is_fp()) {
     switch (actual_compact_sz) {
       case 8: {
@@ -1784,11 +1854,8 @@ TargetValue ResultSet::getTargetValueFromBufferRowwise(
           const auto bitmap_byte_sz = count_distinct_desc.sub_bitmap_count == 1
                                           ? count_distinct_desc.bitmapSizeBytes()
                                           : count_distinct_desc.bitmapPaddedSizeBytes();
-          auto count_distinct_buffer =
-              static_cast<int8_t*>(checked_malloc(bitmap_byte_sz));
+          auto count_distinct_buffer = row_set_mem_owner_->allocate(bitmap_byte_sz);
           memset(count_distinct_buffer, 0, bitmap_byte_sz);
-          row_set_mem_owner_->addCountDistinctBuffer(
-              count_distinct_buffer, bitmap_byte_sz, true);
           *count_distinct_ptr_ptr = reinterpret_cast<int64_t>(count_distinct_buffer);
         }
       }
@@ -1869,6 +1936,13 @@ bool ResultSetStorage::isEmptyEntry(const size_t entry_idx, const int8_t* buff)
   if (query_mem_desc_.didOutputColumnar()) {
     return isEmptyEntryColumnar(entry_idx, buff);
   }
+  if (query_mem_desc_.hasOccupancyBitmap()) {
+    // the kernel marked every entry it claimed, so classifying the entry
+    // never has to touch the wide row
+    const auto occupancy_bitmap = reinterpret_cast<const uint64_t*>(
+        buff + query_mem_desc_.getOccupancyBitmapOffset());
+    return !(occupancy_bitmap[entry_idx >> 6] & (uint64_t(1) << (entry_idx & 63)));
+  }
   if (query_mem_desc_.hasKeylessHash()) {
     CHECK(query_mem_desc_.getQueryDescriptionType() ==
           QueryDescriptionType::GroupByPerfectHash);
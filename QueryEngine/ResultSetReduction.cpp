@@ -22,20 +22,30 @@
  * Copyright (c) 2014 MapD Technologies, Inc.  All rights reserved.
  */
 
+#include "ApproxQuantileDigest.h"
+#include "ApproxTopKSketch.h"
 #include "DynamicWatchdog.h"
 #include "ResultSet.h"
 #include "RuntimeFunctions.h"
 #include "Shared/SqlTypesLayout.h"
 
+#include "Shared/checked_alloc.h"
 #include "Shared/likely.h"
 #include "Shared/thread_count.h"
 
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
 #include <algorithm>
+#include <cstdio>
 #include <future>
 #include <numeric>
 
 extern bool g_enable_dynamic_watchdog;
 
+bool g_enable_spill_to_disk_reduction{false};
+size_t g_spill_to_disk_reduction_min_bytes{size_t(1) << 31};  // 2GB
+
 namespace {
 
 bool use_multithreaded_reduction(const size_t entry_count) {
@@ -170,6 +180,51 @@ void ResultSetStorage::reduce(
   CHECK(this_buff);
   auto that_buff = that.buff_;
   CHECK(that_buff);
+  const uint64_t* that_occupancy_bitmap{nullptr};
+  if (query_mem_desc_.hasOccupancyBitmap()) {
+    CHECK(that.query_mem_desc_.hasOccupancyBitmap());
+    that_occupancy_bitmap = reinterpret_cast<const uint64_t*>(
+        that_buff + query_mem_desc_.getOccupancyBitmapOffset());
+  }
+  // Walks [start_index, end_index) of that_buff; when the kernels maintained
+  // an occupancy bitmap, whole words of 64 empty entries are skipped without
+  // ever touching the wide rows.
+  const auto reduce_rowwise_range = [this,
+                                     this_buff,
+                                     that_buff,
+                                     that_occupancy_bitmap,
+                                     &that,
+                                     &serialized_varlen_buffer](
+                                        const size_t start_index,
+                                        const size_t end_index) {
+    if (!that_occupancy_bitmap) {
+      for (size_t entry_idx = start_index; entry_idx < end_index; ++entry_idx) {
+        reduceOneEntryNoCollisionsRowWise(
+            entry_idx, this_buff, that_buff, that, serialized_varlen_buffer);
+      }
+      return;
+    }
+    if (start_index >= end_index) {
+      return;
+    }
+    const size_t first_word = start_index >> 6;
+    const size_t last_word = (end_index - 1) >> 6;
+    for (size_t word_idx = first_word; word_idx <= last_word; ++word_idx) {
+      auto word = that_occupancy_bitmap[word_idx];
+      if (word_idx == first_word && (start_index & 63)) {
+        word &= ~uint64_t(0) << (start_index & 63);
+      }
+      if (word_idx == last_word && (end_index & 63)) {
+        word &= ~uint64_t(0) >> (64 - (end_index & 63));
+      }
+      while (word) {
+        const size_t entry_idx = (word_idx << 6) + __builtin_ctzll(word);
+        word &= word - 1;
+        reduceOneEntryNoCollisionsRowWise(
+            entry_idx, this_buff, that_buff, that, serialized_varlen_buffer);
+      }
+    }
+  };
   if (query_mem_desc_.getQueryDescriptionType() ==
       QueryDescriptionType::GroupByBaselineHash) {
     if (!serialized_varlen_buffer.empty()) {
@@ -238,18 +293,8 @@ void ResultSetStorage::reduce(
                                                   }));
       } else {
         reduction_threads.emplace_back(std::async(
-            std::launch::async,
-            [this,
-             this_buff,
-             that_buff,
-             start_index,
-             end_index,
-             &that,
-             &serialized_varlen_buffer] {
-              for (size_t entry_idx = start_index; entry_idx < end_index; ++entry_idx) {
-                reduceOneEntryNoCollisionsRowWise(
-                    entry_idx, this_buff, that_buff, that, serialized_varlen_buffer);
-              }
+            std::launch::async, [&reduce_rowwise_range, start_index, end_index] {
+              reduce_rowwise_range(start_index, end_index);
             }));
       }
     }
@@ -268,10 +313,7 @@ void ResultSetStorage::reduce(
                                        query_mem_desc_.getEntryCount(),
                                        serialized_varlen_buffer);
     } else {
-      for (size_t i = 0; i < entry_count; ++i) {
-        reduceOneEntryNoCollisionsRowWise(
-            i, this_buff, that_buff, that, serialized_varlen_buffer);
-      }
+      reduce_rowwise_range(0, entry_count);
     }
   }
 }
@@ -288,6 +330,94 @@ ALWAYS_INLINE void check_watchdog(const size_t sample_seed) {
   }
 }
 
+template <typename T, typename REDUCE_OP>
+void reduce_slot_elementwise(int8_t* this_ptr,
+                             const int8_t* that_ptr,
+                             const size_t start,
+                             const size_t end) {
+  auto lhs = reinterpret_cast<T*>(this_ptr);
+  auto rhs = reinterpret_cast<const T*>(that_ptr);
+  for (size_t i = start; i < end; ++i) {
+    lhs[i] = REDUCE_OP{}(lhs[i], rhs[i]);
+  }
+}
+
+struct SumOp {
+  template <typename T>
+  T operator()(const T lhs, const T rhs) const {
+    return lhs + rhs;
+  }
+};
+
+struct MinOp {
+  template <typename T>
+  T operator()(const T lhs, const T rhs) const {
+    return std::min(lhs, rhs);
+  }
+};
+
+struct MaxOp {
+  template <typename T>
+  T operator()(const T lhs, const T rhs) const {
+    return std::max(lhs, rhs);
+  }
+};
+
+template <typename REDUCE_OP>
+void reduce_slot_for_type(int8_t* this_ptr,
+                          const int8_t* that_ptr,
+                          const bool is_fp,
+                          const int8_t slot_width,
+                          const size_t start,
+                          const size_t end) {
+  if (is_fp) {
+    if (slot_width == 8) {
+      reduce_slot_elementwise<double, REDUCE_OP>(this_ptr, that_ptr, start, end);
+    } else {
+      reduce_slot_elementwise<float, REDUCE_OP>(this_ptr, that_ptr, start, end);
+    }
+  } else {
+    if (slot_width == 8) {
+      reduce_slot_elementwise<int64_t, REDUCE_OP>(this_ptr, that_ptr, start, end);
+    } else {
+      reduce_slot_elementwise<int32_t, REDUCE_OP>(this_ptr, that_ptr, start, end);
+    }
+  }
+}
+
+// Straight-line element-wise reduction over a columnar slot which the compiler can
+// auto-vectorize. Only valid for keyless layouts (no key columns to copy) and for
+// single slot, non-nullable aggregates whose initial value is the identity of the
+// reduction operator, so empty entries on either side reduce to a no-op and the
+// per-entry emptiness check can be skipped.
+bool reduce_slot_vectorized(int8_t* this_ptr,
+                            const int8_t* that_ptr,
+                            const TargetInfo& agg_info,
+                            const int8_t slot_width,
+                            const size_t start,
+                            const size_t end) {
+  if (slot_width != 4 && slot_width != 8) {
+    return false;
+  }
+  const bool is_fp = agg_info.sql_type.is_fp();
+  switch (agg_info.agg_kind) {
+    case kCOUNT:
+      reduce_slot_for_type<SumOp>(this_ptr, that_ptr, false, slot_width, start, end);
+      return true;
+    case kSUM:
+      reduce_slot_for_type<SumOp>(this_ptr, that_ptr, is_fp, slot_width, start, end);
+      return true;
+    case kMIN:
+      reduce_slot_for_type<MinOp>(this_ptr, that_ptr, is_fp, slot_width, start, end);
+      return true;
+    case kMAX:
+      reduce_slot_for_type<MaxOp>(this_ptr, that_ptr, is_fp, slot_width, start, end);
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace
 
 void ResultSetStorage::reduceEntriesNoCollisionsColWise(
@@ -327,6 +457,26 @@ void ResultSetStorage::reduceEntriesNoCollisionsColWise(
       const auto that_next_col_ptr = advance_to_next_columnar_target_buff(
           that_crt_col_ptr, query_mem_desc_, target_slot_idx);
 
+      // Fast path: for keyless layouts there are no key columns to copy, and for
+      // non-nullable one slot aggregates the initial value stored in empty entries is
+      // the identity of the reduction operator, so the whole slot can be reduced
+      // element-wise without the per-entry emptiness check. The tight loop is
+      // auto-vectorized by the compiler.
+      if (query_mem_desc_.hasKeylessHash() && !two_slot_target && agg_info.is_agg &&
+          !agg_info.is_distinct && !agg_info.skip_null_val &&
+          reduce_slot_vectorized(
+              this_crt_col_ptr,
+              that_crt_col_ptr,
+              agg_info,
+              query_mem_desc_.getPaddedSlotWidthBytes(target_slot_idx),
+              start_index,
+              end_index)) {
+        check_watchdog(start_index);
+        this_crt_col_ptr = this_next_col_ptr;
+        that_crt_col_ptr = that_next_col_ptr;
+        continue;
+      }
+
       for (size_t entry_idx = start_index; entry_idx < end_index; ++entry_idx) {
         check_watchdog(entry_idx);
         if (isEmptyEntryColumnar(entry_idx, that_buff)) {
@@ -506,6 +656,14 @@ void ResultSetStorage::reduceOneEntryNoCollisionsRowWise(
   if (isEmptyEntry(entry_idx, that_buff)) {
     return;
   }
+  if (query_mem_desc_.hasOccupancyBitmap()) {
+    // mark the entry in this buffer too; reduction populates entries the
+    // kernel which produced this buffer never claimed. Atomic since the
+    // multithreaded reduction ranges need not align to word boundaries.
+    auto this_bitmap =
+        reinterpret_cast<uint64_t*>(this_buff + query_mem_desc_.getOccupancyBitmapOffset());
+    __sync_fetch_and_or(&this_bitmap[entry_idx >> 6], uint64_t(1) << (entry_idx & 63));
+  }
   const auto key_bytes = get_key_bytes_rowwise(query_mem_desc_);
   const auto key_bytes_with_padding = align_to_int64(key_bytes);
   auto this_targets_ptr =
@@ -1039,6 +1197,30 @@ ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets) {
   for (const auto result_set : result_sets) {
     CHECK_EQ(executor, result_set->executor_);
   }
+
+  bool spill_partials = false;
+  if (g_enable_spill_to_disk_reduction && result_sets.size() > 1 &&
+      result_sets.front()->serialized_varlen_buffer_.empty()) {
+    size_t total_storage_bytes{0};
+    bool all_buffers_owned = true;
+    for (const auto result_set : result_sets) {
+      total_storage_bytes += result_set->query_mem_desc_.getBufferSizeBytes(
+          result_set->device_type_);
+      all_buffers_owned &= !result_set->storage_->buff_is_provided_;
+    }
+    spill_partials =
+        all_buffers_owned && total_storage_bytes >= g_spill_to_disk_reduction_min_bytes;
+  }
+  if (spill_partials) {
+    // Spill all partial buffers but the first before any merge buffer is allocated,
+    // so peak memory stays close to the final result size plus a single partial
+    // instead of the sum of all partials.
+    for (auto result_it = result_sets.begin() + 1; result_it != result_sets.end();
+         ++result_it) {
+      spillStorage(*result_it);
+    }
+  }
+
   if (first_result.query_mem_desc_.getQueryDescriptionType() ==
       QueryDescriptionType::GroupByBaselineHash) {
     const auto total_entry_count =
@@ -1072,6 +1254,10 @@ ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets) {
     }
     result = rs_->storage_.get();
     result_rs = rs_.get();
+    if (spill_partials) {
+      // The first partial's entries have been moved into the combined buffer.
+      dropStorage(result_sets.front());
+    }
   }
 
   auto& serialized_varlen_buffer = result_sets.front()->serialized_varlen_buffer_;
@@ -1089,15 +1275,72 @@ ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets) {
   size_t ctr = 1;
   for (auto result_it = result_sets.begin() + 1; result_it != result_sets.end();
        ++result_it) {
+    if (spill_partials) {
+      restoreStorage(*result_it);
+    }
     if (!serialized_varlen_buffer.empty()) {
       result->reduce(*((*result_it)->storage_), serialized_varlen_buffer[ctr++]);
     } else {
       result->reduce(*((*result_it)->storage_), {});
     }
+    if (spill_partials) {
+      dropStorage(*result_it);
+    }
   }
   return result_rs;
 }
 
+ResultSetManager::~ResultSetManager() {
+  for (const auto& spill_file : spill_files_) {
+    boost::filesystem::remove(spill_file.second);
+  }
+}
+
+void ResultSetManager::spillStorage(ResultSet* result_set) {
+  auto storage = result_set->storage_.get();
+  CHECK(storage);
+  CHECK(storage->buff_);
+  const auto buffer_size =
+      result_set->query_mem_desc_.getBufferSizeBytes(result_set->device_type_);
+  const auto file_path = (boost::filesystem::temp_directory_path() /
+                          boost::filesystem::unique_path("omnisci-reduce-%%%%-%%%%"))
+                             .string();
+  auto fp = fopen(file_path.c_str(), "wb");
+  CHECK(fp);
+  CHECK_EQ(buffer_size, fwrite(storage->buff_, 1, buffer_size, fp));
+  CHECK_EQ(0, fclose(fp));
+  const auto it_ok = spill_files_.emplace(result_set, file_path);
+  CHECK(it_ok.second);
+  free(storage->buff_);
+  // ~ResultSet expects a buffer to be present; leave a minimal allocation in
+  // place of the spilled one.
+  storage->buff_ = static_cast<int8_t*>(checked_malloc(1));
+}
+
+void ResultSetManager::restoreStorage(ResultSet* result_set) {
+  const auto it = spill_files_.find(result_set);
+  CHECK(it != spill_files_.end());
+  auto storage = result_set->storage_.get();
+  const auto buffer_size =
+      result_set->query_mem_desc_.getBufferSizeBytes(result_set->device_type_);
+  free(storage->buff_);
+  storage->buff_ = static_cast<int8_t*>(checked_malloc(buffer_size));
+  auto fp = fopen(it->second.c_str(), "rb");
+  CHECK(fp);
+  CHECK_EQ(buffer_size, fread(storage->buff_, 1, buffer_size, fp));
+  CHECK_EQ(0, fclose(fp));
+  boost::filesystem::remove(it->second);
+  spill_files_.erase(it);
+}
+
+void ResultSetManager::dropStorage(ResultSet* result_set) {
+  auto storage = result_set->storage_.get();
+  CHECK(storage);
+  CHECK(storage->buff_);
+  free(storage->buff_);
+  storage->buff_ = static_cast<int8_t*>(checked_malloc(1));
+}
+
 std::shared_ptr<ResultSet> ResultSetManager::getOwnResultSet() {
   return rs_;
 }
@@ -1159,6 +1402,11 @@ void ResultSetStorage::initializeRowWise() const {
     default:
       CHECK(false);
   }
+  if (query_mem_desc_.hasOccupancyBitmap()) {
+    memset(buff_ + query_mem_desc_.getOccupancyBitmapOffset(),
+           0,
+           query_mem_desc_.getOccupancyBitmapSizeBytes());
+  }
 }
 
 void ResultSetStorage::fillOneEntryColWise(const std::vector<int64_t>& entry) {
@@ -1411,6 +1659,16 @@ void ResultSetStorage::reduceOneSlot(
         AGGREGATE_ONE_COUNT(this_ptr1, that_ptr1, chosen_bytes);
         break;
       }
+      case kAPPROX_MEDIAN: {
+        CHECK_EQ(static_cast<size_t>(chosen_bytes), sizeof(int64_t));
+        reduceOneApproxMedianSlot(this_ptr1, that_ptr1);
+        break;
+      }
+      case kAPPROX_TOP_K: {
+        CHECK_EQ(static_cast<size_t>(chosen_bytes), sizeof(int64_t));
+        reduceOneApproxTopKSlot(this_ptr1, that_ptr1);
+        break;
+      }
       case kAVG: {
         // Ignore float argument compaction for count component for fear of its overflow
         AGGREGATE_ONE_COUNT(this_ptr2,
@@ -1533,6 +1791,28 @@ void ResultSetStorage::reduceOneCountDistinctSlot(int8_t* this_ptr1,
       *new_set_ptr, *old_set_ptr, new_count_distinct_desc, old_count_distinct_desc);
 }
 
+void ResultSetStorage::reduceOneApproxMedianSlot(int8_t* this_ptr1,
+                                                 const int8_t* that_ptr1) const {
+  CHECK(this_ptr1 && that_ptr1);
+  const auto old_digest = reinterpret_cast<ApproxQuantileDigest*>(
+      *reinterpret_cast<const int64_t*>(this_ptr1));
+  const auto new_digest = reinterpret_cast<const ApproxQuantileDigest*>(
+      *reinterpret_cast<const int64_t*>(that_ptr1));
+  CHECK(old_digest && new_digest);
+  old_digest->mergeDigest(*new_digest);
+}
+
+void ResultSetStorage::reduceOneApproxTopKSlot(int8_t* this_ptr1,
+                                               const int8_t* that_ptr1) const {
+  CHECK(this_ptr1 && that_ptr1);
+  const auto old_sketch = reinterpret_cast<ApproxTopKSketch*>(
+      *reinterpret_cast<const int64_t*>(this_ptr1));
+  const auto new_sketch = reinterpret_cast<const ApproxTopKSketch*>(
+      *reinterpret_cast<const int64_t*>(that_ptr1));
+  CHECK(old_sketch && new_sketch);
+  old_sketch->mergeSketch(*new_sketch);
+}
+
 bool ResultSetStorage::reduceSingleRow(const int8_t* row_ptr,
                                        const int8_t warp_count,
                                        const bool is_columnar,
@@ -33,6 +33,7 @@
 #include <thrust/device_vector.h>
 #include <thrust/sort.h>
 
+#include <algorithm>
 #include <future>
 
 std::unique_ptr<CudaMgr_Namespace::CudaMgr> g_cuda_mgr;  // for unit tests only
@@ -90,6 +91,9 @@ void ResultSet::doBaselineSort(const ExecutorDeviceType device_type,
       device_type == ExecutorDeviceType::GPU ? getGpuCount() : cpu_threads());
   CHECK_GE(step, size_t(1));
   const auto key_bytewidth = query_mem_desc_.getEffectiveKeyWidth();
+  // With no LIMIT every slice has to come back fully sorted; the slices are
+  // then merged instead of re-sorted.
+  const size_t slice_top_n = top_n ? top_n : layout.entry_count;
   if (step > 1) {
     std::vector<std::future<void>> top_futures;
     std::vector<std::vector<uint32_t>> strided_permutations(step);
@@ -103,7 +107,7 @@ void ResultSet::doBaselineSort(const ExecutorDeviceType device_type,
            pod_oe,
            key_bytewidth,
            layout,
-           top_n,
+           slice_top_n,
            start,
            step] {
             if (device_type == ExecutorDeviceType::GPU) {
@@ -116,7 +120,7 @@ void ResultSet::doBaselineSort(const ExecutorDeviceType device_type,
                                                                        groupby_buffer,
                                                                        pod_oe,
                                                                        layout,
-                                                                       top_n,
+                                                                       slice_top_n,
                                                                        start,
                                                                        step)
                                               : baseline_sort<int64_t>(device_type,
@@ -125,7 +129,7 @@ void ResultSet::doBaselineSort(const ExecutorDeviceType device_type,
                                                                        groupby_buffer,
                                                                        pod_oe,
                                                                        layout,
-                                                                       top_n,
+                                                                       slice_top_n,
                                                                        start,
                                                                        step);
           }));
@@ -136,6 +140,10 @@ void ResultSet::doBaselineSort(const ExecutorDeviceType device_type,
     for (auto& top_future : top_futures) {
       top_future.get();
     }
+    if (!top_n) {
+      mergeSortedPermutations(strided_permutations, order_entries);
+      return;
+    }
     permutation_.reserve(strided_permutations.size() * top_n);
     for (const auto& strided_permutation : strided_permutations) {
       permutation_.insert(
@@ -145,15 +153,64 @@ void ResultSet::doBaselineSort(const ExecutorDeviceType device_type,
     topPermutation(permutation_, top_n, compare);
     return;
   } else {
-    permutation_ =
-        (key_bytewidth == 4)
-            ? baseline_sort<int32_t>(
-                  device_type, 0, data_mgr, groupby_buffer, pod_oe, layout, top_n, 0, 1)
-            : baseline_sort<int64_t>(
-                  device_type, 0, data_mgr, groupby_buffer, pod_oe, layout, top_n, 0, 1);
+    permutation_ = (key_bytewidth == 4) ? baseline_sort<int32_t>(device_type,
+                                                                 0,
+                                                                 data_mgr,
+                                                                 groupby_buffer,
+                                                                 pod_oe,
+                                                                 layout,
+                                                                 slice_top_n,
+                                                                 0,
+                                                                 1)
+                                        : baseline_sort<int64_t>(device_type,
+                                                                 0,
+                                                                 data_mgr,
+                                                                 groupby_buffer,
+                                                                 pod_oe,
+                                                                 layout,
+                                                                 slice_top_n,
+                                                                 0,
+                                                                 1);
   }
 }
 
+void ResultSet::mergeSortedPermutations(
+    std::vector<std::vector<uint32_t>>& sorted_runs,
+    const std::list<Analyzer::OrderEntry>& order_entries) {
+  auto compare = createComparator(order_entries, false);
+  // Pairwise merge rounds; each round runs its merges concurrently and halves
+  // the number of runs, so the total comparator work is linear in the result
+  // size times the number of rounds.
+  while (sorted_runs.size() > 1) {
+    std::vector<std::future<std::vector<uint32_t>>> merge_futures;
+    for (size_t i = 0; i + 1 < sorted_runs.size(); i += 2) {
+      merge_futures.emplace_back(
+          std::async(std::launch::async,
+                     [&lhs = sorted_runs[i], &rhs = sorted_runs[i + 1], &compare] {
+                       std::vector<uint32_t> merged;
+                       merged.reserve(lhs.size() + rhs.size());
+                       std::merge(lhs.begin(),
+                                  lhs.end(),
+                                  rhs.begin(),
+                                  rhs.end(),
+                                  std::back_inserter(merged),
+                                  compare);
+                       return merged;
+                     }));
+    }
+    std::vector<std::vector<uint32_t>> next_runs;
+    for (auto& merge_future : merge_futures) {
+      next_runs.push_back(merge_future.get());
+    }
+    if (sorted_runs.size() % 2) {
+      next_runs.push_back(std::move(sorted_runs.back()));
+    }
+    sorted_runs.swap(next_runs);
+  }
+  CHECK_EQ(size_t(1), sorted_runs.size());
+  permutation_ = std::move(sorted_runs.front());
+}
+
 bool ResultSet::canUseFastBaselineSort(
     const std::list<Analyzer::OrderEntry>& order_entries,
     const size_t top_n) {
@@ -168,10 +225,15 @@ bool ResultSet::canUseFastBaselineSort(
   if (!target_info.sql_type.is_number() || is_distinct_target(target_info)) {
     return false;
   }
-  return (query_mem_desc_.getQueryDescriptionType() ==
-              QueryDescriptionType::GroupByBaselineHash ||
-          query_mem_desc_.isSingleColumnGroupByWithPerfectHash()) &&
-         top_n;
+  if (query_mem_desc_.getQueryDescriptionType() !=
+          QueryDescriptionType::GroupByBaselineHash &&
+      !query_mem_desc_.isSingleColumnGroupByWithPerfectHash()) {
+    return false;
+  }
+  // Without a LIMIT the slices are fully sorted per device and merged; that
+  // only beats the CPU paths when there's more than one device to spread the
+  // partition sorts over.
+  return top_n || getGpuCount() > 1;
 }
 
 Data_Namespace::DataMgr* ResultSet::getDataManager() const {
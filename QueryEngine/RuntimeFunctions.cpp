@@ -1018,6 +1018,20 @@ extern "C" ALWAYS_INLINE int64_t* get_matching_group_value_perfect_hash(
   return groups_buffer + off + key_count;
 }
 
+extern "C" ALWAYS_INLINE int64_t* get_matching_group_value_perfect_hash_with_occupancy(
+    int64_t* groups_buffer,
+    const uint32_t hashed_index,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t row_size_quad,
+    int64_t* occupancy_bitmap) {
+  // only generated for CPU, where each kernel thread owns its buffer, so the
+  // plain read-modify-write of the bitmap word is race free
+  occupancy_bitmap[hashed_index >> 6] |= int64_t(1) << (hashed_index & 63);
+  return get_matching_group_value_perfect_hash(
+      groups_buffer, hashed_index, key, key_count, row_size_quad);
+}
+
 /*
  * For a particular hashed_index, find and initialize (if necessary) all the group
  * columns corresponding to a key. It is assumed that all group columns are 64-bit wide.
@@ -1103,6 +1117,18 @@ extern "C" ALWAYS_INLINE DEVICE int32_t char_length_nullable(const char* str,
   return str_len;
 }
 
+extern "C" ALWAYS_INLINE DEVICE int32_t char_length_dict(const int64_t table_handle,
+                                                         const int32_t str_id,
+                                                         const int32_t entry_count,
+                                                         const int32_t int_null) {
+  // negative ids are the null sentinel and transient literals, neither of
+  // which the precomputed table covers
+  if (str_id < 0 || str_id >= entry_count) {
+    return int_null;
+  }
+  return reinterpret_cast<const int32_t*>(table_handle)[str_id];
+}
+
 extern "C" ALWAYS_INLINE DEVICE int32_t key_for_string_encoded(const int32_t str_id) {
   return str_id;
 }
@@ -154,6 +154,13 @@ extern "C" int64_t* get_group_value_fast(int64_t* groups_buffer,
                                          const int64_t bucket,
                                          const uint32_t row_size_quad);
 
+extern "C" int64_t* get_group_value_fast_with_occupancy(int64_t* groups_buffer,
+                                                        const int64_t key,
+                                                        const int64_t min_key,
+                                                        const int64_t bucket,
+                                                        const uint32_t row_size_quad,
+                                                        int64_t* occupancy_bitmap);
+
 extern "C" int64_t* get_group_value_fast_with_original_key(int64_t* groups_buffer,
                                                            const int64_t key,
                                                            const int64_t orig_key,
@@ -172,6 +179,14 @@ extern "C" int64_t* get_matching_group_value_perfect_hash(int64_t* groups_buffer
                                                           const uint32_t key_qw_count,
                                                           const uint32_t row_size_quad);
 
+extern "C" int64_t* get_matching_group_value_perfect_hash_with_occupancy(
+    int64_t* groups_buffer,
+    const uint32_t h,
+    const int64_t* key,
+    const uint32_t key_qw_count,
+    const uint32_t row_size_quad,
+    int64_t* occupancy_bitmap);
+
 extern "C" int32_t* get_bucketized_hash_slot(int32_t* buff,
                                              const int64_t key,
                                              const int64_t min_key,
@@ -224,6 +239,23 @@ extern "C" int64_t fixed_width_small_date_decode_noinline(const int8_t* byte_str
                                                           const int64_t ret_null_val,
                                                           const int64_t pos);
 
+extern "C" int64_t fixed_width_dict_decode_noinline(const int8_t* byte_stream,
+                                                    const int32_t code_byte_width,
+                                                    const int32_t value_byte_width,
+                                                    const int64_t dict_offset,
+                                                    const int64_t pos);
+
+extern "C" int64_t fixed_width_linear_decode_noinline(const int8_t* byte_stream,
+                                                      const int32_t byte_width,
+                                                      const int64_t base,
+                                                      const int64_t slope,
+                                                      const int64_t pos);
+
+extern "C" int64_t run_length_decode_noinline(const int8_t* byte_stream,
+                                              const int32_t value_byte_width,
+                                              const int64_t run_count,
+                                              const int64_t pos);
+
 extern "C" int8_t* extract_str_ptr_noinline(const uint64_t str_and_len);
 
 extern "C" int32_t extract_str_len_noinline(const uint64_t str_and_len);
@@ -20,49 +20,59 @@
 #include "ResultSet.h"
 #include "Shared/Logger.h"
 
-SpeculativeTopNMap::SpeculativeTopNMap() : unknown_(0) {}
+namespace {
+
+// The speculative reduction tracks a single group key per entry; every other
+// target is an aggregate. Returns the position of the key target.
+size_t speculative_topn_key_index(const std::vector<Analyzer::Expr*>& target_exprs) {
+  ssize_t key_idx{-1};
+  for (size_t i = 0; i < target_exprs.size(); ++i) {
+    if (!dynamic_cast<const Analyzer::AggExpr*>(target_exprs[i])) {
+      CHECK_EQ(ssize_t(-1), key_idx);
+      key_idx = i;
+    }
+  }
+  CHECK_GE(key_idx, 0);
+  return static_cast<size_t>(key_idx);
+}
+
+}  // namespace
+
+SpeculativeTopNMap::SpeculativeTopNMap(const size_t sorted_val_idx)
+    : unknown_(0), sorted_val_idx_(sorted_val_idx) {}
 
 SpeculativeTopNMap::SpeculativeTopNMap(const ResultSet& rows,
                                        const std::vector<Analyzer::Expr*>& target_exprs,
-                                       const size_t truncate_n)
-    : unknown_(0) {
+                                       const size_t truncate_n,
+                                       const size_t sorted_val_idx)
+    : unknown_(0), sorted_val_idx_(sorted_val_idx) {
   CHECK_EQ(rows.colCount(), target_exprs.size());
-  const bool count_first = dynamic_cast<const Analyzer::AggExpr*>(target_exprs[0]);
+  const auto key_idx = speculative_topn_key_index(target_exprs);
   for (size_t i = 0; i < truncate_n + 1; ++i) {
     const auto crt_row = rows.getNextRow(false, false);
     if (crt_row.empty()) {
       break;
     }
     int64_t key{0};
-    size_t val{0};
+    std::vector<size_t> vals;
     CHECK_EQ(rows.colCount(), crt_row.size());
-    {
-      auto scalar_r = boost::get<ScalarTargetValue>(&crt_row[0]);
+    for (size_t col_idx = 0; col_idx < crt_row.size(); ++col_idx) {
+      auto scalar_r = boost::get<ScalarTargetValue>(&crt_row[col_idx]);
       CHECK(scalar_r);
       auto p = boost::get<int64_t>(scalar_r);
       CHECK(p);
-      if (count_first) {
-        val = *p;
-      } else {
-        key = *p;
-      }
-    }
-    {
-      auto scalar_r = boost::get<ScalarTargetValue>(&crt_row[1]);
-      CHECK(scalar_r);
-      auto p = boost::get<int64_t>(scalar_r);
-      CHECK(p);
-      if (count_first) {
+      if (col_idx == key_idx) {
         key = *p;
       } else {
-        val = *p;
+        vals.push_back(*p);
       }
     }
+    CHECK_LT(sorted_val_idx_, vals.size());
     if (i < truncate_n) {
-      const auto it_ok = map_.emplace(key, SpeculativeTopNVal{val, false});
+      const auto it_ok = map_.emplace(key, SpeculativeTopNVal{std::move(vals), false});
       CHECK(it_ok.second);
     } else {
-      unknown_ = val;
+      unknown_ = vals[sorted_val_idx_];
     }
   }
 }
@@ -74,16 +84,24 @@ void SpeculativeTopNMap::reduce(SpeculativeTopNMap& that) {
     if (that_it != that.map_.end()) {
       const auto& that_entry = that_it->second;
       CHECK(!that_entry.unknown);
-      this_entry.val += that_entry.val;
+      CHECK_EQ(this_entry.vals.size(), that_entry.vals.size());
+      for (size_t i = 0; i < this_entry.vals.size(); ++i) {
+        this_entry.vals[i] += that_entry.vals[i];
+      }
       that.map_.erase(that_it);
     } else {
-      this_entry.val += that.unknown_;
+      // The group fell below the other device's truncation point; only the
+      // sorted aggregate has an upper bound there, the whole row becomes
+      // unknown.
+      this_entry.vals[sorted_val_idx_] += that.unknown_;
       this_entry.unknown = that.unknown_;
     }
   }
   for (const auto& kv : that.map_) {
-    const auto it_ok = map_.emplace(
-        kv.first, SpeculativeTopNVal{kv.second.val + unknown_, unknown_ != 0});
+    auto vals = kv.second.vals;
+    vals[sorted_val_idx_] += unknown_;
+    const auto it_ok =
+        map_.emplace(kv.first, SpeculativeTopNVal{std::move(vals), unknown_ != 0});
     CHECK(it_ok.second);
   }
   unknown_ += that.unknown_;
@@ -98,47 +116,61 @@ std::shared_ptr<ResultSet> SpeculativeTopNMap::asRows(
     const bool desc) const {
   std::vector<SpeculativeTopNEntry> vec;
   for (const auto& kv : map_) {
-    vec.emplace_back(SpeculativeTopNEntry{kv.first, kv.second.val, kv.second.unknown});
-  }
-  if (desc) {
-    std::sort(vec.begin(), vec.end(), std::greater<SpeculativeTopNEntry>());
-  } else {
-    std::sort(vec.begin(), vec.end());
+    vec.emplace_back(SpeculativeTopNEntry{
+        kv.first, kv.second.vals, kv.second.vals[sorted_val_idx_], kv.second.unknown});
   }
+  const auto& order_entries = ra_exe_unit.sort_info.order_entries;
+  std::sort(vec.begin(),
+            vec.end(),
+            [desc, &order_entries](const SpeculativeTopNEntry& lhs,
+                                   const SpeculativeTopNEntry& rhs) {
+              if (lhs.val != rhs.val) {
+                return desc ? lhs.val > rhs.val : lhs.val < rhs.val;
+              }
+              // Trailing order entries all reference the group by key, whose
+              // value is exact in every entry; use them to break ties.
+              auto it = order_entries.begin();
+              for (++it; it != order_entries.end(); ++it) {
+                if (lhs.key != rhs.key) {
+                  return it->is_desc ? lhs.key > rhs.key : lhs.key < rhs.key;
+                }
+              }
+              return false;
+            });
   const auto num_rows = std::min(top_n, vec.size());
   for (size_t i = 0; i < num_rows; ++i) {
     if (vec[i].unknown) {
       throw SpeculativeTopNFailed();
     }
   }
-  CHECK_EQ(size_t(2), ra_exe_unit.target_exprs.size());
+  const auto& target_exprs = ra_exe_unit.target_exprs;
+  CHECK_GE(target_exprs.size(), size_t(2));
+  const auto key_idx = speculative_topn_key_index(target_exprs);
   auto query_mem_desc_rs = query_mem_desc;
   query_mem_desc_rs.setQueryDescriptionType(QueryDescriptionType::GroupByBaselineHash);
   query_mem_desc_rs.setOutputColumnar(false);
   query_mem_desc_rs.setEntryCount(num_rows);
   query_mem_desc_rs.clearSlotInfo();
-  query_mem_desc_rs.addColSlotInfo({std::make_tuple(8, 8)});
-  query_mem_desc_rs.addColSlotInfo({std::make_tuple(8, 8)});
+  for (size_t i = 0; i < target_exprs.size(); ++i) {
+    query_mem_desc_rs.addColSlotInfo({std::make_tuple(8, 8)});
+  }
   auto rs = std::make_shared<ResultSet>(
-      target_exprs_to_infos(ra_exe_unit.target_exprs, query_mem_desc_rs),
+      target_exprs_to_infos(target_exprs, query_mem_desc_rs),
       ExecutorDeviceType::CPU,
       query_mem_desc_rs,
       row_set_mem_owner,
       executor);
   auto rs_storage = rs->allocateStorage();
   auto rs_buff = reinterpret_cast<int64_t*>(rs_storage->getUnderlyingBuffer());
-  const bool count_first =
-      dynamic_cast<const Analyzer::AggExpr*>(ra_exe_unit.target_exprs[0]);
   for (size_t i = 0; i < num_rows; ++i) {
     rs_buff[0] = vec[i].key;
-    int64_t col0 = vec[i].key;
-    int64_t col1 = vec[i].val;
-    if (count_first) {
-      std::swap(col0, col1);
+    size_t val_idx{0};
+    for (size_t target_idx = 0; target_idx < target_exprs.size(); ++target_idx) {
+      rs_buff[1 + target_idx] = target_idx == key_idx
+                                    ? vec[i].key
+                                    : static_cast<int64_t>(vec[i].vals[val_idx++]);
     }
-    rs_buff[1] = col0;
-    rs_buff[2] = col1;
-    rs_buff += 3;
+    rs_buff += target_exprs.size() + 1;
   }
   return rs;
 }
@@ -166,15 +198,41 @@ bool use_speculative_top_n(const RelAlgExecutionUnit& ra_exe_unit,
   if (g_cluster) {
     return false;
   }
-  if (ra_exe_unit.target_exprs.size() != 2) {
+  if (ra_exe_unit.target_exprs.size() < 2 || ra_exe_unit.groupby_exprs.size() != 1 ||
+      !ra_exe_unit.groupby_exprs.front()) {
     return false;
   }
+  // The reduction carries one group key per entry plus any number of counts,
+  // whose per-device partials simply add up.
+  size_t key_target_count{0};
   for (const auto target_expr : ra_exe_unit.target_exprs) {
     const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
-    if (agg_expr && agg_expr->get_aggtype() != kCOUNT) {
+    if (!agg_expr) {
+      ++key_target_count;
+      continue;
+    }
+    if (agg_expr->get_aggtype() != kCOUNT || agg_expr->get_is_distinct()) {
       return false;
     }
   }
+  if (key_target_count != 1) {
+    return false;
+  }
   return query_mem_desc.sortOnGpu() && ra_exe_unit.sort_info.limit &&
          ra_exe_unit.sort_info.algorithm == SortAlgorithm::SpeculativeTopN;
 }
+
+size_t speculative_topn_sorted_val_index(const RelAlgExecutionUnit& ra_exe_unit) {
+  CHECK(!ra_exe_unit.sort_info.order_entries.empty());
+  const size_t sort_target_idx = ra_exe_unit.sort_info.order_entries.front().tle_no - 1;
+  CHECK_LT(sort_target_idx, ra_exe_unit.target_exprs.size());
+  CHECK(dynamic_cast<const Analyzer::AggExpr*>(
+      ra_exe_unit.target_exprs[sort_target_idx]));
+  size_t sorted_val_idx{0};
+  for (size_t i = 0; i < sort_target_idx; ++i) {
+    if (dynamic_cast<const Analyzer::AggExpr*>(ra_exe_unit.target_exprs[i])) {
+      ++sorted_val_idx;
+    }
+  }
+  return sorted_val_idx;
+}
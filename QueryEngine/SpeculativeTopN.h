@@ -33,13 +33,14 @@
 #include <vector>
 
 struct SpeculativeTopNVal {
-  size_t val;
+  std::vector<size_t> vals;  // one per aggregate target, in target order
   bool unknown;
 };
 
 struct SpeculativeTopNEntry {
   int64_t key;
-  size_t val;
+  std::vector<size_t> vals;  // one per aggregate target, in target order
+  size_t val;                // the aggregate the query sorts on
   bool unknown;
 
   bool operator<(const SpeculativeTopNEntry& that) const { return val < that.val; }
@@ -57,11 +58,12 @@ class Expr;
 
 class SpeculativeTopNMap {
  public:
-  SpeculativeTopNMap();
+  explicit SpeculativeTopNMap(const size_t sorted_val_idx = 0);
 
   SpeculativeTopNMap(const ResultSet& rows,
                      const std::vector<Analyzer::Expr*>& target_exprs,
-                     const size_t truncate_n);
+                     const size_t truncate_n,
+                     const size_t sorted_val_idx);
 
   void reduce(SpeculativeTopNMap& that);
 
@@ -75,6 +77,10 @@ class SpeculativeTopNMap {
  private:
   std::unordered_map<int64_t, SpeculativeTopNVal> map_;
   size_t unknown_;
+  // Index of the sorted aggregate among the aggregate targets; it's the only
+  // column the per-device truncation bounds, so only it absorbs the unknown
+  // tail during reduction.
+  size_t sorted_val_idx_;
 };
 
 class SpeculativeTopNFailed : public std::runtime_error {
@@ -93,4 +99,7 @@ class SpeculativeTopNBlacklist {
 
 bool use_speculative_top_n(const RelAlgExecutionUnit&, const QueryMemoryDescriptor&);
 
+// Position of the aggregate the query sorts on among the aggregate targets.
+size_t speculative_topn_sorted_val_index(const RelAlgExecutionUnit&);
+
 #endif  // QUERYENGINE_SPECULATIVETOPN_H
@@ -59,20 +59,31 @@ bool use_streaming_top_n(const RelAlgExecutionUnit& ra_exe_unit,
   }
 
   // TODO: Allow streaming top n for columnar output
-  if (!output_columnar && ra_exe_unit.sort_info.order_entries.size() == 1 &&
+  const auto& order_entries = ra_exe_unit.sort_info.order_entries;
+  if (!output_columnar && !order_entries.empty() && order_entries.size() <= 2 &&
       ra_exe_unit.sort_info.limit &&
       ra_exe_unit.sort_info.algorithm == SortAlgorithm::StreamingTopN) {
-    const auto only_order_entry = ra_exe_unit.sort_info.order_entries.front();
-    CHECK_GT(only_order_entry.tle_no, int(0));
-    CHECK_LE(static_cast<size_t>(only_order_entry.tle_no),
-             ra_exe_unit.target_exprs.size());
-    const auto order_entry_expr = ra_exe_unit.target_exprs[only_order_entry.tle_no - 1];
     const auto n = ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit;
-    if ((order_entry_expr->get_type_info().is_number() ||
-         order_entry_expr->get_type_info().is_time()) &&
-        n <= 100000) {  // TODO(miyu): relax?
-      return true;
+    if (n > 100000) {  // TODO(miyu): relax?
+      return false;
+    }
+    size_t entry_idx = 0;
+    for (const auto& order_entry : order_entries) {
+      CHECK_GT(order_entry.tle_no, int(0));
+      CHECK_LE(static_cast<size_t>(order_entry.tle_no), ra_exe_unit.target_exprs.size());
+      const auto order_entry_expr = ra_exe_unit.target_exprs[order_entry.tle_no - 1];
+      const auto& oe_ti = order_entry_expr->get_type_info();
+      if (!oe_ti.is_number() && !oe_ti.is_time()) {
+        return false;
+      }
+      // the GPU heap merge breaks primary-key ties by the secondary key but
+      // does not null-partition on it, so the secondary key must be NOT NULL
+      if (entry_idx == 1 && !oe_ti.get_notnull()) {
+        return false;
+      }
+      ++entry_idx;
     }
+    return true;
   }
 
   return false;
@@ -97,12 +108,14 @@ std::vector<int8_t> pick_top_n_rows_from_dev_heaps(
     const size_t thread_count,
     const int device_id) {
   CHECK(!query_mem_desc.canOutputColumnar());
-  CHECK_EQ(ra_exe_unit.sort_info.order_entries.size(), size_t(1));
-  const auto& only_oe = ra_exe_unit.sort_info.order_entries.back();
-  const auto oe_col_idx = only_oe.tle_no - 1;
+  const auto& order_entries = ra_exe_unit.sort_info.order_entries;
+  CHECK_GE(order_entries.size(), size_t(1));
+  CHECK_LE(order_entries.size(), size_t(2));
+  const auto& primary_oe = order_entries.front();
+  const auto oe_col_idx = primary_oe.tle_no - 1;
   const auto n = ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit;
   const auto group_key_bytes = query_mem_desc.getEffectiveKeyWidth();
-  const PodOrderEntry pod_oe{only_oe.tle_no, only_oe.is_desc, only_oe.nulls_first};
+  const PodOrderEntry pod_oe{primary_oe.tle_no, primary_oe.is_desc, primary_oe.nulls_first};
   const auto key_slot_idx = get_heap_key_slot_index(ra_exe_unit.target_exprs, oe_col_idx);
   GroupByBufferLayoutInfo oe_layout{
       n * thread_count,
@@ -111,6 +124,23 @@ std::vector<int8_t> pick_top_n_rows_from_dev_heaps(
       query_mem_desc.getRowSize(),
       get_target_info(ra_exe_unit.target_exprs[oe_col_idx], g_bigint_count),
       -1};
+  std::unique_ptr<PodOrderEntry> pod_oe2;
+  std::unique_ptr<GroupByBufferLayoutInfo> oe_layout2;
+  if (order_entries.size() == 2) {
+    const auto& secondary_oe = order_entries.back();
+    const auto oe2_col_idx = secondary_oe.tle_no - 1;
+    pod_oe2.reset(new PodOrderEntry{
+        secondary_oe.tle_no, secondary_oe.is_desc, secondary_oe.nulls_first});
+    const auto key2_slot_idx =
+        get_heap_key_slot_index(ra_exe_unit.target_exprs, oe2_col_idx);
+    oe_layout2.reset(new GroupByBufferLayoutInfo{
+        n * thread_count,
+        query_mem_desc.getColOffInBytes(key2_slot_idx),
+        static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(oe2_col_idx)),
+        query_mem_desc.getRowSize(),
+        get_target_info(ra_exe_unit.target_exprs[oe2_col_idx], g_bigint_count),
+        -1});
+  }
   return pop_n_rows_from_merged_heaps_gpu(
       data_mgr,
       dev_heaps_buffer,
@@ -121,6 +151,8 @@ std::vector<int8_t> pick_top_n_rows_from_dev_heaps(
       oe_layout,
       group_key_bytes,
       thread_count,
-      device_id);
+      device_id,
+      pod_oe2.get(),
+      oe_layout2.get());
 }
 #endif  // HAVE_CUDA
@@ -55,6 +55,10 @@ extern "C" int32_t string_compress(const int64_t ptr_and_len,
 
 llvm::Value* CodeGenerator::codegen(const Analyzer::CharLengthExpr* expr,
                                     const CompilationOptions& co) {
+  auto fast_dict_length_lv = codegenDictCharLength(expr, co);
+  if (fast_dict_length_lv) {
+    return fast_dict_length_lv;
+  }
   auto str_lv = codegen(expr->get_arg(), true, co);
   if (str_lv.size() != 3) {
     CHECK_EQ(size_t(1), str_lv.size());
@@ -150,6 +154,41 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::LikeExpr* expr,
   return cgen_state_->emitCall(fn_name, str_like_args);
 }
 
+llvm::Value* CodeGenerator::codegenDictCharLength(const Analyzer::CharLengthExpr* expr,
+                                                  const CompilationOptions& co) {
+  if (!co.hoist_literals_) {
+    return nullptr;
+  }
+  const auto cast_oper = std::dynamic_pointer_cast<Analyzer::UOper>(expr->get_own_arg());
+  if (!cast_oper || cast_oper->get_optype() != kCAST) {
+    return nullptr;
+  }
+  const auto dict_arg = cast_oper->get_own_operand();
+  const auto& dict_arg_ti = dict_arg->get_type_info();
+  if (!dict_arg_ti.is_string() || dict_arg_ti.get_compression() != kENCODING_DICT) {
+    return nullptr;
+  }
+  const auto sdp = executor()->getStringDictionaryProxy(
+      dict_arg_ti.get_comp_param(), executor()->getRowSetMemoryOwner(), true);
+  // 4 bytes per distinct id; past this the table stops being an obvious win
+  // over decompressing row by row on CPU
+  if (sdp->storageEntryCount() > 16 * 1024 * 1024) {
+    return nullptr;
+  }
+  const auto dict_id_lvs = codegen(dict_arg.get(), true, co);
+  CHECK_EQ(size_t(1), dict_id_lvs.size());
+  std::unique_ptr<DictStringLengthTable> length_table(new DictStringLengthTable(
+      dict_arg_ti.get_comp_param(),
+      sdp,
+      expr->get_calc_encoded_length(),
+      co.device_type_ == ExecutorDeviceType::GPU ? Data_Namespace::GPU_LEVEL
+                                                 : Data_Namespace::CPU_LEVEL,
+      executor()->deviceCount(co.device_type_),
+      &executor()->getCatalog()->getDataMgr()));
+  return cgen_state_->addDictStringLengthTable(length_table)
+      ->codegen(dict_id_lvs.front(), executor());
+}
+
 llvm::Value* CodeGenerator::codegenDictLike(
     const std::shared_ptr<Analyzer::Expr> like_arg,
     const Analyzer::Constant* pattern,
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TableFunctions.h"
+
+#include "../Shared/SqlTypesLayout.h"
+
+#include <glog/logging.h>
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include <algorithm>
+
+namespace {
+
+// Reads element `row` of a native-width columnar buffer as a double, mapping
+// the column's inline null sentinel to NULL_DOUBLE.
+double read_input_value(const int8_t* col_buffer,
+                        const SQLTypeInfo& ti,
+                        const size_t row) {
+  if (ti.get_type() == kFLOAT) {
+    const auto val = reinterpret_cast<const float*>(col_buffer)[row];
+    return val == NULL_FLOAT ? NULL_DOUBLE : static_cast<double>(val);
+  }
+  if (ti.get_type() == kDOUBLE) {
+    return reinterpret_cast<const double*>(col_buffer)[row];
+  }
+  int64_t val{0};
+  switch (ti.get_size()) {
+    case 1:
+      val = col_buffer[row];
+      break;
+    case 2:
+      val = reinterpret_cast<const int16_t*>(col_buffer)[row];
+      break;
+    case 4:
+      val = reinterpret_cast<const int32_t*>(col_buffer)[row];
+      break;
+    case 8:
+      val = reinterpret_cast<const int64_t*>(col_buffer)[row];
+      break;
+    default:
+      CHECK(false);
+  }
+  return val == inline_int_null_val(ti) ? NULL_DOUBLE : static_cast<double>(val);
+}
+
+// ROW_COPIER(CURSOR, multiplier): repeats the single input column `multiplier`
+// times, as a DOUBLE column. Mostly useful as a smoke test for the framework.
+size_t row_copier(const std::vector<TableFunctionInputBatch>& inputs,
+                  const std::vector<int64_t>& scalar_args,
+                  TableFunctionOutputBatch& output) {
+  CHECK_EQ(size_t(1), inputs.size());
+  const auto& input = inputs.front();
+  CHECK_EQ(size_t(1), input.col_buffers.size());
+  CHECK_EQ(size_t(1), scalar_args.size());
+  CHECK_EQ(size_t(1), output.col_buffers.size());
+  const auto copy_multiplier = scalar_args.front();
+  const auto output_buffer = reinterpret_cast<double*>(output.col_buffers.front());
+  size_t out_row = 0;
+  for (int64_t copy = 0; copy < copy_multiplier; ++copy) {
+    for (size_t row = 0; row < input.row_count; ++row) {
+      CHECK_LT(out_row, output.allocated_rows);
+      output_buffer[out_row++] =
+          read_input_value(input.col_buffers.front(), input.col_types.front(), row);
+    }
+  }
+  return out_row;
+}
+
+}  // namespace
+
+std::unordered_map<std::string, TableFunction> TableFunctionRegistry::functions_;
+
+const TableFunction* TableFunctionRegistry::get(const std::string& name) {
+  if (functions_.empty()) {
+    registerBuiltins();
+  }
+  const auto it = functions_.find(boost::algorithm::to_upper_copy(name));
+  return it != functions_.end() ? &it->second : nullptr;
+}
+
+void TableFunctionRegistry::add(const TableFunction& table_function) {
+  functions_[boost::algorithm::to_upper_copy(table_function.name)] = table_function;
+}
+
+void TableFunctionRegistry::registerBuiltins() {
+  add({"ROW_COPIER",
+       size_t(1),
+       size_t(1),
+       [](const std::vector<size_t>& input_row_counts,
+          const std::vector<int64_t>& scalar_args) {
+         CHECK_EQ(size_t(1), input_row_counts.size());
+         CHECK_EQ(size_t(1), scalar_args.size());
+         return input_row_counts.front() *
+                static_cast<size_t>(std::max<int64_t>(scalar_args.front(), 0));
+       },
+       row_copier});
+}
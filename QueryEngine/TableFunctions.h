@@ -0,0 +1,88 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QUERYENGINE_TABLEFUNCTIONS_H
+#define QUERYENGINE_TABLEFUNCTIONS_H
+
+#include "../Shared/sqltypes.h"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Columnar batch handed to a table function. The buffers come straight from
+ * the columnar conversion of the cursor argument, so each column uses its
+ * native width (4 bytes for INT, 8 for BIGINT and DOUBLE and so on) and the
+ * usual inline null sentinels.
+ */
+struct TableFunctionInputBatch {
+  std::vector<const int8_t*> col_buffers;
+  std::vector<SQLTypeInfo> col_types;
+  size_t row_count;
+};
+
+/**
+ * Output batch filled by a table function. The executor preallocates one
+ * 8 byte slot per output column and row, matching the layout of a columnar
+ * projection result, and the function reports how many rows it produced.
+ */
+struct TableFunctionOutputBatch {
+  std::vector<int64_t*> col_buffers;
+  size_t allocated_rows;
+};
+
+using TableFunctionImpl =
+    std::function<size_t(const std::vector<TableFunctionInputBatch>&,
+                         const std::vector<int64_t>&,
+                         TableFunctionOutputBatch&)>;
+
+/**
+ * Descriptor for a table function: the SQL-visible name, the expected argument
+ * counts, an upper bound on the output cardinality (used to size the output
+ * buffers before the function runs) and the function itself.
+ */
+struct TableFunction {
+  std::string name;
+  size_t cursor_arg_count;
+  size_t scalar_arg_count;
+  std::function<size_t(const std::vector<size_t>& input_row_counts,
+                       const std::vector<int64_t>& scalar_args)>
+      output_row_capacity;
+  TableFunctionImpl impl;
+};
+
+/**
+ * Name keyed registry for table functions, in the spirit of
+ * ExtensionFunctionsWhitelist. The built-in functions are registered on first
+ * use; there is no facility for user defined table functions yet.
+ */
+class TableFunctionRegistry {
+ public:
+  // Returns the function registered under the given (case insensitive) name,
+  // or nullptr if there is no such function.
+  static const TableFunction* get(const std::string& name);
+
+  static void add(const TableFunction& table_function);
+
+ private:
+  static void registerBuiltins();
+
+  static std::unordered_map<std::string, TableFunction> functions_;
+};
+
+#endif  // QUERYENGINE_TABLEFUNCTIONS_H
@@ -19,6 +19,8 @@
 #include <Analyzer/Analyzer.h>
 #include <Shared/scope.h>
 
+#include <limits>
+
 namespace {
 
 template <typename T>
@@ -102,6 +104,17 @@ inline ExecutionOptions get_execution_options() {
       false, false, false, false, false, false, false, false, 0, false, false, 0};
 }
 
+// A nullable fixed-width column stores NULL as the narrow type's minimum, so
+// the observed range must leave that slot free.
+bool range_fits_in_bytes(const int64_t min_val,
+                         const int64_t max_val,
+                         const bool has_nulls,
+                         const size_t num_bytes) {
+  const int64_t type_min = -(1LL << (8 * num_bytes - 1));
+  const int64_t type_max = (1LL << (8 * num_bytes - 1)) - 1;
+  return min_val >= (has_nulls ? type_min + 1 : type_min) && max_val <= type_max;
+}
+
 }  // namespace
 
 void TableOptimizer::recomputeMetadata() const {
@@ -129,6 +142,30 @@ void TableOptimizer::recomputeMetadata() const {
     executor_->catalog_ = &cat_;
     const auto table_id = td->tableId;
 
+    auto* fragmenter = td->fragmenter;
+    CHECK(fragmenter);
+
+    // Only rescan fragments an update or delete has touched since the last
+    // recompute. Tables modified before the dirty marks existed carry none, so
+    // fall back to a full rescan when nothing is marked.
+    std::set<size_t> fragment_indexes;
+    const auto fragments = fragmenter->getFragmentsForQuery().fragments;
+    for (size_t fragment_index = 0; fragment_index < fragments.size();
+         ++fragment_index) {
+      if (fragments[fragment_index].isMetadataDirty()) {
+        fragment_indexes.insert(fragment_index);
+      }
+    }
+    if (fragment_indexes.empty()) {
+      for (size_t fragment_index = 0; fragment_index < fragments.size();
+           ++fragment_index) {
+        fragment_indexes.insert(fragment_index);
+      }
+    } else {
+      LOG(INFO) << "Incrementally recomputing metadata for " << fragment_indexes.size()
+                << " of " << fragments.size() << " fragments of table " << td->tableName;
+    }
+
     std::unordered_map</*fragment_id*/ int, size_t> tuple_count_map;
 
     // Special case handle $deleted column if it exists
@@ -219,11 +256,14 @@ void TableOptimizer::recomputeMetadata() const {
             tuple_count_map.emplace(std::make_pair(fragment_info.fragmentId, num_tuples));
           };
 
-      executor_->executeWorkUnitPerFragment(
-          ra_exe_unit, table_infos[0], co, eo, cat_, compute_deleted_callback);
+      executor_->executeWorkUnitPerFragment(ra_exe_unit,
+                                            table_infos[0],
+                                            co,
+                                            eo,
+                                            cat_,
+                                            compute_deleted_callback,
+                                            fragment_indexes);
 
-      auto* fragmenter = td->fragmenter;
-      CHECK(fragmenter);
       fragmenter->updateChunkStats(cd, stats_map);
     }  // finished special handling deleted column;
 
@@ -310,13 +350,17 @@ void TableOptimizer::recomputeMetadata() const {
                 std::make_pair(fragment_info.fragmentId, chunk_metadata.chunkStats));
           };
 
-      executor_->executeWorkUnitPerFragment(
-          ra_exe_unit, table_infos[0], co, eo, cat_, compute_metadata_callback);
+      executor_->executeWorkUnitPerFragment(ra_exe_unit,
+                                            table_infos[0],
+                                            co,
+                                            eo,
+                                            cat_,
+                                            compute_metadata_callback,
+                                            fragment_indexes);
 
-      auto* fragmenter = td->fragmenter;
-      CHECK(fragmenter);
       fragmenter->updateChunkStats(cd, stats_map);
     }
+    fragmenter->clearMetadataDirtyFlags();
     data_mgr.checkpoint(cat_.getCurrentDB().dbId, table_id);
     executor_->clearMetaInfoCache();
   }
@@ -332,3 +376,158 @@ void TableOptimizer::vacuumDeletedRows() const {
   cat_.vacuumDeletedRows(table_id);
   cat_.checkpoint(table_id);
 }
+
+std::vector<EncodingRecommendation> TableOptimizer::recommendEncodings() const {
+  CHECK_GE(td_->tableId, 0);
+
+  std::vector<const TableDescriptor*> table_descriptors;
+  if (td_->nShards > 0) {
+    const auto physical_tds = cat_.getPhysicalTablesDescriptors(td_);
+    table_descriptors.insert(
+        table_descriptors.begin(), physical_tds.begin(), physical_tds.end());
+  } else {
+    table_descriptors.push_back(td_);
+  }
+
+  // Aggregate the per-chunk ranges across all fragments (and shards for a
+  // sharded table); column ids are shared between the shards.
+  struct ObservedRange {
+    int64_t min_val{std::numeric_limits<int64_t>::max()};
+    int64_t max_val{std::numeric_limits<int64_t>::min()};
+    bool has_nulls{false};
+  };
+  std::map<int, ObservedRange> observed_ranges;
+  size_t total_rows{0};
+
+  for (const auto td : table_descriptors) {
+    auto* fragmenter = td->fragmenter;
+    CHECK(fragmenter);
+    for (const auto& fragment : fragmenter->getFragmentsForQuery().fragments) {
+      total_rows += fragment.getPhysicalNumTuples();
+      const auto& metadata_map = fragment.getChunkMetadataMapPhysical();
+      for (auto metadata_it = metadata_map.begin(); metadata_it != metadata_map.end();
+           ++metadata_it) {
+        const auto& metadata = metadata_it->second;
+        switch (metadata.sqlType.get_type()) {
+          case kSMALLINT:
+          case kINT:
+          case kBIGINT:
+          case kNUMERIC:
+          case kDECIMAL:
+          case kTIME:
+          case kTIMESTAMP:
+          case kDATE:
+            break;
+          default:
+            continue;
+        }
+        if (metadata.numElements == 0) {
+          continue;
+        }
+        auto& range = observed_ranges[metadata_it->first];
+        range.min_val = std::min(range.min_val,
+                                 extract_min_stat(metadata.chunkStats, metadata.sqlType));
+        range.max_val = std::max(range.max_val,
+                                 extract_max_stat(metadata.chunkStats, metadata.sqlType));
+        range.has_nulls |= metadata.chunkStats.has_nulls;
+      }
+    }
+  }
+
+  std::vector<EncodingRecommendation> recommendations;
+  const auto col_descs =
+      cat_.getAllColumnMetadataForTable(td_->tableId, false, false, false);
+  for (const auto& cd : col_descs) {
+    const auto& ti = cd->columnType;
+    if (ti.is_varlen()) {
+      continue;
+    }
+    const auto current_bytes = static_cast<size_t>(ti.get_size());
+    size_t recommended_bytes{0};
+    std::string encoding;
+    if (ti.is_string()) {
+      if (ti.get_compression() != kENCODING_DICT || current_bytes <= 1) {
+        continue;
+      }
+      const auto dd = cat_.getMetadataForDict(ti.get_comp_param());
+      if (!dd || !dd->stringDict) {
+        continue;
+      }
+      const size_t entry_count = dd->stringDict->storageEntryCount();
+      for (const size_t candidate_bytes : {size_t(1), size_t(2)}) {
+        if (candidate_bytes >= current_bytes) {
+          break;
+        }
+        // dictionaries only grow, so leave half the narrower id space as
+        // headroom before suggesting it
+        const size_t capacity = (size_t(1) << (8 * candidate_bytes - 1)) - 1;
+        if (entry_count <= capacity / 2) {
+          recommended_bytes = candidate_bytes;
+          break;
+        }
+      }
+      if (recommended_bytes) {
+        encoding = "DICT(" + std::to_string(8 * recommended_bytes) + ")";
+      }
+    } else {
+      std::vector<size_t> candidate_widths;
+      switch (ti.get_type()) {
+        case kSMALLINT:
+        case kINT:
+        case kBIGINT:
+          candidate_widths = {1, 2, 4};
+          break;
+        case kNUMERIC:
+        case kDECIMAL:
+          candidate_widths = {2, 4};
+          break;
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          // fixed time encodings store seconds in 32 bits; narrower date
+          // encodings change the unit to days and aren't comparable by the
+          // stored range alone
+          candidate_widths = {4};
+          break;
+        default:
+          continue;
+      }
+      const auto range_it = observed_ranges.find(cd->columnId);
+      if (range_it == observed_ranges.end() ||
+          range_it->second.min_val > range_it->second.max_val) {
+        continue;  // no stats, empty table or all-null chunks
+      }
+      const auto& range = range_it->second;
+      for (const auto candidate_bytes : candidate_widths) {
+        if (candidate_bytes >= current_bytes) {
+          break;
+        }
+        if (range_fits_in_bytes(
+                range.min_val, range.max_val, range.has_nulls, candidate_bytes)) {
+          recommended_bytes = candidate_bytes;
+          break;
+        }
+      }
+      if (recommended_bytes) {
+        encoding = "FIXED(" + std::to_string(8 * recommended_bytes) + ")";
+      }
+    }
+    if (!recommended_bytes) {
+      continue;
+    }
+    const size_t bytes_saved = current_bytes - recommended_bytes;
+    LOG(INFO) << "Encoding advisor: column " << cd->columnName << " of table "
+              << td_->tableName << " (" << ti.get_type_name() << ", " << current_bytes
+              << " bytes per value) fits ENCODING " << encoding << ", saving "
+              << bytes_saved << " bytes per row ("
+              << (bytes_saved * total_rows) / (1024 * 1024) << "MB over " << total_rows
+              << " rows)";
+    recommendations.push_back(
+        {cd->columnName, ti.get_type_name(), encoding, bytes_saved});
+  }
+  if (recommendations.empty()) {
+    LOG(INFO) << "Encoding advisor: no tighter encodings found for table "
+              << td_->tableName;
+  }
+  return recommendations;
+}
@@ -21,6 +21,16 @@
 #include <Shared/measure.h>
 #include "Shared/Logger.h"
 
+/**
+ * @brief A tighter encoding the observed data of a column would fit in.
+ */
+struct EncodingRecommendation {
+  std::string column_name;
+  std::string current_type;
+  std::string recommended_encoding;
+  size_t bytes_saved_per_row;
+};
+
 /**
  * @brief Driver for running cleanup processes on a table.
  * TableOptimizer provides functions for various cleanup processes that improve
@@ -55,6 +65,17 @@ class TableOptimizer {
    */
   void vacuumDeletedRows() const;
 
+  /**
+   * @brief Recommends tighter column encodings based on chunk statistics.
+   * Analyzes the per-chunk min/max ranges and dictionary cardinalities of the
+   * table and reports columns whose data would fit a narrower fixed or
+   * dictionary encoding. Run after recomputeMetadata() so the ranges reflect
+   * the current data. Recommendations are logged and returned; applying one
+   * still requires rewriting the table, since the encoding determines the
+   * on-disk chunk layout.
+   */
+  std::vector<EncodingRecommendation> recommendEncodings() const;
+
  private:
   const TableDescriptor* td_;
   Executor* executor_;
@@ -63,6 +63,10 @@ std::vector<std::string> agg_fn_base_names(const TargetInfo& target_info) {
       return {"agg_sum"};
     case kAPPROX_COUNT_DISTINCT:
       return {"agg_approximate_count_distinct"};
+    case kAPPROX_MEDIAN:
+      return {"agg_approx_median"};
+    case kAPPROX_TOP_K:
+      return {"agg_approx_top_k"};
     case kSAMPLE:
       return {"agg_id"};
     default:
@@ -354,6 +358,12 @@ void TargetExprCodegen::codegen(
       CHECK(!chosen_type.is_fp());
       group_by_and_agg->codegenCountDistinct(
           target_idx, target_expr, agg_args, query_mem_desc, co.device_type_);
+    } else if (target_info.agg_kind == kAPPROX_MEDIAN) {
+      CHECK_EQ(agg_chosen_bytes, sizeof(int64_t));
+      group_by_and_agg->codegenApproxMedian(target_expr, agg_args, co.device_type_);
+    } else if (target_info.agg_kind == kAPPROX_TOP_K) {
+      CHECK_EQ(agg_chosen_bytes, sizeof(int64_t));
+      group_by_and_agg->codegenApproxTopK(target_expr, agg_args, co.device_type_);
     } else {
       const auto& arg_ti = target_info.agg_arg_type;
       if (need_skip_null && !arg_ti.is_geometry()) {
@@ -29,16 +29,18 @@ enum class NullsOrdering { FIRST, LAST };
 
 template <typename KeyT = int64_t, typename IndexT = int32_t>
 struct KeyAccessor {
-  DEVICE KeyAccessor(const int8_t* key_buff,
-                     const size_t key_stride,
-                     const size_t key_idx)
+  DEVICE KeyAccessor(int8_t* key_buff, const size_t key_stride, const size_t key_idx)
       : buffer(key_buff), stride(key_stride), index(key_idx) {}
   ALWAYS_INLINE DEVICE KeyT get(const IndexT rowid) const {
     auto keys_ptr = reinterpret_cast<const KeyT*>(buffer + stride * rowid);
     return keys_ptr[index];
   }
+  ALWAYS_INLINE DEVICE void set(const IndexT rowid, const KeyT key) const {
+    auto keys_ptr = reinterpret_cast<KeyT*>(buffer + stride * rowid);
+    keys_ptr[index] = key;
+  }
 
-  const int8_t* buffer;
+  int8_t* buffer;
   const size_t stride;
   const size_t index;
 };
@@ -79,12 +81,58 @@ struct KeyComparator {
   const NullsOrdering nulls_ordering;
 };
 
-template <typename KeyT = int64_t, typename NodeT = int64_t>
+// The two-key composite variants below reuse the heap machinery, so the
+// helpers are generic over the comparator and accessor types.
+template <typename KeyT1, typename KeyT2>
+struct CompositeKey {
+  KeyT1 key1;
+  KeyT2 key2;
+};
+
+template <typename KeyT1, typename KeyT2, typename IndexT = int32_t>
+struct CompositeKeyAccessor {
+  DEVICE CompositeKeyAccessor(const KeyAccessor<KeyT1, IndexT>& key1_accessor,
+                              const KeyAccessor<KeyT2, IndexT>& key2_accessor)
+      : key1(key1_accessor), key2(key2_accessor) {}
+  ALWAYS_INLINE DEVICE CompositeKey<KeyT1, KeyT2> get(const IndexT rowid) const {
+    return {key1.get(rowid), key2.get(rowid)};
+  }
+  ALWAYS_INLINE DEVICE void set(const IndexT rowid,
+                                const CompositeKey<KeyT1, KeyT2>& key) const {
+    key1.set(rowid, key.key1);
+    key2.set(rowid, key.key2);
+  }
+
+  const KeyAccessor<KeyT1, IndexT> key1;
+  const KeyAccessor<KeyT2, IndexT> key2;
+};
+
+template <typename KeyT1, typename KeyT2>
+struct CompositeKeyComparator {
+  DEVICE CompositeKeyComparator(const KeyComparator<KeyT1>& key1_comparator,
+                                const KeyComparator<KeyT2>& key2_comparator)
+      : compare1(key1_comparator), compare2(key2_comparator) {}
+  ALWAYS_INLINE DEVICE bool operator()(const CompositeKey<KeyT1, KeyT2>& lhs,
+                                       const CompositeKey<KeyT1, KeyT2>& rhs) const {
+    if (compare1(lhs.key1, rhs.key1)) {
+      return true;
+    }
+    if (compare1(rhs.key1, lhs.key1)) {
+      return false;
+    }
+    return compare2(lhs.key2, rhs.key2);
+  }
+
+  const KeyComparator<KeyT1> compare1;
+  const KeyComparator<KeyT2> compare2;
+};
+
+template <typename NodeT, typename CompareT, typename AccessorT>
 ALWAYS_INLINE DEVICE void sift_down(NodeT* heap,
                                     const size_t heap_size,
                                     const NodeT curr_idx,
-                                    const KeyComparator<KeyT>& compare,
-                                    const KeyAccessor<KeyT, NodeT>& accessor) {
+                                    const CompareT& compare,
+                                    const AccessorT& accessor) {
   for (NodeT i = curr_idx, last = static_cast<NodeT>(heap_size); i < last;) {
 #ifdef __CUDACC__
     const auto left_child = min(2 * i + 1, last);
@@ -120,11 +168,11 @@ ALWAYS_INLINE DEVICE void sift_down(NodeT* heap,
   }
 }
 
-template <typename KeyT = int64_t, typename NodeT = int64_t>
+template <typename NodeT, typename CompareT, typename AccessorT>
 ALWAYS_INLINE DEVICE void sift_up(NodeT* heap,
                                   const NodeT curr_idx,
-                                  const KeyComparator<KeyT>& compare,
-                                  const KeyAccessor<KeyT, NodeT>& accessor) {
+                                  const CompareT& compare,
+                                  const AccessorT& accessor) {
   for (NodeT i = curr_idx; i > 0 && (i - 1) < i;) {
     const auto parent = (i - 1) / 2;
     const auto curr_key = accessor.get(heap[i]);
@@ -139,43 +187,34 @@ ALWAYS_INLINE DEVICE void sift_up(NodeT* heap,
   }
 }
 
-template <typename KeyT = int64_t, typename NodeT = int64_t>
+template <typename KeyT, typename NodeT, typename CompareT, typename AccessorT>
 ALWAYS_INLINE DEVICE void push_heap(int64_t* heap_ptr,
-                                    int64_t* rows_ptr,
                                     NodeT& node_count,
-                                    const uint32_t row_size_quad,
-                                    const uint32_t key_offset,
-                                    const KeyComparator<KeyT>& comparator,
-                                    const KeyAccessor<KeyT, NodeT>& accessor,
+                                    const CompareT& comparator,
+                                    const AccessorT& accessor,
                                     const KeyT curr_key) {
   const NodeT bin_index = node_count++;
   heap_ptr[bin_index] = bin_index;
-  int8_t* row_ptr = reinterpret_cast<int8_t*>(rows_ptr + bin_index * row_size_quad);
-  auto key_ptr = reinterpret_cast<KeyT*>(row_ptr + key_offset);
-  *key_ptr = curr_key;
+  accessor.set(bin_index, curr_key);
   // sift up
-  sift_up<KeyT, NodeT>(heap_ptr, bin_index, comparator, accessor);
+  sift_up(heap_ptr, bin_index, comparator, accessor);
 }
 
-template <typename KeyT = int64_t, typename NodeT = int64_t>
+template <typename KeyT, typename NodeT, typename CompareT, typename AccessorT>
 ALWAYS_INLINE DEVICE bool pop_and_push_heap(int64_t* heap_ptr,
-                                            int64_t* rows_ptr,
                                             const NodeT node_count,
-                                            const uint32_t row_size_quad,
-                                            const uint32_t key_offset,
-                                            const KeyComparator<KeyT>& compare,
-                                            const KeyAccessor<KeyT, NodeT>& accessor,
+                                            const CompareT& compare,
+                                            const AccessorT& accessor,
                                             const KeyT curr_key) {
   const NodeT top_bin_idx = static_cast<NodeT>(heap_ptr[0]);
-  int8_t* top_row_ptr = reinterpret_cast<int8_t*>(rows_ptr + top_bin_idx * row_size_quad);
-  auto top_key = reinterpret_cast<KeyT*>(top_row_ptr + key_offset);
-  if (compare(curr_key, *top_key)) {
+  const auto top_key = accessor.get(top_bin_idx);
+  if (compare(curr_key, top_key)) {
     return false;
   }
   // kick out
-  *top_key = curr_key;
+  accessor.set(top_bin_idx, curr_key);
   // sift down
-  sift_down<KeyT, NodeT>(heap_ptr, node_count, 0, compare, accessor);
+  sift_down(heap_ptr, node_count, static_cast<NodeT>(0), compare, accessor);
   return true;
 }
 
@@ -204,28 +243,15 @@ ALWAYS_INLINE DEVICE int64_t* get_bin_from_k_heap_impl(int64_t* heaps,
                                       row_size_quad * sizeof(int64_t),
                                       key_offset / sizeof(KeyT));
   if (node_count < static_cast<int64_t>(k)) {
-    push_heap(heap_ptr,
-              rows_ptr,
-              node_count,
-              row_size_quad,
-              key_offset,
-              compare,
-              accessor,
-              curr_key);
+    push_heap(heap_ptr, node_count, compare, accessor, curr_key);
     const auto last_bin_index = node_count - 1;
     auto row_ptr = rows_ptr + last_bin_index * row_size_quad;
     row_ptr[0] = last_bin_index;
     return row_ptr + 1;
   } else {
     const int64_t top_bin_idx = heap_ptr[0];
-    const bool rejected = !pop_and_push_heap(heap_ptr,
-                                             rows_ptr,
-                                             node_count,
-                                             row_size_quad,
-                                             key_offset,
-                                             compare,
-                                             accessor,
-                                             curr_key);
+    const bool rejected =
+        !pop_and_push_heap(heap_ptr, node_count, compare, accessor, curr_key);
     if (rejected) {
       return nullptr;
     }
@@ -261,3 +287,118 @@ DEF_GET_BIN_FROM_K_HEAP(int32_t)
 DEF_GET_BIN_FROM_K_HEAP(int64_t)
 DEF_GET_BIN_FROM_K_HEAP(float)
 DEF_GET_BIN_FROM_K_HEAP(double)
+
+#undef DEF_GET_BIN_FROM_K_HEAP
+
+// Two-key variant for composite ORDER BY (e.g. score DESC, ts ASC): the heap
+// ordering is decided by the first key and falls back to the second key on
+// ties, so the kept rows are exactly the top k under the composite order.
+template <typename KeyT1, typename KeyT2>
+ALWAYS_INLINE DEVICE int64_t* get_bin_from_k_heap_2keys_impl(int64_t* heaps,
+                                                             const uint32_t k,
+                                                             const uint32_t row_size_quad,
+                                                             const uint32_t key1_offset,
+                                                             const bool min_heap1,
+                                                             const bool has_null1,
+                                                             const bool nulls_first1,
+                                                             const KeyT1 null_key1,
+                                                             const KeyT1 curr_key1,
+                                                             const uint32_t key2_offset,
+                                                             const bool min_heap2,
+                                                             const bool has_null2,
+                                                             const bool nulls_first2,
+                                                             const KeyT2 null_key2,
+                                                             const KeyT2 curr_key2) {
+  const int32_t thread_global_index = pos_start_impl(nullptr);
+  const int32_t thread_count = pos_step_impl();
+  int64_t& node_count = heaps[thread_global_index];
+  int64_t* heap_ptr = heaps + thread_count + thread_global_index * k;
+  int64_t* rows_ptr =
+      heaps + thread_count + thread_count * k + thread_global_index * row_size_quad * k;
+  const KeyComparator<KeyT1> compare1(
+      (min_heap1 ? HeapOrdering::MIN : HeapOrdering::MAX),
+      has_null1,
+      null_key1,
+      nulls_first1 ? NullsOrdering::FIRST : NullsOrdering::LAST);
+  const KeyComparator<KeyT2> compare2(
+      (min_heap2 ? HeapOrdering::MIN : HeapOrdering::MAX),
+      has_null2,
+      null_key2,
+      nulls_first2 ? NullsOrdering::FIRST : NullsOrdering::LAST);
+  const CompositeKeyComparator<KeyT1, KeyT2> compare(compare1, compare2);
+  const KeyAccessor<KeyT1, int64_t> key1_accessor(reinterpret_cast<int8_t*>(rows_ptr),
+                                                  row_size_quad * sizeof(int64_t),
+                                                  key1_offset / sizeof(KeyT1));
+  const KeyAccessor<KeyT2, int64_t> key2_accessor(reinterpret_cast<int8_t*>(rows_ptr),
+                                                  row_size_quad * sizeof(int64_t),
+                                                  key2_offset / sizeof(KeyT2));
+  const CompositeKeyAccessor<KeyT1, KeyT2, int64_t> accessor(key1_accessor,
+                                                             key2_accessor);
+  const CompositeKey<KeyT1, KeyT2> curr_key{curr_key1, curr_key2};
+  if (node_count < static_cast<int64_t>(k)) {
+    push_heap(heap_ptr, node_count, compare, accessor, curr_key);
+    const auto last_bin_index = node_count - 1;
+    auto row_ptr = rows_ptr + last_bin_index * row_size_quad;
+    row_ptr[0] = last_bin_index;
+    return row_ptr + 1;
+  } else {
+    const int64_t top_bin_idx = heap_ptr[0];
+    const bool rejected =
+        !pop_and_push_heap(heap_ptr, node_count, compare, accessor, curr_key);
+    if (rejected) {
+      return nullptr;
+    }
+    auto row_ptr = rows_ptr + top_bin_idx * row_size_quad;
+    row_ptr[0] = top_bin_idx;
+    return row_ptr + 1;
+  }
+}
+
+#define DEF_GET_BIN_FROM_2K_HEAP(key1_type, key2_type)            \
+  extern "C" NEVER_INLINE DEVICE int64_t*                         \
+      get_bin_from_k_heap_2keys_##key1_type##_##key2_type(        \
+          int64_t* heaps,                                         \
+          const uint32_t k,                                       \
+          const uint32_t row_size_quad,                           \
+          const uint32_t key1_offset,                             \
+          const bool min_heap1,                                   \
+          const bool has_null1,                                   \
+          const bool nulls_first1,                                \
+          const key1_type null_key1,                              \
+          const key1_type curr_key1,                              \
+          const uint32_t key2_offset,                             \
+          const bool min_heap2,                                   \
+          const bool has_null2,                                   \
+          const bool nulls_first2,                                \
+          const key2_type null_key2,                              \
+          const key2_type curr_key2) {                            \
+    return get_bin_from_k_heap_2keys_impl(heaps,                  \
+                                          k,                      \
+                                          row_size_quad,          \
+                                          key1_offset,            \
+                                          min_heap1,              \
+                                          has_null1,              \
+                                          nulls_first1,           \
+                                          null_key1,              \
+                                          curr_key1,              \
+                                          key2_offset,            \
+                                          min_heap2,              \
+                                          has_null2,              \
+                                          nulls_first2,           \
+                                          null_key2,              \
+                                          curr_key2);             \
+  }
+
+#define DEF_GET_BIN_FROM_2K_HEAP_FIRST_KEY(key1_type) \
+  DEF_GET_BIN_FROM_2K_HEAP(key1_type, int32_t)        \
+  DEF_GET_BIN_FROM_2K_HEAP(key1_type, int64_t)        \
+  DEF_GET_BIN_FROM_2K_HEAP(key1_type, float)          \
+  DEF_GET_BIN_FROM_2K_HEAP(key1_type, double)
+
+DEF_GET_BIN_FROM_2K_HEAP_FIRST_KEY(int32_t)
+DEF_GET_BIN_FROM_2K_HEAP_FIRST_KEY(int64_t)
+DEF_GET_BIN_FROM_2K_HEAP_FIRST_KEY(float)
+DEF_GET_BIN_FROM_2K_HEAP_FIRST_KEY(double)
+
+#undef DEF_GET_BIN_FROM_2K_HEAP_FIRST_KEY
+#undef DEF_GET_BIN_FROM_2K_HEAP
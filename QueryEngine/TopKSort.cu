@@ -68,37 +68,49 @@ struct is_null_order_entry {
   const int64_t null_val;
 };
 
+// The stable variants preserve the relative order established by an earlier
+// sort on a secondary order entry.
+template <typename ForwardIterator, typename Predicate>
+ForwardIterator do_partition(ForwardIterator first,
+                             ForwardIterator last,
+                             const Predicate& pred,
+                             const bool stable) {
+  return stable ? thrust::stable_partition(first, last, pred)
+                : thrust::partition(first, last, pred);
+}
+
 template <typename ForwardIterator>
 ForwardIterator partition_by_null(ForwardIterator first,
                                   ForwardIterator last,
                                   const int64_t null_val,
                                   const bool nulls_first,
                                   const int8_t* rows_ptr,
-                                  const GroupByBufferLayoutInfo& layout) {
+                                  const GroupByBufferLayoutInfo& layout,
+                                  const bool stable = false) {
   if (nulls_first) {
     return (layout.col_bytes == 4)
-               ? thrust::partition(
-                     first,
-                     last,
-                     is_null_order_entry<int32_t>(
-                         rows_ptr + layout.col_off, layout.row_bytes, null_val))
-               : thrust::partition(
-                     first,
-                     last,
-                     is_null_order_entry<int64_t>(
-                         rows_ptr + layout.col_off, layout.row_bytes, null_val));
+               ? do_partition(first,
+                              last,
+                              is_null_order_entry<int32_t>(
+                                  rows_ptr + layout.col_off, layout.row_bytes, null_val),
+                              stable)
+               : do_partition(first,
+                              last,
+                              is_null_order_entry<int64_t>(
+                                  rows_ptr + layout.col_off, layout.row_bytes, null_val),
+                              stable);
   } else {
     return (layout.col_bytes == 4)
-               ? thrust::partition(
-                     first,
-                     last,
-                     thrust::not1(is_null_order_entry<int32_t>(
-                         rows_ptr + layout.col_off, layout.row_bytes, null_val)))
-               : thrust::partition(
-                     first,
-                     last,
-                     thrust::not1(is_null_order_entry<int64_t>(
-                         rows_ptr + layout.col_off, layout.row_bytes, null_val)));
+               ? do_partition(first,
+                              last,
+                              thrust::not1(is_null_order_entry<int32_t>(
+                                  rows_ptr + layout.col_off, layout.row_bytes, null_val)),
+                              stable)
+               : do_partition(first,
+                              last,
+                              thrust::not1(is_null_order_entry<int64_t>(
+                                  rows_ptr + layout.col_off, layout.row_bytes, null_val)),
+                              stable);
   }
 }
 
@@ -154,16 +166,30 @@ void sort_indices_by_key(thrust::device_ptr<I> d_idx_first,
                          const size_t idx_count,
                          const thrust::device_ptr<K>& d_key_buffer,
                          const bool desc,
-                         ThrustAllocator& allocator) {
+                         ThrustAllocator& allocator,
+                         const bool stable = false) {
   if (desc) {
-    thrust::sort_by_key(thrust::device(allocator),
-                        d_key_buffer,
-                        d_key_buffer + idx_count,
-                        d_idx_first,
-                        thrust::greater<K>());
+    if (stable) {
+      thrust::stable_sort_by_key(thrust::device(allocator),
+                                 d_key_buffer,
+                                 d_key_buffer + idx_count,
+                                 d_idx_first,
+                                 thrust::greater<K>());
+    } else {
+      thrust::sort_by_key(thrust::device(allocator),
+                          d_key_buffer,
+                          d_key_buffer + idx_count,
+                          d_idx_first,
+                          thrust::greater<K>());
+    }
   } else {
-    thrust::sort_by_key(
-        thrust::device(allocator), d_key_buffer, d_key_buffer + idx_count, d_idx_first);
+    if (stable) {
+      thrust::stable_sort_by_key(
+          thrust::device(allocator), d_key_buffer, d_key_buffer + idx_count, d_idx_first);
+    } else {
+      thrust::sort_by_key(
+          thrust::device(allocator), d_key_buffer, d_key_buffer + idx_count, d_idx_first);
+    }
   }
 }
 
@@ -173,7 +199,8 @@ void do_radix_sort(thrust::device_ptr<I> d_idx_first,
                    const int8_t* d_src_buffer,
                    const PodOrderEntry& oe,
                    const GroupByBufferLayoutInfo& layout,
-                   ThrustAllocator& allocator) {
+                   ThrustAllocator& allocator,
+                   const bool stable = false) {
   const auto& oe_type = layout.oe_target_info.sql_type;
   if (oe_type.is_fp()) {
     switch (layout.col_bytes) {
@@ -185,7 +212,7 @@ void do_radix_sort(thrust::device_ptr<I> d_idx_first,
                                    idx_count,
                                    layout.col_off,
                                    layout.row_bytes);
-        sort_indices_by_key(d_idx_first, idx_count, d_oe_buffer, oe.is_desc, allocator);
+        sort_indices_by_key(d_idx_first, idx_count, d_oe_buffer, oe.is_desc, allocator, stable);
       } break;
       case 8: {
         auto d_oe_buffer = get_device_ptr<double>(idx_count, allocator);
@@ -195,7 +222,7 @@ void do_radix_sort(thrust::device_ptr<I> d_idx_first,
                                    idx_count,
                                    layout.col_off,
                                    layout.row_bytes);
-        sort_indices_by_key(d_idx_first, idx_count, d_oe_buffer, oe.is_desc, allocator);
+        sort_indices_by_key(d_idx_first, idx_count, d_oe_buffer, oe.is_desc, allocator, stable);
       } break;
       default:
         CHECK(false);
@@ -212,7 +239,7 @@ void do_radix_sort(thrust::device_ptr<I> d_idx_first,
                                  idx_count,
                                  layout.col_off,
                                  layout.row_bytes);
-      sort_indices_by_key(d_idx_first, idx_count, d_oe_buffer, oe.is_desc, allocator);
+      sort_indices_by_key(d_idx_first, idx_count, d_oe_buffer, oe.is_desc, allocator, stable);
     } break;
     case 8: {
       auto d_oe_buffer = get_device_ptr<int64_t>(idx_count, allocator);
@@ -222,7 +249,7 @@ void do_radix_sort(thrust::device_ptr<I> d_idx_first,
                                  idx_count,
                                  layout.col_off,
                                  layout.row_bytes);
-      sort_indices_by_key(d_idx_first, idx_count, d_oe_buffer, oe.is_desc, allocator);
+      sort_indices_by_key(d_idx_first, idx_count, d_oe_buffer, oe.is_desc, allocator, stable);
     } break;
     default:
       CHECK(false);
@@ -283,7 +310,9 @@ std::vector<int8_t> pop_n_rows_from_merged_heaps_gpu(
     const GroupByBufferLayoutInfo& layout,
     const size_t group_key_bytes,
     const size_t thread_count,
-    const int device_id) {
+    const int device_id,
+    const PodOrderEntry* oe2,
+    const GroupByBufferLayoutInfo* layout2) {
   const auto row_size = layout.row_bytes;
   CHECK_EQ(heaps_size, streaming_top_n::get_heap_size(row_size, n, thread_count));
   const int8_t* rows_ptr = reinterpret_cast<const int8_t*>(dev_heaps) +
@@ -307,16 +336,34 @@ std::vector<int8_t> pop_n_rows_from_merged_heaps_gpu(
     return top_rows;
   }
 
+  const bool has_secondary_oe = oe2 != nullptr;
+  if (has_secondary_oe) {
+    CHECK(layout2);
+    // Order all candidates by the secondary key first, then stable sort /
+    // partition on the primary key so rows tied on the primary key keep the
+    // secondary order. The secondary key is NOT NULL (enforced by
+    // use_streaming_top_n), so no null partitioning is needed here.
+    do_radix_sort(
+        d_indices, actual_entry_count, rows_ptr, *oe2, *layout2, thrust_allocator);
+  }
+
   const auto& oe_type = layout.oe_target_info.sql_type;
   if (oe_type.get_notnull()) {
-    do_radix_sort(d_indices, actual_entry_count, rows_ptr, oe, layout, thrust_allocator);
+    do_radix_sort(d_indices,
+                  actual_entry_count,
+                  rows_ptr,
+                  oe,
+                  layout,
+                  thrust_allocator,
+                  has_secondary_oe);
   } else {
     auto separator = partition_by_null(d_indices,
                                        d_indices + actual_entry_count,
                                        null_val_bit_pattern(oe_type, false),
                                        oe.nulls_first,
                                        rows_ptr,
-                                       layout);
+                                       layout,
+                                       has_secondary_oe);
     if (oe.nulls_first) {
       const size_t null_count = separator - d_indices;
       if (null_count < actual_entry_count) {
@@ -325,12 +372,19 @@ std::vector<int8_t> pop_n_rows_from_merged_heaps_gpu(
                       rows_ptr,
                       oe,
                       layout,
-                      thrust_allocator);
+                      thrust_allocator,
+                      has_secondary_oe);
       }
     } else {
       const size_t nonnull_count = separator - d_indices;
       if (nonnull_count > 0) {
-        do_radix_sort(d_indices, nonnull_count, rows_ptr, oe, layout, thrust_allocator);
+        do_radix_sort(d_indices,
+                      nonnull_count,
+                      rows_ptr,
+                      oe,
+                      layout,
+                      thrust_allocator,
+                      has_secondary_oe);
       }
     }
   }
@@ -39,7 +39,9 @@ std::vector<int8_t> pop_n_rows_from_merged_heaps_gpu(
     const GroupByBufferLayoutInfo& layout,
     const size_t group_key_bytes,
     const size_t thread_count,
-    const int device_id);
+    const int device_id,
+    const PodOrderEntry* oe2 = nullptr,
+    const GroupByBufferLayoutInfo* layout2 = nullptr);
 
 #endif  // HAVE_CUDA
 
@@ -15,8 +15,10 @@
  */
 
 #include "WindowContext.h"
+#include <future>
 #include <numeric>
 #include "../Shared/checked_alloc.h"
+#include "../Shared/thread_count.h"
 #include "../Shared/sql_window_function_to_string.h"
 #include "Descriptors/CountDistinctDescriptor.h"
 #include "OutputBufferInitialization.h"
@@ -24,6 +26,9 @@
 #include "RuntimeFunctions.h"
 #include "TypePunning.h"
 
+bool g_enable_parallel_window_partition_sort{false};
+bool g_enable_parallel_window_partition_compute{false};
+
 WindowFunctionContext::WindowFunctionContext(
     const Analyzer::WindowFunction* window_func,
     const std::shared_ptr<JoinHashTableInterface>& partitions,
@@ -407,65 +412,51 @@ void WindowFunctionContext::compute() {
     }
   }
   std::unique_ptr<int64_t[]> scratchpad(new int64_t[elem_count_]);
-  int64_t off = 0;
-  for (size_t i = 0; i < partitionCount(); ++i) {
-    auto partition_size = counts()[i];
-    if (partition_size == 0) {
-      continue;
-    }
-    auto output_for_partition_buff = scratchpad.get() + offsets()[i];
-    std::iota(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              int64_t(0));
-    std::vector<Comparator> comparators;
-    const auto& order_keys = window_func_->getOrderKeys();
-    const auto& collation = window_func_->getCollation();
-    CHECK_EQ(order_keys.size(), collation.size());
-    for (size_t order_column_idx = 0; order_column_idx < order_columns_.size();
-         ++order_column_idx) {
-      auto order_column_buffer = order_columns_[order_column_idx];
-      const auto order_col =
-          dynamic_cast<const Analyzer::ColumnVar*>(order_keys[order_column_idx].get());
-      CHECK(order_col);
-      const auto& order_col_collation = collation[order_column_idx];
-      const auto asc_comparator = makeComparator(order_col,
-                                                 order_column_buffer,
-                                                 payload() + offsets()[i],
-                                                 order_col_collation.nulls_first);
-      auto comparator = asc_comparator;
-      if (order_col_collation.is_desc) {
-        comparator = [asc_comparator](const int64_t lhs, const int64_t rhs) {
-          return asc_comparator(rhs, lhs);
-        };
+  // Peer handling writes a shared end-of-group bitmap whose byte granularity
+  // doesn't allow concurrent writers, so those functions stay sequential.
+  const bool parallel_compute = g_enable_parallel_window_partition_compute &&
+                                partitionCount() > 1 &&
+                                !window_function_requires_peer_handling(window_func_);
+  const bool parallel_sort =
+      (g_enable_parallel_window_partition_sort || parallel_compute) &&
+      partitionCount() > 1;
+  if (parallel_sort) {
+    sortPartitions(scratchpad.get());
+  }
+  if (parallel_compute) {
+    computePartitionsParallel(scratchpad.get());
+  } else {
+    int64_t off = 0;
+    for (size_t i = 0; i < partitionCount(); ++i) {
+      auto partition_size = counts()[i];
+      if (partition_size == 0) {
+        continue;
       }
-      comparators.push_back(comparator);
-    }
-    const auto col_tuple_comparator = [&comparators](const int64_t lhs,
-                                                     const int64_t rhs) {
-      for (const auto& comparator : comparators) {
-        if (comparator(lhs, rhs)) {
-          return true;
-        }
+      auto output_for_partition_buff = scratchpad.get() + offsets()[i];
+      const auto col_tuple_comparator = createComparatorForPartition(i);
+      if (!parallel_sort) {
+        std::iota(output_for_partition_buff,
+                  output_for_partition_buff + partition_size,
+                  int64_t(0));
+        std::sort(output_for_partition_buff,
+                  output_for_partition_buff + partition_size,
+                  col_tuple_comparator);
       }
-      return false;
-    };
-    std::sort(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              col_tuple_comparator);
-    computePartition(output_for_partition_buff,
-                     partition_size,
-                     off,
-                     window_func_,
-                     col_tuple_comparator);
+      computePartition(output_for_partition_buff,
+                       partition_size,
+                       off,
+                       window_func_,
+                       col_tuple_comparator);
+      if (window_function_is_value(window_func_->getKind()) ||
+          window_function_is_aggregate(window_func_->getKind())) {
+        off += partition_size;
+      }
+    }
     if (window_function_is_value(window_func_->getKind()) ||
         window_function_is_aggregate(window_func_->getKind())) {
-      off += partition_size;
+      CHECK_EQ(static_cast<size_t>(off), elem_count_);
     }
   }
-  if (window_function_is_value(window_func_->getKind()) ||
-      window_function_is_aggregate(window_func_->getKind())) {
-    CHECK_EQ(static_cast<size_t>(off), elem_count_);
-  }
   auto output_i64 = reinterpret_cast<int64_t*>(output_);
   if (window_function_is_aggregate(window_func_->getKind())) {
     std::copy(scratchpad.get(), scratchpad.get() + elem_count_, output_i64);
@@ -638,6 +629,111 @@ WindowFunctionContext::makeComparator(const Analyzer::ColumnVar* col_var,
   throw std::runtime_error("Type not supported yet");
 }
 
+WindowFunctionContext::Comparator WindowFunctionContext::createComparatorForPartition(
+    const size_t partition_idx) const {
+  std::vector<Comparator> comparators;
+  const auto& order_keys = window_func_->getOrderKeys();
+  const auto& collation = window_func_->getCollation();
+  CHECK_EQ(order_keys.size(), collation.size());
+  for (size_t order_column_idx = 0; order_column_idx < order_columns_.size();
+       ++order_column_idx) {
+    auto order_column_buffer = order_columns_[order_column_idx];
+    const auto order_col =
+        dynamic_cast<const Analyzer::ColumnVar*>(order_keys[order_column_idx].get());
+    CHECK(order_col);
+    const auto& order_col_collation = collation[order_column_idx];
+    const auto asc_comparator = makeComparator(order_col,
+                                               order_column_buffer,
+                                               payload() + offsets()[partition_idx],
+                                               order_col_collation.nulls_first);
+    auto comparator = asc_comparator;
+    if (order_col_collation.is_desc) {
+      comparator = [asc_comparator](const int64_t lhs, const int64_t rhs) {
+        return asc_comparator(rhs, lhs);
+      };
+    }
+    comparators.push_back(comparator);
+  }
+  return [comparators](const int64_t lhs, const int64_t rhs) {
+    for (const auto& comparator : comparators) {
+      if (comparator(lhs, rhs)) {
+        return true;
+      }
+    }
+    return false;
+  };
+}
+
+void WindowFunctionContext::sortPartitions(int64_t* scratchpad) {
+  // Each partition's index buffer is sorted independently; the comparator sort
+  // dominates the window function cost, so stride the partitions across worker
+  // threads. The partition end bitmap and output writes stay on the calling
+  // thread in compute().
+  const size_t worker_count = cpu_threads();
+  std::vector<std::future<void>> sort_futures;
+  for (size_t worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
+    sort_futures.emplace_back(
+        std::async(std::launch::async, [this, scratchpad, worker_idx, worker_count] {
+          for (size_t i = worker_idx; i < partitionCount(); i += worker_count) {
+            const auto partition_size = counts()[i];
+            if (partition_size == 0) {
+              continue;
+            }
+            auto output_for_partition_buff = scratchpad + offsets()[i];
+            std::iota(output_for_partition_buff,
+                      output_for_partition_buff + partition_size,
+                      int64_t(0));
+            std::sort(output_for_partition_buff,
+                      output_for_partition_buff + partition_size,
+                      createComparatorForPartition(i));
+          }
+        }));
+  }
+  for (auto& sort_future : sort_futures) {
+    sort_future.wait();
+  }
+  for (auto& sort_future : sort_futures) {
+    sort_future.get();
+  }
+}
+
+void WindowFunctionContext::computePartitionsParallel(int64_t* scratchpad) {
+  const auto partition_count = partitionCount();
+  // Running payload offset of every partition, mirroring the sequential
+  // path's accumulated `off`.
+  std::vector<size_t> partition_end_offsets(partition_count);
+  std::partial_sum(counts(), counts() + partition_count, partition_end_offsets.begin());
+  if (window_function_is_value(window_func_->getKind()) ||
+      window_function_is_aggregate(window_func_->getKind())) {
+    CHECK_EQ(partition_end_offsets.back(), elem_count_);
+  }
+  const size_t worker_count = cpu_threads();
+  std::vector<std::future<void>> compute_futures;
+  for (size_t worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
+    compute_futures.emplace_back(std::async(
+        std::launch::async,
+        [this, scratchpad, &partition_end_offsets, worker_idx, worker_count] {
+          for (size_t i = worker_idx; i < partitionCount(); i += worker_count) {
+            const auto partition_size = counts()[i];
+            if (partition_size == 0) {
+              continue;
+            }
+            computePartition(scratchpad + offsets()[i],
+                             partition_size,
+                             partition_end_offsets[i] - partition_size,
+                             window_func_,
+                             createComparatorForPartition(i));
+          }
+        }));
+  }
+  for (auto& compute_future : compute_futures) {
+    compute_future.wait();
+  }
+  for (auto& compute_future : compute_futures) {
+    compute_future.get();
+  }
+}
+
 void WindowFunctionContext::computePartition(
     int64_t* output_for_partition_buff,
     const size_t partition_size,
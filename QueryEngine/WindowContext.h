@@ -128,6 +128,18 @@ class WindowFunctionContext {
                                    const int32_t* partition_indices,
                                    const bool nulls_first);
 
+  // Builds the multi-key order comparator for the given partition's rows.
+  Comparator createComparatorForPartition(const size_t partition_idx) const;
+
+  // Sorts every partition's index buffer into the scratchpad, striding the
+  // partitions across worker threads.
+  void sortPartitions(int64_t* scratchpad);
+
+  // Computes the window function over every sorted partition, striding the
+  // partitions across worker threads. Only valid for functions which don't
+  // require peer handling.
+  void computePartitionsParallel(int64_t* scratchpad);
+
   void computePartition(
       int64_t* output_for_partition_buff,
       const size_t partition_size,
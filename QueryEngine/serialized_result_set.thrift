@@ -76,6 +76,11 @@ struct TCountDistinctSet {
   3: i64 remote_ptr
 }
 
+// A large result may be split into several TSerializedRows messages sent for
+// the same query id. Each entry of `buffers` is compressed independently, so
+// the receiver can decompress and reduce one chunk while the next one is
+// still on the wire. `chunk_count` of zero (or absent, for senders predating
+// the field) means the whole result is carried by this single message.
 struct TSerializedRows {
   1: list<binary> buffers,
   2: list<i64> buffer_lengths,
@@ -86,5 +91,7 @@ struct TSerializedRows {
   7: list<i64> target_init_vals,
   8: list<binary> varlen_buffer,
   9: list<TCountDistinctSet> count_distinct_sets,
-  10: string explanation
+  10: string explanation,
+  11: i32 chunk_index,
+  12: i32 chunk_count
 }
@@ -383,7 +383,8 @@ ExecutionResult run_select_query_with_filter_push_down(
                                        eo.dynamic_watchdog_time_limit,
                                        /*find_push_down_candidates=*/false,
                                        /*just_calcite_explain=*/false,
-                                       eo.gpu_input_mem_limit_percent};
+                                       eo.gpu_input_mem_limit_percent,
+                                       eo.low_priority};
     return ra_executor.executeRelAlgQuery(new_query_ra, co, eo_modified, nullptr);
   } else {
     return result;
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHARED_ARENA_H
+#define SHARED_ARENA_H
+
+#include "CpuMemBudget.h"
+#include "checked_alloc.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * A chunked bump allocator for allocations which share a lifetime, like the
+ * scratch buffers a query makes while it executes. Memory is carved out of
+ * large blocks with simple pointer arithmetic and given back to the system all
+ * at once when the arena is destroyed, so many small allocations neither hit
+ * the system allocator individually nor require a long per-pointer free loop
+ * at the end. Allocations cannot be freed individually; the arena is not
+ * thread-safe and callers must synchronize access themselves.
+ */
+class Arena {
+ public:
+  explicit Arena(const size_t min_block_size = 1 << 20)
+      : min_block_size_(min_block_size), crt_ptr_(nullptr), bytes_left_(0) {}
+
+  ~Arena() {
+    for (auto block : blocks_) {
+      free(block);
+    }
+    release_cpu_mem(total_reserved_);
+  }
+
+  void* allocate(const size_t num_bytes) {
+    // Keep every allocation suitably aligned for any scalar payload.
+    const auto aligned_bytes = (num_bytes + kAlignment - 1) & ~(kAlignment - 1);
+    if (aligned_bytes > bytes_left_) {
+      const auto block_size = std::max(aligned_bytes, min_block_size_);
+      // Each arena belongs to one query's RowSetMemoryOwner, so the arena's
+      // reserved total is the metered footprint of that query; new blocks are
+      // checked against the per-query budget and accounted against the
+      // process-wide one.
+      if (g_cpu_query_mem_budget_bytes &&
+          total_reserved_ + block_size > g_cpu_query_mem_budget_bytes) {
+        throw OutOfHostMemory(block_size);
+      }
+      reserve_cpu_mem(block_size);
+      try {
+        crt_ptr_ = static_cast<int8_t*>(checked_malloc(block_size));
+      } catch (...) {
+        release_cpu_mem(block_size);
+        throw;
+      }
+      blocks_.push_back(crt_ptr_);
+      bytes_left_ = block_size;
+      total_reserved_ += block_size;
+    }
+    const auto ptr = crt_ptr_;
+    crt_ptr_ += aligned_bytes;
+    bytes_left_ -= aligned_bytes;
+    return ptr;
+  }
+
+  size_t totalReserved() const { return total_reserved_; }
+
+ private:
+  static const size_t kAlignment = 16;
+
+  const size_t min_block_size_;
+  std::vector<int8_t*> blocks_;
+  int8_t* crt_ptr_;
+  size_t bytes_left_;
+  size_t total_reserved_{0};
+};
+
+#endif  // SHARED_ARENA_H
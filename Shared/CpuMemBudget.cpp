@@ -0,0 +1,47 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CpuMemBudget.h"
+#include "checked_alloc.h"
+
+#include <atomic>
+
+size_t g_cpu_mem_budget_bytes{0};
+size_t g_cpu_query_mem_budget_bytes{0};
+
+namespace {
+
+std::atomic<size_t> g_cpu_mem_reserved{0};
+
+}  // namespace
+
+size_t cpu_mem_reserved() {
+  return g_cpu_mem_reserved.load();
+}
+
+void reserve_cpu_mem(const size_t num_bytes) {
+  const auto reserved = g_cpu_mem_reserved.fetch_add(num_bytes) + num_bytes;
+  if (g_cpu_mem_budget_bytes && reserved > g_cpu_mem_budget_bytes) {
+    g_cpu_mem_reserved.fetch_sub(num_bytes);
+    LOG(WARNING) << "CPU memory budget exceeded: " << reserved << " of "
+                 << g_cpu_mem_budget_bytes << " bytes reserved";
+    throw OutOfHostMemory(num_bytes);
+  }
+}
+
+void release_cpu_mem(const size_t num_bytes) {
+  g_cpu_mem_reserved.fetch_sub(num_bytes);
+}
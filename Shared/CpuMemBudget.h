@@ -0,0 +1,46 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHARED_CPUMEMBUDGET_H
+#define SHARED_CPUMEMBUDGET_H
+
+#include <cstddef>
+
+/**
+ * Process-wide accounting for the CPU memory queries reserve through metered
+ * allocators (today the arenas backing RowSetMemoryOwner, which carry result
+ * sets, columnar conversions and the small owned objects of a query). A plain
+ * checked_malloc only reports failure once the host is already thrashing;
+ * metering reservations against a configurable budget turns a runaway query
+ * into an OutOfHostMemory error while the server is still healthy. Budgets of
+ * zero disable enforcement, leaving only the accounting.
+ */
+
+// Cap on the total metered CPU memory across all queries, in bytes.
+extern size_t g_cpu_mem_budget_bytes;
+// Cap on the metered CPU memory a single query may hold, in bytes.
+extern size_t g_cpu_query_mem_budget_bytes;
+
+// Metered bytes currently reserved across the process.
+size_t cpu_mem_reserved();
+
+// Accounts num_bytes against the process-wide budget; throws OutOfHostMemory
+// when the reservation would exceed it. Every successful reservation must be
+// paired with a release of the same size.
+void reserve_cpu_mem(const size_t num_bytes);
+void release_cpu_mem(const size_t num_bytes);
+
+#endif  // SHARED_CPUMEMBUDGET_H
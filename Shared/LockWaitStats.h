@@ -0,0 +1,126 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    LockWaitStats.h
+ * @brief   Per-subsystem lock contention counters.
+ *
+ * Counts contended acquisitions of a few chokepoint locks (catalog,
+ * buffer manager, per-executor execute mutex) and the time spent waiting
+ * on them. Uncontended acquisitions cost one extra try_lock and are not
+ * counted, so the counters only move when threads actually queue up.
+ * Benchmarks read the counters to attribute tail latency to a subsystem.
+ */
+
+#ifndef LOCK_WAIT_STATS_H
+#define LOCK_WAIT_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace lock_wait_stats {
+
+enum class Subsystem { kCatalog, kBufferMgr, kExecutor };
+
+constexpr size_t kNumSubsystems{3};
+
+struct SubsystemStats {
+  std::atomic<uint64_t> contended_acquisitions{0};
+  std::atomic<uint64_t> wait_ns{0};
+};
+
+inline SubsystemStats& stats_for(const Subsystem subsystem) {
+  static SubsystemStats stats[kNumSubsystems];
+  return stats[static_cast<size_t>(subsystem)];
+}
+
+inline const char* subsystem_name(const Subsystem subsystem) {
+  switch (subsystem) {
+    case Subsystem::kCatalog:
+      return "catalog";
+    case Subsystem::kBufferMgr:
+      return "buffer_mgr";
+    case Subsystem::kExecutor:
+      return "executor";
+  }
+  return "unknown";
+}
+
+inline uint64_t contended_acquisitions(const Subsystem subsystem) {
+  return stats_for(subsystem).contended_acquisitions.load(std::memory_order_relaxed);
+}
+
+inline uint64_t wait_ns(const Subsystem subsystem) {
+  return stats_for(subsystem).wait_ns.load(std::memory_order_relaxed);
+}
+
+inline void reset() {
+  for (size_t i = 0; i < kNumSubsystems; ++i) {
+    auto& stats = stats_for(static_cast<Subsystem>(i));
+    stats.contended_acquisitions.store(0, std::memory_order_relaxed);
+    stats.wait_ns.store(0, std::memory_order_relaxed);
+  }
+}
+
+// Acquires a deferred std::unique_lock / std::shared_lock (or anything with
+// try_lock / lock), charging the blocking wait to the subsystem if the fast
+// path loses the race.
+template <typename LockType>
+void acquire_timed(LockType& lock, const Subsystem subsystem) {
+  if (lock.try_lock()) {
+    return;
+  }
+  const auto wait_start = std::chrono::steady_clock::now();
+  lock.lock();
+  const auto waited_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - wait_start)
+                             .count();
+  auto& stats = stats_for(subsystem);
+  stats.contended_acquisitions.fetch_add(1, std::memory_order_relaxed);
+  stats.wait_ns.fetch_add(waited_ns, std::memory_order_relaxed);
+}
+
+// Drop-in replacement for std::lock_guard on instrumented mutexes.
+template <typename MutexType>
+class TimedLockGuard {
+ public:
+  TimedLockGuard(MutexType& mutex, const Subsystem subsystem) : mutex_(mutex) {
+    if (!mutex_.try_lock()) {
+      const auto wait_start = std::chrono::steady_clock::now();
+      mutex_.lock();
+      const auto waited_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - wait_start)
+                                 .count();
+      auto& stats = stats_for(subsystem);
+      stats.contended_acquisitions.fetch_add(1, std::memory_order_relaxed);
+      stats.wait_ns.fetch_add(waited_ns, std::memory_order_relaxed);
+    }
+  }
+
+  ~TimedLockGuard() { mutex_.unlock(); }
+
+  TimedLockGuard(const TimedLockGuard&) = delete;
+  TimedLockGuard& operator=(const TimedLockGuard&) = delete;
+
+ private:
+  MutexType& mutex_;
+};
+
+}  // namespace lock_wait_stats
+
+#endif  // LOCK_WAIT_STATS_H
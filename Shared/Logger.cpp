@@ -19,8 +19,10 @@
 #include "Logger.h"
 #include <boost/algorithm/string.hpp>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <regex>
+#include <vector>
 
 namespace logger {
 
@@ -75,6 +77,11 @@ LogOptions::LogOptions(char const* argv0) : options_("Logging") {
   options_.add_options()("log-auto-flush",
                          po::value<bool>(&auto_flush_)->default_value(auto_flush_),
                          "Flush logging buffer to file after each message.");
+  options_.add_options()(
+      "log-async",
+      po::value<bool>(&async_)->default_value(async_),
+      "Format and write log records on a background thread; logging threads only "
+      "enqueue the record, keeping file I/O off the query hot path.");
   options_.add_options()("log-max-files",
                          po::value<size_t>(&max_files_)->default_value(max_files_),
                          "Maximum number of log files to keep.");
@@ -218,6 +225,23 @@ BOOST_NORETURN Logger<Severity::FATAL>::~Logger() {
 
 using ClogSync = sinks::synchronous_sink<sinks::text_ostream_backend>;
 using FileSync = sinks::synchronous_sink<sinks::text_file_backend>;
+using ClogAsync = sinks::asynchronous_sink<sinks::text_ostream_backend>;
+using FileAsync = sinks::asynchronous_sink<sinks::text_file_backend>;
+
+// Asynchronous sinks own a feeding thread which must be stopped and drained
+// before the core drops the sinks, or queued records are lost on shutdown.
+std::mutex g_async_sinks_mutex;
+std::vector<std::function<void()>> g_async_sink_drainers;
+
+template <typename ASYNC_SINK>
+boost::shared_ptr<ASYNC_SINK> register_async_sink(boost::shared_ptr<ASYNC_SINK> sink) {
+  std::lock_guard<std::mutex> lock(g_async_sinks_mutex);
+  g_async_sink_drainers.emplace_back([sink] {
+    sink->stop();
+    sink->flush();
+  });
+  return sink;
+}
 
 template <typename CONSOLE_SINK>
 boost::shared_ptr<CONSOLE_SINK> make_sink(LogOptions const& log_opts) {
@@ -245,14 +269,23 @@ void init(LogOptions const& log_opts) {
     Severity const min_sink_level = std::max(Severity::INFO, log_opts.severity_);
     for (int i = min_sink_level; i < Severity::NLEVELS; ++i) {
       Severity const level = static_cast<Severity>(i);
-      core->add_sink(make_sink<FileSync>(log_opts, full_log_dir, level));
+      if (log_opts.async_) {
+        core->add_sink(
+            register_async_sink(make_sink<FileAsync>(log_opts, full_log_dir, level)));
+      } else {
+        core->add_sink(make_sink<FileSync>(log_opts, full_log_dir, level));
+      }
     }
     g_min_active_severity = std::min(g_min_active_severity, log_opts.severity_);
     if (log_dir_was_created) {
       LOG(INFO) << "Log directory(" << full_log_dir.native() << ") created.";
     }
   }
-  core->add_sink(make_sink<ClogSync>(log_opts));
+  if (log_opts.async_) {
+    core->add_sink(register_async_sink(make_sink<ClogAsync>(log_opts)));
+  } else {
+    core->add_sink(make_sink<ClogSync>(log_opts));
+  }
   g_min_active_severity = std::min(g_min_active_severity, log_opts.severity_clog_);
 }
 
@@ -264,6 +297,15 @@ void set_once_fatal_func(FatalFunc fatal_func) {
 }
 
 void shutdown() {
+  {
+    // Stop the feeding threads and write out anything still queued - this also
+    // covers LOG(FATAL), whose record would otherwise die with the process.
+    std::lock_guard<std::mutex> lock(g_async_sinks_mutex);
+    for (auto& drain : g_async_sink_drainers) {
+      drain();
+    }
+    g_async_sink_drainers.clear();
+  }
   boost::log::core::get()->remove_all_sinks();
 }
 
@@ -97,6 +97,7 @@ class LogOptions {
   Severity severity_{Severity::INFO};
   Severity severity_clog_{Severity::WARNING};
   bool auto_flush_{true};
+  bool async_{false};
   size_t max_files_{100};
   size_t min_free_space_{20 << 20};
   bool rotate_daily_{true};
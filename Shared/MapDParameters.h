@@ -39,6 +39,13 @@ struct MapDParameters {
   bool is_decr_start_epoch;         // are we doing a start epoch decrement?
   size_t cpu_buffer_mem_bytes = 0;  // max size of memory reserved for CPU buffers [bytes]
   size_t gpu_buffer_mem_bytes = 0;  // max size of memory reserved for GPU buffers [bytes]
+  size_t cpu_slab_size_bytes = 0;   // size of each CPU buffer pool slab, 0 = default
+  size_t gpu_slab_size_bytes = 0;   // size of each GPU buffer pool slab, 0 = default
+  size_t cpu_buffer_huge_page_size = 0;  // back CPU slabs with explicit huge pages of
+                                         // this size (e.g. 2MB/1GB), 0 = normal pages
+  std::string nvme_cache_path;       // directory on local flash for the NVMe chunk
+                                     // cache between disk and CPU, empty = disabled
+  size_t nvme_cache_size_bytes = 0;  // max size of the NVMe chunk cache [bytes]
   double gpu_input_mem_limit = 0.9;  // Punt query to CPU if input mem exceeds % GPU mem
   std::string ssl_cert_file = "";    // file path to server's certified PKI certificate
   std::string ssl_key_file = "";     // file path to server's' private PKI key
@@ -47,6 +54,10 @@ struct MapDParameters {
   bool aggregator = false;
   bool enable_calcite_view_optimize =
       true;  // allow calcite to optimize the relalgebra for a view query
+  bool enable_calcite_jni =
+      false;  // run the calcite planner in-process over JNI instead of thrift
+  size_t max_concurrent_queries = 0;  // cap on concurrently executing queries,
+                                      // 0 means unbounded
   MapDParameters() : cuda_block_size(0), cuda_grid_size(0), calcite_max_mem(1024) {}
 };
 
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ThreadPool.h"
+
+#include "thread_count.h"
+
+namespace ThreadPool_NS {
+
+namespace {
+
+// Set for pool workers so nested submissions can be detected and diverted to
+// their own thread instead of deadlocking the fixed-size pool.
+thread_local bool t_is_pool_worker{false};
+
+}  // namespace
+
+ThreadPool& ThreadPool::instance() {
+  static ThreadPool pool;
+  return pool;
+}
+
+ThreadPool::ThreadPool() {
+  const int worker_count = cpu_threads();
+  workers_.reserve(worker_count);
+  for (int i = 0; i < worker_count; ++i) {
+    workers_.emplace_back([this] { workerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    shutdown_ = true;
+  }
+  queue_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task,
+                                     TaskGroup* group,
+                                     const Priority priority) {
+  if (t_is_pool_worker) {
+    return std::async(std::launch::async, std::move(task));
+  }
+  Task pool_task{std::packaged_task<void()>(std::move(task)), group};
+  auto future = pool_task.work.get_future();
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    (priority == Priority::kHigh ? high_queue_ : normal_queue_)
+        .push_back(std::move(pool_task));
+  }
+  queue_cv_.notify_one();
+  return future;
+}
+
+bool ThreadPool::popRunnableTask(Task& task) {
+  for (auto* queue : {&high_queue_, &normal_queue_}) {
+    for (auto task_it = queue->begin(); task_it != queue->end(); ++task_it) {
+      auto* group = task_it->group;
+      if (!group || group->running_.load() < group->max_concurrency_) {
+        if (group) {
+          ++group->running_;
+        }
+        task = std::move(*task_it);
+        queue->erase(task_it);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ThreadPool::workerLoop() {
+  t_is_pool_worker = true;
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this, &task] { return popRunnableTask(task) || shutdown_; });
+      if (!task.work.valid()) {
+        return;  // shut down with nothing runnable left
+      }
+    }
+    task.work();  // exceptions land in the future
+    if (task.group) {
+      --task.group->running_;
+      // a task of this group may have been skipped as over the cap
+      queue_cv_.notify_all();
+    }
+  }
+}
+
+}  // namespace ThreadPool_NS
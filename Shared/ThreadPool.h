@@ -0,0 +1,92 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ThreadPool_NS {
+
+enum class Priority { kHigh, kNormal };
+
+/**
+ * @type TaskGroup
+ * @brief Caps how many tasks submitted under this group may run at once, so a
+ * single bulk operation cannot occupy every pool worker while other
+ * operations are queued. Must outlive the futures of tasks submitted with it.
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(const int max_concurrency) : max_concurrency_(max_concurrency) {}
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+ private:
+  friend class ThreadPool;
+  const int max_concurrency_;
+  std::atomic<int> running_{0};
+};
+
+/**
+ * @type ThreadPool
+ * @brief Process-wide pool of cpu_threads() workers for the short-lived thread
+ * batches that imports, reductions and columnar conversions used to spawn with
+ * std::async each. Concurrent operations share the fixed worker set instead of
+ * oversubscribing cores; high priority tasks run before queued normal ones and
+ * a TaskGroup caps one operation's share of the workers. Tasks must not block
+ * on other pool tasks - submissions made from inside a pool worker fall back
+ * to a dedicated thread for exactly that reason.
+ */
+class ThreadPool {
+ public:
+  static ThreadPool& instance();
+
+  std::future<void> submit(std::function<void()> task,
+                           TaskGroup* group = nullptr,
+                           const Priority priority = Priority::kNormal);
+
+  ~ThreadPool();
+
+ private:
+  ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  struct Task {
+    std::packaged_task<void()> work;
+    TaskGroup* group{nullptr};
+  };
+
+  // Pops the first queued task whose group still has capacity and accounts
+  // for it in the group; must be called with queue_mutex_ held.
+  bool popRunnableTask(Task& task);
+  void workerLoop();
+
+  std::vector<std::thread> workers_;
+  std::deque<Task> high_queue_;
+  std::deque<Task> normal_queue_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  bool shutdown_{false};
+};
+
+}  // namespace ThreadPool_NS
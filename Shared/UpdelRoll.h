@@ -20,10 +20,12 @@
 #include <mutex>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "../Chunk/Chunk.h"
 #include "../DataMgr/ChunkMetadata.h"
 #include "../DataMgr/MemoryLevel.h"
+#include "mapd_shared_mutex.h"
 
 namespace Fragmenter_Namespace {
 class InsertOrderFragmenter;
@@ -52,6 +54,14 @@ struct UpdelRoll {
   std::map<Chunk_NS::Chunk*, std::shared_ptr<Chunk_NS::Chunk>> dirtyChunks;
   std::set<ChunkKey> dirtyChunkeys;
 
+  // exclusive fragment locks held for the life of the statement (under the
+  // table's intent-exclusive lock) so another DML statement cannot interleave
+  // in-place changes on the same fragments before this one commits or rolls
+  // back; lockedFragments keeps each fragment from being locked twice when a
+  // statement updates several columns of it
+  std::vector<mapd_unique_lock<mapd_shared_mutex>> fragmentLocks;
+  std::set<ChunkKey> lockedFragments;
+
   // new FragmentInfo.numTuples
   std::map<MetaDataKey, size_t> numTuples;
 
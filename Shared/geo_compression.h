@@ -26,6 +26,8 @@
 
 #include "funcannotations.h"
 
+#include <cstddef>
+
 namespace Geo_namespace {
 
 DEVICE inline double decompress_longitude_coord_geoint32(const int32_t compressed) {
@@ -40,6 +42,19 @@ DEVICE inline double decompress_lattitude_coord_geoint32(const int32_t compresse
          4.1909515877212172e-08;  // // (90.0 / 2147483647.0)
 }
 
+// Batch decompression of an interleaved lon/lat geoint32 vertex array. The
+// loop body is two constant multiplies with no per-element dispatch, so the
+// compiler is free to vectorize it; prefer this over per-coordinate calls
+// when a whole vertex array is being decoded at once.
+DEVICE inline void decompress_geoint32_coords(const int32_t* compressed,
+                                              double* decompressed,
+                                              const size_t num_coords) {
+  for (size_t i = 0; i < num_coords; i += 2) {
+    decompressed[i] = decompress_longitude_coord_geoint32(compressed[i]);
+    decompressed[i + 1] = decompress_lattitude_coord_geoint32(compressed[i + 1]);
+  }
+}
+
 DEVICE inline uint64_t compress_longitude_coord_geoint32(const double coord) {
   // compress longitude: -180..180  --->  -2,147,483,647..2,147,483,647
   int32_t compressed_coord = static_cast<int32_t>(coord * (2147483647.0 / 180.0));
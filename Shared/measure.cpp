@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "measure.h"
+
+#include <algorithm>
+#include <map>
+
+std::shared_ptr<StageTimingCollector> StageTimingCollector::active_;
+thread_local int StageTimingCollector::depth_{0};
+
+size_t StageTimingCollector::beginEntry(const std::string& description,
+                                        const std::string& func) {
+  const auto start_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back(
+      Entry{description, func, depth_++, std::this_thread::get_id(), start_us, -1});
+  return entries_.size() - 1;
+}
+
+void StageTimingCollector::endEntry(const size_t index, const int64_t elapsed_us) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK_LT(index, entries_.size());
+  entries_[index].elapsed_us = elapsed_us;
+  --depth_;
+}
+
+std::string StageTimingCollector::report() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream oss;
+  oss << std::setfill(' ') << std::left << std::setw(60) << "Stage" << std::right
+      << std::setw(12) << "Time(ms)"
+      << "\n";
+  std::map<std::thread::id, size_t> thread_ordinals;
+  for (const auto& entry : entries_) {
+    thread_ordinals.emplace(entry.thread_id, thread_ordinals.size());
+  }
+  for (const auto& entry : entries_) {
+    std::string label(2 * entry.depth, ' ');
+    label += entry.description;
+    const auto thread_ordinal = thread_ordinals[entry.thread_id];
+    if (thread_ordinal) {
+      label += " [thread " + std::to_string(thread_ordinal) + "]";
+    }
+    oss << std::left << std::setw(60) << label << std::right << std::setw(12);
+    if (entry.elapsed_us < 0) {
+      oss << "-";
+    } else {
+      oss << std::fixed << std::setprecision(2)
+          << static_cast<double>(entry.elapsed_us) / 1000.;
+    }
+    oss << "\n";
+  }
+  return oss.str();
+}
+
+std::string StageTimingCollector::chromeTrace() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::thread::id, size_t> thread_ordinals;
+  for (const auto& entry : entries_) {
+    thread_ordinals.emplace(entry.thread_id, thread_ordinals.size());
+  }
+  std::ostringstream oss;
+  oss << "{\"traceEvents\": [";
+  bool first = true;
+  for (const auto& entry : entries_) {
+    if (!first) {
+      oss << ", ";
+    }
+    first = false;
+    oss << "{\"name\": \"" << entry.description << "\", \"cat\": \"query\", "
+        << "\"ph\": \"X\", \"ts\": " << entry.start_us
+        << ", \"dur\": " << std::max(entry.elapsed_us, int64_t(0))
+        << ", \"pid\": 1, \"tid\": " << thread_ordinals[entry.thread_id]
+        << ", \"args\": {\"func\": \"" << entry.func << "\"}}";
+  }
+  oss << "]}";
+  return oss.str();
+}
@@ -19,7 +19,12 @@
 
 #include <chrono>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 #include "Logger.h"
 
 extern bool g_enable_debug_timer;
@@ -64,11 +69,60 @@ std::string timer_lap(Type clock_begin, Type& clock_last) {
   return oss.str();
 }
 
+// Collects the INJECT_TIMER stages hit while a query executes, preserving
+// start order and nesting depth, so EXPLAIN ANALYZE can render a per-stage
+// timing breakdown from the same probes g_enable_debug_timer logs. At most
+// one collector is active at a time; entries from worker threads spawned
+// during execution are captured too and tagged with a thread ordinal.
+class StageTimingCollector {
+ public:
+  struct Entry {
+    std::string description;
+    std::string func;
+    int depth;
+    std::thread::id thread_id;
+    int64_t start_us{0};     // since the steady clock epoch
+    int64_t elapsed_us{-1};  // -1 until the stage finishes
+  };
+
+  size_t beginEntry(const std::string& description, const std::string& func);
+  void endEntry(const size_t index, const int64_t elapsed_us);
+
+  std::string report() const;
+
+  // The same spans as Chrome trace-event JSON, one complete event per entry
+  // with the thread ordinal as the tid, for chrome://tracing and compatible
+  // viewers.
+  std::string chromeTrace() const;
+
+  // Timers hold a shared_ptr to the collector they started against, so a
+  // collector deactivated mid-stage stays alive until its last timer ends.
+  static std::shared_ptr<StageTimingCollector> getActive() {
+    return std::atomic_load(&active_);
+  }
+  static void setActive(const std::shared_ptr<StageTimingCollector>& collector) {
+    std::atomic_store(&active_, collector);
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+
+  static std::shared_ptr<StageTimingCollector> active_;
+  static thread_local int depth_;
+};
+
 struct InjectTimer {
   InjectTimer(std::string const& description, int const& lineNum, std::string const& func)
       : description_(description), lineNum_(lineNum), func_(func) {
-    if (g_enable_debug_timer) {
+    collector_ = StageTimingCollector::getActive();
+    if (g_enable_debug_timer || collector_) {
       start_ = timer_start();
+    }
+    if (collector_) {
+      entry_index_ = collector_->beginEntry(description_, func_);
+    }
+    if (g_enable_debug_timer) {
       LOG(INFO) << "Timer start " << std::setfill(' ') << std::setw(35) << description_
                 << " " << std::setw(35) << func_ << ":" << std::setw(5) << lineNum_;
     }
@@ -80,6 +134,11 @@ struct InjectTimer {
                 << " " << std::setw(35) << func_ << ":" << std::setw(5) << lineNum_
                 << " elapsed " << timer_stop(start_) << " ms";
     }
+    if (collector_) {
+      collector_->endEntry(entry_index_,
+                           timer_stop<std::chrono::steady_clock::time_point,
+                                      std::chrono::microseconds>(start_));
+    }
   }
 
   std::string description_;
@@ -87,6 +146,8 @@ struct InjectTimer {
   std::string func_;
 
   std::chrono::steady_clock::time_point start_;
+  std::shared_ptr<StageTimingCollector> collector_;
+  size_t entry_index_{0};
 };
 #define INJECT_TIMER(DESC) InjectTimer DESC(#DESC, __LINE__, __FUNCTION__)
 
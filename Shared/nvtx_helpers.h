@@ -0,0 +1,54 @@
+/*
+ * Copyright 2018 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHARED_NVTX_HELPERS_H
+#define SHARED_NVTX_HELPERS_H
+
+#ifdef HAVE_NVTX
+
+#include <nvToolsExt.h>
+
+#include <string>
+
+namespace nvtx_helpers {
+
+// RAII wrapper for an NVTX range on the calling thread. Ranges nest, so a
+// range pushed around a kernel launch or copy shows up under any enclosing
+// range pushed on the same thread in the Nsight timeline.
+class Range {
+ public:
+  explicit Range(const char* name) { nvtxRangePushA(name); }
+  explicit Range(const std::string& name) { nvtxRangePushA(name.c_str()); }
+  Range(const Range&) = delete;
+  Range& operator=(const Range&) = delete;
+  ~Range() { nvtxRangePop(); }
+};
+
+}  // namespace nvtx_helpers
+
+// Annotates the enclosing scope as an NVTX range so the kernels, copies and
+// allocations issued from it can be attributed in Nsight. NAME may be a string
+// literal or a std::string expression; it is only evaluated when the build
+// enables NVTX (cmake -DENABLE_NVTX=on), otherwise the macro compiles away.
+#define NVTX_RANGE(NAME) const nvtx_helpers::Range nvtx_scope_range_(NAME)
+
+#else  // HAVE_NVTX
+
+#define NVTX_RANGE(NAME)
+
+#endif  // HAVE_NVTX
+
+#endif  // SHARED_NVTX_HELPERS_H
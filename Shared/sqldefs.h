@@ -68,7 +68,17 @@ enum SQLOps {
 
 enum SQLQualifier { kONE, kANY, kALL };
 
-enum SQLAgg { kAVG, kMIN, kMAX, kSUM, kCOUNT, kAPPROX_COUNT_DISTINCT, kSAMPLE };
+enum SQLAgg {
+  kAVG,
+  kMIN,
+  kMAX,
+  kSUM,
+  kCOUNT,
+  kAPPROX_COUNT_DISTINCT,
+  kSAMPLE,
+  kAPPROX_MEDIAN,
+  kAPPROX_TOP_K
+};
 
 enum class SqlWindowFunctionKind {
   ROW_NUMBER,
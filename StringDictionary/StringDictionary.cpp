@@ -16,6 +16,7 @@
 
 #include "StringDictionary.h"
 #include "../Shared/sqltypes.h"
+#include "../Shared/measure.h"
 #include "../Utils/Regexp.h"
 #include "../Utils/StringLike.h"
 #include "LeafHostInfo.h"
@@ -28,12 +29,54 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/sort/spreadsort/string_sort.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <future>
 #include <thread>
 
+bool g_enable_string_dict_index_cache{false};
+
+// Resolve ILIKE equality and prefix patterns through a lazily built
+// case-folded inverted index instead of scanning every dictionary entry.
+// Costs roughly one folded copy of the dictionary in memory once the first
+// such pattern arrives.
+bool g_enable_folded_dict_index{false};
+
+// Persist the sorted-id permutation (sorted_cache) at checkpoint and restore
+// it on recovery, so range predicates and ORDER BY on dictionary columns do
+// not pay a full re-sort of the dictionary after every restart.
+bool g_enable_sorted_dict_cache{false};
+
 namespace {
 const int SYSTEM_PAGE_SIZE = getpagesize();
 
+// On-disk header for the persisted hash index ("DictIndex"). The index is a
+// point-in-time snapshot written at checkpoint; a snapshot whose string count
+// does not exactly match the recovered offsets file is stale and ignored.
+struct DictIndexHeader {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t str_count;
+  uint64_t bucket_count;
+  uint64_t hash_count;
+  uint64_t payload_file_off;
+};
+
+const uint64_t DICT_INDEX_MAGIC{0x5844495464706d31ULL};
+const uint64_t DICT_INDEX_VERSION{1};
+
+// On-disk header for the persisted sorted permutation ("DictSorted"). Unlike
+// the hash index a sorted prefix stays valid when strings were appended after
+// the snapshot; buildSortedCache merges in the unsorted tail on first use.
+struct DictSortedHeader {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t str_count;
+};
+
+const uint64_t DICT_SORTED_MAGIC{0x5453525364706d31ULL};
+const uint64_t DICT_SORTED_VERSION{1};
+
 size_t file_size(const int fd) {
   struct stat buf;
   int err = fstat(fd, &buf);
@@ -127,6 +170,8 @@ StringDictionary::StringDictionary(const std::string& folder,
   if (!isTemp_) {
     boost::filesystem::path storage_path(folder);
     offsets_path_ = (storage_path / boost::filesystem::path("DictOffsets")).string();
+    index_path_ = (storage_path / boost::filesystem::path("DictIndex")).string();
+    sorted_path_ = (storage_path / boost::filesystem::path("DictSorted")).string();
     const auto payload_path =
         (storage_path / boost::filesystem::path("DictPayload")).string();
     payload_fd_ = checked_open(payload_path.c_str(), recover);
@@ -151,6 +196,15 @@ StringDictionary::StringDictionary(const std::string& folder,
         LOG(WARNING) << "Offsets " << offsets_path_ << " file is truncated";
       }
       const uint64_t str_count = bytes / sizeof(StringIdxEntry);
+      if (g_enable_sorted_dict_cache && loadSortedCacheFromStorage(str_count)) {
+        VLOG(1) << "Restored sorted permutation for dictionary " << offsets_path_
+                << " from " << sorted_path_;
+      }
+      if (g_enable_string_dict_index_cache && loadIndexFromStorage(str_count)) {
+        VLOG(1) << "Restored hash index for dictionary " << offsets_path_ << " from "
+                << index_path_;
+        return;
+      }
       // at this point we know the size of the StringDict we need to load
       // so lets reallocate the vector to the correct size
       const uint64_t max_entries = round_up_p2(str_count * 2 + 1);
@@ -219,6 +273,169 @@ void StringDictionary::processDictionaryFutures(
   dictionary_futures.clear();
 }
 
+// Restores str_ids_ (and rk_hashes_ when materialized) from the DictIndex
+// snapshot instead of rehashing every payload string. The snapshot is only
+// accepted if its string count exactly matches the count recovered from the
+// offsets file, i.e. no strings were appended after the last checkpoint.
+bool StringDictionary::loadIndexFromStorage(const size_t max_str_count) noexcept {
+  if (index_path_.empty() || !boost::filesystem::exists(index_path_)) {
+    return false;
+  }
+  const auto fd = open(index_path_.c_str(), O_RDWR);
+  if (fd < 0) {
+    LOG(WARNING) << "Unable to open dictionary index " << index_path_;
+    return false;
+  }
+  bool loaded = false;
+  DictIndexHeader header;
+  const size_t bytes = file_size(fd);
+  if (bytes >= sizeof(header) &&
+      read(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)) &&
+      header.magic == DICT_INDEX_MAGIC && header.version == DICT_INDEX_VERSION &&
+      header.str_count <= max_str_count && header.bucket_count > 0 &&
+      (header.bucket_count & (header.bucket_count - 1)) == 0 &&
+      header.bucket_count > header.str_count * 2 &&
+      (materialize_hashes_ ? header.hash_count >= header.str_count
+                           : header.hash_count == 0) &&
+      bytes == sizeof(header) + header.bucket_count * sizeof(int32_t) +
+                   header.hash_count * sizeof(uint32_t)) {
+    // The offsets file counts canaries as potential entries; the snapshot is
+    // current only if entry str_count - 1 is real and entry str_count is not.
+    const bool exact_count =
+        (header.str_count == 0 || !getStringFromStorage(header.str_count - 1).canary) &&
+        (header.str_count == max_str_count ||
+         getStringFromStorage(header.str_count).canary);
+    if (exact_count) {
+      auto index_map = reinterpret_cast<const char*>(checked_mmap(fd, bytes));
+      std::vector<int32_t> new_str_ids(header.bucket_count, INVALID_STR_ID);
+      memcpy(&new_str_ids[0],
+             index_map + sizeof(header),
+             header.bucket_count * sizeof(int32_t));
+      mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+      str_ids_.swap(new_str_ids);
+      if (materialize_hashes_) {
+        std::vector<uint32_t> new_rk_hashes(header.hash_count);
+        memcpy(&new_rk_hashes[0],
+               index_map + sizeof(header) + header.bucket_count * sizeof(int32_t),
+               header.hash_count * sizeof(uint32_t));
+        rk_hashes_.swap(new_rk_hashes);
+      }
+      str_count_ = header.str_count;
+      payload_file_off_ = header.payload_file_off;
+      checked_munmap(const_cast<char*>(index_map), bytes);
+      loaded = true;
+    }
+  }
+  close(fd);
+  return loaded;
+}
+
+bool StringDictionary::writeIndexToStorage() noexcept {
+  CHECK(!isTemp_);
+  if (index_path_.empty()) {
+    return false;
+  }
+  const auto fd = open(index_path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG(WARNING) << "Unable to write dictionary index " << index_path_;
+    return false;
+  }
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  DictIndexHeader header{DICT_INDEX_MAGIC,
+                         DICT_INDEX_VERSION,
+                         str_count_,
+                         str_ids_.size(),
+                         materialize_hashes_ ? rk_hashes_.size() : 0,
+                         payload_file_off_};
+  // The header is written last so a partially written snapshot fails the
+  // magic check on recovery and falls back to the payload scan.
+  const ssize_t buckets_sz = str_ids_.size() * sizeof(int32_t);
+  const ssize_t hashes_sz = header.hash_count * sizeof(uint32_t);
+  bool ret = pwrite(fd, &str_ids_[0], buckets_sz, sizeof(header)) == buckets_sz;
+  if (materialize_hashes_) {
+    ret = ret && pwrite(fd, &rk_hashes_[0], hashes_sz, sizeof(header) + buckets_sz) ==
+                     hashes_sz;
+  }
+  ret = ret && fsync(fd) == 0;
+  ret = ret && pwrite(fd, &header, sizeof(header), 0) ==
+                   static_cast<ssize_t>(sizeof(header));
+  ret = ret && fsync(fd) == 0;
+  close(fd);
+  return ret;
+}
+
+// Restores sorted_cache from the DictSorted snapshot so getCompare and
+// getSortedPermutation start from an already sorted prefix. A snapshot older
+// than the payload is still usable: ids appended after the snapshot are
+// merged in by buildSortedCache on first use.
+bool StringDictionary::loadSortedCacheFromStorage(const size_t max_str_count) noexcept {
+  if (sorted_path_.empty() || !boost::filesystem::exists(sorted_path_)) {
+    return false;
+  }
+  const auto fd = open(sorted_path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(WARNING) << "Unable to open sorted dictionary cache " << sorted_path_;
+    return false;
+  }
+  bool loaded = false;
+  DictSortedHeader header;
+  const size_t bytes = file_size(fd);
+  if (bytes >= sizeof(header) &&
+      read(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)) &&
+      header.magic == DICT_SORTED_MAGIC && header.version == DICT_SORTED_VERSION &&
+      header.str_count <= max_str_count &&
+      bytes == sizeof(header) + header.str_count * sizeof(int32_t)) {
+    // every id in the snapshot must name a real (non-canary) payload entry
+    const bool ids_exist =
+        header.str_count == 0 || !getStringFromStorage(header.str_count - 1).canary;
+    if (ids_exist) {
+      std::vector<int32_t> new_sorted(header.str_count);
+      const ssize_t ids_sz = header.str_count * sizeof(int32_t);
+      if (header.str_count == 0 ||
+          pread(fd, &new_sorted[0], ids_sz, sizeof(header)) == ids_sz) {
+        loaded = true;
+        for (const auto id : new_sorted) {
+          if (id < 0 || static_cast<uint64_t>(id) >= header.str_count) {
+            loaded = false;
+            break;
+          }
+        }
+        if (loaded) {
+          mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+          sorted_cache.swap(new_sorted);
+        }
+      }
+    }
+  }
+  close(fd);
+  return loaded;
+}
+
+bool StringDictionary::writeSortedCacheToStorage() noexcept {
+  CHECK(!isTemp_);
+  if (sorted_path_.empty()) {
+    return false;
+  }
+  const auto fd = open(sorted_path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG(WARNING) << "Unable to write sorted dictionary cache " << sorted_path_;
+    return false;
+  }
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  DictSortedHeader header{DICT_SORTED_MAGIC, DICT_SORTED_VERSION, sorted_cache.size()};
+  // The header is written last so a partially written snapshot fails the
+  // magic check on recovery and the cache is simply rebuilt on demand.
+  const ssize_t ids_sz = sorted_cache.size() * sizeof(int32_t);
+  bool ret = sorted_cache.empty() ||
+             pwrite(fd, &sorted_cache[0], ids_sz, sizeof(header)) == ids_sz;
+  ret = ret && fsync(fd) == 0;
+  ret = ret && pwrite(fd, &header, sizeof(header), 0) ==
+                   static_cast<ssize_t>(sizeof(header));
+  ret = ret && fsync(fd) == 0;
+  close(fd);
+  return ret;
+}
+
 StringDictionary::StringDictionary(const LeafHostInfo& host, const DictRef dict_ref)
     : strings_cache_(nullptr)
     , client_(new StringDictionaryClient(host, dict_ref, true))
@@ -278,6 +495,33 @@ void StringDictionary::getOrAddBulkArray(
   }
 }
 
+void StringDictionary::hashStrings(const std::vector<std::string>& string_vec,
+                                   std::vector<uint32_t>& hashes) const {
+  CHECK_EQ(string_vec.size(), hashes.size());
+  const size_t min_strings_per_thread{1000};
+  const size_t items_per_thread =
+      std::max<size_t>(min_strings_per_thread,
+                       (string_vec.size() + cpu_threads() - 1) / cpu_threads());
+  std::vector<std::thread> workers;
+  for (size_t string_id = 0; string_id < string_vec.size();
+       string_id += items_per_thread) {
+    workers.emplace_back(
+        [&string_vec, &hashes, string_id, items_per_thread] {
+          const size_t end_id =
+              std::min(string_id + items_per_thread, string_vec.size());
+          for (size_t curr_id = string_id; curr_id < end_id; ++curr_id) {
+            if (string_vec[curr_id].empty()) {
+              continue;
+            }
+            hashes[curr_id] = rk_hash(string_vec[curr_id]);
+          }
+        });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
 template <class T>
 void StringDictionary::getOrAddBulk(const std::vector<std::string>& string_vec,
                                     T* encoded_vec) {
@@ -285,6 +529,12 @@ void StringDictionary::getOrAddBulk(const std::vector<std::string>& string_vec,
     getOrAddBulkRemote(string_vec, encoded_vec);
     return;
   }
+  // Compute the hashes in parallel before taking the write lock, so
+  // concurrent ingestion threads serialize only on the actual inserts rather
+  // than on per-string hashing.
+  std::vector<uint32_t> hashes(string_vec.size());
+  hashStrings(string_vec, hashes);
+
   size_t out_idx{0};
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
 
@@ -295,7 +545,7 @@ void StringDictionary::getOrAddBulk(const std::vector<std::string>& string_vec,
     }
     CHECK(str.size() <= MAX_STRLEN);
     uint32_t bucket;
-    const uint32_t hash = rk_hash(str);
+    const uint32_t hash = hashes[out_idx];
     bucket = computeBucket(hash, str, str_ids_, false);
     if (str_ids_[bucket] != INVALID_STR_ID) {
       encoded_vec[out_idx++] = str_ids_[bucket];
@@ -383,6 +633,33 @@ int32_t StringDictionary::getUnlocked(const std::string& str) const noexcept {
   return str_id;
 }
 
+// Read-only bulk lookup: hashes the whole column in parallel before taking
+// the read lock once, mirroring getOrAddBulk. Missing strings are encoded as
+// INVALID_STR_ID and empty strings as the int32 null sentinel.
+void StringDictionary::getBulk(const std::vector<std::string>& string_vec,
+                               int32_t* encoded_vec) const {
+  if (client_) {
+    size_t out_idx{0};
+    for (const auto& str : string_vec) {
+      encoded_vec[out_idx++] = client_->get(str);
+    }
+    return;
+  }
+  std::vector<uint32_t> hashes(string_vec.size());
+  hashStrings(string_vec, hashes);
+  size_t out_idx{0};
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  for (const auto& str : string_vec) {
+    if (str.empty()) {
+      encoded_vec[out_idx++] = inline_int_null_value<int32_t>();
+      continue;
+    }
+    encoded_vec[out_idx] =
+        str_ids_[computeBucket(hashes[out_idx], str, str_ids_, false)];
+    ++out_idx;
+  }
+}
+
 std::string StringDictionary::getString(int32_t string_id) const {
   mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
@@ -417,26 +694,22 @@ size_t StringDictionary::storageEntryCount() const {
 
 namespace {
 
-bool is_like(const std::string& str,
+bool is_like(const char* str,
+             const size_t str_len,
              const std::string& pattern,
              const bool icase,
              const bool is_simple,
              const char escape) {
-  return icase
-             ? (is_simple ? string_ilike_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_ilike(str.c_str(),
-                                         str.size(),
-                                         pattern.c_str(),
-                                         pattern.size(),
-                                         escape))
-             : (is_simple ? string_like_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_like(str.c_str(),
-                                        str.size(),
-                                        pattern.c_str(),
-                                        pattern.size(),
-                                        escape));
+  if (is_simple && !icase) {
+    // Simple case-sensitive patterns are a plain substring search; memmem is
+    // vectorized by libc and far faster than the naive scan for long strings.
+    return memmem(str, str_len, pattern.c_str(), pattern.size()) != nullptr;
+  }
+  return icase ? (is_simple ? string_ilike_simple(
+                                  str, str_len, pattern.c_str(), pattern.size())
+                            : string_ilike(
+                                  str, str_len, pattern.c_str(), pattern.size(), escape))
+               : string_like(str, str_len, pattern.c_str(), pattern.size(), escape);
 }
 
 }  // namespace
@@ -446,21 +719,42 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
                                                const bool is_simple,
                                                const char escape,
                                                const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
-  if (client_) {
-    return client_->get_like(pattern, icase, is_simple, escape, generation);
-  }
   const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape);
+  {
+    // Repeated patterns are served from the cache under a shared lock so
+    // concurrent queries don't serialize on cache hits.
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    if (client_) {
+      return client_->get_like(pattern, icase, is_simple, escape, generation);
+    }
+    const auto it = like_cache_.find(cache_key);
+    if (it != like_cache_.end()) {
+      return it->second;
+    }
+  }
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  // another thread may have filled the cache while we waited for the lock
   const auto it = like_cache_.find(cache_key);
   if (it != like_cache_.end()) {
     return it->second;
   }
+  if (icase && !is_simple && g_enable_folded_dict_index) {
+    std::vector<int32_t> folded_result;
+    if (getLikeViaFoldedIndex(pattern, escape, generation, folded_result)) {
+      const auto it_ok = like_cache_.insert(std::make_pair(cache_key, folded_result));
+      CHECK(it_ok.second);
+      return folded_result;
+    }
+  }
   std::vector<int32_t> result;
   std::vector<std::thread> workers;
   int worker_count = cpu_threads();
   CHECK_GT(worker_count, 0);
   std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
+  // each worker scans a contiguous range of the mmap'd payload directly,
+  // avoiding a std::string copy per entry and strided page access
+  const size_t chunk_size = (generation + worker_count - 1) / worker_count;
   for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
     workers.emplace_back([&worker_results,
                           &pattern,
@@ -469,12 +763,13 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
                           is_simple,
                           escape,
                           worker_idx,
-                          worker_count,
+                          chunk_size,
                           this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_like(str, pattern, icase, is_simple, escape)) {
+      const size_t chunk_begin = worker_idx * chunk_size;
+      const size_t chunk_end = std::min(chunk_begin + chunk_size, generation);
+      for (size_t string_id = chunk_begin; string_id < chunk_end; ++string_id) {
+        const auto str = getStringFromStorage(string_id);
+        if (is_like(str.c_str_ptr, str.size, pattern, icase, is_simple, escape)) {
           worker_results[worker_idx].push_back(string_id);
         }
       }
@@ -494,6 +789,83 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
   return result;
 }
 
+namespace {
+
+// same ASCII folding as lowercase() in the LIKE string functions
+inline char fold_case(const char c) {
+  return ('A' <= c && c <= 'Z') ? 'a' + (c - 'A') : c;
+}
+
+}  // namespace
+
+bool StringDictionary::getLikeViaFoldedIndex(const std::string& pattern,
+                                             const char escape,
+                                             const size_t generation,
+                                             std::vector<int32_t>& result) const {
+  // only equality (no wildcards) and prefix ("foo%") patterns resolve through
+  // the index; inner wildcards and escaped patterns take the full scan
+  bool is_prefix = false;
+  std::string folded_pattern;
+  folded_pattern.reserve(pattern.size());
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == escape || c == '_') {
+      return false;
+    }
+    if (c == '%') {
+      if (i + 1 == pattern.size()) {
+        is_prefix = true;
+        break;
+      }
+      return false;
+    }
+    folded_pattern.push_back(fold_case(c));
+  }
+  if (is_prefix && folded_pattern.empty()) {
+    // "%" matches everything; the scan handles the degenerate case
+    return false;
+  }
+  CHECK_LE(generation, str_count_);
+  if (folded_index_size_ < generation) {
+    auto clock_begin = timer_start();
+    for (size_t string_id = folded_index_size_; string_id < generation; ++string_id) {
+      const auto str = getStringFromStorage(string_id);
+      std::string folded_str(str.c_str_ptr, str.size);
+      for (auto& folded_c : folded_str) {
+        folded_c = fold_case(folded_c);
+      }
+      folded_index_[folded_str].push_back(string_id);
+    }
+    VLOG(1) << "Extended case-folded dictionary index to " << generation
+            << " entries in " << timer_stop(clock_begin) << "ms";
+    folded_index_size_ = generation;
+  }
+  // ids were inserted in ascending order, so each bucket is sorted; filter by
+  // generation so older transactions do not see newer strings
+  const auto append_bucket = [&result, generation](const std::vector<int32_t>& ids) {
+    for (const auto string_id : ids) {
+      if (string_id < static_cast<int32_t>(generation)) {
+        result.push_back(string_id);
+      }
+    }
+  };
+  if (!is_prefix) {
+    const auto bucket_it = folded_index_.find(folded_pattern);
+    if (bucket_it != folded_index_.end()) {
+      append_bucket(bucket_it->second);
+    }
+    return true;
+  }
+  for (auto bucket_it = folded_index_.lower_bound(folded_pattern);
+       bucket_it != folded_index_.end() &&
+       bucket_it->first.compare(0, folded_pattern.size(), folded_pattern) == 0;
+       ++bucket_it) {
+    append_bucket(bucket_it->second);
+  }
+  std::sort(result.begin(), result.end());
+  return true;
+}
+
 std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
                                                  std::string comp_operator,
                                                  size_t generation) {
@@ -554,6 +926,15 @@ std::vector<int32_t> StringDictionary::getEquals(std::string pattern,
   return result;
 }
 
+const std::vector<int32_t>& StringDictionary::getSortedPermutation() {
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  CHECK(!client_);
+  if (sorted_cache.size() < str_count_) {
+    buildSortedCache();
+  }
+  return sorted_cache;
+}
+
 std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
                                                   const std::string& comp_operator,
                                                   const size_t generation) {
@@ -707,10 +1088,11 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
 
 namespace {
 
-bool is_regexp_like(const std::string& str,
+bool is_regexp_like(const char* str,
+                    const size_t str_len,
                     const std::string& pattern,
                     const char escape) {
-  return regexp_like(str.c_str(), str.size(), pattern.c_str(), pattern.size(), escape);
+  return regexp_like(str, str_len, pattern.c_str(), pattern.size(), escape);
 }
 
 }  // namespace
@@ -718,11 +1100,18 @@ bool is_regexp_like(const std::string& str,
 std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
                                                      const char escape,
                                                      const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
-  if (client_) {
-    return client_->get_regexp_like(pattern, escape, generation);
-  }
   const auto cache_key = std::make_pair(pattern, escape);
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    if (client_) {
+      return client_->get_regexp_like(pattern, escape, generation);
+    }
+    const auto it = regex_cache_.find(cache_key);
+    if (it != regex_cache_.end()) {
+      return it->second;
+    }
+  }
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
   const auto it = regex_cache_.find(cache_key);
   if (it != regex_cache_.end()) {
     return it->second;
@@ -733,18 +1122,20 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   CHECK_GT(worker_count, 0);
   std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
+  const size_t chunk_size = (generation + worker_count - 1) / worker_count;
   for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
     workers.emplace_back([&worker_results,
                           &pattern,
                           generation,
                           escape,
                           worker_idx,
-                          worker_count,
+                          chunk_size,
                           this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_regexp_like(str, pattern, escape)) {
+      const size_t chunk_begin = worker_idx * chunk_size;
+      const size_t chunk_end = std::min(chunk_begin + chunk_size, generation);
+      for (size_t string_id = chunk_begin; string_id < chunk_end; ++string_id) {
+        const auto str = getStringFromStorage(string_id);
+        if (is_regexp_like(str.c_str_ptr, str.size, pattern, escape)) {
           worker_results[worker_idx].push_back(string_id);
         }
       }
@@ -1077,6 +1468,19 @@ bool StringDictionary::checkpoint() noexcept {
   ret = ret && (msync((void*)payload_map_, payload_file_size_, MS_SYNC) == 0);
   ret = ret && (fsync(offset_fd_) == 0);
   ret = ret && (fsync(payload_fd_) == 0);
+  if (ret && g_enable_string_dict_index_cache) {
+    // The index is an optimization; a failed write only costs the next
+    // recovery a payload scan, so it does not fail the checkpoint.
+    if (!writeIndexToStorage()) {
+      LOG(WARNING) << "Failed to write hash index for dictionary " << offsets_path_;
+    }
+  }
+  if (ret && g_enable_sorted_dict_cache && !sorted_cache.empty()) {
+    // like the hash index, a failed write only costs a rebuild on demand
+    if (!writeSortedCacheToStorage()) {
+      LOG(WARNING) << "Failed to write sorted cache for dictionary " << offsets_path_;
+    }
+  }
   return ret;
 }
 
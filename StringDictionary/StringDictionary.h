@@ -59,6 +59,7 @@ class StringDictionary {
   void getOrAddBulkArray(const std::vector<std::vector<std::string>>& string_array_vec,
                          std::vector<std::vector<int32_t>>& ids_array_vec);
   int32_t getIdOfString(const std::string& str) const;
+  void getBulk(const std::vector<std::string>& string_vec, int32_t* encoded_vec) const;
   std::string getString(int32_t string_id) const;
   std::pair<char*, size_t> getStringBytes(int32_t string_id) const noexcept;
   size_t storageEntryCount() const;
@@ -73,6 +74,11 @@ class StringDictionary {
                                   const std::string& comp_operator,
                                   const size_t generation);
 
+  /// Returns the dictionary's sorted-id permutation, building or extending it
+  /// first when it is stale. A string's position in the returned vector is its
+  /// rank, so callers can evaluate string ordering in integer space.
+  const std::vector<int32_t>& getSortedPermutation();
+
   std::vector<int32_t> getRegexpLike(const std::string& pattern,
                                      const char escape,
                                      const size_t generation) const;
@@ -120,11 +126,17 @@ class StringDictionary {
   void processDictionaryFutures(
       std::vector<std::future<std::vector<std::pair<uint32_t, unsigned int>>>>&
           dictionary_futures);
+  bool loadIndexFromStorage(const size_t max_str_count) noexcept;
+  bool writeIndexToStorage() noexcept;
+  bool loadSortedCacheFromStorage(const size_t max_str_count) noexcept;
+  bool writeSortedCacheToStorage() noexcept;
   bool fillRateIsHigh() const noexcept;
   void increaseCapacity() noexcept;
   int32_t getOrAddImpl(const std::string& str) noexcept;
   template <class T>
   void getOrAddBulkRemote(const std::vector<std::string>& string_vec, T* encoded_vec);
+  void hashStrings(const std::vector<std::string>& string_vec,
+                   std::vector<uint32_t>& hashes) const;
   int32_t getUnlocked(const std::string& str) const noexcept;
   std::string getStringUnlocked(int32_t string_id) const noexcept;
   std::string getStringChecked(const int string_id) const noexcept;
@@ -137,6 +149,13 @@ class StringDictionary {
                                        const std::vector<int32_t>& data) const noexcept;
   void appendToStorage(const std::string& str) noexcept;
   PayloadString getStringFromStorage(const int string_id) const noexcept;
+  /// Resolves an ILIKE equality or prefix pattern through the case-folded
+  /// index, building/extending the index first if needed. Returns false when
+  /// the pattern needs the full scan. Must be called under the write lock.
+  bool getLikeViaFoldedIndex(const std::string& pattern,
+                             const char escape,
+                             const size_t generation,
+                             std::vector<int32_t>& result) const;
   void addPayloadCapacity() noexcept;
   void addOffsetCapacity() noexcept;
   size_t addStorageCapacity(int fd) noexcept;
@@ -158,6 +177,8 @@ class StringDictionary {
   bool isTemp_;
   bool materialize_hashes_;
   std::string offsets_path_;
+  std::string index_path_;
+  std::string sorted_path_;
   int payload_fd_;
   int offset_fd_;
   StringIdxEntry* offset_map_;
@@ -170,6 +191,12 @@ class StringDictionary {
       like_cache_;
   mutable std::map<std::pair<std::string, char>, std::vector<int32_t>> regex_cache_;
   mutable std::map<std::string, int32_t> equal_cache_;
+  // Case-folded inverted index for ILIKE equality and prefix patterns: folded
+  // string -> ids, ordered so prefix patterns resolve with a range scan
+  // instead of a full dictionary scan. Extended lazily up to the generation a
+  // query asks for; ids are append-only so it is never invalidated.
+  mutable std::map<std::string, std::vector<int32_t>> folded_index_;
+  mutable size_t folded_index_size_ = 0;  // ids [0, folded_index_size_) are indexed
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
   std::unique_ptr<StringDictionaryClient> client_;
@@ -23,6 +23,11 @@
 #include <memory>
 #include <mutex>
 
+// Stub of the remote dictionary client; only compiled into single-node
+// builds, where it is never reached. Performance work on the wire protocol —
+// batching lookups into the existing bulk entry points, caching resolved ids
+// per dictionary generation, pipelining requests — applies to the Thrift
+// implementation behind this interface and cannot be expressed here.
 class StringDictionaryClient {
  public:
   StringDictionaryClient(const LeafHostInfo& server_host,
@@ -24,6 +24,7 @@
 
 #include <sys/fcntl.h>
 
+#include <algorithm>
 #include <thread>
 
 StringDictionaryProxy::StringDictionaryProxy(std::shared_ptr<StringDictionary> sd,
@@ -63,6 +64,45 @@ int32_t StringDictionaryProxy::getOrAddTransient(const std::string& str) {
   return transient_id;
 }
 
+// Bulk variant of getOrAddTransient: one parallel hash pass over the column
+// and a single acquisition of each lock instead of a dictionary probe per
+// row. Strings missing from the underlying dictionary get (or reuse)
+// transient ids; empty strings encode as the int32 null sentinel.
+void StringDictionaryProxy::getOrAddTransientBulk(
+    const std::vector<std::string>& string_vec,
+    int32_t* encoded_vec) {
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  CHECK_GE(generation_, 0);
+  string_dict_->getBulk(string_vec, encoded_vec);
+  for (size_t i = 0; i < string_vec.size(); ++i) {
+    const auto& str = string_vec[i];
+    if (str.empty()) {
+      continue;  // getBulk already wrote the null sentinel
+    }
+    const auto str_id = truncate_to_generation(encoded_vec[i], generation_);
+    if (str_id != StringDictionary::INVALID_STR_ID) {
+      encoded_vec[i] = str_id;
+      continue;
+    }
+    const auto it = transient_str_to_int_.find(str);
+    if (it != transient_str_to_int_.end()) {
+      encoded_vec[i] = it->second;
+      continue;
+    }
+    const int32_t transient_id =
+        -(transient_str_to_int_.size() + 2);  // make sure it's not INVALID_STR_ID
+    {
+      auto it_ok = transient_str_to_int_.insert(std::make_pair(str, transient_id));
+      CHECK(it_ok.second);
+    }
+    {
+      auto it_ok = transient_int_to_str_.insert(std::make_pair(transient_id, str));
+      CHECK(it_ok.second);
+    }
+    encoded_vec[i] = transient_id;
+  }
+}
+
 int32_t StringDictionaryProxy::getIdOfString(const std::string& str) const {
   mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   CHECK_GE(generation_, 0);
@@ -75,6 +115,79 @@ int32_t StringDictionaryProxy::getIdOfString(const std::string& str) const {
                                            : StringDictionary::INVALID_STR_ID;
 }
 
+// Builds (once) and caches a translation of every persisted id below this
+// proxy's generation to the corresponding id in dest_proxy's dictionary, so
+// joins and IN subqueries across dictionaries can stay in id space instead of
+// decompressing to a string per row. Ids missing from the destination encode
+// as INVALID_STR_ID. The map is built without holding this proxy's lock so
+// two proxies translating towards each other cannot deadlock.
+const std::vector<int32_t>* StringDictionaryProxy::getOrBuildTranslationMap(
+    const StringDictionaryProxy* dest_proxy) const {
+  CHECK(dest_proxy);
+  CHECK_NE(this, dest_proxy);
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    const auto it = translation_maps_.find(dest_proxy);
+    if (it != translation_maps_.end()) {
+      return &it->second;
+    }
+  }
+  CHECK_GE(generation_, 0);
+  std::vector<int32_t> translation_map(generation_, StringDictionary::INVALID_STR_ID);
+  std::vector<std::thread> workers;
+  const int worker_count = cpu_threads();
+  CHECK_GT(worker_count, 0);
+  const size_t chunk_size = (translation_map.size() + worker_count - 1) / worker_count;
+  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
+    workers.emplace_back([&translation_map, dest_proxy, worker_idx, chunk_size, this] {
+      const size_t chunk_begin = worker_idx * chunk_size;
+      const size_t chunk_end =
+          std::min(chunk_begin + chunk_size, translation_map.size());
+      for (size_t string_id = chunk_begin; string_id < chunk_end; ++string_id) {
+        translation_map[string_id] =
+            dest_proxy->getIdOfString(string_dict_->getString(string_id));
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  // if another thread built the same map while we did, keep the winner
+  const auto it_ok = translation_maps_.emplace(dest_proxy, std::move(translation_map));
+  return &it_ok.first->second;
+}
+
+const std::vector<int32_t>* StringDictionaryProxy::getCachedTranslationMap(
+    const StringDictionaryProxy* dest_proxy) const noexcept {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  const auto it = translation_maps_.find(dest_proxy);
+  return it != translation_maps_.end() ? &it->second : nullptr;
+}
+
+// Read-only bulk lookup resolving both persisted and transient ids under a
+// single lock acquisition.
+void StringDictionaryProxy::getBulk(const std::vector<std::string>& string_vec,
+                                    int32_t* encoded_vec) const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  CHECK_GE(generation_, 0);
+  string_dict_->getBulk(string_vec, encoded_vec);
+  for (size_t i = 0; i < string_vec.size(); ++i) {
+    if (string_vec[i].empty()) {
+      continue;
+    }
+    const auto str_id = truncate_to_generation(encoded_vec[i], generation_);
+    encoded_vec[i] = str_id;
+    if (str_id != StringDictionary::INVALID_STR_ID || transient_str_to_int_.empty()) {
+      continue;
+    }
+    const auto it = transient_str_to_int_.find(string_vec[i]);
+    if (it != transient_str_to_int_.end()) {
+      encoded_vec[i] = it->second;
+    }
+  }
+}
+
 int32_t StringDictionaryProxy::getIdOfStringNoGeneration(const std::string& str) const {
   mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   auto str_id = string_dict_->getIdOfString(str);
@@ -38,7 +38,14 @@ class StringDictionaryProxy {
   StringDictionary* getDictionary() noexcept;
   ssize_t getGeneration() const noexcept;
   int32_t getOrAddTransient(const std::string& str);
+  void getOrAddTransientBulk(const std::vector<std::string>& string_vec,
+                             int32_t* encoded_vec);
   int32_t getIdOfString(const std::string& str) const;
+  void getBulk(const std::vector<std::string>& string_vec, int32_t* encoded_vec) const;
+  const std::vector<int32_t>* getOrBuildTranslationMap(
+      const StringDictionaryProxy* dest_proxy) const;
+  const std::vector<int32_t>* getCachedTranslationMap(
+      const StringDictionaryProxy* dest_proxy) const noexcept;
   int32_t getIdOfStringNoGeneration(
       const std::string& str) const;  // disregard generation, only used by QueryRenderer
   std::string getString(int32_t string_id) const;
@@ -64,6 +71,7 @@ class StringDictionaryProxy {
   std::shared_ptr<StringDictionary> string_dict_;
   std::map<int32_t, std::string> transient_int_to_str_;
   std::map<std::string, int32_t> transient_str_to_int_;
+  mutable std::map<const StringDictionaryProxy*, std::vector<int32_t>> translation_maps_;
   ssize_t generation_;
   mutable mapd_shared_mutex rw_mutex_;
 };
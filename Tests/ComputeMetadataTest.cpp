@@ -148,6 +148,14 @@ void vacuum_and_recompute_metadata(const TableDescriptor* td,
   EXPECT_NO_THROW(optimizer.recomputeMetadata());
 }
 
+std::vector<EncodingRecommendation> recommend_encodings(
+    const TableDescriptor* td,
+    const Catalog_Namespace::Catalog& cat) {
+  auto executor = Executor::getExecutor(cat.getCurrentDB().dbId);
+  TableOptimizer optimizer(td, executor.get(), cat);
+  return optimizer.recommendEncodings();
+}
+
 static const std::string g_table_name{"metadata_test"};
 
 }  // namespace
@@ -483,6 +491,58 @@ TEST_UNSHARDED_AND_SHARDED(MetadataUpdate, SmallDateNarrowMax)
 TEST_UNSHARDED_AND_SHARDED(MetadataUpdate, DeleteReset)
 TEST_UNSHARDED_AND_SHARDED(MetadataUpdate, EncodedStringNull)
 
+class EncodingAdvisor : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    EXPECT_NO_THROW(run_ddl_statement("DROP TABLE IF EXISTS encoding_advisor_test;"));
+    EXPECT_NO_THROW(run_ddl_statement(
+        "CREATE TABLE encoding_advisor_test (i BIGINT, d DOUBLE, t TEXT ENCODING "
+        "DICT(32));"));
+
+    TestHelpers::ValuesGenerator gen("encoding_advisor_test");
+    for (int i = 0; i < 3; i++) {
+      run_multiple_agg(gen(i, i * 1.1, "'s" + std::to_string(i) + "'"),
+                       ExecutorDeviceType::CPU);
+    }
+  }
+
+  void TearDown() override {
+    EXPECT_NO_THROW(run_ddl_statement("DROP TABLE IF EXISTS encoding_advisor_test;"));
+  }
+};
+
+TEST_F(EncodingAdvisor, RecommendsTighterEncodings) {
+  const auto cat = QR::get()->getCatalog();
+  const auto td = cat->getMetadataForTable("encoding_advisor_test",
+                                           /*populateFragmenter=*/true);
+  const auto recommendations = recommend_encodings(td, *cat);
+
+  auto find_recommendation =
+      [&recommendations](const std::string& column_name) -> const EncodingRecommendation* {
+    for (const auto& recommendation : recommendations) {
+      if (recommendation.column_name == column_name) {
+        return &recommendation;
+      }
+    }
+    return nullptr;
+  };
+
+  // values 0..2 without nulls fit a single byte
+  const auto int_recommendation = find_recommendation("i");
+  ASSERT_NE(nullptr, int_recommendation);
+  EXPECT_EQ("FIXED(8)", int_recommendation->recommended_encoding);
+  EXPECT_EQ(size_t(7), int_recommendation->bytes_saved_per_row);
+
+  // three dictionary entries fit 8 bit ids with room to grow
+  const auto text_recommendation = find_recommendation("t");
+  ASSERT_NE(nullptr, text_recommendation);
+  EXPECT_EQ("DICT(8)", text_recommendation->recommended_encoding);
+  EXPECT_EQ(size_t(3), text_recommendation->bytes_saved_per_row);
+
+  // floating point columns have no narrower encoding to offer
+  EXPECT_EQ(nullptr, find_recommendation("d"));
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,198 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ConcurrencyBenchmark.cpp
+ * @brief   Replays a query mix from concurrent threads against generated data
+ * and reports latency percentiles plus per-subsystem lock-wait counters, so
+ * lock regressions (catalog, BufferMgr, execute mutex) show up as p99 shifts
+ * with an attribution instead of reaching production unnoticed.
+ */
+
+#include "../Catalog/Catalog.h"
+#include "../QueryRunner/QueryRunner.h"
+#include "../Shared/LockWaitStats.h"
+#include "PopulateTableRandom.h"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+const char* kBenchTableName = "concurrency_bench";
+
+double percentile(const std::vector<double>& sorted_latencies_ms, const double pct) {
+  CHECK(!sorted_latencies_ms.empty());
+  const auto rank = static_cast<size_t>(pct * (sorted_latencies_ms.size() - 1) + 0.5);
+  return sorted_latencies_ms[rank];
+}
+
+void report_lock_waits() {
+  const lock_wait_stats::Subsystem subsystems[]{lock_wait_stats::Subsystem::kCatalog,
+                                                lock_wait_stats::Subsystem::kBufferMgr,
+                                                lock_wait_stats::Subsystem::kExecutor};
+  printf("lock waits (contended acquisitions / total wait ms):\n");
+  for (const auto subsystem : subsystems) {
+    printf("  %-10s %12lu / %.3f\n",
+           lock_wait_stats::subsystem_name(subsystem),
+           static_cast<unsigned long>(lock_wait_stats::contended_acquisitions(subsystem)),
+           lock_wait_stats::wait_ns(subsystem) / 1e6);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string db_path;
+  size_t num_rows;
+  size_t num_threads;
+  size_t duration_sec;
+  std::vector<std::string> queries;
+
+  ExecutorDeviceType device_type{ExecutorDeviceType::GPU};
+
+  boost::program_options::options_description desc("Options");
+  desc.add_options()("path",
+                     boost::program_options::value<std::string>(&db_path)->required(),
+                     "Directory path to Mapd catalogs")(
+      "rows",
+      boost::program_options::value<size_t>(&num_rows)->default_value(1000000),
+      "Number of rows to generate in the benchmark table")(
+      "threads",
+      boost::program_options::value<size_t>(&num_threads)->default_value(8),
+      "Number of concurrent query threads")(
+      "duration",
+      boost::program_options::value<size_t>(&duration_sec)->default_value(30),
+      "Measured run duration in seconds")(
+      "query",
+      boost::program_options::value<std::vector<std::string>>(&queries),
+      "Query to include in the mix, may be given multiple times; threads pick "
+      "uniformly at random. Defaults to a scan/filter/group-by mix over the "
+      "generated table")("cpu", "Run on CPU (run on GPU by default)");
+
+  boost::program_options::positional_options_description positionalOptions;
+  positionalOptions.add("path", 1);
+
+  boost::program_options::variables_map vm;
+
+  try {
+    boost::program_options::store(boost::program_options::command_line_parser(argc, argv)
+                                      .options(desc)
+                                      .positional(positionalOptions)
+                                      .run(),
+                                  vm);
+    boost::program_options::notify(vm);
+  } catch (boost::program_options::error& err) {
+    LOG(ERROR) << err.what();
+    return 1;
+  }
+
+  if (vm.count("cpu")) {
+    device_type = ExecutorDeviceType::CPU;
+  }
+
+  if (queries.empty()) {
+    const std::string table_name{kBenchTableName};
+    queries = {"SELECT COUNT(*) FROM " + table_name + " WHERE b > 0;",
+               "SELECT a, COUNT(*), AVG(e) FROM " + table_name + " GROUP BY a;",
+               "SELECT MIN(c), MAX(c) FROM " + table_name + " WHERE f < e;"};
+  }
+
+  QR::init(db_path.c_str());
+
+  QR::get()->runDDLStatement(std::string("DROP TABLE IF EXISTS ") + kBenchTableName +
+                             ";");
+  QR::get()->runDDLStatement(
+      std::string("CREATE TABLE ") + kBenchTableName +
+      " (a SMALLINT, b INT, c BIGINT, d NUMERIC(17,3), e DOUBLE, f FLOAT, g "
+      "TIMESTAMP(0), h TIME(0), i DATE, x VARCHAR(10), y TEXT);");
+  populate_table_random(kBenchTableName, num_rows, *QR::get()->getCatalog());
+
+  // One warmup pass per query so generated code and resident chunks don't get
+  // billed to the first measured iterations.
+  for (const auto& query : queries) {
+    QR::get()->runSQL(query, device_type, true, true);
+  }
+  lock_wait_stats::reset();
+
+  std::vector<std::vector<double>> latencies_ms_per_thread(num_threads);
+  std::atomic<size_t> error_count{0};
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(duration_sec);
+
+  std::vector<std::thread> workers;
+  for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    workers.emplace_back([&, thread_idx] {
+      std::mt19937 gen(thread_idx);
+      std::uniform_int_distribution<size_t> pick_query(0, queries.size() - 1);
+      auto& latencies_ms = latencies_ms_per_thread[thread_idx];
+      while (std::chrono::steady_clock::now() < deadline) {
+        const auto& query = queries[pick_query(gen)];
+        const auto query_start = std::chrono::steady_clock::now();
+        try {
+          QR::get()->runSQL(query, device_type, true, true);
+        } catch (const std::exception& e) {
+          ++error_count;
+          continue;
+        }
+        latencies_ms.push_back(std::chrono::duration<double, std::milli>(
+                                   std::chrono::steady_clock::now() - query_start)
+                                   .count());
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  std::vector<double> latencies_ms;
+  for (const auto& thread_latencies_ms : latencies_ms_per_thread) {
+    latencies_ms.insert(
+        latencies_ms.end(), thread_latencies_ms.begin(), thread_latencies_ms.end());
+  }
+  if (latencies_ms.empty()) {
+    LOG(ERROR) << "No query completed within the measured window.";
+    return 1;
+  }
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+
+  printf("%lu queries, %lu threads, %lu s, %lu errors, %.1f qps\n",
+         static_cast<unsigned long>(latencies_ms.size()),
+         static_cast<unsigned long>(num_threads),
+         static_cast<unsigned long>(duration_sec),
+         static_cast<unsigned long>(error_count.load()),
+         static_cast<double>(latencies_ms.size()) / duration_sec);
+  printf("latency ms: p50 %.3f  p90 %.3f  p95 %.3f  p99 %.3f  max %.3f\n",
+         percentile(latencies_ms, 0.50),
+         percentile(latencies_ms, 0.90),
+         percentile(latencies_ms, 0.95),
+         percentile(latencies_ms, 0.99),
+         latencies_ms.back());
+  report_lock_waits();
+
+  QR::get()->runDDLStatement(std::string("DROP TABLE ") + kBenchTableName + ";");
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file DateTimeMathTest.cpp
+ * @brief Checks the civil-calendar EXTRACT / DATE_TRUNC math against glibc
+ * gmtime_r / timegm over random timestamps spanning roughly eleven centuries
+ * either side of the epoch, plus the usual calendar edge cases. Any
+ * divergence here silently changes every EXTRACT and DATE_TRUNC result, so
+ * the reference comparison is the test.
+ */
+
+#include "../QueryEngine/DateTruncate.h"
+#include "../QueryEngine/ExtractFromTime.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <ctime>
+#include <random>
+#include <vector>
+
+namespace {
+
+// ~1100 years either side of 1970, well past both fast-path boundaries.
+constexpr int64_t kTimestampRange = 34700000000LL;
+constexpr size_t kNumRandomTimestamps = 2000000;
+
+void compare_extract_to_gmtime(const int64_t timeval) {
+  const time_t time = timeval;
+  std::tm ref;
+  ASSERT_NE(nullptr, gmtime_r(&time, &ref)) << "timeval " << timeval;
+  ASSERT_EQ(ref.tm_year + 1900, ExtractFromTime(kYEAR, timeval))
+      << "timeval " << timeval;
+  ASSERT_EQ(ref.tm_mon + 1, ExtractFromTime(kMONTH, timeval)) << "timeval " << timeval;
+  ASSERT_EQ(ref.tm_mday, ExtractFromTime(kDAY, timeval)) << "timeval " << timeval;
+  ASSERT_EQ(ref.tm_yday + 1, ExtractFromTime(kDOY, timeval)) << "timeval " << timeval;
+  ASSERT_EQ(ref.tm_mon / 3 + 1, ExtractFromTime(kQUARTER, timeval))
+      << "timeval " << timeval;
+  ASSERT_EQ(ref.tm_wday, ExtractFromTime(kDOW, timeval)) << "timeval " << timeval;
+}
+
+void compare_truncate_to_timegm(const int64_t timeval) {
+  const time_t time = timeval;
+  std::tm ref;
+  ASSERT_NE(nullptr, gmtime_r(&time, &ref)) << "timeval " << timeval;
+  std::tm start{};
+  start.tm_mday = 1;
+  start.tm_year = ref.tm_year;
+  start.tm_mon = ref.tm_mon;
+  ASSERT_EQ(timegm(&start), DateTruncate(dtMONTH, timeval)) << "timeval " << timeval;
+  start.tm_mon = ref.tm_mon / 3 * 3;
+  ASSERT_EQ(timegm(&start), DateTruncate(dtQUARTER, timeval)) << "timeval " << timeval;
+  start.tm_mon = 0;
+  ASSERT_EQ(timegm(&start), DateTruncate(dtYEAR, timeval)) << "timeval " << timeval;
+}
+
+}  // namespace
+
+TEST(DateTimeMath, ExtractEdgeCases) {
+  const std::vector<int64_t> timestamps{
+      0,           // 1970-01-01, the epoch itself
+      -1,          // one second into 1969-12-31
+      951782399,   // 2000-02-28 23:59:59, leap century about to roll over
+      951782400,   // 2000-02-29, the leap day glibc and naive /4 rules disagree on
+      951868800,   // 2000-03-01
+      -2203977600, // 1900-02-28, 1900 is not a leap year
+      -2203891200, // 1900-03-01
+      68184086400, // 4130-08-01, far outside the unsigned fast-path range
+      -30610224000 // 1000-01-01
+  };
+  for (const auto timeval : timestamps) {
+    compare_extract_to_gmtime(timeval);
+    compare_truncate_to_timegm(timeval);
+  }
+}
+
+TEST(DateTimeMath, ExtractAgainstGmtime) {
+  std::mt19937_64 generator(42);
+  std::uniform_int_distribution<int64_t> distribution(-kTimestampRange,
+                                                      kTimestampRange);
+  for (size_t i = 0; i < kNumRandomTimestamps; ++i) {
+    compare_extract_to_gmtime(distribution(generator));
+  }
+}
+
+TEST(DateTimeMath, TruncateAgainstTimegm) {
+  std::mt19937_64 generator(43);
+  std::uniform_int_distribution<int64_t> distribution(-kTimestampRange,
+                                                      kTimestampRange);
+  for (size_t i = 0; i < kNumRandomTimestamps; ++i) {
+    compare_truncate_to_timegm(distribution(generator));
+  }
+}
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    KernelBenchmark.cpp
+ * @brief   Microbenchmarks for hot runtime kernels: perfect hash join build
+ *          and probe, result set reduction and string dictionary bulk
+ *          encoding, across type widths and cardinalities. Writes a JSON
+ *          report in the same shape as Benchmarks/run-benchmark.py so the
+ *          results feed straight into Benchmarks/analyze-benchmark.py.
+ */
+
+#include "../QueryEngine/Descriptors/QueryMemoryDescriptor.h"
+#include "../QueryEngine/Descriptors/RowSetMemoryOwner.h"
+#include "../QueryEngine/HashJoinRuntime.h"
+#include "../QueryEngine/ResultSet.h"
+#include "../Shared/TargetInfo.h"
+#include "../StringDictionary/StringDictionary.h"
+#include "Shared/measure.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+// The probe side of the perfect hash join is generated code; the host build
+// of the same runtime function is linked into QueryEngine.
+extern "C" int64_t hash_join_idx(int64_t hash_buff,
+                                 const int64_t key,
+                                 const int64_t min_key,
+                                 const int64_t max_key);
+
+namespace {
+
+struct BenchmarkResult {
+  std::string query_id;
+  double avg_ms;
+  double min_ms;
+  double max_ms;
+};
+
+size_t g_iterations{5};
+std::string g_label{"KernelBenchmark"};
+
+template <class F>
+BenchmarkResult run_benchmark(const std::string& query_id, F f) {
+  std::vector<double> times_ms;
+  for (size_t i = 0; i < g_iterations; ++i) {
+    times_ms.push_back(measure<std::chrono::microseconds>::execution(f) / 1000.);
+  }
+  const auto avg_ms =
+      std::accumulate(times_ms.begin(), times_ms.end(), 0.) / times_ms.size();
+  const auto result =
+      BenchmarkResult{query_id,
+                      avg_ms,
+                      *std::min_element(times_ms.begin(), times_ms.end()),
+                      *std::max_element(times_ms.begin(), times_ms.end())};
+  std::cout << query_id << ": avg " << result.avg_ms << " ms, min " << result.min_ms
+            << " ms, max " << result.max_ms << " ms" << std::endl;
+  return result;
+}
+
+// Keep a running sum of the kernel outputs alive so the loops cannot be
+// optimized away.
+int64_t g_sink{0};
+
+std::vector<int64_t> make_shuffled_keys(const size_t cardinality, const size_t count) {
+  std::vector<int64_t> keys(count);
+  for (size_t i = 0; i < count; ++i) {
+    keys[i] = i % cardinality;
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  return keys;
+}
+
+template <class K>
+std::vector<BenchmarkResult> benchmark_hash_join(const size_t cardinality) {
+  std::vector<BenchmarkResult> results;
+  const size_t elem_count = 2 * cardinality;
+  std::vector<K> build_keys;
+  for (const auto key : make_shuffled_keys(cardinality, cardinality)) {
+    build_keys.push_back(key);
+  }
+  const JoinColumn join_column{reinterpret_cast<const int8_t*>(build_keys.data()),
+                               build_keys.size()};
+  const JoinColumnTypeInfo type_info{sizeof(K),
+                                     0,
+                                     static_cast<int64_t>(cardinality - 1),
+                                     std::numeric_limits<K>::min(),
+                                     false,
+                                     0,
+                                     Signed};
+  std::vector<int32_t> hash_table(cardinality);
+  const int32_t invalid_slot_val{-1};
+  const auto suffix = std::to_string(8 * sizeof(K)) + "_card_" +
+                      std::to_string(cardinality);
+  results.push_back(run_benchmark("hash_join_build_int" + suffix, [&] {
+    init_hash_join_buff(hash_table.data(), cardinality, invalid_slot_val, 0, 1);
+    const auto err = fill_hash_join_buff(hash_table.data(),
+                                         invalid_slot_val,
+                                         join_column,
+                                         type_info,
+                                         nullptr,
+                                         nullptr,
+                                         0,
+                                         1);
+    CHECK_EQ(0, err);
+  }));
+  const auto probe_keys = make_shuffled_keys(cardinality, elem_count);
+  results.push_back(run_benchmark("hash_join_probe_int" + suffix, [&] {
+    int64_t matched{0};
+    for (const auto key : probe_keys) {
+      matched += hash_join_idx(reinterpret_cast<int64_t>(hash_table.data()),
+                               key,
+                               0,
+                               cardinality - 1);
+    }
+    g_sink += matched;
+  }));
+  return results;
+}
+
+std::vector<TargetInfo> make_int_agg_target_infos() {
+  std::vector<TargetInfo> target_infos;
+  const SQLTypeInfo bigint_ti(kBIGINT, false);
+  target_infos.push_back(TargetInfo{true, kMIN, bigint_ti, bigint_ti, true, false});
+  target_infos.push_back(TargetInfo{true, kMAX, bigint_ti, bigint_ti, true, false});
+  target_infos.push_back(TargetInfo{true, kSUM, bigint_ti, bigint_ti, true, false});
+  target_infos.push_back(TargetInfo{true, kCOUNT, bigint_ti, bigint_ti, true, false});
+  return target_infos;
+}
+
+QueryMemoryDescriptor make_perfect_hash_desc(
+    const std::vector<TargetInfo>& target_infos,
+    const size_t entry_count) {
+  QueryMemoryDescriptor query_mem_desc(
+      QueryDescriptionType::GroupByPerfectHash, 0, entry_count - 1, false, {8});
+  for (const auto& target_info : target_infos) {
+    const auto slot_bytes = static_cast<int8_t>(target_info.sql_type.get_size());
+    query_mem_desc.addColSlotInfo({std::make_tuple(slot_bytes, slot_bytes)});
+  }
+  query_mem_desc.setEntryCount(entry_count);
+  return query_mem_desc;
+}
+
+void fill_perfect_hash_storage(int8_t* buff,
+                               const std::vector<TargetInfo>& target_infos,
+                               const QueryMemoryDescriptor& query_mem_desc) {
+  auto buff_i64 = reinterpret_cast<int64_t*>(buff);
+  for (size_t i = 0; i < query_mem_desc.getEntryCount(); ++i) {
+    *buff_i64++ = i;  // the group key
+    for (size_t target_idx = 0; target_idx < target_infos.size(); ++target_idx) {
+      *buff_i64++ = static_cast<int64_t>(i);
+    }
+  }
+}
+
+BenchmarkResult benchmark_reduce(const size_t entry_count) {
+  const auto target_infos = make_int_agg_target_infos();
+  const auto query_mem_desc = make_perfect_hash_desc(target_infos, entry_count);
+  return run_benchmark(
+      "result_set_reduce_perfect_hash_card_" + std::to_string(entry_count), [&] {
+        const auto row_set_mem_owner = std::make_shared<RowSetMemoryOwner>();
+        const auto rs1 = std::make_unique<ResultSet>(target_infos,
+                                                     ExecutorDeviceType::CPU,
+                                                     query_mem_desc,
+                                                     row_set_mem_owner,
+                                                     nullptr);
+        fill_perfect_hash_storage(
+            rs1->allocateStorage()->getUnderlyingBuffer(), target_infos, query_mem_desc);
+        const auto rs2 = std::make_unique<ResultSet>(target_infos,
+                                                     ExecutorDeviceType::CPU,
+                                                     query_mem_desc,
+                                                     row_set_mem_owner,
+                                                     nullptr);
+        fill_perfect_hash_storage(
+            rs2->allocateStorage()->getUnderlyingBuffer(), target_infos, query_mem_desc);
+        ResultSetManager rs_manager;
+        std::vector<ResultSet*> storage_set{rs1.get(), rs2.get()};
+        g_sink += reinterpret_cast<int64_t>(rs_manager.reduce(storage_set));
+      });
+}
+
+BenchmarkResult benchmark_string_dictionary_bulk(const size_t unique_count,
+                                                 const size_t total_count) {
+  std::vector<std::string> strings;
+  strings.reserve(total_count);
+  for (size_t i = 0; i < total_count; ++i) {
+    strings.push_back("benchmark_string_" + std::to_string(i % unique_count));
+  }
+  std::shuffle(strings.begin(), strings.end(), std::mt19937(42));
+  const auto dict_path =
+      boost::filesystem::path(BASE_PATH) / "kernel_benchmark_string_dict";
+  return run_benchmark("string_dict_bulk_unique_" + std::to_string(unique_count) +
+                           "_total_" + std::to_string(total_count),
+                       [&] {
+                         boost::filesystem::remove_all(dict_path);
+                         boost::filesystem::create_directories(dict_path);
+                         StringDictionary string_dict(dict_path.string(), false, false);
+                         std::vector<int32_t> encoded(strings.size());
+                         string_dict.getOrAddBulk(strings, encoded.data());
+                         g_sink += encoded.back();
+                       });
+}
+
+void write_report(const std::vector<BenchmarkResult>& results,
+                  const std::string& output_path) {
+  std::ofstream out(output_path);
+  CHECK(out);
+  out << "[";
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (i) {
+      out << ", ";
+    }
+    out << "{\"results\": {"
+        << "\"run_label\": \"" << g_label << "\", "
+        << "\"run_gpu_name\": \"\", "
+        << "\"run_table\": \"kernels\", "
+        << "\"query_id\": \"" << results[i].query_id << "\", "
+        << "\"query_exec_avg\": " << results[i].avg_ms << ", "
+        << "\"query_exec_min\": " << results[i].min_ms << ", "
+        << "\"query_exec_max\": " << results[i].max_ms << ", "
+        << "\"query_total_avg\": " << results[i].avg_ms << "}}";
+  }
+  out << "]\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string output_path{"kernel_benchmark.json"};
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg{argv[i]};
+    if (arg == "--output" && i + 1 < argc) {
+      output_path = argv[++i];
+    } else if (arg == "--label" && i + 1 < argc) {
+      g_label = argv[++i];
+    } else if (arg == "--iterations" && i + 1 < argc) {
+      g_iterations = std::stoul(argv[++i]);
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--output <file>] [--label <run label>] [--iterations <n>]"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<BenchmarkResult> results;
+  for (const size_t cardinality : {size_t(1) << 16, size_t(1) << 22}) {
+    for (auto& result : benchmark_hash_join<int32_t>(cardinality)) {
+      results.push_back(result);
+    }
+    for (auto& result : benchmark_hash_join<int64_t>(cardinality)) {
+      results.push_back(result);
+    }
+  }
+  for (const size_t entry_count : {size_t(1) << 12, size_t(1) << 18}) {
+    results.push_back(benchmark_reduce(entry_count));
+  }
+  results.push_back(benchmark_string_dictionary_bulk(1000, 1000 * 1000));
+  results.push_back(benchmark_string_dictionary_bulk(1000 * 1000, 1000 * 1000));
+
+  write_report(results, output_path);
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file MetadataOnlyAggregateTest.cpp
+ * @brief Checks the metadata-only shortcut for unfiltered COUNT(*), MIN and
+ * MAX against the regular scan path. The dangerous side of the shortcut is
+ * the bailouts: after an UPDATE chunk stats are only widened bounds and after
+ * a DELETE the tuple counts still include the deleted rows, so serving either
+ * from metadata would return stale aggregates. Every query here runs with the
+ * shortcut enabled and disabled and both results must agree with the known
+ * table contents.
+ */
+
+#include "TestHelpers.h"
+
+#include "../Catalog/Catalog.h"
+#include "../QueryEngine/Execute.h"
+#include "../QueryEngine/TableOptimizer.h"
+#include "../QueryRunner/QueryRunner.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+extern bool g_enable_metadata_only_aggregates;
+
+using namespace TestHelpers;
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+inline void run_ddl_statement(const std::string& stmt) {
+  QR::get()->runDDLStatement(stmt);
+}
+
+std::shared_ptr<ResultSet> run_multiple_agg(const std::string& query_str,
+                                            const ExecutorDeviceType device_type) {
+  return QR::get()->runSQL(query_str, device_type, false, false);
+}
+
+void run_query(const std::string& query_str) {
+  run_multiple_agg(query_str, ExecutorDeviceType::CPU);
+}
+
+int64_t run_agg(const std::string& query_str) {
+  auto rows = run_multiple_agg(query_str, ExecutorDeviceType::CPU);
+  auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  return v<int64_t>(crt_row[0]);
+}
+
+// Runs the aggregate with the metadata shortcut on and off; both must agree
+// with each other and with the expected value.
+void check_agg(const std::string& query_str, const int64_t expected) {
+  g_enable_metadata_only_aggregates = true;
+  ASSERT_EQ(expected, run_agg(query_str)) << "metadata path: " << query_str;
+  g_enable_metadata_only_aggregates = false;
+  ASSERT_EQ(expected, run_agg(query_str)) << "scan path: " << query_str;
+  g_enable_metadata_only_aggregates = true;
+}
+
+void vacuum_and_recompute_metadata(const std::string& table_name) {
+  auto cat = QR::get()->getCatalog();
+  const auto td = cat->getMetadataForTable(table_name);
+  auto executor = Executor::getExecutor(cat->getCurrentDB().dbId);
+  TableOptimizer optimizer(td, executor.get(), *cat);
+  EXPECT_NO_THROW(optimizer.vacuumDeletedRows());
+  EXPECT_NO_THROW(optimizer.recomputeMetadata());
+}
+
+class MetadataOnlyAggregateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    run_ddl_statement("DROP TABLE IF EXISTS meta_agg_test;");
+    // two fragments, so the merge over per-fragment metadata is exercised
+    run_ddl_statement(
+        "CREATE TABLE meta_agg_test (x INT, f FLOAT) WITH (FRAGMENT_SIZE=4);");
+    run_query("INSERT INTO meta_agg_test VALUES (1, 1.5);");
+    run_query("INSERT INTO meta_agg_test VALUES (2, 2.5);");
+    run_query("INSERT INTO meta_agg_test VALUES (NULL, 3.5);");
+    run_query("INSERT INTO meta_agg_test VALUES (4, 4.5);");
+    run_query("INSERT INTO meta_agg_test VALUES (5, 5.5);");
+    run_query("INSERT INTO meta_agg_test VALUES (100, 6.5);");
+  }
+
+  void TearDown() override { run_ddl_statement("DROP TABLE IF EXISTS meta_agg_test;"); }
+};
+
+}  // namespace
+
+TEST_F(MetadataOnlyAggregateTest, FastPath) {
+  check_agg("SELECT COUNT(*) FROM meta_agg_test;", 6);
+  check_agg("SELECT MIN(x) FROM meta_agg_test;", 1);
+  check_agg("SELECT MAX(x) FROM meta_agg_test;", 100);
+  check_agg("SELECT CAST(MIN(f) * 10 AS INT) FROM meta_agg_test;", 15);
+  check_agg("SELECT CAST(MAX(f) * 10 AS INT) FROM meta_agg_test;", 65);
+}
+
+TEST_F(MetadataOnlyAggregateTest, BailoutAfterUpdate) {
+  // pull the maximum down; chunk stats keep the old bound, only dirty-flagged
+  run_query("UPDATE meta_agg_test SET x = 6 WHERE x = 100;");
+  check_agg("SELECT MAX(x) FROM meta_agg_test;", 6);
+  check_agg("SELECT MIN(x) FROM meta_agg_test;", 1);
+  check_agg("SELECT COUNT(*) FROM meta_agg_test;", 6);
+  // pull the minimum up as well
+  run_query("UPDATE meta_agg_test SET x = 3 WHERE x = 1;");
+  check_agg("SELECT MIN(x) FROM meta_agg_test;", 2);
+}
+
+TEST_F(MetadataOnlyAggregateTest, BailoutAfterDelete) {
+  // the per-fragment tuple counts still include deleted rows
+  run_query("DELETE FROM meta_agg_test WHERE x = 100;");
+  check_agg("SELECT COUNT(*) FROM meta_agg_test;", 5);
+  check_agg("SELECT MAX(x) FROM meta_agg_test;", 5);
+  run_query("DELETE FROM meta_agg_test WHERE x = 1;");
+  check_agg("SELECT COUNT(*) FROM meta_agg_test;", 4);
+  check_agg("SELECT MIN(x) FROM meta_agg_test;", 2);
+}
+
+TEST_F(MetadataOnlyAggregateTest, EligibleAgainAfterOptimize) {
+  run_query("UPDATE meta_agg_test SET x = 6 WHERE x = 100;");
+  run_query("DELETE FROM meta_agg_test WHERE x = 1;");
+  vacuum_and_recompute_metadata("meta_agg_test");
+  check_agg("SELECT COUNT(*) FROM meta_agg_test;", 5);
+  check_agg("SELECT MIN(x) FROM meta_agg_test;", 2);
+  check_agg("SELECT MAX(x) FROM meta_agg_test;", 6);
+}
+
+TEST_F(MetadataOnlyAggregateTest, EmptyTable) {
+  run_ddl_statement("DROP TABLE IF EXISTS meta_agg_empty;");
+  run_ddl_statement("CREATE TABLE meta_agg_empty (x INT);");
+  check_agg("SELECT COUNT(*) FROM meta_agg_empty;", 0);
+  run_ddl_statement("DROP TABLE meta_agg_empty;");
+}
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  QR::init(BASE_PATH);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  QR::reset();
+  return err;
+}
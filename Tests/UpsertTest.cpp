@@ -0,0 +1,173 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file UpsertTest.cpp
+ * @brief Behavioral coverage for tables declared WITH (UNIQUE_KEY='col'):
+ * inserts into such a table rewrite the matched row in place when the key
+ * already exists and append otherwise, and the key index survives the
+ * invalidation paths (DELETE, key rewrites) by rebuilding on the next upsert.
+ */
+
+#include "TestHelpers.h"
+
+#include "../Catalog/Catalog.h"
+#include "../QueryEngine/Execute.h"
+#include "../QueryRunner/QueryRunner.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using namespace TestHelpers;
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+inline void run_ddl_statement(const std::string& stmt) {
+  QR::get()->runDDLStatement(stmt);
+}
+
+std::shared_ptr<ResultSet> run_multiple_agg(const std::string& query_str,
+                                            const ExecutorDeviceType device_type) {
+  return QR::get()->runSQL(query_str, device_type, false, false);
+}
+
+void run_query(const std::string& query_str) {
+  run_multiple_agg(query_str, ExecutorDeviceType::CPU);
+}
+
+int64_t run_count(const std::string& query_str) {
+  auto rows = run_multiple_agg(query_str, ExecutorDeviceType::CPU);
+  auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  return v<int64_t>(crt_row[0]);
+}
+
+class UpsertTableTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    run_ddl_statement("DROP TABLE IF EXISTS upsert_test;");
+    run_ddl_statement(
+        "CREATE TABLE upsert_test (id INT, val INT, s TEXT ENCODING DICT) WITH "
+        "(UNIQUE_KEY='id');");
+  }
+
+  void TearDown() override { run_ddl_statement("DROP TABLE IF EXISTS upsert_test;"); }
+};
+
+}  // namespace
+
+TEST_F(UpsertTableTest, UpdateExistingKey) {
+  run_query("INSERT INTO upsert_test VALUES (1, 10, 'a');");
+  run_query("INSERT INTO upsert_test VALUES (2, 20, 'b');");
+  ASSERT_EQ(int64_t(2), run_count("SELECT COUNT(*) FROM upsert_test;"));
+  // same key again: the existing row is rewritten, not duplicated
+  run_query("INSERT INTO upsert_test VALUES (1, 11, 'c');");
+  ASSERT_EQ(int64_t(2), run_count("SELECT COUNT(*) FROM upsert_test;"));
+  ASSERT_EQ(int64_t(11),
+            run_count("SELECT MAX(val) FROM upsert_test WHERE id = 1;"));
+  ASSERT_EQ(int64_t(1),
+            run_count("SELECT COUNT(*) FROM upsert_test WHERE id = 1 AND s = 'c';"));
+  ASSERT_EQ(int64_t(0),
+            run_count("SELECT COUNT(*) FROM upsert_test WHERE id = 1 AND s = 'a';"));
+  // the untouched row is still intact
+  ASSERT_EQ(int64_t(1),
+            run_count("SELECT COUNT(*) FROM upsert_test WHERE id = 2 AND val = 20;"));
+}
+
+TEST_F(UpsertTableTest, InsertNewKey) {
+  run_query("INSERT INTO upsert_test VALUES (1, 10, 'a');");
+  run_query("INSERT INTO upsert_test VALUES (2, 20, 'b');");
+  run_query("INSERT INTO upsert_test VALUES (3, 30, 'c');");
+  ASSERT_EQ(int64_t(3), run_count("SELECT COUNT(*) FROM upsert_test;"));
+  ASSERT_EQ(int64_t(1),
+            run_count("SELECT COUNT(*) FROM upsert_test WHERE id = 3 AND val = 30;"));
+}
+
+TEST_F(UpsertTableTest, NullKeysAppend) {
+  run_query("INSERT INTO upsert_test VALUES (NULL, 1, 'x');");
+  run_query("INSERT INTO upsert_test VALUES (NULL, 2, 'y');");
+  ASSERT_EQ(int64_t(2), run_count("SELECT COUNT(*) FROM upsert_test;"));
+}
+
+TEST_F(UpsertTableTest, RebuildAfterDelete) {
+  run_query("INSERT INTO upsert_test VALUES (1, 10, 'a');");
+  run_query("INSERT INTO upsert_test VALUES (2, 20, 'b');");
+  // DELETE invalidates the key index; the next upsert rebuilds it over live
+  // rows only, so the deleted key appends as a fresh row
+  run_query("DELETE FROM upsert_test WHERE id = 1;");
+  ASSERT_EQ(int64_t(1), run_count("SELECT COUNT(*) FROM upsert_test;"));
+  run_query("INSERT INTO upsert_test VALUES (1, 12, 'd');");
+  ASSERT_EQ(int64_t(2), run_count("SELECT COUNT(*) FROM upsert_test;"));
+  ASSERT_EQ(int64_t(1),
+            run_count("SELECT COUNT(*) FROM upsert_test WHERE id = 1 AND val = 12;"));
+  // and upserting it once more updates the resurrected row, not a duplicate
+  run_query("INSERT INTO upsert_test VALUES (1, 13, 'e');");
+  ASSERT_EQ(int64_t(2), run_count("SELECT COUNT(*) FROM upsert_test;"));
+  ASSERT_EQ(int64_t(13),
+            run_count("SELECT MAX(val) FROM upsert_test WHERE id = 1;"));
+}
+
+TEST_F(UpsertTableTest, RebuildAfterKeyRewrite) {
+  run_query("INSERT INTO upsert_test VALUES (1, 10, 'a');");
+  run_query("INSERT INTO upsert_test VALUES (2, 20, 'b');");
+  // rewriting key values through UPDATE conflicts with what the index saw at
+  // insert time and must invalidate it
+  run_query("UPDATE upsert_test SET id = 3 WHERE id = 1;");
+  // the new key value is found after the rebuild: update in place
+  run_query("INSERT INTO upsert_test VALUES (3, 31, 'f');");
+  ASSERT_EQ(int64_t(2), run_count("SELECT COUNT(*) FROM upsert_test;"));
+  ASSERT_EQ(int64_t(31),
+            run_count("SELECT MAX(val) FROM upsert_test WHERE id = 3;"));
+  // the old key value is gone: same key appends again
+  run_query("INSERT INTO upsert_test VALUES (1, 14, 'g');");
+  ASSERT_EQ(int64_t(3), run_count("SELECT COUNT(*) FROM upsert_test;"));
+}
+
+TEST(UpsertDDL, RejectedOnUnsupportedTables) {
+  run_ddl_statement("DROP TABLE IF EXISTS upsert_reject;");
+  // variable length columns can't go through the in-place rewrite path
+  EXPECT_ANY_THROW(
+      run_ddl_statement("CREATE TABLE upsert_reject (id INT, s TEXT ENCODING NONE) "
+                        "WITH (UNIQUE_KEY='id');"));
+  // the key itself must be an integer or dictionary-encoded text column
+  EXPECT_ANY_THROW(
+      run_ddl_statement("CREATE TABLE upsert_reject (id FLOAT, val INT) WITH "
+                        "(UNIQUE_KEY='id');"));
+  // and it has to exist
+  EXPECT_ANY_THROW(run_ddl_statement(
+      "CREATE TABLE upsert_reject (id INT) WITH (UNIQUE_KEY='nope');"));
+}
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  QR::init(BASE_PATH);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  QR::reset();
+  return err;
+}
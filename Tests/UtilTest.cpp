@@ -32,6 +32,25 @@ TEST(Utils, StringLike) {
   ASSERT_TRUE(string_like("hello [", 7, "%\\[%", 4, '\\'));
 }
 
+TEST(Utils, RegexpLiteralPrefilter) {
+  // A quantified group makes everything inside it optional; the prefilter
+  // must not demand the group's contents.
+  ASSERT_TRUE(regexp_like("definitely", 10, "(abcdef)*def.*", 14, '\\'));
+  ASSERT_TRUE(regexp_like("definitely", 10, "(abcdef)?def.*", 14, '\\'));
+  ASSERT_TRUE(regexp_like("abcdefdefinitely", 16, "(abcdef)*def.*", 14, '\\'));
+  ASSERT_FALSE(regexp_like("indefinitely", 12, "(abcdef)*def.*", 14, '\\'));
+  // Patterns with a genuinely required literal keep matching on both sides of
+  // the prefilter.
+  ASSERT_TRUE(regexp_like("2018 ERROR: oops", 16, ".*ERROR.*", 9, '\\'));
+  ASSERT_FALSE(regexp_like("2018 WARN: meh", 14, ".*ERROR.*", 9, '\\'));
+  ASSERT_TRUE(regexp_like("xERRORx", 7, ".*ERROR+.*", 10, '\\'));
+  ASSERT_FALSE(regexp_like("xERROx", 6, ".*ERROR+.*", 10, '\\'));
+  // Optional atoms and bounds drop out of the required run.
+  ASSERT_TRUE(regexp_like("ERROR", 5, "ERRORS?", 7, '\\'));
+  ASSERT_TRUE(regexp_like("ERRORS", 6, "ERRORS?", 7, '\\'));
+  ASSERT_TRUE(regexp_like("ERROR", 5, "ERRORS{0,1}", 11, '\\'));
+}
+
 TEST(Utils, Regexp) {
   ASSERT_TRUE(regexp_like("abc", 3, "abc", 3, '\\'));
   ASSERT_FALSE(regexp_like("abc", 3, "ABC", 3, '\\'));
@@ -56,6 +56,7 @@
 #include "Parser/ReservedKeywords.h"
 #include "Parser/parser.h"
 #include "Planner/Planner.h"
+#include "QueryEngine/AdmissionController.h"
 #include "QueryEngine/CalciteAdapter.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
@@ -65,6 +66,7 @@
 #include "QueryEngine/TableOptimizer.h"
 #include "QueryEngine/ThriftSerializers.h"
 #include "Shared/SQLTypeUtilities.h"
+#include "Shared/SqlTypesLayout.h"
 #include "Shared/StringTransform.h"
 #include "Shared/SysInfo.h"
 #include "Shared/geo_types.h"
@@ -72,6 +74,7 @@
 #include "Shared/import_helpers.h"
 #include "Shared/mapd_shared_mutex.h"
 #include "Shared/measure.h"
+#include "Shared/nvtx_helpers.h"
 #include "Shared/scope.h"
 
 #include <fcntl.h>
@@ -89,6 +92,7 @@
 #include <boost/program_options.hpp>
 #include <boost/regex.hpp>
 #include <boost/tokenizer.hpp>
+#include <boost/uuid/sha1.hpp>
 #include <cmath>
 #include <csignal>
 #include <fstream>
@@ -115,6 +119,21 @@ using namespace Lock_Namespace;
 
 #define INVALID_SESSION_ID ""
 
+// When set, every query writes its stage timeline as Chrome trace-event JSON
+// into this directory, one file per query.
+std::string g_query_trace_dir;
+
+// When set, a successful password check caches a salted digest of the
+// credentials so repeated connects from short-lived clients skip the slow
+// bcrypt verification. Entries are fenced by the SysCatalog privileges
+// version, so user DDL (including password changes) invalidates them.
+bool g_enable_connect_credential_cache{true};
+
+// Comma-separated users (typically ETL service accounts) whose queries run
+// batch-class: they wait for interactive queries when competing for execution
+// slots and yield the devices at fragment kernel boundaries.
+std::string g_low_priority_users;
+
 #define THROW_MAPD_EXCEPTION(errstr) \
   TMapDException ex;                 \
   ex.error_msg = errstr;             \
@@ -123,6 +142,20 @@ using namespace Lock_Namespace;
 
 namespace {
 
+std::string salted_credential_digest(const std::string& salt,
+                                     const std::string& passwd) {
+  boost::uuids::detail::sha1 sha1;
+  unsigned int digest[5];
+  const auto salted = salt + passwd;
+  sha1.process_bytes(salted.c_str(), salted.length());
+  sha1.get_digest(digest);
+  std::stringstream ss;
+  for (size_t i = 0; i < 5; i++) {
+    ss << std::hex << digest[i];
+  }
+  return ss.str();
+}
+
 SessionMap::iterator get_session_from_map(const TSessionId& session,
                                           SessionMap& session_map) {
   auto session_it = session_map.find(session);
@@ -217,6 +250,19 @@ MapDHandler::MapDHandler(const std::vector<LeafHostInfo>& db_leaves,
     }
   }
 
+  credential_cache_salt_ = generate_random_string(32);
+
+  if (!g_low_priority_users.empty()) {
+    std::vector<std::string> users;
+    boost::split(users, g_low_priority_users, boost::is_any_of(","));
+    for (auto& user : users) {
+      boost::trim(user);
+      if (!user.empty()) {
+        low_priority_users_.insert(user);
+      }
+    }
+  }
+
   std::string calcite_session_prefix = "calcite-" + generate_random_string(64);
 
   calcite_ = std::make_shared<Calcite>(
@@ -325,9 +371,24 @@ void MapDHandler::connect(TSessionId& session,
   std::string dbname2 = dbname;      // login() may reset dbname given as argument
   Catalog_Namespace::UserMetadata user_meta;
   std::shared_ptr<Catalog> cat = nullptr;
+  // Skip the expensive password verification if exactly these credentials
+  // passed it before and no user/role DDL has happened since.
+  bool credentials_cached = false;
+  std::string credential_key;
+  std::string credential_digest;
+  const auto privileges_version = SysCatalog::instance().getPrivilegesVersion();
+  if (g_enable_connect_credential_cache && !super_user_rights_) {
+    credential_key = username + '/' + dbname;
+    credential_digest = salted_credential_digest(credential_cache_salt_, passwd);
+    std::lock_guard<std::mutex> lock(credential_cache_mutex_);
+    const auto it = credential_cache_.find(credential_key);
+    credentials_cached = it != credential_cache_.end() &&
+                         it->second.privileges_version == privileges_version &&
+                         it->second.salted_digest == credential_digest;
+  }
   try {
     cat = SysCatalog::instance().login(
-        dbname2, username2, passwd, user_meta, !super_user_rights_);
+        dbname2, username2, passwd, user_meta, !super_user_rights_ && !credentials_cached);
   } catch (std::exception& e) {
     THROW_MAPD_EXCEPTION(e.what());
   }
@@ -341,6 +402,11 @@ void MapDHandler::connect(TSessionId& session,
     THROW_MAPD_EXCEPTION("Unauthorized Access: user " + username +
                          " is not allowed to access database " + dbname2 + ".");
   }
+  if (g_enable_connect_credential_cache && !super_user_rights_ &&
+      !credentials_cached) {
+    std::lock_guard<std::mutex> lock(credential_cache_mutex_);
+    credential_cache_[credential_key] = {privileges_version, credential_digest};
+  }
   connect_impl(session, passwd, dbname2, user_meta, cat, log_session);
 }
 
@@ -394,6 +460,14 @@ void MapDHandler::disconnect_impl(const SessionMap::iterator& session_it) {
   if (render_handler_) {
     render_handler_->disconnect(session_id);
   }
+  {
+    std::lock_guard<std::mutex> lock(prepared_statements_mutex_);
+    prepared_statements_.erase(session_id);
+  }
+  {
+    std::lock_guard<std::mutex> lock(cursors_mutex_);
+    cursors_.erase(session_id);
+  }
   sessions_.erase(session_it);
 }
 
@@ -414,34 +488,36 @@ void MapDHandler::switch_database(const TSessionId& session, const std::string&
 
 void MapDHandler::interrupt(const TSessionId& session) {
   LOG_SESSION(session);
-  if (g_enable_dynamic_watchdog) {
-    // Shared lock to allow simultaneous interrupts of multiple sessions
-    mapd_shared_lock<mapd_shared_mutex> read_lock(sessions_mutex_);
-    if (leaf_aggregator_.leafCount() > 0) {
-      leaf_aggregator_.interrupt(session);
-    }
+  // Interrupts are accepted unconditionally: CPU kernels and chunk fetches
+  // poll the executor flag at fragment boundaries either way. Only aborting a
+  // GPU kernel mid-flight additionally needs the dynamic watchdog
+  // instrumentation compiled into it.
+  // Shared lock to allow simultaneous interrupts of multiple sessions
+  mapd_shared_lock<mapd_shared_mutex> read_lock(sessions_mutex_);
+  if (leaf_aggregator_.leafCount() > 0) {
+    leaf_aggregator_.interrupt(session);
+  }
 
-    auto session_it = get_session_it_unsafe(session);
-    auto& cat = session_it->second.get()->getCatalog();
-    const auto dbname = cat.getCurrentDB().dbName;
-    auto executor = Executor::getExecutor(cat.getCurrentDB().dbId,
-                                          jit_debug_ ? "/tmp" : "",
-                                          jit_debug_ ? "mapdquery" : "",
-                                          mapd_parameters_,
-                                          nullptr);
-    CHECK(executor);
+  auto session_it = get_session_it_unsafe(session);
+  auto& cat = session_it->second.get()->getCatalog();
+  const auto dbname = cat.getCurrentDB().dbName;
+  auto executor = Executor::getExecutor(cat.getCurrentDB().dbId,
+                                        jit_debug_ ? "/tmp" : "",
+                                        jit_debug_ ? "mapdquery" : "",
+                                        mapd_parameters_,
+                                        nullptr);
+  CHECK(executor);
 
-    VLOG(1) << "Received interrupt: "
-            << "Session " << *session_it->second << ", Executor " << executor
-            << ", leafCount " << leaf_aggregator_.leafCount() << ", User "
-            << session_it->second->get_currentUser().userName << ", Database " << dbname
-            << std::endl;
+  VLOG(1) << "Received interrupt: "
+          << "Session " << *session_it->second << ", Executor " << executor
+          << ", leafCount " << leaf_aggregator_.leafCount() << ", User "
+          << session_it->second->get_currentUser().userName << ", Database " << dbname
+          << std::endl;
 
-    executor->interrupt();
+  executor->interrupt();
 
-    LOG(INFO) << "User " << session_it->second->get_currentUser().userName
-              << " interrupted session with database " << dbname << std::endl;
-  }
+  LOG(INFO) << "User " << session_it->second->get_currentUser().userName
+            << " interrupted session with database " << dbname << std::endl;
 }
 
 void MapDHandler::get_server_status(TServerStatus& _return, const TSessionId& session) {
@@ -745,6 +821,45 @@ TDatum MapDHandler::value_to_thrift(const TargetValue& tv, const SQLTypeInfo& ti
   return datum;
 }
 
+void MapDHandler::acquire_query_slot(const bool low_priority) {
+  if (!mapd_parameters_.max_concurrent_queries) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(query_slots_mutex_);
+  if (low_priority) {
+    // Batch-class queries only take a slot when no interactive query is
+    // waiting for one, so a long ETL backlog cannot queue ahead of dashboards.
+    query_slots_cv_.wait(lock, [this] {
+      return queries_executing_ < mapd_parameters_.max_concurrent_queries &&
+             high_priority_queries_waiting_ == 0;
+    });
+  } else {
+    ++high_priority_queries_waiting_;
+    query_slots_cv_.wait(lock, [this] {
+      return queries_executing_ < mapd_parameters_.max_concurrent_queries;
+    });
+    --high_priority_queries_waiting_;
+  }
+  ++queries_executing_;
+}
+
+void MapDHandler::release_query_slot() {
+  if (!mapd_parameters_.max_concurrent_queries) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(query_slots_mutex_);
+    CHECK_GT(queries_executing_, size_t(0));
+    --queries_executing_;
+  }
+  query_slots_cv_.notify_all();
+}
+
+bool MapDHandler::is_low_priority_session(
+    const Catalog_Namespace::SessionInfo& session_info) const {
+  return low_priority_users_.count(session_info.get_currentUser().userName) > 0;
+}
+
 void MapDHandler::sql_execute(TQueryResult& _return,
                               const TSessionId& session,
                               const std::string& query_str,
@@ -758,6 +873,8 @@ void MapDHandler::sql_execute(TQueryResult& _return,
     THROW_MAPD_EXCEPTION(std::string("At most one of first_n and at_most_n can be set"));
   }
   const auto session_info = get_session_copy(session);
+  acquire_query_slot(is_low_priority_session(session_info));
+  ScopeGuard release_slot = [this] { release_query_slot(); };
   if (leaf_aggregator_.leafCount() > 0) {
     if (!agg_handler_) {
       THROW_MAPD_EXCEPTION("Distributed support is disabled.");
@@ -836,6 +953,8 @@ void MapDHandler::sql_execute_df(TDataFrame& _return,
                                  const int32_t first_n) {
   LOG_SESSION(session, "query_str", hide_sensitive_data_from_query(query_str));
   const auto session_info = get_session_copy(session);
+  acquire_query_slot(is_low_priority_session(session_info));
+  ScopeGuard release_slot = [this] { release_query_slot(); };
   if (device_type == TDeviceType::GPU) {
     const auto executor_device_type = session_info.get_executor_device_type();
     if (executor_device_type != ExecutorDeviceType::GPU) {
@@ -902,6 +1021,203 @@ void MapDHandler::sql_execute_gdf(TDataFrame& _return,
   sql_execute_df(_return, session, query_str, TDeviceType::GPU, device_id, first_n);
 }
 
+namespace {
+
+// Placeholders are bare '?' characters outside of string literals. Quotes
+// inside string literals are escaped by doubling, which this scan handles by
+// simply toggling on every quote.
+std::vector<size_t> get_placeholder_positions(const std::string& query) {
+  std::vector<size_t> positions;
+  bool in_string = false;
+  for (size_t i = 0; i < query.size(); ++i) {
+    if (query[i] == '\'') {
+      in_string = !in_string;
+    } else if (query[i] == '?' && !in_string) {
+      positions.push_back(i);
+    }
+  }
+  return positions;
+}
+
+// Parameters always bind as quoted string literals (or NULL), relying on the
+// implicit casts the analyzer applies to literals; quoting keeps the
+// parameter values from being parsed as anything but a literal.
+std::string bind_placeholders(const std::string& query,
+                              const std::vector<size_t>& positions,
+                              const std::vector<TStringValue>& parameters) {
+  CHECK_EQ(positions.size(), parameters.size());
+  std::string bound;
+  bound.reserve(query.size());
+  size_t last = 0;
+  for (size_t i = 0; i < positions.size(); ++i) {
+    bound.append(query, last, positions[i] - last);
+    const auto& parameter = parameters[i];
+    if (parameter.is_null) {
+      bound.append("NULL");
+    } else {
+      bound.push_back('\'');
+      for (const char c : parameter.str_val) {
+        if (c == '\'') {
+          bound.push_back('\'');
+        }
+        bound.push_back(c);
+      }
+      bound.push_back('\'');
+    }
+    last = positions[i] + 1;
+  }
+  bound.append(query, last, std::string::npos);
+  return bound;
+}
+
+}  // namespace
+
+int64_t MapDHandler::sql_prepare(const TSessionId& session, const std::string& query) {
+  LOG_SESSION(session, "query_str", hide_sensitive_data_from_query(query));
+  get_session_copy(session);  // throws if the session is invalid
+  std::lock_guard<std::mutex> lock(prepared_statements_mutex_);
+  const auto statement_id = next_prepared_statement_id_++;
+  prepared_statements_[session].emplace(
+      statement_id, PreparedStatement{query, get_placeholder_positions(query)});
+  return statement_id;
+}
+
+void MapDHandler::sql_execute_prepared(TQueryResult& _return,
+                                       const TSessionId& session,
+                                       const int64_t statement_id,
+                                       const std::vector<TStringValue>& parameters,
+                                       const bool column_format,
+                                       const std::string& nonce,
+                                       const int32_t first_n,
+                                       const int32_t at_most_n) {
+  std::string bound_query;
+  {
+    std::lock_guard<std::mutex> lock(prepared_statements_mutex_);
+    const auto session_statements_it = prepared_statements_.find(session);
+    if (session_statements_it == prepared_statements_.end() ||
+        !session_statements_it->second.count(statement_id)) {
+      THROW_MAPD_EXCEPTION("Exception: unknown prepared statement id " +
+                           std::to_string(statement_id));
+    }
+    const auto& prepared_statement = session_statements_it->second.at(statement_id);
+    if (parameters.size() != prepared_statement.placeholder_positions.size()) {
+      THROW_MAPD_EXCEPTION(
+          "Exception: prepared statement expects " +
+          std::to_string(prepared_statement.placeholder_positions.size()) +
+          " parameters, " + std::to_string(parameters.size()) + " provided");
+    }
+    bound_query = bind_placeholders(
+        prepared_statement.query, prepared_statement.placeholder_positions, parameters);
+  }
+  sql_execute(_return, session, bound_query, column_format, nonce, first_n, at_most_n);
+}
+
+void MapDHandler::sql_release_prepared(const TSessionId& session,
+                                       const int64_t statement_id) {
+  LOG_SESSION(session);
+  std::lock_guard<std::mutex> lock(prepared_statements_mutex_);
+  const auto session_statements_it = prepared_statements_.find(session);
+  if (session_statements_it != prepared_statements_.end()) {
+    session_statements_it->second.erase(statement_id);
+  }
+}
+
+int64_t MapDHandler::sql_execute_cursor(const TSessionId& session,
+                                        const std::string& query_str) {
+  LOG_SESSION(session, "query_str", hide_sensitive_data_from_query(query_str));
+  const auto session_info = get_session_copy(session);
+  acquire_query_slot(is_low_priority_session(session_info));
+  ScopeGuard release_slot = [this] { release_query_slot(); };
+  try {
+    ParserWrapper pw{query_str};
+    if (pw.is_ddl || pw.is_update_dml || pw.isSelectExplain() ||
+        pw.getExplainType() != ParserWrapper::ExplainType::None) {
+      throw std::runtime_error("Cursors are only supported for SELECT statements");
+    }
+    TableMap table_map;
+    OptionalTableMap tableNames(table_map);
+    const auto query_ra =
+        parse_to_ra(query_str, {}, session_info, tableNames, mapd_parameters_);
+
+    mapd_shared_lock<mapd_shared_mutex> executeReadLock(
+        *LockMgr<mapd_shared_mutex, bool>::getMutex(ExecutorOuterLock, true));
+    std::vector<Lock_Namespace::TableLock> table_locks;
+    TableLockMgr::getTableLocks(
+        session_info.getCatalog(), tableNames.value(), table_locks);
+
+    auto& cat = session_info.getCatalog();
+    CompilationOptions co = {session_info.get_executor_device_type(),
+                             true,
+                             ExecutorOptLevel::Default,
+                             g_enable_dynamic_watchdog};
+    ExecutionOptions eo = {false,
+                           allow_multifrag_,
+                           false,
+                           allow_loop_joins_,
+                           g_enable_watchdog,
+                           jit_debug_,
+                           false,
+                           g_enable_dynamic_watchdog,
+                           g_dynamic_watchdog_time_limit,
+                           false,
+                           false,
+                           mapd_parameters_.gpu_input_mem_limit,
+                           is_low_priority_session(session_info)};
+    auto executor = Executor::getExecutor(cat.getCurrentDB().dbId,
+                                          jit_debug_ ? "/tmp" : "",
+                                          jit_debug_ ? "mapdquery" : "",
+                                          mapd_parameters_,
+                                          nullptr);
+    RelAlgExecutor ra_executor(executor.get(), cat);
+    const auto result = ra_executor.executeRelAlgQuery(query_ra, co, eo, nullptr);
+
+    std::lock_guard<std::mutex> lock(cursors_mutex_);
+    const auto cursor_id = next_cursor_id_++;
+    cursors_[session].emplace(
+        cursor_id,
+        Cursor{result.getRows(), result.getTargetsMeta(), std::make_shared<std::mutex>()});
+    return cursor_id;
+  } catch (std::exception& e) {
+    THROW_MAPD_EXCEPTION(std::string("Exception: ") + e.what());
+  }
+}
+
+void MapDHandler::sql_fetch_cursor(TQueryResult& _return,
+                                   const TSessionId& session,
+                                   const int64_t cursor_id,
+                                   const bool column_format,
+                                   const int32_t n) {
+  LOG_SESSION(session);
+  get_session_copy(session);  // throws if the session is invalid
+  Cursor cursor;
+  {
+    std::lock_guard<std::mutex> lock(cursors_mutex_);
+    const auto session_cursors_it = cursors_.find(session);
+    if (session_cursors_it == cursors_.end() ||
+        !session_cursors_it->second.count(cursor_id)) {
+      THROW_MAPD_EXCEPTION("Exception: unknown cursor id " + std::to_string(cursor_id));
+    }
+    cursor = session_cursors_it->second.at(cursor_id);
+  }
+  // The result set advances its own iteration state, so each fetch resumes
+  // where the previous one stopped; a short (or empty) page tells the client
+  // the cursor is exhausted. n < 0 fetches everything that's left.
+  std::lock_guard<std::mutex> fetch_lock(*cursor.fetch_mutex);
+  _return.execution_time_ms = measure<>::execution([&]() {
+    convert_rows(_return, cursor.targets, *cursor.result_set, column_format, n, -1);
+  });
+  _return.total_time_ms = _return.execution_time_ms;
+}
+
+void MapDHandler::sql_close_cursor(const TSessionId& session, const int64_t cursor_id) {
+  LOG_SESSION(session);
+  std::lock_guard<std::mutex> lock(cursors_mutex_);
+  const auto session_cursors_it = cursors_.find(session);
+  if (session_cursors_it != cursors_.end()) {
+    session_cursors_it->second.erase(cursor_id);
+  }
+}
+
 // For now we have only one user of a data frame in all cases.
 void MapDHandler::deallocate_df(const TSessionId& session,
                                 const TDataFrame& df,
@@ -1625,6 +1941,21 @@ void MapDHandler::get_table_details_impl(TTableDetails& _return,
                                          const bool get_physical) {
   auto session_info = get_session_copy(session);
   auto& cat = session_info.getCatalog();
+  const auto catalog_version = cat.getMetadataVersion();
+  const auto privileges_version = SysCatalog::instance().getPrivilegesVersion();
+  const auto cache_key = cat.getCurrentDB().dbName + '/' +
+                         session_info.get_currentUser().userName + "/table_details/" +
+                         table_name + '/' + std::to_string(get_system) +
+                         std::to_string(get_physical);
+  {
+    std::lock_guard<std::mutex> lock(metadata_cache_mutex_);
+    const auto it = metadata_cache_.find(cache_key);
+    if (it != metadata_cache_.end() && it->second.catalog_version == catalog_version &&
+        it->second.privileges_version == privileges_version) {
+      _return = it->second.table_details;
+      return;
+    }
+  }
   auto td = cat.getMetadataForTable(
       table_name,
       false);  // don't populate fragmenter on this call since we only want metadata
@@ -1692,6 +2023,10 @@ void MapDHandler::get_table_details_impl(TTableDetails& _return,
                  ? TPartitionDetail::REPLICATED
                  : (td->partitions == "SHARDED" ? TPartitionDetail::SHARDED
                                                 : TPartitionDetail::OTHER));
+  {
+    std::lock_guard<std::mutex> lock(metadata_cache_mutex_);
+    metadata_cache_[cache_key] = {catalog_version, privileges_version, {}, _return};
+  }
 }
 
 // DEPRECATED(2017-04-17) - use get_table_details()
@@ -1750,6 +2085,20 @@ void MapDHandler::get_tables_impl(std::vector<std::string>& table_names,
                                   const GetTablesType get_tables_type) {
   const auto session_info = get_session_copy(session);
   auto& cat = session_info.getCatalog();
+  const auto catalog_version = cat.getMetadataVersion();
+  const auto privileges_version = SysCatalog::instance().getPrivilegesVersion();
+  const auto cache_key = cat.getCurrentDB().dbName + '/' +
+                         session_info.get_currentUser().userName + "/tables/" +
+                         std::to_string(get_tables_type);
+  {
+    std::lock_guard<std::mutex> lock(metadata_cache_mutex_);
+    const auto it = metadata_cache_.find(cache_key);
+    if (it != metadata_cache_.end() && it->second.catalog_version == catalog_version &&
+        it->second.privileges_version == privileges_version) {
+      table_names = it->second.names;
+      return;
+    }
+  }
   const auto tables = cat.getAllTableMetadata();
   for (const auto td : tables) {
     if (td->shard >= 0) {
@@ -1778,6 +2127,10 @@ void MapDHandler::get_tables_impl(std::vector<std::string>& table_names,
     }
     table_names.push_back(td->tableName);
   }
+  {
+    std::lock_guard<std::mutex> lock(metadata_cache_mutex_);
+    metadata_cache_[cache_key] = {catalog_version, privileges_version, table_names, {}};
+  }
 }
 
 void MapDHandler::get_tables(std::vector<std::string>& table_names,
@@ -1892,6 +2245,21 @@ void MapDHandler::get_users(std::vector<std::string>& user_names,
   std::list<Catalog_Namespace::UserMetadata> user_list;
   const auto session_info = get_session_copy(session);
 
+  const auto privileges_version = SysCatalog::instance().getPrivilegesVersion();
+  const auto cache_key =
+      session_info.get_currentUser().isSuper
+          ? std::string("/users/all")
+          : session_info.getCatalog().getCurrentDB().dbName + "/users";
+  {
+    std::lock_guard<std::mutex> lock(metadata_cache_mutex_);
+    const auto it = metadata_cache_.find(cache_key);
+    if (it != metadata_cache_.end() &&
+        it->second.privileges_version == privileges_version) {
+      user_names = it->second.names;
+      return;
+    }
+  }
+
   if (!session_info.get_currentUser().isSuper) {
     user_list = SysCatalog::instance().getAllUserMetadata(
         session_info.getCatalog().getCurrentDB().dbId);
@@ -1901,6 +2269,10 @@ void MapDHandler::get_users(std::vector<std::string>& user_names,
   for (auto u : user_list) {
     user_names.push_back(u.userName);
   }
+  {
+    std::lock_guard<std::mutex> lock(metadata_cache_mutex_);
+    metadata_cache_[cache_key] = {0, privileges_version, user_names, {}};
+  }
 }
 
 void MapDHandler::get_version(std::string& version) {
@@ -1977,6 +2349,9 @@ void MapDHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
     nodeInfo.max_num_pages = memInfo.maxNumPages;
     nodeInfo.num_pages_allocated = memInfo.numPageAllocated;
     nodeInfo.is_allocation_capped = memInfo.isAllocationCapped;
+    nodeInfo.num_chunk_hits = memInfo.numChunkHits;
+    nodeInfo.num_chunk_misses = memInfo.numChunkMisses;
+    nodeInfo.num_chunk_evictions = memInfo.numChunkEvictions;
     for (auto gpu : memInfo.nodeMemoryData) {
       TMemoryData md;
       md.slab = gpu.slabNum;
@@ -2104,6 +2479,7 @@ void MapDHandler::load_table_binary(const TSessionId& session,
   auto checkpoint_lock = getTableLock<mapd_shared_mutex, mapd_unique_lock>(
       session_info.getCatalog(), table_name, LockType::CheckpointLock);
   loader->load(import_buffers, rows.size());
+  Parser::MaterializedViewRegistry::instance().refreshViews(session_info, table_name);
 }
 
 void MapDHandler::prepare_columnar_loader(
@@ -2227,6 +2603,7 @@ void MapDHandler::load_table_binary_columnar(const TSessionId& session,
   auto checkpoint_lock = getTableLock<mapd_shared_mutex, mapd_unique_lock>(
       session_info.getCatalog(), table_name, LockType::CheckpointLock);
   loader->load(import_buffers, numRows);
+  Parser::MaterializedViewRegistry::instance().refreshViews(session_info, table_name);
 }
 
 using RecordBatchVector = std::vector<std::shared_ptr<arrow::RecordBatch>>;
@@ -2282,31 +2659,44 @@ void MapDHandler::load_table_binary_arrow(const TSessionId& session,
 
   RecordBatchVector batches = loadArrowStream(arrow_stream);
 
-  // Assuming have one batch for now
-  if (batches.size() != 1) {
-    THROW_MAPD_EXCEPTION("Expected a single Arrow record batch. Import aborted");
+  if (batches.empty()) {
+    THROW_MAPD_EXCEPTION("Expected at least one Arrow record batch. Import aborted");
   }
 
-  std::shared_ptr<arrow::RecordBatch> batch = batches[0];
-
   std::unique_ptr<Importer_NS::Loader> loader;
   std::vector<std::unique_ptr<Importer_NS::TypedImportBuffer>> import_buffers;
   const auto session_info = get_session_copy(session);
   prepare_columnar_loader(session_info,
                           table_name,
-                          static_cast<size_t>(batch->num_columns()),
+                          static_cast<size_t>(batches.front()->num_columns()),
                           &loader,
                           &import_buffers);
 
   size_t numRows = 0;
   size_t col_idx = 0;
   try {
-    for (auto cd : loader->get_column_descs()) {
-      auto& array = *batch->column(col_idx);
-      Importer_NS::ArraySliceRange row_slice(0, array.length());
-      numRows =
-          import_buffers[col_idx]->add_arrow_values(cd, array, true, row_slice, nullptr);
-      col_idx++;
+    // batches of the stream append into the same import buffers; columns
+    // within a batch convert in parallel since each conversion thread owns
+    // its column's buffer
+    for (const auto& batch : batches) {
+      std::vector<std::future<size_t>> conversion_threads;
+      size_t thread_col_idx = 0;
+      for (auto cd : loader->get_column_descs()) {
+        conversion_threads.push_back(std::async(
+            std::launch::async,
+            [&batch, &import_buffers, cd](const size_t col_idx) {
+              auto& array = *batch->column(col_idx);
+              Importer_NS::ArraySliceRange row_slice(0, array.length());
+              return import_buffers[col_idx]->add_arrow_values(
+                  cd, array, true, row_slice, nullptr);
+            },
+            thread_col_idx++));
+      }
+      size_t batch_rows = 0;
+      for (col_idx = 0; col_idx < conversion_threads.size(); ++col_idx) {
+        batch_rows = conversion_threads[col_idx].get();
+      }
+      numRows += batch_rows;
     }
   } catch (const std::exception& e) {
     LOG(ERROR) << "Input exception thrown: " << e.what()
@@ -2318,6 +2708,7 @@ void MapDHandler::load_table_binary_arrow(const TSessionId& session,
   auto checkpoint_lock = getTableLock<mapd_shared_mutex, mapd_unique_lock>(
       session_info.getCatalog(), table_name, LockType::CheckpointLock);
   loader->load(import_buffers, numRows);
+  Parser::MaterializedViewRegistry::instance().refreshViews(session_info, table_name);
 }
 
 void MapDHandler::load_table(const TSessionId& session,
@@ -2427,6 +2818,7 @@ void MapDHandler::load_table(const TSessionId& session,
   auto checkpoint_lock = getTableLock<mapd_shared_mutex, mapd_unique_lock>(
       session_info.getCatalog(), table_name, LockType::CheckpointLock);
   loader->load(import_buffers, rows_completed);
+  Parser::MaterializedViewRegistry::instance().refreshViews(session_info, table_name);
 }
 
 char MapDHandler::unescape_char(std::string str) {
@@ -4350,8 +4742,10 @@ std::vector<PushedDownFilterInfo> MapDHandler::execute_rel_alg(
     const bool just_validate,
     const bool find_push_down_candidates,
     const bool just_calcite_explain,
-    const bool explain_optimized_ir) const {
+    const bool explain_optimized_ir,
+    const bool explain_analyze) const {
   INJECT_TIMER(execute_rel_alg);
+  NVTX_RANGE("execute_rel_alg");
   const auto& cat = session_info.getCatalog();
   CompilationOptions co = {executor_device_type,
                            true,
@@ -4370,12 +4764,25 @@ std::vector<PushedDownFilterInfo> MapDHandler::execute_rel_alg(
                          g_dynamic_watchdog_time_limit,
                          find_push_down_candidates,
                          just_calcite_explain,
-                         mapd_parameters_.gpu_input_mem_limit};
+                         mapd_parameters_.gpu_input_mem_limit,
+                         is_low_priority_session(session_info)};
+  // Under admission control, CPU-mode queries are routed to a bounded pool of
+  // dedicated executors so they don't queue behind long-running queries held
+  // by the default executor; GPU queries keep the default executor and its
+  // serialization, since they contend for device memory.
+  AdmissionController::Slot admission_slot;
+  size_t executor_index{0};
+  if (g_enable_admission_control && executor_device_type == ExecutorDeviceType::CPU &&
+      !just_validate) {
+    admission_slot = AdmissionController::getInstance().admitSmallQuery();
+    executor_index = admission_slot.slotIndex() + 1;
+  }
   auto executor = Executor::getExecutor(cat.getCurrentDB().dbId,
                                         jit_debug_ ? "/tmp" : "",
                                         jit_debug_ ? "mapdquery" : "",
                                         mapd_parameters_,
-                                        nullptr);
+                                        nullptr,
+                                        executor_index);
   RelAlgExecutor ra_executor(executor.get(), cat);
   ExecutionResult result{std::make_shared<ResultSet>(std::vector<TargetInfo>{},
                                                      ExecutorDeviceType::CPU,
@@ -4383,15 +4790,51 @@ std::vector<PushedDownFilterInfo> MapDHandler::execute_rel_alg(
                                                      nullptr,
                                                      nullptr),
                          {}};
+  // EXPLAIN ANALYZE runs the query for real with the stage timing collector
+  // active, so every INJECT_TIMER probe hit during execution (Calcite parse is
+  // reported separately, codegen, chunk fetch, kernels, reduction) lands in a
+  // per-stage breakdown returned instead of the rows. Only one collector can
+  // be active at a time; stages of queries running concurrently with the
+  // analyzed one show up in its report tagged with their thread.
+  std::shared_ptr<StageTimingCollector> stage_timings;
+  if (explain_analyze || !g_query_trace_dir.empty()) {
+    stage_timings = std::make_shared<StageTimingCollector>();
+    StageTimingCollector::setActive(stage_timings);
+  }
+  ScopeGuard reset_timing_collector = [&stage_timings] {
+    if (stage_timings) {
+      StageTimingCollector::setActive(nullptr);
+    }
+  };
   _return.execution_time_ms += measure<>::execution(
       [&]() { result = ra_executor.executeRelAlgQuery(query_ra, co, eo, nullptr); });
   // reduce execution time by the time spent during queue waiting
   _return.execution_time_ms -= result.getRows()->getQueueTime();
+  _return.fraction_sampled = result.getRows()->getFractionSampled();
   const auto& filter_push_down_info = result.getPushedDownFilterInfo();
   if (!filter_push_down_info.empty()) {
     return filter_push_down_info;
   }
-  if (just_explain) {
+  if (stage_timings && !g_query_trace_dir.empty()) {
+    const auto trace_path =
+        boost::filesystem::path(g_query_trace_dir) /
+        ("query_trace_" +
+         std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count()) +
+         ".json");
+    std::ofstream trace_stream(trace_path.string());
+    if (trace_stream) {
+      trace_stream << stage_timings->chromeTrace();
+      LOG(INFO) << "Wrote query trace to " << trace_path.string();
+    } else {
+      LOG(ERROR) << "Failed to write query trace to " << trace_path.string();
+    }
+  }
+  if (explain_analyze) {
+    StageTimingCollector::setActive(nullptr);
+    convert_explain(_return, ResultSet(stage_timings->report()), column_format);
+  } else if (just_explain) {
     convert_explain(_return, *result.getRows(), column_format);
   } else if (!just_calcite_explain) {
     convert_rows(_return,
@@ -4426,7 +4869,8 @@ void MapDHandler::execute_rel_alg_df(TDataFrame& _return,
                          g_dynamic_watchdog_time_limit,
                          false,
                          false,
-                         mapd_parameters_.gpu_input_mem_limit};
+                         mapd_parameters_.gpu_input_mem_limit,
+                         is_low_priority_session(session_info)};
   auto executor = Executor::getExecutor(cat.getCurrentDB().dbId,
                                         jit_debug_ ? "/tmp" : "",
                                         jit_debug_ ? "mapdquery" : "",
@@ -4556,6 +5000,209 @@ TRowDescriptor MapDHandler::convert_target_metainfo(
   return row_desc;
 }
 
+namespace {
+
+// Reads a signed integer of the given byte width from a columnar slot buffer.
+inline int64_t read_columnar_int(const int8_t* buf, const size_t idx, const size_t width) {
+  switch (width) {
+    case 1:
+      return buf[idx];
+    case 2:
+      return reinterpret_cast<const int16_t*>(buf)[idx];
+    case 4:
+      return reinterpret_cast<const int32_t*>(buf)[idx];
+    case 8:
+      return reinterpret_cast<const int64_t*>(buf)[idx];
+    default:
+      CHECK(false);
+  }
+  return 0;
+}
+
+// True for columns whose columnar slot holds the logical value verbatim, so
+// the Thrift column can be filled by a bulk loop over the raw buffer. Anything
+// the row iterator has to translate on read -- dictionary keys, fixed width
+// compression, dates in days -- disqualifies the column.
+bool slot_holds_logical_value(const SQLTypeInfo& ti, const size_t padded_width) {
+  if (padded_width != static_cast<size_t>(ti.get_size())) {
+    return false;
+  }
+  if (ti.is_fp()) {
+    return true;
+  }
+  if (ti.get_compression() != kENCODING_NONE) {
+    return false;
+  }
+  return ti.is_integer() || ti.is_boolean() || ti.is_decimal() || ti.is_time() ||
+         ti.is_timeinterval();
+}
+
+// Appends the contents of `from` to `to`; both must carry data for the same
+// column type.
+void append_tcolumn(TColumn& to, TColumn&& from) {
+  to.nulls.insert(to.nulls.end(), from.nulls.begin(), from.nulls.end());
+  to.data.int_col.insert(
+      to.data.int_col.end(), from.data.int_col.begin(), from.data.int_col.end());
+  to.data.real_col.insert(
+      to.data.real_col.end(), from.data.real_col.begin(), from.data.real_col.end());
+  to.data.str_col.insert(to.data.str_col.end(),
+                         std::make_move_iterator(from.data.str_col.begin()),
+                         std::make_move_iterator(from.data.str_col.end()));
+  to.data.arr_col.insert(to.data.arr_col.end(),
+                         std::make_move_iterator(from.data.arr_col.begin()),
+                         std::make_move_iterator(from.data.arr_col.end()));
+}
+
+}  // namespace
+
+bool MapDHandler::convert_rows_columnar(TQueryResult& _return,
+                                        const std::vector<TargetMetaInfo>& targets,
+                                        const ResultSet& results,
+                                        const int32_t first_n,
+                                        const int32_t at_most_n) const {
+  const size_t col_count = results.colCount();
+  if (first_n >= 0 || col_count == 0) {
+    // A row limit can't be mapped onto entry ranges up front; let the iterator
+    // path count rows as it fetches them.
+    return false;
+  }
+  CHECK_EQ(col_count, targets.size());
+  if (results.isFastColumnarConversionPossible() && results.entryCount() > 0) {
+    // Direct conversion: one bulk, type specialized loop per column reading
+    // the columnar storage, no per value TargetValue round trip. Lazily
+    // fetched columns aren't materialized in the result buffer, so their
+    // presence sends the whole result set down the slower paths.
+    const auto& lazy_fetch_info = results.getLazyFetchInfo();
+    bool direct_eligible = true;
+    for (size_t i = 0; i < col_count; ++i) {
+      if ((!lazy_fetch_info.empty() && lazy_fetch_info[i].is_lazily_fetched) ||
+          !slot_holds_logical_value(
+              targets[i].get_type_info(),
+              results.getQueryMemDesc().getPaddedSlotWidthBytes(i))) {
+        direct_eligible = false;
+        break;
+      }
+    }
+    if (direct_eligible) {
+      // Columnar projection buffers have no empty entries, every entry is a row.
+      const size_t row_count = results.entryCount();
+      if (at_most_n >= 0 && row_count > static_cast<size_t>(at_most_n)) {
+        THROW_MAPD_EXCEPTION("The result contains more rows than the specified cap of " +
+                             std::to_string(at_most_n));
+      }
+      _return.row_set.columns.resize(col_count);
+      std::vector<std::future<void>> conversion_threads;
+      for (size_t i = 0; i < col_count; ++i) {
+        conversion_threads.push_back(std::async(std::launch::async, [&, i] {
+          const auto& ti = targets[i].get_type_info();
+          const size_t width = ti.get_size();
+          std::vector<int8_t> buf(row_count * width);
+          results.copyColumnIntoBuffer(i, buf.data(), buf.size());
+          auto& column = _return.row_set.columns[i];
+          column.nulls.reserve(row_count);
+          if (ti.get_type() == kFLOAT) {
+            const auto vals = reinterpret_cast<const float*>(buf.data());
+            column.data.real_col.reserve(row_count);
+            for (size_t j = 0; j < row_count; ++j) {
+              column.data.real_col.push_back(vals[j]);
+              column.nulls.push_back(vals[j] == NULL_FLOAT && !ti.get_notnull());
+            }
+          } else if (ti.get_type() == kDOUBLE) {
+            const auto vals = reinterpret_cast<const double*>(buf.data());
+            column.data.real_col.reserve(row_count);
+            for (size_t j = 0; j < row_count; ++j) {
+              column.data.real_col.push_back(vals[j]);
+              column.nulls.push_back(vals[j] == NULL_DOUBLE && !ti.get_notnull());
+            }
+          } else if (ti.is_decimal()) {
+            const auto null_val = inline_int_null_val(ti);
+            const double scale = pow(10.0, std::abs(ti.get_scale()));
+            column.data.real_col.reserve(row_count);
+            for (size_t j = 0; j < row_count; ++j) {
+              const auto ival = read_columnar_int(buf.data(), j, width);
+              double val = static_cast<double>(ival);
+              if (ti.get_scale() > 0) {
+                val /= scale;
+              }
+              column.data.real_col.push_back(val);
+              column.nulls.push_back(ival == null_val && !ti.get_notnull());
+            }
+          } else {
+            const auto null_val = inline_int_null_val(ti);
+            column.data.int_col.reserve(row_count);
+            for (size_t j = 0; j < row_count; ++j) {
+              const auto ival = read_columnar_int(buf.data(), j, width);
+              column.data.int_col.push_back(ival);
+              column.nulls.push_back(ival == null_val && !ti.get_notnull());
+            }
+          }
+        }));
+      }
+      for (auto& child : conversion_threads) {
+        child.wait();
+      }
+      for (auto& child : conversion_threads) {
+        child.get();
+      }
+      return true;
+    }
+  }
+  if (!use_parallel_algorithms(results)) {
+    return false;
+  }
+  // Parallel conversion over entry ranges: each worker materializes its own
+  // set of TColumn pieces through the existing per value conversion and the
+  // pieces are stitched together in order afterwards.
+  const size_t entry_count = results.entryCount();
+  const size_t worker_count = cpu_threads();
+  const size_t stride = (entry_count + worker_count - 1) / worker_count;
+  std::vector<std::vector<TColumn>> worker_columns(worker_count,
+                                                   std::vector<TColumn>(col_count));
+  std::vector<std::future<void>> conversion_threads;
+  for (size_t worker_idx = 0, start_entry = 0;
+       worker_idx < worker_count && start_entry < entry_count;
+       ++worker_idx, start_entry += stride) {
+    const auto end_entry = std::min(start_entry + stride, entry_count);
+    conversion_threads.push_back(std::async(
+        std::launch::async,
+        [&results, &targets, col_count](std::vector<TColumn>& columns,
+                                        const size_t start,
+                                        const size_t end) {
+          for (size_t i = start; i < end; ++i) {
+            const auto crt_row = results.getRowAt(i);
+            if (crt_row.empty()) {
+              continue;
+            }
+            for (size_t j = 0; j < col_count; ++j) {
+              value_to_thrift_column(crt_row[j], targets[j].get_type_info(), columns[j]);
+            }
+          }
+        },
+        std::ref(worker_columns[worker_idx]),
+        start_entry,
+        end_entry));
+  }
+  for (auto& child : conversion_threads) {
+    child.wait();
+  }
+  for (auto& child : conversion_threads) {
+    child.get();
+  }
+  _return.row_set.columns.resize(col_count);
+  size_t fetched{0};
+  for (auto& columns : worker_columns) {
+    fetched += columns.front().nulls.size();
+    for (size_t j = 0; j < col_count; ++j) {
+      append_tcolumn(_return.row_set.columns[j], std::move(columns[j]));
+    }
+  }
+  if (at_most_n >= 0 && fetched > static_cast<size_t>(at_most_n)) {
+    THROW_MAPD_EXCEPTION("The result contains more rows than the specified cap of " +
+                         std::to_string(at_most_n));
+  }
+  return true;
+}
+
 template <class R>
 void MapDHandler::convert_rows(TQueryResult& _return,
                                const std::vector<TargetMetaInfo>& targets,
@@ -4568,6 +5215,9 @@ void MapDHandler::convert_rows(TQueryResult& _return,
   int32_t fetched{0};
   if (column_format) {
     _return.row_set.is_columnar = true;
+    if (convert_rows_columnar(_return, targets, results, first_n, at_most_n)) {
+      return;
+    }
     std::vector<TColumn> tcolumns(results.colCount());
     while (first_n == -1 || fetched < first_n) {
       const auto crt_row = results.getNextRow(true, true);
@@ -4742,7 +5392,8 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
                   INSERT_SELECT: CheckpointLock >> TableReadLock [ >>
      TableWriteLock ] COPY_TO/SELECT: TableReadLock COPY_FROM:  CheckpointLock [
      >> TableWriteLock ] DROP/TRUNC: CheckpointLock >> TableWriteLock
-                  DELETE/UPDATE: CheckpointLock >> TableWriteLock
+                  DELETE/UPDATE: CheckpointLock >> TableIntentExclusiveLock >>
+     FragmentWriteLock (per rewritten fragment, taken in the fragmenter)
   */
 
   std::vector<Lock_Namespace::TableLock> table_locks;
@@ -4800,7 +5451,8 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
                           false,
                           g_enable_filter_push_down && !g_cluster,
                           pw.isCalciteExplain(),
-                          pw.getExplainType() == ParserWrapper::ExplainType::OptimizedIR);
+                          pw.getExplainType() == ParserWrapper::ExplainType::OptimizedIR,
+                          pw.isAnalyzeExplain());
       if (pw.isCalciteExplain() && filter_push_down_requests.empty()) {
         // we only reach here if filter push down was enabled, but no filter
         // push down candidate was found
@@ -4818,7 +5470,8 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
                                               pw.isIRExplain(),
                                               pw.isCalciteExplain(),
                                               query_str,
-                                              filter_push_down_requests);
+                                              filter_push_down_requests,
+                                              pw.isAnalyzeExplain());
       } else if (pw.isCalciteExplain() && filter_push_down_requests.empty()) {
         // return the ra as the result:
         // If we reach here, the 'filter_push_down_request' turned out to be empty, i.e.,
@@ -4883,6 +5536,11 @@ void MapDHandler::sql_execute_impl(TQueryResult& _return,
             optimizer.vacuumDeletedRows();
           }
           optimizer.recomputeMetadata();
+          if (optimize_stmt->shouldRecommendEncodings()) {
+            // after the recompute so the ranges reflect the current data;
+            // recommendations go to the server log
+            optimizer.recommendEncodings();
+          }
         });
 
         return;
@@ -5120,7 +5778,8 @@ void MapDHandler::execute_rel_alg_with_filter_push_down(
     const bool just_explain,
     const bool just_calcite_explain,
     const std::string& query_str,
-    const std::vector<PushedDownFilterInfo> filter_push_down_requests) {
+    const std::vector<PushedDownFilterInfo> filter_push_down_requests,
+    const bool explain_analyze) {
   // collecting the selected filters' info to be sent to Calcite:
   std::vector<TFilterPushDownInfo> filter_push_down_info;
   for (const auto& req : filter_push_down_requests) {
@@ -5154,7 +5813,8 @@ void MapDHandler::execute_rel_alg_with_filter_push_down(
                   /*just_validate = */ false,
                   /*find_push_down_candidates = */ false,
                   /*just_calcite_explain = */ false,
-                  /*TODO: explain optimized*/ false);
+                  /*TODO: explain optimized*/ false,
+                  explain_analyze);
 }
 
 void MapDHandler::execute_distributed_copy_statement(
@@ -86,6 +86,7 @@
 #include <boost/regex.hpp>
 #include <boost/tokenizer.hpp>
 #include <cmath>
+#include <condition_variable>
 #include <csignal>
 #include <fstream>
 #include <list>
@@ -98,6 +99,7 @@
 #include <thread>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 #include "gen-cpp/MapD.h"
 
 using namespace std::string_literals;
@@ -224,6 +226,25 @@ class MapDHandler : public MapDIf {
                        const std::string& query,
                        const int32_t device_id,
                        const int32_t first_n) override;
+  int64_t sql_prepare(const TSessionId& session, const std::string& query) override;
+  void sql_execute_prepared(TQueryResult& _return,
+                            const TSessionId& session,
+                            const int64_t statement_id,
+                            const std::vector<TStringValue>& parameters,
+                            const bool column_format,
+                            const std::string& nonce,
+                            const int32_t first_n,
+                            const int32_t at_most_n) override;
+  void sql_release_prepared(const TSessionId& session,
+                            const int64_t statement_id) override;
+  int64_t sql_execute_cursor(const TSessionId& session,
+                             const std::string& query) override;
+  void sql_fetch_cursor(TQueryResult& _return,
+                        const TSessionId& session,
+                        const int64_t cursor_id,
+                        const bool column_format,
+                        const int32_t n) override;
+  void sql_close_cursor(const TSessionId& session, const int64_t cursor_id) override;
   void deallocate_df(const TSessionId& session,
                      const TDataFrame& df,
                      const TDeviceType::type device_type,
@@ -545,7 +566,8 @@ class MapDHandler : public MapDIf {
       const bool just_validate,
       const bool find_push_down_candidates,
       const bool just_calcite_explain,
-      const bool explain_optimized_ir) const;
+      const bool explain_optimized_ir,
+      const bool explain_analyze = false) const;
 
   void execute_rel_alg_with_filter_push_down(
       TQueryResult& _return,
@@ -558,7 +580,8 @@ class MapDHandler : public MapDIf {
       const bool just_explain,
       const bool just_calcite_explain,
       const std::string& query_str,
-      const std::vector<PushedDownFilterInfo> filter_push_down_requests);
+      const std::vector<PushedDownFilterInfo> filter_push_down_requests,
+      const bool explain_analyze = false);
 
   void execute_rel_alg_df(TDataFrame& _return,
                           const std::string& query_ra,
@@ -603,6 +626,16 @@ class MapDHandler : public MapDIf {
                     const int32_t first_n,
                     const int32_t at_most_n) const;
 
+  // Columnar fast path for convert_rows: bulk-converts fixed width scalar
+  // columns straight out of columnar ResultSet storage, or falls back to
+  // parallel conversion over entry ranges for the other types. Returns false
+  // if the result set doesn't qualify and the row-by-row path should run.
+  bool convert_rows_columnar(TQueryResult& _return,
+                             const std::vector<TargetMetaInfo>& targets,
+                             const ResultSet& results,
+                             const int32_t first_n,
+                             const int32_t at_most_n) const;
+
   void create_simple_result(TQueryResult& _return,
                             const ResultSet& results,
                             const bool column_format,
@@ -681,6 +714,80 @@ class MapDHandler : public MapDIf {
   Importer_NS::CopyParams _geo_copy_from_copy_params;
   std::string _geo_copy_from_partitions;
 
+  struct PreparedStatement {
+    std::string query;
+    std::vector<size_t> placeholder_positions;
+  };
+  // Prepared statements are per session and live until released explicitly or
+  // the session disconnects. Binding splices the parameter values into the
+  // statement text; reuse of the compiled kernel across parameter values comes
+  // from literal hoisting, which keys the code cache on the parameterized form.
+  std::mutex prepared_statements_mutex_;
+  std::map<TSessionId, std::map<int64_t, PreparedStatement>> prepared_statements_;
+  int64_t next_prepared_statement_id_ = 1;
+
+  struct Cursor {
+    std::shared_ptr<ResultSet> result_set;
+    std::vector<TargetMetaInfo> targets;
+    // getNextRow keeps the paging position inside the result set, so
+    // concurrent fetches on the same cursor have to serialize on it.
+    std::shared_ptr<std::mutex> fetch_mutex;
+  };
+  // Server-side cursors are per session and live until closed explicitly or
+  // the session disconnects. The spool is the result set itself, kept
+  // resident in CPU memory by its row set memory owner; sql_fetch_cursor
+  // pages through it with the regular row conversion, so paging a large
+  // export costs one execution instead of one per LIMIT/OFFSET page.
+  std::mutex cursors_mutex_;
+  std::map<TSessionId, std::map<int64_t, Cursor>> cursors_;
+  int64_t next_cursor_id_ = 1;
+
+  // Responses for the metadata calls BI tools issue in bursts (get_tables and
+  // friends, get_table_details, get_users), keyed by database, user and call.
+  // Entries remember the catalog and privilege versions they were built
+  // against, so any DDL or GRANT/REVOKE invalidates them on the next lookup
+  // and a dashboard refresh storm is served with map copies instead of
+  // catalog walks and per-table privilege checks.
+  struct MetadataCacheEntry {
+    uint64_t catalog_version;
+    uint64_t privileges_version;
+    std::vector<std::string> names;
+    TTableDetails table_details;
+  };
+  std::mutex metadata_cache_mutex_;
+  std::unordered_map<std::string, MetadataCacheEntry> metadata_cache_;
+
+  // Credentials validated by a previous connect, keyed by user and database,
+  // so short-lived clients that reconnect per request skip the slow password
+  // verification. Only a digest of the password salted with a per-process
+  // random value is kept, and entries are fenced by the SysCatalog privileges
+  // version so user DDL (including password changes) invalidates them.
+  struct CredentialCacheEntry {
+    uint64_t privileges_version;
+    std::string salted_digest;
+  };
+  std::mutex credential_cache_mutex_;
+  std::unordered_map<std::string, CredentialCacheEntry> credential_cache_;
+  std::string credential_cache_salt_;
+
+  // Bounds the number of queries executing at once when
+  // --max-concurrent-queries is set. The Thrift server dispatches one thread
+  // per connection, so once query execution is bounded here cheap metadata
+  // calls like get_tables keep their own threads and never queue behind
+  // long-running queries.
+  void acquire_query_slot(const bool low_priority);
+  void release_query_slot();
+  bool is_low_priority_session(
+      const Catalog_Namespace::SessionInfo& session_info) const;
+  std::mutex query_slots_mutex_;
+  std::condition_variable query_slots_cv_;
+  size_t queries_executing_ = 0;
+  size_t high_priority_queries_waiting_ = 0;
+  // Users (typically the ETL service account) whose queries run batch-class:
+  // they queue behind interactive queries for execution slots and yield the
+  // devices at fragment kernel boundaries. From --low-priority-users.
+  std::unordered_set<std::string> low_priority_users_;
+
   // Only for IPC device memory deallocation
   mutable std::mutex handle_to_dev_ptr_mutex_;
   mutable std::unordered_map<std::string, int8_t*> ipc_handle_to_dev_ptr_;
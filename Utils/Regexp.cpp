@@ -19,15 +19,175 @@
  * @author		Dmitri Shtilman <d@mapd.com>
  * @brief		Support the REGEX operator and REGEX_LIKE function in SQL.
  *
+ * Patterns are compiled once and cached, not recompiled per row. When RE2 is
+ * available the compiled automaton gives linear-time matching, so a
+ * pathological pattern can no longer pin a CPU through backtracking; without
+ * it the boost::regex fallback still benefits from the cache. A required
+ * literal extracted from the pattern is used as a substring prefilter
+ * (vectorized through memchr) before the automaton runs at all, which is
+ * where most of the win on log-pattern scans comes from - including the
+ * per-dictionary-entry pre-pass in StringDictionary::getRegexpLike, which
+ * funnels through regexp_like.
+ *
  * Copyright (c) 2016 MapD Technologies, Inc.  All rights reserved.
  **/
 
 #include "Regexp.h"
 
 #ifndef __CUDACC__
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#ifdef HAVE_RE2
+#include <re2/re2.h>
+#else
 #include <boost/regex.hpp>
 #endif
 
+namespace {
+
+// Extracts the longest literal run the pattern requires in any match. Returns
+// an empty string when no safe literal exists. Conservative: alternation or
+// grouping anywhere disqualifies the pattern - a quantifier after a group
+// ("(abc)*") makes everything inside it optional, and tracking that through
+// nesting is not worth it - while metacharacters, classes and escapes just
+// break the current run. Short literals are not worth the scan.
+std::string extract_required_literal(const std::string& pattern) {
+  if (pattern.find_first_of("|(") != std::string::npos) {
+    return "";
+  }
+  std::string best;
+  std::string current;
+  const auto flush = [&best, &current]() {
+    if (current.size() > best.size()) {
+      best = current;
+    }
+    current.clear();
+  };
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    switch (c) {
+      case '\\':
+        ++i;  // escaped character could be a literal, but don't assume
+        flush();
+        break;
+      case '*':
+      case '?':
+        // the previous atom is optional, it can't be part of a required run
+        if (!current.empty()) {
+          current.pop_back();
+        }
+        flush();
+        break;
+      case '{':
+        // a bound could have a zero minimum; treat like '*'
+        if (!current.empty()) {
+          current.pop_back();
+        }
+        flush();
+        while (i < pattern.size() && pattern[i] != '}') {
+          ++i;
+        }
+        break;
+      case '+':
+        // the previous atom occurs at least once, the run up to here stands
+        flush();
+        break;
+      case '[':
+        flush();
+        while (i < pattern.size() && pattern[i] != ']') {
+          ++i;
+        }
+        break;
+      case ')':
+      case '.':
+      case '^':
+      case '$':
+        flush();
+        break;
+      default:
+        current.push_back(c);
+        break;
+    }
+  }
+  flush();
+  return best.size() >= 3 ? best : "";
+}
+
+// Substring scan built on memchr, which libc vectorizes; the regex engine
+// only runs on rows that contain the required literal.
+bool contains_literal(const char* str, const size_t str_len, const std::string& literal) {
+  if (literal.size() > str_len) {
+    return false;
+  }
+  const char* pos = str;
+  const char* last_start = str + str_len - literal.size();
+  while (pos <= last_start) {
+    const char* hit =
+        static_cast<const char*>(memchr(pos, literal.front(), last_start - pos + 1));
+    if (!hit) {
+      return false;
+    }
+    if (memcmp(hit, literal.data(), literal.size()) == 0) {
+      return true;
+    }
+    pos = hit + 1;
+  }
+  return false;
+}
+
+struct CompiledPattern {
+  std::string required_literal;
+  bool valid{false};
+#ifdef HAVE_RE2
+  std::unique_ptr<re2::RE2> re;
+#else
+  boost::regex re;
+#endif
+};
+
+// Shared compile cache with a thread local view over it, so steady-state
+// per-row lookups (notably the StringDictionary scan workers) take no lock.
+const CompiledPattern* get_compiled_pattern(const std::string& pattern) {
+  thread_local std::unordered_map<std::string, const CompiledPattern*> local_cache;
+  const auto local_it = local_cache.find(pattern);
+  if (local_it != local_cache.end()) {
+    return local_it->second;
+  }
+  static std::mutex cache_mutex;
+  static std::unordered_map<std::string, std::unique_ptr<CompiledPattern>> cache;
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto it = cache.find(pattern);
+  if (it == cache.end()) {
+    auto compiled = std::unique_ptr<CompiledPattern>(new CompiledPattern);
+    compiled->required_literal = extract_required_literal(pattern);
+#ifdef HAVE_RE2
+    re2::RE2::Options options;
+    options.set_log_errors(false);
+    compiled->re.reset(new re2::RE2(pattern, options));
+    compiled->valid = compiled->re->ok();
+#else
+    try {
+      compiled->re = boost::regex(pattern, boost::regex::extended);
+      compiled->valid = true;
+    } catch (const std::runtime_error&) {
+      compiled->valid = false;
+    }
+#endif
+    it = cache.emplace(pattern, std::move(compiled)).first;
+  }
+  local_cache.emplace(pattern, it->second.get());
+  return it->second.get();
+}
+
+}  // namespace
+
+#endif  // __CUDACC__
+
 /*
  * @brief regexp_like performs the SQL REGEXP operation
  * @param str string argument to be matched against pattern.
@@ -43,16 +203,20 @@ extern "C" DEVICE bool regexp_like(const char* str,
                                    const int32_t pat_len,
                                    const char escape_char) {
 #ifndef __CUDACC__
-  bool result;
-  try {
-    boost::regex re(pattern, pat_len, boost::regex::extended);
-    boost::cmatch what;
-    result = boost::regex_match(str, str + str_len, what, re);
-  } catch (std::runtime_error& error) {
-    // LOG(ERROR) << "Regexp match error: " << error.what();
-    result = false;
+  const auto compiled = get_compiled_pattern(std::string(pattern, pat_len));
+  if (!compiled->valid) {
+    return false;
   }
-  return result;
+  if (!compiled->required_literal.empty() &&
+      !contains_literal(str, str_len, compiled->required_literal)) {
+    return false;
+  }
+#ifdef HAVE_RE2
+  return re2::RE2::FullMatch(re2::StringPiece(str, str_len), *compiled->re);
+#else
+  boost::cmatch what;
+  return boost::regex_match(str, str + str_len, what, compiled->re);
+#endif
 #else
   return false;
 #endif
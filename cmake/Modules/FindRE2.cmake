@@ -0,0 +1,74 @@
+#.rst:
+# FindRE2.cmake
+# -------------
+#
+# Find a RE2 installation.
+#
+# This module finds if RE2 is installed and selects a default
+# configuration to use.
+#
+# find_package(RE2 ...)
+#
+#
+# The following variables control which libraries are found::
+#
+#   RE2_USE_STATIC_LIBS  - Set to ON to force use of static libraries.
+#
+# The following are set after the configuration is done:
+#
+# ::
+#
+#   RE2_FOUND            - Set to TRUE if RE2 was found.
+#   RE2_LIBRARIES        - Path to the RE2 libraries.
+#   RE2_LIBRARY_DIRS     - compile time link directories
+#   RE2_INCLUDE_DIRS     - compile time include directories
+#
+#
+# Sample usage:
+#
+# ::
+#
+#    find_package(RE2)
+#    if(RE2_FOUND)
+#      target_link_libraries(<YourTarget> ${RE2_LIBRARIES})
+#    endif()
+
+if(RE2_USE_STATIC_LIBS)
+  set(_CMAKE_FIND_LIBRARY_SUFFIXES ${CMAKE_FIND_LIBRARY_SUFFIXES})
+  set(CMAKE_FIND_LIBRARY_SUFFIXES .lib .a ${CMAKE_FIND_LIBRARY_SUFFIXES})
+endif()
+
+find_library(RE2_LIBRARY
+  NAMES re2
+  HINTS
+  ENV LD_LIBRARY_PATH
+  ENV DYLD_LIBRARY_PATH
+  PATHS
+  /usr/lib
+  /usr/local/lib
+  /usr/local/homebrew/lib
+  /opt/local/lib)
+
+find_path(RE2_INCLUDE_DIR
+  NAMES re2/re2.h
+  HINTS
+  ${RE2_LIBRARY}/../../include
+  PATHS
+  /usr/include
+  /usr/local/include
+  /usr/local/homebrew/include
+  /opt/local/include)
+
+if(RE2_USE_STATIC_LIBS)
+  set(CMAKE_FIND_LIBRARY_SUFFIXES ${_CMAKE_FIND_LIBRARY_SUFFIXES})
+endif()
+
+get_filename_component(RE2_LIBRARY_DIR ${RE2_LIBRARY} DIRECTORY)
+
+# Set standard CMake FindPackage variables if found.
+set(RE2_LIBRARIES ${RE2_LIBRARY})
+set(RE2_LIBRARY_DIRS ${RE2_LIBRARY_DIR})
+set(RE2_INCLUDE_DIRS ${RE2_INCLUDE_DIR})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(RE2 REQUIRED_VARS RE2_LIBRARY RE2_INCLUDE_DIR)
@@ -41,6 +41,7 @@ import org.apache.calcite.sql.SqlBasicCall;
 import org.apache.calcite.sql.SqlCall;
 import org.apache.calcite.sql.SqlDialect;
 import org.apache.calcite.sql.SqlIdentifier;
+import org.apache.calcite.sql.SqlJoin;
 import org.apache.calcite.sql.SqlLiteral;
 import org.apache.calcite.sql.SqlNode;
 import org.apache.calcite.sql.SqlNodeList;
@@ -111,6 +112,10 @@ public final class MapDParser {
   }
 
   private MapDPlanner getPlanner() {
+    return getPlanner(false);
+  }
+
+  private MapDPlanner getPlanner(final boolean expandSubQueries) {
     MapDSchema mapd =
             new MapDSchema(dataDir, this, mapdPort, mapdUser, sock_transport_properties);
     final SchemaPlus rootSchema = Frameworks.createRootSchema(true);
@@ -126,8 +131,11 @@ public final class MapDParser {
                     .sqlToRelConverterConfig(
                             SqlToRelConverter
                                     .configBuilder()
-                                    // disable sub-query expansion (in-lining)
-                                    .withExpand(false)
+                                    // sub-query expansion (in-lining) stays off unless
+                                    // the statement needs decorrelation; expanded
+                                    // sub-queries are turned into joins by the
+                                    // decorrelator in PlannerImpl.rel()
+                                    .withExpand(expandSubQueries)
                                     // allow as many as possible IN operator values
                                     .withInSubQueryThreshold(Integer.MAX_VALUE)
                                     .build())
@@ -198,6 +206,15 @@ public final class MapDParser {
       node = processSQL(node.toSqlString(SqlDialect.CALCITE).toString(), false, planner);
     }
 
+    if (requiresSubQueryExpansion(node)) {
+      // EXISTS and correlated IN sub-queries cannot be executed as-is by the
+      // backend; re-plan with sub-query expansion enabled so the decorrelator
+      // unnests them into join shaped plans the backend runs as hash joins.
+      planner.close();
+      planner = getPlanner(true);
+      node = processSQL(node.toSqlString(SqlDialect.CALCITE).toString(), false, planner);
+    }
+
     boolean is_select_star = isSelectStar(node);
 
     SqlNode validateR = planner.validate(node);
@@ -288,6 +305,116 @@ public final class MapDParser {
     }
   }
 
+  // True if the statement contains a sub-query only executable after Calcite
+  // expands it into a join: any EXISTS, or an IN whose sub-select refers to the
+  // enclosing query. Uncorrelated IN sub-queries are left unexpanded so the
+  // backend keeps its specialized value-set path for them.
+  private static boolean requiresSubQueryExpansion(final SqlNode node) {
+    if (node == null) {
+      return false;
+    }
+    if (node instanceof SqlBasicCall) {
+      final SqlBasicCall call = (SqlBasicCall) node;
+      final String operator = call.getOperator().getName().toUpperCase();
+      if (operator.equals("EXISTS")) {
+        return true;
+      }
+      if ((operator.equals("IN") || operator.equals("NOT IN"))
+              && call.getOperands().length == 2
+              && call.getOperands()[1] instanceof SqlSelect
+              && subQueryIsCorrelated((SqlSelect) call.getOperands()[1])) {
+        return true;
+      }
+    }
+    if (node instanceof SqlNodeList) {
+      for (SqlNode item : (SqlNodeList) node) {
+        if (requiresSubQueryExpansion(item)) {
+          return true;
+        }
+      }
+      return false;
+    }
+    if (node instanceof SqlCall) {
+      for (SqlNode operand : ((SqlCall) node).getOperandList()) {
+        if (requiresSubQueryExpansion(operand)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Best effort check whether a sub-select references a table or alias which is
+  // not part of its own FROM clause. A false positive only costs the value-set
+  // fast path; expansion is always a correct way to run the sub-query.
+  private static boolean subQueryIsCorrelated(final SqlSelect select) {
+    final Set<String> aliases = new HashSet<>();
+    collectFromAliases(select.getFrom(), aliases);
+    return referencesOtherScope(select.getWhere(), aliases);
+  }
+
+  private static void collectFromAliases(final SqlNode from, final Set<String> aliases) {
+    if (from == null) {
+      return;
+    }
+    if (from instanceof SqlJoin) {
+      final SqlJoin join = (SqlJoin) from;
+      collectFromAliases(join.getLeft(), aliases);
+      collectFromAliases(join.getRight(), aliases);
+      return;
+    }
+    if (from instanceof SqlBasicCall) {
+      final SqlBasicCall call = (SqlBasicCall) from;
+      if (call.getOperator() instanceof SqlAsOperator
+              && call.getOperands()[1] instanceof SqlIdentifier) {
+        aliases.add(((SqlIdentifier) call.getOperands()[1]).toString().toLowerCase());
+      }
+      return;
+    }
+    if (from instanceof SqlIdentifier) {
+      final SqlIdentifier identifier = (SqlIdentifier) from;
+      aliases.add(identifier.names.get(identifier.names.size() - 1).toLowerCase());
+    }
+  }
+
+  private static boolean referencesOtherScope(
+          final SqlNode node, final Set<String> aliases) {
+    if (node == null) {
+      return false;
+    }
+    if (node instanceof SqlIdentifier) {
+      final SqlIdentifier identifier = (SqlIdentifier) node;
+      return identifier.names.size() > 1
+              && !aliases.contains(identifier.names.get(0).toLowerCase());
+    }
+    if (node instanceof SqlSelect) {
+      // a nested sub-select brings its own FROM aliases into scope
+      final SqlSelect select = (SqlSelect) node;
+      final Set<String> nested_aliases = new HashSet<>(aliases);
+      collectFromAliases(select.getFrom(), nested_aliases);
+      if (referencesOtherScope(select.getWhere(), nested_aliases)) {
+        return true;
+      }
+      return referencesOtherScope(select.getSelectList(), nested_aliases);
+    }
+    if (node instanceof SqlNodeList) {
+      for (SqlNode item : (SqlNodeList) node) {
+        if (referencesOtherScope(item, aliases)) {
+          return true;
+        }
+      }
+      return false;
+    }
+    if (node instanceof SqlCall) {
+      for (SqlNode operand : ((SqlCall) node).getOperandList()) {
+        if (referencesOtherScope(operand, aliases)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
   private static SqlNode getUnaliasedExpression(final SqlNode node) {
     if (node instanceof SqlBasicCall
             && ((SqlBasicCall) node).getOperator() instanceof SqlAsOperator) {
@@ -129,6 +129,7 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
     // using reflection when we are deserializing from JSON.
     // opTab.addOperator(new RampFunction());
     // opTab.addOperator(new DedupFunction());
+    opTab.addOperator(new RowCopier());
     opTab.addOperator(new MyUDFFunction());
     opTab.addOperator(new PgUnnest());
     opTab.addOperator(new Any());
@@ -181,6 +182,8 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
     opTab.addOperator(new CastToGeography());
     opTab.addOperator(new OffsetInFragment());
     opTab.addOperator(new ApproxCountDistinct());
+    opTab.addOperator(new ApproxMedian());
+    opTab.addOperator(new ApproxTopK());
     opTab.addOperator(new Sample());
     opTab.addOperator(new LastSample());
     // MapD_Geo* are deprecated in place of the OmniSci_Geo_ varietals
@@ -257,6 +260,32 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
     }
   }
 
+  /**
+   * "ROW_COPIER" table function: TABLE(row_copier(CURSOR(...), multiplier))
+   * repeats the cursor argument multiplier times. The execution side lives in
+   * the query engine table function registry; here we only describe the
+   * signature and the shape of the result.
+   */
+  public static class RowCopier extends SqlFunction {
+    public RowCopier() {
+      super("ROW_COPIER",
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.VARIADIC,
+              SqlFunctionCategory.USER_DEFINED_TABLE_FUNCTION);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.builder()
+              .add("out0", SqlTypeName.DOUBLE)
+              .nullable(true)
+              .build();
+    }
+  }
+
   /**
    * "MyUDFFunction" user-defined function test. our udf's will look like system
    * functions to calcite as it has no access to the code
@@ -1329,6 +1358,41 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
     }
   }
 
+  static class ApproxMedian extends SqlAggFunction {
+    ApproxMedian() {
+      super("APPROX_MEDIAN",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.family(SqlTypeFamily.NUMERIC),
+              SqlFunctionCategory.SYSTEM);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createSqlType(SqlTypeName.DOUBLE);
+    }
+  }
+
+  static class ApproxTopK extends SqlAggFunction {
+    ApproxTopK() {
+      super("APPROX_TOP_K",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.family(SqlTypeFamily.ANY, SqlTypeFamily.INTEGER),
+              SqlFunctionCategory.SYSTEM);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      return opBinding.getOperandType(0);
+    }
+  }
+
   public static class Sample extends SqlAggFunction {
     public Sample() {
       super("SAMPLE",
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2019 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.mapd.parser.server;
+
+import com.mapd.thrift.calciteserver.TFilterPushDownInfo;
+import com.mapd.thrift.calciteserver.TPlanResult;
+
+import org.apache.thrift.TSerializer;
+import org.apache.thrift.protocol.TSimpleJSONProtocol;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Static entry points invoked from the omnisci server over JNI when it runs
+ * the Calcite planner in-process instead of talking to a CalciteServer over
+ * Thrift. The C++ side caches the method ids once at JVM creation; results
+ * that are Thrift structs travel back serialized with TSimpleJSONProtocol.
+ */
+public final class CalciteJNI {
+  final static Logger MAPDLOGGER = LoggerFactory.getLogger(CalciteJNI.class);
+
+  private static CalciteServerHandler handler = null;
+
+  private CalciteJNI() {}
+
+  public static synchronized void init(
+          int mapdPort, String dataDir, String extensionFunctionsAstFile, String udfAstFile) {
+    if (handler == null) {
+      handler = new CalciteServerHandler(
+              mapdPort, dataDir, extensionFunctionsAstFile, null, udfAstFile);
+      MAPDLOGGER.info("Calcite JNI bridge initialized");
+    }
+  }
+
+  /**
+   * Runs the planner; the filter push down info travels as three parallel
+   * arrays to keep Thrift objects off the JNI boundary. An InvalidParseRequest
+   * propagates as an exception whose message the C++ side maps back to
+   * std::invalid_argument.
+   */
+  public static String process(String user,
+          String session,
+          String catalog,
+          String sqlText,
+          int[] pushDownInputPrev,
+          int[] pushDownInputStart,
+          int[] pushDownInputNext,
+          boolean legacySyntax,
+          boolean isExplain,
+          boolean isViewOptimize) throws Exception {
+    List<TFilterPushDownInfo> pushDownInfo = new ArrayList<TFilterPushDownInfo>();
+    for (int i = 0; i < pushDownInputPrev.length; ++i) {
+      TFilterPushDownInfo info = new TFilterPushDownInfo();
+      info.input_prev = pushDownInputPrev[i];
+      info.input_start = pushDownInputStart[i];
+      info.input_next = pushDownInputNext[i];
+      pushDownInfo.add(info);
+    }
+    TPlanResult result = handler.process(user,
+            session,
+            catalog,
+            sqlText,
+            pushDownInfo,
+            legacySyntax,
+            isExplain,
+            isViewOptimize);
+    return new TSerializer(new TSimpleJSONProtocol.Factory()).toString(result);
+  }
+
+  public static void updateMetadata(String catalog, String table) throws Exception {
+    handler.updateMetadata(catalog, table);
+  }
+
+  public static String getExtensionFunctionWhitelist() throws Exception {
+    return handler.getExtensionFunctionWhitelist();
+  }
+
+  public static String getUserDefinedFunctionWhitelist() throws Exception {
+    return handler.getUserDefinedFunctionWhitelist();
+  }
+
+  public static String getRuntimeUserDefinedFunctionWhitelist() throws Exception {
+    return handler.getRuntimeUserDefinedFunctionWhitelist();
+  }
+
+  public static void setRuntimeUserDefinedFunction(String udfString) throws Exception {
+    handler.setRuntimeUserDefinedFunction(udfString);
+  }
+}
@@ -120,6 +120,7 @@ struct TQueryResult {
   2: i64 execution_time_ms
   3: i64 total_time_ms
   4: string nonce
+  5: double fraction_sampled = 1.0
 }
 
 struct TDataFrame {
@@ -270,6 +271,10 @@ struct TNodeMemoryInfo {
   4: i64 num_pages_allocated
   5: bool is_allocation_capped
   6: list<TMemoryData> node_memory_data
+  # cache statistics, cumulative since startup
+  7: i64 num_chunk_hits
+  8: i64 num_chunk_misses
+  9: i64 num_chunk_evictions
 }
 
 struct TTableMeta {
@@ -507,6 +512,14 @@ service MapD {
   TQueryResult sql_execute(1: TSessionId session, 2: string query 3: bool column_format, 4: string nonce, 5: i32 first_n = -1, 6: i32 at_most_n = -1) throws (1: TMapDException e)
   TDataFrame sql_execute_df(1: TSessionId session, 2: string query 3: common.TDeviceType device_type 4: i32 device_id = 0 5: i32 first_n = -1) throws (1: TMapDException e)
   TDataFrame sql_execute_gdf(1: TSessionId session, 2: string query 3: i32 device_id = 0, 4: i32 first_n = -1) throws (1: TMapDException e)
+  # prepared statements; parameters replace '?' placeholders in the prepared query text, in order
+  i64 sql_prepare(1: TSessionId session, 2: string query) throws (1: TMapDException e)
+  TQueryResult sql_execute_prepared(1: TSessionId session, 2: i64 statement_id, 3: list<TStringValue> parameters, 4: bool column_format, 5: string nonce, 6: i32 first_n = -1, 7: i32 at_most_n = -1) throws (1: TMapDException e)
+  void sql_release_prepared(1: TSessionId session, 2: i64 statement_id) throws (1: TMapDException e)
+  # server-side cursors; the SELECT runs once, its result set is spooled on the server and paged out by sql_fetch_cursor
+  i64 sql_execute_cursor(1: TSessionId session, 2: string query) throws (1: TMapDException e)
+  TQueryResult sql_fetch_cursor(1: TSessionId session, 2: i64 cursor_id, 3: bool column_format, 4: i32 n) throws (1: TMapDException e)
+  void sql_close_cursor(1: TSessionId session, 2: i64 cursor_id) throws (1: TMapDException e)
   void deallocate_df(1: TSessionId session, 2: TDataFrame df, 3: common.TDeviceType device_type, 4: i32 device_id = 0) throws (1: TMapDException e)
   void interrupt(1: TSessionId session) throws (1: TMapDException e)
   TTableDescriptor sql_validate(1: TSessionId session, 2: string query) throws (1: TMapDException e)